@@ -16,12 +16,22 @@ const std::string dash_line = "\n" + std::string(78, '-') + "\n";
 void print_usage(std::ostream& out) {
     out << R"doc(Usage:
     openturbine <input_file> [param=value] [param=value] ...
+    openturbine --sweep <sweep_file> [summary_file] [n_threads]
 
 Required:
     input_file   : Input file with simulation settings
 
 Optional:
     param=value  : Overrides for parameters during runtime
+
+Sweep mode:
+    sweep_file   : Base case and parameter grid, "parameter = value" per line, where
+                   "parameter = value, value, ..." is an axis of the grid
+    summary_file : Output file with the summary of every case (default: sweep_summary.csv)
+    n_threads    : Number of cases run at once (default: hardware concurrency)
+
+    With MPI, every rank runs its share of the cases and writes its summary and log files,
+    named with the rank before the extension, e.g. sweep_summary.3.csv and log.3.txt
 )doc" << std::endl;
 }
 
@@ -0,0 +1,55 @@
+#include "src/io/ensemble_history_writer.H"
+
+namespace openturbine::io {
+
+namespace {
+
+/// Returns the provided (component, body) view as one vector, body after body
+rigid_pendulum::HostView1D concatenate_bodies(
+    const std::string& name, const rigid_pendulum::HostView2D view
+) {
+    const auto n_components = view.extent(0);
+    const auto n_bodies = view.extent(1);
+    auto values = rigid_pendulum::HostView1D(name, n_components * n_bodies);
+    for (size_t body = 0; body < n_bodies; ++body) {
+        for (size_t i = 0; i < n_components; ++i) {
+            values(body * n_components + i) = view(i, body);
+        }
+    }
+    return values;
+}
+
+}  // namespace
+
+EnsembleHistoryWriter::EnsembleHistoryWriter(
+    const std::string& file_name, const util::Communicator& communicator,
+    const rigid_pendulum::TimeStepper& time_stepper, size_t chunk_size, Compression compression
+)
+    : writer_(communicator.GetRankFileName(file_name), time_stepper, chunk_size, compression),
+      host_states_(0) {
+}
+
+void EnsembleHistoryWriter::Finalize() {
+    writer_.Finalize();
+}
+
+void EnsembleHistoryWriter::WriteHostStates(
+    size_t step, double time, const rigid_pendulum::BatchedState<Kokkos::HostSpace>& states,
+    size_t n_iterations, bool is_converged
+) {
+    writer_.Observe(
+        {step, time,
+         rigid_pendulum::State(
+             concatenate_bodies("generalized_coordinates", states.GetGeneralizedCoordinates()),
+             concatenate_bodies("velocity", states.GetVelocity()),
+             concatenate_bodies("acceleration", states.GetAcceleration()),
+             concatenate_bodies(
+                 "algorithmic_acceleration", states.GetAlgorithmicAcceleration()
+             )
+         ),
+         concatenate_bodies("lagrange_mults", states.GetLagrangeMultipliers()), n_iterations,
+         is_converged}
+    );
+}
+
+}  // namespace openturbine::io
@@ -0,0 +1,393 @@
+#include "src/io/parameter_sweep.H"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/state_observer.h"
+
+namespace openturbine::io {
+
+namespace {
+
+/// A parameter of a sweep case, i.e. either a real or an integer member of SweepCase
+struct SweepParameter {
+    const char* name;
+    double SweepCase::*real;
+    size_t SweepCase::*integer;
+};
+
+const std::vector<SweepParameter>& get_sweep_parameters() {
+    static const std::vector<SweepParameter> parameters = {
+        {"mass", &SweepCase::mass, nullptr},
+        {"inertia_x", &SweepCase::inertia_x, nullptr},
+        {"inertia_y", &SweepCase::inertia_y, nullptr},
+        {"inertia_z", &SweepCase::inertia_z, nullptr},
+        {"angular_velocity_x", &SweepCase::angular_velocity_x, nullptr},
+        {"angular_velocity_y", &SweepCase::angular_velocity_y, nullptr},
+        {"angular_velocity_z", &SweepCase::angular_velocity_z, nullptr},
+        {"alpha_f", &SweepCase::alpha_f, nullptr},
+        {"alpha_m", &SweepCase::alpha_m, nullptr},
+        {"beta", &SweepCase::beta, nullptr},
+        {"gamma", &SweepCase::gamma, nullptr},
+        {"initial_time", &SweepCase::initial_time, nullptr},
+        {"time_step", &SweepCase::time_step, nullptr},
+        {"n_steps", nullptr, &SweepCase::n_steps},
+        {"max_iterations", nullptr, &SweepCase::max_iterations},
+    };
+    return parameters;
+}
+
+const SweepParameter& find_sweep_parameter(const std::string& name) {
+    const auto& parameters = get_sweep_parameters();
+    const auto parameter = std::find_if(
+        parameters.begin(), parameters.end(),
+        [&name](const SweepParameter& p) { return name == p.name; }
+    );
+    if (parameter == parameters.end()) {
+        throw std::invalid_argument("Unknown sweep parameter: " + name);
+    }
+    return *parameter;
+}
+
+std::string trim(const std::string& text) {
+    const auto first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    const auto last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+double parse_value(const std::string& text, size_t line_number) {
+    const auto value = trim(text);
+    size_t n_parsed = 0;
+    double result = 0.;
+    try {
+        result = std::stod(value, &n_parsed);
+    } catch (const std::exception&) {
+        n_parsed = 0;
+    }
+    if (value.empty() || n_parsed != value.size()) {
+        throw std::runtime_error(
+            "Invalid value '" + value + "' on line " + std::to_string(line_number) +
+            " of the sweep input"
+        );
+    }
+    return result;
+}
+
+/// Solves the 3 x 3 system [A] {x} = {b} with Cramer's rule
+rigid_pendulum::Vec<3> solve(
+    const rigid_pendulum::Matrix<3, 3>& A, const rigid_pendulum::Vec<3>& b
+) {
+    using rigid_pendulum::Vec;
+    const auto column = [&A](size_t j) { return Vec<3>{{A(0, j), A(1, j), A(2, j)}}; };
+    const auto determinant = column(0).DotProduct(column(1).CrossProduct(column(2)));
+    if (std::abs(determinant) < std::numeric_limits<double>::min()) {
+        throw std::invalid_argument("The initial accelerations of the case are not defined");
+    }
+    return Vec<3>{
+        {b.DotProduct(column(1).CrossProduct(column(2))) / determinant,
+         column(0).DotProduct(b.CrossProduct(column(2))) / determinant,
+         column(0).DotProduct(column(1).CrossProduct(b)) / determinant}};
+}
+
+/// Writes the provided text as a quoted CSV field
+void write_quoted(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (const auto c : text) {
+        out << c;
+        if (c == '"') {
+            out << '"';
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+const std::vector<std::string>& get_sweep_parameter_names() {
+    static const std::vector<std::string> names = []() {
+        auto result = std::vector<std::string>{};
+        for (const auto& parameter : get_sweep_parameters()) {
+            result.emplace_back(parameter.name);
+        }
+        return result;
+    }();
+    return names;
+}
+
+double get_sweep_parameter(const SweepCase& sweep_case, const std::string& parameter) {
+    const auto& p = find_sweep_parameter(parameter);
+    return p.real != nullptr ? sweep_case.*p.real : static_cast<double>(sweep_case.*p.integer);
+}
+
+void set_sweep_parameter(SweepCase& sweep_case, const std::string& parameter, double value) {
+    const auto& p = find_sweep_parameter(parameter);
+    if (p.real != nullptr) {
+        sweep_case.*p.real = value;
+        return;
+    }
+    if (value < 0. || value != std::floor(value)) {
+        throw std::invalid_argument(
+            "The sweep parameter " + parameter + " must be a non-negative integer"
+        );
+    }
+    sweep_case.*p.integer = static_cast<size_t>(value);
+}
+
+SweepInput parse_sweep_input(std::istream& in) {
+    auto input = SweepInput{};
+    auto assigned = std::vector<std::string>{};
+    auto line = std::string{};
+    size_t line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        const auto equals = line.find('=');
+        if (equals == std::string::npos) {
+            throw std::runtime_error(
+                "Expected 'parameter = value' on line " + std::to_string(line_number) +
+                " of the sweep input"
+            );
+        }
+        const auto parameter = trim(line.substr(0, equals));
+        auto values = std::vector<double>{};
+        auto list = std::istringstream(line.substr(equals + 1));
+        auto entry = std::string{};
+        while (std::getline(list, entry, ',')) {
+            values.push_back(parse_value(entry, line_number));
+        }
+        if (values.empty()) {
+            throw std::runtime_error(
+                "Missing value on line " + std::to_string(line_number) + " of the sweep input"
+            );
+        }
+
+        // Validates the parameter and its values before they are stored
+        auto sweep_case = input.base;
+        for (const auto value : values) {
+            set_sweep_parameter(sweep_case, parameter, value);
+        }
+        if (std::find(assigned.begin(), assigned.end(), parameter) != assigned.end()) {
+            throw std::runtime_error("The sweep parameter " + parameter + " is assigned twice");
+        }
+        assigned.push_back(parameter);
+        if (values.size() == 1) {
+            input.base = sweep_case;
+        } else {
+            input.grid.push_back({parameter, values});
+        }
+    }
+    return input;
+}
+
+SweepInput read_sweep_input(const std::string& file_name) {
+    auto file = std::ifstream(file_name);
+    if (!file) {
+        throw std::runtime_error("Unable to open the sweep input file " + file_name);
+    }
+    return parse_sweep_input(file);
+}
+
+std::vector<SweepCase> create_sweep_cases(const SweepInput& input) {
+    auto cases = std::vector<SweepCase>{input.base};
+    for (const auto& axis : input.grid) {
+        auto expanded = std::vector<SweepCase>{};
+        expanded.reserve(cases.size() * axis.values.size());
+        for (const auto& sweep_case : cases) {
+            for (const auto value : axis.values) {
+                expanded.push_back(sweep_case);
+                set_sweep_parameter(expanded.back(), axis.parameter, value);
+            }
+        }
+        cases = std::move(expanded);
+    }
+    return cases;
+}
+
+rigid_pendulum::HeavyTop create_sweep_heavy_top(const SweepCase& sweep_case) {
+    return rigid_pendulum::HeavyTop(
+        sweep_case.mass, rigid_pendulum::Vec<3>{
+                             {sweep_case.inertia_x, sweep_case.inertia_y, sweep_case.inertia_z}}
+    );
+}
+
+rigid_pendulum::State create_sweep_initial_state(const SweepCase& sweep_case) {
+    using rigid_pendulum::create_cross_product_matrix;
+    using rigid_pendulum::Vec;
+
+    const auto heavy_top = create_sweep_heavy_top(sweep_case);
+    const auto mass = heavy_top.GetMass();
+    const auto inertia = heavy_top.GetMomentOfInertiaMatrix();
+    const auto position = heavy_top.GetReferencePosition();
+    const auto omega = Vec<3>{
+        {sweep_case.angular_velocity_x, sweep_case.angular_velocity_y,
+         sweep_case.angular_velocity_z}};
+
+    // In the reference orientation, the constraint {x} = [R] {X} yields {x'} = ~{Omega} {X} and
+    // {x''} = ~{Omega'} {X} + ~{Omega} ~{Omega} {X}, eliminating the Lagrange multipliers
+    // {Lambda} = m {x''} + {f} from the equations of motion leaves
+    // ([J] - m ~{X} ~{X}) {Omega'} = -~{Omega} [J] {Omega} - ~{X} (m ~{Omega} ~{Omega} {X} + {f})
+    const auto velocity = omega.CrossProduct(position);
+    const auto centripetal_acceleration = omega.CrossProduct(velocity);
+    const auto gravity_force = heavy_top.CalculateForces(Vec<6>{}).GetSegment<3>(0);
+    const auto position_matrix = create_cross_product_matrix(position);
+    const auto angular_acceleration = solve(
+        inertia - position_matrix * position_matrix * mass,
+        -omega.CrossProduct(inertia * omega) -
+            position.CrossProduct(centripetal_acceleration * mass + gravity_force)
+    );
+    const auto acceleration =
+        angular_acceleration.CrossProduct(position) + centripetal_acceleration;
+
+    auto gen_coords = rigid_pendulum::HostView1D("gen_coords", 7);
+    auto v = rigid_pendulum::HostView1D("velocity", 6);
+    auto a = rigid_pendulum::HostView1D("acceleration", 6);
+    auto algo_acceleration = rigid_pendulum::HostView1D("algorithmic_acceleration", 6);
+    for (size_t i = 0; i < 3; ++i) {
+        gen_coords(i) = position(i);
+        v(i) = velocity(i);
+        v(i + 3) = omega(i);
+        a(i) = acceleration(i);
+        a(i + 3) = angular_acceleration(i);
+    }
+    gen_coords(3) = 1.;
+    return rigid_pendulum::State(gen_coords, v, a, algo_acceleration);
+}
+
+SweepCaseSummary run_sweep_case(size_t index, const SweepCase& sweep_case) {
+    using namespace rigid_pendulum;
+
+    auto summary = SweepCaseSummary{};
+    summary.index = index;
+    summary.parameters = sweep_case;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        auto problem = HeavyTopLinearizationParameters(create_sweep_heavy_top(sweep_case));
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            sweep_case.alpha_f, sweep_case.alpha_m, sweep_case.beta, sweep_case.gamma,
+            TimeStepper(
+                sweep_case.initial_time, sweep_case.time_step, sweep_case.n_steps,
+                sweep_case.max_iterations
+            ),
+            true
+        );
+
+        summary.is_converged = true;
+        auto observer = CallbackObserver([&summary](const TimeStepRecord& record) {
+            summary.n_steps = record.step;
+            summary.final_time = record.time;
+            summary.is_converged = summary.is_converged && record.is_converged;
+            const auto gen_coords = record.state.GetGeneralizedCoordinates();
+            const auto velocity = record.state.GetVelocity();
+            for (size_t i = 0; i < 3; ++i) {
+                summary.final_position[i] = gen_coords(i);
+                summary.final_velocity[i] = velocity(i + 3);
+            }
+        });
+        time_integrator.Integrate(
+            create_sweep_initial_state(sweep_case), HeavyTop::kNumberOfConstraints, problem,
+            observer
+        );
+
+        const auto& time_stepper = time_integrator.GetTimeStepper();
+        summary.total_iterations = time_stepper.GetTotalNumberOfIterations();
+        summary.mean_iterations = time_stepper.GetIterationStatistics().GetMean();
+    } catch (const std::exception& e) {
+        summary.is_converged = false;
+        summary.error = e.what();
+    }
+    summary.wall_time =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+std::vector<SweepCaseSummary> run_sweep(const std::vector<SweepCase>& cases, size_t n_threads) {
+    auto summaries = std::vector<SweepCaseSummary>(cases.size());
+    if (n_threads == 0) {
+        n_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    n_threads = std::max<size_t>(std::min(n_threads, cases.size()), 1);
+
+    auto next_case = std::atomic<size_t>(0);
+    const auto work = [&cases, &summaries, &next_case]() {
+        for (auto i = next_case.fetch_add(1); i < cases.size(); i = next_case.fetch_add(1)) {
+            summaries[i] = run_sweep_case(i, cases[i]);
+        }
+    };
+
+#if defined(KOKKOS_ENABLE_OPENMP)
+#pragma omp parallel num_threads(static_cast<int>(n_threads))
+    work();
+#else
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(n_threads - 1);
+    for (size_t i = 1; i < n_threads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+#endif
+
+    return summaries;
+}
+
+void write_sweep_summary(std::ostream& out, const std::vector<SweepCaseSummary>& summaries) {
+    const auto& names = get_sweep_parameter_names();
+    out << "case";
+    for (const auto& name : names) {
+        out << "," << name;
+    }
+    out << ",converged,completed_steps,total_iterations,mean_iterations,wall_time,final_time"
+        << ",x,y,z,omega_x,omega_y,omega_z,error\n";
+
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    for (const auto& summary : summaries) {
+        out << summary.index;
+        for (const auto& name : names) {
+            out << "," << get_sweep_parameter(summary.parameters, name);
+        }
+        out << "," << summary.is_converged << "," << summary.n_steps << ","
+            << summary.total_iterations << "," << summary.mean_iterations << ","
+            << summary.wall_time << "," << summary.final_time;
+        for (const auto value : summary.final_position) {
+            out << "," << value;
+        }
+        for (const auto value : summary.final_velocity) {
+            out << "," << value;
+        }
+        out << ",";
+        write_quoted(out, summary.error);
+        out << "\n";
+    }
+    out.precision(precision);
+}
+
+void write_sweep_summary(
+    const std::string& file_name, const std::vector<SweepCaseSummary>& summaries
+) {
+    auto file = std::ofstream(file_name);
+    if (!file) {
+        throw std::runtime_error("Unable to open the sweep summary file " + file_name);
+    }
+    write_sweep_summary(file, summaries);
+    if (!file) {
+        throw std::runtime_error("Unable to write the sweep summary file " + file_name);
+    }
+}
+
+}  // namespace openturbine::io
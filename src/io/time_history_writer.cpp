@@ -0,0 +1,359 @@
+#include "src/io/time_history_writer.H"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef OTURB_ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace openturbine::io {
+
+namespace {
+
+constexpr char kMAGIC[4] = {'O', 'T', 'T', 'H'};
+constexpr std::uint32_t kVERSION = 1;
+constexpr size_t kRECORD_HEADER_SIZE = 4;  // step, time, number of iterations, convergence flag
+
+template <typename T>
+void write_value(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_value(std::istream& stream) {
+    T value{};
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!stream) {
+        throw std::runtime_error("Unexpected end of the time history file");
+    }
+    return value;
+}
+
+size_t get_record_size(const TimeHistoryMetadata& metadata) {
+    return kRECORD_HEADER_SIZE + metadata.n_coordinates + 3 * metadata.n_velocities +
+           metadata.n_lagrange_mults;
+}
+
+void pack_view(const rigid_pendulum::HostView1D view, std::vector<double>& values) {
+    for (size_t i = 0; i < view.extent(0); ++i) {
+        values.push_back(view(i));
+    }
+}
+
+rigid_pendulum::HostView1D unpack_view(
+    const std::string& name, const double*& values, size_t size
+) {
+    auto view = rigid_pendulum::HostView1D(name, size);
+    for (size_t i = 0; i < size; ++i) {
+        view(i) = *values++;
+    }
+    return view;
+}
+
+}  // namespace
+
+bool is_compression_available(Compression compression) {
+    switch (compression) {
+        case Compression::kNone: {
+            return true;
+        }
+        case Compression::kZlib: {
+#ifdef OTURB_ENABLE_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+TimeHistoryWriter::TimeHistoryWriter(
+    const std::string& file_name, const rigid_pendulum::TimeStepper& time_stepper,
+    size_t chunk_size, Compression compression
+)
+    : file_name_(file_name),
+      metadata_{
+          time_stepper.GetInitialTime(),
+          time_stepper.GetTimeStep(),
+          time_stepper.GetNumberOfSteps(),
+          time_stepper.GetMaximumNumberOfIterations(),
+          0,
+          0,
+          0,
+          chunk_size,
+          compression},
+      chunk_{0, {}},
+      n_records_(0),
+      is_finalized_(false),
+      is_header_written_(false),
+      stop_(false) {
+    if (chunk_size == 0) {
+        throw std::invalid_argument("The number of records per chunk must be > 0");
+    }
+
+    if (!is_compression_available(compression)) {
+        throw std::invalid_argument("The requested compression is not available in this build");
+    }
+
+    file_.open(file_name_, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!file_) {
+        throw std::runtime_error("Unable to open the time history file " + file_name_);
+    }
+
+    thread_ = std::thread([this]() { this->Run(); });
+}
+
+TimeHistoryWriter::~TimeHistoryWriter() {
+    try {
+        this->Finalize();
+    } catch (const std::exception&) {
+        // Errors can only be reported by an explicit call to Finalize()
+    }
+}
+
+void TimeHistoryWriter::Observe(const rigid_pendulum::TimeStepRecord& record) {
+    if (is_finalized_) {
+        throw std::runtime_error("Records cannot be observed after the writer has been finalized");
+    }
+
+    const auto& state = record.state;
+    // The sizes of the first record define the layout of all records in the file
+    if (n_records_ == 0) {
+        metadata_.n_coordinates = state.GetGeneralizedCoordinates().extent(0);
+        metadata_.n_velocities = state.GetVelocity().extent(0);
+        metadata_.n_lagrange_mults = record.lagrange_mults.extent(0);
+    }
+
+    if (state.GetGeneralizedCoordinates().extent(0) != metadata_.n_coordinates ||
+        state.GetVelocity().extent(0) != metadata_.n_velocities ||
+        state.GetAcceleration().extent(0) != metadata_.n_velocities ||
+        state.GetAlgorithmicAcceleration().extent(0) != metadata_.n_velocities ||
+        record.lagrange_mults.extent(0) != metadata_.n_lagrange_mults) {
+        throw std::invalid_argument("All records of a time history must be of the same size");
+    }
+
+    if (chunk_.values.empty()) {
+        chunk_.values.reserve(metadata_.chunk_size * get_record_size(metadata_));
+    }
+
+    auto& values = chunk_.values;
+    values.push_back(static_cast<double>(record.step));
+    values.push_back(record.time);
+    values.push_back(static_cast<double>(record.n_iterations));
+    values.push_back(record.is_converged ? 1. : 0.);
+    pack_view(state.GetGeneralizedCoordinates(), values);
+    pack_view(state.GetVelocity(), values);
+    pack_view(state.GetAcceleration(), values);
+    pack_view(state.GetAlgorithmicAcceleration(), values);
+    pack_view(record.lagrange_mults, values);
+
+    chunk_.n_records++;
+    n_records_++;
+    if (chunk_.n_records == metadata_.chunk_size) {
+        this->SubmitChunk();
+    }
+}
+
+void TimeHistoryWriter::Finalize() {
+    if (is_finalized_) {
+        return;
+    }
+    is_finalized_ = true;
+
+    if (chunk_.n_records > 0) {
+        this->SubmitChunk();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+
+    file_.close();
+    if (!error_.empty()) {
+        throw std::runtime_error(error_);
+    }
+}
+
+void TimeHistoryWriter::SubmitChunk() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(chunk_));
+    }
+    condition_.notify_one();
+    chunk_ = Chunk{0, {}};
+}
+
+void TimeHistoryWriter::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty() && stop_) {
+            break;
+        }
+
+        auto chunk = std::move(queue_.front());
+        queue_.pop_front();
+        const auto is_header_written = is_header_written_;
+        is_header_written_ = true;
+        lock.unlock();
+
+        // The sizes in the metadata are final once the first chunk has been submitted
+        if (!is_header_written) {
+            this->WriteHeader();
+        }
+        this->WriteChunk(chunk);
+
+        lock.lock();
+    }
+
+    // Files without any records still carry the header
+    if (!is_header_written_) {
+        is_header_written_ = true;
+        lock.unlock();
+        this->WriteHeader();
+        lock.lock();
+    }
+
+    file_.flush();
+    if (!file_ && error_.empty()) {
+        error_ = "Unable to write the time history file " + file_name_;
+    }
+}
+
+void TimeHistoryWriter::WriteHeader() {
+    file_.write(kMAGIC, sizeof(kMAGIC));
+    write_value(file_, kVERSION);
+    write_value(file_, metadata_.compression);
+    write_value(file_, metadata_.initial_time);
+    write_value(file_, metadata_.time_step);
+    write_value(file_, static_cast<std::uint64_t>(metadata_.n_steps));
+    write_value(file_, static_cast<std::uint64_t>(metadata_.max_iterations));
+    write_value(file_, static_cast<std::uint64_t>(metadata_.n_coordinates));
+    write_value(file_, static_cast<std::uint64_t>(metadata_.n_velocities));
+    write_value(file_, static_cast<std::uint64_t>(metadata_.n_lagrange_mults));
+    write_value(file_, static_cast<std::uint64_t>(metadata_.chunk_size));
+}
+
+void TimeHistoryWriter::WriteChunk(const Chunk& chunk) {
+    const auto* raw_data = reinterpret_cast<const char*>(chunk.values.data());
+    const auto raw_size = chunk.values.size() * sizeof(double);
+    const char* stored_data = raw_data;
+    auto stored_size = raw_size;
+
+#ifdef OTURB_ENABLE_ZLIB
+    auto compressed = std::vector<Bytef>{};
+    if (metadata_.compression == Compression::kZlib) {
+        auto compressed_size = compressBound(static_cast<uLong>(raw_size));
+        compressed.resize(compressed_size);
+        if (compress2(
+                compressed.data(), &compressed_size, reinterpret_cast<const Bytef*>(raw_data),
+                static_cast<uLong>(raw_size), Z_DEFAULT_COMPRESSION
+            ) != Z_OK) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = "Unable to compress a chunk of the time history file " + file_name_;
+            return;
+        }
+        stored_data = reinterpret_cast<const char*>(compressed.data());
+        stored_size = compressed_size;
+    }
+#endif
+
+    write_value(file_, static_cast<std::uint64_t>(chunk.n_records));
+    write_value(file_, static_cast<std::uint64_t>(raw_size));
+    write_value(file_, static_cast<std::uint64_t>(stored_size));
+    file_.write(stored_data, static_cast<std::streamsize>(stored_size));
+}
+
+TimeHistory read_time_history(const std::string& file_name) {
+    auto file = std::ifstream(file_name, std::ifstream::in | std::ifstream::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open the time history file " + file_name);
+    }
+
+    char magic[sizeof(kMAGIC)];
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + sizeof(magic), kMAGIC) ||
+        read_value<std::uint32_t>(file) != kVERSION) {
+        throw std::runtime_error(file_name + " is not a supported time history file");
+    }
+
+    auto history = TimeHistory{};
+    auto& metadata = history.metadata;
+    metadata.compression = read_value<Compression>(file);
+    metadata.initial_time = read_value<double>(file);
+    metadata.time_step = read_value<double>(file);
+    metadata.n_steps = read_value<std::uint64_t>(file);
+    metadata.max_iterations = read_value<std::uint64_t>(file);
+    metadata.n_coordinates = read_value<std::uint64_t>(file);
+    metadata.n_velocities = read_value<std::uint64_t>(file);
+    metadata.n_lagrange_mults = read_value<std::uint64_t>(file);
+    metadata.chunk_size = read_value<std::uint64_t>(file);
+
+    if (!is_compression_available(metadata.compression)) {
+        throw std::runtime_error("The compression of " + file_name + " is not available");
+    }
+
+    const auto record_size = get_record_size(metadata);
+    while (file.peek() != std::ifstream::traits_type::eof()) {
+        const auto n_records = read_value<std::uint64_t>(file);
+        const auto raw_size = read_value<std::uint64_t>(file);
+        const auto stored_size = read_value<std::uint64_t>(file);
+        if (raw_size != n_records * record_size * sizeof(double)) {
+            throw std::runtime_error("Corrupt chunk in the time history file " + file_name);
+        }
+
+        auto stored = std::vector<char>(stored_size);
+        file.read(stored.data(), static_cast<std::streamsize>(stored_size));
+        if (!file) {
+            throw std::runtime_error("Unexpected end of the time history file");
+        }
+
+        auto values = std::vector<double>(n_records * record_size);
+        if (metadata.compression == Compression::kNone) {
+            if (stored_size != raw_size) {
+                throw std::runtime_error("Corrupt chunk in the time history file " + file_name);
+            }
+            std::copy(stored.begin(), stored.end(), reinterpret_cast<char*>(values.data()));
+        }
+#ifdef OTURB_ENABLE_ZLIB
+        if (metadata.compression == Compression::kZlib) {
+            auto uncompressed_size = static_cast<uLongf>(raw_size);
+            if (uncompress(
+                    reinterpret_cast<Bytef*>(values.data()), &uncompressed_size,
+                    reinterpret_cast<const Bytef*>(stored.data()), static_cast<uLong>(stored_size)
+                ) != Z_OK ||
+                uncompressed_size != raw_size) {
+                throw std::runtime_error("Corrupt chunk in the time history file " + file_name);
+            }
+        }
+#endif
+
+        const double* value = values.data();
+        for (size_t i = 0; i < n_records; ++i) {
+            auto step = static_cast<size_t>(*value++);
+            auto time = *value++;
+            auto n_iterations = static_cast<size_t>(*value++);
+            auto is_converged = *value++ != 0.;
+            auto q = unpack_view("generalized_coordinates", value, metadata.n_coordinates);
+            auto v = unpack_view("velocity", value, metadata.n_velocities);
+            auto v_dot = unpack_view("acceleration", value, metadata.n_velocities);
+            auto a = unpack_view("algorithmic_acceleration", value, metadata.n_velocities);
+            auto lagrange_mults = unpack_view("lagrange_mults", value, metadata.n_lagrange_mults);
+            history.records.push_back(
+                {step, time, rigid_pendulum::State(q, v, v_dot, a), lagrange_mults, n_iterations,
+                 is_converged}
+            );
+        }
+    }
+
+    return history;
+}
+
+}  // namespace openturbine::io
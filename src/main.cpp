@@ -1,20 +1,32 @@
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <filesystem>
+#include <memory>
 
 #include <Kokkos_Core.hpp>
 
 #include "src/OpenTurbineVersion.H"
 #include "src/io/console_io.H"
+#include "src/io/parameter_sweep.H"
+#include "src/rigid_pendulum_poc/distributed_ensemble.h"
+#include "src/utilities/communicator.h"
 #include "src/utilities/debug_utils.H"
 #include "src/utilities/log.h"
+#include "src/utilities/metrics.h"
 
 int main(int argc, char* argv[]) {
     using namespace openturbine;
 
-    if (argc > 2) {
+    // MPI is initialized before Kokkos, so that Kokkos can assign the devices of a node to its
+    // ranks
+    auto mpi_environment = util::MPIEnvironment(argc, argv);
+    const auto communicator = util::Communicator::World();
+
+    const auto is_sweep = argc > 1 && std::string(argv[1]) == "--sweep";
+    if (is_sweep ? (argc < 3 || argc > 5) : argc > 2) {
         // Print usage and exit with error code if no input file was provided.
         io::print_usage(std::cout);
         io::print_error("No input file provided. Exiting.");
@@ -33,28 +45,95 @@ int main(int argc, char* argv[]) {
     }
 
     // TODO Name the logging file based on the provided input file name
-    std::string log_file = "log.txt";
-    if (std::filesystem::exists(log_file)) {
+    // Every rank logs to its own file, and only the first one to the console as well
+    std::string log_file = communicator.GetRankFileName("log.txt");
+    if (std::filesystem::exists(log_file) && communicator.IsRoot()) {
         std::cout << "Overwriting the previously existing log file" << std::endl;
     }
     std::ofstream{log_file};
 
+    const auto log_output =
+        communicator.IsRoot() ? util::OutputType::kConsoleAndFile : util::OutputType::kFile;
 #ifdef DEBUG
-    auto log = util::Log::Get(log_file, util::SeverityLevel::kDebug);
+    auto log = util::Log::Get(log_file, util::SeverityLevel::kDebug, log_output);
 #elif defined RELEASE
-    auto log = util::Log::Get(log_file, util::SeverityLevel::kInfo);
+    auto log = util::Log::Get(log_file, util::SeverityLevel::kInfo, log_output);
 #else
-    auto log = util::Log::Get(log_file, util::SeverityLevel::kNone);
+    auto log = util::Log::Get(log_file, util::SeverityLevel::kNone, log_output);
 #endif
 
     log->Info("openturbine " + version::oturb_version + "\n");
 
     Kokkos::initialize(argc, argv);
 
-    std::cout << "Hello from Open Turbine! (Note to Faisal: What should the program do here?)"
-              << std::endl;
+    // Export the metrics of the solvers periodically if requested, e.g. OTURB_METRICS_FILE=
+    // metrics.prom for the Prometheus text format, any other extension for JSON lines
+    auto metrics_exporter = std::unique_ptr<util::MetricsExporter>{};
+    if (const auto* metrics_file = std::getenv("OTURB_METRICS_FILE")) {
+        const auto file_name = communicator.GetRankFileName(metrics_file);
+        const auto format = std::filesystem::path(file_name).extension() == ".prom"
+                                ? util::MetricsFormat::kPrometheus
+                                : util::MetricsFormat::kJsonLines;
+        const auto* interval = std::getenv("OTURB_METRICS_INTERVAL");
+        const auto interval_seconds = (interval != nullptr) ? std::atof(interval) : 10.;
+        try {
+            auto& registry = util::MetricsRegistry::Get();
+            metrics_exporter = std::make_unique<util::MetricsExporter>(
+                registry, file_name, format,
+                std::chrono::milliseconds(static_cast<long>(1000. * interval_seconds))
+            );
+            registry.EnableAllocationTracking();
+            log->Info("Exporting the metrics to " + file_name + "\n");
+        } catch (const std::exception& e) {
+            io::print_error(e.what());
+        }
+    }
+
+    auto exit_code = 0;
+    if (is_sweep) {
+        // Runs the cases of the sweep of this rank in this process, i.e. Kokkos is initialized
+        // only once - every rank writes the summary of its cases to its own file
+        try {
+            const auto summary_file = communicator.GetRankFileName(
+                std::string(argc > 3 ? argv[3] : "sweep_summary.csv")
+            );
+            const auto n_threads = static_cast<size_t>(argc > 4 ? std::stoul(argv[4]) : 0);
+            const auto all_cases = io::create_sweep_cases(io::read_sweep_input(argv[2]));
+            const auto partition = rigid_pendulum::partition_ensemble(
+                all_cases.size(), communicator.GetSize(), communicator.GetRank()
+            );
+            const auto first_case = all_cases.begin() + static_cast<long>(partition.first_body);
+            const auto cases = std::vector<io::SweepCase>(
+                first_case, first_case + static_cast<long>(partition.n_bodies)
+            );
+            std::cout << "Running " << cases.size() << " of " << all_cases.size()
+                      << " sweep cases" << std::endl;
+
+            auto summaries = io::run_sweep(cases, n_threads);
+            for (auto& summary : summaries) {
+                summary.index += partition.first_body;
+            }
+            io::write_sweep_summary(summary_file, summaries);
+
+            const auto n_failed = std::count_if(
+                summaries.begin(), summaries.end(),
+                [](const io::SweepCaseSummary& summary) { return !summary.is_converged; }
+            );
+            std::cout << "Wrote the summary of the sweep to " << summary_file << ", " << n_failed
+                      << " of " << summaries.size() << " cases did not converge" << std::endl;
+        } catch (const std::exception& e) {
+            io::print_error(e.what());
+            exit_code = 1;
+        }
+    } else {
+        std::cout
+            << "Hello from Open Turbine! (Note to Faisal: What should the program do here?)"
+            << std::endl;
+    }
 
+    // Writes the final metrics before Kokkos is finalized
+    metrics_exporter.reset();
     Kokkos::finalize();
 
-    return 0;
+    return exit_code;
 }
@@ -0,0 +1,82 @@
+#include "src/rigid_pendulum_poc/automatic_differentiation.h"
+
+#include <algorithm>
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+/// Returns the (block row, block column) pairs of the stored blocks of the provided matrix
+std::vector<std::pair<size_t, size_t>> get_nonzero_blocks(const BlockSparseMatrix& matrix) {
+    auto nonzero_blocks = std::vector<std::pair<size_t, size_t>>{};
+    nonzero_blocks.reserve(matrix.GetNumberOfNonZeroBlocks());
+    const auto& row_offsets = matrix.GetRowOffsets();
+    for (size_t block_row = 0; block_row < matrix.GetNumberOfBlockRows(); ++block_row) {
+        for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1]; ++index) {
+            nonzero_blocks.emplace_back(block_row, matrix.GetColumnIndices()[index]);
+        }
+    }
+    return nonzero_blocks;
+}
+
+}  // namespace
+
+JacobianColoring::JacobianColoring(const BlockSparseMatrix& pattern)
+    : pattern_(pattern.GetBlockSizes(), get_nonzero_blocks(pattern)),
+      colors_(pattern.GetNumberOfRows(), 0),
+      color_view_("colors", pattern.GetNumberOfRows()) {
+    const auto n_blocks = pattern_.GetNumberOfBlockRows();
+    const auto& sizes = pattern_.GetBlockSizes();
+    const auto& offsets = pattern_.GetBlockOffsets();
+    const auto& row_offsets = pattern_.GetRowOffsets();
+    const auto& column_indices = pattern_.GetColumnIndices();
+
+    // The block rows of every block column, i.e. the transposed pattern
+    auto column_rows = std::vector<std::vector<size_t>>(n_blocks);
+    for (size_t block_row = 0; block_row < n_blocks; ++block_row) {
+        for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1]; ++index) {
+            column_rows[column_indices[index]].push_back(block_row);
+        }
+    }
+
+    // Greedy distance-2 coloring of the block columns: the columns of a block take the smallest
+    // colors not used by any colored column that shares one of its block rows
+    auto is_colored = std::vector<bool>(n_blocks, false);
+    auto forbidden = std::vector<size_t>{};
+    for (size_t block_column = 0; block_column < n_blocks; ++block_column) {
+        forbidden.clear();
+        for (const auto block_row : column_rows[block_column]) {
+            for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1];
+                 ++index) {
+                const auto neighbor = column_indices[index];
+                if (!is_colored[neighbor]) {
+                    continue;
+                }
+                for (size_t j = 0; j < sizes[neighbor]; ++j) {
+                    forbidden.push_back(colors_[offsets[neighbor] + j]);
+                }
+            }
+        }
+        std::sort(forbidden.begin(), forbidden.end());
+        forbidden.erase(std::unique(forbidden.begin(), forbidden.end()), forbidden.end());
+
+        auto color = size_t{0};
+        auto next_forbidden = forbidden.begin();
+        for (size_t j = 0; j < sizes[block_column]; ++j, ++color) {
+            while (next_forbidden != forbidden.end() && *next_forbidden == color) {
+                ++next_forbidden;
+                ++color;
+            }
+            colors_[offsets[block_column] + j] = color;
+            color_view_(offsets[block_column] + j) = color;
+            n_colors_ = std::max(n_colors_, color + 1);
+        }
+        is_colored[block_column] = true;
+    }
+}
+
+BlockSparseMatrix JacobianColoring::CreateJacobian() const {
+    return BlockSparseMatrix(pattern_.GetBlockSizes(), get_nonzero_blocks(pattern_));
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/block_sparse_matrix.h"
+#include "src/rigid_pendulum_poc/dual_number.h"
+#include "src/rigid_pendulum_poc/execution_policy.h"
+#include "src/rigid_pendulum_poc/linearization_parameters.h"
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "src/rigid_pendulum_poc/quaternion.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// A 1D Kokkos view of the provided scalar type on the host, i.e. a HostView1D for doubles
+template <typename Scalar>
+using ScalarHostView1D = Kokkos::View<Scalar*, Kokkos::HostSpace>;
+
+/// Default number of derivatives of the dual numbers of a sweep, i.e. of the colors seeded at once
+inline constexpr size_t kDefaultNumberOfDerivatives = 8;
+
+/*! @brief A coloring of the columns of a block sparse Jacobian, i.e. groups of columns that do
+ *      not share a structurally non-zero row, so that one directional derivative per group
+ *      yields all of their columns at once (Curtis, Powell, and Reid 1974)
+ *  @details The columns are colored greedily, block column by block column, with the smallest
+ *      color that none of the columns of a shared block row uses yet - the columns of a block
+ *      are always distinct, since they share its rows. For multibody models every body couples
+ *      only to its joints and every joint only to its two bodies, i.e. the number of colors is
+ *      bounded by the block sizes and the number of joints per body, independent of the number
+ *      of bodies. Evaluate() computes the Jacobian of a function templated on its scalar type
+ *      with ceil(colors / N) evaluations on Dual<N> numbers.
+ */
+class JacobianColoring {
+public:
+    /// Colors the columns of the sparsity pattern of the provided (square) matrix
+    JacobianColoring(const BlockSparseMatrix& pattern = BlockSparseMatrix());
+
+    /// Returns the sparsity pattern of the colored Jacobian, i.e. a zero matrix
+    inline const BlockSparseMatrix& GetPattern() const { return pattern_; }
+
+    /// Returns a new zero matrix with the sparsity pattern of the coloring, i.e. one that does
+    /// not share its values with the pattern
+    BlockSparseMatrix CreateJacobian() const;
+
+    /// Returns the color of every (scalar) column
+    inline const std::vector<size_t>& GetColors() const { return colors_; }
+
+    /// Returns the number of colors
+    inline size_t GetNumberOfColors() const { return n_colors_; }
+
+    /// Returns the number of function evaluations of the Jacobian with the provided number of
+    /// derivatives per dual number
+    inline size_t GetNumberOfSweeps(size_t n_derivatives) const {
+        return (n_colors_ + n_derivatives - 1) / n_derivatives;
+    }
+
+    /*! @brief Calculates the Jacobian of the provided function at the provided point into the
+     *      provided matrix, which must have the sparsity pattern of the coloring
+     *  @details The function is called as function(x, f) with ScalarHostView1D<Dual<N>> views of
+     *      its arguments and of its values, i.e. it is evaluated on dual numbers and may run
+     *      Kokkos kernels over them. Every sweep seeds N colors, i.e. sets the derivative of all
+     *      columns of the i-th seeded color to the i-th unit vector, and scatters the derivatives
+     *      of the values into the stored blocks of these columns. Entries outside the pattern
+     *      are assumed to be zero.
+     */
+    template <size_t N, typename Function>
+    void Evaluate(const Function& function, const HostView1D x, BlockSparseMatrix& jacobian) const {
+        const auto size = pattern_.GetNumberOfRows();
+        if (x.extent(0) != size || jacobian.GetNumberOfRows() != size ||
+            jacobian.GetBlockSizes() != pattern_.GetBlockSizes() ||
+            jacobian.GetColumnIndices() != pattern_.GetColumnIndices()) {
+            throw std::invalid_argument(
+                "The provided point and Jacobian must match the sparsity pattern of the coloring"
+            );
+        }
+
+        const auto colors = color_view_;
+        auto x_dual = ScalarHostView1D<Dual<N>>("x_dual", size);
+        auto f_dual = ScalarHostView1D<Dual<N>>("f_dual", size);
+        const auto& offsets = pattern_.GetBlockOffsets();
+        const auto& row_offsets = pattern_.GetRowOffsets();
+        const auto& column_indices = pattern_.GetColumnIndices();
+        for (size_t sweep = 0; sweep < this->GetNumberOfSweeps(N); ++sweep) {
+            const auto first_color = sweep * N;
+            host_parallel_for(
+                "seed_colors", size,
+                KOKKOS_LAMBDA(const size_t i) {
+                    x_dual(i) = (colors(i) >= first_color && colors(i) < first_color + N)
+                                    ? Dual<N>(x(i), colors(i) - first_color)
+                                    : Dual<N>(x(i));
+                    f_dual(i) = Dual<N>();
+                }
+            );
+            function(x_dual, f_dual);
+
+            for (size_t block_row = 0; block_row < pattern_.GetNumberOfBlockRows(); ++block_row) {
+                for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1];
+                     ++index) {
+                    const auto block_column = column_indices[index];
+                    const auto block = jacobian.GetBlock(block_row, block_column);
+                    for (size_t j = 0; j < block.extent(1); ++j) {
+                        const auto color = colors_[offsets[block_column] + j];
+                        if (color < first_color || color >= first_color + N) {
+                            continue;
+                        }
+                        for (size_t i = 0; i < block.extent(0); ++i) {
+                            block(i, j) = f_dual(offsets[block_row] + i)
+                                              .GetDerivative(color - first_color);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    BlockSparseMatrix pattern_;                            //< Sparsity pattern of the Jacobian
+    std::vector<size_t> colors_;                           //< Color of every column
+    Kokkos::View<size_t*, Kokkos::HostSpace> color_view_;  //< Colors, for the seeding kernel
+    size_t n_colors_ = 0;                                  //< Number of colors
+};
+
+/// Returns the unit quaternion of the provided rotation vector, i.e. its exponential map,
+/// evaluated on any scalar type - small angles use the Taylor series of the coefficients, so
+/// that the derivatives of dual numbers are finite at zero
+template <typename Scalar>
+KOKKOS_INLINE_FUNCTION Vec<4, Scalar> calculate_exponential_map_quaternion(
+    const Vec<3, Scalar>& psi
+) {
+    using Kokkos::cos;
+    using Kokkos::sin;
+    using Kokkos::sqrt;
+    constexpr double kSmallAngleSquared = 0.02;
+
+    const auto a2 = psi.DotProduct(psi);
+    auto cos_half = Scalar(1.);
+    auto vector_factor = Scalar(0.5);
+    if (value_of(a2) < kSmallAngleSquared) {
+        const auto a4 = a2 * a2;
+        cos_half = 1. - a2 / 8. + a4 / 384. - a4 * a2 / 46080. + a4 * a4 / 10321920.;
+        vector_factor = 0.5 - a2 / 48. + a2 * a2 / 3840. - a2 * a2 * a2 / 645120.;
+    } else {
+        const auto angle = sqrt(a2);
+        cos_half = cos(angle * 0.5);
+        vector_factor = sin(angle * 0.5) / angle;
+    }
+    return Vec<4, Scalar>{
+        {cos_half, psi(0) * vector_factor, psi(1) * vector_factor, psi(2) * vector_factor}};
+}
+
+/// Returns the product of the provided quaternions, stored as {q0, q1, q2, q3}
+template <typename Scalar>
+KOKKOS_INLINE_FUNCTION constexpr Vec<4, Scalar> multiply_quaternions(
+    const Vec<4, Scalar>& a, const Vec<4, Scalar>& b
+) {
+    return Vec<4, Scalar>{
+        {a(0) * b(0) - a(1) * b(1) - a(2) * b(2) - a(3) * b(3),
+         a(0) * b(1) + a(1) * b(0) + a(2) * b(3) - a(3) * b(2),
+         a(0) * b(2) - a(1) * b(3) + a(2) * b(0) + a(3) * b(1),
+         a(0) * b(3) + a(1) * b(2) - a(2) * b(1) + a(3) * b(0)}};
+}
+
+/*! @brief Linearization parameters of a model that only defines its residual vector, i.e. whose
+ *      iteration matrix is generated with forward-mode automatic differentiation
+ *  @details The residual is a functor templated on its scalar type, called as
+ *      residual(gen_coords, velocity, acceleration, lagrange_mults, residual_vector) with
+ *      ScalarHostView1D views, e.g. of doubles for the residual vector and of Dual<N> numbers
+ *      for the iteration matrix. The generalized coordinates are ordered by body, 7 per body,
+ *      i.e. the model is a multibody model like MultibodyModel. The iteration matrix is the
+ *      derivative of the residual vector with respect to the solution increments, i.e. the
+ *      state of the iterate is perturbed the same way the time integrator updates it: the
+ *      positions by the increments, the quaternions by the exponential map of the rotational
+ *      increments composed with the rotation of the time step, the velocities and accelerations
+ *      by gamma' and beta' times the increments, and the Lagrange multipliers directly. The
+ *      provided sparsity pattern of the iteration matrix is colored once, so that every
+ *      iteration matrix costs a constant number of residual sweeps on dual numbers, see
+ *      JacobianColoring.
+ */
+template <typename Residual, size_t N = kDefaultNumberOfDerivatives>
+class AutomaticDifferentiationLinearizationParameters final : public LinearizationParameters {
+public:
+    /// Constructs the linearization parameters of the provided residual, whose iteration matrix
+    /// has the sparsity pattern of the provided matrix
+    AutomaticDifferentiationLinearizationParameters(
+        Residual residual, const BlockSparseMatrix& pattern
+    )
+        : residual_(std::move(residual)), coloring_(pattern) {}
+
+    /// Returns the residual functor of the model
+    inline const Residual& GetResidual() const { return residual_; }
+
+    /// Returns the coloring of the sparsity pattern of the iteration matrix
+    inline const JacobianColoring& GetColoring() const { return coloring_; }
+
+    virtual HostView1D ResidualVector(
+        const HostView1D gen_coords, const HostView1D velocity, const HostView1D acceleration,
+        const HostView1D lagrange_mults
+    ) override {
+        auto residual_vector =
+            HostView1D("residual_vector", coloring_.GetPattern().GetNumberOfRows());
+        residual_(gen_coords, velocity, acceleration, lagrange_mults, residual_vector);
+        return residual_vector;
+    }
+
+    virtual HostView2D IterationMatrix(
+        const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+        const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+        const HostView1D acceleration, const HostView1D lagrange_mults
+    ) override {
+        return this
+            ->SparseIterationMatrix(
+                h, BETA_PRIME, GAMMA_PRIME, gen_coords, delta_gen_coords, velocity, acceleration,
+                lagrange_mults
+            )
+            .ToDense();
+    }
+
+    /// Returns the iteration matrix generated from ceil(colors / N) residual sweeps on dual
+    /// numbers, in the block sparse format of the provided pattern
+    virtual BlockSparseMatrix SparseIterationMatrix(
+        const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+        const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+        const HostView1D acceleration, const HostView1D lagrange_mults
+    ) override {
+        constexpr auto kCOORDINATES = 7;
+        constexpr auto kVELOCITIES = 6;
+        const auto n_bodies = gen_coords.extent(0) / kCOORDINATES;
+        const auto n_velocities = n_bodies * kVELOCITIES;
+        const auto size = coloring_.GetPattern().GetNumberOfRows();
+        if (gen_coords.extent(0) != n_bodies * kCOORDINATES ||
+            delta_gen_coords.extent(0) != n_velocities || velocity.extent(0) != n_velocities ||
+            acceleration.extent(0) != n_velocities ||
+            lagrange_mults.extent(0) != size - n_velocities) {
+            throw std::invalid_argument("The provided views do not match the sparsity pattern");
+        }
+
+        using Scalar = Dual<N>;
+        auto gen_coords_dual = ScalarHostView1D<Scalar>("gen_coords_dual", gen_coords.extent(0));
+        auto velocity_dual = ScalarHostView1D<Scalar>("velocity_dual", n_velocities);
+        auto acceleration_dual = ScalarHostView1D<Scalar>("acceleration_dual", n_velocities);
+        auto lagrange_mults_dual =
+            ScalarHostView1D<Scalar>("lagrange_mults_dual", lagrange_mults.extent(0));
+        const auto residual = residual_;
+        const auto perturbed_residual = [=](const ScalarHostView1D<Scalar> increments,
+                                            ScalarHostView1D<Scalar> residual_vector) {
+            // Perturb the iterate the same way the solution increments update it - the
+            // quaternions of the iterate are those of the time step, q_n * exp(h * dq), i.e. the
+            // perturbed ones are q_n * exp(h * dq + increment)
+            host_parallel_for(
+                "perturb_bodies", n_bodies,
+                KOKKOS_LAMBDA(const size_t body) {
+                    const auto q = body * kCOORDINATES;
+                    const auto v = body * kVELOCITIES;
+                    for (size_t i = 0; i < 3; ++i) {
+                        gen_coords_dual(q + i) = gen_coords(q + i) + increments(v + i);
+                    }
+                    auto psi = Vec<3, Scalar>{};
+                    for (size_t i = 0; i < 3; ++i) {
+                        psi(i) = delta_gen_coords(v + 3 + i) * h + increments(v + 3 + i);
+                    }
+                    const auto step_rotation = quaternion_from_rotation_vector(Vector(
+                        delta_gen_coords(v + 3) * h, delta_gen_coords(v + 4) * h,
+                        delta_gen_coords(v + 5) * h
+                    ));
+                    const auto orientation =
+                        Quaternion(
+                            gen_coords(q + 3), gen_coords(q + 4), gen_coords(q + 5),
+                            gen_coords(q + 6)
+                        ) *
+                        step_rotation.GetConjugate();
+                    const auto perturbed_orientation = multiply_quaternions(
+                        Vec<4, Scalar>{
+                            {Scalar(orientation.GetScalarComponent()),
+                             Scalar(orientation.GetXComponent()),
+                             Scalar(orientation.GetYComponent()),
+                             Scalar(orientation.GetZComponent())}},
+                        calculate_exponential_map_quaternion(psi)
+                    );
+                    for (size_t i = 0; i < 4; ++i) {
+                        gen_coords_dual(q + 3 + i) = perturbed_orientation(i);
+                    }
+                    for (size_t i = 0; i < kVELOCITIES; ++i) {
+                        velocity_dual(v + i) = velocity(v + i) + increments(v + i) * GAMMA_PRIME;
+                        acceleration_dual(v + i) =
+                            acceleration(v + i) + increments(v + i) * BETA_PRIME;
+                    }
+                }
+            );
+            host_parallel_for(
+                "perturb_lagrange_mults", lagrange_mults.extent(0),
+                KOKKOS_LAMBDA(const size_t i) {
+                    lagrange_mults_dual(i) = lagrange_mults(i) + increments(n_velocities + i);
+                }
+            );
+            residual(
+                gen_coords_dual, velocity_dual, acceleration_dual, lagrange_mults_dual,
+                residual_vector
+            );
+        };
+
+        auto iteration_matrix = coloring_.CreateJacobian();
+        coloring_.Evaluate<N>(perturbed_residual, HostView1D("increments", size), iteration_matrix);
+        return iteration_matrix;
+    }
+
+    /// Returns true, since the products with the sparse iteration matrix only require O(n)
+    /// memory and work
+    inline bool HasJacobianVectorProduct() const override { return true; }
+
+private:
+    Residual residual_;          //< Residual functor, templated on its scalar type
+    JacobianColoring coloring_;  //< Coloring of the sparsity pattern of the iteration matrix
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,445 @@
+#include "src/rigid_pendulum_poc/batched_generalized_alpha_time_integrator.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#include "src/rigid_pendulum_poc/batched_solver.h"
+#include "src/utilities/log.h"
+
+namespace openturbine::rigid_pendulum {
+
+template <typename ExecutionSpace>
+BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::BatchedGeneralizedAlphaTimeIntegrator(
+    double alpha_f, double alpha_m, double beta, double gamma, TimeStepper time_stepper,
+    bool precondition
+)
+    : kALPHA_F_(alpha_f),
+      kALPHA_M_(alpha_m),
+      kBETA_(beta),
+      kGAMMA_(gamma),
+      time_stepper_(std::move(time_stepper)),
+      precondition_(precondition) {
+    if (this->kALPHA_F_ < 0 || this->kALPHA_F_ > 1) {
+        throw std::invalid_argument("Invalid value for alpha_f");
+    }
+
+    if (this->kALPHA_M_ < 0 || this->kALPHA_M_ > 1) {
+        throw std::invalid_argument("Invalid value for alpha_m");
+    }
+
+    if (this->kBETA_ < 0 || this->kBETA_ > 0.50) {
+        throw std::invalid_argument("Invalid value for beta");
+    }
+
+    if (this->kGAMMA_ < 0 || this->kGAMMA_ > 1) {
+        throw std::invalid_argument("Invalid value for gamma");
+    }
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::Integrate(
+    BatchedStateType& states, const BodiesView bodies
+) {
+    this->ResetDiagnostics(states, bodies);
+    this->IntegrateSteps(0, states, bodies, StepCallback());
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::Integrate(
+    BatchedStateType& states, const BodiesView bodies, const StepCallback& on_step
+) {
+    this->ResetDiagnostics(states, bodies);
+    this->IntegrateSteps(0, states, bodies, on_step);
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::Restart(
+    const BatchedCheckpoint& checkpoint, BatchedStateType& states, const BodiesView bodies,
+    const StepCallback& on_step
+) {
+    if (checkpoint.step > this->time_stepper_.GetNumberOfSteps()) {
+        throw std::invalid_argument("The checkpoint is past the last time step of the analysis");
+    }
+
+    copy_batched_state(states, checkpoint.states);
+    this->time_stepper_.SetCurrentTime(checkpoint.current_time);
+    this->time_stepper_.SetTotalNumberOfIterations(checkpoint.total_n_iterations);
+
+    OTURB_LOG_INFO(
+        "Restarting time integration of the ensemble after step number " +
+        std::to_string(checkpoint.step) + "\n"
+    );
+    this->IntegrateSteps(checkpoint.step, states, bodies, on_step);
+}
+
+template <typename ExecutionSpace>
+BatchedCheckpoint BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::CreateCheckpoint(
+    size_t step, const BatchedStateType& states
+) const {
+    auto checkpoint = BatchedCheckpoint{
+        step, this->time_stepper_.GetCurrentTime(),
+        this->time_stepper_.GetTotalNumberOfIterations(),
+        BatchedState<Kokkos::HostSpace>(
+            states.GetNumberOfBodies(), states.GetGeneralizedCoordinates().extent(0),
+            states.GetVelocity().extent(0), states.GetLagrangeMultipliers().extent(0)
+        )};
+    copy_batched_state(checkpoint.states, states);
+    return checkpoint;
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::SetCheckpointPolicy(
+    const CheckpointPolicy& policy
+) {
+    if (policy.interval > 0 && policy.file_name.empty()) {
+        throw std::invalid_argument("A file name must be provided to write checkpoints");
+    }
+
+    this->checkpoint_policy_ = policy;
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::SetDiagnosticsPolicy(
+    const DiagnosticsPolicy& policy
+) {
+    if (!(policy.renormalization_threshold > 0.)) {
+        throw std::invalid_argument("The renormalization threshold must be > 0");
+    }
+
+    this->diagnostics_policy_ = policy;
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::ResetDiagnostics(
+    const BatchedStateType& states, const BodiesView bodies
+) {
+    if (!this->diagnostics_policy_.is_enabled) {
+        this->diagnostics_ = InvariantDiagnosticsView1D<memory_space>();
+        return;
+    }
+
+    const auto n_bodies = states.GetNumberOfBodies();
+    if (bodies.extent(0) != n_bodies) {
+        throw std::invalid_argument("The number of bodies must match the number of states");
+    }
+
+    this->diagnostics_ = InvariantDiagnosticsView1D<memory_space>("diagnostics", n_bodies);
+    const auto diagnostics = this->diagnostics_;
+    const auto gen_coords = states.GetGeneralizedCoordinates();
+    const auto velocity = states.GetVelocity();
+    Kokkos::parallel_for(
+        "batched_initial_diagnostics", Kokkos::RangePolicy<ExecutionSpace>(0, n_bodies),
+        KOKKOS_LAMBDA(const size_t body) {
+            auto q = Vec<7>{};
+            for (size_t i = 0; i < HeavyTop::kNumberOfGeneralizedCoordinates; ++i) {
+                q(i) = gen_coords(i, body);
+            }
+            auto v = Vec<6>{};
+            for (size_t i = 0; i < HeavyTop::kNumberOfVelocities; ++i) {
+                v(i) = velocity(i, body);
+            }
+            diagnostics(body).Accumulate(bodies(body).CalculateInvariants(q, v));
+        }
+    );
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::IntegrateSteps(
+    size_t first_step, BatchedStateType& states, const BodiesView bodies,
+    const StepCallback& on_step
+) {
+    const auto checkpoint_interval = this->checkpoint_policy_.interval;
+    auto n_steps = this->time_stepper_.GetNumberOfSteps();
+    for (size_t i = first_step; i < n_steps; i++) {
+        this->time_stepper_.AdvanceTimeStep();
+        OTURB_LOG_INFO(
+            "** Integrating step number " + std::to_string(i + 1) + " of the ensemble **\n"
+        );
+        this->AlphaStep(states, bodies);
+        if (on_step) {
+            on_step(i + 1, states);
+        }
+        if (checkpoint_interval > 0 && (i + 1) % checkpoint_interval == 0) {
+            // Only the copy to the host is synchronous, the next steps overlap with the write
+            checkpoint_writer_.Write(
+                this->checkpoint_policy_.file_name, this->CreateCheckpoint(i + 1, states)
+            );
+        }
+    }
+    checkpoint_writer_.Wait();
+
+    OTURB_LOG_INFO("Time integration of the ensemble has completed!\n");
+}
+
+template <typename ExecutionSpace>
+void BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::AlphaStep(
+    BatchedStateType& states, const BodiesView bodies
+) {
+    using TeamPolicy = Kokkos::TeamPolicy<ExecutionSpace>;
+    using ScratchSpace = typename ExecutionSpace::scratch_memory_space;
+    using ScratchView1D = Kokkos::View<double*, ScratchSpace, Kokkos::MemoryUnmanaged>;
+    using ScratchView2D = Kokkos::View<double**, ScratchSpace, Kokkos::MemoryUnmanaged>;
+    using ScratchIntView1D = Kokkos::View<int*, ScratchSpace, Kokkos::MemoryUnmanaged>;
+
+    Kokkos::Profiling::ScopedRegion alpha_step_region("BatchedGeneralizedAlpha::AlphaStep");
+    const auto step_start = std::chrono::steady_clock::now();
+
+    const auto n_bodies = states.GetNumberOfBodies();
+    if (bodies.extent(0) != n_bodies) {
+        throw std::invalid_argument("The number of bodies must match the number of states");
+    }
+
+    const auto gen_coords = states.GetGeneralizedCoordinates();
+    const auto velocity = states.GetVelocity();
+    const auto acceleration = states.GetAcceleration();
+    const auto algo_acceleration = states.GetAlgorithmicAcceleration();
+    const auto lagrange_mults = states.GetLagrangeMultipliers();
+
+    if (gen_coords.extent(0) != HeavyTop::kNumberOfGeneralizedCoordinates ||
+        velocity.extent(0) != HeavyTop::kNumberOfVelocities ||
+        lagrange_mults.extent(0) != HeavyTop::kNumberOfConstraints) {
+        throw std::invalid_argument(
+            "The number of generalized coordinates, velocities, and constraints of the states "
+            "must be 7, 6, and 3 for the lie group based generalized alpha integrator"
+        );
+    }
+
+    if (n_iterations_.extent(0) != n_bodies) {
+        n_iterations_ = IntView1D<memory_space>("n_iterations", n_bodies);
+        converged_ = IntView1D<memory_space>("converged", n_bodies);
+    }
+    const auto n_iterations = n_iterations_;
+    const auto converged = converged_;
+
+    const auto h = this->time_stepper_.GetTimeStep();
+    const auto max_iterations = this->time_stepper_.GetMaximumNumberOfIterations();
+    const auto precondition = this->precondition_;
+
+    // The diagnostics of a restarted integration start with its first time step
+    if (this->diagnostics_policy_.is_enabled && diagnostics_.extent(0) != n_bodies) {
+        diagnostics_ = InvariantDiagnosticsView1D<memory_space>("diagnostics", n_bodies);
+    }
+    const auto is_diagnosed = this->diagnostics_policy_.is_enabled;
+    const auto diagnostics = this->diagnostics_;
+    const auto renormalization_threshold = this->diagnostics_policy_.renormalization_threshold;
+
+    const double kALPHA_F_local = kALPHA_F_;
+    const double kALPHA_M_local = kALPHA_M_;
+    const double kBETA_local = kBETA_;
+    const double kGAMMA_local = kGAMMA_;
+    const auto BETA_PRIME = (1 - kALPHA_M_) / (h * h * kBETA_ * (1 - kALPHA_F_));
+    const auto GAMMA_PRIME = kGAMMA_ / (h * kBETA_);
+
+    constexpr size_t kSize = HeavyTop::kNumberOfVelocities;
+    constexpr size_t kSystemSize = HeavyTop::kSystemSize;
+
+    // One team per body - the iteration matrix, residual/solution vector, and pivots of each body
+    // live in the scratch memory of its team
+    const auto scratch_size = ScratchView2D::shmem_size(kSystemSize, kSystemSize) +
+                              ScratchView1D::shmem_size(kSystemSize) +
+                              ScratchIntView1D::shmem_size(kSystemSize);
+    auto policy = TeamPolicy(static_cast<int>(n_bodies), Kokkos::AUTO)
+                      .set_scratch_size(0, Kokkos::PerTeam(scratch_size));
+
+    Kokkos::parallel_for(
+        "batched_alpha_step", policy,
+        KOKKOS_LAMBDA(const typename TeamPolicy::member_type& member) {
+            const size_t body = member.league_rank();
+            const auto heavy_top = bodies(body);
+            auto iteration_matrix = ScratchView2D(member.team_scratch(0), kSystemSize, kSystemSize);
+            auto soln_increments = ScratchView1D(member.team_scratch(0), kSystemSize);
+            auto pivots = ScratchIntView1D(member.team_scratch(0), kSystemSize);
+
+            // Every thread of the team holds its own (identical) copy of the small state
+            // vectors, so that only the linear solve needs to be shared through scratch memory
+            auto q = Vec<7>{};
+            for (size_t i = 0; i < HeavyTop::kNumberOfGeneralizedCoordinates; ++i) {
+                q(i) = gen_coords(i, body);
+            }
+
+            // Algorithm from Table 1, Brüls, Cardona, and Arnold 2012
+            auto algo_acceleration_next = Vec<kSize>{};
+            auto delta_gen_coords = Vec<kSize>{};
+            auto v = Vec<kSize>{};
+            auto a = Vec<kSize>{};
+            auto lambda = Vec<HeavyTop::kNumberOfConstraints>{};
+            for (size_t i = 0; i < kSize; ++i) {
+                algo_acceleration_next(i) = (kALPHA_F_local * acceleration(i, body) -
+                                             kALPHA_M_local * algo_acceleration(i, body)) /
+                                            (1. - kALPHA_M_local);
+                delta_gen_coords(i) = velocity(i, body) +
+                                      h * (0.5 - kBETA_local) * algo_acceleration(i, body) +
+                                      h * kBETA_local * algo_acceleration_next(i);
+                v(i) = velocity(i, body) + h * (1 - kGAMMA_local) * algo_acceleration(i, body) +
+                       h * kGAMMA_local * algo_acceleration_next(i);
+            }
+
+            // Newton-Raphson iterations, until this body has converged
+            auto q_next = q;
+            size_t iteration = 0;
+            bool is_converged = false;
+            for (; iteration < max_iterations; ++iteration) {
+                // The exponential map of the rotational increment provides both the update of
+                // the orientation and the tangent operator of the iteration matrix
+                const auto psi = delta_gen_coords.GetSegment<3>(3) * h;
+                const auto exponential_map = ExponentialMap::Calculate(psi);
+                q_next =
+                    UpdateGeneralizedCoordinates(q, delta_gen_coords, h, exponential_map.quaternion);
+
+                Kokkos::single(Kokkos::PerTeam(member), [&]() {
+                    auto residuals = Vec<kSystemSize>{};
+                    auto matrix = Matrix<kSystemSize, kSystemSize>{};
+                    heavy_top.Linearize(
+                        BETA_PRIME, GAMMA_PRIME,
+                        RigidBodyKinematics::Calculate(q_next, psi, exponential_map), q_next, v, a,
+                        lambda, residuals, true, matrix
+                    );
+                    for (size_t i = 0; i < kSystemSize; ++i) {
+                        soln_increments(i) = residuals(i);
+                        for (size_t j = 0; j < kSystemSize; ++j) {
+                            iteration_matrix(i, j) = matrix(i, j);
+                        }
+                    }
+                });
+                member.team_barrier();
+
+                double residual_norm = 0.;
+                for (size_t i = 0; i < kSystemSize; ++i) {
+                    residual_norm += soln_increments(i) * soln_increments(i);
+                }
+                if (Kokkos::sqrt(residual_norm) < kCONVERGENCETOLERANCE) {
+                    is_converged = true;
+                    break;
+                }
+                member.team_barrier();
+
+                if (precondition) {
+                    // Precondition the linear solve with the diagonal scaling of Bottasso et al
+                    // 2008, i.e. [DL] [iteration matrix] [DR]
+                    Kokkos::single(Kokkos::PerTeam(member), [&]() {
+                        const auto scale = kBETA_local * h * h;
+                        for (size_t i = 0; i < kSystemSize; ++i) {
+                            for (size_t j = 0; j < kSystemSize; ++j) {
+                                if (i < kSize) {
+                                    iteration_matrix(i, j) *= scale;
+                                }
+                                if (j >= kSize) {
+                                    iteration_matrix(i, j) /= scale;
+                                }
+                            }
+                            if (i < kSize) {
+                                soln_increments(i) *= scale;
+                            }
+                        }
+                    });
+                    member.team_barrier();
+                }
+
+                // The size of the system is known at compile time, i.e. the loops of the
+                // factorization and substitutions are unrolled
+                team_lu_factorize<kSystemSize>(member, iteration_matrix, pivots);
+                team_lu_solve<kSystemSize>(member, iteration_matrix, pivots, soln_increments);
+
+                // Take negative of the solution increments to update the Lagrange multipliers
+                // and generalized coordinates
+                const auto lagrange_mults_factor = precondition ? 1. / (kBETA_local * h * h) : 1.;
+                for (size_t i = 0; i < HeavyTop::kNumberOfConstraints; ++i) {
+                    lambda(i) -= soln_increments(i + kSize) * lagrange_mults_factor;
+                }
+                for (size_t i = 0; i < kSize; ++i) {
+                    const auto delta_x = -soln_increments(i);
+                    delta_gen_coords(i) += delta_x / h;
+                    v(i) += GAMMA_PRIME * delta_x;
+                    a(i) += BETA_PRIME * delta_x;
+                }
+                member.team_barrier();
+            }
+
+            // Update algorithmic acceleration once Newton-Raphson iterations have ended
+            for (size_t i = 0; i < kSize; ++i) {
+                algo_acceleration_next(i) +=
+                    (1. - kALPHA_F_local) / (1. - kALPHA_M_local) * a(i);
+            }
+
+            Kokkos::single(Kokkos::PerTeam(member), [&]() {
+                // Accumulate the invariants of the new state, then renormalize its quaternion
+                // if it drifted too far from unit norm
+                if (is_diagnosed) {
+                    const auto invariants = heavy_top.CalculateInvariants(q_next, v);
+                    diagnostics(body).Accumulate(invariants);
+                    if (invariants.quaternion_norm_drift > renormalization_threshold) {
+                        renormalize_quaternion(q_next);
+                        diagnostics(body).n_renormalizations++;
+                    }
+                }
+                for (size_t i = 0; i < HeavyTop::kNumberOfGeneralizedCoordinates; ++i) {
+                    gen_coords(i, body) = q_next(i);
+                }
+                for (size_t i = 0; i < kSize; ++i) {
+                    velocity(i, body) = v(i);
+                    acceleration(i, body) = a(i);
+                    algo_acceleration(i, body) = algo_acceleration_next(i);
+                }
+                for (size_t i = 0; i < HeavyTop::kNumberOfConstraints; ++i) {
+                    lagrange_mults(i, body) = lambda(i);
+                }
+                n_iterations(body) = static_cast<int>(iteration);
+                converged(body) = is_converged ? 1 : 0;
+            });
+        }
+    );
+
+    // Keep track of the iterations of the slowest body, i.e. the number of Newton-Raphson
+    // iterations the ensemble as a whole required in this time step
+    int max_n_iterations = 0;
+    Kokkos::parallel_reduce(
+        "batched_max_iterations", Kokkos::RangePolicy<ExecutionSpace>(0, n_bodies),
+        KOKKOS_LAMBDA(const size_t i, int& local_max) {
+            local_max = n_iterations(i) > local_max ? n_iterations(i) : local_max;
+        },
+        Kokkos::Max<int>(max_n_iterations)
+    );
+    this->time_stepper_.SetNumberOfIterations(static_cast<size_t>(max_n_iterations));
+    this->time_stepper_.IncrementTotalNumberOfIterations(static_cast<size_t>(max_n_iterations));
+
+    // The linear solves run inside the kernel, i.e. they are part of the wall time only
+    this->time_stepper_.RecordStepStatistics(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - step_start).count(), 0.,
+        static_cast<size_t>(max_n_iterations)
+    );
+
+    const auto n_converged = this->GetNumberOfConvergedBodies();
+    if (n_converged == n_bodies) {
+        OTURB_LOG_INFO(
+            "Newton-Raphson iterations of all " + std::to_string(n_bodies) +
+            " bodies converged in at most " + std::to_string(max_n_iterations + 1) +
+            " iterations\n"
+        );
+        return;
+    }
+
+    OTURB_LOG_WARNING(
+        "Newton-Raphson iterations of " + std::to_string(n_bodies - n_converged) + " of " +
+        std::to_string(n_bodies) + " bodies failed to converge on a solution after " +
+        std::to_string(max_n_iterations + 1) + " iterations!\n"
+    );
+}
+
+template <typename ExecutionSpace>
+size_t BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>::GetNumberOfConvergedBodies() const {
+    const auto converged = converged_;
+    int n_converged = 0;
+    Kokkos::parallel_reduce(
+        "batched_converged_bodies", Kokkos::RangePolicy<ExecutionSpace>(0, converged.extent(0)),
+        KOKKOS_LAMBDA(const size_t i, int& local_sum) { local_sum += converged(i); },
+        Kokkos::Sum<int>(n_converged)
+    );
+    return static_cast<size_t>(n_converged);
+}
+
+template class BatchedGeneralizedAlphaTimeIntegrator<Kokkos::DefaultHostExecutionSpace>;
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+template class BatchedGeneralizedAlphaTimeIntegrator<Kokkos::DefaultExecutionSpace>;
+#endif
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/batched_state.h"
+#include "src/rigid_pendulum_poc/checkpoint.h"
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/invariants.h"
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "src/rigid_pendulum_poc/quaternion.h"
+#include "src/rigid_pendulum_poc/time_stepper.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// A 1D Kokkos view of heavy tops, i.e. the bodies of an ensemble, in the provided memory space
+template <typename MemorySpace>
+using HeavyTopView1D = Kokkos::View<HeavyTop*, MemorySpace>;
+
+/*! @brief A generalized-alpha time integrator that advances an ensemble of independent heavy
+ *      tops at once
+ *  @details Every time step of the whole ensemble is a single Kokkos::TeamPolicy launch with one
+ *      team per body. The residual vector, iteration matrix, and LU factorization of each body
+ *      are kept in team scratch memory, and a body stops iterating as soon as it has converged,
+ *      i.e. converged bodies are masked out of the remaining Newton-Raphson iterations.
+ *      The states and bodies live in the memory space of the execution space the integrator is
+ *      instantiated for, and the linear solves are done in the kernel itself, so that an entire
+ *      time step runs on the device (e.g. a GPU) without any host round trips.
+ */
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+class BatchedGeneralizedAlphaTimeIntegrator {
+public:
+    using execution_space = ExecutionSpace;
+    using memory_space = typename ExecutionSpace::memory_space;
+    using BatchedStateType = BatchedState<memory_space>;
+    using BodiesView = HeavyTopView1D<memory_space>;
+
+    /// Called after every time step with the index of the step and the states of all bodies
+    using StepCallback = std::function<void(size_t step, const BatchedStateType&)>;
+
+    static constexpr double kCONVERGENCETOLERANCE = 1e-12;
+
+    BatchedGeneralizedAlphaTimeIntegrator(
+        double alpha_f = 0.5, double alpha_m = 0.5, double beta = 0.25, double gamma = 0.5,
+        TimeStepper time_stepper = TimeStepper(), bool precondition = false
+    );
+
+    /// Returns the alpha_f parameter
+    inline double GetAlphaF() const { return kALPHA_F_; }
+
+    /// Returns the alpha_m parameter
+    inline double GetAlphaM() const { return kALPHA_M_; }
+
+    /// Returns the beta parameter
+    inline double GetBeta() const { return kBETA_; }
+
+    /// Returns the gamma parameter
+    inline double GetGamma() const { return kGAMMA_; }
+
+    /// Returns a const reference to the time stepper
+    inline const TimeStepper& GetTimeStepper() const { return time_stepper_; }
+
+    /// Performs the time integration of all bodies, updating the provided states in place
+    void Integrate(BatchedStateType&, const BodiesView bodies);
+
+    /// Performs the time integration of all bodies, updating the provided states in place and
+    /// calling the provided callback after every time step
+    void Integrate(BatchedStateType&, const BodiesView bodies, const StepCallback& on_step);
+
+    /*! @brief Resumes the time integration of all bodies from the provided checkpoint,
+     *      updating the provided states in place
+     *  @details The results are identical to those of the uninterrupted time integration
+     */
+    void Restart(
+        const BatchedCheckpoint&, BatchedStateType&, const BodiesView bodies,
+        const StepCallback& on_step = StepCallback()
+    );
+
+    /// Returns a host copy of the provided states along with the time stepper counters
+    BatchedCheckpoint CreateCheckpoint(size_t step, const BatchedStateType&) const;
+
+    /// Returns the policy for writing checkpoints during the time integration
+    inline const CheckpointPolicy& GetCheckpointPolicy() const { return checkpoint_policy_; }
+
+    /*! @brief Sets the policy for writing checkpoints during the time integration
+     *  @details Checkpoints are written on a background thread, so that the time integration
+     *      continues while they are written - every process, e.g. every rank of an ensemble
+     *      spread over many processes, should write to its own file
+     */
+    void SetCheckpointPolicy(const CheckpointPolicy&);
+
+    /// Returns the policy for accumulating the invariants of the bodies during the integration
+    inline const DiagnosticsPolicy& GetDiagnosticsPolicy() const { return diagnostics_policy_; }
+
+    /*! @brief Sets the policy for accumulating the invariants of the bodies during the
+     *      integration, i.e. their running statistics over the initial states and every time step
+     *  @details The invariants of every body are evaluated and accumulated at the end of the
+     *      kernel of each time step, i.e. without any further launch or copy of the states. The
+     *      quaternions whose norm drift exceeds the renormalization threshold are scaled to unit
+     *      norm in the same kernel, after their invariants are accumulated. The diagnostics are
+     *      reset at the start of every integration and continue across a restart.
+     */
+    void SetDiagnosticsPolicy(const DiagnosticsPolicy&);
+
+    /// Returns the running statistics of the invariants of each body, empty if not enabled
+    inline InvariantDiagnosticsView1D<memory_space> GetDiagnostics() const { return diagnostics_; }
+
+    /// Advances the states of all bodies by one time step, in place
+    void AlphaStep(BatchedStateType&, const BodiesView bodies);
+
+    /// Computes the updated generalized coordinates based on the non-linear update
+    KOKKOS_INLINE_FUNCTION static Vec<7> UpdateGeneralizedCoordinates(
+        const Vec<7>& gen_coords, const Vec<6>& delta_gen_coords, double h
+    ) {
+        const auto rotation_vector = delta_gen_coords.GetSegment<3>(3) * h;
+        return UpdateGeneralizedCoordinates(
+            gen_coords, delta_gen_coords, h,
+            quaternion_from_rotation_vector(
+                Vector{rotation_vector(0), rotation_vector(1), rotation_vector(2)}
+            )
+        );
+    }
+
+    /// Computes the updated generalized coordinates based on the non-linear update, given the
+    /// exponential map of its rotation vector h * {delta_gen_coords(3:5)}
+    KOKKOS_INLINE_FUNCTION static Vec<7> UpdateGeneralizedCoordinates(
+        const Vec<7>& gen_coords, const Vec<6>& delta_gen_coords, double h,
+        const Quaternion& rotation_increment
+    ) {
+        // Step 1: R^3 update, done with vector addition
+        auto gen_coords_next = Vec<7>{};
+        gen_coords_next.SetSegment(
+            0, gen_coords.GetSegment<3>(0) + delta_gen_coords.GetSegment<3>(0) * h
+        );
+
+        // Step 2: SO(3) update, done with quaternion composition of the current orientation
+        // and the exponential map of the rotation vector
+        const auto q = Quaternion{gen_coords(3), gen_coords(4), gen_coords(5), gen_coords(6)} *
+                       rotation_increment;
+        gen_coords_next(3) = q.GetScalarComponent();
+        gen_coords_next(4) = q.GetXComponent();
+        gen_coords_next(5) = q.GetYComponent();
+        gen_coords_next(6) = q.GetZComponent();
+        return gen_coords_next;
+    }
+
+    /// Returns the number of Newton-Raphson iterations of each body in the latest time step
+    inline IntView1D<memory_space> GetNumberOfIterations() const { return n_iterations_; }
+
+    /// Returns a flag per body to indicate if its latest non-linear update has converged
+    inline IntView1D<memory_space> GetConvergedFlags() const { return converged_; }
+
+    /// Returns the number of bodies whose latest non-linear update has converged
+    size_t GetNumberOfConvergedBodies() const;
+
+private:
+    const double kALPHA_F_;  //< Alpha_f coefficient of the generalized-alpha method
+    const double kALPHA_M_;  //< Alpha_m coefficient of the generalized-alpha method
+    const double kBETA_;     //< Beta coefficient of the generalized-alpha method
+    const double kGAMMA_;    //< Gamma coefficient of the generalized-alpha method
+
+    TimeStepper time_stepper_;  //< Time stepper object to perform the time integration
+    bool precondition_;         //< Flag to indicate if the iteration matrix is preconditioned
+
+    IntView1D<memory_space> n_iterations_;  //< Number of iterations of each body in latest step
+    IntView1D<memory_space> converged_;     //< Convergence flag of each body in latest step
+
+    CheckpointPolicy checkpoint_policy_;       //< When and where to write checkpoints
+    AsyncCheckpointWriter checkpoint_writer_;  //< Writes the checkpoints in the background
+
+    DiagnosticsPolicy diagnostics_policy_;                  //< When to accumulate invariants
+    InvariantDiagnosticsView1D<memory_space> diagnostics_;  //< Statistics of each body
+
+    /// Resets the diagnostics and accumulates the invariants of the initial states, if enabled
+    void ResetDiagnostics(const BatchedStateType&, const BodiesView bodies);
+
+    /// Performs the time steps after the provided one
+    void IntegrateSteps(
+        size_t first_step, BatchedStateType&, const BodiesView bodies, const StepCallback& on_step
+    );
+};
+
+}  // namespace openturbine::rigid_pendulum
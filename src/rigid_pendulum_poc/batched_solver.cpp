@@ -0,0 +1,126 @@
+#include "src/rigid_pendulum_poc/batched_solver.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "src/rigid_pendulum_poc/matrix.h"
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+/// Solves all systems of compile-time size N, returns the number of singular systems
+template <size_t N, typename ExecutionSpace>
+size_t solve_systems_of_size(
+    View3D<typename ExecutionSpace::memory_space> systems,
+    View2D<typename ExecutionSpace::memory_space> solutions
+) {
+    int n_singular = 0;
+    Kokkos::parallel_reduce(
+        "solve_batched_linear_systems", Kokkos::RangePolicy<ExecutionSpace>(0, systems.extent(0)),
+        KOKKOS_LAMBDA(const size_t i, int& local_n_singular) {
+            auto system = Kokkos::subview(systems, i, Kokkos::ALL, Kokkos::ALL);
+            auto solution = Kokkos::subview(solutions, i, Kokkos::ALL);
+            auto pivots = Vec<N, int>{};
+            if (serial_lu_factorize<N>(system, pivots) != 0) {
+                ++local_n_singular;
+                return;
+            }
+            serial_lu_solve<N>(system, pivots, solution);
+        },
+        Kokkos::Sum<int>(n_singular)
+    );
+    return static_cast<size_t>(n_singular);
+}
+
+/// Solves all systems with run-time loop bounds, returns the number of singular systems
+template <typename ExecutionSpace>
+size_t solve_systems_of_dynamic_size(
+    View3D<typename ExecutionSpace::memory_space> systems,
+    View2D<typename ExecutionSpace::memory_space> solutions
+) {
+    const auto all_pivots = Kokkos::View<int**, typename ExecutionSpace::memory_space>(
+        "pivots", systems.extent(0), systems.extent(1)
+    );
+    int n_singular = 0;
+    Kokkos::parallel_reduce(
+        "solve_batched_linear_systems", Kokkos::RangePolicy<ExecutionSpace>(0, systems.extent(0)),
+        KOKKOS_LAMBDA(const size_t i, int& local_n_singular) {
+            auto system = Kokkos::subview(systems, i, Kokkos::ALL, Kokkos::ALL);
+            auto solution = Kokkos::subview(solutions, i, Kokkos::ALL);
+            auto pivots = Kokkos::subview(all_pivots, i, Kokkos::ALL);
+            if (serial_lu_factorize<kDynamicSize>(system, pivots) != 0) {
+                ++local_n_singular;
+                return;
+            }
+            serial_lu_solve<kDynamicSize>(system, pivots, solution);
+        },
+        Kokkos::Sum<int>(n_singular)
+    );
+    return static_cast<size_t>(n_singular);
+}
+
+}  // namespace
+
+template <typename ExecutionSpace>
+void solve_batched_linear_systems(
+    View3D<typename ExecutionSpace::memory_space> systems,
+    View2D<typename ExecutionSpace::memory_space> solutions
+) {
+    const auto n = systems.extent(1);
+    if (systems.extent(2) != n) {
+        throw std::invalid_argument("The systems must be square");
+    }
+    if (solutions.extent(0) != systems.extent(0) || solutions.extent(1) != n) {
+        throw std::invalid_argument(
+            "The number of right-hand sides and their sizes must match the systems"
+        );
+    }
+
+    // Keep the cases in line with the specialized sizes
+    static_assert(kMinimumSpecializedSize == 6 && kMaximumSpecializedSize == 12);
+    size_t n_singular = 0;
+    switch (n) {
+        case 6:
+            n_singular = solve_systems_of_size<6, ExecutionSpace>(systems, solutions);
+            break;
+        case 7:
+            n_singular = solve_systems_of_size<7, ExecutionSpace>(systems, solutions);
+            break;
+        case 8:
+            n_singular = solve_systems_of_size<8, ExecutionSpace>(systems, solutions);
+            break;
+        case 9:
+            n_singular = solve_systems_of_size<9, ExecutionSpace>(systems, solutions);
+            break;
+        case 10:
+            n_singular = solve_systems_of_size<10, ExecutionSpace>(systems, solutions);
+            break;
+        case 11:
+            n_singular = solve_systems_of_size<11, ExecutionSpace>(systems, solutions);
+            break;
+        case 12:
+            n_singular = solve_systems_of_size<12, ExecutionSpace>(systems, solutions);
+            break;
+        default:
+            n_singular = solve_systems_of_dynamic_size<ExecutionSpace>(systems, solutions);
+    }
+
+    if (n_singular > 0) {
+        throw std::runtime_error(
+            std::to_string(n_singular) + " of " + std::to_string(systems.extent(0)) +
+            " systems are singular"
+        );
+    }
+}
+
+template void solve_batched_linear_systems<Kokkos::DefaultHostExecutionSpace>(
+    View3D<Kokkos::HostSpace>, View2D<Kokkos::HostSpace>
+);
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+template void solve_batched_linear_systems<Kokkos::DefaultExecutionSpace>(
+    View3D<DeviceMemorySpace>, View2D<DeviceMemorySpace>
+);
+#endif
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// Size of systems whose number of rows/columns is only known at run time, i.e. taken from the
+/// extent of the provided views instead of a template argument
+static constexpr size_t kDynamicSize = 0;
+
+/// Smallest and largest sizes of the batched solves that are specialized at compile time, i.e.
+/// the 6 velocities of a rigid body plus up to 6 constraints
+static constexpr size_t kMinimumSpecializedSize = 6;
+static constexpr size_t kMaximumSpecializedSize = 12;
+
+/// Returns the number of rows/columns of the provided square system, i.e. N unless it is the
+/// dynamic size
+template <size_t N, typename SystemView>
+KOKKOS_INLINE_FUNCTION constexpr size_t small_system_size(
+    [[maybe_unused]] const SystemView& system
+) {
+    if constexpr (N == kDynamicSize) {
+        return system.extent(0);
+    } else {
+        return N;
+    }
+}
+
+/*! @brief Computes the LU factorization with partial pivoting of a small dense system by a single
+ *      thread, e.g. one system per thread of a Kokkos::RangePolicy kernel
+ *  @details The system is overwritten with its factors, i.e. the unit lower triangular factor
+ *      below the diagonal and the upper triangular factor on and above it, and pivots(k) holds
+ *      the row that was swapped with row k, as with LAPACK's dgetrf. With a compile-time size N
+ *      all loops have fixed trip counts, so that they are unrolled and the factorization of a
+ *      Matrix<N, N> stays in registers.
+ *  @param system A square matrix of coefficients, e.g. a view or a Matrix<N, N>
+ *  @param pivots A vector of N (or n) integers for the pivot rows, e.g. a view or a Vec<N, int>
+ *  @return 0 on success, or k + 1 if the k-th pivot is exactly zero, i.e. the system is singular
+ */
+template <size_t N, typename SystemView, typename PivotView>
+KOKKOS_INLINE_FUNCTION int serial_lu_factorize(SystemView&& system, PivotView&& pivots) {
+    const size_t n = small_system_size<N>(system);
+    int info = 0;
+    for (size_t k = 0; k < n; ++k) {
+        // Find the row with the largest entry in column k and swap it into place
+        size_t pivot = k;
+        auto max_entry = Kokkos::fabs(system(k, k));
+        for (size_t i = k + 1; i < n; ++i) {
+            if (Kokkos::fabs(system(i, k)) > max_entry) {
+                pivot = i;
+                max_entry = Kokkos::fabs(system(i, k));
+            }
+        }
+        pivots(k) = static_cast<int>(pivot);
+        if (max_entry == 0.) {
+            info = (info == 0) ? static_cast<int>(k + 1) : info;
+            continue;
+        }
+        if (pivot != k) {
+            for (size_t j = 0; j < n; ++j) {
+                const auto temp = system(k, j);
+                system(k, j) = system(pivot, j);
+                system(pivot, j) = temp;
+            }
+        }
+
+        const auto inverse_pivot = 1. / system(k, k);
+        for (size_t i = k + 1; i < n; ++i) {
+            system(i, k) *= inverse_pivot;
+            for (size_t j = k + 1; j < n; ++j) {
+                system(i, j) -= system(i, k) * system(k, j);
+            }
+        }
+    }
+    return info;
+}
+
+/*! @brief Solves a small dense system factorized by serial_lu_factorize() or team_lu_factorize()
+ *      by a single thread, i.e. applies the row swaps and the forward and back substitutions
+ *  @param factors LU factors of the system
+ *  @param pivots Pivot rows of the factorization
+ *  @param solution A vector of right-hand side values, overwritten with the solution
+ */
+template <size_t N, typename SystemView, typename PivotView, typename SolutionView>
+KOKKOS_INLINE_FUNCTION void serial_lu_solve(
+    const SystemView& factors, const PivotView& pivots, SolutionView&& solution
+) {
+    const size_t n = small_system_size<N>(factors);
+    for (size_t k = 0; k < n; ++k) {
+        const auto pivot = static_cast<size_t>(pivots(k));
+        if (pivot != k) {
+            const auto temp = solution(k);
+            solution(k) = solution(pivot);
+            solution(pivot) = temp;
+        }
+    }
+
+    // Forward substitution with the unit lower triangular factor
+    for (size_t i = 1; i < n; ++i) {
+        auto sum = solution(i);
+        for (size_t j = 0; j < i; ++j) {
+            sum -= factors(i, j) * solution(j);
+        }
+        solution(i) = sum;
+    }
+
+    // Back substitution with the upper triangular factor
+    for (size_t i = n; i-- > 0;) {
+        auto sum = solution(i);
+        for (size_t j = i + 1; j < n; ++j) {
+            sum -= factors(i, j) * solution(j);
+        }
+        solution(i) = sum / factors(i, i);
+    }
+}
+
+/*! @brief Computes the LU factorization with partial pivoting of a small dense system with a
+ *      team of threads, i.e. from inside a Kokkos::TeamPolicy kernel
+ *  @details Same factors and pivots as serial_lu_factorize(), intended to be views into team
+ *      scratch memory. The pivot search is done by one thread, the row swap and the elimination
+ *      of the rows below the pivot by all threads of the team.
+ *  @param member The team member/handle of the calling thread
+ *  @param system A square matrix of coefficients, overwritten with its factors
+ *  @param pivots A vector of integers for the pivot rows
+ *  @return 0 on success, or k + 1 if the k-th pivot is exactly zero - on every thread
+ */
+template <size_t N, typename TeamMember, typename SystemView, typename PivotView>
+KOKKOS_INLINE_FUNCTION int team_lu_factorize(
+    const TeamMember& member, const SystemView& system, const PivotView& pivots
+) {
+    const size_t n = small_system_size<N>(system);
+    int info = 0;
+    for (size_t k = 0; k < n; ++k) {
+        size_t pivot = k;
+        Kokkos::single(
+            Kokkos::PerTeam(member),
+            [&](size_t& pivot_row) {
+                pivot_row = k;
+                for (size_t i = k + 1; i < n; ++i) {
+                    if (Kokkos::fabs(system(i, k)) > Kokkos::fabs(system(pivot_row, k))) {
+                        pivot_row = i;
+                    }
+                }
+                pivots(k) = static_cast<int>(pivot_row);
+            },
+            pivot
+        );
+        member.team_barrier();
+        if (system(pivot, k) == 0.) {
+            info = (info == 0) ? static_cast<int>(k + 1) : info;
+            continue;
+        }
+        if (pivot != k) {
+            Kokkos::parallel_for(Kokkos::TeamThreadRange(member, n), [&](size_t j) {
+                const auto temp = system(k, j);
+                system(k, j) = system(pivot, j);
+                system(pivot, j) = temp;
+            });
+            member.team_barrier();
+        }
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(member, k + 1, n), [&](size_t i) {
+            const auto factor = system(i, k) / system(k, k);
+            system(i, k) = factor;
+            for (size_t j = k + 1; j < n; ++j) {
+                system(i, j) -= factor * system(k, j);
+            }
+        });
+        member.team_barrier();
+    }
+    return info;
+}
+
+/*! @brief Solves a small dense system factorized by team_lu_factorize() with a team of threads
+ *  @details The substitutions are sequential by nature and the systems small, i.e. one thread of
+ *      the team solves while the others wait, which is cheaper than a barrier per row
+ *  @param member The team member/handle of the calling thread
+ *  @param factors LU factors of the system
+ *  @param pivots Pivot rows of the factorization
+ *  @param solution A vector of right-hand side values, overwritten with the solution
+ */
+template <
+    size_t N, typename TeamMember, typename SystemView, typename PivotView,
+    typename SolutionView>
+KOKKOS_INLINE_FUNCTION void team_lu_solve(
+    const TeamMember& member, const SystemView& factors, const PivotView& pivots,
+    const SolutionView& solution
+) {
+    Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        serial_lu_solve<N>(factors, pivots, solution);
+    });
+    member.team_barrier();
+}
+
+/*! @brief Solves a batch of independent small dense systems with LU factorizations with partial
+ *      pivoting, one system per thread of the provided execution space
+ *  @details The systems are indexed as (system, row, column) and the right-hand sides as
+ *      (system, row), so that the default layout of the memory space keeps the entries of one
+ *      system contiguous on the host and coalesces the accesses of neighboring threads on GPUs.
+ *      Sizes from kMinimumSpecializedSize to kMaximumSpecializedSize are dispatched to their
+ *      compile-time specializations, other sizes are solved with run-time loop bounds. The
+ *      systems are overwritten with their factors and the right-hand sides with the solutions.
+ *  @param systems Matrices of coefficients of all systems
+ *  @param solutions Vectors of right-hand side values of all systems
+ */
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+void solve_batched_linear_systems(
+    View3D<typename ExecutionSpace::memory_space> systems,
+    View2D<typename ExecutionSpace::memory_space> solutions
+);
+
+}  // namespace openturbine::rigid_pendulum
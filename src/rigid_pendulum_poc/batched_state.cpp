@@ -0,0 +1,85 @@
+#include "src/rigid_pendulum_poc/batched_state.h"
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+/// Copies the provided vector into the column of a (component, body) view
+template <typename View>
+void set_column(const View& view, size_t body, const HostView1D values) {
+    auto host_view = Kokkos::create_mirror_view(view);
+    Kokkos::deep_copy(host_view, view);
+    for (size_t i = 0; i < values.extent(0); ++i) {
+        host_view(i, body) = values(i);
+    }
+    Kokkos::deep_copy(view, host_view);
+}
+
+/// Returns a copy of the column of a (component, body) view
+template <typename View>
+HostView1D get_column(const View& view, size_t body, const std::string& label) {
+    auto host_view = Kokkos::create_mirror_view(view);
+    Kokkos::deep_copy(host_view, view);
+    auto values = HostView1D(label, view.extent(0));
+    for (size_t i = 0; i < values.extent(0); ++i) {
+        values(i) = host_view(i, body);
+    }
+    return values;
+}
+
+}  // namespace
+
+template <typename MemorySpace>
+BatchedState<MemorySpace>::BatchedState(
+    size_t n_bodies, size_t n_gen_coords, size_t n_velocities, size_t n_constraints
+)
+    : n_bodies_(n_bodies),
+      generalized_coords_("generalized_coordinates", n_gen_coords, n_bodies),
+      velocity_("velocity", n_velocities, n_bodies),
+      acceleration_("acceleration", n_velocities, n_bodies),
+      algorithmic_acceleration_("algorithmic_acceleration", n_velocities, n_bodies),
+      lagrange_multipliers_("lagrange_multipliers", n_constraints, n_bodies) {
+}
+
+template <typename MemorySpace>
+void BatchedState<MemorySpace>::SetState(size_t body, const State& state) {
+    if (body >= n_bodies_) {
+        throw std::out_of_range("The provided body index is out of range");
+    }
+
+    const auto gen_coords = state.GetGeneralizedCoordinates();
+    const auto velocity = state.GetVelocity();
+    const auto acceleration = state.GetAcceleration();
+    const auto algo_acceleration = state.GetAlgorithmicAcceleration();
+
+    if (gen_coords.extent(0) != generalized_coords_.extent(0) ||
+        velocity.extent(0) != velocity_.extent(0) ||
+        acceleration.extent(0) != acceleration_.extent(0) ||
+        algo_acceleration.extent(0) != algorithmic_acceleration_.extent(0)) {
+        throw std::invalid_argument("The provided state does not match the size of the batch");
+    }
+
+    set_column(generalized_coords_, body, gen_coords);
+    set_column(velocity_, body, velocity);
+    set_column(acceleration_, body, acceleration);
+    set_column(algorithmic_acceleration_, body, algo_acceleration);
+}
+
+template <typename MemorySpace>
+State BatchedState<MemorySpace>::GetState(size_t body) const {
+    if (body >= n_bodies_) {
+        throw std::out_of_range("The provided body index is out of range");
+    }
+
+    return State{
+        get_column(generalized_coords_, body, "generalized_coordinates"),
+        get_column(velocity_, body, "velocity"), get_column(acceleration_, body, "acceleration"),
+        get_column(algorithmic_acceleration_, body, "algorithmic_acceleration")};
+}
+
+template class BatchedState<Kokkos::HostSpace>;
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+template class BatchedState<DeviceMemorySpace>;
+#endif
+
+}  // namespace openturbine::rigid_pendulum
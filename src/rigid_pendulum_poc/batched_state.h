@@ -0,0 +1,64 @@
+#pragma once
+
+#include "src/rigid_pendulum_poc/state.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief Class to store and manage the states of an ensemble of independent dynamic systems
+ *  @details The states are stored in a struct-of-arrays layout, i.e. every view is indexed as
+ *      (component, body) so that a given component of all bodies is contiguous in memory. The
+ *      views live in the provided memory space, e.g. on the GPU, so that an ensemble can be
+ *      advanced in time without any host round trips.
+ */
+template <typename MemorySpace = DeviceMemorySpace>
+class BatchedState {
+public:
+    using memory_space = MemorySpace;
+
+    /// Constructs the states of n_bodies bodies, all initialized to zero
+    BatchedState(
+        size_t n_bodies = 0, size_t n_gen_coords = 7, size_t n_velocities = 6,
+        size_t n_constraints = 3
+    );
+
+    /// Returns the number of bodies in the ensemble
+    inline size_t GetNumberOfBodies() const { return n_bodies_; }
+
+    /// Returns the generalized coordinates of all bodies as a (component, body) view
+    inline View2D<MemorySpace> GetGeneralizedCoordinates() const { return generalized_coords_; }
+
+    /// Returns the velocities of all bodies as a (component, body) view
+    inline View2D<MemorySpace> GetVelocity() const { return velocity_; }
+
+    /// Returns the accelerations of all bodies as a (component, body) view
+    inline View2D<MemorySpace> GetAcceleration() const { return acceleration_; }
+
+    /// Returns the algorithmic accelerations of all bodies as a (component, body) view
+    inline View2D<MemorySpace> GetAlgorithmicAcceleration() const {
+        return algorithmic_acceleration_;
+    }
+
+    /// Returns the Lagrange multipliers of all bodies as a (component, body) view
+    inline View2D<MemorySpace> GetLagrangeMultipliers() const { return lagrange_multipliers_; }
+
+    /*! @brief Sets the state of the provided body from a (host) state
+     *  @details Meant for setting up/inspecting individual bodies - when the views live in
+     *      device memory every call copies all bodies between host and device
+     */
+    void SetState(size_t body, const State&);
+
+    /// Returns a (host) copy of the state of the provided body
+    State GetState(size_t body) const;
+
+private:
+    size_t n_bodies_;  //< Number of bodies in the ensemble
+
+    View2D<MemorySpace> generalized_coords_;        //< Generalized coordinates
+    View2D<MemorySpace> velocity_;                  //< Velocity vectors
+    View2D<MemorySpace> acceleration_;              //< First time derivative of velocities
+    View2D<MemorySpace> algorithmic_acceleration_;  //< Algorithmic accelerations
+    View2D<MemorySpace> lagrange_multipliers_;      //< Lagrange multipliers
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,264 @@
+#include "src/rigid_pendulum_poc/block_sparse_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <stdexcept>
+
+namespace openturbine::rigid_pendulum {
+
+BlockSparseMatrix::BlockSparseMatrix(
+    const std::vector<size_t>& block_sizes,
+    const std::vector<std::pair<size_t, size_t>>& nonzero_blocks
+)
+    : block_sizes_(block_sizes), block_offsets_(block_sizes.size() + 1, 0) {
+    const auto n_blocks = block_sizes_.size();
+    for (size_t i = 0; i < n_blocks; ++i) {
+        block_offsets_[i + 1] = block_offsets_[i] + block_sizes_[i];
+    }
+
+    auto pattern = nonzero_blocks;
+    for (const auto& [block_row, block_column] : pattern) {
+        if (block_row >= n_blocks || block_column >= n_blocks) {
+            throw std::out_of_range("The provided non-zero block is out of range");
+        }
+    }
+    std::sort(pattern.begin(), pattern.end());
+    pattern.erase(std::unique(pattern.begin(), pattern.end()), pattern.end());
+
+    // Build the block-CSR structure from the sorted (block row, block column) pairs
+    row_offsets_.assign(n_blocks + 1, 0);
+    column_indices_.reserve(pattern.size());
+    value_offsets_.reserve(pattern.size() + 1);
+    value_offsets_.push_back(0);
+    for (const auto& [block_row, block_column] : pattern) {
+        row_offsets_[block_row + 1]++;
+        column_indices_.push_back(block_column);
+        value_offsets_.push_back(
+            value_offsets_.back() + block_sizes_[block_row] * block_sizes_[block_column]
+        );
+    }
+    for (size_t i = 0; i < n_blocks; ++i) {
+        row_offsets_[i + 1] += row_offsets_[i];
+    }
+
+    values_ = HostView1D("values", value_offsets_.back());
+}
+
+size_t BlockSparseMatrix::FindBlock(size_t block_row, size_t block_column) const {
+    if (block_row >= this->GetNumberOfBlockRows()) {
+        return this->GetNumberOfNonZeroBlocks();
+    }
+
+    const auto begin = column_indices_.begin() + row_offsets_[block_row];
+    const auto end = column_indices_.begin() + row_offsets_[block_row + 1];
+    const auto it = std::lower_bound(begin, end, block_column);
+    if (it == end || *it != block_column) {
+        return this->GetNumberOfNonZeroBlocks();
+    }
+    return static_cast<size_t>(it - column_indices_.begin());
+}
+
+bool BlockSparseMatrix::HasBlock(size_t block_row, size_t block_column) const {
+    return this->FindBlock(block_row, block_column) != this->GetNumberOfNonZeroBlocks();
+}
+
+HostView2D BlockSparseMatrix::GetBlock(size_t block_row, size_t block_column) const {
+    const auto index = this->FindBlock(block_row, block_column);
+    if (index == this->GetNumberOfNonZeroBlocks()) {
+        throw std::invalid_argument("The provided block is not part of the sparsity pattern");
+    }
+    return HostView2D(
+        values_.data() + value_offsets_[index], block_sizes_[block_row],
+        block_sizes_[block_column]
+    );
+}
+
+double BlockSparseMatrix::operator()(size_t row, size_t column) const {
+    if (row >= this->GetNumberOfRows() || column >= this->GetNumberOfRows()) {
+        throw std::out_of_range("The provided entry is out of range");
+    }
+
+    // Find the blocks containing the provided row and column
+    const auto block_row = static_cast<size_t>(
+        std::upper_bound(block_offsets_.begin(), block_offsets_.end(), row) -
+        block_offsets_.begin() - 1
+    );
+    const auto block_column = static_cast<size_t>(
+        std::upper_bound(block_offsets_.begin(), block_offsets_.end(), column) -
+        block_offsets_.begin() - 1
+    );
+
+    const auto index = this->FindBlock(block_row, block_column);
+    if (index == this->GetNumberOfNonZeroBlocks()) {
+        return 0.;
+    }
+    const auto i = row - block_offsets_[block_row];
+    const auto j = column - block_offsets_[block_column];
+    return values_(value_offsets_[index] + i * block_sizes_[block_column] + j);
+}
+
+void BlockSparseMatrix::SetZero() {
+    Kokkos::deep_copy(values_, 0.);
+}
+
+HostView2D BlockSparseMatrix::ToDense() const {
+    const auto size = this->GetNumberOfRows();
+    auto dense = HostView2D("dense_matrix", size, size);
+    for (size_t block_row = 0; block_row < this->GetNumberOfBlockRows(); ++block_row) {
+        for (auto index = row_offsets_[block_row]; index < row_offsets_[block_row + 1]; ++index) {
+            const auto block_column = column_indices_[index];
+            const auto block = this->GetBlock(block_row, block_column);
+            for (size_t i = 0; i < block.extent(0); ++i) {
+                for (size_t j = 0; j < block.extent(1); ++j) {
+                    dense(block_offsets_[block_row] + i, block_offsets_[block_column] + j) =
+                        block(i, j);
+                }
+            }
+        }
+    }
+    return dense;
+}
+
+HostView1D BlockSparseMatrix::Multiply(const HostView1D vector) const {
+    if (vector.extent(0) != this->GetNumberOfRows()) {
+        throw std::invalid_argument(
+            "Number of columns of the matrix must be same as the number of rows of the vector"
+        );
+    }
+
+    auto result = HostView1D("result", this->GetNumberOfRows());
+    for (size_t block_row = 0; block_row < this->GetNumberOfBlockRows(); ++block_row) {
+        for (auto index = row_offsets_[block_row]; index < row_offsets_[block_row + 1]; ++index) {
+            const auto block_column = column_indices_[index];
+            const auto block = this->GetBlock(block_row, block_column);
+            for (size_t i = 0; i < block.extent(0); ++i) {
+                for (size_t j = 0; j < block.extent(1); ++j) {
+                    result(block_offsets_[block_row] + i) +=
+                        block(i, j) * vector(block_offsets_[block_column] + j);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<size_t> BlockSparseMatrix::ReverseCuthillMcKeeOrdering() const {
+    const auto n_blocks = this->GetNumberOfBlockRows();
+
+    // Build the adjacency of the symmetrized block graph, without self loops
+    auto adjacency = std::vector<std::vector<size_t>>(n_blocks);
+    for (size_t block_row = 0; block_row < n_blocks; ++block_row) {
+        for (auto index = row_offsets_[block_row]; index < row_offsets_[block_row + 1]; ++index) {
+            const auto block_column = column_indices_[index];
+            if (block_column != block_row) {
+                adjacency[block_row].push_back(block_column);
+                adjacency[block_column].push_back(block_row);
+            }
+        }
+    }
+    for (auto& neighbors : adjacency) {
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+
+    const auto by_degree = [&adjacency](size_t a, size_t b) {
+        return adjacency[a].size() < adjacency[b].size() ||
+               (adjacency[a].size() == adjacency[b].size() && a < b);
+    };
+
+    // Breadth-first traversal of every connected component, starting from a node of minimum
+    // degree and visiting the neighbors in order of increasing degree
+    auto ordering = std::vector<size_t>{};
+    ordering.reserve(n_blocks);
+    auto visited = std::vector<bool>(n_blocks, false);
+    auto nodes = std::vector<size_t>(n_blocks);
+    for (size_t i = 0; i < n_blocks; ++i) {
+        nodes[i] = i;
+    }
+    std::sort(nodes.begin(), nodes.end(), by_degree);
+
+    for (const auto start : nodes) {
+        if (visited[start]) {
+            continue;
+        }
+        auto queue = std::queue<size_t>{};
+        queue.push(start);
+        visited[start] = true;
+        while (!queue.empty()) {
+            const auto node = queue.front();
+            queue.pop();
+            ordering.push_back(node);
+
+            auto neighbors = std::vector<size_t>{};
+            for (const auto neighbor : adjacency[node]) {
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    neighbors.push_back(neighbor);
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end(), by_degree);
+            for (const auto neighbor : neighbors) {
+                queue.push(neighbor);
+            }
+        }
+    }
+
+    std::reverse(ordering.begin(), ordering.end());
+    return ordering;
+}
+
+BlockSparseMatrix BlockSparseMatrix::FromDense(
+    const HostView2D dense, const std::vector<size_t>& block_sizes, double tolerance
+) {
+    auto block_offsets = std::vector<size_t>(block_sizes.size() + 1, 0);
+    for (size_t i = 0; i < block_sizes.size(); ++i) {
+        block_offsets[i + 1] = block_offsets[i] + block_sizes[i];
+    }
+    if (dense.extent(0) != dense.extent(1) || dense.extent(0) != block_offsets.back()) {
+        throw std::invalid_argument(
+            "Provided matrix must be a square matrix matching the sum of the block sizes"
+        );
+    }
+
+    auto nonzero_blocks = std::vector<std::pair<size_t, size_t>>{};
+    for (size_t block_row = 0; block_row < block_sizes.size(); ++block_row) {
+        for (size_t block_column = 0; block_column < block_sizes.size(); ++block_column) {
+            auto is_nonzero = false;
+            for (auto i = block_offsets[block_row]; i < block_offsets[block_row + 1]; ++i) {
+                for (auto j = block_offsets[block_column]; j < block_offsets[block_column + 1];
+                     ++j) {
+                    is_nonzero = is_nonzero || std::abs(dense(i, j)) > tolerance;
+                }
+            }
+            if (is_nonzero) {
+                nonzero_blocks.emplace_back(block_row, block_column);
+            }
+        }
+    }
+
+    auto matrix = BlockSparseMatrix(block_sizes, nonzero_blocks);
+    for (const auto& [block_row, block_column] : nonzero_blocks) {
+        auto block = matrix.GetBlock(block_row, block_column);
+        for (size_t i = 0; i < block.extent(0); ++i) {
+            for (size_t j = 0; j < block.extent(1); ++j) {
+                block(i, j) =
+                    dense(block_offsets[block_row] + i, block_offsets[block_column] + j);
+            }
+        }
+    }
+    return matrix;
+}
+
+std::vector<size_t> create_multibody_block_sizes(size_t n_velocities, size_t n_constraints) {
+    auto block_sizes = std::vector<size_t>(n_velocities / 6, 6);
+    if (n_velocities % 6 != 0) {
+        block_sizes.push_back(n_velocities % 6);
+    }
+    if (n_constraints > 0) {
+        block_sizes.push_back(n_constraints);
+    }
+    return block_sizes;
+}
+
+}  // namespace openturbine::rigid_pendulum
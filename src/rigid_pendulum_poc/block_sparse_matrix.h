@@ -0,0 +1,102 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief A square matrix in block compressed sparse row (block-CSR) format
+ *  @details The rows and columns are partitioned into blocks of the provided sizes, e.g. the six
+ *      velocities of every body followed by the constraints of every joint, and only the
+ *      structurally non-zero blocks are stored. Every stored block is a dense row-major matrix
+ *      and all blocks share a single contiguous allocation, so assembling into an existing
+ *      matrix does not allocate.
+ */
+class BlockSparseMatrix {
+public:
+    /// Constructs a zero matrix with the provided block sizes and (block row, block column)
+    /// pairs of the structurally non-zero blocks - duplicate pairs are stored only once
+    BlockSparseMatrix(
+        const std::vector<size_t>& block_sizes = {},
+        const std::vector<std::pair<size_t, size_t>>& nonzero_blocks = {}
+    );
+
+    /// Returns the number of (scalar) rows/columns of the matrix
+    inline size_t GetNumberOfRows() const { return block_offsets_.back(); }
+
+    /// Returns the number of block rows/columns of the matrix
+    inline size_t GetNumberOfBlockRows() const { return block_sizes_.size(); }
+
+    /// Returns the number of stored, i.e. structurally non-zero, blocks
+    inline size_t GetNumberOfNonZeroBlocks() const { return column_indices_.size(); }
+
+    /// Returns the number of stored (scalar) values
+    inline size_t GetNumberOfNonZeros() const { return values_.extent(0); }
+
+    /// Returns the sizes of the blocks
+    inline const std::vector<size_t>& GetBlockSizes() const { return block_sizes_; }
+
+    /// Returns the offsets of the blocks in the rows/columns of the matrix
+    inline const std::vector<size_t>& GetBlockOffsets() const { return block_offsets_; }
+
+    /// Returns the offsets of the block rows in the stored blocks, i.e. the block-CSR row pointers
+    inline const std::vector<size_t>& GetRowOffsets() const { return row_offsets_; }
+
+    /// Returns the block column indices of the stored blocks
+    inline const std::vector<size_t>& GetColumnIndices() const { return column_indices_; }
+
+    /// Returns if the provided block is stored, i.e. part of the sparsity pattern
+    bool HasBlock(size_t block_row, size_t block_column) const;
+
+    /// Returns an (unmanaged) view of the provided block, which must be part of the sparsity
+    /// pattern - writes to the view modify the matrix
+    HostView2D GetBlock(size_t block_row, size_t block_column) const;
+
+    /// Returns the value of the provided (scalar) entry, zero if outside the sparsity pattern
+    double operator()(size_t row, size_t column) const;
+
+    /// Sets all stored values to zero, keeping the sparsity pattern
+    void SetZero();
+
+    /// Returns the matrix in a dense format
+    HostView2D ToDense() const;
+
+    /// Multiplies the matrix with a vector and returns the result
+    HostView1D Multiply(const HostView1D) const;
+
+    /*! @brief Returns a permutation of the block rows/columns that reduces the bandwidth of the
+     *      matrix, computed with the reverse Cuthill-McKee algorithm on the block graph
+     *  @details The i-th entry of the returned vector is the original index of the block that is
+     *      placed at position i. The sparsity pattern is treated as symmetric.
+     */
+    std::vector<size_t> ReverseCuthillMcKeeOrdering() const;
+
+    /// Creates a block sparse matrix from a dense matrix, storing every block that contains at
+    /// least one entry with a magnitude larger than the provided tolerance
+    static BlockSparseMatrix FromDense(
+        const HostView2D, const std::vector<size_t>& block_sizes, double tolerance = 0.
+    );
+
+private:
+    std::vector<size_t> block_sizes_;     //< Sizes of the blocks
+    std::vector<size_t> block_offsets_;   //< Offsets of the blocks in the rows/columns
+    std::vector<size_t> row_offsets_;     //< Offsets of the block rows in the stored blocks
+    std::vector<size_t> column_indices_;  //< Block column indices of the stored blocks
+    std::vector<size_t> value_offsets_;   //< Offsets of the stored blocks in the values
+    HostView1D values_;                   //< Values of all stored blocks, block by block
+
+    /// Returns the index of the provided block in the stored blocks, or the number of stored
+    /// blocks if the block is not part of the sparsity pattern
+    size_t FindBlock(size_t block_row, size_t block_column) const;
+};
+
+/*! @brief Returns the block sizes of a multibody system with the provided number of velocities
+ *      and constraints, i.e. one block of six for every body followed by one constraint block
+ *  @details If the number of velocities is not a multiple of six, the remaining velocities
+ *      form an additional block
+ */
+std::vector<size_t> create_multibody_block_sizes(size_t n_velocities, size_t n_constraints);
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,244 @@
+#include "src/rigid_pendulum_poc/checkpoint.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+constexpr char kMAGIC[4] = {'O', 'T', 'C', 'P'};
+constexpr std::uint32_t kVERSION = 1;
+
+// An enum class to indicate the kind of integrator a checkpoint was taken from
+enum class CheckpointType : std::uint32_t {
+    kSINGLE = 0,   //< A single system, see Checkpoint
+    kBATCHED = 1,  //< An ensemble of systems, see BatchedCheckpoint
+};
+
+template <typename T>
+void write_value(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_value(std::istream& stream) {
+    T value{};
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!stream) {
+        throw std::runtime_error("Unexpected end of the checkpoint file");
+    }
+    return value;
+}
+
+void write_size(std::ostream& stream, size_t size) {
+    write_value(stream, static_cast<std::uint64_t>(size));
+}
+
+size_t read_size(std::istream& stream) {
+    return static_cast<size_t>(read_value<std::uint64_t>(stream));
+}
+
+template <typename View>
+void write_view_1D(std::ostream& stream, const View& view) {
+    write_size(stream, view.extent(0));
+    for (size_t i = 0; i < view.extent(0); ++i) {
+        write_value(stream, view(i));
+    }
+}
+
+template <typename View>
+View read_view_1D(std::istream& stream, const std::string& label) {
+    auto view = View(label, read_size(stream));
+    for (size_t i = 0; i < view.extent(0); ++i) {
+        view(i) = read_value<typename View::value_type>(stream);
+    }
+    return view;
+}
+
+void write_view_2D(std::ostream& stream, const HostView2D view) {
+    write_size(stream, view.extent(0));
+    write_size(stream, view.extent(1));
+    for (size_t i = 0; i < view.extent(0); ++i) {
+        for (size_t j = 0; j < view.extent(1); ++j) {
+            write_value(stream, view(i, j));
+        }
+    }
+}
+
+void read_view_2D(std::istream& stream, HostView2D view) {
+    if (read_size(stream) != view.extent(0) || read_size(stream) != view.extent(1)) {
+        throw std::runtime_error("Unexpected size of a view in the checkpoint file");
+    }
+    for (size_t i = 0; i < view.extent(0); ++i) {
+        for (size_t j = 0; j < view.extent(1); ++j) {
+            view(i, j) = read_value<double>(stream);
+        }
+    }
+}
+
+/// Writes the checkpoint with the provided function into a temporary file, which then replaces
+/// the provided file - a run that dies while writing leaves the previous checkpoint intact
+template <typename WriteFunction>
+void write_checkpoint_file(
+    const std::string& file_name, CheckpointType type, WriteFunction write_contents
+) {
+    const auto temporary_file_name = file_name + ".tmp";
+    {
+        auto file = std::ofstream(
+            temporary_file_name, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc
+        );
+        if (!file) {
+            throw std::runtime_error("Unable to open the checkpoint file " + temporary_file_name);
+        }
+        file.write(kMAGIC, sizeof(kMAGIC));
+        write_value(file, kVERSION);
+        write_value(file, type);
+        write_contents(file);
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("Unable to write the checkpoint file " + temporary_file_name);
+        }
+    }
+
+    if (std::rename(temporary_file_name.c_str(), file_name.c_str()) != 0) {
+        throw std::runtime_error("Unable to replace the checkpoint file " + file_name);
+    }
+}
+
+/// Opens the provided checkpoint file and verifies its header
+std::ifstream open_checkpoint_file(const std::string& file_name, CheckpointType type) {
+    auto file = std::ifstream(file_name, std::ifstream::in | std::ifstream::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open the checkpoint file " + file_name);
+    }
+
+    char magic[sizeof(kMAGIC)];
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + sizeof(magic), kMAGIC) ||
+        read_value<std::uint32_t>(file) != kVERSION) {
+        throw std::runtime_error(file_name + " is not a supported checkpoint file");
+    }
+
+    if (read_value<CheckpointType>(file) != type) {
+        throw std::runtime_error(file_name + " is a checkpoint of a different kind of integrator");
+    }
+    return file;
+}
+
+}  // namespace
+
+void write_checkpoint(const std::string& file_name, const Checkpoint& checkpoint) {
+    write_checkpoint_file(file_name, CheckpointType::kSINGLE, [&checkpoint](std::ostream& file) {
+        write_size(file, checkpoint.step);
+        write_value(file, checkpoint.current_time);
+        write_value(file, checkpoint.time_step);
+        write_size(file, checkpoint.n_iterations);
+        write_size(file, checkpoint.total_n_iterations);
+        write_view_1D(file, checkpoint.state.GetGeneralizedCoordinates());
+        write_view_1D(file, checkpoint.state.GetVelocity());
+        write_view_1D(file, checkpoint.state.GetAcceleration());
+        write_view_1D(file, checkpoint.state.GetAlgorithmicAcceleration());
+        write_view_1D(file, checkpoint.lagrange_mults);
+        write_size(file, checkpoint.n_steps_since_jacobian_update);
+        write_view_2D(file, checkpoint.factors);
+        write_view_1D(file, checkpoint.pivots);
+    });
+}
+
+Checkpoint read_checkpoint(const std::string& file_name) {
+    auto file = open_checkpoint_file(file_name, CheckpointType::kSINGLE);
+
+    auto checkpoint = Checkpoint{};
+    checkpoint.step = read_size(file);
+    checkpoint.current_time = read_value<double>(file);
+    checkpoint.time_step = read_value<double>(file);
+    checkpoint.n_iterations = read_size(file);
+    checkpoint.total_n_iterations = read_size(file);
+    auto q = read_view_1D<HostView1D>(file, "generalized_coordinates");
+    auto v = read_view_1D<HostView1D>(file, "velocities");
+    auto v_dot = read_view_1D<HostView1D>(file, "accelerations");
+    auto a = read_view_1D<HostView1D>(file, "algorithmic_accelerations");
+    checkpoint.state = State(q, v, v_dot, a);
+    checkpoint.lagrange_mults = read_view_1D<HostView1D>(file, "lagrange_mults");
+    checkpoint.n_steps_since_jacobian_update = read_size(file);
+
+    const auto rows = read_size(file);
+    const auto columns = read_size(file);
+    checkpoint.factors = HostView2D("factors", rows, columns);
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < columns; ++j) {
+            checkpoint.factors(i, j) = read_value<double>(file);
+        }
+    }
+    checkpoint.pivots = read_view_1D<HostIntView1D>(file, "pivots");
+    return checkpoint;
+}
+
+void write_checkpoint(const std::string& file_name, const BatchedCheckpoint& checkpoint) {
+    write_checkpoint_file(file_name, CheckpointType::kBATCHED, [&checkpoint](std::ostream& file) {
+        const auto& states = checkpoint.states;
+        write_size(file, checkpoint.step);
+        write_value(file, checkpoint.current_time);
+        write_size(file, checkpoint.total_n_iterations);
+        write_size(file, states.GetNumberOfBodies());
+        write_size(file, states.GetGeneralizedCoordinates().extent(0));
+        write_size(file, states.GetVelocity().extent(0));
+        write_size(file, states.GetLagrangeMultipliers().extent(0));
+        write_view_2D(file, states.GetGeneralizedCoordinates());
+        write_view_2D(file, states.GetVelocity());
+        write_view_2D(file, states.GetAcceleration());
+        write_view_2D(file, states.GetAlgorithmicAcceleration());
+        write_view_2D(file, states.GetLagrangeMultipliers());
+    });
+}
+
+BatchedCheckpoint read_batched_checkpoint(const std::string& file_name) {
+    auto file = open_checkpoint_file(file_name, CheckpointType::kBATCHED);
+
+    const auto step = read_size(file);
+    const auto current_time = read_value<double>(file);
+    const auto total_n_iterations = read_size(file);
+    const auto n_bodies = read_size(file);
+    const auto n_gen_coords = read_size(file);
+    const auto n_velocities = read_size(file);
+    const auto n_constraints = read_size(file);
+
+    auto checkpoint = BatchedCheckpoint{
+        step, current_time, total_n_iterations,
+        BatchedState<Kokkos::HostSpace>(n_bodies, n_gen_coords, n_velocities, n_constraints)};
+    const auto& states = checkpoint.states;
+    read_view_2D(file, states.GetGeneralizedCoordinates());
+    read_view_2D(file, states.GetVelocity());
+    read_view_2D(file, states.GetAcceleration());
+    read_view_2D(file, states.GetAlgorithmicAcceleration());
+    read_view_2D(file, states.GetLagrangeMultipliers());
+    return checkpoint;
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+    if (pending_write_.valid()) {
+        // Errors can only be reported by an explicit call to Wait()
+        pending_write_.wait();
+    }
+}
+
+void AsyncCheckpointWriter::Write(const std::string& file_name, BatchedCheckpoint checkpoint) {
+    this->Wait();
+    pending_write_ = std::async(
+        std::launch::async,
+        [file_name, checkpoint = std::move(checkpoint)]() {
+            write_checkpoint(file_name, checkpoint);
+        }
+    );
+}
+
+void AsyncCheckpointWriter::Wait() {
+    if (pending_write_.valid()) {
+        pending_write_.get();
+    }
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <future>
+#include <stdexcept>
+#include <string>
+
+#include "src/rigid_pendulum_poc/batched_state.h"
+#include "src/rigid_pendulum_poc/state.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// @brief Policy for writing checkpoints while a time integration runs
+struct CheckpointPolicy {
+    std::string file_name;  //< File holding the latest checkpoint, overwritten by every write
+    size_t interval = 0;    //< Number of time steps between two checkpoints, zero to disable
+};
+
+/*! @brief Everything required to resume a time integration with the same results as if it
+ *      had never stopped
+ *  @details Besides the state and the time stepper counters, the checkpoint keeps the
+ *      factorization of the iteration matrix, since a modified Newton iteration may reuse it
+ *      in the time steps after the checkpoint
+ */
+struct Checkpoint {
+    size_t step;                           //< Index of the latest completed time step
+    double current_time;                   //< Current time of the time stepper
+    double time_step;                      //< Time step of the next time step
+    size_t n_iterations;                   //< Number of iterations of the latest time step
+    size_t total_n_iterations;             //< Total number of iterations thus far
+    State state;                           //< State at the end of the latest time step
+    HostView1D lagrange_mults;             //< Lagrange multipliers at the end of the time step
+    size_t n_steps_since_jacobian_update;  //< Number of steps since the latest factorization
+    HostView2D factors;                    //< LU factors of the iteration matrix, empty if none
+    HostIntView1D pivots;                  //< Pivot indices of the factorization, empty if none
+};
+
+/// @brief The states of an ensemble and the time stepper counters to resume its integration
+struct BatchedCheckpoint {
+    size_t step;                             //< Index of the latest completed time step
+    double current_time;                     //< Current time of the time stepper
+    size_t total_n_iterations;               //< Total number of iterations thus far
+    BatchedState<Kokkos::HostSpace> states;  //< Host copy of the states of all bodies
+};
+
+/// Writes the provided checkpoint in a compact binary format, replacing any existing file only
+/// once the checkpoint has been written completely
+void write_checkpoint(const std::string& file_name, const Checkpoint&);
+
+/// Reads a checkpoint written by write_checkpoint()
+Checkpoint read_checkpoint(const std::string& file_name);
+
+/// Writes the provided ensemble checkpoint, see write_checkpoint()
+void write_checkpoint(const std::string& file_name, const BatchedCheckpoint&);
+
+/// Reads an ensemble checkpoint written by write_checkpoint()
+BatchedCheckpoint read_batched_checkpoint(const std::string& file_name);
+
+/// Copies the states of all bodies between batched states in any memory spaces
+template <typename DestinationSpace, typename SourceSpace>
+void copy_batched_state(
+    const BatchedState<DestinationSpace>& destination, const BatchedState<SourceSpace>& source
+) {
+    const auto copy_view = [](const auto& destination_view, const auto& source_view) {
+        if (destination_view.extent(0) != source_view.extent(0) ||
+            destination_view.extent(1) != source_view.extent(1)) {
+            throw std::invalid_argument("The provided batched states must be of the same size");
+        }
+        // Copy through host mirrors, since the layouts of the memory spaces may differ
+        auto source_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), source_view);
+        auto destination_host = Kokkos::create_mirror_view(destination_view);
+        for (size_t i = 0; i < source_view.extent(0); ++i) {
+            for (size_t j = 0; j < source_view.extent(1); ++j) {
+                destination_host(i, j) = source_host(i, j);
+            }
+        }
+        Kokkos::deep_copy(destination_view, destination_host);
+    };
+
+    copy_view(destination.GetGeneralizedCoordinates(), source.GetGeneralizedCoordinates());
+    copy_view(destination.GetVelocity(), source.GetVelocity());
+    copy_view(destination.GetAcceleration(), source.GetAcceleration());
+    copy_view(destination.GetAlgorithmicAcceleration(), source.GetAlgorithmicAcceleration());
+    copy_view(destination.GetLagrangeMultipliers(), source.GetLagrangeMultipliers());
+}
+
+/*! @brief Writes ensemble checkpoints on a background thread
+ *  @details The states are copied to the host when a checkpoint is taken, afterwards the time
+ *      integration continues while the copy is written. At most one write is in flight, i.e.
+ *      taking a checkpoint waits only if the previous one has not been written yet.
+ */
+class AsyncCheckpointWriter {
+public:
+    AsyncCheckpointWriter() = default;
+
+    /// Waits for the pending write, if any
+    ~AsyncCheckpointWriter();
+
+    AsyncCheckpointWriter(const AsyncCheckpointWriter&) = delete;
+    AsyncCheckpointWriter& operator=(const AsyncCheckpointWriter&) = delete;
+
+    /// Starts writing the provided checkpoint to the provided file in the background
+    void Write(const std::string& file_name, BatchedCheckpoint checkpoint);
+
+    /// Waits for the pending write, if any, and rethrows any error raised while writing
+    void Wait();
+
+    /// Returns if a write is in flight
+    inline bool IsPending() const { return pending_write_.valid(); }
+
+private:
+    std::future<void> pending_write_;  //< Pending write of the latest checkpoint
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,260 @@
+#include "src/rigid_pendulum_poc/coupling.h"
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+/// Throws a runtime error with the provided message and the description of errno
+[[noreturn]] void throw_system_error(const std::string& message) {
+    throw std::runtime_error(message + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+SharedMemorySegment::SharedMemorySegment(std::string name, void* data, size_t size, bool is_owner)
+    : name_(std::move(name)), data_(data), size_(size), is_owner_(is_owner) {
+}
+
+std::shared_ptr<SharedMemorySegment> SharedMemorySegment::Create(
+    const std::string& name, size_t size
+) {
+    if (size == 0) {
+        throw std::invalid_argument("The size of the shared memory segment must be > 0");
+    }
+
+    shm_unlink(name.c_str());
+    const auto file_descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (file_descriptor < 0) {
+        throw_system_error("Cannot create the shared memory segment " + name);
+    }
+    if (ftruncate(file_descriptor, static_cast<off_t>(size)) != 0) {
+        close(file_descriptor);
+        shm_unlink(name.c_str());
+        throw_system_error("Cannot size the shared memory segment " + name);
+    }
+
+    auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+    if (data == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw_system_error("Cannot map the shared memory segment " + name);
+    }
+    return std::shared_ptr<SharedMemorySegment>(new SharedMemorySegment(name, data, size, true));
+}
+
+std::shared_ptr<SharedMemorySegment> SharedMemorySegment::Open(const std::string& name) {
+    const auto file_descriptor = shm_open(name.c_str(), O_RDWR, 0600);
+    if (file_descriptor < 0) {
+        throw_system_error("Cannot open the shared memory segment " + name);
+    }
+
+    struct stat status {};
+    if (fstat(file_descriptor, &status) != 0 || status.st_size <= 0) {
+        close(file_descriptor);
+        throw_system_error("Cannot determine the size of the shared memory segment " + name);
+    }
+
+    const auto size = static_cast<size_t>(status.st_size);
+    auto* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    close(file_descriptor);
+    if (data == MAP_FAILED) {
+        throw_system_error("Cannot map the shared memory segment " + name);
+    }
+    return std::shared_ptr<SharedMemorySegment>(new SharedMemorySegment(name, data, size, false));
+}
+
+SharedMemorySegment::~SharedMemorySegment() {
+    munmap(data_, size_);
+    if (is_owner_) {
+        shm_unlink(name_.c_str());
+    }
+}
+
+CouplingChannel::CouplingChannel(std::shared_ptr<void> memory)
+    : memory_(std::move(memory)),
+      header_(static_cast<Header*>(memory_.get())),
+      slots_(reinterpret_cast<double*>(static_cast<char*>(memory_.get()) + kSlotsOffset)),
+      timeout_(std::chrono::seconds(60)) {
+    // Processes sharing a segment synchronize through the atomics of the header
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<uint32_t>::is_always_lock_free);
+}
+
+CouplingChannel::CouplingChannel(size_t n_loads, size_t n_kinematics, size_t pipeline_depth)
+    : CouplingChannel(std::shared_ptr<double[]>(
+          new double[RequiredBytes(n_loads, n_kinematics, pipeline_depth) / sizeof(double)]
+      )) {
+    Initialize(memory_.get(), n_loads, n_kinematics, pipeline_depth);
+}
+
+CouplingChannel CouplingChannel::Create(
+    const std::string& name, size_t n_loads, size_t n_kinematics, size_t pipeline_depth
+) {
+    auto segment =
+        SharedMemorySegment::Create(name, RequiredBytes(n_loads, n_kinematics, pipeline_depth));
+    Initialize(segment->GetData(), n_loads, n_kinematics, pipeline_depth);
+    // The memory of the channel is the data of the segment, which it keeps alive
+    return CouplingChannel(std::shared_ptr<void>(segment, segment->GetData()));
+}
+
+CouplingChannel CouplingChannel::Attach(const std::string& name) {
+    auto segment = SharedMemorySegment::Open(name);
+    if (segment->GetSize() < kSlotsOffset) {
+        throw std::runtime_error("The shared memory segment " + name + " is not a channel");
+    }
+
+    const auto* header = static_cast<const Header*>(segment->GetData());
+    if (segment->GetSize() <
+        RequiredBytes(header->n_loads, header->n_kinematics, header->pipeline_depth)) {
+        throw std::runtime_error("The shared memory segment " + name + " is not a channel");
+    }
+    return CouplingChannel(std::shared_ptr<void>(segment, segment->GetData()));
+}
+
+size_t CouplingChannel::RequiredBytes(size_t n_loads, size_t n_kinematics, size_t pipeline_depth) {
+    if (n_loads == 0 || n_kinematics == 0) {
+        throw std::invalid_argument("The numbers of loads and kinematics must be > 0");
+    }
+    return kSlotsOffset + (pipeline_depth + 2) * (n_loads + n_kinematics) * sizeof(double);
+}
+
+void CouplingChannel::Initialize(
+    void* data, size_t n_loads, size_t n_kinematics, size_t pipeline_depth
+) {
+    auto* header = new (data) Header{};
+    header->n_loads = n_loads;
+    header->n_kinematics = n_kinematics;
+    header->pipeline_depth = pipeline_depth;
+    header->kinematics_sequence.store(0, std::memory_order_relaxed);
+    // The loads of the initial state are never exchanged, i.e. count as published
+    header->loads_sequence.store(1, std::memory_order_relaxed);
+    header->is_closed.store(0, std::memory_order_release);
+}
+
+HostView1D CouplingChannel::GetKinematics(size_t step) const {
+    const auto n_slots = GetPipelineDepth() + 2;
+    auto* kinematics = slots_ + n_slots * GetNumberOfLoads();
+    return HostView1D(
+        kinematics + (step % n_slots) * GetNumberOfKinematics(), GetNumberOfKinematics()
+    );
+}
+
+HostView1D CouplingChannel::GetLoads(size_t step) const {
+    const auto n_slots = GetPipelineDepth() + 2;
+    return HostView1D(slots_ + (step % n_slots) * GetNumberOfLoads(), GetNumberOfLoads());
+}
+
+void CouplingChannel::PublishKinematics(size_t step) {
+    if (step != header_->kinematics_sequence.load(std::memory_order_relaxed)) {
+        throw std::invalid_argument(
+            "The kinematics must be published once per time step, in order"
+        );
+    }
+    header_->kinematics_sequence.store(step + 1, std::memory_order_release);
+}
+
+void CouplingChannel::PublishLoads(size_t step) {
+    if (step != header_->loads_sequence.load(std::memory_order_relaxed)) {
+        throw std::invalid_argument("The loads must be published once per time step, in order");
+    }
+    header_->loads_sequence.store(step + 1, std::memory_order_release);
+}
+
+bool CouplingChannel::WaitForKinematics(size_t step) const {
+    return Wait(header_->kinematics_sequence, step);
+}
+
+bool CouplingChannel::WaitForLoads(size_t step) const {
+    return Wait(header_->loads_sequence, step);
+}
+
+bool CouplingChannel::Wait(const std::atomic<uint64_t>& sequence, size_t step) const {
+    // Spin briefly, since the other side is typically about to publish, then yield the core
+    constexpr auto kSpinIterations = 1000;
+    const auto start = std::chrono::steady_clock::now();
+    auto n_spins = 0;
+    while (sequence.load(std::memory_order_acquire) <= step) {
+        if (IsClosed()) {
+            // The other side may have published right before closing the channel
+            return sequence.load(std::memory_order_acquire) > step;
+        }
+        if (n_spins < kSpinIterations) {
+            n_spins++;
+            continue;
+        }
+        if (std::chrono::steady_clock::now() - start > timeout_) {
+            throw std::runtime_error(
+                "Timed out waiting for time step " + std::to_string(step) +
+                " of the coupled code"
+            );
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void CouplingChannel::Close() {
+    header_->is_closed.store(1, std::memory_order_release);
+}
+
+LoadCouplingObserver::LoadCouplingObserver(
+    std::shared_ptr<CouplingChannel> channel, std::shared_ptr<LinearizationParameters> problem
+)
+    : channel_(std::move(channel)), problem_(std::move(problem)) {
+    if (channel_ == nullptr || problem_ == nullptr) {
+        throw std::invalid_argument("The provided channel and problem must not be null");
+    }
+}
+
+size_t LoadCouplingObserver::KinematicsSize(size_t n_gen_coords, size_t n_velocities) {
+    return 1 + n_gen_coords + 2 * n_velocities;
+}
+
+void LoadCouplingObserver::Observe(const TimeStepRecord& record) {
+    const auto& state = record.state;
+    const auto n_gen_coords = state.GetGeneralizedCoordinates().extent(0);
+    const auto n_velocities = state.GetVelocity().extent(0);
+    if (KinematicsSize(n_gen_coords, n_velocities) != channel_->GetNumberOfKinematics() ||
+        n_velocities != channel_->GetNumberOfLoads()) {
+        throw std::invalid_argument("The sizes of the state must match the coupling channel");
+    }
+
+    // Write the kinematics in place, i.e. into the slot of the time step
+    auto kinematics = channel_->GetKinematics(record.step);
+    kinematics(0) = record.time;
+    for (size_t i = 0; i < n_gen_coords; ++i) {
+        kinematics(1 + i) = state.GetGeneralizedCoordinates()(i);
+    }
+    for (size_t i = 0; i < n_velocities; ++i) {
+        kinematics(1 + n_gen_coords + i) = state.GetVelocity()(i);
+        kinematics(1 + n_gen_coords + n_velocities + i) = state.GetAcceleration()(i);
+    }
+    channel_->PublishKinematics(record.step);
+
+    // The residual vector reads the loads of the next time step from their slot
+    const auto next_step = record.step + 1;
+    if (!channel_->WaitForLoads(next_step)) {
+        throw std::runtime_error(
+            "The coupled code closed the channel before the loads of time step " +
+            std::to_string(next_step)
+        );
+    }
+    problem_->SetExternalLoads(channel_->GetLoads(next_step));
+}
+
+void LoadCouplingObserver::Finalize() {
+    channel_->Close();
+}
+
+}  // namespace openturbine::rigid_pendulum
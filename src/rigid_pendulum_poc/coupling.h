@@ -0,0 +1,193 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "src/rigid_pendulum_poc/linearization_parameters.h"
+#include "src/rigid_pendulum_poc/state_observer.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief A named POSIX shared memory segment mapped into this process, e.g. to exchange loads
+ *      and kinematics with a code running in another process
+ *  @details The segment is unmapped on destruction and, if this process created it, removed.
+ */
+class SharedMemorySegment {
+public:
+    /// Creates the segment of the provided name (e.g. "/openturbine_coupling") and size, i.e.
+    /// replaces any segment of that name
+    static std::shared_ptr<SharedMemorySegment> Create(const std::string& name, size_t size);
+
+    /// Opens the segment of the provided name that another process created
+    static std::shared_ptr<SharedMemorySegment> Open(const std::string& name);
+
+    ~SharedMemorySegment();
+
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    /// Returns the name of the segment
+    inline const std::string& GetName() const { return name_; }
+
+    /// Returns the address of the segment in this process
+    inline void* GetData() const { return data_; }
+
+    /// Returns the size of the segment in bytes
+    inline size_t GetSize() const { return size_; }
+
+private:
+    SharedMemorySegment(std::string name, void* data, size_t size, bool is_owner);
+
+    std::string name_;  //< Name of the segment
+    void* data_;        //< Address of the mapped segment
+    size_t size_;       //< Size of the segment in bytes
+    bool is_owner_;     //< Flag to indicate if this process created the segment
+};
+
+/*! @brief Exchanges the external loads and the kinematics of a time integration with an
+ *      external code, e.g. an aerodynamic or controller code, through buffers of preregistered
+ *      memory, i.e. without serializing or copying them
+ *  @details The loads of the time steps n >= 1 are computed by the external code from the
+ *      kinematics of the time step GetKinematicsStep(n) = max(n - 1 - pipeline depth, 0). With a
+ *      pipeline depth of zero, the conventional staggered coupling, the loads of a time step
+ *      follow from the kinematics of the previous time step, i.e. the codes run in turns. With a
+ *      pipeline depth of one, the external code evaluates the loads of the next time step while
+ *      the time integrator solves the current one, at the cost of loads lagging one more step.
+ *
+ *      Both sides write into and read from the slots of the buffers in place - pipeline depth + 2
+ *      slots per buffer, so that a slot is never written while the other side still reads it -
+ *      and publish a slot by incrementing its sequence number with release semantics. The
+ *      waiting side acquires the sequence number, i.e. sees the values of the published slot.
+ *      The external code runs, e.g. in another thread:
+ *
+ *          for (size_t step = 1; channel.WaitForKinematics(channel.GetKinematicsStep(step));
+ *               ++step) {
+ *              evaluate(channel.GetKinematics(channel.GetKinematicsStep(step)),
+ *                       channel.GetLoads(step));
+ *              channel.PublishLoads(step);
+ *          }
+ *
+ *      The channel lives in memory of this process or in a SharedMemorySegment, whose layout is
+ *      a header of the sizes and sequence numbers followed by the slots of the loads and the
+ *      kinematics as doubles.
+ */
+class CouplingChannel {
+public:
+    /// Creates a channel in memory of this process, e.g. for an external code in another thread
+    CouplingChannel(size_t n_loads, size_t n_kinematics, size_t pipeline_depth = 0);
+
+    /// Creates a channel in a new shared memory segment of the provided name
+    static CouplingChannel Create(
+        const std::string& name, size_t n_loads, size_t n_kinematics, size_t pipeline_depth = 0
+    );
+
+    /// Attaches to the channel that another process created in the shared memory segment of the
+    /// provided name
+    static CouplingChannel Attach(const std::string& name);
+
+    /// Returns the number of bytes of a channel of the provided sizes
+    static size_t RequiredBytes(size_t n_loads, size_t n_kinematics, size_t pipeline_depth = 0);
+
+    /// Returns the number of loads per time step
+    inline size_t GetNumberOfLoads() const { return header_->n_loads; }
+
+    /// Returns the number of kinematic quantities per time step
+    inline size_t GetNumberOfKinematics() const { return header_->n_kinematics; }
+
+    /// Returns the number of time steps the loads are evaluated ahead of the time integration
+    inline size_t GetPipelineDepth() const { return header_->pipeline_depth; }
+
+    /// Returns the time step whose kinematics the loads of the provided time step follow from
+    inline size_t GetKinematicsStep(size_t load_step) const {
+        return (load_step > 1 + GetPipelineDepth()) ? load_step - 1 - GetPipelineDepth() : 0;
+    }
+
+    /// Returns the slot of the kinematics of the provided time step, as a view of the channel
+    HostView1D GetKinematics(size_t step) const;
+
+    /// Returns the slot of the loads of the provided time step, as a view of the channel
+    HostView1D GetLoads(size_t step) const;
+
+    /// Publishes the kinematics of the provided time step, written to its slot beforehand
+    void PublishKinematics(size_t step);
+
+    /// Publishes the loads of the provided time step, written to its slot beforehand
+    void PublishLoads(size_t step);
+
+    /// Waits until the kinematics of the provided time step are published, returns false if the
+    /// channel was closed before, and throws if the timeout expires
+    bool WaitForKinematics(size_t step) const;
+
+    /// Waits until the loads of the provided time step are published, returns false if the
+    /// channel was closed before, and throws if the timeout expires
+    bool WaitForLoads(size_t step) const;
+
+    /// Closes the channel, i.e. signals the other side that no further time steps follow
+    void Close();
+
+    /// Returns if either side closed the channel
+    inline bool IsClosed() const { return header_->is_closed.load(std::memory_order_acquire); }
+
+    /// Sets the maximum time to wait for the other side
+    inline void SetTimeout(std::chrono::duration<double> timeout) { timeout_ = timeout; }
+
+private:
+    /// Sizes and sequence numbers at the start of the memory of a channel, i.e. shared between
+    /// the processes of a shared memory segment
+    struct Header {
+        uint64_t n_loads;                          //< Number of loads per time step
+        uint64_t n_kinematics;                     //< Number of kinematics per time step
+        uint64_t pipeline_depth;                   //< Time steps the loads are evaluated ahead
+        std::atomic<uint64_t> kinematics_sequence;  //< Latest published kinematics step + 1
+        std::atomic<uint64_t> loads_sequence;       //< Latest published loads step + 1
+        std::atomic<uint32_t> is_closed;            //< Flag to indicate if the channel is closed
+    };
+
+    /// Offset of the slots from the start of the memory, i.e. a whole number of cache lines
+    static constexpr size_t kSlotsOffset = (sizeof(Header) + 63) / 64 * 64;
+
+    explicit CouplingChannel(std::shared_ptr<void> memory);
+
+    /// Initializes the header of new memory of a channel
+    static void Initialize(void* data, size_t n_loads, size_t n_kinematics, size_t pipeline_depth);
+
+    /// Waits until the provided sequence number exceeds the provided step
+    bool Wait(const std::atomic<uint64_t>& sequence, size_t step) const;
+
+    std::shared_ptr<void> memory_;           //< Owner of the memory of the channel
+    Header* header_;                         //< Header at the start of the memory
+    double* slots_;                          //< Slots of the loads followed by the kinematics
+    std::chrono::duration<double> timeout_;  //< Maximum time to wait for the other side
+};
+
+/*! @brief Couples a time integration to an external code through a CouplingChannel
+ *  @details Publishes the time, the generalized coordinates, the velocities, and the
+ *      accelerations of every time step, then waits for the loads of the next time step and
+ *      registers their slot with the problem via LinearizationParameters::SetExternalLoads(),
+ *      i.e. the residual vector reads the loads in place. The channel is closed after the last
+ *      time step, so the external code evaluates the loads of one time step past it.
+ */
+class LoadCouplingObserver : public StateObserver {
+public:
+    LoadCouplingObserver(
+        std::shared_ptr<CouplingChannel> channel, std::shared_ptr<LinearizationParameters> problem
+    );
+
+    /// Returns the number of kinematics per time step of a problem of the provided sizes, i.e.
+    /// one time, the generalized coordinates, the velocities, and the accelerations
+    static size_t KinematicsSize(size_t n_gen_coords, size_t n_velocities);
+
+    void Observe(const TimeStepRecord&) override;
+
+    void Finalize() override;
+
+private:
+    std::shared_ptr<CouplingChannel> channel_;          //< Channel to the external code
+    std::shared_ptr<LinearizationParameters> problem_;  //< Problem the loads are applied to
+};
+
+}  // namespace openturbine::rigid_pendulum
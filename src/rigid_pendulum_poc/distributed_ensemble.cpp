@@ -0,0 +1,113 @@
+#include "src/rigid_pendulum_poc/distributed_ensemble.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "src/utilities/log.h"
+
+namespace openturbine::rigid_pendulum {
+
+EnsemblePartition partition_ensemble(size_t n_bodies, size_t n_ranks, size_t rank) {
+    if (rank >= n_ranks) {
+        throw std::invalid_argument("The rank must be less than the number of ranks");
+    }
+
+    // The first n_bodies % n_ranks ranks hold one body more than the others
+    const auto n_bodies_per_rank = n_bodies / n_ranks;
+    const auto n_remaining_bodies = n_bodies % n_ranks;
+    const auto n_larger_ranks = std::min(rank, n_remaining_bodies);
+    return EnsemblePartition{
+        rank * n_bodies_per_rank + n_larger_ranks,
+        n_bodies_per_rank + (rank < n_remaining_bodies ? 1 : 0)};
+}
+
+EnsembleStepStatistics reduce_step_statistics(
+    const util::Communicator& communicator, size_t n_bodies, size_t n_converged_bodies,
+    size_t max_iterations, double wall_time
+) {
+    // Counts of up to 2^53 bodies are exact in doubles, so that all sums share one reduction,
+    // and all minima/maxima another one by negating the minima
+    const auto sums = communicator.Sum(std::array<double, 3>{
+        static_cast<double>(n_bodies), static_cast<double>(n_converged_bodies), wall_time});
+    const auto maxima = communicator.Max(
+        std::array<double, 3>{static_cast<double>(max_iterations), wall_time, -wall_time}
+    );
+
+    auto statistics = EnsembleStepStatistics{};
+    statistics.n_bodies = static_cast<size_t>(sums[0]);
+    statistics.n_converged_bodies = static_cast<size_t>(sums[1]);
+    statistics.max_iterations = static_cast<size_t>(maxima[0]);
+    statistics.min_wall_time = -maxima[2];
+    statistics.mean_wall_time = sums[2] / static_cast<double>(communicator.GetSize());
+    statistics.max_wall_time = maxima[1];
+    return statistics;
+}
+
+template <typename ExecutionSpace>
+DistributedEnsembleIntegrator<ExecutionSpace>::DistributedEnsembleIntegrator(
+    util::Communicator communicator, size_t n_bodies, double alpha_f, double alpha_m,
+    double beta, double gamma, TimeStepper time_stepper, bool precondition
+)
+    : communicator_(std::move(communicator)),
+      n_bodies_(n_bodies),
+      partition_(partition_ensemble(n_bodies, communicator_.GetSize(), communicator_.GetRank())),
+      batched_integrator_(alpha_f, alpha_m, beta, gamma, std::move(time_stepper), precondition),
+      is_converged_(true) {
+}
+
+template <typename ExecutionSpace>
+void DistributedEnsembleIntegrator<ExecutionSpace>::Integrate(
+    BatchedStateType& states, const BodiesView bodies, const StepCallback& on_step
+) {
+    if (states.GetNumberOfBodies() != partition_.n_bodies) {
+        throw std::invalid_argument(
+            "The number of states must match the number of bodies of the partition of rank " +
+            std::to_string(communicator_.GetRank())
+        );
+    }
+
+    // The wall time of a step is the increment of the total wall time of the batched integrator
+    auto previous_wall_time =
+        batched_integrator_.GetTimeStepper().GetWallTimeStatistics().GetTotal();
+    is_converged_ = true;
+    const auto reduce_statistics = [&](size_t step, const BatchedStateType& step_states) {
+        const auto& time_stepper = batched_integrator_.GetTimeStepper();
+        const auto wall_time = time_stepper.GetWallTimeStatistics().GetTotal();
+        latest_step_statistics_ = reduce_step_statistics(
+            communicator_, partition_.n_bodies, batched_integrator_.GetNumberOfConvergedBodies(),
+            time_stepper.GetNumberOfIterations(), wall_time - previous_wall_time
+        );
+        previous_wall_time = wall_time;
+
+        wall_time_.Add(latest_step_statistics_.max_wall_time);
+        iterations_.Add(static_cast<double>(latest_step_statistics_.max_iterations));
+        is_converged_ = is_converged_ && latest_step_statistics_.n_converged_bodies ==
+                                             latest_step_statistics_.n_bodies;
+
+        if (communicator_.IsRoot()) {
+            OTURB_LOG_INFO(
+                "Step " + std::to_string(step) + " of the distributed ensemble: " +
+                std::to_string(latest_step_statistics_.n_converged_bodies) + " of " +
+                std::to_string(latest_step_statistics_.n_bodies) + " bodies converged in at most " +
+                std::to_string(latest_step_statistics_.max_iterations + 1) +
+                " iterations, slowest rank took " +
+                std::to_string(latest_step_statistics_.max_wall_time) + " s\n"
+            );
+        }
+        if (on_step) {
+            on_step(step, step_states);
+        }
+    };
+
+    batched_integrator_.Integrate(states, bodies, reduce_statistics);
+}
+
+template class DistributedEnsembleIntegrator<Kokkos::DefaultHostExecutionSpace>;
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+template class DistributedEnsembleIntegrator<Kokkos::DefaultExecutionSpace>;
+#endif
+
+}  // namespace openturbine::rigid_pendulum
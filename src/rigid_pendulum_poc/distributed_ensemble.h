@@ -0,0 +1,114 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/batched_generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/time_stepper.h"
+#include "src/utilities/communicator.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// @brief The contiguous range of the bodies of an ensemble assigned to one process
+struct EnsemblePartition {
+    size_t first_body;  //< Index of the first body of the process in the whole ensemble
+    size_t n_bodies;    //< Number of bodies of the process
+};
+
+/// Returns the partition of the provided rank, i.e. of contiguous blocks of bodies whose sizes
+/// differ by at most one body over all ranks - throws if the rank is not one of the ranks
+EnsemblePartition partition_ensemble(size_t n_bodies, size_t n_ranks, size_t rank);
+
+/// @brief The statistics of one time step of a whole ensemble, i.e. over all processes
+struct EnsembleStepStatistics {
+    size_t n_bodies = 0;            //< Number of bodies of the ensemble
+    size_t n_converged_bodies = 0;  //< Number of bodies whose iterations converged
+    size_t max_iterations = 0;      //< Number of iterations of the slowest body
+    double min_wall_time = 0.;      //< Wall time (s) of the fastest process
+    double mean_wall_time = 0.;     //< Mean wall time (s) of the processes
+    double max_wall_time = 0.;      //< Wall time (s) of the slowest process, i.e. of the step
+};
+
+/// Reduces the provided statistics of the bodies of this process over all processes of the
+/// communicator - collective, i.e. every process must call it for every time step
+EnsembleStepStatistics reduce_step_statistics(
+    const util::Communicator&, size_t n_bodies, size_t n_converged_bodies, size_t max_iterations,
+    double wall_time
+);
+
+/*! @brief A generalized-alpha time integrator of an ensemble of heavy tops distributed over the
+ *      processes of a communicator, e.g. the rotors of a wind farm or the members of a study
+ *  @details Every process owns one partition of the bodies (see partition_ensemble()) and
+ *      advances it with its own BatchedGeneralizedAlphaTimeIntegrator, i.e. on the execution
+ *      space and device of that process. The bodies are independent, so the only communication
+ *      of a time step is the reduction of its statistics into two small collectives - the work
+ *      and memory of a process is that of its partition, however many processes there are.
+ */
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+class DistributedEnsembleIntegrator {
+public:
+    using BatchedIntegratorType = BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>;
+    using BatchedStateType = typename BatchedIntegratorType::BatchedStateType;
+    using BodiesView = typename BatchedIntegratorType::BodiesView;
+    using StepCallback = typename BatchedIntegratorType::StepCallback;
+
+    /// Constructs the integrator of the partition of this process of an ensemble of n_bodies
+    DistributedEnsembleIntegrator(
+        util::Communicator communicator, size_t n_bodies, double alpha_f = 0.5,
+        double alpha_m = 0.5, double beta = 0.25, double gamma = 0.5,
+        TimeStepper time_stepper = TimeStepper(), bool precondition = false
+    );
+
+    /// Returns the communicator of the processes sharing the ensemble
+    inline const util::Communicator& GetCommunicator() const { return communicator_; }
+
+    /// Returns the number of bodies of the whole ensemble
+    inline size_t GetNumberOfBodies() const { return n_bodies_; }
+
+    /// Returns the partition of the bodies of this process
+    inline const EnsemblePartition& GetPartition() const { return partition_; }
+
+    /// Returns the integrator of the partition of this process, e.g. to set its checkpoint policy
+    /// - every process should then write to the file of its rank
+    inline BatchedIntegratorType& GetBatchedIntegrator() { return batched_integrator_; }
+
+    /// Returns a const reference to the integrator of the partition of this process
+    inline const BatchedIntegratorType& GetBatchedIntegrator() const {
+        return batched_integrator_;
+    }
+
+    /*! @brief Performs the time integration of the partition of this process - collective
+     *  @details The provided states and bodies are those of the partition, i.e. the bodies
+     *      first_body to first_body + n_bodies - 1 of the ensemble. The optional callback is
+     *      called after every time step once its statistics have been reduced.
+     */
+    void Integrate(
+        BatchedStateType&, const BodiesView bodies, const StepCallback& on_step = StepCallback()
+    );
+
+    /// Returns the statistics of the latest time step of the whole ensemble
+    inline const EnsembleStepStatistics& GetLatestStepStatistics() const {
+        return latest_step_statistics_;
+    }
+
+    /// Returns the statistics of the wall time (s) of the slowest process over the time steps
+    inline const RunningStatistics& GetWallTimeStatistics() const { return wall_time_; }
+
+    /// Returns the statistics of the iterations of the slowest body over the time steps
+    inline const RunningStatistics& GetIterationStatistics() const { return iterations_; }
+
+    /// Returns if all bodies of the ensemble converged in every time step thus far
+    inline bool IsConverged() const { return is_converged_; }
+
+private:
+    util::Communicator communicator_;          //< Processes sharing the ensemble
+    size_t n_bodies_;                          //< Number of bodies of the whole ensemble
+    EnsemblePartition partition_;              //< Bodies of this process
+    BatchedIntegratorType batched_integrator_;  //< Integrator of the bodies of this process
+
+    EnsembleStepStatistics latest_step_statistics_;  //< Statistics of the latest time step
+    RunningStatistics wall_time_;                    //< Wall time of the slowest process
+    RunningStatistics iterations_;                   //< Iterations of the slowest body
+    bool is_converged_;                              //< Flag if all bodies always converged
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief A forward-mode automatic differentiation number, i.e. a value together with its
+ *      derivatives with respect to N independent directions
+ *  @details The number of directions is known at compile time, so a Dual lives on the
+ *      stack/in registers like Vec and Matrix, and all of its operations are callable from
+ *      inside Kokkos kernels. Code that is templated on its scalar type, e.g. Vec<3, Scalar>,
+ *      therefore evaluates its value and N directional derivatives in one pass when
+ *      instantiated with Dual<N>. Comparisons only consider the values.
+ */
+template <size_t N>
+class Dual {
+public:
+    static constexpr size_t kNumberOfDerivatives = N;
+
+    /// Constructs a constant, i.e. a number with zero derivatives
+    KOKKOS_INLINE_FUNCTION constexpr Dual(double value = 0.) : value_(value), derivatives_{} {}
+
+    /// Constructs an independent variable, i.e. a number with a unit derivative in the provided
+    /// direction
+    KOKKOS_INLINE_FUNCTION constexpr Dual(double value, size_t direction)
+        : value_(value), derivatives_{} {
+        derivatives_[direction] = 1.;
+    }
+
+    /// Returns the value of the number
+    KOKKOS_INLINE_FUNCTION constexpr double GetValue() const { return value_; }
+
+    /// Returns the derivative of the number in the provided direction
+    KOKKOS_INLINE_FUNCTION constexpr double GetDerivative(size_t direction) const {
+        return derivatives_[direction];
+    }
+
+    /// Sets the derivative of the number in the provided direction
+    KOKKOS_INLINE_FUNCTION constexpr void SetDerivative(size_t direction, double derivative) {
+        derivatives_[direction] = derivative;
+    }
+
+    /// Returns the negative of this number
+    KOKKOS_INLINE_FUNCTION constexpr Dual operator-() const { return Scale(-1.); }
+
+    /// Adds provided number to this number in place
+    KOKKOS_INLINE_FUNCTION constexpr Dual& operator+=(const Dual& other) {
+        value_ += other.value_;
+        for (size_t i = 0; i < N; ++i) {
+            derivatives_[i] += other.derivatives_[i];
+        }
+        return *this;
+    }
+
+    /// Subtracts provided number from this number in place
+    KOKKOS_INLINE_FUNCTION constexpr Dual& operator-=(const Dual& other) {
+        value_ -= other.value_;
+        for (size_t i = 0; i < N; ++i) {
+            derivatives_[i] -= other.derivatives_[i];
+        }
+        return *this;
+    }
+
+    /// Multiplies this number with provided number in place, i.e. (u v)' = u' v + u v'
+    KOKKOS_INLINE_FUNCTION constexpr Dual& operator*=(const Dual& other) {
+        for (size_t i = 0; i < N; ++i) {
+            derivatives_[i] = derivatives_[i] * other.value_ + value_ * other.derivatives_[i];
+        }
+        value_ *= other.value_;
+        return *this;
+    }
+
+    /// Divides this number by provided number in place, i.e. (u / v)' = (u' - (u / v) v') / v
+    KOKKOS_INLINE_FUNCTION constexpr Dual& operator/=(const Dual& other) {
+        value_ /= other.value_;
+        for (size_t i = 0; i < N; ++i) {
+            derivatives_[i] = (derivatives_[i] - value_ * other.derivatives_[i]) / other.value_;
+        }
+        return *this;
+    }
+
+    /// Returns the number f(u) of the provided value f(u) and derivative f'(u) of a function at
+    /// the value of this number, i.e. applies the chain rule f(u)' = f'(u) u'
+    KOKKOS_INLINE_FUNCTION constexpr Dual Chain(double value, double derivative) const {
+        auto result = Scale(derivative);
+        result.value_ = value;
+        return result;
+    }
+
+private:
+    double value_;           //< Value of the number
+    double derivatives_[N];  //< Derivatives of the number in the N directions
+
+    /// Returns this number with its value and derivatives multiplied with the provided factor
+    KOKKOS_INLINE_FUNCTION constexpr Dual Scale(double factor) const {
+        auto result = Dual(value_ * factor);
+        for (size_t i = 0; i < N; ++i) {
+            result.derivatives_[i] = derivatives_[i] * factor;
+        }
+        return result;
+    }
+};
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator+(Dual<N> a, const Dual<N>& b) {
+    return a += b;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator-(Dual<N> a, const Dual<N>& b) {
+    return a -= b;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator*(Dual<N> a, const Dual<N>& b) {
+    return a *= b;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator/(Dual<N> a, const Dual<N>& b) {
+    return a /= b;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator+(Dual<N> a, double b) {
+    return a += Dual<N>(b);
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator+(double a, const Dual<N>& b) {
+    return b + a;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator-(Dual<N> a, double b) {
+    return a -= Dual<N>(b);
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator-(double a, const Dual<N>& b) {
+    return Dual<N>(a) - b;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator*(const Dual<N>& a, double b) {
+    return a.Chain(a.GetValue() * b, b);
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator*(double a, const Dual<N>& b) {
+    return b * a;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator/(const Dual<N>& a, double b) {
+    return a * (1. / b);
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr Dual<N> operator/(double a, const Dual<N>& b) {
+    return Dual<N>(a) / b;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr bool operator<(const Dual<N>& a, const Dual<N>& b) {
+    return a.GetValue() < b.GetValue();
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr bool operator>(const Dual<N>& a, const Dual<N>& b) {
+    return b < a;
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr bool operator<=(const Dual<N>& a, const Dual<N>& b) {
+    return !(b < a);
+}
+
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr bool operator>=(const Dual<N>& a, const Dual<N>& b) {
+    return !(a < b);
+}
+
+/// Returns the square root of the provided number - its derivative is infinite at zero
+template <size_t N>
+KOKKOS_INLINE_FUNCTION Dual<N> sqrt(const Dual<N>& x) {
+    const auto value = Kokkos::sqrt(x.GetValue());
+    return x.Chain(value, 0.5 / value);
+}
+
+/// Returns the sine of the provided number
+template <size_t N>
+KOKKOS_INLINE_FUNCTION Dual<N> sin(const Dual<N>& x) {
+    return x.Chain(Kokkos::sin(x.GetValue()), Kokkos::cos(x.GetValue()));
+}
+
+/// Returns the cosine of the provided number
+template <size_t N>
+KOKKOS_INLINE_FUNCTION Dual<N> cos(const Dual<N>& x) {
+    return x.Chain(Kokkos::cos(x.GetValue()), -Kokkos::sin(x.GetValue()));
+}
+
+/// Returns the value of the provided number, i.e. itself for plain numbers
+KOKKOS_INLINE_FUNCTION constexpr double value_of(double x) {
+    return x;
+}
+
+/// Returns the value of the provided number, i.e. without its derivatives
+template <size_t N>
+KOKKOS_INLINE_FUNCTION constexpr double value_of(const Dual<N>& x) {
+    return x.GetValue();
+}
+
+}  // namespace openturbine::rigid_pendulum
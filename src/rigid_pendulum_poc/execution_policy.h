@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include <Kokkos_Core.hpp>
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief Dispatch of the host kernels over the entries of small objects, e.g. the vectors and
+ *      matrices of a single rigid body or of a small system
+ *  @details Launching a kernel on a threaded execution space, e.g. OpenMP, costs a fork and a
+ *      join of the thread pool, i.e. microseconds, whereas a kernel over the dozen entries of the
+ *      heavy top's state takes nanoseconds. The dispatch functions below therefore run kernels of
+ *      up to kMaxInlineKernelSize iterations inline on the calling thread, through the Serial
+ *      execution space, and launch larger ones on the default host execution space. Parallelism
+ *      is meant to live at the outer level, i.e. over the bodies of a model, the members of an
+ *      ensemble, or the elements of a mesh, e.g. through the batched time integrator.
+ */
+
+/// Largest number of iterations of a host kernel that runs inline on the calling thread
+inline constexpr size_t kMaxInlineKernelSize = 256;
+
+/// Execution space of the inline kernels, i.e. the calling thread
+#ifdef KOKKOS_ENABLE_SERIAL
+using InlineExecutionSpace = Kokkos::Serial;
+#else
+using InlineExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+#endif
+
+/// Returns if a host kernel of the provided number of iterations runs inline
+inline constexpr bool is_inline_kernel(size_t n_iterations) {
+    return n_iterations <= kMaxInlineKernelSize;
+}
+
+/// Runs the provided functor for the indices 0 <= i < size on the host, inline if small
+template <typename Functor>
+void host_parallel_for(const std::string& label, size_t size, const Functor& functor) {
+    if (is_inline_kernel(size)) {
+        Kokkos::parallel_for(label, Kokkos::RangePolicy<InlineExecutionSpace>(0, size), functor);
+        return;
+    }
+    Kokkos::parallel_for(
+        label, Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, size), functor
+    );
+}
+
+/// Runs the provided functor for the indices 0 <= i < rows, 0 <= j < columns on the host,
+/// inline if small
+template <typename Functor>
+void host_parallel_for(
+    const std::string& label, size_t rows, size_t columns, const Functor& functor
+) {
+    if (is_inline_kernel(rows * columns)) {
+        Kokkos::parallel_for(
+            label,
+            Kokkos::MDRangePolicy<InlineExecutionSpace, Kokkos::Rank<2>>({0, 0}, {rows, columns}),
+            functor
+        );
+        return;
+    }
+    Kokkos::parallel_for(
+        label,
+        Kokkos::MDRangePolicy<Kokkos::DefaultHostExecutionSpace, Kokkos::Rank<2>>(
+            {0, 0}, {rows, columns}
+        ),
+        functor
+    );
+}
+
+/// Reduces the provided functor over the indices 0 <= i < size on the host, inline if small,
+/// into the provided result or reducer
+template <typename Functor, typename Result>
+void host_parallel_reduce(
+    const std::string& label, size_t size, const Functor& functor, Result&& result
+) {
+    if (is_inline_kernel(size)) {
+        Kokkos::parallel_reduce(
+            label, Kokkos::RangePolicy<InlineExecutionSpace>(0, size), functor,
+            std::forward<Result>(result)
+        );
+        return;
+    }
+    Kokkos::parallel_reduce(
+        label, Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, size), functor,
+        std::forward<Result>(result)
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -1,22 +1,35 @@
 #include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#include "src/rigid_pendulum_poc/execution_policy.h"
 #include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "src/rigid_pendulum_poc/multibody_model.h"
 #include "src/rigid_pendulum_poc/quaternion.h"
 #include "src/rigid_pendulum_poc/solver.h"
 #include "src/utilities/log.h"
+#include "src/utilities/metrics.h"
 
 namespace openturbine::rigid_pendulum {
 
 GeneralizedAlphaTimeIntegrator::GeneralizedAlphaTimeIntegrator(
     double alpha_f, double alpha_m, double beta, double gamma, TimeStepper time_stepper,
-    bool precondition
+    bool precondition, LinearSolverPolicy linear_solver_policy
 )
     : kALPHA_F_(alpha_f),
       kALPHA_M_(alpha_m),
       kBETA_(beta),
       kGAMMA_(gamma),
       time_stepper_(std::move(time_stepper)),
-      precondition_(precondition) {
+      precondition_(precondition),
+      n_steps_since_jacobian_update_(0),
+      n_predictor_steps_(0),
+      linear_solver_policy_(std::move(linear_solver_policy)),
+      n_rejected_steps_(0) {
     if (this->kALPHA_F_ < 0 || this->kALPHA_F_ > 1) {
         throw std::invalid_argument("Invalid value for alpha_f");
     }
@@ -33,6 +46,32 @@ GeneralizedAlphaTimeIntegrator::GeneralizedAlphaTimeIntegrator(
         throw std::invalid_argument("Invalid value for gamma");
     }
 
+    if (this->IsMatrixFree()) {
+        if (this->linear_solver_policy_.perturbation <= 0.) {
+            throw std::invalid_argument("The finite difference perturbation must be positive");
+        }
+
+        // Validates the GMRES parameters
+        this->krylov_solver_ = GMRESSolver(
+            0, this->linear_solver_policy_.krylov_restart,
+            this->linear_solver_policy_.max_krylov_iterations,
+            this->linear_solver_policy_.krylov_tolerance
+        );
+    } else {
+        if (this->IsSparseDirect() &&
+            this->linear_solver_policy_.precision != FactorizationPrecision::kDOUBLE) {
+            throw std::invalid_argument(
+                "The sparse direct solver only supports double precision factorizations"
+            );
+        }
+
+        // Validates the refinement parameters
+        this->linear_solver_ = DenseLinearSolver(
+            0, this->linear_solver_policy_.precision,
+            this->linear_solver_policy_.max_refinement_iterations
+        );
+    }
+
     this->is_converged_ = false;
 }
 
@@ -40,57 +79,329 @@ std::vector<State> GeneralizedAlphaTimeIntegrator::Integrate(
     const State& initial_state, size_t n_constraints,
     std::shared_ptr<LinearizationParameters> linearization_parameters
 ) {
-    auto n_gen_coords = initial_state.GetGeneralizedCoordinates().size();
-    auto n_velocities = initial_state.GetVelocity().size();
-    auto n_accelerations = initial_state.GetAcceleration().size();
-    auto n_algo_accelerations = initial_state.GetAlgorithmicAcceleration().size();
+    return this->Integrate(initial_state, n_constraints, *linearization_parameters);
+}
+
+void GeneralizedAlphaTimeIntegrator::Integrate(
+    const State& initial_state, size_t n_constraints,
+    std::shared_ptr<LinearizationParameters> linearization_parameters, StateObserver& observer
+) {
+    this->Integrate(initial_state, n_constraints, *linearization_parameters, observer);
+}
+
+template <typename Problem, typename>
+std::vector<State> GeneralizedAlphaTimeIntegrator::Integrate(
+    const State& initial_state, size_t n_constraints, Problem& problem
+) {
+    auto history = StateHistoryObserver();
+    this->Integrate(initial_state, n_constraints, problem, history);
+    return history.GetStates();
+}
+
+template <typename Problem, typename>
+void GeneralizedAlphaTimeIntegrator::Integrate(
+    const State& initial_state, size_t n_constraints, Problem& problem, StateObserver& observer
+) {
+    CheckStateSizes(initial_state);
+
+    // Size the workspace once so that the time loop below reuses it for every step
+    this->PrepareWorkspace(
+        initial_state.GetGeneralizedCoordinates().size(), initial_state.GetVelocity().size(),
+        n_constraints
+    );
+    this->n_predictor_steps_ = 0;
+
+    // The initial state is the caller's, i.e. its quaternions are never renormalized
+    this->diagnostics_ = InvariantDiagnosticsView1D<Kokkos::HostSpace>();
+    this->AccumulateDiagnostics(initial_state, problem);
+
+    observer.Observe(
+        {0, this->time_stepper_.GetCurrentTime(), initial_state,
+         HostView1D("lagrange_mults", n_constraints), 0, true}
+    );
+
+    this->IntegrateSteps(0, initial_state, n_constraints, problem, observer);
+}
+
+void GeneralizedAlphaTimeIntegrator::Restart(
+    const Checkpoint& checkpoint, size_t n_constraints,
+    std::shared_ptr<LinearizationParameters> linearization_parameters, StateObserver& observer
+) {
+    CheckStateSizes(checkpoint.state);
 
-    if (n_velocities != 6 || n_accelerations != 6 || n_algo_accelerations != 6) {
+    // Adaptive time steps are not related to the nominal number of steps, i.e. only the time of
+    // the checkpoint tells whether it is part of the analysis
+    if (this->time_step_controller_.GetPolicy().is_adaptive) {
+        const auto final_time = this->time_stepper_.GetFinalTime();
+        if (checkpoint.current_time - final_time >
+            kTIMETOLERANCE * std::max(1., std::abs(final_time))) {
+            throw std::invalid_argument("The checkpoint is past the final time of the analysis");
+        }
+    } else if (checkpoint.step > this->time_stepper_.GetNumberOfSteps()) {
+        throw std::invalid_argument("The checkpoint is past the last time step of the analysis");
+    }
+
+    if (checkpoint.lagrange_mults.extent(0) != n_constraints) {
         throw std::invalid_argument(
-            "The number of velocities, accelerations, and algorithmic accelerations in the "
-            "initial state must be of size 6 for lie group based generalized alpha integrator"
+            "The checkpoint must contain a Lagrange multiplier for every constraint"
         );
     }
 
-    if (n_gen_coords != 7) {
+    this->PrepareWorkspace(
+        checkpoint.state.GetGeneralizedCoordinates().size(), checkpoint.state.GetVelocity().size(),
+        n_constraints
+    );
+
+    // Restore everything that carries over from one time step to the next
+    this->SetTimeStep(checkpoint.time_step);
+    this->time_stepper_.SetCurrentTime(checkpoint.current_time);
+    this->time_stepper_.SetNumberOfIterations(checkpoint.n_iterations);
+    this->time_stepper_.SetTotalNumberOfIterations(checkpoint.total_n_iterations);
+    this->n_steps_since_jacobian_update_ = checkpoint.n_steps_since_jacobian_update;
+    this->n_predictor_steps_ = 0;
+    this->banded_solver_.Invalidate();
+    if (checkpoint.factors.extent(0) > 0) {
+        this->linear_solver_.SetFactorization(checkpoint.factors, checkpoint.pivots);
+    } else {
+        this->linear_solver_.Invalidate();
+    }
+
+    OTURB_LOG_INFO(
+        "Restarting time integration after step number " + std::to_string(checkpoint.step) +
+        "\n"
+    );
+    this->IntegrateSteps(
+        checkpoint.step, checkpoint.state, n_constraints, *linearization_parameters, observer
+    );
+}
+
+Checkpoint GeneralizedAlphaTimeIntegrator::CreateCheckpoint(
+    size_t step, const State& state, const HostView1D lagrange_mults
+) const {
+    auto checkpoint = Checkpoint{
+        step,
+        this->time_stepper_.GetCurrentTime(),
+        this->time_stepper_.GetTimeStep(),
+        this->time_stepper_.GetNumberOfIterations(),
+        this->time_stepper_.GetTotalNumberOfIterations(),
+        state,
+        HostView1D("lagrange_mults", lagrange_mults.extent(0)),
+        this->n_steps_since_jacobian_update_,
+        HostView2D("factors", 0, 0),
+        HostIntView1D("pivots", 0)};
+    Kokkos::deep_copy(checkpoint.lagrange_mults, lagrange_mults);
+
+    // Single precision factors and those of the reduced and the banded systems are not stored,
+    // i.e. they are recomputed after a restart
+    if (this->linear_solver_.IsFactorized() && !this->linear_solver_.IsRefined() &&
+        !this->IsNullSpaceReduced()) {
+        const auto size = this->linear_solver_.GetSize();
+        checkpoint.factors = HostView2D("factors", size, size);
+        checkpoint.pivots = HostIntView1D("pivots", size);
+        Kokkos::deep_copy(checkpoint.factors, this->linear_solver_.GetFactors());
+        Kokkos::deep_copy(checkpoint.pivots, this->linear_solver_.GetPivots());
+    }
+    return checkpoint;
+}
+
+void GeneralizedAlphaTimeIntegrator::SetCheckpointPolicy(const CheckpointPolicy& policy) {
+    if (policy.interval > 0 && policy.file_name.empty()) {
+        throw std::invalid_argument("A file name must be provided to write checkpoints");
+    }
+
+    this->checkpoint_policy_ = policy;
+}
+
+void GeneralizedAlphaTimeIntegrator::SetAdaptiveTimeStepPolicy(
+    const AdaptiveTimeStepPolicy& policy
+) {
+    this->time_step_controller_ = TimeStepController(policy);
+}
+
+void GeneralizedAlphaTimeIntegrator::SetTimeStep(double h) {
+    if (h == this->time_stepper_.GetTimeStep()) {
+        return;
+    }
+
+    this->time_stepper_.SetTimeStep(h);
+
+    // The iteration matrix and the preconditioner both scale with the time step, and the
+    // extrapolation of the predictor assumes equal time steps
+    this->linear_solver_.Invalidate();
+    this->banded_solver_.Invalidate();
+    this->n_predictor_steps_ = 0;
+    if (this->precondition_) {
+        this->preconditioner_ = create_bottasso_preconditioner(
+            this->workspace_.GetVelocity().extent(0),
+            this->workspace_.GetLagrangeMultipliersNext().extent(0), kBETA_, h
+        );
+    }
+}
+
+void GeneralizedAlphaTimeIntegrator::CheckStateSizes(const State& state) {
+    auto n_gen_coords = state.GetGeneralizedCoordinates().size();
+    auto n_velocities = state.GetVelocity().size();
+    auto n_accelerations = state.GetAcceleration().size();
+    auto n_algo_accelerations = state.GetAlgorithmicAcceleration().size();
+
+    if (n_velocities == 0 || n_velocities % kNumberOfVelocitiesPerBody != 0 ||
+        n_accelerations != n_velocities || n_algo_accelerations != n_velocities) {
         throw std::invalid_argument(
-            "The number of generalized coordinates in the initial state must be of size "
-            "7 for lie group based generalized alpha integrator"
+            "The number of velocities, accelerations, and algorithmic accelerations in the "
+            "initial state must be the same multiple of 6 for lie group based generalized alpha "
+            "integrator, i.e. 6 per rigid body"
         );
     }
 
-    auto log = util::Log::Get();
-    std::vector<State> states{initial_state};
-    auto n_steps = this->time_stepper_.GetNumberOfSteps();
-    for (size_t i = 0; i < n_steps; i++) {
-        this->time_stepper_.AdvanceTimeStep();
-        log->Info("** Integrating step number " + std::to_string(i + 1) + " **\n");
-        states.emplace_back(
-            std::get<0>(this->AlphaStep(states[i], n_constraints, linearization_parameters))
+    const auto n_bodies = n_velocities / kNumberOfVelocitiesPerBody;
+    if (n_gen_coords != n_bodies * kNumberOfGeneralizedCoordinatesPerBody) {
+        throw std::invalid_argument(
+            "The number of generalized coordinates in the initial state must be of size "
+            "7 per rigid body for lie group based generalized alpha integrator"
         );
     }
+}
 
-    log->Info("Time integration has completed!\n");
+template <typename Problem>
+void GeneralizedAlphaTimeIntegrator::IntegrateSteps(
+    size_t first_step, const State& first_state, size_t n_constraints, Problem& problem,
+    StateObserver& observer
+) {
+    const auto checkpoint_interval = this->checkpoint_policy_.interval;
+    const auto write_checkpoint_if_due = [&](size_t step, const State& state,
+                                             const HostView1D lagrange_mults) {
+        if (checkpoint_interval > 0 && step % checkpoint_interval == 0) {
+            write_checkpoint(
+                this->checkpoint_policy_.file_name,
+                this->CreateCheckpoint(step, state, lagrange_mults)
+            );
+        }
+    };
+
+    auto state = first_state;
+    if (!this->time_step_controller_.GetPolicy().is_adaptive) {
+        auto n_steps = this->time_stepper_.GetNumberOfSteps();
+        for (size_t i = first_step; i < n_steps; i++) {
+            this->time_stepper_.AdvanceTimeStep();
+            OTURB_LOG_INFO("** Integrating step number " + std::to_string(i + 1) + " **\n");
+            auto [next_state, lagrange_mults] =
+                this->AlphaStep(state, n_constraints, problem);
+            this->AccumulateDiagnostics(next_state, problem);
+            this->RenormalizeQuaternions(next_state);
+            observer.Observe(
+                {i + 1, this->time_stepper_.GetCurrentTime(), next_state, lagrange_mults,
+                 this->time_stepper_.GetNumberOfIterations(), this->is_converged_}
+            );
+            write_checkpoint_if_due(i + 1, next_state, lagrange_mults);
+            state = next_state;
+        }
+    } else {
+        // Step until the final time, with every time step sized by the time step controller
+        const auto final_time = this->time_stepper_.GetFinalTime();
+        const auto time_tolerance = kTIMETOLERANCE * std::max(1., std::abs(final_time));
+        const auto& policy = this->time_step_controller_.GetPolicy();
+        auto step = first_step;
+        while (final_time - this->time_stepper_.GetCurrentTime() > time_tolerance) {
+            const auto current_time = this->time_stepper_.GetCurrentTime();
+            const auto remaining_time = final_time - current_time;
+            const auto is_last_step = this->time_stepper_.GetTimeStep() >= remaining_time;
+            if (is_last_step) {
+                this->SetTimeStep(remaining_time);
+            }
+
+            const auto h = this->time_stepper_.GetTimeStep();
+            this->time_stepper_.AdvanceTimeStep();
+            OTURB_LOG_INFO(
+                "** Integrating step number " + std::to_string(step + 1) +
+                " with time step " + std::to_string(h) + " **\n"
+            );
+            auto [next_state, lagrange_mults] =
+                this->AlphaStep(state, n_constraints, problem);
+
+            const auto error_norm = this->is_converged_
+                                        ? this->time_step_controller_.CalculateErrorNorm(
+                                              h, kBETA_, state, next_state
+                                          )
+                                        : 0.;
+            const auto decision = this->time_step_controller_.Evaluate(
+                h, error_norm, this->time_stepper_.GetNumberOfIterations(), this->is_converged_
+            );
 
-    return states;
+            if (!decision.is_accepted) {
+                this->time_stepper_.SetCurrentTime(current_time);
+                this->n_rejected_steps_++;
+                if (h <= policy.min_time_step) {
+                    throw std::runtime_error(
+                        "Time step rejected at the minimum time step of " +
+                        std::to_string(policy.min_time_step) + " at time " +
+                        std::to_string(current_time)
+                    );
+                }
+                OTURB_LOG_INFO(
+                    "Time step rejected with scaled error " + std::to_string(error_norm) +
+                    ", repeating it with time step " +
+                    std::to_string(decision.next_time_step) + "\n"
+                );
+                this->SetTimeStep(decision.next_time_step);
+                continue;
+            }
+
+            // Land exactly on the final time, irrespective of round-off in the time steps
+            if (is_last_step) {
+                this->time_stepper_.SetCurrentTime(final_time);
+            }
+
+            step++;
+            this->AccumulateDiagnostics(next_state, problem);
+            this->RenormalizeQuaternions(next_state);
+            observer.Observe(
+                {step, this->time_stepper_.GetCurrentTime(), next_state, lagrange_mults,
+                 this->time_stepper_.GetNumberOfIterations(), this->is_converged_}
+            );
+            this->SetTimeStep(decision.next_time_step);
+            write_checkpoint_if_due(step, next_state, lagrange_mults);
+            state = next_state;
+        }
+    }
+    observer.Finalize();
+
+    OTURB_LOG_INFO(
+        "Time integration has completed with an average of " +
+        std::to_string(this->time_stepper_.GetAverageNumberOfIterations()) +
+        " Newton-Raphson iterations per time step!\n"
+    );
 }
 
 std::tuple<State, HostView1D> GeneralizedAlphaTimeIntegrator::AlphaStep(
     const State& state, size_t n_constraints,
     std::shared_ptr<LinearizationParameters> linearization_parameters
 ) {
-    auto gen_coords = state.GetGeneralizedCoordinates();
-    auto velocity = state.GetVelocity();
-    auto acceleration = state.GetAcceleration();
-    auto algo_acceleration = state.GetAlgorithmicAcceleration();
-
-    // Initialize some X_next variables to assist in updating the State - only for ones that
-    // require both the current and next values in a calculation
-    auto gen_coords_next = HostView1D("gen_coords_next", gen_coords.size());
-    auto algo_acceleration_next =
-        HostView1D("algorithmic_acceleration_next", algo_acceleration.size());
-    auto delta_gen_coords = HostView1D("gen_coords_increment", velocity.size());
-    auto lagrange_mults_next = HostView1D("lagrange_mults_next", n_constraints);
+    return this->AlphaStep(state, n_constraints, *linearization_parameters);
+}
+
+template <typename Problem, typename>
+std::tuple<State, HostView1D> GeneralizedAlphaTimeIntegrator::AlphaStep(
+    const State& state, size_t n_constraints, Problem& problem
+) {
+    Kokkos::Profiling::ScopedRegion alpha_step_region("GeneralizedAlpha::AlphaStep");
+    const auto step_start = std::chrono::steady_clock::now();
+    auto solve_time = std::chrono::steady_clock::duration::zero();
+
+    const auto gen_coords = state.GetGeneralizedCoordinates();
+    const auto velocity_current = state.GetVelocity();
+    const auto acceleration_current = state.GetAcceleration();
+    const auto algo_acceleration = state.GetAlgorithmicAcceleration();
+
+    // All temporaries of the time step live in the preallocated workspace - only for ones that
+    // require both the current and next values in a calculation we keep a separate X_next view
+    this->PrepareWorkspace(gen_coords.size(), velocity_current.size(), n_constraints);
+    auto gen_coords_next = workspace_.GetGeneralizedCoordinatesNext();
+    auto velocity = workspace_.GetVelocity();
+    auto acceleration = workspace_.GetAcceleration();
+    auto algo_acceleration_next = workspace_.GetAlgorithmicAccelerationNext();
+    auto delta_gen_coords = workspace_.GetGeneralizedCoordinatesIncrement();
+    auto lagrange_mults_next = workspace_.GetLagrangeMultipliersNext();
+    auto soln_increments = workspace_.GetSolutionIncrements();
 
     // Perform the linear update part of the generalized alpha algorithm
     const auto h = this->time_stepper_.GetTimeStep();
@@ -101,228 +412,803 @@ std::tuple<State, HostView1D> GeneralizedAlphaTimeIntegrator::AlphaStep(
     const double kBETA_local = kBETA_;
     const double kGAMMA_local = kGAMMA_;
 
+    const auto BETA_PRIME = (1 - kALPHA_M_) / (h * h * kBETA_ * (1 - kALPHA_F_));
+    const auto GAMMA_PRIME = kGAMMA_ / (h * kBETA_);
+
     // Algorithm from Table 1, Brüls, Cardona, and Arnold 2012
-    Kokkos::parallel_for(
-        size,
-        KOKKOS_LAMBDA(const size_t i) {
-            algo_acceleration_next(i) =
-                (kALPHA_F_local * acceleration(i) - kALPHA_M_local * algo_acceleration(i)) /
-                (1. - kALPHA_M_local);
+    {
+        Kokkos::Profiling::ScopedRegion predictor_region("GeneralizedAlpha::Predictor");
+        host_parallel_for(
+            "alpha_step_predictor", size,
+            KOKKOS_LAMBDA(const size_t i) {
+                algo_acceleration_next(i) = (kALPHA_F_local * acceleration_current(i) -
+                                             kALPHA_M_local * algo_acceleration(i)) /
+                                            (1. - kALPHA_M_local);
 
-            delta_gen_coords(i) = velocity(i) + h * (0.5 - kBETA_local) * algo_acceleration(i) +
-                                  h * kBETA_local * algo_acceleration_next(i);
-            velocity(i) += h * (1 - kGAMMA_local) * algo_acceleration(i) +
-                           h * kGAMMA_local * algo_acceleration_next(i);
+                delta_gen_coords(i) = velocity_current(i) +
+                                      h * (0.5 - kBETA_local) * algo_acceleration(i) +
+                                      h * kBETA_local * algo_acceleration_next(i);
+                velocity(i) = velocity_current(i) + h * (1 - kGAMMA_local) * algo_acceleration(i) +
+                              h * kGAMMA_local * algo_acceleration_next(i);
 
-            algo_acceleration(i) = algo_acceleration_next(i);
+                acceleration(i) = 0.;
+            }
+        );
 
-            acceleration(i) = 0.;
-        }
-    );
+        // Initialize lagrange_mults_next to zero separately since it might be of different size
+        Kokkos::deep_copy(lagrange_mults_next, 0.);
 
-    // Initialize lagrange_mults_next to zero separately since it might be of different size
-    Kokkos::deep_copy(lagrange_mults_next, 0.);
+        // Start the iterations from the acceleration and Lagrange multipliers extrapolated from the
+        // latest converged steps, i.e. apply the increment that moves the acceleration from zero to
+        // its extrapolation through the same Newmark relations as the Newton-Raphson updates
+        this->PreparePredictor(size, n_constraints);
+        const auto n_history = std::min(newton_policy_.predictor_order, n_predictor_steps_);
+        if (n_history > 0) {
+            // Coefficients of the equal-step extrapolation by a polynomial through n_history steps,
+            // i.e. (-1)^j * binomial(n_history, j + 1)
+            auto coefficients = Vec<3>{};
+            auto binomial = 1.;
+            for (size_t j = 0; j < n_history; ++j) {
+                binomial *= static_cast<double>(n_history - j) / static_cast<double>(j + 1);
+                coefficients(j) = (j % 2 == 0 ? 1. : -1.) * binomial;
+            }
+            const auto accelerations = predictor_accelerations_;
+            const auto history_lagrange_mults = predictor_lagrange_mults_;
+            host_parallel_for(
+                "alpha_step_extrapolate_acceleration", size,
+                KOKKOS_LAMBDA(const size_t i) {
+                    auto predicted_acceleration = 0.;
+                    for (size_t j = 0; j < n_history; ++j) {
+                        predicted_acceleration += coefficients(j) * accelerations(j, i);
+                    }
+                    delta_gen_coords(i) += predicted_acceleration / (BETA_PRIME * h);
+                    velocity(i) += GAMMA_PRIME / BETA_PRIME * predicted_acceleration;
+                    acceleration(i) = predicted_acceleration;
+                }
+            );
+            host_parallel_for(
+                "alpha_step_extrapolate_lagrange_mults", n_constraints,
+                KOKKOS_LAMBDA(const size_t i) {
+                    auto predicted_lagrange_mult = 0.;
+                    for (size_t j = 0; j < n_history; ++j) {
+                        predicted_lagrange_mult += coefficients(j) * history_lagrange_mults(j, i);
+                    }
+                    lagrange_mults_next(i) = predicted_lagrange_mult;
+                }
+            );
+        }
+    }
 
     // Perform Newton-Raphson iterations to update nonlinear part of generalized-alpha algorithm
-    auto log = util::Log::Get();
-    log->Info(
+    OTURB_LOG_INFO(
         "Performing Newton-Raphson iterations to update solution using the generalized-alpha "
         "algorithm\n"
     );
 
-    const auto BETA_PRIME = (1 - kALPHA_M_) / (h * h * kBETA_ * (1 - kALPHA_F_));
-    const auto GAMMA_PRIME = kGAMMA_ / (h * kBETA_);
-
-    // Precondition the linear solve (Bottasso et al 2008)
-    const auto dl = HostView2D("dl", size + n_constraints, size + n_constraints);
-    const auto dr = HostView2D("dr", size + n_constraints, size + n_constraints);
-    Kokkos::deep_copy(dl, 0.);
-    Kokkos::deep_copy(dr, 0.);
-
-    if (this->precondition_) {
-        Kokkos::parallel_for(
-            size + n_constraints,
-            KOKKOS_LAMBDA(const size_t i) {
-                dl(i, i) = 1.;
-                dr(i, i) = 1.;
-            }
-        );
+    // Problems with a fused linearization evaluate the residuals and the iteration matrix in one
+    // pass, which requires knowing up front if the matrix is updated - this is not the case if
+    // the update depends on the residual norm. The fused iteration matrix is dense, i.e. the
+    // sparse direct solver assembles the block sparse iteration matrix separately.
+    const auto is_matrix_free = this->IsMatrixFree();
+    const auto is_sparse_direct = this->IsSparseDirect();
+    const auto strategy = jacobian_update_policy_.strategy;
+    const auto is_linearize_fused =
+        problem.IsLinearizeFused() && !is_sparse_direct &&
+        (is_matrix_free || (strategy != JacobianUpdateStrategy::kON_STALL &&
+                            strategy != JacobianUpdateStrategy::kBROYDEN));
 
-        Kokkos::parallel_for(
-            size + n_constraints,
-            KOKKOS_LAMBDA(const size_t i) {
-                if (i >= size) {
-                    dr(i, i) = 1. / (kBETA_local * h * h);
-                } else {
-                    dl(i, i) = kBETA_local * h * h;
-                }
-            }
+    // Quasi-Newton iterations update the inverse of the iteration matrix between its updates
+    const auto is_broyden = !is_matrix_free && strategy == JacobianUpdateStrategy::kBROYDEN;
+    if (is_broyden && broyden_update_.GetSize() != soln_increments.extent(0)) {
+        this->broyden_update_ = BroydenUpdate(
+            soln_increments.extent(0), this->time_stepper_.GetMaximumNumberOfIterations()
         );
     }
 
     const auto max_iterations = this->time_stepper_.GetMaximumNumberOfIterations();
+    this->is_converged_ = false;
+    auto previous_residual_norm = std::numeric_limits<double>::max();
+    auto initial_residual_norm = 0.;
+
+    // Residual norm of the iterate the latest increments were solved for, the fraction of these
+    // increments currently applied, and the number of times they were halved
+    auto step_residual_norm = std::numeric_limits<double>::max();
+    auto step_length = 1.;
+    size_t n_backtracks = 0;
     for (time_stepper_.SetNumberOfIterations(0);
          time_stepper_.GetNumberOfIterations() < max_iterations;
          time_stepper_.IncrementNumberOfIterations()) {
-        gen_coords_next = UpdateGeneralizedCoordinates(gen_coords, delta_gen_coords);
+        {
+            Kokkos::Profiling::ScopedRegion update_region("GeneralizedAlpha::Update");
+            UpdateGeneralizedCoordinates(gen_coords, delta_gen_coords, gen_coords_next);
+        }
 
-        // Compute the residuals and check for convergence
-        const auto residuals = linearization_parameters->ResidualVector(
-            gen_coords_next, velocity, acceleration, lagrange_mults_next
-        );
+        // Compute the residuals and check for convergence - the fused linearization computes
+        // the iteration matrix as well, i.e. its region covers the Jacobian assembly
+        const auto iteration = time_stepper_.GetNumberOfIterations();
+        auto residuals = workspace_.GetResiduals();
+        auto is_jacobian_update_required = false;
+        auto residual_norm = 0.;
+        {
+            Kokkos::Profiling::ScopedRegion linearize_region(
+                is_linearize_fused ? "GeneralizedAlpha::Linearize" : "GeneralizedAlpha::Residual"
+            );
+            if (is_linearize_fused) {
+                is_jacobian_update_required =
+                    !is_matrix_free && this->IsJacobianUpdateRequired(
+                                           iteration, 0., std::numeric_limits<double>::max()
+                                       );
+                problem.Linearize(
+                    h, BETA_PRIME, GAMMA_PRIME, gen_coords_next, delta_gen_coords, velocity,
+                    acceleration, lagrange_mults_next, residuals, is_jacobian_update_required,
+                    workspace_.GetIterationMatrix()
+                );
+            } else {
+                residuals = problem.ResidualVector(
+                    gen_coords_next, velocity, acceleration, lagrange_mults_next
+                );
+            }
 
-        if (this->CheckConvergence(residuals)) {
+            residual_norm = CalculateResidualNorm(residuals);
+        }
+        if (iteration == 0) {
+            initial_residual_norm = residual_norm;
+        }
+        if (this->CheckConvergence(residual_norm, initial_residual_norm)) {
             this->is_converged_ = true;
             break;
         }
 
-        auto iteration_matrix = linearization_parameters->IterationMatrix(
-            h, BETA_PRIME, GAMMA_PRIME, gen_coords_next, delta_gen_coords, velocity, acceleration,
-            lagrange_mults_next
-        );
+        // Backtrack along the latest increments while they do not decrease the residual norm
+        // sufficiently, i.e. retract half of the applied fraction - NaNs are backtracked as well
+        if (newton_policy_.is_line_search && iteration > 0 &&
+            n_backtracks < newton_policy_.max_backtracks &&
+            !(residual_norm <=
+              (1. - newton_policy_.armijo_constant * step_length) * step_residual_norm)) {
+            step_length *= 0.5;
+            n_backtracks++;
+            Kokkos::Profiling::ScopedRegion line_search_region("GeneralizedAlpha::LineSearch");
+            this->ApplySolutionIncrements(-step_length, BETA_PRIME, GAMMA_PRIME);
+            continue;
+        }
+        const auto applied_step_length = step_length;
+        step_residual_norm = residual_norm;
+        step_length = 1.;
+        n_backtracks = 0;
 
-        if (this->precondition_) {
-            iteration_matrix = multiply_matrix_with_matrix(iteration_matrix, dr);
-            iteration_matrix = multiply_matrix_with_matrix(dl, iteration_matrix);
+        if (is_matrix_free) {
+            Kokkos::Profiling::ScopedRegion solve_region("GeneralizedAlpha::LinearSolve");
+            const auto solve_start = std::chrono::steady_clock::now();
+            this->SolveMatrixFree(problem, gen_coords, residuals, BETA_PRIME, GAMMA_PRIME);
+            solve_time += std::chrono::steady_clock::now() - solve_start;
+        } else {
+            // Only assemble and factorize the iteration matrix when the update policy requires it,
+            // otherwise solve with the factors of the latest update (modified Newton)
+            if (!is_linearize_fused) {
+                is_jacobian_update_required =
+                    this->IsJacobianUpdateRequired(iteration, residual_norm, previous_residual_norm);
+            }
+            if (is_jacobian_update_required && is_sparse_direct) {
+                Kokkos::Profiling::ScopedRegion jacobian_region("GeneralizedAlpha::Jacobian");
+                const auto iteration_matrix = problem.SparseIterationMatrix(
+                    h, BETA_PRIME, GAMMA_PRIME, gen_coords_next, delta_gen_coords, velocity,
+                    acceleration, lagrange_mults_next
+                );
 
-            Kokkos::parallel_for(
-                6,
-                KOKKOS_LAMBDA(const size_t i) { residuals(i) = residuals(i) * kBETA_local * h * h; }
-            );
-        }
+                if (this->precondition_) {
+                    // Precondition the linear solve (Bottasso et al 2008)
+                    preconditioner_.ApplyToMatrix(iteration_matrix);
+                }
 
-        auto soln_increments = HostView1D("soln_increments", residuals.size());
-        Kokkos::deep_copy(soln_increments, residuals);
-        solve_linear_system(iteration_matrix, soln_increments);
+                const auto factorize_start = std::chrono::steady_clock::now();
+                banded_solver_.Factorize(iteration_matrix);
+                solve_time += std::chrono::steady_clock::now() - factorize_start;
+                n_steps_since_jacobian_update_ = 0;
+                this->time_stepper_.IncrementTotalNumberOfJacobianUpdates();
+                if (is_broyden) {
+                    broyden_update_.Reset();
+                }
+            } else if (is_jacobian_update_required) {
+                Kokkos::Profiling::ScopedRegion jacobian_region("GeneralizedAlpha::Jacobian");
+                auto iteration_matrix = workspace_.GetIterationMatrix();
+                if (!is_linearize_fused) {
+                    iteration_matrix = problem.IterationMatrix(
+                        h, BETA_PRIME, GAMMA_PRIME, gen_coords_next, delta_gen_coords, velocity,
+                        acceleration, lagrange_mults_next
+                    );
+                }
 
-        HostView1D delta_x("delta_x", delta_gen_coords.size());
-        Kokkos::parallel_for(
-            delta_gen_coords.size(),
-            // Take negative of the solution increments to update generalized coordinates
-            KOKKOS_LAMBDA(const size_t i) { delta_x(i) = -soln_increments(i); }
-        );
+                if (this->precondition_) {
+                    // Precondition the linear solve (Bottasso et al 2008)
+                    preconditioner_.ApplyToMatrix(iteration_matrix);
+                }
 
-        if (n_constraints > 0) {
-            HostView1D delta_lagrange_mults("delta_lagrange_mults", n_constraints);
-
-            if (this->precondition_) {
-                Kokkos::parallel_for(
-                    n_constraints,
-                    KOKKOS_LAMBDA(const size_t i) {
-                        // Take negative of the solution increments to update Lagrange multipliers
-                        delta_lagrange_mults(i) =
-                            -soln_increments(i + delta_gen_coords.size()) / (kBETA_local * h * h);
-                        lagrange_mults_next(i) += delta_lagrange_mults(i);
-                    }
-                );
-            } else {
-                Kokkos::parallel_for(
-                    n_constraints,
-                    KOKKOS_LAMBDA(const size_t i) {
-                        // Take negative of the solution increments to update Lagrange multipliers
-                        delta_lagrange_mults(i) = -soln_increments(i + delta_gen_coords.size());
-                        lagrange_mults_next(i) += delta_lagrange_mults(i);
-                    }
-                );
+                const auto factorize_start = std::chrono::steady_clock::now();
+                if (this->IsNullSpaceReduced()) {
+                    linear_solver_.Factorize(null_space_reduction_.Reduce(iteration_matrix));
+                } else {
+                    linear_solver_.Factorize(iteration_matrix);
+                }
+                solve_time += std::chrono::steady_clock::now() - factorize_start;
+                n_steps_since_jacobian_update_ = 0;
+                this->time_stepper_.IncrementTotalNumberOfJacobianUpdates();
+                if (is_broyden) {
+                    broyden_update_.Reset();
+                }
             }
-        }
+            previous_residual_norm = residual_norm;
 
-        // Update the velocity, acceleration, and constraints based on the increments
-        Kokkos::parallel_for(
-            size,
-            KOKKOS_LAMBDA(const size_t i) {
-                delta_gen_coords(i) += delta_x(i) / h;
-                velocity(i) += GAMMA_PRIME * delta_x(i);
-                acceleration(i) += BETA_PRIME * delta_x(i);
+            Kokkos::Profiling::ScopedRegion solve_region("GeneralizedAlpha::LinearSolve");
+            const auto solve_start = std::chrono::steady_clock::now();
+            const auto solve = [this](HostView1D right_hand_side) {
+                if (this->precondition_) {
+                    preconditioner_.ApplyToRightHandSide(right_hand_side);
+                }
+                if (this->IsSparseDirect()) {
+                    banded_solver_.Solve(right_hand_side);
+                } else if (this->IsNullSpaceReduced()) {
+                    auto reduced_increments =
+                        null_space_reduction_.ReduceRightHandSide(right_hand_side);
+                    linear_solver_.Solve(reduced_increments);
+                    null_space_reduction_.Recover(reduced_increments, right_hand_side);
+                } else {
+                    linear_solver_.Solve(right_hand_side);
+                }
+                if (this->precondition_) {
+                    preconditioner_.ApplyToSolution(right_hand_side);
+                }
+            };
+
+            // Between updates of the iteration matrix, the secant of the latest step updates
+            // its inverse, i.e. only the residual vector is evaluated per iteration (Broyden)
+            if (is_broyden && !is_jacobian_update_required && broyden_update_.HasStep() &&
+                broyden_update_.Update(applied_step_length, residuals, solve)) {
+                this->time_stepper_.IncrementTotalNumberOfBroydenUpdates();
             }
-        );
+            Kokkos::deep_copy(soln_increments, residuals);
+            solve(soln_increments);
+            if (is_broyden) {
+                broyden_update_.Apply(soln_increments);
+                broyden_update_.Record(residuals, soln_increments);
+            }
+            solve_time += std::chrono::steady_clock::now() - solve_start;
+        }
+
+        Kokkos::Profiling::ScopedRegion update_region("GeneralizedAlpha::Update");
+        this->ApplySolutionIncrements(1., BETA_PRIME, GAMMA_PRIME);
     }
 
     const auto n_iterations = time_stepper_.GetNumberOfIterations();
     this->time_stepper_.IncrementTotalNumberOfIterations(n_iterations);
+    this->n_steps_since_jacobian_update_++;
+
+    // Only converged steps are extrapolated, a failed step restarts the history
+    if (this->is_converged_) {
+        this->RecordPredictorStep(acceleration, lagrange_mults_next);
+    } else {
+        this->n_predictor_steps_ = 0;
+    }
 
     // Update algorithmic acceleration once Newton-Raphson iterations have ended
-    Kokkos::parallel_for(
-        size,
+    host_parallel_for(
+        "alpha_step_update_algorithmic_acceleration", size,
         KOKKOS_LAMBDA(const size_t i) {
             algo_acceleration_next(i) +=
                 (1. - kALPHA_F_local) / (1. - kALPHA_M_local) * acceleration(i);
         }
     );
 
+    // Copy the results out of the workspace so that they outlive the next time step
+    auto lagrange_mults = HostView1D("lagrange_mults", n_constraints);
+    Kokkos::deep_copy(lagrange_mults, lagrange_mults_next);
     auto results = std::make_tuple(
-        State{gen_coords_next, velocity, acceleration, algo_acceleration_next}, lagrange_mults_next
+        State{gen_coords_next, velocity, acceleration, algo_acceleration_next}, lagrange_mults
+    );
+
+    this->time_stepper_.RecordStepStatistics(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - step_start).count(),
+        std::chrono::duration<double>(solve_time).count(), n_iterations
     );
 
     if (this->is_converged_) {
-        log->Info(
+        OTURB_LOG_INFO(
             "Newton-Raphson iterations converged in " + std::to_string(n_iterations + 1) +
             " iterations\n"
         );
         return results;
     }
 
-    log->Warning(
+    static auto& nonconverged_steps = util::MetricsRegistry::Get().GetCounter(
+        "openturbine_nonconverged_steps_total",
+        "Number of time steps whose Newton-Raphson iterations did not converge"
+    );
+    nonconverged_steps.Increment();
+    OTURB_LOG_WARNING(
         "Newton-Raphson iterations failed to converge on a solution after " +
         std::to_string(n_iterations + 1) + " iterations!\n"
     );
     return results;
 }
 
-HostView1D GeneralizedAlphaTimeIntegrator::UpdateGeneralizedCoordinates(
-    const HostView1D gen_coords, const HostView1D delta_gen_coords
+void GeneralizedAlphaTimeIntegrator::PrepareWorkspace(
+    size_t n_gen_coords, size_t n_velocities, size_t n_constraints
+) {
+    const auto is_matrix_free = this->IsMatrixFree();
+    if (this->workspace_.IsSizedFor(n_gen_coords, n_velocities, n_constraints, is_matrix_free)) {
+        return;
+    }
+
+    this->workspace_ =
+        GeneralizedAlphaWorkspace(n_gen_coords, n_velocities, n_constraints, is_matrix_free);
+    if (is_matrix_free) {
+        this->krylov_solver_ = GMRESSolver(
+            n_velocities + n_constraints, this->linear_solver_policy_.krylov_restart,
+            this->linear_solver_policy_.max_krylov_iterations,
+            this->linear_solver_policy_.krylov_tolerance
+        );
+    } else {
+        const auto is_null_space_reduced = this->IsNullSpaceReduced();
+        if (is_null_space_reduced) {
+            this->null_space_reduction_ = NullSpaceReduction(n_velocities, n_constraints);
+        }
+        // The banded solver of kSPARSE_DIRECT is sized by every factorization instead
+        auto dense_size = is_null_space_reduced ? n_velocities - n_constraints
+                                                : n_velocities + n_constraints;
+        if (this->IsSparseDirect()) {
+            dense_size = 0;
+        }
+        this->linear_solver_ = DenseLinearSolver(
+            dense_size, this->linear_solver_policy_.precision,
+            this->linear_solver_policy_.max_refinement_iterations
+        );
+    }
+
+    // The preconditioner only depends on the (constant) time step and beta, so it is
+    // assembled once here instead of in every time step (Bottasso et al 2008)
+    if (this->precondition_) {
+        this->preconditioner_ = create_bottasso_preconditioner(
+            n_velocities, n_constraints, kBETA_, this->time_stepper_.GetTimeStep()
+        );
+    }
+}
+
+void GeneralizedAlphaTimeIntegrator::PreparePredictor(size_t n_velocities, size_t n_constraints) {
+    const auto order = this->newton_policy_.predictor_order;
+    if (this->predictor_accelerations_.extent(0) == order &&
+        this->predictor_accelerations_.extent(1) == n_velocities &&
+        this->predictor_lagrange_mults_.extent(1) == n_constraints) {
+        return;
+    }
+
+    this->predictor_accelerations_ = HostView2D("predictor_accelerations", order, n_velocities);
+    this->predictor_lagrange_mults_ =
+        HostView2D("predictor_lagrange_mults", order, n_constraints);
+    this->n_predictor_steps_ = 0;
+}
+
+void GeneralizedAlphaTimeIntegrator::RecordPredictorStep(
+    const HostView1D acceleration, const HostView1D lagrange_mults
+) {
+    const auto order = this->newton_policy_.predictor_order;
+    if (order == 0) {
+        return;
+    }
+
+    // Shift the history by one step, dropping the oldest step once the history is full
+    const auto accelerations = this->predictor_accelerations_;
+    const auto history_lagrange_mults = this->predictor_lagrange_mults_;
+    const auto n_steps = std::min(this->n_predictor_steps_ + 1, order);
+    host_parallel_for(
+        "record_predictor_acceleration", acceleration.extent(0),
+        KOKKOS_LAMBDA(const size_t i) {
+            for (size_t j = n_steps - 1; j > 0; --j) {
+                accelerations(j, i) = accelerations(j - 1, i);
+            }
+            accelerations(0, i) = acceleration(i);
+        }
+    );
+    host_parallel_for(
+        "record_predictor_lagrange_mults", lagrange_mults.extent(0),
+        KOKKOS_LAMBDA(const size_t i) {
+            for (size_t j = n_steps - 1; j > 0; --j) {
+                history_lagrange_mults(j, i) = history_lagrange_mults(j - 1, i);
+            }
+            history_lagrange_mults(0, i) = lagrange_mults(i);
+        }
+    );
+    this->n_predictor_steps_ = n_steps;
+}
+
+void GeneralizedAlphaTimeIntegrator::ApplySolutionIncrements(
+    double scale, double BETA_PRIME, double GAMMA_PRIME
 ) {
-    // {gen_coords_next} = {gen_coords} + h * {delta_gen_coords}
-    //
-    // Step 1: R^3 update, done with vector addition
-    auto current_position = Vector{gen_coords(0), gen_coords(1), gen_coords(2)};
-    auto updated_position = Vector{delta_gen_coords(0), delta_gen_coords(1), delta_gen_coords(2)};
     const auto h = this->time_stepper_.GetTimeStep();
-    auto r = current_position + (updated_position * h);
+    const auto delta_gen_coords = workspace_.GetGeneralizedCoordinatesIncrement();
+    const auto velocity = workspace_.GetVelocity();
+    const auto acceleration = workspace_.GetAcceleration();
+    const auto lagrange_mults = workspace_.GetLagrangeMultipliersNext();
+    const auto soln_increments = workspace_.GetSolutionIncrements();
+    const auto size = velocity.extent(0);
+    const auto n_constraints = lagrange_mults.extent(0);
 
-    // Step 2: SO(3) update, done with quaternion composition
-    Quaternion current_orientation{gen_coords(3), gen_coords(4), gen_coords(5), gen_coords(6)};
-    auto updated_orientation = quaternion_from_rotation_vector(
-        // Convert Vector -> Quaternion via exponential mapping
-        Vector{delta_gen_coords(3), delta_gen_coords(4), delta_gen_coords(5)} * h
+    if (n_constraints > 0) {
+        // Take negative of the solution increments to update Lagrange multipliers
+        host_parallel_for(
+            "alpha_step_update_lagrange_mults", n_constraints,
+            KOKKOS_LAMBDA(const size_t i) {
+                lagrange_mults(i) -= scale * soln_increments(i + size);
+            }
+        );
+    }
+
+    // Update the velocity, acceleration, and constraints based on the increments - take
+    // negative of the solution increments to update generalized coordinates
+    host_parallel_for(
+        "alpha_step_update_increments", size,
+        KOKKOS_LAMBDA(const size_t i) {
+            const auto delta_x = -scale * soln_increments(i);
+            delta_gen_coords(i) += delta_x / h;
+            velocity(i) += GAMMA_PRIME * delta_x;
+            acceleration(i) += BETA_PRIME * delta_x;
+        }
     );
-    auto q = current_orientation * updated_orientation;
+}
 
-    // Construct the updated generalized coordinates from position and orientation vectors
-    auto gen_coords_next = HostView1D("generalized_coordinates_next", gen_coords.size());
-    constexpr int numComponents = 7;
-    double components[numComponents] = {
-        r.GetXComponent(),       // component 1
-        r.GetYComponent(),       // component 2
-        r.GetZComponent(),       // component 3
-        q.GetScalarComponent(),  // component 4
-        q.GetXComponent(),       // component 5
-        q.GetYComponent(),       // component 6
-        q.GetZComponent()        // component 7
+template <typename Problem>
+void GeneralizedAlphaTimeIntegrator::SolveMatrixFree(
+    Problem& problem, const HostView1D gen_coords, const HostView1D residuals, double BETA_PRIME,
+    double GAMMA_PRIME
+) {
+    const auto h = this->time_stepper_.GetTimeStep();
+    const auto gen_coords_next = workspace_.GetGeneralizedCoordinatesNext();
+    const auto delta_gen_coords = workspace_.GetGeneralizedCoordinatesIncrement();
+    const auto velocity = workspace_.GetVelocity();
+    const auto acceleration = workspace_.GetAcceleration();
+    const auto lagrange_mults = workspace_.GetLagrangeMultipliersNext();
+    const auto perturbed_gen_coords = workspace_.GetPerturbedGeneralizedCoordinates();
+    const auto perturbed_delta_gen_coords = workspace_.GetPerturbedGeneralizedCoordinatesIncrement();
+    const auto perturbed_velocity = workspace_.GetPerturbedVelocity();
+    const auto perturbed_acceleration = workspace_.GetPerturbedAcceleration();
+    const auto perturbed_lagrange_mults = workspace_.GetPerturbedLagrangeMultipliers();
+    const auto krylov_vector = workspace_.GetKrylovVector();
+    const auto size = velocity.extent(0);
+    const auto n_constraints = lagrange_mults.extent(0);
+
+    // The finite difference step is relative to the magnitude of the generalized coordinates,
+    // as proposed by Brown and Saad (1990), and sized by the part of the vector that perturbs
+    // them - the residuals are affine in the Lagrange multipliers, i.e. their part of the
+    // vector is differentiated exactly by any step
+    const auto gen_coords_norm = CalculateResidualNorm(gen_coords_next);
+    const auto is_linearize_fused = problem.IsLinearizeFused();
+    const auto jacobian_vector_product = [&](const HostView1D vector, HostView1D product) {
+        if (problem.HasJacobianVectorProduct()) {
+            problem.JacobianVectorProduct(
+                h, BETA_PRIME, GAMMA_PRIME, gen_coords_next, delta_gen_coords, velocity,
+                acceleration, lagrange_mults, vector, product
+            );
+            return;
+        }
+
+        auto gen_coords_vector_norm = 0.;
+        host_parallel_reduce(
+            "matrix_free_vector_norm", size,
+            KOKKOS_LAMBDA(const size_t i, double& partial_sum) {
+                partial_sum += vector(i) * vector(i);
+            },
+            Kokkos::Sum<double>(gen_coords_vector_norm)
+        );
+        gen_coords_vector_norm = std::sqrt(gen_coords_vector_norm);
+        const auto vector_norm =
+            gen_coords_vector_norm > 0. ? gen_coords_vector_norm : CalculateResidualNorm(vector);
+        if (vector_norm == 0.) {
+            Kokkos::deep_copy(product, 0.);
+            return;
+        }
+        const auto epsilon =
+            this->linear_solver_policy_.perturbation * (1. + gen_coords_norm) / vector_norm;
+
+        // Perturb the state the same way the solution increments update it
+        host_parallel_for(
+            "matrix_free_perturb_state", size,
+            KOKKOS_LAMBDA(const size_t i) {
+                const auto delta_x = epsilon * vector(i);
+                perturbed_delta_gen_coords(i) = delta_gen_coords(i) + delta_x / h;
+                perturbed_velocity(i) = velocity(i) + GAMMA_PRIME * delta_x;
+                perturbed_acceleration(i) = acceleration(i) + BETA_PRIME * delta_x;
+            }
+        );
+        host_parallel_for(
+            "matrix_free_perturb_lagrange_mults", n_constraints,
+            KOKKOS_LAMBDA(const size_t i) {
+                perturbed_lagrange_mults(i) = lagrange_mults(i) + epsilon * vector(i + size);
+            }
+        );
+        this->UpdateGeneralizedCoordinates(
+            gen_coords, perturbed_delta_gen_coords, perturbed_gen_coords
+        );
+
+        auto perturbed_residuals = workspace_.GetPerturbedResiduals();
+        if (is_linearize_fused) {
+            problem.Linearize(
+                h, BETA_PRIME, GAMMA_PRIME, perturbed_gen_coords, perturbed_delta_gen_coords,
+                perturbed_velocity, perturbed_acceleration, perturbed_lagrange_mults,
+                perturbed_residuals, false, workspace_.GetIterationMatrix()
+            );
+        } else {
+            perturbed_residuals = problem.ResidualVector(
+                perturbed_gen_coords, perturbed_velocity, perturbed_acceleration,
+                perturbed_lagrange_mults
+            );
+        }
+        host_parallel_for(
+            "matrix_free_jacobian_vector_product", product.extent(0),
+            KOKKOS_LAMBDA(const size_t i) {
+                product(i) = (perturbed_residuals(i) - residuals(i)) / epsilon;
+            }
+        );
     };
 
-    Kokkos::parallel_for(
-        gen_coords.size(), KOKKOS_LAMBDA(const size_t i) { gen_coords_next(i) = components[i]; }
+    // Solve the system scaled by the preconditioner (Bottasso et al 2008), i.e. multiply with
+    // [DL] [A] [DR] and recover the solution of the original system from the scaled one
+    auto soln_increments = workspace_.GetSolutionIncrements();
+    Kokkos::deep_copy(soln_increments, residuals);
+    auto system = LinearOperator(jacobian_vector_product);
+    if (this->precondition_) {
+        system = [&](const HostView1D vector, HostView1D product) {
+            Kokkos::deep_copy(krylov_vector, vector);
+            preconditioner_.ApplyToSolution(krylov_vector);
+            jacobian_vector_product(krylov_vector, product);
+            preconditioner_.ApplyToRightHandSide(product);
+        };
+        preconditioner_.ApplyToRightHandSide(soln_increments);
+    }
+
+    const auto is_solved = krylov_solver_.Solve(
+        system, soln_increments, this->linear_solver_policy_.preconditioner
     );
+    if (this->precondition_) {
+        preconditioner_.ApplyToSolution(soln_increments);
+    }
+
+    if (!is_solved) {
+        OTURB_LOG_WARNING(
+            "GMRES failed to converge after " +
+            std::to_string(krylov_solver_.GetNumberOfIterations()) +
+            " iterations, with a relative residual of " +
+            std::to_string(krylov_solver_.GetRelativeResidualNorm()) + "\n"
+        );
+    }
+}
 
+HostView1D GeneralizedAlphaTimeIntegrator::UpdateGeneralizedCoordinates(
+    const HostView1D gen_coords, const HostView1D delta_gen_coords
+) {
+    auto gen_coords_next = HostView1D("generalized_coordinates_next", gen_coords.size());
+    UpdateGeneralizedCoordinates(gen_coords, delta_gen_coords, gen_coords_next);
     return gen_coords_next;
 }
 
+void GeneralizedAlphaTimeIntegrator::UpdateGeneralizedCoordinates(
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, HostView1D gen_coords_next
+) {
+    // {gen_coords_next} = {gen_coords} + h * {delta_gen_coords}, computed entirely inside of
+    // the kernel since Vector and Quaternion are device-callable - one body per iteration
+    const auto h = this->time_stepper_.GetTimeStep();
+    const auto n_bodies = gen_coords.extent(0) / kNumberOfGeneralizedCoordinatesPerBody;
+    host_parallel_for(
+        "update_generalized_coordinates", n_bodies,
+        KOKKOS_LAMBDA(const size_t body) {
+            const auto q = body * kNumberOfGeneralizedCoordinatesPerBody;
+            const auto v = body * kNumberOfVelocitiesPerBody;
+
+            // Step 1: R^3 update, done with vector addition
+            const auto current_position =
+                Vector{gen_coords(q), gen_coords(q + 1), gen_coords(q + 2)};
+            const auto updated_position =
+                Vector{delta_gen_coords(v), delta_gen_coords(v + 1), delta_gen_coords(v + 2)};
+            const auto r = current_position + (updated_position * h);
+
+            // Step 2: SO(3) update, done with quaternion composition
+            const auto current_orientation = Quaternion{
+                gen_coords(q + 3), gen_coords(q + 4), gen_coords(q + 5), gen_coords(q + 6)};
+            const auto rotation_vector =
+                Vector{delta_gen_coords(v + 3), delta_gen_coords(v + 4), delta_gen_coords(v + 5)};
+            // Convert Vector -> Quaternion via exponential mapping
+            const auto updated_orientation = quaternion_from_rotation_vector(rotation_vector * h);
+            const auto orientation = current_orientation * updated_orientation;
+
+            gen_coords_next(q) = r.GetXComponent();
+            gen_coords_next(q + 1) = r.GetYComponent();
+            gen_coords_next(q + 2) = r.GetZComponent();
+            gen_coords_next(q + 3) = orientation.GetScalarComponent();
+            gen_coords_next(q + 4) = orientation.GetXComponent();
+            gen_coords_next(q + 5) = orientation.GetYComponent();
+            gen_coords_next(q + 6) = orientation.GetZComponent();
+        }
+    );
+}
+
+void GeneralizedAlphaTimeIntegrator::SetJacobianUpdatePolicy(const JacobianUpdatePolicy& policy) {
+    if (policy.k == 0) {
+        throw std::invalid_argument("The number of iterations/steps between updates must be > 0");
+    }
+
+    if (policy.stall_ratio <= 0.) {
+        throw std::invalid_argument("The stall ratio must be positive");
+    }
+
+    this->jacobian_update_policy_ = policy;
+    this->linear_solver_.Invalidate();
+    this->banded_solver_.Invalidate();
+}
+
+void GeneralizedAlphaTimeIntegrator::SetNewtonPolicy(const NewtonPolicy& policy) {
+    if (policy.predictor_order > 3) {
+        throw std::invalid_argument("The predictor extrapolates at most 3 converged steps");
+    }
+
+    if (policy.is_line_search && policy.max_backtracks == 0) {
+        throw std::invalid_argument("The line search must allow at least one backtrack");
+    }
+
+    if (policy.armijo_constant < 0. || policy.armijo_constant >= 1.) {
+        throw std::invalid_argument("The Armijo constant must be in [0, 1)");
+    }
+
+    if (policy.relative_tolerance < 0. || policy.relative_tolerance >= 1.) {
+        throw std::invalid_argument("The relative tolerance must be in [0, 1)");
+    }
+
+    this->newton_policy_ = policy;
+    this->n_predictor_steps_ = 0;
+}
+
+void GeneralizedAlphaTimeIntegrator::SetDiagnosticsPolicy(const DiagnosticsPolicy& policy) {
+    if (!(policy.renormalization_threshold > 0.)) {
+        throw std::invalid_argument("The renormalization threshold must be > 0");
+    }
+
+    this->diagnostics_policy_ = policy;
+}
+
+template <typename Problem>
+void GeneralizedAlphaTimeIntegrator::AccumulateDiagnostics(const State& state, Problem& problem) {
+    if (!this->diagnostics_policy_.is_enabled) {
+        return;
+    }
+
+    const auto gen_coords = state.GetGeneralizedCoordinates();
+    const auto n_bodies = gen_coords.extent(0) / kNumberOfGeneralizedCoordinatesPerBody;
+    if (this->diagnostics_.extent(0) != n_bodies) {
+        this->diagnostics_ = InvariantDiagnosticsView1D<Kokkos::HostSpace>("diagnostics", n_bodies);
+        this->invariants_ = RigidBodyInvariantsView1D<Kokkos::HostSpace>("invariants", n_bodies);
+    }
+
+    const auto invariants = this->invariants_;
+    if (problem.HasInvariants()) {
+        problem.CalculateInvariants(gen_coords, state.GetVelocity(), invariants);
+    } else {
+        Kokkos::deep_copy(invariants, RigidBodyInvariants{});
+    }
+
+    // The drift is evaluated here for every problem
+    const auto diagnostics = this->diagnostics_;
+    host_parallel_for(
+        "accumulate_diagnostics", n_bodies,
+        KOKKOS_LAMBDA(const size_t body) {
+            const auto q = body * kNumberOfGeneralizedCoordinatesPerBody;
+            auto body_gen_coords = Vec<7>{};
+            for (size_t i = 0; i < kNumberOfGeneralizedCoordinatesPerBody; ++i) {
+                body_gen_coords(i) = gen_coords(q + i);
+            }
+            invariants(body).quaternion_norm_drift =
+                calculate_quaternion_norm_drift(body_gen_coords);
+            diagnostics(body).Accumulate(invariants(body));
+        }
+    );
+}
+
+void GeneralizedAlphaTimeIntegrator::RenormalizeQuaternions(State& state) {
+    if (!this->diagnostics_policy_.is_enabled) {
+        return;
+    }
+
+    // The quaternions beyond the threshold are renormalized in the generalized coordinates of
+    // the state, i.e. the next time step starts from unit quaternions
+    const auto gen_coords = state.GetGeneralizedCoordinates();
+    const auto diagnostics = this->diagnostics_;
+    const auto invariants = this->invariants_;
+    const auto threshold = this->diagnostics_policy_.renormalization_threshold;
+    host_parallel_for(
+        "renormalize_quaternions", diagnostics.extent(0),
+        KOKKOS_LAMBDA(const size_t body) {
+            if (invariants(body).quaternion_norm_drift <= threshold) {
+                return;
+            }
+            const auto q = body * kNumberOfGeneralizedCoordinatesPerBody;
+            auto body_gen_coords = Vec<7>{};
+            for (size_t i = 0; i < kNumberOfGeneralizedCoordinatesPerBody; ++i) {
+                body_gen_coords(i) = gen_coords(q + i);
+            }
+            renormalize_quaternion(body_gen_coords);
+            for (size_t i = 3; i < kNumberOfGeneralizedCoordinatesPerBody; ++i) {
+                gen_coords(q + i) = body_gen_coords(i);
+            }
+            diagnostics(body).n_renormalizations++;
+        }
+    );
+}
+
+bool GeneralizedAlphaTimeIntegrator::IsJacobianUpdateRequired(
+    size_t iteration, double residual_norm, double previous_residual_norm
+) const {
+    const auto is_factorized =
+        this->IsSparseDirect() ? banded_solver_.IsFactorized() : linear_solver_.IsFactorized();
+    if (!is_factorized) {
+        return true;
+    }
+
+    const auto k = jacobian_update_policy_.k;
+    switch (jacobian_update_policy_.strategy) {
+        case JacobianUpdateStrategy::kEVERY_K_ITERATIONS:
+            return iteration % k == 0;
+        case JacobianUpdateStrategy::kEVERY_K_STEPS:
+            return iteration == 0 && n_steps_since_jacobian_update_ >= k;
+        case JacobianUpdateStrategy::kON_STALL:
+            return residual_norm > jacobian_update_policy_.stall_ratio * previous_residual_norm;
+        case JacobianUpdateStrategy::kBROYDEN:
+            return iteration == 0 ||
+                   residual_norm > jacobian_update_policy_.stall_ratio * previous_residual_norm;
+        case JacobianUpdateStrategy::kEVERY_ITERATION:
+        default:
+            return true;
+    }
+}
+
 bool GeneralizedAlphaTimeIntegrator::CheckConvergence(const HostView1D residual) {
     // L2 norm of the residual vector should be very small (< epsilon) for the solution
     // to be considered converged
+    return CalculateResidualNorm(residual) < kCONVERGENCETOLERANCE ? true : false;
+}
+
+bool GeneralizedAlphaTimeIntegrator::CheckConvergence(
+    double residual_norm, double initial_residual_norm
+) const {
+    // Large problems, or ones with large forces, may not reach the absolute tolerance in double
+    // precision, so the residual norm may converge relative to that of the first iteration
+    return residual_norm < kCONVERGENCETOLERANCE ||
+           residual_norm < this->newton_policy_.relative_tolerance * initial_residual_norm;
+}
+
+double GeneralizedAlphaTimeIntegrator::CalculateResidualNorm(const HostView1D residual) {
     double residual_norm = 0.;
-    Kokkos::parallel_reduce(
-        residual.extent(0),
+    host_parallel_reduce(
+        "residual_norm", residual.extent(0),
         KOKKOS_LAMBDA(int i, double& residual_partial_sum) {
             double residual_value = residual(i);
             residual_partial_sum += residual_value * residual_value;
         },
         Kokkos::Sum<double>(residual_norm)
     );
-    residual_norm = std::sqrt(residual_norm);
-
-    return (residual_norm) < kCONVERGENCETOLERANCE ? true : false;
+    return std::sqrt(residual_norm);
 }
 
+#define OTURB_INSTANTIATE_GENERALIZED_ALPHA_PROBLEM(Problem)                                     \
+    template std::vector<State> GeneralizedAlphaTimeIntegrator::Integrate<Problem>(             \
+        const State&, size_t, Problem&                                                          \
+    );                                                                                          \
+    template void GeneralizedAlphaTimeIntegrator::Integrate<Problem>(                           \
+        const State&, size_t, Problem&, StateObserver&                                          \
+    );                                                                                          \
+    template std::tuple<State, HostView1D> GeneralizedAlphaTimeIntegrator::AlphaStep<Problem>(  \
+        const State&, size_t, Problem&                                                          \
+    )
+
+OTURB_INSTANTIATE_GENERALIZED_ALPHA_PROBLEM(LinearizationParameters);
+OTURB_INSTANTIATE_GENERALIZED_ALPHA_PROBLEM(UnityLinearizationParameters);
+OTURB_INSTANTIATE_GENERALIZED_ALPHA_PROBLEM(HeavyTopLinearizationParameters);
+OTURB_INSTANTIATE_GENERALIZED_ALPHA_PROBLEM(MultibodyModel);
+
+#undef OTURB_INSTANTIATE_GENERALIZED_ALPHA_PROBLEM
+
 }  // namespace openturbine::rigid_pendulum
@@ -1,20 +1,140 @@
 #pragma once
 
+#include <type_traits>
+
+#include "src/rigid_pendulum_poc/checkpoint.h"
+#include "src/rigid_pendulum_poc/generalized_alpha_workspace.h"
+#include "src/rigid_pendulum_poc/invariants.h"
 #include "src/rigid_pendulum_poc/linearization_parameters.h"
+#include "src/rigid_pendulum_poc/preconditioner.h"
+#include "src/rigid_pendulum_poc/solver.h"
 #include "src/rigid_pendulum_poc/state.h"
 #include "src/rigid_pendulum_poc/time_integrator.h"
+#include "src/rigid_pendulum_poc/time_step_controller.h"
 #include "src/rigid_pendulum_poc/time_stepper.h"
 
 namespace openturbine::rigid_pendulum {
 
-/// @brief A time integrator class based on the generalized-alpha method
+// An enum class to indicate when the iteration matrix is re-assembled and re-factorized
+enum class JacobianUpdateStrategy {
+    kEVERY_ITERATION = 0,  //< Full Newton-Raphson, i.e. a new factorization in every iteration
+    kEVERY_K_ITERATIONS,   //< Every k-th iteration of every time step
+    kEVERY_K_STEPS,        //< In the first iteration of every k-th time step
+    kON_STALL,             //< Only when the residual norm decreases too slowly
+    kBROYDEN,              //< In the first iteration and on stall, Broyden updates in between
+};
+
+/*! @brief Policy for reusing the factorization of the iteration matrix (modified Newton)
+ *  @details Whenever the iteration matrix is not updated, the Newton-Raphson iteration solves
+ *      with the factors of the latest update, which skips the assembly and the O(n^3)
+ *      factorization of the iteration matrix.
+ *
+ *      With kBROYDEN, the iteration matrix is updated in the first iteration of every time step
+ *      and whenever the residual norm decreases too slowly, as with kON_STALL, and its inverse
+ *      is updated with the secant of every step in between (quasi-Newton), see BroydenUpdate.
+ *      Those iterations only evaluate the residual vector and solve twice with the factors of
+ *      the latest update, which keeps the superlinear convergence that the modified Newton
+ *      iteration loses. The Broyden updates do not apply to matrix-free linear solves.
+ */
+struct JacobianUpdatePolicy {
+    JacobianUpdateStrategy strategy = JacobianUpdateStrategy::kEVERY_ITERATION;
+    size_t k = 1;              //< Number of iterations/time steps between updates
+    double stall_ratio = 0.5;  //< Update if |residual| > stall_ratio * |previous residual|
+};
+
+/*! @brief Policy for the predictor and the convergence of the Newton-Raphson iterations
+ *  @details With a predictor order p > 0, the iterations of a time step start from the
+ *      acceleration and Lagrange multipliers extrapolated from the latest p converged time steps
+ *      by a polynomial of degree p - 1, rather than from zero. The extrapolation assumes equal
+ *      time steps, so the history is discarded whenever the time step changes, after a time step
+ *      fails to converge, and at the start of every time integration - it is not part of
+ *      checkpoints, i.e. a restart with a predictor is not identical to the uninterrupted time
+ *      integration.
+ *
+ *      With a line search, an increment that does not decrease the residual norm sufficiently
+ *      (Armijo condition) is halved, up to max_backtracks times, before the next increment is
+ *      solved for - every backtrack counts as an iteration. A relative tolerance > 0 considers
+ *      the iterations converged as well once the residual norm drops below the relative tolerance
+ *      times the residual norm of the first iteration.
+ */
+struct NewtonPolicy {
+    size_t predictor_order = 0;      //< Number of converged steps to extrapolate, 0 for none
+    bool is_line_search = false;     //< Flag to indicate if increments are backtracked
+    size_t max_backtracks = 4;       //< Maximum number of halvings of one increment
+    double armijo_constant = 1e-4;   //< Sufficient decrease of the residual norm per unit step
+    double relative_tolerance = 0.;  //< Tolerance relative to the first residual norm, 0 for none
+};
+
+// An enum class to indicate how the linear system of every Newton-Raphson iteration is solved
+enum class LinearSolverType {
+    kDIRECT = 0,     //< LU factorization of the assembled iteration matrix
+    kNEWTON_KRYLOV,  //< Matrix-free GMRES, i.e. Jacobian-free Newton-Krylov (JFNK)
+    kNULL_SPACE,     //< LU factorization of the iteration matrix reduced to the null space
+    kSPARSE_DIRECT,  //< Banded LU factorization of the block sparse iteration matrix
+};
+
+/*! @brief Policy for solving the linear system of every Newton-Raphson iteration
+ *  @details With kNEWTON_KRYLOV the iteration matrix is neither assembled nor factorized, GMRES
+ *      only requires its products with vectors. These are provided by the problem if it
+ *      implements LinearizationParameters::HasJacobianVectorProduct(), and are approximated by
+ *      finite differences of the residual vector otherwise - the Jacobian update policy has no
+ *      effect. If the integrator is preconditioned, GMRES solves the system scaled by the
+ *      Bottasso preconditioner, and the optional preconditioner below is applied to it from
+ *      the right.
+ *
+ *      With kDIRECT and mixed precision, the iteration matrix is factorized in single precision
+ *      and every solve is refined to double precision accuracy, falling back to a double
+ *      precision factorization if the refinement stalls. Checkpoints then do not hold the
+ *      factorization, i.e. a restart reproduces the uninterrupted integration only if the
+ *      iteration matrix is updated in every iteration.
+ *
+ *      With kNULL_SPACE, the assembled iteration matrix is reduced to the null space of the
+ *      constraint gradient by a NullSpaceReduction, i.e. the factorized system is of the size
+ *      of the velocities instead of the velocities and the constraints, and the Lagrange
+ *      multipliers are recovered after every solve. Checkpoints then do not hold the
+ *      factorization either.
+ *
+ *      With kSPARSE_DIRECT, the iteration matrix is assembled in a block sparse format by
+ *      LinearizationParameters::SparseIterationMatrix(), i.e. never as a dense matrix, and
+ *      factorized by a BandedLinearSolver after reordering its blocks to a small bandwidth. The
+ *      factorization is kept according to the Jacobian update policy like the dense one, is
+ *      always in double precision, and is not held by checkpoints.
+ */
+struct LinearSolverPolicy {
+    LinearSolverType type = LinearSolverType::kDIRECT;
+    size_t krylov_restart = 30;           //< Number of GMRES iterations between restarts
+    size_t max_krylov_iterations = 200;   //< Maximum number of GMRES iterations per solve
+    double krylov_tolerance = 1e-6;       //< Relative residual norm of GMRES, i.e. forcing term
+    double perturbation = 1.4901161e-08;  //< Relative finite difference step, i.e. sqrt(eps)
+    LinearOperator preconditioner;        //< Right preconditioner of GMRES, identity if empty
+    FactorizationPrecision precision = FactorizationPrecision::kDOUBLE;  //< Precision of the LU
+    size_t max_refinement_iterations = 10;  //< Maximum number of refinements of a mixed solve
+};
+
+/// Restricts the statically dispatched integration to problems implementing the interface of
+/// LinearizationParameters, i.e. excludes shared pointers to them
+template <typename Problem>
+using EnableIfProblem = std::enable_if_t<std::is_base_of_v<LinearizationParameters, Problem>>;
+
+/*! @brief A time integrator class based on the generalized-alpha method
+ *  @details The problem is either provided as a shared pointer to LinearizationParameters, i.e.
+ *      with its residual vector and iteration matrix called through virtual dispatch, or by
+ *      reference to its concrete type, i.e. with static dispatch - calls to problems declared
+ *      final are then bound at compile time and can be inlined into the Newton-Raphson loop.
+ *      The statically dispatched member templates are instantiated for the problems of this
+ *      library in the translation unit.
+ */
 class GeneralizedAlphaTimeIntegrator : public TimeIntegrator {
 public:
     static constexpr double kCONVERGENCETOLERANCE = 1e-12;
+    static constexpr double kTIMETOLERANCE = 1e-12;  //< Relative tolerance of the final time
+    static constexpr size_t kNumberOfGeneralizedCoordinatesPerBody = 7;
+    static constexpr size_t kNumberOfVelocitiesPerBody = 6;
 
     GeneralizedAlphaTimeIntegrator(
         double alpha_f = 0.5, double alpha_m = 0.5, double beta = 0.25, double gamma = 0.5,
-        TimeStepper time_stepper = TimeStepper(), bool precondition = false
+        TimeStepper time_stepper = TimeStepper(), bool precondition = false,
+        LinearSolverPolicy linear_solver_policy = LinearSolverPolicy()
     );
 
     /// Returns the type of the time integrator
@@ -42,6 +162,45 @@ public:
         const State&, size_t, std::shared_ptr<LinearizationParameters> lin_params
     ) override;
 
+    /*! @brief Performs the time integration and hands the state of every time step, starting
+     *      with the initial state, to the provided observer
+     *  @details Only the latest state is kept, i.e. the memory does not grow with the number of
+     *      time steps unless the observer stores the states
+     */
+    virtual void Integrate(
+        const State&, size_t, std::shared_ptr<LinearizationParameters> lin_params,
+        StateObserver& observer
+    ) override;
+
+    /// Performs the time integration of the provided problem with static dispatch and returns a
+    /// vector of States over the time steps
+    template <typename Problem, typename = EnableIfProblem<Problem>>
+    std::vector<State> Integrate(const State&, size_t, Problem& problem);
+
+    /// Performs the time integration of the provided problem with static dispatch and hands the
+    /// state of every time step, starting with the initial state, to the provided observer
+    template <typename Problem, typename = EnableIfProblem<Problem>>
+    void Integrate(const State&, size_t, Problem& problem, StateObserver& observer);
+
+    /*! @brief Resumes a time integration from the provided checkpoint and hands the state of
+     *      every remaining time step to the provided observer
+     *  @details The results are identical to those of the uninterrupted time integration, given
+     *      the same integrator parameters, time stepper, and Jacobian update policy
+     */
+    void Restart(
+        const Checkpoint&, size_t, std::shared_ptr<LinearizationParameters> lin_params,
+        StateObserver& observer
+    );
+
+    /// Returns a checkpoint of the provided time step, state, and Lagrange multipliers
+    Checkpoint CreateCheckpoint(size_t step, const State&, const HostView1D lagrange_mults) const;
+
+    /// Returns the policy for writing checkpoints during the time integration
+    inline const CheckpointPolicy& GetCheckpointPolicy() const { return checkpoint_policy_; }
+
+    /// Sets the policy for writing checkpoints during the time integration
+    void SetCheckpointPolicy(const CheckpointPolicy&);
+
     /*! Implements the solveTimeStep() algorithm of the Lie group based generalized-alpha
      *  method as described in Brüls, Cardona, and Arnold, "Lie group generalized-alpha time
      *  integration of constrained flexible multibody systems," 2012, Mechanism and
@@ -52,15 +211,108 @@ public:
         const State&, size_t, std::shared_ptr<LinearizationParameters> lin_params
     );
 
-    /// Computes the updated generalized coordinates based on the non-linear update
+    /// Performs one time step of the provided problem with static dispatch, see above
+    template <typename Problem, typename = EnableIfProblem<Problem>>
+    std::tuple<State, HostView1D> AlphaStep(const State&, size_t, Problem& problem);
+
+    /// Computes the updated generalized coordinates based on the non-linear update, i.e. of
+    /// every body of the provided coordinates (7 per body) and increments (6 per body)
     HostView1D UpdateGeneralizedCoordinates(const HostView1D, const HostView1D);
 
+    /// Computes the updated generalized coordinates in place, i.e. into the provided view
+    void UpdateGeneralizedCoordinates(const HostView1D, const HostView1D, HostView1D);
+
     /// Checks convergence of the non-linear solution based on the residuals
     bool CheckConvergence(const HostView1D);
 
+    /// Checks convergence of the non-linear solution based on the residual norm, i.e. against
+    /// the absolute tolerance and, if set, the relative tolerance of the Newton policy
+    bool CheckConvergence(double residual_norm, double initial_residual_norm) const;
+
     /// Returns the flag to indicate if the latest non-linear update has converged
     inline bool IsConverged() const { return is_converged_; }
 
+    /// Returns a const reference to the workspace holding the time step temporaries
+    inline const GeneralizedAlphaWorkspace& GetWorkspace() const { return workspace_; }
+
+    /// Returns the policy for updating the iteration matrix
+    inline const JacobianUpdatePolicy& GetJacobianUpdatePolicy() const {
+        return jacobian_update_policy_;
+    }
+
+    /// Sets the policy for updating the iteration matrix, discarding any stored factorization
+    void SetJacobianUpdatePolicy(const JacobianUpdatePolicy&);
+
+    /// Returns the policy for the predictor and the convergence of the Newton-Raphson iterations
+    inline const NewtonPolicy& GetNewtonPolicy() const { return newton_policy_; }
+
+    /// Sets the policy for the predictor and the convergence of the Newton-Raphson iterations,
+    /// discarding the history of the predictor
+    void SetNewtonPolicy(const NewtonPolicy&);
+
+    /// Returns the policy for accumulating the invariants of the bodies during the integration
+    inline const DiagnosticsPolicy& GetDiagnosticsPolicy() const { return diagnostics_policy_; }
+
+    /*! @brief Sets the policy for accumulating the invariants of the bodies during the
+     *      integration, i.e. their running statistics over the initial state and every accepted
+     *      time step, without storing any states
+     *  @details The quaternion norm drift of every body is evaluated from the generalized
+     *      coordinates, the other invariants only for problems that define them (see
+     *      LinearizationParameters::HasInvariants()). The quaternions of the bodies whose drift
+     *      exceeds the renormalization threshold are scaled to unit norm after the invariants of
+     *      the time step are accumulated, i.e. the statistics record the drift as integrated.
+     *      The diagnostics are reset at the start of every integration and continue across a
+     *      restart, i.e. they are not part of the checkpoints.
+     */
+    void SetDiagnosticsPolicy(const DiagnosticsPolicy&);
+
+    /// Returns the running statistics of the invariants of each body, empty if not enabled
+    inline InvariantDiagnosticsView1D<Kokkos::HostSpace> GetDiagnostics() const {
+        return diagnostics_;
+    }
+
+    /// Returns the policy for adapting the time step to the local error
+    inline const AdaptiveTimeStepPolicy& GetAdaptiveTimeStepPolicy() const {
+        return time_step_controller_.GetPolicy();
+    }
+
+    /*! @brief Sets the policy for adapting the time step to the local error
+     *  @details With an adaptive time step, the time integration runs until the final time of
+     *      the time stepper, i.e. the number of time steps of the time stepper only defines the
+     *      final time, starting with the time step of the time stepper
+     */
+    void SetAdaptiveTimeStepPolicy(const AdaptiveTimeStepPolicy&);
+
+    /// Returns the number of time steps rejected by the adaptive time step control thus far
+    inline size_t GetNumberOfRejectedSteps() const { return n_rejected_steps_; }
+
+    /// Returns a const reference to the linear solver holding the latest factorization
+    inline const DenseLinearSolver& GetLinearSolver() const { return linear_solver_; }
+
+    /// Returns the policy for solving the linear system of every Newton-Raphson iteration
+    inline const LinearSolverPolicy& GetLinearSolverPolicy() const {
+        return linear_solver_policy_;
+    }
+
+    /// Returns a const reference to the banded solver holding the latest factorization, if the
+    /// linear solver type is kSPARSE_DIRECT
+    inline const BandedLinearSolver& GetBandedLinearSolver() const { return banded_solver_; }
+
+    /// Returns a const reference to the reduction of the iteration matrix to the null space of
+    /// the constraints, if the linear solver type is kNULL_SPACE
+    inline const NullSpaceReduction& GetNullSpaceReduction() const {
+        return null_space_reduction_;
+    }
+
+    /// Returns a const reference to the GMRES solver of the matrix-free linear solves
+    inline const GMRESSolver& GetKrylovSolver() const { return krylov_solver_; }
+
+    /// Returns the flag to indicate if the iteration matrix is preconditioned
+    inline bool IsPreconditioned() const { return precondition_; }
+
+    /// Returns a const reference to the preconditioner of the linear solves
+    inline const DiagonalPreconditioner& GetPreconditioner() const { return preconditioner_; }
+
 private:
     const double kALPHA_F_;  //< Alpha_f coefficient of the generalized-alpha method
     const double kALPHA_M_;  //< Alpha_m coefficient of the generalized-alpha method
@@ -70,6 +322,105 @@ private:
     bool is_converged_;         //< Flag to indicate if the latest non-linear update has converged
     TimeStepper time_stepper_;  //< Time stepper object to perform the time integration
     bool precondition_;         //< Flag to indicate if the iteration matrix is preconditioned
+
+    GeneralizedAlphaWorkspace workspace_;    //< Preallocated temporaries of the time step
+    DiagonalPreconditioner preconditioner_;  //< Scaling of the linear solves, if preconditioned
+
+    JacobianUpdatePolicy jacobian_update_policy_;  //< When to update the iteration matrix
+    DenseLinearSolver linear_solver_;              //< Keeps the factorized iteration matrix
+    size_t n_steps_since_jacobian_update_;         //< Number of steps since the latest update
+
+    NewtonPolicy newton_policy_;           //< Predictor and convergence of the iterations
+    HostView2D predictor_accelerations_;   //< Accelerations of the latest converged steps
+    HostView2D predictor_lagrange_mults_;  //< Lagrange multipliers of the same steps
+    size_t n_predictor_steps_;             //< Number of steps held by the two views above
+
+    LinearSolverPolicy linear_solver_policy_;  //< How the linear systems are solved
+    GMRESSolver krylov_solver_;                //< Solves the systems if matrix-free
+    NullSpaceReduction null_space_reduction_;  //< Reduces the systems if kNULL_SPACE
+    BandedLinearSolver banded_solver_;         //< Keeps the factorized system if kSPARSE_DIRECT
+    BroydenUpdate broyden_update_;             //< Updates the inverse if kBROYDEN
+
+    CheckpointPolicy checkpoint_policy_;       //< When and where to write checkpoints
+    TimeStepController time_step_controller_;  //< Adapts the time step to the local error
+    size_t n_rejected_steps_;                  //< Number of rejected time steps thus far
+
+    DiagnosticsPolicy diagnostics_policy_;                       //< When to accumulate invariants
+    InvariantDiagnosticsView1D<Kokkos::HostSpace> diagnostics_;  //< Statistics of each body
+    RigidBodyInvariantsView1D<Kokkos::HostSpace> invariants_;    //< Invariants of the latest state
+
+    /// Checks that the provided state is of the sizes supported by the integrator, i.e. of
+    /// one or more rigid bodies with 7 generalized coordinates and 6 velocities each
+    static void CheckStateSizes(const State&);
+
+    /// Performs the time steps after the provided one, starting from the provided state
+    template <typename Problem>
+    void IntegrateSteps(
+        size_t first_step, const State&, size_t, Problem& problem, StateObserver& observer
+    );
+
+    /// Accumulates the invariants of the provided state into the diagnostics, if enabled
+    template <typename Problem>
+    void AccumulateDiagnostics(const State&, Problem& problem);
+
+    /// Renormalizes the quaternions of the provided state whose drift, as of the latest
+    /// AccumulateDiagnostics(), exceeds the threshold, i.e. modifies its generalized coordinates
+    /// in place - does nothing if the diagnostics are not enabled
+    void RenormalizeQuaternions(State&);
+
+    /// Returns if the linear systems are solved without forming the iteration matrix
+    inline bool IsMatrixFree() const {
+        return linear_solver_policy_.type == LinearSolverType::kNEWTON_KRYLOV;
+    }
+
+    /// Returns if the linear systems are reduced to the null space of the constraints
+    inline bool IsNullSpaceReduced() const {
+        return linear_solver_policy_.type == LinearSolverType::kNULL_SPACE;
+    }
+
+    /// Returns if the linear systems are assembled block sparse and factorized as band matrices
+    inline bool IsSparseDirect() const {
+        return linear_solver_policy_.type == LinearSolverType::kSPARSE_DIRECT;
+    }
+
+    /*! @brief Solves the linear system of the current Newton-Raphson iteration with GMRES into
+     *      the solution increments of the workspace, i.e. without forming the iteration matrix
+     *  @details The products of the iteration matrix with a vector {v} are either provided by
+     *      the problem, or approximated by the directional derivative of the residual vector,
+     *      i.e. ({r}(x + epsilon {v}) - {r}(x)) / epsilon, with the same update of the state
+     *      as the solution increments
+     */
+    template <typename Problem>
+    void SolveMatrixFree(
+        Problem& problem, const HostView1D gen_coords, const HostView1D residuals,
+        double BETA_PRIME, double GAMMA_PRIME
+    );
+
+    /// Changes the time step of the time stepper and everything that depends on it
+    void SetTimeStep(double);
+
+    /// Sizes the workspace for the provided problem dimensions, if not already sized for them
+    void PrepareWorkspace(size_t n_gen_coords, size_t n_velocities, size_t n_constraints);
+
+    /// Sizes the history of the predictor for the provided problem dimensions and the order of
+    /// the Newton policy, if not already sized for them - resizing discards the history
+    void PreparePredictor(size_t n_velocities, size_t n_constraints);
+
+    /// Adds the acceleration and Lagrange multipliers of a converged step to the history of the
+    /// predictor, newest first
+    void RecordPredictorStep(const HostView1D acceleration, const HostView1D lagrange_mults);
+
+    /// Adds the provided multiple of the solution increments of the workspace to the unknowns
+    /// of the iteration, i.e. -scale * {increments} through the Newmark relations
+    void ApplySolutionIncrements(double scale, double BETA_PRIME, double GAMMA_PRIME);
+
+    /// Returns if the iteration matrix should be updated in the provided iteration
+    bool IsJacobianUpdateRequired(
+        size_t iteration, double residual_norm, double previous_residual_norm
+    ) const;
+
+    /// Returns the L2 norm of the residual vector
+    static double CalculateResidualNorm(const HostView1D);
 };
 
 }  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,48 @@
+#include "src/rigid_pendulum_poc/generalized_alpha_workspace.h"
+
+namespace openturbine::rigid_pendulum {
+
+GeneralizedAlphaWorkspace::GeneralizedAlphaWorkspace(
+    size_t n_gen_coords, size_t n_velocities, size_t n_constraints, bool is_matrix_free
+)
+    : n_gen_coords_(n_gen_coords),
+      n_velocities_(n_velocities),
+      n_constraints_(n_constraints),
+      is_matrix_free_(is_matrix_free),
+      gen_coords_next_("workspace_gen_coords_next", n_gen_coords),
+      velocity_("workspace_velocity", n_velocities),
+      acceleration_("workspace_acceleration", n_velocities),
+      algo_acceleration_next_("workspace_algorithmic_acceleration_next", n_velocities),
+      delta_gen_coords_("workspace_gen_coords_increment", n_velocities),
+      lagrange_mults_next_("workspace_lagrange_mults_next", n_constraints),
+      soln_increments_("workspace_soln_increments", n_velocities + n_constraints),
+      residuals_("workspace_residuals", n_velocities + n_constraints),
+      iteration_matrix_(
+          "workspace_iteration_matrix", is_matrix_free ? 0 : n_velocities + n_constraints,
+          is_matrix_free ? 0 : n_velocities + n_constraints
+      ),
+      perturbed_gen_coords_("workspace_perturbed_gen_coords", is_matrix_free ? n_gen_coords : 0),
+      perturbed_delta_gen_coords_(
+          "workspace_perturbed_gen_coords_increment", is_matrix_free ? n_velocities : 0
+      ),
+      perturbed_velocity_("workspace_perturbed_velocity", is_matrix_free ? n_velocities : 0),
+      perturbed_acceleration_(
+          "workspace_perturbed_acceleration", is_matrix_free ? n_velocities : 0
+      ),
+      perturbed_lagrange_mults_(
+          "workspace_perturbed_lagrange_mults", is_matrix_free ? n_constraints : 0
+      ),
+      perturbed_residuals_(
+          "workspace_perturbed_residuals", is_matrix_free ? n_velocities + n_constraints : 0
+      ),
+      krylov_vector_("workspace_krylov_vector", is_matrix_free ? n_velocities + n_constraints : 0) {
+}
+
+bool GeneralizedAlphaWorkspace::IsSizedFor(
+    size_t n_gen_coords, size_t n_velocities, size_t n_constraints, bool is_matrix_free
+) const {
+    return n_gen_coords == n_gen_coords_ && n_velocities == n_velocities_ &&
+           n_constraints == n_constraints_ && is_matrix_free == is_matrix_free_;
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief Preallocated storage for the temporaries of a generalized-alpha time step
+ *  @details The workspace is sized once from the number of generalized coordinates,
+ *      velocities, and constraints of the problem. All per-step and per-iteration
+ *      temporaries of GeneralizedAlphaTimeIntegrator::AlphaStep() are views owned by
+ *      this object, so that the steady-state time loop performs no allocations of its own.
+ *      A matrix-free workspace does not hold the O(n^2) iteration matrix, but the perturbed
+ *      states of the finite difference Jacobian-vector products instead.
+ */
+class GeneralizedAlphaWorkspace {
+public:
+    GeneralizedAlphaWorkspace(
+        size_t n_gen_coords = 0, size_t n_velocities = 0, size_t n_constraints = 0,
+        bool is_matrix_free = false
+    );
+
+    /// Returns if the workspace has been sized for the provided problem dimensions
+    bool IsSizedFor(
+        size_t n_gen_coords, size_t n_velocities, size_t n_constraints,
+        bool is_matrix_free = false
+    ) const;
+
+    /// Returns if the workspace is for a matrix-free solve, i.e. without an iteration matrix
+    inline bool IsMatrixFree() const { return is_matrix_free_; }
+
+    /// Returns the number of generalized coordinates the workspace is sized for
+    inline size_t GetNumberOfGeneralizedCoordinates() const { return n_gen_coords_; }
+
+    /// Returns the number of velocities the workspace is sized for
+    inline size_t GetNumberOfVelocities() const { return n_velocities_; }
+
+    /// Returns the number of constraints the workspace is sized for
+    inline size_t GetNumberOfConstraints() const { return n_constraints_; }
+
+    /// Returns the size of the linear system solved in each iteration
+    inline size_t GetSystemSize() const { return n_velocities_ + n_constraints_; }
+
+    /// Returns the generalized coordinates at the end of the time step
+    inline HostView1D GetGeneralizedCoordinatesNext() const { return gen_coords_next_; }
+
+    /// Returns the velocity vector being updated during the time step
+    inline HostView1D GetVelocity() const { return velocity_; }
+
+    /// Returns the acceleration vector being updated during the time step
+    inline HostView1D GetAcceleration() const { return acceleration_; }
+
+    /// Returns the algorithmic acceleration vector at the end of the time step
+    inline HostView1D GetAlgorithmicAccelerationNext() const { return algo_acceleration_next_; }
+
+    /// Returns the increment of the generalized coordinates
+    inline HostView1D GetGeneralizedCoordinatesIncrement() const { return delta_gen_coords_; }
+
+    /// Returns the Lagrange multipliers being updated during the time step
+    inline HostView1D GetLagrangeMultipliersNext() const { return lagrange_mults_next_; }
+
+    /// Returns the right-hand side/solution vector of the linear solve
+    inline HostView1D GetSolutionIncrements() const { return soln_increments_; }
+
+    /// Returns the residual vector written by a fused linearization
+    inline HostView1D GetResiduals() const { return residuals_; }
+
+    /// Returns the iteration matrix written by a fused linearization
+    inline HostView2D GetIterationMatrix() const { return iteration_matrix_; }
+
+    /// Returns the perturbed generalized coordinates of a matrix-free iteration
+    inline HostView1D GetPerturbedGeneralizedCoordinates() const { return perturbed_gen_coords_; }
+
+    /// Returns the perturbed increment of the generalized coordinates of a matrix-free iteration
+    inline HostView1D GetPerturbedGeneralizedCoordinatesIncrement() const {
+        return perturbed_delta_gen_coords_;
+    }
+
+    /// Returns the perturbed velocity vector of a matrix-free iteration
+    inline HostView1D GetPerturbedVelocity() const { return perturbed_velocity_; }
+
+    /// Returns the perturbed acceleration vector of a matrix-free iteration
+    inline HostView1D GetPerturbedAcceleration() const { return perturbed_acceleration_; }
+
+    /// Returns the perturbed Lagrange multipliers of a matrix-free iteration
+    inline HostView1D GetPerturbedLagrangeMultipliers() const { return perturbed_lagrange_mults_; }
+
+    /// Returns the residual vector of the perturbed state of a matrix-free iteration
+    inline HostView1D GetPerturbedResiduals() const { return perturbed_residuals_; }
+
+    /// Returns the vector the iteration matrix is multiplied with in a matrix-free iteration
+    inline HostView1D GetKrylovVector() const { return krylov_vector_; }
+
+private:
+    size_t n_gen_coords_;   //< Number of generalized coordinates
+    size_t n_velocities_;   //< Number of velocities/accelerations
+    size_t n_constraints_;  //< Number of constraints/Lagrange multipliers
+    bool is_matrix_free_;   //< Flag to indicate if the workspace is for a matrix-free solve
+
+    HostView1D gen_coords_next_;             //< Generalized coordinates at the next time step
+    HostView1D velocity_;                    //< Velocity vector
+    HostView1D acceleration_;                //< Acceleration vector
+    HostView1D algo_acceleration_next_;      //< Algorithmic acceleration at the next time step
+    HostView1D delta_gen_coords_;            //< Increment of the generalized coordinates
+    HostView1D lagrange_mults_next_;         //< Lagrange multipliers at the next time step
+    HostView1D soln_increments_;             //< Right-hand side/solution of the linear solve
+    HostView1D residuals_;                   //< Residual vector of the fused linearization
+    HostView2D iteration_matrix_;            //< Iteration matrix of the fused linearization
+    HostView1D perturbed_gen_coords_;        //< Perturbed generalized coordinates
+    HostView1D perturbed_delta_gen_coords_;  //< Perturbed increment of the generalized coordinates
+    HostView1D perturbed_velocity_;          //< Perturbed velocity vector
+    HostView1D perturbed_acceleration_;      //< Perturbed acceleration vector
+    HostView1D perturbed_lagrange_mults_;    //< Perturbed Lagrange multipliers
+    HostView1D perturbed_residuals_;         //< Residual vector of the perturbed state
+    HostView1D krylov_vector_;               //< Vector multiplied with the iteration matrix
+};
+
+}  // namespace openturbine::rigid_pendulum
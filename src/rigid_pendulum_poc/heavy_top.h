@@ -1,19 +1,353 @@
 #pragma once
 
+#include <cmath>
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/invariants.h"
+#include "src/rigid_pendulum_poc/kinematics.h"
 #include "src/rigid_pendulum_poc/linearization_parameters.h"
+#include "src/rigid_pendulum_poc/matrix.h"
 #include "src/rigid_pendulum_poc/state.h"
 #include "src/rigid_pendulum_poc/utilities.h"
 
 namespace openturbine::rigid_pendulum {
 
+/*! @brief Residual vector and iteration matrix of the heavy top problem on fixed-size types
+ *  @details All quantities are compile-time sized Vec/Matrix values, so that a heavy top can be
+ *      evaluated without any heap allocation, and from inside Kokkos kernels (e.g. one top per
+ *      thread/team)
+ */
+class HeavyTop {
+public:
+    static constexpr size_t kNumberOfGeneralizedCoordinates = 7;
+    static constexpr size_t kNumberOfVelocities = 6;
+    static constexpr size_t kNumberOfConstraints = 3;
+    static constexpr size_t kSystemSize = kNumberOfVelocities + kNumberOfConstraints;
+
+    /// Constructs a heavy top with the properties used by Brüls and Cardona (2010)
+    KOKKOS_INLINE_FUNCTION constexpr HeavyTop(
+        double mass = 15.,
+        Vec<3> principal_moment_of_inertia = Vec<3>{{0.234375, 0.46875, 0.234375}},
+        Vec<3> reference_position = Vec<3>{{0., 1., 0.}}, Vec<3> gravity = Vec<3>{{0., 0., 9.81}}
+    )
+        : mass_(mass),
+          principal_moment_of_inertia_(principal_moment_of_inertia),
+          reference_position_(reference_position),
+          gravity_(gravity) {}
+
+    /// Returns the mass of the top
+    KOKKOS_INLINE_FUNCTION constexpr double GetMass() const { return mass_; }
+
+    /// Returns the reference position vector {X} of the center of mass
+    KOKKOS_INLINE_FUNCTION constexpr Vec<3> GetReferencePosition() const {
+        return reference_position_;
+    }
+
+    /// Returns the 3 x 3 moment of inertia matrix [J]
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<3, 3> GetMomentOfInertiaMatrix() const {
+        return Matrix<3, 3>::Diagonal(principal_moment_of_inertia_);
+    }
+
+    /// Returns the 6 x 6 mass matrix [M] = diag(m, m, m, J)
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<6, 6> GetMassMatrix() const {
+        return Matrix<6, 6>::Diagonal(Vec<6>{
+            {mass_, mass_, mass_, principal_moment_of_inertia_(0), principal_moment_of_inertia_(1),
+             principal_moment_of_inertia_(2)}});
+    }
+
+    /// Calculates the rotation matrix from the quaternion stored in the generalized coordinates
+    KOKKOS_INLINE_FUNCTION static constexpr Matrix<3, 3> CalculateRotationMatrix(
+        const Vec<7>& gen_coords
+    ) {
+        return calculate_rotation_matrix(gen_coords);
+    }
+
+    /// Calculates the generalized forces as defined in Brüls and Cardona (2010)
+    KOKKOS_INLINE_FUNCTION constexpr Vec<6> CalculateForces(const Vec<6>& velocity) const {
+        const auto forces = gravity_ * mass_;
+        const auto angular_velocity = velocity.GetSegment<3>(3);
+        const auto moments =
+            angular_velocity.CrossProduct(GetMomentOfInertiaMatrix() * angular_velocity);
+
+        auto generalized_forces = Vec<6>{};
+        generalized_forces.SetSegment(0, forces);
+        generalized_forces.SetSegment(3, moments);
+        return generalized_forces;
+    }
+
+    /*! @brief Calculates the invariants of the top at the provided state
+     *  @details The total energy is 1/2 m {v}^T {v} + 1/2 {W}^T [J] {W} + m {g}^T {x}, i.e. with
+     *      the angular velocity {W} in the body frame and the potential of the gravity forces
+     *      -m {g}. The angular momentum is the component along gravity of {x} x m {v} + [R] [J]
+     *      {W} about the fixed point, whose moment of the gravity forces vanishes.
+     */
+    KOKKOS_INLINE_FUNCTION RigidBodyInvariants CalculateInvariants(
+        const Vec<7>& gen_coords, const Vec<6>& velocity
+    ) const {
+        const auto rotation_matrix = CalculateRotationMatrix(gen_coords);
+        const auto position = gen_coords.GetSegment<3>(0);
+        const auto linear_velocity = velocity.GetSegment<3>(0);
+        const auto angular_velocity = velocity.GetSegment<3>(3);
+        const auto inertia_matrix = GetMomentOfInertiaMatrix();
+
+        auto invariants = RigidBodyInvariants{};
+        invariants.total_energy =
+            0.5 * mass_ * linear_velocity.DotProduct(linear_velocity) +
+            0.5 * angular_velocity.DotProduct(inertia_matrix * angular_velocity) +
+            mass_ * gravity_.DotProduct(position);
+        const auto angular_momentum =
+            position.CrossProduct(linear_velocity * mass_) +
+            rotation_matrix * (inertia_matrix * angular_velocity);
+        const auto gravity_norm = gravity_.Length();
+        invariants.angular_momentum =
+            (gravity_norm > 0.) ? angular_momentum.DotProduct(gravity_) / gravity_norm : 0.;
+        invariants.quaternion_norm_drift = calculate_quaternion_norm_drift(gen_coords);
+        invariants.constraint_violation =
+            ConstraintsResidualVector(rotation_matrix, position, reference_position_).Length();
+        return invariants;
+    }
+
+    /// Calculates the generalized coordinates residual vector
+    KOKKOS_INLINE_FUNCTION static constexpr Vec<6> GeneralizedCoordinatesResidualVector(
+        const Matrix<6, 6>& mass_matrix, const Matrix<3, 3>& rotation_matrix,
+        const Vec<6>& acceleration_vector, const Vec<6>& gen_forces_vector,
+        const Vec<3>& lagrange_multipliers, const Vec<3>& reference_position_vector
+    ) {
+        // {residual_gen_coords} = [M(q)] {v'} + {g(q,v,t)} + [B(q)]T {Lambda}
+        const auto constraint_gradient_matrix =
+            ConstraintsGradientMatrix(rotation_matrix, reference_position_vector);
+        return mass_matrix * acceleration_vector + gen_forces_vector +
+               constraint_gradient_matrix.GetTranspose() * lagrange_multipliers;
+    }
+
+    /// Calculates the constraint residual vector
+    KOKKOS_INLINE_FUNCTION static constexpr Vec<3> ConstraintsResidualVector(
+        const Matrix<3, 3>& rotation_matrix, const Vec<3>& position_vector,
+        const Vec<3>& reference_position_vector
+    ) {
+        // {residual_constraints} = -{x} + [R] {X}
+        return rotation_matrix * reference_position_vector - position_vector;
+    }
+
+    /// Calculates the constraint gradient matrix
+    KOKKOS_INLINE_FUNCTION static constexpr Matrix<3, 6> ConstraintsGradientMatrix(
+        const Matrix<3, 3>& rotation_matrix, const Vec<3>& reference_position_vector
+    ) {
+        // [B] = [ -I_3x3    -[R ~{X}] ]
+        auto constraint_gradient_matrix = Matrix<3, 6>{};
+        constraint_gradient_matrix.SetBlock(0, 0, -Matrix<3, 3>::Identity());
+        constraint_gradient_matrix.SetBlock(
+            0, 3, -(rotation_matrix * create_cross_product_matrix(reference_position_vector))
+        );
+        return constraint_gradient_matrix;
+    }
+
+    /// Calculates the tangent damping matrix
+    KOKKOS_INLINE_FUNCTION static constexpr Matrix<6, 6> TangentDampingMatrix(
+        const Vec<3>& angular_velocity_vector, const Matrix<3, 3>& inertia_matrix
+    ) {
+        // [C_t] = [ [0]_3x3                     [0]_3x3
+        //           [0]_3x3    [ ~{OMEGA}] * [J] - ~([J] * {OMEGA}) ]
+        auto tangent_damping_matrix = Matrix<6, 6>{};
+        tangent_damping_matrix.SetBlock(
+            3, 3,
+            create_cross_product_matrix(angular_velocity_vector) * inertia_matrix -
+                create_cross_product_matrix(inertia_matrix * angular_velocity_vector)
+        );
+        return tangent_damping_matrix;
+    }
+
+    /// Calculates the tangent stiffness matrix
+    KOKKOS_INLINE_FUNCTION static constexpr Matrix<6, 6> TangentStiffnessMatrix(
+        const Matrix<3, 3>& rotation_matrix, const Vec<3>& lagrange_multipliers,
+        const Vec<3>& reference_position_vector
+    ) {
+        // [K_t] = [ [0]_3x3              [0]_3x3
+        //           [0]_3x3    [ ~{X} * ~([R^T] * {Lambda}) ] ]
+        auto tangent_stiffness_matrix = Matrix<6, 6>{};
+        tangent_stiffness_matrix.SetBlock(
+            3, 3,
+            create_cross_product_matrix(reference_position_vector) *
+                create_cross_product_matrix(rotation_matrix.GetTranspose() * lagrange_multipliers)
+        );
+        return tangent_stiffness_matrix;
+    }
+
+    /// Calculates the tangent operator [T(psi)] of the rotational increment psi
+    KOKKOS_INLINE_FUNCTION static Matrix<6, 6> TangentOperator(const Vec<3>& psi) {
+        return calculate_tangent_operator(psi, create_cross_product_matrix(psi));
+    }
+
+    /// Calculates the residual vector of the heavy top problem
+    KOKKOS_INLINE_FUNCTION constexpr Vec<kSystemSize> ResidualVector(
+        const Vec<7>& gen_coords, const Vec<6>& velocity, const Vec<6>& acceleration,
+        const Vec<3>& lagrange_multipliers
+    ) const {
+        auto kinematics = RigidBodyKinematics{};
+        kinematics.rotation_matrix = CalculateRotationMatrix(gen_coords);
+        return ResidualVector(kinematics, gen_coords, velocity, acceleration, lagrange_multipliers);
+    }
+
+    /// Calculates the residual vector of the heavy top problem from the kinematics of the
+    /// generalized coordinates, i.e. only their rotation matrix is used
+    KOKKOS_INLINE_FUNCTION constexpr Vec<kSystemSize> ResidualVector(
+        const RigidBodyKinematics& kinematics, const Vec<7>& gen_coords, const Vec<6>& velocity,
+        const Vec<6>& acceleration, const Vec<3>& lagrange_multipliers
+    ) const {
+        // {residual} = {
+        //     {residual_gen_coords},
+        //     {residual_constraints}
+        // }
+        const auto& rotation_matrix = kinematics.rotation_matrix;
+
+        auto residual_vector = Vec<kSystemSize>{};
+        residual_vector.SetSegment(
+            0, GeneralizedCoordinatesResidualVector(
+                   GetMassMatrix(), rotation_matrix, acceleration, CalculateForces(velocity),
+                   lagrange_multipliers, reference_position_
+               )
+        );
+        residual_vector.SetSegment(
+            kNumberOfVelocities,
+            ConstraintsResidualVector(
+                rotation_matrix, gen_coords.GetSegment<3>(0), reference_position_
+            )
+        );
+        return residual_vector;
+    }
+
+    /// Calculates the iteration matrix of the heavy top problem
+    KOKKOS_INLINE_FUNCTION Matrix<kSystemSize, kSystemSize> IterationMatrix(
+        double h, double BETA_PRIME, double GAMMA_PRIME, const Vec<7>& gen_coords,
+        const Vec<6>& delta_gen_coords, const Vec<6>& velocity, const Vec<3>& lagrange_mults
+    ) const {
+        return IterationMatrix(
+            BETA_PRIME, GAMMA_PRIME,
+            RigidBodyKinematics::Calculate(gen_coords, delta_gen_coords.GetSegment<3>(3) * h),
+            velocity, lagrange_mults
+        );
+    }
+
+    /// Calculates the iteration matrix of the heavy top problem from the kinematics of the
+    /// generalized coordinates and their rotational increment h * dq
+    KOKKOS_INLINE_FUNCTION Matrix<kSystemSize, kSystemSize> IterationMatrix(
+        double BETA_PRIME, double GAMMA_PRIME, const RigidBodyKinematics& kinematics,
+        const Vec<6>& velocity, const Vec<3>& lagrange_mults
+    ) const {
+        // [iteration matrix] = [
+        //     [M(q)] * beta' + [C_t(q,v,t)] * gamma' + [K_t(q,v,v',Lambda,t)] * [T(h dq)]  [B(q)^T]
+        //                         [ B(q) ] * [T(h dq)]                                       [0]
+        // ]
+        const auto& rotation_matrix = kinematics.rotation_matrix;
+        const auto& tangent_operator = kinematics.tangent_operator;
+        const auto tangent_damping_matrix =
+            TangentDampingMatrix(velocity.GetSegment<3>(3), GetMomentOfInertiaMatrix());
+        const auto tangent_stiffness_matrix =
+            TangentStiffnessMatrix(rotation_matrix, lagrange_mults, reference_position_);
+        const auto constraint_gradient_matrix =
+            ConstraintsGradientMatrix(rotation_matrix, reference_position_);
+
+        auto iteration_matrix = Matrix<kSystemSize, kSystemSize>{};
+        iteration_matrix.SetBlock(
+            0, 0,
+            GetMassMatrix() * BETA_PRIME + tangent_damping_matrix * GAMMA_PRIME +
+                tangent_stiffness_matrix * tangent_operator
+        );
+        iteration_matrix.SetBlock(0, kNumberOfVelocities, constraint_gradient_matrix.GetTranspose());
+        iteration_matrix.SetBlock(
+            kNumberOfVelocities, 0, constraint_gradient_matrix * tangent_operator
+        );
+        return iteration_matrix;
+    }
+
+    /*! @brief Calculates the residual vector and, if requested, the iteration matrix of the heavy
+     *      top problem
+     *  @details Equivalent to ResidualVector() and IterationMatrix(), but the rotation matrix,
+     *      the constraint gradient matrix, and the mass matrix are evaluated only once for both
+     */
+    KOKKOS_INLINE_FUNCTION void Linearize(
+        double h, double BETA_PRIME, double GAMMA_PRIME, const Vec<7>& gen_coords,
+        const Vec<6>& delta_gen_coords, const Vec<6>& velocity, const Vec<6>& acceleration,
+        const Vec<3>& lagrange_mults, Vec<kSystemSize>& residual_vector,
+        bool is_iteration_matrix_required, Matrix<kSystemSize, kSystemSize>& iteration_matrix
+    ) const {
+        // The tangent operator of a zero increment is the identity, i.e. is not evaluated
+        const auto kinematics = RigidBodyKinematics::Calculate(
+            gen_coords,
+            is_iteration_matrix_required ? delta_gen_coords.GetSegment<3>(3) * h : Vec<3>{}
+        );
+        Linearize(
+            BETA_PRIME, GAMMA_PRIME, kinematics, gen_coords, velocity, acceleration,
+            lagrange_mults, residual_vector, is_iteration_matrix_required, iteration_matrix
+        );
+    }
+
+    /// Calculates the residual vector and, if requested, the iteration matrix of the heavy top
+    /// problem from the kinematics of the generalized coordinates and their rotational increment
+    KOKKOS_INLINE_FUNCTION void Linearize(
+        double BETA_PRIME, double GAMMA_PRIME, const RigidBodyKinematics& kinematics,
+        const Vec<7>& gen_coords, const Vec<6>& velocity, const Vec<6>& acceleration,
+        const Vec<3>& lagrange_mults, Vec<kSystemSize>& residual_vector,
+        bool is_iteration_matrix_required, Matrix<kSystemSize, kSystemSize>& iteration_matrix
+    ) const {
+        const auto& rotation_matrix = kinematics.rotation_matrix;
+        const auto constraint_gradient_matrix =
+            ConstraintsGradientMatrix(rotation_matrix, reference_position_);
+        const auto constraint_gradient_matrix_transpose = constraint_gradient_matrix.GetTranspose();
+        const auto mass_matrix = GetMassMatrix();
+
+        residual_vector.SetSegment(
+            0, mass_matrix * acceleration + CalculateForces(velocity) +
+                   constraint_gradient_matrix_transpose * lagrange_mults
+        );
+        residual_vector.SetSegment(
+            kNumberOfVelocities,
+            ConstraintsResidualVector(
+                rotation_matrix, gen_coords.GetSegment<3>(0), reference_position_
+            )
+        );
+
+        if (!is_iteration_matrix_required) {
+            return;
+        }
+
+        const auto tangent_damping_matrix =
+            TangentDampingMatrix(velocity.GetSegment<3>(3), GetMomentOfInertiaMatrix());
+        const auto tangent_stiffness_matrix =
+            TangentStiffnessMatrix(rotation_matrix, lagrange_mults, reference_position_);
+        const auto& tangent_operator = kinematics.tangent_operator;
+
+        iteration_matrix.SetBlock(
+            0, 0,
+            mass_matrix * BETA_PRIME + tangent_damping_matrix * GAMMA_PRIME +
+                tangent_stiffness_matrix * tangent_operator
+        );
+        iteration_matrix.SetBlock(0, kNumberOfVelocities, constraint_gradient_matrix_transpose);
+        iteration_matrix.SetBlock(
+            kNumberOfVelocities, 0, constraint_gradient_matrix * tangent_operator
+        );
+        iteration_matrix.SetBlock(
+            kNumberOfVelocities, kNumberOfVelocities,
+            Matrix<kNumberOfConstraints, kNumberOfConstraints>{}
+        );
+    }
+
+private:
+    double mass_;                         //< Mass of the top
+    Vec<3> principal_moment_of_inertia_;  //< Principal moments of inertia about the center of mass
+    Vec<3> reference_position_;           //< Reference position of the center of mass
+    Vec<3> gravity_;                      //< Gravity vector
+};
+
 /*! Calculates the residual vector and iteration matrix for the heavy top problem from Brüls and
  * Cardona (2010) "On the use of Lie group time integrators in multibody dynamics," 2010, Journal
  * of Computational and Nonlinear Dynamics, Vol 5.
  * Ref: https://doi.org/10.1115/1.4001370
  */
-class HeavyTopLinearizationParameters : public LinearizationParameters {
+class HeavyTopLinearizationParameters final : public LinearizationParameters {
 public:
-    HeavyTopLinearizationParameters();
+    HeavyTopLinearizationParameters(HeavyTop heavy_top = HeavyTop());
 
     virtual HostView1D ResidualVector(
         const HostView1D, const HostView1D, const HostView1D, const HostView1D
@@ -24,6 +358,37 @@ public:
         const HostView1D, const HostView1D, const HostView1D
     ) override;
 
+    /// Returns true, since the heavy top shares the kinematics of both evaluations
+    inline bool IsLinearizeFused() const override { return true; }
+
+    virtual void Linearize(
+        const double&, const double&, const double&, const HostView1D, const HostView1D,
+        const HostView1D, const HostView1D, const HostView1D, HostView1D, bool, HostView2D
+    ) override;
+
+    /// Returns true once a view of external loads has been registered
+    inline bool HasExternalLoads() const override { return external_loads_.extent(0) > 0; }
+
+    /// Registers a view of the 6 generalized external loads, i.e. the forces in the inertial
+    /// frame and the moments in the body frame about the center of mass, or an empty view for none
+    void SetExternalLoads(const HostView1D) override;
+
+    /// Returns the registered view of the external loads
+    inline HostView1D GetExternalLoads() const { return external_loads_; }
+
+    /// Returns true, since the heavy top conserves its energy and its angular momentum about
+    /// the axis of gravity
+    inline bool HasInvariants() const override { return true; }
+
+    /// Calculates the invariants of the single body of the heavy top
+    void CalculateInvariants(
+        const HostView1D gen_coords, const HostView1D velocity,
+        RigidBodyInvariantsView1D<Kokkos::HostSpace> invariants
+    ) override;
+
+    /// Returns the heavy top model evaluated by these linearization parameters
+    inline const HeavyTop& GetHeavyTop() const { return heavy_top_; }
+
     /// Calculates the generalized coordinates residual vector for the heavy top problem
     HostView1D GeneralizedCoordinatesResidualVector(
         const HostView2D, const HostView2D, const HostView1D, const HostView1D, const HostView1D,
@@ -50,11 +415,19 @@ public:
 
     HostView2D TangentOperator(const HostView1D psi);
 
+    /// Returns the kinematics of the latest evaluated iterate
+    inline const KinematicsCache& GetKinematicsCache() const { return kinematics_cache_; }
+
 private:
-    MassMatrix mass_matrix_;
+    HeavyTop heavy_top_;
+    KinematicsCache kinematics_cache_;  //< Kinematics shared by the evaluations of an iterate
+    HostView1D external_loads_;         //< Generalized external loads, empty for none
+
+    /// Throws if the quaternion in the generalized coordinates is not a unit quaternion
+    void CheckOrientation(const HostView1D);
 
-    HostView2D CalculateRotationMatrix(const HostView1D);
-    HostView1D CalculateForces(MassMatrix, const HostView1D);
+    /// Subtracts the external loads, if any, from the generalized coordinates residual vector
+    void SubtractExternalLoads(Vec<HeavyTop::kSystemSize>& residual_vector) const;
 };
 
 }  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <limits>
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "src/rigid_pendulum_poc/time_stepper.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// The invariants of a body at one instant, i.e. the quantities a long time integration should
+/// conserve, or keep at zero in the case of the drift and the violation
+struct RigidBodyInvariants {
+    double total_energy = 0.;           //< Kinetic plus potential energy
+    double angular_momentum = 0.;       //< Component of the angular momentum about a conserved axis
+    double quaternion_norm_drift = 0.;  //< Deviation of the norm of the quaternion from one
+    double constraint_violation = 0.;   //< Norm of the constraint residual vector
+};
+
+/// A 1D Kokkos view of the invariants of the bodies, in the provided memory space
+template <typename MemorySpace>
+using RigidBodyInvariantsView1D = Kokkos::View<RigidBodyInvariants*, MemorySpace>;
+
+/// Returns the deviation of the norm of the quaternion in the provided generalized coordinates
+/// from one
+KOKKOS_INLINE_FUNCTION double calculate_quaternion_norm_drift(const Vec<7>& gen_coords) {
+    const auto norm = gen_coords.GetSegment<4>(3).Length();
+    return (norm > 1.) ? norm - 1. : 1. - norm;
+}
+
+/// Scales the quaternion in the provided generalized coordinates to unit norm
+KOKKOS_INLINE_FUNCTION void renormalize_quaternion(Vec<7>& gen_coords) {
+    gen_coords.SetSegment(3, gen_coords.GetSegment<4>(3) / gen_coords.GetSegment<4>(3).Length());
+}
+
+/*! @brief Running statistics of the invariants of one body, e.g. one body of a model or one
+ *      member of an ensemble, over the time steps of an integration
+ *  @details The statistics are accumulated while the time integration runs, so that energy
+ *      drift, momentum drift, quaternion drift, and constraint violation of a long run are known
+ *      without storing or post-processing its states, e.g. the energy drift is max - min.
+ */
+struct InvariantDiagnostics {
+    RunningStatistics total_energy;           //< Statistics of the total energy
+    RunningStatistics angular_momentum;       //< Statistics of the conserved angular momentum
+    RunningStatistics quaternion_norm_drift;  //< Statistics of the quaternion norm drift
+    RunningStatistics constraint_violation;   //< Statistics of the constraint violation
+    size_t n_renormalizations = 0;            //< Number of quaternion renormalizations
+
+    /// Adds the provided invariants of one time step to the statistics
+    KOKKOS_INLINE_FUNCTION void Accumulate(const RigidBodyInvariants& invariants) {
+        total_energy.Add(invariants.total_energy);
+        angular_momentum.Add(invariants.angular_momentum);
+        quaternion_norm_drift.Add(invariants.quaternion_norm_drift);
+        constraint_violation.Add(invariants.constraint_violation);
+    }
+};
+
+/// A 1D Kokkos view of the diagnostics of the bodies, in the provided memory space
+template <typename MemorySpace>
+using InvariantDiagnosticsView1D = Kokkos::View<InvariantDiagnostics*, MemorySpace>;
+
+/// Policy of the invariant diagnostics accumulated during a time integration
+struct DiagnosticsPolicy {
+    bool is_enabled = false;  //< Flag to accumulate the invariants of every time step
+
+    /// Quaternion norm drift beyond which the quaternions are renormalized, i.e. never by default
+    double renormalization_threshold = std::numeric_limits<double>::infinity();
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,122 @@
+#include "src/rigid_pendulum_poc/kinematics.h"
+
+#include <stdexcept>
+
+#include "src/rigid_pendulum_poc/execution_policy.h"
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+constexpr size_t kCOORDINATES = 7;
+constexpr size_t kVELOCITIES = 6;
+
+/// Returns if the provided views hold the same values
+bool is_equal(const HostView1D a, const HostView1D b) {
+    if (a.extent(0) != b.extent(0)) {
+        return false;
+    }
+    for (size_t i = 0; i < a.extent(0); ++i) {
+        if (a(i) != b(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+KinematicsCache& KinematicsCache::operator=(const KinematicsCache& other) {
+    if (this != &other) {
+        this->kinematics_ = KinematicsView();
+        this->gen_coords_ = HostView1D();
+        this->rotation_increments_ = HostView1D();
+        this->n_rotation_evaluations_ = 0;
+        this->n_tangent_evaluations_ = 0;
+        this->Invalidate();
+    }
+    return *this;
+}
+
+void KinematicsCache::Resize(size_t n_bodies) {
+    if (kinematics_.extent(0) == n_bodies && gen_coords_.extent(0) == n_bodies * kCOORDINATES) {
+        return;
+    }
+    this->kinematics_ = KinematicsView("kinematics", n_bodies);
+    this->gen_coords_ = HostView1D("kinematics_gen_coords", n_bodies * kCOORDINATES);
+    this->rotation_increments_ = HostView1D("kinematics_rotation_increments", n_bodies * 3);
+    this->Invalidate();
+}
+
+void KinematicsCache::Invalidate() {
+    this->is_rotation_valid_ = false;
+    this->is_tangent_valid_ = false;
+}
+
+KinematicsCache::KinematicsView KinematicsCache::Update(const HostView1D gen_coords) {
+    if (gen_coords.extent(0) % kCOORDINATES != 0) {
+        throw std::invalid_argument("gen_coords must be of size 7 per rigid body");
+    }
+    this->Resize(gen_coords.extent(0) / kCOORDINATES);
+    if (is_rotation_valid_ && is_equal(gen_coords, gen_coords_)) {
+        return kinematics_;
+    }
+
+    Kokkos::deep_copy(gen_coords_, gen_coords);
+    const auto kinematics = kinematics_;
+    host_parallel_for(
+        "kinematics_rotation_matrices", kinematics.extent(0),
+        KOKKOS_LAMBDA(const size_t body) {
+            auto q = Vec<kCOORDINATES>{};
+            for (size_t i = 0; i < kCOORDINATES; ++i) {
+                q(i) = gen_coords(body * kCOORDINATES + i);
+            }
+            kinematics(body).rotation_matrix = calculate_rotation_matrix(q);
+        }
+    );
+    this->is_rotation_valid_ = true;
+    this->n_rotation_evaluations_++;
+    return kinematics_;
+}
+
+KinematicsCache::KinematicsView KinematicsCache::Update(
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, double h
+) {
+    this->Update(gen_coords);
+    const auto n_bodies = kinematics_.extent(0);
+    if (delta_gen_coords.extent(0) != n_bodies * kVELOCITIES) {
+        throw std::invalid_argument("delta_gen_coords must be of size 6 per rigid body");
+    }
+
+    // The tangent operators only depend on the rotational increments psi = h * dq
+    auto is_tangent_valid = is_tangent_valid_;
+    for (size_t body = 0; body < n_bodies; ++body) {
+        for (size_t i = 0; i < 3; ++i) {
+            const auto psi = delta_gen_coords(body * kVELOCITIES + 3 + i) * h;
+            is_tangent_valid = is_tangent_valid && rotation_increments_(body * 3 + i) == psi;
+            rotation_increments_(body * 3 + i) = psi;
+        }
+    }
+    if (is_tangent_valid) {
+        return kinematics_;
+    }
+
+    const auto kinematics = kinematics_;
+    const auto rotation_increments = rotation_increments_;
+    host_parallel_for(
+        "kinematics_tangent_operators", n_bodies,
+        KOKKOS_LAMBDA(const size_t body) {
+            const auto psi = Vec<3>{
+                {rotation_increments(body * 3), rotation_increments(body * 3 + 1),
+                 rotation_increments(body * 3 + 2)}};
+            kinematics(body).rotation_increment_matrix = create_cross_product_matrix(psi);
+            kinematics(body).tangent_operator =
+                calculate_tangent_operator(psi, kinematics(body).rotation_increment_matrix);
+        }
+    );
+    this->is_tangent_valid_ = true;
+    this->n_tangent_evaluations_++;
+    return kinematics_;
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "src/rigid_pendulum_poc/quaternion.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// Calculates the rotation matrix from the quaternion stored in the generalized coordinates of a
+/// rigid body, i.e. entries 3 to 6
+KOKKOS_INLINE_FUNCTION constexpr Matrix<3, 3> calculate_rotation_matrix(const Vec<7>& gen_coords) {
+    const auto q0 = gen_coords(3);
+    const auto q1 = gen_coords(4);
+    const auto q2 = gen_coords(5);
+    const auto q3 = gen_coords(6);
+    return Matrix<3, 3>{
+        {{q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3, 2. * (q1 * q2 - q0 * q3),
+          2. * (q1 * q3 + q0 * q2)},
+         {2. * (q1 * q2 + q0 * q3), q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3,
+          2. * (q2 * q3 - q0 * q1)},
+         {2. * (q1 * q3 - q0 * q2), 2. * (q2 * q3 + q0 * q1),
+          q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3}}};
+}
+
+/// Calculates the tangent operator [T(psi)] of the rotational increment psi from its cross
+/// product matrix ~{psi}, see ExponentialMapCoefficients
+KOKKOS_INLINE_FUNCTION Matrix<6, 6> calculate_tangent_operator(
+    const Vec<3>& psi, const Matrix<3, 3>& psi_matrix
+) {
+    const auto c = calculate_exponential_map_coefficients(psi.DotProduct(psi));
+
+    auto tangent_operator = Matrix<6, 6>::Identity();
+    tangent_operator.SetBlock(
+        3, 3,
+        Matrix<3, 3>::Identity() + psi_matrix * c.cos_coefficient +
+            (psi_matrix * psi_matrix) * c.sin_coefficient
+    );
+    return tangent_operator;
+}
+
+/*! @brief The kinematic quantities of a rigid body at a Newton-Raphson iterate, i.e. everything
+ *      that only depends on its generalized coordinates and their rotational increment
+ *  @details Evaluated once per iterate and shared by the residual vector and the iteration
+ *      matrix, and by all elements attached to the body, instead of being rebuilt from the
+ *      quaternion and the increment by every evaluation
+ */
+struct RigidBodyKinematics {
+    Matrix<3, 3> rotation_matrix;            //< [R] of the orientation quaternion
+    Matrix<3, 3> rotation_increment_matrix;  //< Cross product matrix ~{psi} of the increment
+    Matrix<6, 6> tangent_operator;           //< Tangent operator [T(psi)] of the increment
+
+    /// Evaluates the kinematics of the provided generalized coordinates and rotational
+    /// increment psi, i.e. h times the angular part of the increment of the coordinates
+    KOKKOS_INLINE_FUNCTION static RigidBodyKinematics Calculate(
+        const Vec<7>& gen_coords, const Vec<3>& psi = Vec<3>{}
+    ) {
+        auto kinematics = RigidBodyKinematics{};
+        kinematics.rotation_matrix = calculate_rotation_matrix(gen_coords);
+        kinematics.rotation_increment_matrix = create_cross_product_matrix(psi);
+        kinematics.tangent_operator =
+            calculate_tangent_operator(psi, kinematics.rotation_increment_matrix);
+        return kinematics;
+    }
+
+    /// Evaluates the kinematics of the provided generalized coordinates and rotational
+    /// increment psi, reusing the tangent operator of the provided exponential map of psi, e.g.
+    /// the one that updated the generalized coordinates
+    KOKKOS_INLINE_FUNCTION static RigidBodyKinematics Calculate(
+        const Vec<7>& gen_coords, const Vec<3>& psi, const ExponentialMap& exponential_map
+    ) {
+        auto kinematics = RigidBodyKinematics{};
+        kinematics.rotation_matrix = calculate_rotation_matrix(gen_coords);
+        kinematics.rotation_increment_matrix = create_cross_product_matrix(psi);
+        kinematics.tangent_operator = Matrix<6, 6>::Identity();
+        kinematics.tangent_operator.SetBlock(3, 3, exponential_map.tangent_operator);
+        return kinematics;
+    }
+};
+
+/*! @brief Lazily evaluated kinematics of all rigid bodies of a Newton-Raphson iterate
+ *  @details The rotation matrices are evaluated from the generalized coordinates (7 per body) and
+ *      the tangent operators from the increments of the coordinates (6 per body) - each only if
+ *      the coordinates or increments differ from the ones of its latest evaluation, so that
+ *      evaluating the residual vector and the iteration matrix of the same iterate separately
+ *      builds the rotation matrices and tangent operators once. Comparing the iterate with the
+ *      evaluated one also covers coordinates that were written through views, i.e. the cache
+ *      never has to be invalidated by hand.
+ */
+class KinematicsCache {
+public:
+    using KinematicsView = Kokkos::View<RigidBodyKinematics*, Kokkos::HostSpace>;
+
+    KinematicsCache() = default;
+
+    /// Copies start out empty, so that copies of a model or state never share (and invalidate)
+    /// each other's evaluated kinematics
+    KinematicsCache(const KinematicsCache&) {}
+    KinematicsCache& operator=(const KinematicsCache&);
+
+    /// Returns the kinematics of the bodies of the provided generalized coordinates - only the
+    /// rotation matrices are up to date, e.g. for the residual vector
+    KinematicsView Update(const HostView1D gen_coords);
+
+    /// Returns the kinematics of the bodies of the provided generalized coordinates and their
+    /// increments, i.e. including the tangent operators of the rotational increments h * dq
+    KinematicsView Update(const HostView1D gen_coords, const HostView1D delta_gen_coords, double h);
+
+    /// Discards the evaluated kinematics, i.e. the next update evaluates them in any case
+    void Invalidate();
+
+    /// Returns the number of evaluations of the rotation matrices thus far
+    inline size_t GetNumberOfRotationEvaluations() const { return n_rotation_evaluations_; }
+
+    /// Returns the number of evaluations of the tangent operators thus far
+    inline size_t GetNumberOfTangentEvaluations() const { return n_tangent_evaluations_; }
+
+private:
+    KinematicsView kinematics_;          //< Kinematics of all bodies
+    HostView1D gen_coords_;              //< Generalized coordinates of the rotation matrices
+    HostView1D rotation_increments_;     //< Rotational increments of the tangent operators
+    bool is_rotation_valid_ = false;     //< Flag to indicate if the rotation matrices are valid
+    bool is_tangent_valid_ = false;      //< Flag to indicate if the tangent operators are valid
+    size_t n_rotation_evaluations_ = 0;  //< Number of evaluations of the rotation matrices
+    size_t n_tangent_evaluations_ = 0;   //< Number of evaluations of the tangent operators
+
+    /// Sizes the cache for the provided number of bodies, which invalidates it if it changes
+    void Resize(size_t n_bodies);
+};
+
+}  // namespace openturbine::rigid_pendulum
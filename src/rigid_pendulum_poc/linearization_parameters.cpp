@@ -1,7 +1,66 @@
 #include "src/rigid_pendulum_poc/linearization_parameters.h"
 
+#include <stdexcept>
+
 namespace openturbine::rigid_pendulum {
 
+void LinearizationParameters::Linearize(
+    const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+    const HostView1D acceleration, const HostView1D lagrange_mults, HostView1D residual_vector,
+    bool is_iteration_matrix_required, HostView2D iteration_matrix
+) {
+    Kokkos::deep_copy(
+        residual_vector, this->ResidualVector(gen_coords, velocity, acceleration, lagrange_mults)
+    );
+    if (is_iteration_matrix_required) {
+        Kokkos::deep_copy(
+            iteration_matrix,
+            this->IterationMatrix(
+                h, BETA_PRIME, GAMMA_PRIME, gen_coords, delta_gen_coords, velocity, acceleration,
+                lagrange_mults
+            )
+        );
+    }
+}
+
+BlockSparseMatrix LinearizationParameters::SparseIterationMatrix(
+    const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+    const HostView1D acceleration, const HostView1D lagrange_mults
+) {
+    auto iteration_matrix = this->IterationMatrix(
+        h, BETA_PRIME, GAMMA_PRIME, gen_coords, delta_gen_coords, velocity, acceleration,
+        lagrange_mults
+    );
+    return BlockSparseMatrix::FromDense(
+        iteration_matrix, create_multibody_block_sizes(velocity.size(), lagrange_mults.size())
+    );
+}
+
+void LinearizationParameters::JacobianVectorProduct(
+    const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+    const HostView1D acceleration, const HostView1D lagrange_mults, const HostView1D vector,
+    HostView1D product
+) {
+    const auto iteration_matrix = this->SparseIterationMatrix(
+        h, BETA_PRIME, GAMMA_PRIME, gen_coords, delta_gen_coords, velocity, acceleration,
+        lagrange_mults
+    );
+    Kokkos::deep_copy(product, iteration_matrix.Multiply(vector));
+}
+
+void LinearizationParameters::SetExternalLoads(const HostView1D) {
+    throw std::runtime_error("The problem does not support external loads");
+}
+
+void LinearizationParameters::CalculateInvariants(
+    const HostView1D, const HostView1D, RigidBodyInvariantsView1D<Kokkos::HostSpace>
+) {
+    throw std::runtime_error("The problem does not define any invariants");
+}
+
 HostView1D UnityLinearizationParameters::ResidualVector(
     [[maybe_unused]] const HostView1D gen_coords, [[maybe_unused]] const HostView1D velocity,
     const HostView1D acceleration, const HostView1D lagrange_mults
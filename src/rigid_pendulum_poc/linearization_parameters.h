@@ -1,5 +1,7 @@
 #pragma once
 
+#include "src/rigid_pendulum_poc/block_sparse_matrix.h"
+#include "src/rigid_pendulum_poc/invariants.h"
 #include "src/rigid_pendulum_poc/utilities.h"
 
 namespace openturbine::rigid_pendulum {
@@ -17,10 +19,82 @@ public:
         const double&, const double&, const double&, const HostView1D, const HostView1D,
         const HostView1D, const HostView1D, const HostView1D
     ) = 0;
+
+    /// Returns if Linearize() evaluates the residual vector and the iteration matrix from one
+    /// shared evaluation, i.e. if it is cheaper than calling ResidualVector() and
+    /// IterationMatrix() separately
+    virtual bool IsLinearizeFused() const { return false; }
+
+    /*! @brief Calculates the residual vector and, if requested, the iteration matrix into the
+     *      provided views, i.e. without allocating the results
+     *  @details The default implementation calls ResidualVector() and IterationMatrix(),
+     *      problems that share kinematics between the two should override it, along with
+     *      IsLinearizeFused()
+     */
+    virtual void Linearize(
+        const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+        const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+        const HostView1D acceleration, const HostView1D lagrange_mults, HostView1D residual_vector,
+        bool is_iteration_matrix_required, HostView2D iteration_matrix
+    );
+
+    /*! @brief Returns the iteration matrix in a block sparse format, i.e. with 6 x 6 blocks for
+     *      the bodies and coupling blocks for the constraints
+     *  @details The default implementation partitions the dense iteration matrix with
+     *      create_multibody_block_sizes(), multibody problems should override it to assemble the
+     *      blocks of the bodies and joints directly
+     */
+    virtual BlockSparseMatrix SparseIterationMatrix(
+        const double&, const double&, const double&, const HostView1D, const HostView1D,
+        const HostView1D, const HostView1D, const HostView1D
+    );
+
+    /// Returns if JacobianVectorProduct() is cheaper than forming the dense iteration matrix,
+    /// i.e. if matrix-free solvers should call it instead of approximating the product with
+    /// finite differences of the residual vector
+    virtual bool HasJacobianVectorProduct() const { return false; }
+
+    /*! @brief Calculates the product of the iteration matrix with the provided vector into the
+     *      provided product vector
+     *  @details The default implementation multiplies with SparseIterationMatrix(), i.e. only
+     *      avoids the O(n^2) dense matrix for problems that override the latter
+     */
+    virtual void JacobianVectorProduct(
+        const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+        const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+        const HostView1D acceleration, const HostView1D lagrange_mults, const HostView1D vector,
+        HostView1D product
+    );
+
+    /// Returns if the problem applies the external loads registered with SetExternalLoads()
+    virtual bool HasExternalLoads() const { return false; }
+
+    /*! @brief Registers a view of the generalized external loads, e.g. the aerodynamic loads of
+     *      a coupled code, which the residual vector subtracts from the generalized forces
+     *  @details The view is read on every evaluation, i.e. it is not copied and its values may
+     *      change between evaluations. The loads do not depend on the state, i.e. the iteration
+     *      matrix is not affected. The default implementation throws, since the problem does not
+     *      support external loads.
+     */
+    virtual void SetExternalLoads(const HostView1D);
+
+    /// Returns if CalculateInvariants() evaluates the total energy, the angular momentum, and
+    /// the constraint violation of the bodies of the problem
+    virtual bool HasInvariants() const { return false; }
+
+    /*! @brief Calculates the invariants of the bodies of the problem at the provided generalized
+     *      coordinates and velocities, i.e. one entry per body
+     *  @details The default implementation throws, since the problem does not define any
+     *      invariants.
+     */
+    virtual void CalculateInvariants(
+        const HostView1D gen_coords, const HostView1D velocity,
+        RigidBodyInvariantsView1D<Kokkos::HostSpace> invariants
+    );
 };
 
 /// Defines a unity residual vector and identity iteration matrix
-class UnityLinearizationParameters : public LinearizationParameters {
+class UnityLinearizationParameters final : public LinearizationParameters {
 public:
     UnityLinearizationParameters(){};
 
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief A fixed-size vector of N entries, stored by value
+ *  @details The size is known at compile time, so a Vec lives on the stack/in registers and all
+ *      of its operations are constexpr and callable from inside Kokkos kernels
+ */
+template <size_t N, typename Scalar = double>
+class Vec {
+public:
+    static constexpr size_t kSize = N;
+
+    /// Constructs a null vector
+    KOKKOS_INLINE_FUNCTION constexpr Vec() : data_{} {}
+
+    /// Constructs a vector from the provided values
+    KOKKOS_INLINE_FUNCTION constexpr Vec(const Scalar (&values)[N]) : data_{} {
+        for (size_t i = 0; i < N; ++i) {
+            data_[i] = values[i];
+        }
+    }
+
+    /// Returns the i-th entry of the vector
+    KOKKOS_INLINE_FUNCTION constexpr Scalar& operator()(size_t i) { return data_[i]; }
+
+    /// Returns the i-th entry of the vector
+    KOKKOS_INLINE_FUNCTION constexpr const Scalar& operator()(size_t i) const { return data_[i]; }
+
+    /// Returns the number of entries of the vector
+    KOKKOS_INLINE_FUNCTION static constexpr size_t size() { return N; }
+
+    /// Returns a pointer to the contiguous entries of the vector
+    KOKKOS_INLINE_FUNCTION constexpr const Scalar* data() const { return data_; }
+
+    /// Adds provided vector to this vector and returns the result
+    KOKKOS_INLINE_FUNCTION constexpr Vec operator+(const Vec& other) const {
+        Vec result;
+        for (size_t i = 0; i < N; ++i) {
+            result(i) = data_[i] + other(i);
+        }
+        return result;
+    }
+
+    /// Subtracts provided vector from this vector and returns the result
+    KOKKOS_INLINE_FUNCTION constexpr Vec operator-(const Vec& other) const {
+        Vec result;
+        for (size_t i = 0; i < N; ++i) {
+            result(i) = data_[i] - other(i);
+        }
+        return result;
+    }
+
+    /// Returns the negative of this vector
+    KOKKOS_INLINE_FUNCTION constexpr Vec operator-() const { return *this * Scalar(-1.); }
+
+    /// Multiplies this vector with a scalar and returns the result
+    KOKKOS_INLINE_FUNCTION constexpr Vec operator*(Scalar scalar) const {
+        Vec result;
+        for (size_t i = 0; i < N; ++i) {
+            result(i) = data_[i] * scalar;
+        }
+        return result;
+    }
+
+    /// Divides this vector by a scalar and returns the result
+    KOKKOS_INLINE_FUNCTION constexpr Vec operator/(Scalar scalar) const {
+        return *this * (Scalar(1.) / scalar);
+    }
+
+    /// Adds provided vector to this vector in place
+    KOKKOS_INLINE_FUNCTION constexpr Vec& operator+=(const Vec& other) {
+        for (size_t i = 0; i < N; ++i) {
+            data_[i] += other(i);
+        }
+        return *this;
+    }
+
+    /// Subtracts provided vector from this vector in place
+    KOKKOS_INLINE_FUNCTION constexpr Vec& operator-=(const Vec& other) {
+        for (size_t i = 0; i < N; ++i) {
+            data_[i] -= other(i);
+        }
+        return *this;
+    }
+
+    /// Calculates the dot product of provided vector with this vector
+    KOKKOS_INLINE_FUNCTION constexpr Scalar DotProduct(const Vec& other) const {
+        Scalar sum{};
+        for (size_t i = 0; i < N; ++i) {
+            sum += data_[i] * other(i);
+        }
+        return sum;
+    }
+
+    /// Returns the length/Euclidean/L2 norm of the vector
+    KOKKOS_INLINE_FUNCTION Scalar Length() const {
+        using Kokkos::sqrt;
+        return sqrt(DotProduct(*this));
+    }
+
+    /// Calculates the cross product of provided 3-D vector with this 3-D vector
+    KOKKOS_INLINE_FUNCTION constexpr Vec CrossProduct(const Vec& other) const {
+        static_assert(N == 3, "The cross product is only defined for 3-D vectors");
+        return Vec{
+            {data_[1] * other(2) - data_[2] * other(1), data_[2] * other(0) - data_[0] * other(2),
+             data_[0] * other(1) - data_[1] * other(0)}};
+    }
+
+    /// Returns the M entries of this vector starting at the provided offset
+    template <size_t M>
+    KOKKOS_INLINE_FUNCTION constexpr Vec<M, Scalar> GetSegment(size_t offset) const {
+        Vec<M, Scalar> result;
+        for (size_t i = 0; i < M; ++i) {
+            result(i) = data_[offset + i];
+        }
+        return result;
+    }
+
+    /// Sets the entries of this vector starting at the provided offset to the provided segment
+    template <size_t M>
+    KOKKOS_INLINE_FUNCTION constexpr void SetSegment(size_t offset, const Vec<M, Scalar>& segment) {
+        for (size_t i = 0; i < M; ++i) {
+            data_[offset + i] = segment(i);
+        }
+    }
+
+private:
+    Scalar data_[N];
+};
+
+/// Multiplies a scalar with a vector and returns the result
+template <size_t N, typename Scalar>
+KOKKOS_INLINE_FUNCTION constexpr Vec<N, Scalar> operator*(Scalar scalar, const Vec<N, Scalar>& v) {
+    return v * scalar;
+}
+
+/*! @brief A fixed-size R x C matrix, stored by value in row-major order
+ *  @details The size is known at compile time, so a Matrix lives on the stack/in registers and
+ *      all of its operations are constexpr and callable from inside Kokkos kernels
+ */
+template <size_t R, size_t C, typename Scalar = double>
+class Matrix {
+public:
+    static constexpr size_t kRows = R;
+    static constexpr size_t kColumns = C;
+
+    /// Constructs a null matrix
+    KOKKOS_INLINE_FUNCTION constexpr Matrix() : data_{} {}
+
+    /// Constructs a matrix from the provided (row-major) values
+    KOKKOS_INLINE_FUNCTION constexpr Matrix(const Scalar (&values)[R][C]) : data_{} {
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                data_[i * C + j] = values[i][j];
+            }
+        }
+    }
+
+    /// Returns an identity matrix
+    KOKKOS_INLINE_FUNCTION static constexpr Matrix Identity() {
+        static_assert(R == C, "The identity matrix must be a square matrix");
+        Matrix result;
+        for (size_t i = 0; i < R; ++i) {
+            result(i, i) = Scalar(1.);
+        }
+        return result;
+    }
+
+    /// Returns a diagonal matrix with the provided diagonal entries
+    KOKKOS_INLINE_FUNCTION static constexpr Matrix Diagonal(const Vec<R, Scalar>& diagonal) {
+        static_assert(R == C, "A diagonal matrix must be a square matrix");
+        Matrix result;
+        for (size_t i = 0; i < R; ++i) {
+            result(i, i) = diagonal(i);
+        }
+        return result;
+    }
+
+    /// Returns the entry of the matrix at the provided row and column
+    KOKKOS_INLINE_FUNCTION constexpr Scalar& operator()(size_t i, size_t j) {
+        return data_[i * C + j];
+    }
+
+    /// Returns the entry of the matrix at the provided row and column
+    KOKKOS_INLINE_FUNCTION constexpr const Scalar& operator()(size_t i, size_t j) const {
+        return data_[i * C + j];
+    }
+
+    /// Returns a pointer to the contiguous (row-major) entries of the matrix
+    KOKKOS_INLINE_FUNCTION constexpr const Scalar* data() const { return data_; }
+
+    /// Adds provided matrix to this matrix and returns the result
+    KOKKOS_INLINE_FUNCTION constexpr Matrix operator+(const Matrix& other) const {
+        Matrix result;
+        for (size_t i = 0; i < R * C; ++i) {
+            result.data_[i] = data_[i] + other.data_[i];
+        }
+        return result;
+    }
+
+    /// Subtracts provided matrix from this matrix and returns the result
+    KOKKOS_INLINE_FUNCTION constexpr Matrix operator-(const Matrix& other) const {
+        Matrix result;
+        for (size_t i = 0; i < R * C; ++i) {
+            result.data_[i] = data_[i] - other.data_[i];
+        }
+        return result;
+    }
+
+    /// Returns the negative of this matrix
+    KOKKOS_INLINE_FUNCTION constexpr Matrix operator-() const { return *this * Scalar(-1.); }
+
+    /// Multiplies this matrix with a scalar and returns the result
+    KOKKOS_INLINE_FUNCTION constexpr Matrix operator*(Scalar scalar) const {
+        Matrix result;
+        for (size_t i = 0; i < R * C; ++i) {
+            result.data_[i] = data_[i] * scalar;
+        }
+        return result;
+    }
+
+    /// Adds provided matrix to this matrix in place
+    KOKKOS_INLINE_FUNCTION constexpr Matrix& operator+=(const Matrix& other) {
+        for (size_t i = 0; i < R * C; ++i) {
+            data_[i] += other.data_[i];
+        }
+        return *this;
+    }
+
+    /// Multiplies this R x C matrix with provided C x P matrix and returns the R x P result
+    template <size_t P>
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<R, P, Scalar> operator*(
+        const Matrix<C, P, Scalar>& other
+    ) const {
+        Matrix<R, P, Scalar> result;
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t k = 0; k < C; ++k) {
+                const auto a_ik = data_[i * C + k];
+                for (size_t j = 0; j < P; ++j) {
+                    result(i, j) += a_ik * other(k, j);
+                }
+            }
+        }
+        return result;
+    }
+
+    /// Multiplies this R x C matrix with provided C x 1 vector and returns the R x 1 result
+    KOKKOS_INLINE_FUNCTION constexpr Vec<R, Scalar> operator*(const Vec<C, Scalar>& v) const {
+        Vec<R, Scalar> result;
+        for (size_t i = 0; i < R; ++i) {
+            Scalar sum{};
+            for (size_t j = 0; j < C; ++j) {
+                sum += data_[i * C + j] * v(j);
+            }
+            result(i) = sum;
+        }
+        return result;
+    }
+
+    /// Returns the C x R transpose of this matrix
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<C, R, Scalar> GetTranspose() const {
+        Matrix<C, R, Scalar> result;
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                result(j, i) = data_[i * C + j];
+            }
+        }
+        return result;
+    }
+
+    /// Returns the BR x BC block of this matrix whose upper left entry is at (row, column)
+    template <size_t BR, size_t BC>
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<BR, BC, Scalar> GetBlock(size_t row, size_t column)
+        const {
+        Matrix<BR, BC, Scalar> result;
+        for (size_t i = 0; i < BR; ++i) {
+            for (size_t j = 0; j < BC; ++j) {
+                result(i, j) = data_[(row + i) * C + column + j];
+            }
+        }
+        return result;
+    }
+
+    /// Sets the block of this matrix whose upper left entry is at (row, column)
+    template <size_t BR, size_t BC>
+    KOKKOS_INLINE_FUNCTION constexpr void SetBlock(
+        size_t row, size_t column, const Matrix<BR, BC, Scalar>& block
+    ) {
+        for (size_t i = 0; i < BR; ++i) {
+            for (size_t j = 0; j < BC; ++j) {
+                data_[(row + i) * C + column + j] = block(i, j);
+            }
+        }
+    }
+
+private:
+    Scalar data_[R * C];
+};
+
+/// Multiplies a scalar with a matrix and returns the result
+template <size_t R, size_t C, typename Scalar>
+KOKKOS_INLINE_FUNCTION constexpr Matrix<R, C, Scalar> operator*(
+    Scalar scalar, const Matrix<R, C, Scalar>& m
+) {
+    return m * scalar;
+}
+
+/// Generates and returns the 3 x 3 cross product (skew-symmetric) matrix of a 3-D vector
+template <typename Scalar>
+KOKKOS_INLINE_FUNCTION constexpr Matrix<3, 3, Scalar> create_cross_product_matrix(
+    const Vec<3, Scalar>& v
+) {
+    return Matrix<3, 3, Scalar>{
+        {{Scalar(0.), -v(2), v(1)}, {v(2), Scalar(0.), -v(0)}, {-v(1), v(0), Scalar(0.)}}};
+}
+
+/// Returns a fixed-size vector with the N entries of a HostView1D starting at the offset
+template <size_t N>
+Vec<N> to_vec(const HostView1D view, size_t offset = 0) {
+    if (view.extent(0) < offset + N) {
+        throw std::invalid_argument("The provided view does not contain enough entries");
+    }
+
+    Vec<N> result;
+    for (size_t i = 0; i < N; ++i) {
+        result(i) = view(offset + i);
+    }
+    return result;
+}
+
+/// Returns a fixed-size R x C matrix with the entries of a HostView2D of the same shape
+template <size_t R, size_t C>
+Matrix<R, C> to_matrix(const HostView2D view) {
+    if (view.extent(0) != R || view.extent(1) != C) {
+        throw std::invalid_argument("The provided view does not have the shape of the matrix");
+    }
+
+    Matrix<R, C> result;
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < C; ++j) {
+            result(i, j) = view(i, j);
+        }
+    }
+    return result;
+}
+
+/// Returns a HostView1D with the entries of the provided fixed-size vector
+template <size_t N>
+HostView1D to_host_view(const Vec<N>& v) {
+    auto view = HostView1D("vector", N);
+    for (size_t i = 0; i < N; ++i) {
+        view(i) = v(i);
+    }
+    return view;
+}
+
+/// Returns a HostView2D with the entries of the provided fixed-size matrix
+template <size_t R, size_t C>
+HostView2D to_host_view(const Matrix<R, C>& m) {
+    auto view = HostView2D("matrix", R, C);
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < C; ++j) {
+            view(i, j) = m(i, j);
+        }
+    }
+    return view;
+}
+
+/// Copies the entries of the provided fixed-size vector into a HostView1D of the same size
+template <size_t N>
+void copy_to_host_view(const Vec<N>& v, const HostView1D view) {
+    if (view.extent(0) != N) {
+        throw std::invalid_argument("The provided view does not have the size of the vector");
+    }
+
+    for (size_t i = 0; i < N; ++i) {
+        view(i) = v(i);
+    }
+}
+
+/// Copies the entries of the provided fixed-size matrix into a HostView2D of the same shape
+template <size_t R, size_t C>
+void copy_to_host_view(const Matrix<R, C>& m, const HostView2D view) {
+    if (view.extent(0) != R || view.extent(1) != C) {
+        throw std::invalid_argument("The provided view does not have the shape of the matrix");
+    }
+
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < C; ++j) {
+            view(i, j) = m(i, j);
+        }
+    }
+}
+
+}  // namespace openturbine::rigid_pendulum
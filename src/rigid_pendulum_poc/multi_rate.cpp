@@ -0,0 +1,160 @@
+#include "src/rigid_pendulum_poc/multi_rate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+/// Returns the linear interpolation of the provided vectors at the provided fraction
+HostView1D interpolate(const HostView1D start, const HostView1D end, double fraction) {
+    auto values = HostView1D("interpolated", start.extent(0));
+    for (size_t i = 0; i < start.extent(0); ++i) {
+        values(i) = (1. - fraction) * start(i) + fraction * end(i);
+    }
+    return values;
+}
+
+/// Returns the linear interpolation of the provided states at the provided fraction, with the
+/// quaternions of the generalized coordinates renormalized, i.e. 7 coordinates per body
+State interpolate(const State& start, const State& end, double fraction) {
+    auto gen_coords = interpolate(
+        start.GetGeneralizedCoordinates(), end.GetGeneralizedCoordinates(), fraction
+    );
+    constexpr auto n_coords = GeneralizedAlphaTimeIntegrator::kNumberOfGeneralizedCoordinatesPerBody;
+    for (size_t body = 0; body < gen_coords.extent(0) / n_coords; ++body) {
+        auto norm = 0.;
+        for (size_t i = 3; i < n_coords; ++i) {
+            norm += gen_coords(body * n_coords + i) * gen_coords(body * n_coords + i);
+        }
+        norm = std::sqrt(norm);
+        for (size_t i = 3; i < n_coords; ++i) {
+            gen_coords(body * n_coords + i) /= norm;
+        }
+    }
+    return State(
+        gen_coords, interpolate(start.GetVelocity(), end.GetVelocity(), fraction),
+        interpolate(start.GetAcceleration(), end.GetAcceleration(), fraction),
+        interpolate(
+            start.GetAlgorithmicAcceleration(), end.GetAlgorithmicAcceleration(), fraction
+        )
+    );
+}
+
+}  // namespace
+
+MultiRateIntegrator::MultiRateIntegrator(
+    const GeneralizedAlphaTimeIntegrator& macro_integrator, std::vector<SubsystemGroup> groups,
+    InterfaceCoupling coupling
+)
+    : macro_stepper_(macro_integrator.GetTimeStepper()),
+      groups_(std::move(groups)),
+      coupling_(std::move(coupling)) {
+    if (groups_.empty()) {
+        throw std::invalid_argument("A multi-rate integration requires at least one group");
+    }
+
+    if (macro_integrator.GetAdaptiveTimeStepPolicy().is_adaptive) {
+        throw std::invalid_argument("Multi-rate integration requires a fixed macro time step");
+    }
+
+    integrators_.reserve(groups_.size());
+    for (const auto& group : groups_) {
+        if (group.problem == nullptr || group.n_substeps == 0) {
+            throw std::invalid_argument(
+                "Every group requires a problem and a number of sub-steps > 0"
+            );
+        }
+
+        const auto n_velocities = group.initial_state.GetVelocity().extent(0);
+        loads_.emplace_back("interface_loads", n_velocities);
+        if (coupling_) {
+            group.problem->SetExternalLoads(loads_.back());
+        }
+
+        // Every group keeps its own integrator, i.e. its factorization and predictor history
+        // carry over from one macro time step to the next
+        const auto n_substeps = static_cast<double>(group.n_substeps);
+        integrators_.emplace_back(
+            macro_integrator.GetAlphaF(), macro_integrator.GetAlphaM(),
+            macro_integrator.GetBeta(), macro_integrator.GetGamma(),
+            TimeStepper(
+                macro_stepper_.GetInitialTime(), macro_stepper_.GetTimeStep() / n_substeps,
+                macro_stepper_.GetNumberOfSteps() * group.n_substeps,
+                macro_stepper_.GetMaximumNumberOfIterations()
+            ),
+            macro_integrator.IsPreconditioned(), macro_integrator.GetLinearSolverPolicy()
+        );
+        integrators_.back().SetJacobianUpdatePolicy(macro_integrator.GetJacobianUpdatePolicy());
+        integrators_.back().SetNewtonPolicy(macro_integrator.GetNewtonPolicy());
+    }
+}
+
+double MultiRateIntegrator::GetTimeStep(size_t group) const {
+    return integrators_.at(group).GetTimeStepper().GetTimeStep();
+}
+
+std::vector<std::vector<State>> MultiRateIntegrator::Integrate() {
+    const auto n_groups = groups_.size();
+    const auto macro_time_step = macro_stepper_.GetTimeStep();
+
+    // The slowest groups advance first, i.e. the fast ones see their interpolated states
+    auto order = std::vector<size_t>(n_groups);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+        return groups_[lhs].n_substeps < groups_[rhs].n_substeps;
+    });
+
+    auto start_states = std::vector<State>{};
+    auto results = std::vector<std::vector<State>>(n_groups);
+    for (size_t i = 0; i < n_groups; ++i) {
+        start_states.push_back(groups_[i].initial_state);
+        results[i].reserve(macro_stepper_.GetNumberOfSteps() + 1);
+        results[i].push_back(groups_[i].initial_state);
+    }
+
+    auto interface_states = start_states;
+    for (size_t step = 0; step < macro_stepper_.GetNumberOfSteps(); ++step) {
+        const auto start_time =
+            macro_stepper_.GetInitialTime() + static_cast<double>(step) * macro_time_step;
+        auto end_states = start_states;
+        auto is_advanced = std::vector<bool>(n_groups, false);
+
+        for (const auto i : order) {
+            const auto& group = groups_[i];
+            const auto h = macro_time_step / static_cast<double>(group.n_substeps);
+            auto state = start_states[i];
+            for (size_t substep = 1; substep <= group.n_substeps; ++substep) {
+                const auto time = start_time + static_cast<double>(substep) * h;
+                if (coupling_) {
+                    const auto fraction = static_cast<double>(substep) /
+                                          static_cast<double>(group.n_substeps);
+                    for (size_t j = 0; j < n_groups; ++j) {
+                        interface_states[j] =
+                            is_advanced[j]
+                                ? interpolate(start_states[j], end_states[j], fraction)
+                                : start_states[j];
+                    }
+                    interface_states[i] = state;
+                    coupling_(i, time, interface_states, loads_[i]);
+                }
+                auto [next_state, lagrange_mults] =
+                    integrators_[i].AlphaStep(state, group.n_constraints, group.problem);
+                state = next_state;
+            }
+            end_states[i] = state;
+            is_advanced[i] = true;
+        }
+
+        for (size_t i = 0; i < n_groups; ++i) {
+            results[i].push_back(end_states[i]);
+        }
+        start_states = std::move(end_states);
+    }
+    return results;
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/linearization_parameters.h"
+#include "src/rigid_pendulum_poc/state.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// A subsystem of a multi-rate time integration, e.g. the stiff drivetrain or the slow tower,
+/// advanced with its own time step
+struct SubsystemGroup {
+    std::shared_ptr<LinearizationParameters> problem;  //< Problem of the subsystem
+    State initial_state;                               //< State at the initial time
+    size_t n_constraints = 0;                          //< Number of constraints of the problem
+    size_t n_substeps = 1;                             //< Time steps per macro time step
+};
+
+/// Writes the interface loads of the provided group at the provided time, i.e. the external
+/// loads of its problem, from the states of all groups interpolated to that time
+using InterfaceCoupling = std::function<
+    void(size_t group, double time, const std::vector<State>& states, HostView1D loads)>;
+
+/*! @brief Integrates subsystems with individual time steps, i.e. sub-cycles the fast and stiff
+ *      subsystems within the macro time step of the slow ones
+ *  @details Every group advances with its own generalized-alpha integrator of the macro
+ *      integrator's parameters and policies, at the macro time step divided by its number of
+ *      sub-steps, so that the small time step is only paid for by the groups that need it.
+ *      Within a macro time step, the groups advance in order of increasing numbers of sub-steps,
+ *      i.e. slowest first. Before every sub-step, the coupling evaluates the loads of the group
+ *      at the end of the sub-step from the interface states of all groups: the group itself
+ *      provides its state at the start of the sub-step, the states of groups that advanced
+ *      already are linearly interpolated between the start and the end of the macro time step,
+ *      the quaternions renormalized, while the others are held at the start of the macro time
+ *      step. The loads are registered with the problems through
+ *      LinearizationParameters::SetExternalLoads(), i.e. the problems of coupled groups must
+ *      support external loads.
+ */
+class MultiRateIntegrator {
+public:
+    MultiRateIntegrator(
+        const GeneralizedAlphaTimeIntegrator& macro_integrator, std::vector<SubsystemGroup> groups,
+        InterfaceCoupling coupling = nullptr
+    );
+
+    /// Returns the number of groups
+    inline size_t GetNumberOfGroups() const { return groups_.size(); }
+
+    /// Returns the time step of the provided group
+    double GetTimeStep(size_t group) const;
+
+    /// Performs the time integration and returns the states of every group at the macro time
+    /// steps, starting with the initial states
+    std::vector<std::vector<State>> Integrate();
+
+private:
+    TimeStepper macro_stepper_;                                //< Macro time steps
+    std::vector<SubsystemGroup> groups_;                       //< Subsystems of the integration
+    std::vector<GeneralizedAlphaTimeIntegrator> integrators_;  //< Integrator of every group
+    std::vector<HostView1D> loads_;                            //< Interface loads of every group
+    InterfaceCoupling coupling_;                               //< Evaluates the interface loads
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,339 @@
+#include "src/rigid_pendulum_poc/multibody_model.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "src/rigid_pendulum_poc/quaternion.h"
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+using RigidBodiesView = Kokkos::View<RigidBodyElement*, Kokkos::HostSpace>;
+using JointsView = Kokkos::View<SphericalJointElement*, Kokkos::HostSpace>;
+using HostRangePolicy = Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>;
+using KinematicsView = KinematicsCache::KinematicsView;
+
+constexpr size_t kCOORDINATES = RigidBodyElement::kNumberOfGeneralizedCoordinates;
+constexpr size_t kVELOCITIES = RigidBodyElement::kNumberOfVelocities;
+constexpr size_t kCONSTRAINTS = SphericalJointElement::kNumberOfConstraints;
+
+/// Returns the N entries of the provided view starting at the offset, without any checks
+template <size_t N>
+KOKKOS_INLINE_FUNCTION Vec<N> get_segment(const HostView1D view, size_t offset) {
+    auto segment = Vec<N>{};
+    for (size_t i = 0; i < N; ++i) {
+        segment(i) = view(offset + i);
+    }
+    return segment;
+}
+
+/// Writes the blocks of the iteration matrix into a dense matrix, whose block rows/columns are
+/// the bodies followed by the joints
+class DenseBlockWriter {
+public:
+    DenseBlockWriter(HostView2D matrix, size_t n_bodies) : matrix_(matrix), n_bodies_(n_bodies) {}
+
+    template <size_t R, size_t C>
+    KOKKOS_INLINE_FUNCTION void Set(size_t row, size_t column, const Matrix<R, C>& block) const {
+        const auto row_offset = GetOffset(row);
+        const auto column_offset = GetOffset(column);
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                matrix_(row_offset + i, column_offset + j) = block(i, j);
+            }
+        }
+    }
+
+    template <size_t R, size_t C>
+    KOKKOS_INLINE_FUNCTION void AtomicAdd(size_t row, size_t column, const Matrix<R, C>& block)
+        const {
+        const auto row_offset = GetOffset(row);
+        const auto column_offset = GetOffset(column);
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                Kokkos::atomic_add(&matrix_(row_offset + i, column_offset + j), block(i, j));
+            }
+        }
+    }
+
+private:
+    HostView2D matrix_;
+    size_t n_bodies_;
+
+    KOKKOS_INLINE_FUNCTION size_t GetOffset(size_t block) const {
+        return (block < n_bodies_) ? block * kVELOCITIES
+                                   : n_bodies_ * kVELOCITIES + (block - n_bodies_) * kCONSTRAINTS;
+    }
+};
+
+/// Writes the blocks of the iteration matrix into the blocks of a block sparse matrix
+class SparseBlockWriter {
+public:
+    SparseBlockWriter(const BlockSparseMatrix& matrix) : matrix_(&matrix) {}
+
+    template <size_t R, size_t C>
+    void Set(size_t row, size_t column, const Matrix<R, C>& block) const {
+        copy_to_host_view(block, matrix_->GetBlock(row, column));
+    }
+
+    template <size_t R, size_t C>
+    void AtomicAdd(size_t row, size_t column, const Matrix<R, C>& block) const {
+        auto view = matrix_->GetBlock(row, column);
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                Kokkos::atomic_add(&view(i, j), block(i, j));
+            }
+        }
+    }
+
+private:
+    const BlockSparseMatrix* matrix_;
+};
+
+/// Assembles the residual vector and, if required, the iteration matrix blocks of all elements
+/// with the provided writer - the bodies first, since the joints add to the blocks of their
+/// bodies
+template <typename BlockWriter>
+void assemble(
+    const RigidBodiesView bodies, const JointsView joints, double BETA_PRIME, double GAMMA_PRIME,
+    const KinematicsView kinematics, const HostView1D gen_coords, const HostView1D velocity,
+    const HostView1D acceleration, const HostView1D lagrange_mults,
+    const HostView1D residual_vector, bool is_iteration_matrix_required,
+    const BlockWriter& block_writer
+) {
+    const auto n_bodies = bodies.extent(0);
+    const auto n_velocities = n_bodies * kVELOCITIES;
+
+    Kokkos::parallel_for(
+        "assemble_rigid_bodies", HostRangePolicy(0, n_bodies),
+        KOKKOS_LAMBDA(const size_t body) {
+            const auto v = get_segment<kVELOCITIES>(velocity, body * kVELOCITIES);
+            const auto a = get_segment<kVELOCITIES>(acceleration, body * kVELOCITIES);
+            const auto residual = bodies(body).ResidualVector(v, a);
+            for (size_t i = 0; i < kVELOCITIES; ++i) {
+                residual_vector(body * kVELOCITIES + i) = residual(i);
+            }
+            if (is_iteration_matrix_required) {
+                block_writer.Set(
+                    body, body, bodies(body).IterationMatrix(BETA_PRIME, GAMMA_PRIME, v)
+                );
+            }
+        }
+    );
+
+    Kokkos::parallel_for(
+        "assemble_spherical_joints", HostRangePolicy(0, joints.extent(0)),
+        KOKKOS_LAMBDA(const size_t joint) {
+            const auto& element = joints(joint);
+            const auto lambda =
+                get_segment<kCONSTRAINTS>(lagrange_mults, joint * kCONSTRAINTS);
+
+            auto constraints = Vec<kCONSTRAINTS>{};
+            for (size_t end = 0; end < 2; ++end) {
+                const auto body = element.GetBody(end);
+                if (body == SphericalJointElement::kGround) {
+                    constraints += element.GetPosition(end) * element.GetSign(end);
+                    continue;
+                }
+                const auto& rotation_matrix = kinematics(body).rotation_matrix;
+                const auto q = get_segment<kCOORDINATES>(gen_coords, body * kCOORDINATES);
+                constraints +=
+                    element.CalculatePosition(end, q, rotation_matrix) * element.GetSign(end);
+
+                // The contributions to the rows of the body are shared with the other joints of
+                // the body, i.e. scattered with atomics
+                const auto constraint_gradient_matrix =
+                    element.ConstraintsGradientMatrix(end, rotation_matrix);
+                const auto reaction = constraint_gradient_matrix.GetTranspose() * lambda;
+                for (size_t i = 0; i < kVELOCITIES; ++i) {
+                    Kokkos::atomic_add(&residual_vector(body * kVELOCITIES + i), reaction(i));
+                }
+
+                if (is_iteration_matrix_required) {
+                    const auto& tangent_operator = kinematics(body).tangent_operator;
+                    block_writer.Set(
+                        body, n_bodies + joint, constraint_gradient_matrix.GetTranspose()
+                    );
+                    block_writer.Set(
+                        n_bodies + joint, body, constraint_gradient_matrix * tangent_operator
+                    );
+                    block_writer.AtomicAdd(
+                        body, body,
+                        element.TangentStiffnessMatrix(end, rotation_matrix, lambda) *
+                            tangent_operator
+                    );
+                }
+            }
+
+            for (size_t i = 0; i < kCONSTRAINTS; ++i) {
+                residual_vector(n_velocities + joint * kCONSTRAINTS + i) = constraints(i);
+            }
+        }
+    );
+}
+
+}  // namespace
+
+size_t MultibodyModel::AddRigidBody(const RigidBodyElement& body) {
+    const auto n_bodies = this->GetNumberOfBodies();
+    auto bodies = RigidBodiesView("rigid_bodies", n_bodies + 1);
+    for (size_t i = 0; i < n_bodies; ++i) {
+        bodies(i) = bodies_(i);
+    }
+    bodies(n_bodies) = body;
+    this->bodies_ = bodies;
+    return n_bodies;
+}
+
+size_t MultibodyModel::AddSphericalJoint(const SphericalJointElement& joint) {
+    const auto body_a = joint.GetBody(0);
+    const auto body_b = joint.GetBody(1);
+    const auto is_valid_body = [this](size_t body) {
+        return body == SphericalJointElement::kGround || body < this->GetNumberOfBodies();
+    };
+    if (!is_valid_body(body_a) || !is_valid_body(body_b)) {
+        throw std::invalid_argument("The bodies of the joint must be part of the model");
+    }
+    if (body_a == body_b) {
+        throw std::invalid_argument("A joint must connect two different bodies");
+    }
+
+    const auto n_joints = this->GetNumberOfJoints();
+    auto joints = JointsView("spherical_joints", n_joints + 1);
+    for (size_t i = 0; i < n_joints; ++i) {
+        joints(i) = joints_(i);
+    }
+    joints(n_joints) = joint;
+    this->joints_ = joints;
+    return n_joints;
+}
+
+void MultibodyModel::CheckSizes(
+    const HostView1D gen_coords, const HostView1D velocity, const HostView1D acceleration,
+    const HostView1D lagrange_mults
+) const {
+    if (gen_coords.extent(0) != this->GetNumberOfGeneralizedCoordinates()) {
+        throw std::invalid_argument("gen_coords must be of size 7 per rigid body of the model");
+    }
+
+    if (velocity.extent(0) != this->GetNumberOfVelocities() ||
+        acceleration.extent(0) != this->GetNumberOfVelocities()) {
+        throw std::invalid_argument(
+            "delta_gen_coords, velocity, acceleration must be of size 6 per rigid body of the model"
+        );
+    }
+
+    if (lagrange_mults.extent(0) != this->GetNumberOfConstraints()) {
+        throw std::invalid_argument("lagrange_mults must be of size 3 per joint of the model");
+    }
+
+    for (size_t body = 0; body < this->GetNumberOfBodies(); ++body) {
+        const auto q = body * kCOORDINATES;
+        if (!Quaternion{gen_coords(q + 3), gen_coords(q + 4), gen_coords(q + 5), gen_coords(q + 6)}
+                 .IsUnitQuaternion()) {
+            throw std::invalid_argument(
+                "CANNOT convert quaternion to rotation matrix - must be a unit quaternion to "
+                "rotate a vector"
+            );
+        }
+    }
+}
+
+HostView1D MultibodyModel::ResidualVector(
+    const HostView1D gen_coords, const HostView1D velocity, const HostView1D acceleration,
+    const HostView1D lagrange_mults
+) {
+    this->CheckSizes(gen_coords, velocity, acceleration, lagrange_mults);
+
+    auto residual_vector = HostView1D(
+        "residual_vector", this->GetNumberOfVelocities() + this->GetNumberOfConstraints()
+    );
+    assemble(
+        bodies_, joints_, 0., 0., kinematics_cache_.Update(gen_coords), gen_coords, velocity,
+        acceleration, lagrange_mults, residual_vector, false, DenseBlockWriter(HostView2D(), 0)
+    );
+    return residual_vector;
+}
+
+HostView2D MultibodyModel::IterationMatrix(
+    const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+    const HostView1D acceleration, const HostView1D lagrange_mults
+) {
+    const auto size = this->GetNumberOfVelocities() + this->GetNumberOfConstraints();
+    auto residual_vector = HostView1D("residual_vector", size);
+    auto iteration_matrix = HostView2D("iteration_matrix", size, size);
+    this->Linearize(
+        h, BETA_PRIME, GAMMA_PRIME, gen_coords, delta_gen_coords, velocity, acceleration,
+        lagrange_mults, residual_vector, true, iteration_matrix
+    );
+    return iteration_matrix;
+}
+
+void MultibodyModel::Linearize(
+    const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+    const HostView1D acceleration, const HostView1D lagrange_mults, HostView1D residual_vector,
+    bool is_iteration_matrix_required, HostView2D iteration_matrix
+) {
+    this->CheckSizes(gen_coords, velocity, acceleration, lagrange_mults);
+    if (delta_gen_coords.extent(0) != this->GetNumberOfVelocities()) {
+        throw std::invalid_argument(
+            "delta_gen_coords, velocity, acceleration must be of size 6 per rigid body of the model"
+        );
+    }
+
+    // Only the structurally non-zero blocks are written, i.e. the rest must be zero
+    if (is_iteration_matrix_required) {
+        Kokkos::deep_copy(iteration_matrix, 0.);
+    }
+    const auto kinematics = is_iteration_matrix_required
+                                ? kinematics_cache_.Update(gen_coords, delta_gen_coords, h)
+                                : kinematics_cache_.Update(gen_coords);
+    assemble(
+        bodies_, joints_, BETA_PRIME, GAMMA_PRIME, kinematics, gen_coords, velocity, acceleration,
+        lagrange_mults, residual_vector, is_iteration_matrix_required,
+        DenseBlockWriter(iteration_matrix, this->GetNumberOfBodies())
+    );
+}
+
+BlockSparseMatrix MultibodyModel::SparseIterationMatrix(
+    const double& h, const double& BETA_PRIME, const double& GAMMA_PRIME,
+    const HostView1D gen_coords, const HostView1D delta_gen_coords, const HostView1D velocity,
+    const HostView1D acceleration, const HostView1D lagrange_mults
+) {
+    this->CheckSizes(gen_coords, velocity, acceleration, lagrange_mults);
+
+    // One block per body followed by one per joint, with the blocks of the bodies coupled by
+    // the blocks of their joints
+    const auto n_bodies = this->GetNumberOfBodies();
+    auto block_sizes = std::vector<size_t>(n_bodies, kVELOCITIES);
+    block_sizes.resize(n_bodies + this->GetNumberOfJoints(), kCONSTRAINTS);
+    auto nonzero_blocks = std::vector<std::pair<size_t, size_t>>{};
+    for (size_t body = 0; body < n_bodies; ++body) {
+        nonzero_blocks.emplace_back(body, body);
+    }
+    for (size_t joint = 0; joint < this->GetNumberOfJoints(); ++joint) {
+        for (size_t end = 0; end < 2; ++end) {
+            const auto body = joints_(joint).GetBody(end);
+            if (body != SphericalJointElement::kGround) {
+                nonzero_blocks.emplace_back(body, n_bodies + joint);
+                nonzero_blocks.emplace_back(n_bodies + joint, body);
+            }
+        }
+    }
+
+    auto iteration_matrix = BlockSparseMatrix(block_sizes, nonzero_blocks);
+    auto residual_vector = HostView1D(
+        "residual_vector", this->GetNumberOfVelocities() + this->GetNumberOfConstraints()
+    );
+    assemble(
+        bodies_, joints_, BETA_PRIME, GAMMA_PRIME,
+        kinematics_cache_.Update(gen_coords, delta_gen_coords, h), gen_coords, velocity,
+        acceleration, lagrange_mults, residual_vector, true, SparseBlockWriter(iteration_matrix)
+    );
+    return iteration_matrix;
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,255 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/block_sparse_matrix.h"
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/kinematics.h"
+#include "src/rigid_pendulum_poc/linearization_parameters.h"
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief A rigid body element of a multibody model, i.e. 7 generalized coordinates (position
+ *      of the center of mass and orientation quaternion) and 6 velocities
+ *  @details Contributes the inertial and gravity terms of its own equations of motion, i.e. the
+ *      same terms as the heavy top without its constraint. Like HeavyTop, it is evaluated on
+ *      fixed-size types and is callable from inside Kokkos kernels.
+ */
+class RigidBodyElement {
+public:
+    static constexpr size_t kNumberOfGeneralizedCoordinates = 7;
+    static constexpr size_t kNumberOfVelocities = 6;
+
+    /// Constructs a rigid body with the provided mass, principal moments of inertia about its
+    /// center of mass, and gravity vector - the defaults are the ones of the heavy top
+    KOKKOS_INLINE_FUNCTION constexpr RigidBodyElement(
+        double mass = 15.,
+        Vec<3> principal_moment_of_inertia = Vec<3>{{0.234375, 0.46875, 0.234375}},
+        Vec<3> gravity = Vec<3>{{0., 0., 9.81}}
+    )
+        : mass_(mass),
+          principal_moment_of_inertia_(principal_moment_of_inertia),
+          gravity_(gravity) {}
+
+    /// Returns the 3 x 3 moment of inertia matrix [J]
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<3, 3> GetMomentOfInertiaMatrix() const {
+        return Matrix<3, 3>::Diagonal(principal_moment_of_inertia_);
+    }
+
+    /// Returns the 6 x 6 mass matrix [M] = diag(m, m, m, J)
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<6, 6> GetMassMatrix() const {
+        return Matrix<6, 6>::Diagonal(Vec<6>{
+            {mass_, mass_, mass_, principal_moment_of_inertia_(0), principal_moment_of_inertia_(1),
+             principal_moment_of_inertia_(2)}});
+    }
+
+    /// Calculates the residual vector of the body, i.e. [M] {v'} + {g(q,v,t)}
+    KOKKOS_INLINE_FUNCTION constexpr Vec<6> ResidualVector(
+        const Vec<6>& velocity, const Vec<6>& acceleration
+    ) const {
+        const auto angular_velocity = velocity.GetSegment<3>(3);
+        auto generalized_forces = Vec<6>{};
+        generalized_forces.SetSegment(0, gravity_ * mass_);
+        generalized_forces.SetSegment(
+            3, angular_velocity.CrossProduct(GetMomentOfInertiaMatrix() * angular_velocity)
+        );
+        return GetMassMatrix() * acceleration + generalized_forces;
+    }
+
+    /// Calculates the iteration matrix block of the body, i.e. [M] * beta' + [C_t] * gamma'
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<6, 6> IterationMatrix(
+        double BETA_PRIME, double GAMMA_PRIME, const Vec<6>& velocity
+    ) const {
+        return GetMassMatrix() * BETA_PRIME +
+               HeavyTop::TangentDampingMatrix(
+                   velocity.GetSegment<3>(3), GetMomentOfInertiaMatrix()
+               ) * GAMMA_PRIME;
+    }
+
+private:
+    double mass_;                         //< Mass of the body
+    Vec<3> principal_moment_of_inertia_;  //< Principal moments of inertia about the center of mass
+    Vec<3> gravity_;                      //< Gravity vector
+};
+
+/*! @brief A spherical joint element of a multibody model, i.e. 3 constraints that keep a point
+ *      of one body coincident with a point of another body or of the ground
+ *  @details The constraints are {Phi} = ({x_a} + [R_a] {s_a}) - ({x_b} + [R_b] {s_b}), with {x}
+ *      the position of the center of mass of a body, [R] its rotation matrix, and {s} the
+ *      position of the joint relative to the center of mass in the body frame. If body a is the
+ *      ground, {s_a} is the fixed position of the joint and [R_a] the identity.
+ */
+class SphericalJointElement {
+public:
+    static constexpr size_t kNumberOfConstraints = 3;
+    static constexpr size_t kGround = std::numeric_limits<size_t>::max();  //< Body of the ground
+
+    /// Constructs a joint between the provided points of the provided bodies
+    KOKKOS_INLINE_FUNCTION constexpr SphericalJointElement(
+        size_t body_a = kGround, Vec<3> position_a = Vec<3>{}, size_t body_b = 0,
+        Vec<3> position_b = Vec<3>{}
+    )
+        : bodies_{body_a, body_b}, positions_{position_a, position_b} {}
+
+    /// Returns the index of the provided end, i.e. 0 for body a and 1 for body b, of the joint
+    KOKKOS_INLINE_FUNCTION constexpr size_t GetBody(size_t end) const { return bodies_[end]; }
+
+    /// Returns the position of the joint in the frame of the provided end of the joint
+    KOKKOS_INLINE_FUNCTION constexpr Vec<3> GetPosition(size_t end) const {
+        return positions_[end];
+    }
+
+    /// Returns the sign of the provided end of the joint in the constraints
+    KOKKOS_INLINE_FUNCTION static constexpr double GetSign(size_t end) {
+        return end == 0 ? 1. : -1.;
+    }
+
+    /// Calculates the position of the joint on the provided end from the generalized coordinates
+    /// of its body
+    KOKKOS_INLINE_FUNCTION constexpr Vec<3> CalculatePosition(
+        size_t end, const Vec<7>& gen_coords
+    ) const {
+        if (bodies_[end] == kGround) {
+            return positions_[end];
+        }
+        return CalculatePosition(end, gen_coords, calculate_rotation_matrix(gen_coords));
+    }
+
+    /// Calculates the position of the joint on the provided (non-ground) end from the
+    /// generalized coordinates of its body and their already evaluated rotation matrix
+    KOKKOS_INLINE_FUNCTION constexpr Vec<3> CalculatePosition(
+        size_t end, const Vec<7>& gen_coords, const Matrix<3, 3>& rotation_matrix
+    ) const {
+        return gen_coords.GetSegment<3>(0) + rotation_matrix * positions_[end];
+    }
+
+    /// Calculates the constraint gradient matrix of the provided (non-ground) end of the joint,
+    /// i.e. sign * [ I_3x3    -[R ~{s}] ]
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<3, 6> ConstraintsGradientMatrix(
+        size_t end, const Matrix<3, 3>& rotation_matrix
+    ) const {
+        auto constraint_gradient_matrix = Matrix<3, 6>{};
+        constraint_gradient_matrix.SetBlock(0, 0, Matrix<3, 3>::Identity() * GetSign(end));
+        constraint_gradient_matrix.SetBlock(
+            0, 3,
+            -(rotation_matrix * create_cross_product_matrix(positions_[end])) * GetSign(end)
+        );
+        return constraint_gradient_matrix;
+    }
+
+    /// Calculates the tangent stiffness matrix of the provided (non-ground) end of the joint,
+    /// i.e. the variation of [B]^T {Lambda} with the orientation of the body
+    KOKKOS_INLINE_FUNCTION constexpr Matrix<6, 6> TangentStiffnessMatrix(
+        size_t end, const Matrix<3, 3>& rotation_matrix, const Vec<3>& lagrange_multipliers
+    ) const {
+        // [K_t] = [ [0]_3x3              [0]_3x3
+        //           [0]_3x3    sign * [ ~{s} * ~([R^T] * {Lambda}) ] ]
+        auto tangent_stiffness_matrix = Matrix<6, 6>{};
+        tangent_stiffness_matrix.SetBlock(
+            3, 3,
+            create_cross_product_matrix(positions_[end]) *
+                create_cross_product_matrix(rotation_matrix.GetTranspose() * lagrange_multipliers) *
+                GetSign(end)
+        );
+        return tangent_stiffness_matrix;
+    }
+
+private:
+    size_t bodies_[2];     //< Bodies at both ends of the joint, kGround for the ground
+    Vec<3> positions_[2];  //< Positions of the joint relative to both bodies, in their frames
+};
+
+/*! @brief A multibody model, i.e. a container of rigid body and joint elements that assembles
+ *      the residual vector and the iteration matrix of the whole system
+ *  @details The generalized coordinates, velocities and constraints are ordered by element: 7
+ *      coordinates/6 velocities per body in the order in which the bodies were added, followed
+ *      by 3 constraints per joint. Assembly is a Kokkos parallel_for over the bodies, which
+ *      write their own blocks, followed by one over the joints, which write their own
+ *      constraint rows and scatter their contributions to the blocks of their bodies with
+ *      atomic additions, so that it scales with the number of threads rather than the number
+ *      of elements.
+ */
+class MultibodyModel final : public LinearizationParameters {
+public:
+    MultibodyModel() = default;
+
+    /// Adds a rigid body to the model and returns its index
+    size_t AddRigidBody(const RigidBodyElement&);
+
+    /// Adds a spherical joint to the model and returns its index - the bodies of the joint must
+    /// have been added to the model before
+    size_t AddSphericalJoint(const SphericalJointElement&);
+
+    /// Returns the number of rigid bodies of the model
+    inline size_t GetNumberOfBodies() const { return bodies_.extent(0); }
+
+    /// Returns the number of joints of the model
+    inline size_t GetNumberOfJoints() const { return joints_.extent(0); }
+
+    /// Returns the number of generalized coordinates of the model
+    inline size_t GetNumberOfGeneralizedCoordinates() const {
+        return GetNumberOfBodies() * RigidBodyElement::kNumberOfGeneralizedCoordinates;
+    }
+
+    /// Returns the number of velocities of the model
+    inline size_t GetNumberOfVelocities() const {
+        return GetNumberOfBodies() * RigidBodyElement::kNumberOfVelocities;
+    }
+
+    /// Returns the number of constraints/Lagrange multipliers of the model
+    inline size_t GetNumberOfConstraints() const {
+        return GetNumberOfJoints() * SphericalJointElement::kNumberOfConstraints;
+    }
+
+    virtual HostView1D ResidualVector(
+        const HostView1D, const HostView1D, const HostView1D, const HostView1D
+    ) override;
+
+    virtual HostView2D IterationMatrix(
+        const double&, const double&, const double&, const HostView1D, const HostView1D,
+        const HostView1D, const HostView1D, const HostView1D
+    ) override;
+
+    /// Returns true, since the elements share their kinematics between both evaluations
+    inline bool IsLinearizeFused() const override { return true; }
+
+    virtual void Linearize(
+        const double&, const double&, const double&, const HostView1D, const HostView1D,
+        const HostView1D, const HostView1D, const HostView1D, HostView1D, bool, HostView2D
+    ) override;
+
+    /// Returns the iteration matrix with one 6 x 6 block per body and one 3-row block per
+    /// joint, assembled from the elements without forming the dense matrix
+    virtual BlockSparseMatrix SparseIterationMatrix(
+        const double&, const double&, const double&, const HostView1D, const HostView1D,
+        const HostView1D, const HostView1D, const HostView1D
+    ) override;
+
+    /// Returns true, since the products with the sparse iteration matrix only require O(n)
+    /// memory and work
+    inline bool HasJacobianVectorProduct() const override { return true; }
+
+    /// Returns the kinematics of the bodies of the latest evaluated iterate
+    inline const KinematicsCache& GetKinematicsCache() const { return kinematics_cache_; }
+
+private:
+    Kokkos::View<RigidBodyElement*, Kokkos::HostSpace> bodies_;      //< Rigid body elements
+    Kokkos::View<SphericalJointElement*, Kokkos::HostSpace> joints_;  //< Joint elements
+
+    /// Kinematics of the bodies of the latest iterate, shared by all elements of a body
+    KinematicsCache kinematics_cache_;
+
+    /// Throws if the provided views do not match the sizes of the model or if any orientation
+    /// is not a unit quaternion
+    void CheckSizes(
+        const HostView1D gen_coords, const HostView1D velocity, const HostView1D acceleration,
+        const HostView1D lagrange_mults
+    ) const;
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,197 @@
+#include "src/rigid_pendulum_poc/parareal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "src/rigid_pendulum_poc/state_observer.h"
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+/// Returns {coarse} + {fine} - {previous_coarse} of the provided vectors
+HostView1D correct(const HostView1D coarse, const HostView1D fine, const HostView1D previous) {
+    auto corrected = HostView1D("corrected", coarse.extent(0));
+    for (size_t i = 0; i < coarse.extent(0); ++i) {
+        corrected(i) = coarse(i) + fine(i) - previous(i);
+    }
+    return corrected;
+}
+
+/// Returns the Parareal correction of the provided states, with the quaternions of the
+/// generalized coordinates renormalized, i.e. 7 coordinates per body
+State correct(const State& coarse, const State& fine, const State& previous) {
+    auto gen_coords = correct(
+        coarse.GetGeneralizedCoordinates(), fine.GetGeneralizedCoordinates(),
+        previous.GetGeneralizedCoordinates()
+    );
+    constexpr auto n_coords = GeneralizedAlphaTimeIntegrator::kNumberOfGeneralizedCoordinatesPerBody;
+    for (size_t body = 0; body < gen_coords.extent(0) / n_coords; ++body) {
+        auto norm = 0.;
+        for (size_t i = 3; i < n_coords; ++i) {
+            norm += gen_coords(body * n_coords + i) * gen_coords(body * n_coords + i);
+        }
+        norm = std::sqrt(norm);
+        for (size_t i = 3; i < n_coords; ++i) {
+            gen_coords(body * n_coords + i) /= norm;
+        }
+    }
+    return State(
+        gen_coords, correct(coarse.GetVelocity(), fine.GetVelocity(), previous.GetVelocity()),
+        correct(coarse.GetAcceleration(), fine.GetAcceleration(), previous.GetAcceleration()),
+        correct(
+            coarse.GetAlgorithmicAcceleration(), fine.GetAlgorithmicAcceleration(),
+            previous.GetAlgorithmicAcceleration()
+        )
+    );
+}
+
+/// Returns the largest absolute difference of the generalized coordinates and velocities
+double calculate_change(const State& state, const State& previous) {
+    auto change = 0.;
+    const auto update = [&change](const HostView1D values, const HostView1D previous_values) {
+        for (size_t i = 0; i < values.extent(0); ++i) {
+            change = std::max(change, std::abs(values(i) - previous_values(i)));
+        }
+    };
+    update(state.GetGeneralizedCoordinates(), previous.GetGeneralizedCoordinates());
+    update(state.GetVelocity(), previous.GetVelocity());
+    return change;
+}
+
+}  // namespace
+
+PararealIntegrator::PararealIntegrator(
+    GeneralizedAlphaTimeIntegrator fine_integrator, PararealPolicy policy
+)
+    : fine_integrator_(std::move(fine_integrator)), policy_(policy) {
+    if (policy_.n_slices == 0 || policy_.coarse_steps_per_slice == 0) {
+        throw std::invalid_argument("The numbers of slices and coarse time steps must be > 0");
+    }
+
+    if (fine_integrator_.GetTimeStepper().GetNumberOfSteps() % policy_.n_slices != 0) {
+        throw std::invalid_argument(
+            "The number of time steps must be a multiple of the number of slices"
+        );
+    }
+
+    if (fine_integrator_.GetAdaptiveTimeStepPolicy().is_adaptive) {
+        throw std::invalid_argument("Parareal integration requires a fixed time step");
+    }
+}
+
+State PararealIntegrator::Propagate(
+    const State& state, size_t n_constraints, size_t slice, size_t n_steps,
+    std::shared_ptr<LinearizationParameters> problem
+) const {
+    const auto& fine_stepper = fine_integrator_.GetTimeStepper();
+    const auto n_fine_steps = fine_stepper.GetNumberOfSteps() / policy_.n_slices;
+    const auto slice_duration = fine_stepper.GetTimeStep() * static_cast<double>(n_fine_steps);
+    const auto start_time =
+        fine_stepper.GetInitialTime() + static_cast<double>(slice) * slice_duration;
+
+    // A new integrator per propagation, i.e. with its own workspace on every thread
+    auto integrator = GeneralizedAlphaTimeIntegrator(
+        fine_integrator_.GetAlphaF(), fine_integrator_.GetAlphaM(), fine_integrator_.GetBeta(),
+        fine_integrator_.GetGamma(),
+        TimeStepper(
+            start_time, slice_duration / static_cast<double>(n_steps), n_steps,
+            fine_stepper.GetMaximumNumberOfIterations()
+        ),
+        fine_integrator_.IsPreconditioned(), fine_integrator_.GetLinearSolverPolicy()
+    );
+    integrator.SetJacobianUpdatePolicy(fine_integrator_.GetJacobianUpdatePolicy());
+    integrator.SetNewtonPolicy(fine_integrator_.GetNewtonPolicy());
+
+    auto final_state = state;
+    auto observer =
+        CallbackObserver([&final_state](const TimeStepRecord& record) { final_state = record.state; }
+        );
+    integrator.Integrate(state, n_constraints, std::move(problem), observer);
+    return final_state;
+}
+
+PararealResult PararealIntegrator::Integrate(
+    const State& initial_state, size_t n_constraints, const ProblemFactory& create_problem
+) const {
+    const auto n_slices = policy_.n_slices;
+    const auto n_fine_steps = fine_integrator_.GetTimeStepper().GetNumberOfSteps() / n_slices;
+    const auto coarse_problem = create_problem();
+
+    // Predict the states of the slices with the coarse propagator
+    auto result = PararealResult{std::vector<State>{initial_state}, 0, false, {}};
+    auto& states = result.states;
+    auto coarse_states = std::vector<State>{};
+    for (size_t slice = 0; slice < n_slices; ++slice) {
+        coarse_states.emplace_back(Propagate(
+            states[slice], n_constraints, slice, policy_.coarse_steps_per_slice, coarse_problem
+        ));
+        states.emplace_back(coarse_states.back());
+    }
+
+    auto n_threads = policy_.n_threads;
+    if (n_threads == 0) {
+        n_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    auto fine_states = std::vector<State>(n_slices);
+    while (result.n_iterations < policy_.max_iterations && !result.is_converged) {
+        // Integrate the slices that are not exact yet with the fine propagator concurrently,
+        // every thread with its own problem
+        const auto first_slice = result.n_iterations;
+        auto next_slice = std::atomic<size_t>(first_slice);
+        auto errors = std::vector<std::exception_ptr>(n_slices);
+        const auto work = [&]() {
+            const auto problem = create_problem();
+            for (auto i = next_slice.fetch_add(1); i < n_slices; i = next_slice.fetch_add(1)) {
+                try {
+                    fine_states[i] = Propagate(states[i], n_constraints, i, n_fine_steps, problem);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+        const auto n_workers = std::max<size_t>(std::min(n_threads, n_slices - first_slice), 1);
+        auto workers = std::vector<std::thread>{};
+        workers.reserve(n_workers - 1);
+        for (size_t i = 1; i < n_workers; ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Correct the coarse predictions in order, the first slice is exact
+        auto correction = 0.;
+        for (size_t slice = first_slice; slice < n_slices; ++slice) {
+            auto corrected = fine_states[slice];
+            if (slice > first_slice) {
+                auto coarse_state = Propagate(
+                    states[slice], n_constraints, slice, policy_.coarse_steps_per_slice,
+                    coarse_problem
+                );
+                corrected = correct(coarse_state, fine_states[slice], coarse_states[slice]);
+                coarse_states[slice] = coarse_state;
+            }
+            correction = std::max(correction, calculate_change(corrected, states[slice + 1]));
+            states[slice + 1] = corrected;
+        }
+
+        result.n_iterations++;
+        result.corrections.push_back(correction);
+        result.is_converged = correction < policy_.tolerance || result.n_iterations >= n_slices;
+    }
+    return result;
+}
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/linearization_parameters.h"
+#include "src/rigid_pendulum_poc/state.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// Policy of the Parareal parallel-in-time integration
+struct PararealPolicy {
+    size_t n_slices = 4;                //< Number of time slices, i.e. of concurrent fine solves
+    size_t coarse_steps_per_slice = 1;  //< Time steps of the coarse propagator per slice
+    size_t max_iterations = 5;          //< Maximum number of Parareal iterations
+    double tolerance = 1e-8;            //< Maximum change of the slice states when converged
+    size_t n_threads = 0;               //< Threads of the fine solves, 0 for one per core
+};
+
+/// The results of a Parareal integration
+struct PararealResult {
+    std::vector<State> states;        //< States at the boundaries of the slices, initial first
+    size_t n_iterations;              //< Number of Parareal iterations performed
+    bool is_converged;                //< Flag to indicate if the iterations converged
+    std::vector<double> corrections;  //< Maximum change of the slice states per iteration
+};
+
+/// Creates an instance of a problem, i.e. one per concurrent time integration, since problems
+/// may cache the kinematics of their latest evaluation
+using ProblemFactory = std::function<std::shared_ptr<LinearizationParameters>()>;
+
+/*! @brief Integrates in parallel in time with the Parareal algorithm of Lions, Maday, and
+ *      Turinici (2001), i.e. corrects the prediction of a cheap coarse propagator with fine
+ *      time integrations of all time slices at once
+ *  @details The time horizon of the fine integrator's time stepper is split into slices of
+ *      equally many fine time steps. The coarse propagator is the same generalized-alpha
+ *      integrator with coarse_steps_per_slice time steps per slice. Every iteration k integrates
+ *      the slices from the states of iteration k with the fine integrator concurrently, then
+ *      sweeps the slices in order with the correction
+ *
+ *          U_{n+1}^{k+1} = G(U_n^{k+1}) + F(U_n^k) - G(U_n^k)
+ *
+ *      componentwise on the state vectors, renormalizing the quaternions of the generalized
+ *      coordinates afterwards. The states of the first k slices are exact after k iterations,
+ *      i.e. their fine integrations are skipped. The iterations stop once the largest change of
+ *      the generalized coordinates and velocities of a slice state is below the tolerance, after
+ *      max_iterations iterations, or once all slices are exact. The wall-clock time is roughly
+ *      k + 1 coarse sweeps plus k fine slice integrations, i.e. shorter than the sequential fine
+ *      integration if k is well below the number of slices and enough cores are available.
+ *      The iterations converge quickly for numerically damped integrators (spectral radius at
+ *      infinity < 1), whereas the undamped high-frequency modes of inconsistent initial
+ *      accelerations may keep the corrections from decreasing otherwise.
+ */
+class PararealIntegrator {
+public:
+    PararealIntegrator(
+        GeneralizedAlphaTimeIntegrator fine_integrator, PararealPolicy policy = PararealPolicy()
+    );
+
+    /// Returns the policy of the Parareal integration
+    inline const PararealPolicy& GetPolicy() const { return policy_; }
+
+    /// Returns the integrator whose time stepper and parameters define the fine propagator
+    inline const GeneralizedAlphaTimeIntegrator& GetFineIntegrator() const {
+        return fine_integrator_;
+    }
+
+    /// Integrates the problems of the provided factory from the provided initial state
+    PararealResult Integrate(const State&, size_t n_constraints, const ProblemFactory&) const;
+
+private:
+    GeneralizedAlphaTimeIntegrator fine_integrator_;  //< Parameters of the fine propagator
+    PararealPolicy policy_;                           //< Slices and convergence of the iterations
+
+    /// Integrates the provided problem over one slice from the provided state with the provided
+    /// number of time steps, i.e. either fine or coarse, and returns the final state
+    State Propagate(
+        const State&, size_t n_constraints, size_t slice, size_t n_steps,
+        std::shared_ptr<LinearizationParameters> problem
+    ) const;
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,103 @@
+#include "src/rigid_pendulum_poc/preconditioner.h"
+
+#include "src/rigid_pendulum_poc/execution_policy.h"
+
+namespace openturbine::rigid_pendulum {
+
+DiagonalPreconditioner::DiagonalPreconditioner(size_t size)
+    : left_scaling_(create_identity_vector(size)), right_scaling_(create_identity_vector(size)) {
+}
+
+DiagonalPreconditioner::DiagonalPreconditioner(HostView1D left_scaling, HostView1D right_scaling)
+    : left_scaling_(left_scaling), right_scaling_(right_scaling) {
+    if (left_scaling_.extent(0) != right_scaling_.extent(0)) {
+        throw std::invalid_argument("Provided left and right scaling must be of the same size");
+    }
+}
+
+void DiagonalPreconditioner::ApplyToMatrix(HostView2D matrix) const {
+    const auto size = this->GetSize();
+    if (matrix.extent(0) != size || matrix.extent(1) != size) {
+        throw std::invalid_argument(
+            "Provided matrix must be a square matrix of the size of the preconditioner"
+        );
+    }
+
+    const auto left_scaling = left_scaling_;
+    const auto right_scaling = right_scaling_;
+    host_parallel_for(
+        "precondition_matrix", size, size,
+        KOKKOS_LAMBDA(const size_t i, const size_t j) {
+            matrix(i, j) *= left_scaling(i) * right_scaling(j);
+        }
+    );
+}
+
+void DiagonalPreconditioner::ApplyToMatrix(const BlockSparseMatrix& matrix) const {
+    if (matrix.GetNumberOfRows() != this->GetSize()) {
+        throw std::invalid_argument(
+            "Provided matrix must be a square matrix of the size of the preconditioner"
+        );
+    }
+
+    const auto& block_offsets = matrix.GetBlockOffsets();
+    const auto& row_offsets = matrix.GetRowOffsets();
+    const auto& column_indices = matrix.GetColumnIndices();
+    for (size_t block_row = 0; block_row < matrix.GetNumberOfBlockRows(); ++block_row) {
+        for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1]; ++index) {
+            const auto block_column = column_indices[index];
+            const auto block = matrix.GetBlock(block_row, block_column);
+            const auto row_offset = block_offsets[block_row];
+            const auto column_offset = block_offsets[block_column];
+            for (size_t i = 0; i < block.extent(0); ++i) {
+                for (size_t j = 0; j < block.extent(1); ++j) {
+                    block(i, j) *=
+                        left_scaling_(row_offset + i) * right_scaling_(column_offset + j);
+                }
+            }
+        }
+    }
+}
+
+void DiagonalPreconditioner::ApplyToRightHandSide(HostView1D rhs) const {
+    if (rhs.extent(0) != this->GetSize()) {
+        throw std::invalid_argument("Provided vector must be of the size of the preconditioner");
+    }
+
+    const auto left_scaling = left_scaling_;
+    host_parallel_for(
+        "precondition_right_hand_side", rhs.extent(0),
+        KOKKOS_LAMBDA(const size_t i) { rhs(i) *= left_scaling(i); }
+    );
+}
+
+void DiagonalPreconditioner::ApplyToSolution(HostView1D solution) const {
+    if (solution.extent(0) != this->GetSize()) {
+        throw std::invalid_argument("Provided vector must be of the size of the preconditioner");
+    }
+
+    const auto right_scaling = right_scaling_;
+    host_parallel_for(
+        "precondition_solution", solution.extent(0),
+        KOKKOS_LAMBDA(const size_t i) { solution(i) *= right_scaling(i); }
+    );
+}
+
+DiagonalPreconditioner create_bottasso_preconditioner(
+    size_t n_velocities, size_t n_constraints, double beta, double h
+) {
+    const auto size = n_velocities + n_constraints;
+    auto left_scaling = HostView1D("left_scaling", size);
+    auto right_scaling = HostView1D("right_scaling", size);
+    const auto scale = beta * h * h;
+    host_parallel_for(
+        "create_bottasso_preconditioner", size,
+        KOKKOS_LAMBDA(const size_t i) {
+            left_scaling(i) = (i < n_velocities) ? scale : 1.;
+            right_scaling(i) = (i < n_velocities) ? 1. : 1. / scale;
+        }
+    );
+    return DiagonalPreconditioner(left_scaling, right_scaling);
+}
+
+}  // namespace openturbine::rigid_pendulum
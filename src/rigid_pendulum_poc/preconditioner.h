@@ -0,0 +1,61 @@
+#pragma once
+
+#include "src/rigid_pendulum_poc/block_sparse_matrix.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief A diagonal (row and column scaling) preconditioner of a linear system
+ *  @details The system A x = b is replaced by the preconditioned system (DL A DR) y = DL b,
+ *      whose solution gives x = DR y. Only the diagonals of DL and DR are stored, and the
+ *      scaling is applied in place to the rows and columns of the matrix, the right-hand side,
+ *      and the solution, i.e. O(n^2) work without any allocations.
+ */
+class DiagonalPreconditioner {
+public:
+    /// Constructs an identity preconditioner of the provided size
+    DiagonalPreconditioner(size_t size = 0);
+
+    /// Constructs a preconditioner from the diagonals of the left and right scaling matrices
+    DiagonalPreconditioner(HostView1D left_scaling, HostView1D right_scaling);
+
+    /// Returns the number of rows/columns of the systems the preconditioner is sized for
+    inline size_t GetSize() const { return left_scaling_.extent(0); }
+
+    /// Returns the diagonal of the left scaling matrix, DL
+    inline HostView1D GetLeftScaling() const { return left_scaling_; }
+
+    /// Returns the diagonal of the right scaling matrix, DR
+    inline HostView1D GetRightScaling() const { return right_scaling_; }
+
+    /// Scales the rows and columns of the provided matrix in place, i.e. A <- DL A DR
+    void ApplyToMatrix(HostView2D) const;
+
+    /// Scales the rows and columns of the stored blocks of the provided block sparse matrix in
+    /// place, i.e. A <- DL A DR without changing the sparsity pattern
+    void ApplyToMatrix(const BlockSparseMatrix&) const;
+
+    /// Scales the provided right-hand side in place, i.e. b <- DL b
+    void ApplyToRightHandSide(HostView1D) const;
+
+    /// Recovers the solution of the original system in place from the solution of the
+    /// preconditioned system, i.e. y <- DR y
+    void ApplyToSolution(HostView1D) const;
+
+private:
+    HostView1D left_scaling_;   //< Diagonal of the left scaling matrix
+    HostView1D right_scaling_;  //< Diagonal of the right scaling matrix
+};
+
+/*! @brief Creates the preconditioner of Bottasso, Dopico, and Trainelli, "On the optimal
+ *      scaling of index three DAEs in multibody dynamics," 2008, Multibody System Dynamics,
+ *      Vol 19, 3-20, https://doi.org/10.1007/s11044-007-9051-0
+ *  @details The equations of motion are scaled by beta * h^2 and the Lagrange multipliers
+ *      by 1 / (beta * h^2), which makes the condition number of the iteration matrix
+ *      independent of the time step
+ */
+DiagonalPreconditioner create_bottasso_preconditioner(
+    size_t n_velocities, size_t n_constraints, double beta, double h
+);
+
+}  // namespace openturbine::rigid_pendulum
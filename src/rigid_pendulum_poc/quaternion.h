@@ -1,8 +1,12 @@
 #pragma once
 
-#include <cmath>
+#include <stdexcept>
 #include <tuple>
+#include <type_traits>
 
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/matrix.h"
 #include "src/rigid_pendulum_poc/utilities.h"
 #include "src/rigid_pendulum_poc/vector.h"
 
@@ -11,30 +15,36 @@ namespace openturbine::rigid_pendulum {
 // TODO: Refactor to create a Matrix class
 using RotationMatrix = std::tuple<Vector, Vector, Vector>;
 
-/// @brief Class to represent a quaternion
+/*! @brief Class to represent a quaternion
+ *  @details Trivially copyable and callable from host and device code, like Vector
+ */
 class Quaternion {
 public:
     /// Constructs a quaternion based on provided values - if none provided, the quaternion is
     /// initialized to a null quaternion
-    Quaternion(double q0 = 0., double q1 = 0., double q2 = 0., double q3 = 0.);
+    KOKKOS_INLINE_FUNCTION constexpr Quaternion(
+        double q0 = 0., double q1 = 0., double q2 = 0., double q3 = 0.
+    )
+        : q0_(q0), q1_(q1), q2_(q2), q3_(q3) {}
 
-    /// Returns the values of the quaternion
+    /// Returns the values of the quaternion - host only, use the individual components on the
+    /// device
     std::tuple<double, double, double, double> GetComponents() const { return {q0_, q1_, q2_, q3_}; }
 
     /// Returns the first component of the quaternion
-    inline double GetScalarComponent() const { return q0_; }
+    KOKKOS_INLINE_FUNCTION constexpr double GetScalarComponent() const { return q0_; }
 
     /// Returns the second component of the quaternion
-    inline double GetXComponent() const { return q1_; }
+    KOKKOS_INLINE_FUNCTION constexpr double GetXComponent() const { return q1_; }
 
     /// Returns the third component of the quaternion
-    inline double GetYComponent() const { return q2_; }
+    KOKKOS_INLINE_FUNCTION constexpr double GetYComponent() const { return q2_; }
 
     /// Returns the fourth component of the quaternion
-    inline double GetZComponent() const { return q3_; }
+    KOKKOS_INLINE_FUNCTION constexpr double GetZComponent() const { return q3_; }
 
     /// Adds provided quaternion to this quaternion and returns the result
-    inline Quaternion operator+(const Quaternion& other) const {
+    KOKKOS_INLINE_FUNCTION constexpr Quaternion operator+(const Quaternion& other) const {
         return Quaternion(
             this->q0_ + other.q0_, this->q1_ + other.q1_, this->q2_ + other.q2_,
             this->q3_ + other.q3_
@@ -42,7 +52,7 @@ public:
     }
 
     /// Subtracts provided quaternion from this quaternion and returns the result
-    inline Quaternion operator-(const Quaternion& other) const {
+    KOKKOS_INLINE_FUNCTION constexpr Quaternion operator-(const Quaternion& other) const {
         return Quaternion(
             this->q0_ - other.q0_, this->q1_ - other.q1_, this->q2_ - other.q2_,
             this->q3_ - other.q3_
@@ -50,7 +60,7 @@ public:
     }
 
     /// Multiplies provided quaternion with this quaternion and returns the result
-    inline Quaternion operator*(const Quaternion& other) const {
+    KOKKOS_INLINE_FUNCTION constexpr Quaternion operator*(const Quaternion& other) const {
         return Quaternion(
             this->q0_ * other.q0_ - this->q1_ * other.q1_ - this->q2_ * other.q2_ -
                 this->q3_ * other.q3_,
@@ -64,40 +74,56 @@ public:
     }
 
     /// Multiplies this quaternion with a scalar and returns the result
-    inline Quaternion operator*(double scalar) const {
+    KOKKOS_INLINE_FUNCTION constexpr Quaternion operator*(double scalar) const {
         return Quaternion(
             this->q0_ * scalar, this->q1_ * scalar, this->q2_ * scalar, this->q3_ * scalar
         );
     }
 
     /// Divides this quaternion with a scalar and returns the result
-    inline Quaternion operator/(double scalar) const {
+    KOKKOS_INLINE_FUNCTION constexpr Quaternion operator/(double scalar) const {
         return Quaternion(
             this->q0_ / scalar, this->q1_ / scalar, this->q2_ / scalar, this->q3_ / scalar
         );
     }
 
     /// Returns the length/Euclidean/L2 norm of the quaternion
-    inline double Length() const {
-        return std::sqrt(
+    KOKKOS_INLINE_FUNCTION double Length() const {
+        using Kokkos::sqrt;
+        return sqrt(
             this->q0_ * this->q0_ + this->q1_ * this->q1_ + this->q2_ * this->q2_ +
             this->q3_ * this->q3_
         );
     }
 
     /// Returns if the quaternion is a unit quaternion
-    bool IsUnitQuaternion() const;
+    KOKKOS_INLINE_FUNCTION bool IsUnitQuaternion() const { return close_to(Length(), 1.); }
+
+    /// Returns a unit quaternion based on the this quaternion - throws on the host/aborts on the
+    /// device for a null quaternion
+    KOKKOS_INLINE_FUNCTION Quaternion GetUnitQuaternion() const {
+        const auto length = Length();
+
+        if (close_to(length, 0.)) {
+            report_error<std::runtime_error>("Quaternion length is zero, cannot normalize!");
+        }
+
+        if (close_to(length, 1.)) {
+            return *this;
+        }
 
-    /// Returns a unit quaternion based on the this quaternion
-    Quaternion GetUnitQuaternion() const;
+        return *this / length;
+    }
 
     /// Returns the conjugate of this quaternion
-    inline Quaternion GetConjugate() const {
+    KOKKOS_INLINE_FUNCTION constexpr Quaternion GetConjugate() const {
         return Quaternion(this->q0_, -this->q1_, -this->q2_, -this->q3_);
     }
 
     /// Returns the inverse of this quaternion
-    inline Quaternion GetInverse() const { return GetConjugate() / (Length() * Length()); }
+    KOKKOS_INLINE_FUNCTION Quaternion GetInverse() const {
+        return GetConjugate() / (Length() * Length());
+    }
 
 private:
     double q0_;
@@ -106,11 +132,100 @@ private:
     double q3_;
 };
 
+static_assert(std::is_trivially_copyable_v<Quaternion>, "Quaternion must be trivially copyable");
+
+/*! @brief The scalar coefficients of the exponential map of a rotation vector {psi} of angle
+ *      phi = |{psi}|, i.e. of its quaternion and of its tangent operator
+ *  @details Evaluated with one sine and cosine of phi / 2, since sin(phi) = 2 sin(phi / 2)
+ *      cos(phi / 2) and cos(phi) - 1 = -2 sin^2(phi / 2). Small angles use the Taylor series of
+ *      the coefficients instead, which are selected rather than branched to, i.e. the kernels
+ *      calling this are free of branches.
+ */
+struct ExponentialMapCoefficients {
+    double cos_half_angle;   //< cos(phi / 2), the scalar component of the quaternion
+    double vector_factor;    //< sin(phi / 2) / phi, the factor of {psi} of the quaternion
+    double cos_coefficient;  //< (cos(phi) - 1) / phi^2, the factor of ~{psi} of [T]
+    double sin_coefficient;  //< (1 - sin(phi) / phi) / phi^2, the factor of ~{psi}^2 of [T]
+};
+
+/// Returns the coefficients of the exponential map of a rotation vector with the provided
+/// squared angle
+KOKKOS_INLINE_FUNCTION ExponentialMapCoefficients
+calculate_exponential_map_coefficients(double angle_squared) {
+    // Below this squared angle the truncation error of the series, O(phi^8), is smaller than the
+    // cancellation error of (1 - sin(phi) / phi) / phi^2, O(eps / phi^2)
+    constexpr double kSmallAngleSquared = 0.02;
+
+    const auto angle = Kokkos::sqrt(angle_squared);
+    const auto is_small = angle_squared < kSmallAngleSquared;
+    const auto safe_angle = is_small ? 1. : angle;
+    const auto sin_half = Kokkos::sin(0.5 * angle);
+    const auto cos_half = Kokkos::cos(0.5 * angle);
+
+    const auto a2 = angle_squared;
+    const auto vector_factor =
+        is_small ? 0.5 - a2 / 48. + a2 * a2 / 3840. - a2 * a2 * a2 / 645120.
+                 : sin_half / safe_angle;
+    const auto sin_coefficient =
+        is_small ? 1. / 6. - a2 / 120. + a2 * a2 / 5040. - a2 * a2 * a2 / 362880.
+                 : (1. - 2. * vector_factor * cos_half) / (safe_angle * safe_angle);
+    return {cos_half, vector_factor, -2. * vector_factor * vector_factor, sin_coefficient};
+}
+
 /// Returns a 4-D quaternion from provided 3-D rotation vector, i.e. exponential map
-Quaternion quaternion_from_rotation_vector(const Vector&);
+KOKKOS_INLINE_FUNCTION Quaternion quaternion_from_rotation_vector(const Vector& vector) {
+    const auto v0 = vector.GetXComponent();
+    const auto v1 = vector.GetYComponent();
+    const auto v2 = vector.GetZComponent();
+    const auto c = calculate_exponential_map_coefficients(v0 * v0 + v1 * v1 + v2 * v2);
+
+    return Quaternion(
+        c.cos_half_angle, v0 * c.vector_factor, v1 * c.vector_factor, v2 * c.vector_factor
+    );
+}
+
+/// @brief The exponential map of a rotation vector {psi}, i.e. its unit quaternion together with
+///     the rotational block of its tangent operator [T(psi)]
+struct ExponentialMap {
+    Quaternion quaternion;          //< Quaternion of the rotation
+    Matrix<3, 3> tangent_operator;  //< Rotational block of the tangent operator [T(psi)]
+
+    /// Evaluates the quaternion and the tangent operator of the provided rotation vector with
+    /// one sine and cosine, see ExponentialMapCoefficients
+    KOKKOS_INLINE_FUNCTION static ExponentialMap Calculate(const Vec<3>& psi) {
+        const auto c = calculate_exponential_map_coefficients(psi.DotProduct(psi));
+        const auto psi_matrix = create_cross_product_matrix(psi);
+        return {
+            Quaternion(
+                c.cos_half_angle, psi(0) * c.vector_factor, psi(1) * c.vector_factor,
+                psi(2) * c.vector_factor
+            ),
+            Matrix<3, 3>::Identity() + psi_matrix * c.cos_coefficient +
+                (psi_matrix * psi_matrix) * c.sin_coefficient};
+    }
+};
 
 /// Returns a 3-D rotation vector from provided 4-D quaternion, i.e. logarithmic map
-Vector rotation_vector_from_quaternion(const Quaternion&);
+KOKKOS_INLINE_FUNCTION Vector rotation_vector_from_quaternion(const Quaternion& quaternion) {
+    using Kokkos::atan2;
+    using Kokkos::sqrt;
+
+    const auto q0 = quaternion.GetScalarComponent();
+    const auto q1 = quaternion.GetXComponent();
+    const auto q2 = quaternion.GetYComponent();
+    const auto q3 = quaternion.GetZComponent();
+    const auto sin_angle_squared = q1 * q1 + q2 * q2 + q3 * q3;
+
+    // Return the rotation vector {0, 0, 0} if provided quaternion is null
+    if (close_to(sin_angle_squared, 0.)) {
+        return Vector{0.0, 0.0, 0.0};
+    }
+
+    const double sin_angle = sqrt(sin_angle_squared);
+    const double k = 2. * atan2(sin_angle, q0) / sin_angle;
+
+    return {q1 * k, q2 * k, q3 * k};
+}
 
 /*!
  * @brief Returns a quaternion from provided Euler parameters/angle-axis representation of rotation
@@ -118,22 +233,85 @@ Vector rotation_vector_from_quaternion(const Quaternion&);
  * @param axis Axis of rotation, a unit vector
  * @return Unit quaternion representing the rotation
  */
-Quaternion quaternion_from_angle_axis(double angle, const Vector&);
+KOKKOS_INLINE_FUNCTION Quaternion quaternion_from_angle_axis(double angle, const Vector& axis) {
+    using Kokkos::cos;
+    using Kokkos::sin;
+
+    const double sin_angle = sin(angle / 2.0);
+    const double cos_angle = cos(angle / 2.0);
+
+    // We should always get a unit quaternion from the following components
+    return Quaternion(
+        cos_angle, axis.GetXComponent() * sin_angle, axis.GetYComponent() * sin_angle,
+        axis.GetZComponent() * sin_angle
+    );
+}
 
 /*!
  * @brief Returns Euler parameters/angle-axis representation of rotation from provided quaternion
  * @param quaternion Quaternion to be converted
- * @return Tuple of angle of rotation in radians and axis of rotation as a unit vector
+ * @return Tuple of angle of rotation in radians and axis of rotation as a unit vector - host only
  */
 std::tuple<double, Vector> angle_axis_from_quaternion(const Quaternion&);
 
-/// Rotates provided vector by provided *unit* quaternion and returns the result
-Vector rotate_vector(const Quaternion&, const Vector&);
+/// Rotates provided vector by provided *unit* quaternion and returns the result - throws on the
+/// host/aborts on the device if the quaternion is not a unit quaternion
+KOKKOS_INLINE_FUNCTION Vector rotate_vector(const Quaternion& quaternion, const Vector& vector) {
+    if (!quaternion.IsUnitQuaternion()) {
+        report_error<std::invalid_argument>("Must be a unit quaternion to rotate a vector");
+    }
+
+    const auto v0 = vector.GetXComponent();
+    const auto v1 = vector.GetYComponent();
+    const auto v2 = vector.GetZComponent();
+    const auto q0 = quaternion.GetScalarComponent();
+    const auto q1 = quaternion.GetXComponent();
+    const auto q2 = quaternion.GetYComponent();
+    const auto q3 = quaternion.GetZComponent();
 
-/// Converts a 4x1 quaternion to a 3x3 rotation matrix and returns the result
+    return Vector{
+        (q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * v0 + 2. * (q1 * q2 - q0 * q3) * v1 +
+            2. * (q1 * q3 + q0 * q2) * v2,
+        2. * (q1 * q2 + q0 * q3) * v0 + (q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3) * v1 +
+            2. * (q2 * q3 - q0 * q1) * v2,
+        2. * (q1 * q3 - q0 * q2) * v0 + 2. * (q2 * q3 + q0 * q1) * v1 +
+            (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3) * v2};
+}
+
+/// Converts a 4x1 quaternion to a 3x3 rotation matrix, stored as a tuple of its rows, and
+/// returns the result - host only
 RotationMatrix quaternion_to_rotation_matrix(const Quaternion&);
 
 /// Converts a 3x3 rotation matrix to a 4x1 quaternion and returns the result
+KOKKOS_INLINE_FUNCTION Quaternion rotation_matrix_to_quaternion(const Matrix<3, 3>& m) {
+    using Kokkos::sqrt;
+
+    const auto trace = m(0, 0) + m(1, 1) + m(2, 2);
+
+    if (trace > 0) {
+        const auto s = 0.5 / sqrt(trace + 1.0);
+        return Quaternion{
+            0.25 / s, (m(2, 1) - m(1, 2)) * s, (m(0, 2) - m(2, 0)) * s, (m(1, 0) - m(0, 1)) * s};
+    } else if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+        const auto s = 2.0 * sqrt(1.0 + m(0, 0) - m(1, 1) - m(2, 2));
+        return Quaternion(
+            (m(2, 1) - m(1, 2)) / s, 0.25 * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s
+        );
+    } else if (m(1, 1) > m(2, 2)) {
+        const auto s = 2.0 * sqrt(1.0 + m(1, 1) - m(0, 0) - m(2, 2));
+        return Quaternion(
+            (m(0, 2) - m(2, 0)) / s, (m(0, 1) + m(1, 0)) / s, 0.25 * s, (m(1, 2) + m(2, 1)) / s
+        );
+    } else {
+        const auto s = 2.0 * sqrt(1.0 + m(2, 2) - m(0, 0) - m(1, 1));
+        return Quaternion(
+            (m(1, 0) - m(0, 1)) / s, (m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, 0.25 * s
+        );
+    }
+}
+
+/// Converts a 3x3 rotation matrix, stored as a tuple of its rows, to a 4x1 quaternion and
+/// returns the result - host only
 Quaternion rotation_matrix_to_quaternion(const RotationMatrix&);
 
 }  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,293 @@
+#include "src/rigid_pendulum_poc/quaternion_array.h"
+
+#include <stdexcept>
+
+namespace openturbine::rigid_pendulum {
+
+namespace {
+
+/// Sines below which the logarithmic map uses its series expansion
+constexpr double kSMALL_ANGLE = 1e-4;
+
+/// Throws if the provided arrays are not of the same size
+template <typename ArrayA, typename ArrayB>
+void check_sizes(const ArrayA& a, const ArrayB& b) {
+    if (a.GetSize() != b.GetSize()) {
+        throw std::invalid_argument("The provided arrays must be of the same size");
+    }
+}
+
+/// Copies the provided values into the column of a (component, index) view
+template <typename View, size_t N>
+void set_column(const View& view, size_t index, const double (&values)[N]) {
+    if (index >= view.extent(1)) {
+        throw std::out_of_range("The provided index is out of range");
+    }
+
+    auto host_view = Kokkos::create_mirror_view(view);
+    Kokkos::deep_copy(host_view, view);
+    for (size_t i = 0; i < N; ++i) {
+        host_view(i, index) = values[i];
+    }
+    Kokkos::deep_copy(view, host_view);
+}
+
+/// Returns a host copy of a (component, index) view, after checking the provided index
+template <typename View>
+auto get_host_copy(const View& view, size_t index) {
+    if (index >= view.extent(1)) {
+        throw std::out_of_range("The provided index is out of range");
+    }
+    return Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), view);
+}
+
+}  // namespace
+
+template <typename MemorySpace>
+VectorArray<MemorySpace>::VectorArray(size_t n)
+    : components_("vector_array", kNumberOfComponents, n) {
+}
+
+template <typename MemorySpace>
+void VectorArray<MemorySpace>::SetVector(size_t index, const Vector& vector) {
+    auto [x, y, z] = vector.GetComponents();
+    set_column(components_, index, {x, y, z});
+}
+
+template <typename MemorySpace>
+Vector VectorArray<MemorySpace>::GetVector(size_t index) const {
+    const auto host_view = get_host_copy(components_, index);
+    return Vector(host_view(0, index), host_view(1, index), host_view(2, index));
+}
+
+template <typename MemorySpace>
+QuaternionArray<MemorySpace>::QuaternionArray(size_t n)
+    : components_("quaternion_array", kNumberOfComponents, n) {
+}
+
+template <typename MemorySpace>
+void QuaternionArray<MemorySpace>::SetQuaternion(size_t index, const Quaternion& quaternion) {
+    auto [q0, q1, q2, q3] = quaternion.GetComponents();
+    set_column(components_, index, {q0, q1, q2, q3});
+}
+
+template <typename MemorySpace>
+Quaternion QuaternionArray<MemorySpace>::GetQuaternion(size_t index) const {
+    const auto host_view = get_host_copy(components_, index);
+    return Quaternion(
+        host_view(0, index), host_view(1, index), host_view(2, index), host_view(3, index)
+    );
+}
+
+template <typename ExecutionSpace>
+void compose_quaternions(
+    const QuaternionArray<typename ExecutionSpace::memory_space>& a,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& b,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& result
+) {
+    check_sizes(a, b);
+    check_sizes(a, result);
+
+    const auto p = a.GetComponents();
+    const auto q = b.GetComponents();
+    const auto r = result.GetComponents();
+    Kokkos::parallel_for(
+        "compose_quaternions", Kokkos::RangePolicy<ExecutionSpace>(0, a.GetSize()),
+        KOKKOS_LAMBDA(const size_t i) {
+            const auto p0 = p(0, i);
+            const auto p1 = p(1, i);
+            const auto p2 = p(2, i);
+            const auto p3 = p(3, i);
+            const auto q0 = q(0, i);
+            const auto q1 = q(1, i);
+            const auto q2 = q(2, i);
+            const auto q3 = q(3, i);
+            r(0, i) = p0 * q0 - p1 * q1 - p2 * q2 - p3 * q3;
+            r(1, i) = p0 * q1 + p1 * q0 + p2 * q3 - p3 * q2;
+            r(2, i) = p0 * q2 - p1 * q3 + p2 * q0 + p3 * q1;
+            r(3, i) = p0 * q3 + p1 * q2 - p2 * q1 + p3 * q0;
+        }
+    );
+}
+
+template <typename ExecutionSpace>
+void rotate_vectors(
+    const QuaternionArray<typename ExecutionSpace::memory_space>& quaternions,
+    const VectorArray<typename ExecutionSpace::memory_space>& vectors,
+    const VectorArray<typename ExecutionSpace::memory_space>& result
+) {
+    check_sizes(quaternions, vectors);
+    check_sizes(quaternions, result);
+
+    const auto q = quaternions.GetComponents();
+    const auto v = vectors.GetComponents();
+    const auto r = result.GetComponents();
+    Kokkos::parallel_for(
+        "rotate_vectors", Kokkos::RangePolicy<ExecutionSpace>(0, quaternions.GetSize()),
+        KOKKOS_LAMBDA(const size_t i) {
+            const auto q0 = q(0, i);
+            const auto q1 = q(1, i);
+            const auto q2 = q(2, i);
+            const auto q3 = q(3, i);
+            const auto v0 = v(0, i);
+            const auto v1 = v(1, i);
+            const auto v2 = v(2, i);
+            // Same as rotate_vector(), i.e. {v'} = [R(q)] {v}
+            r(0, i) = (q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * v0 +
+                      2. * (q1 * q2 - q0 * q3) * v1 + 2. * (q1 * q3 + q0 * q2) * v2;
+            r(1, i) = 2. * (q1 * q2 + q0 * q3) * v0 +
+                      (q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3) * v1 + 2. * (q2 * q3 - q0 * q1) * v2;
+            r(2, i) = 2. * (q1 * q3 - q0 * q2) * v0 + 2. * (q2 * q3 + q0 * q1) * v1 +
+                      (q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3) * v2;
+        }
+    );
+}
+
+template <typename ExecutionSpace>
+void quaternions_from_rotation_vectors(
+    const VectorArray<typename ExecutionSpace::memory_space>& rotation_vectors,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& result
+) {
+    check_sizes(rotation_vectors, result);
+
+    const auto v = rotation_vectors.GetComponents();
+    const auto q = result.GetComponents();
+    Kokkos::parallel_for(
+        "quaternions_from_rotation_vectors",
+        Kokkos::RangePolicy<ExecutionSpace>(0, rotation_vectors.GetSize()),
+        KOKKOS_LAMBDA(const size_t i) {
+            const auto v0 = v(0, i);
+            const auto v1 = v(1, i);
+            const auto v2 = v(2, i);
+
+            // Small angles select the series of sin(angle/2)/angle instead of branching to the
+            // null rotation, see ExponentialMapCoefficients
+            const auto c = calculate_exponential_map_coefficients(v0 * v0 + v1 * v1 + v2 * v2);
+            q(0, i) = c.cos_half_angle;
+            q(1, i) = v0 * c.vector_factor;
+            q(2, i) = v1 * c.vector_factor;
+            q(3, i) = v2 * c.vector_factor;
+        }
+    );
+}
+
+template <typename ExecutionSpace>
+void exponential_maps(
+    const VectorArray<typename ExecutionSpace::memory_space>& rotation_vectors,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& quaternions,
+    const View3D<typename ExecutionSpace::memory_space>& tangent_operators
+) {
+    check_sizes(rotation_vectors, quaternions);
+    if (tangent_operators.extent(0) != 3 || tangent_operators.extent(1) != 3 ||
+        tangent_operators.extent(2) != rotation_vectors.GetSize()) {
+        throw std::invalid_argument(
+            "The tangent operators must be a 3 x 3 x (number of rotation vectors) view"
+        );
+    }
+
+    const auto v = rotation_vectors.GetComponents();
+    const auto q = quaternions.GetComponents();
+    const auto t = tangent_operators;
+    Kokkos::parallel_for(
+        "exponential_maps", Kokkos::RangePolicy<ExecutionSpace>(0, rotation_vectors.GetSize()),
+        KOKKOS_LAMBDA(const size_t i) {
+            const auto v0 = v(0, i);
+            const auto v1 = v(1, i);
+            const auto v2 = v(2, i);
+            const auto c = calculate_exponential_map_coefficients(v0 * v0 + v1 * v1 + v2 * v2);
+            q(0, i) = c.cos_half_angle;
+            q(1, i) = v0 * c.vector_factor;
+            q(2, i) = v1 * c.vector_factor;
+            q(3, i) = v2 * c.vector_factor;
+
+            // [T] = [I] + a ~{v} + b ~{v} ~{v}, where ~{v} ~{v} = {v} {v}^T - |{v}|^2 [I]
+            const auto a = c.cos_coefficient;
+            const auto b = c.sin_coefficient;
+            const auto diagonal = 1. - b * (v0 * v0 + v1 * v1 + v2 * v2);
+            t(0, 0, i) = diagonal + b * v0 * v0;
+            t(0, 1, i) = -a * v2 + b * v0 * v1;
+            t(0, 2, i) = a * v1 + b * v0 * v2;
+            t(1, 0, i) = a * v2 + b * v1 * v0;
+            t(1, 1, i) = diagonal + b * v1 * v1;
+            t(1, 2, i) = -a * v0 + b * v1 * v2;
+            t(2, 0, i) = -a * v1 + b * v2 * v0;
+            t(2, 1, i) = a * v0 + b * v2 * v1;
+            t(2, 2, i) = diagonal + b * v2 * v2;
+        }
+    );
+}
+
+template <typename ExecutionSpace>
+void rotation_vectors_from_quaternions(
+    const QuaternionArray<typename ExecutionSpace::memory_space>& quaternions,
+    const VectorArray<typename ExecutionSpace::memory_space>& result
+) {
+    check_sizes(quaternions, result);
+
+    const auto q = quaternions.GetComponents();
+    const auto v = result.GetComponents();
+    Kokkos::parallel_for(
+        "rotation_vectors_from_quaternions",
+        Kokkos::RangePolicy<ExecutionSpace>(0, quaternions.GetSize()),
+        KOKKOS_LAMBDA(const size_t i) {
+            const auto q0 = q(0, i);
+            const auto q1 = q(1, i);
+            const auto q2 = q(2, i);
+            const auto q3 = q(3, i);
+            const auto sin_angle_squared = q1 * q1 + q2 * q2 + q3 * q3;
+            const auto sin_angle = Kokkos::sqrt(sin_angle_squared);
+
+            // 2 atan2(sin, cos) / sin is replaced by its series for small sines, see above
+            const auto is_small = sin_angle < kSMALL_ANGLE;
+            const auto safe_sin_angle = is_small ? 1. : sin_angle;
+            const auto k = is_small
+                               ? (2. / q0) * (1. - sin_angle_squared / (3. * q0 * q0))
+                               : 2. * Kokkos::atan2(safe_sin_angle, q0) / safe_sin_angle;
+            v(0, i) = q1 * k;
+            v(1, i) = q2 * k;
+            v(2, i) = q3 * k;
+        }
+    );
+}
+
+template class VectorArray<Kokkos::HostSpace>;
+template class QuaternionArray<Kokkos::HostSpace>;
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+template class VectorArray<DeviceMemorySpace>;
+template class QuaternionArray<DeviceMemorySpace>;
+#endif
+
+/// Instantiates the batched operations for the provided execution space
+#define OTURB_INSTANTIATE_QUATERNION_ARRAY_OPERATIONS(ExecutionSpace)                           \
+    template void compose_quaternions<ExecutionSpace>(                                          \
+        const QuaternionArray<ExecutionSpace::memory_space>&,                                   \
+        const QuaternionArray<ExecutionSpace::memory_space>&,                                   \
+        const QuaternionArray<ExecutionSpace::memory_space>&                                    \
+    );                                                                                          \
+    template void rotate_vectors<ExecutionSpace>(                                               \
+        const QuaternionArray<ExecutionSpace::memory_space>&,                                   \
+        const VectorArray<ExecutionSpace::memory_space>&,                                       \
+        const VectorArray<ExecutionSpace::memory_space>&                                        \
+    );                                                                                          \
+    template void quaternions_from_rotation_vectors<ExecutionSpace>(                            \
+        const VectorArray<ExecutionSpace::memory_space>&,                                       \
+        const QuaternionArray<ExecutionSpace::memory_space>&                                    \
+    );                                                                                          \
+    template void exponential_maps<ExecutionSpace>(                                             \
+        const VectorArray<ExecutionSpace::memory_space>&,                                       \
+        const QuaternionArray<ExecutionSpace::memory_space>&,                                   \
+        const View3D<ExecutionSpace::memory_space>&                                             \
+    );                                                                                          \
+    template void rotation_vectors_from_quaternions<ExecutionSpace>(                            \
+        const QuaternionArray<ExecutionSpace::memory_space>&,                                   \
+        const VectorArray<ExecutionSpace::memory_space>&                                        \
+    )
+
+OTURB_INSTANTIATE_QUATERNION_ARRAY_OPERATIONS(Kokkos::DefaultHostExecutionSpace);
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+OTURB_INSTANTIATE_QUATERNION_ARRAY_OPERATIONS(Kokkos::DefaultExecutionSpace);
+#endif
+
+#undef OTURB_INSTANTIATE_QUATERNION_ARRAY_OPERATIONS
+
+}  // namespace openturbine::rigid_pendulum
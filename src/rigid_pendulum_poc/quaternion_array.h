@@ -0,0 +1,123 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/quaternion.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+#include "src/rigid_pendulum_poc/vector.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief Class to store many 3-D vectors, e.g. the positions of all nodes of a blade
+ *  @details The vectors are stored in a struct-of-arrays layout, i.e. as a (component, index)
+ *      view so that a given component of all vectors is contiguous in memory, which lets the
+ *      batched kernels below vectorize over the vectors
+ */
+template <typename MemorySpace = DeviceMemorySpace>
+class VectorArray {
+public:
+    using memory_space = MemorySpace;
+
+    static constexpr size_t kNumberOfComponents = 3;
+
+    /// Constructs an array of n null vectors
+    VectorArray(size_t n = 0);
+
+    /// Returns the number of vectors in the array
+    inline size_t GetSize() const { return components_.extent(1); }
+
+    /// Returns the components of all vectors as a (component, index) view
+    inline View2D<MemorySpace> GetComponents() const { return components_; }
+
+    /*! @brief Sets the vector at the provided index
+     *  @details Meant for setting up/inspecting individual vectors - when the view lives in
+     *      device memory every call copies all vectors between host and device
+     */
+    void SetVector(size_t index, const Vector&);
+
+    /// Returns a (host) copy of the vector at the provided index
+    Vector GetVector(size_t index) const;
+
+private:
+    View2D<MemorySpace> components_;  //< Components of the vectors, (component, index)
+};
+
+/// @brief Class to store many quaternions, e.g. the orientations of all bodies of an ensemble,
+///     in the same struct-of-arrays layout as VectorArray
+template <typename MemorySpace = DeviceMemorySpace>
+class QuaternionArray {
+public:
+    using memory_space = MemorySpace;
+
+    static constexpr size_t kNumberOfComponents = 4;
+
+    /// Constructs an array of n null quaternions
+    QuaternionArray(size_t n = 0);
+
+    /// Returns the number of quaternions in the array
+    inline size_t GetSize() const { return components_.extent(1); }
+
+    /// Returns the components of all quaternions as a (component, index) view, the scalar
+    /// component first
+    inline View2D<MemorySpace> GetComponents() const { return components_; }
+
+    /// Sets the quaternion at the provided index, see VectorArray::SetVector()
+    void SetQuaternion(size_t index, const Quaternion&);
+
+    /// Returns a (host) copy of the quaternion at the provided index
+    Quaternion GetQuaternion(size_t index) const;
+
+private:
+    View2D<MemorySpace> components_;  //< Components of the quaternions, (component, index)
+};
+
+// Batched counterparts of the quaternion operations in quaternion.h: every function is a single
+// parallel_for over all entries of the arrays on the provided execution space, whose memory space
+// must hold the arrays. Only the sizes of the arrays are checked - the kernels are free of branches
+// and of any checks of the entries, i.e. the quaternions to rotate with must be unit quaternions,
+// so that compilers vectorize them over the unit-stride components.
+
+/// Returns the product a * b of every pair of quaternions in the provided result array
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+void compose_quaternions(
+    const QuaternionArray<typename ExecutionSpace::memory_space>& a,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& b,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& result
+);
+
+/// Returns every vector rotated by the (unit) quaternion at the same index in the provided
+/// result array
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+void rotate_vectors(
+    const QuaternionArray<typename ExecutionSpace::memory_space>& quaternions,
+    const VectorArray<typename ExecutionSpace::memory_space>& vectors,
+    const VectorArray<typename ExecutionSpace::memory_space>& result
+);
+
+/// Returns the quaternions of the provided rotation vectors, i.e. exponential map, in the
+/// provided result array
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+void quaternions_from_rotation_vectors(
+    const VectorArray<typename ExecutionSpace::memory_space>& rotation_vectors,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& result
+);
+
+/// Returns the quaternions and the rotational blocks of the tangent operators of the provided
+/// rotation vectors in the provided result arrays, i.e. the batched ExponentialMap::Calculate() -
+/// the tangent operators are a (row, column, index) view
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+void exponential_maps(
+    const VectorArray<typename ExecutionSpace::memory_space>& rotation_vectors,
+    const QuaternionArray<typename ExecutionSpace::memory_space>& quaternions,
+    const View3D<typename ExecutionSpace::memory_space>& tangent_operators
+);
+
+/// Returns the rotation vectors of the provided quaternions, i.e. logarithmic map, in the
+/// provided result array
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace>
+void rotation_vectors_from_quaternions(
+    const QuaternionArray<typename ExecutionSpace::memory_space>& quaternions,
+    const VectorArray<typename ExecutionSpace::memory_space>& result
+);
+
+}  // namespace openturbine::rigid_pendulum
@@ -1,12 +1,23 @@
 #include "src/rigid_pendulum_poc/solver.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <lapacke.h>
 
+#include "src/rigid_pendulum_poc/execution_policy.h"
 #include "src/utilities/log.h"
+#include "src/utilities/metrics.h"
 
 namespace openturbine::rigid_pendulum {
 
 void solve_linear_system(HostView2D system, HostView1D solution) {
+    auto pivots = HostIntView1D("pivots", solution.size());
+    solve_linear_system(system, solution, pivots);
+}
+
+void solve_linear_system(HostView2D system, HostView1D solution, HostIntView1D pivots) {
     auto rows = static_cast<int>(system.extent(0));
     auto columns = static_cast<int>(system.extent(1));
 
@@ -20,13 +31,17 @@ void solve_linear_system(HostView2D system, HostView1D solution) {
         );
     }
 
+    if (rows != static_cast<int>(pivots.extent(0))) {
+        throw std::invalid_argument(
+            "Provided pivots must contain the same number of rows as the system"
+        );
+    }
+
     int right_hand_sides{1};
     int leading_dimension_sytem{rows};
-    auto pivots = Kokkos::View<int*, Kokkos::DefaultHostExecutionSpace>("pivots", solution.size());
     int leading_dimension_solution{1};
 
-    auto log = util::Log::Get();
-    log->Info(
+    OTURB_LOG_DEBUG(
         "Solving a " + std::to_string(rows) + " x " + std::to_string(rows) +
         " system of linear equations with LAPACKE_dgesv" + "\n"
     );
@@ -47,11 +62,933 @@ void solve_linear_system(HostView2D system, HostView1D solution) {
         leading_dimension_solution  // input: leading dimension of solution
     );
 
-    log->Info("LAPACKE_dgesv returned exit code " + std::to_string(info) + "\n");
+    OTURB_LOG_DEBUG("LAPACKE_dgesv returned exit code " + std::to_string(info) + "\n");
 
     if (info != 0) {
         throw std::runtime_error("LAPACKE_dgesv failed to solve the system!");
     }
 }
 
+void solve_linear_system(const BlockSparseMatrix& system, HostView1D solution) {
+    auto solver = BandedLinearSolver();
+    solver.Factorize(system);
+    solver.Solve(solution);
+}
+
+DenseLinearSolver::DenseLinearSolver(
+    size_t size, FactorizationPrecision precision, size_t max_refinement_iterations
+)
+    : precision_(precision),
+      max_refinement_iterations_(max_refinement_iterations),
+      factors_("factors", size, size),
+      pivots_("pivots", size),
+      is_factorized_(false),
+      is_refined_(false),
+      n_factorizations_(0),
+      n_refinement_iterations_(0),
+      n_fallbacks_(0),
+      system_norm_(0.) {
+    if (precision_ == FactorizationPrecision::kMIXED && max_refinement_iterations_ == 0) {
+        throw std::invalid_argument("The maximum number of refinement iterations must be > 0");
+    }
+}
+
+void DenseLinearSolver::Factorize(const HostView2D system) {
+    if (system.extent(0) != system.extent(1)) {
+        throw std::invalid_argument("Provided system must be a square matrix");
+    }
+
+    // Only (re)allocate the storage when the size of the system changes
+    const auto n = system.extent(0);
+    if (n != this->GetSize()) {
+        factors_ = HostView2D("factors", n, n);
+        pivots_ = HostIntView1D("pivots", n);
+    }
+
+    static auto& factorizations = util::MetricsRegistry::Get().GetCounter(
+        "openturbine_factorizations_total", "Number of dense LU factorizations"
+    );
+    factorizations.Increment();
+
+    if (precision_ == FactorizationPrecision::kDOUBLE) {
+        this->FactorizeDouble(system);
+        return;
+    }
+
+    if (n != system_.extent(0)) {
+        system_ = HostView2D("system", n, n);
+        single_factors_ = Kokkos::View<float**, Kokkos::HostSpace>("single_factors", n, n);
+        correction_ = Kokkos::View<float*, Kokkos::HostSpace>("correction", n);
+        right_hand_side_ = HostView1D("right_hand_side", n);
+        residual_ = HostView1D("residual", n);
+    }
+    Kokkos::deep_copy(system_, system);
+
+    auto system_norm = 0.;
+    const auto system_copy = system_;
+    const auto single_factors = single_factors_;
+    host_parallel_reduce(
+        "mixed_precision_round_system", n,
+        KOKKOS_LAMBDA(const size_t i, double& row_norm) {
+            auto row_sum = 0.;
+            for (size_t j = 0; j < n; ++j) {
+                single_factors(i, j) = static_cast<float>(system_copy(i, j));
+                row_sum += Kokkos::fabs(system_copy(i, j));
+            }
+            row_norm = Kokkos::max(row_norm, row_sum);
+        },
+        Kokkos::Max<double>(system_norm)
+    );
+    system_norm_ = system_norm;
+
+    auto rows = static_cast<int>(n);
+
+    // Call SGETRF from LAPACK to compute the LU factorization of the rounded system in single
+    // precision, returns 0 if successful
+    auto info = LAPACKE_sgetrf(
+        LAPACK_ROW_MAJOR,        // input: matrix layout
+        rows,                    // input: number of rows
+        rows,                    // input: number of columns
+        single_factors_.data(),  // input/output: Upon entry, the n x n coefficient matrix
+                                 // Upon exit, the factors L and U from the factorization
+        rows,                    // input: leading dimension of system
+        pivots_.data()           // output: pivot indices
+    );
+
+    if (info != 0) {
+        // The rounded system is singular, which the double precision factorization confirms
+        // or not - if it does, it throws
+        OTURB_LOG_DEBUG(
+            "LAPACKE_sgetrf returned exit code " + std::to_string(info) +
+            ", falling back to a double precision factorization\n"
+        );
+        n_fallbacks_++;
+        this->FactorizeDouble(system_);
+        return;
+    }
+
+    is_refined_ = true;
+    is_factorized_ = true;
+    n_factorizations_++;
+}
+
+void DenseLinearSolver::FactorizeDouble(const HostView2D system) {
+    is_refined_ = false;
+    Kokkos::deep_copy(factors_, system);
+
+    auto rows = static_cast<int>(factors_.extent(0));
+
+    // Call DGETRF from LAPACK to compute the LU factorization of the system A = P * L * U,
+    // returns 0 if successful
+    // https://www.netlib.org/lapack/lapacke.html
+    auto info = LAPACKE_dgetrf(
+        LAPACK_ROW_MAJOR,  // input: matrix layout
+        rows,              // input: number of rows
+        rows,              // input: number of columns
+        factors_.data(),   // input/output: Upon entry, the n x n coefficient matrix
+                           // Upon exit, the factors L and U from the factorization
+        rows,              // input: leading dimension of system
+        pivots_.data()     // output: pivot indices
+    );
+
+    if (info != 0) {
+        is_factorized_ = false;
+        throw std::runtime_error("LAPACKE_dgetrf failed to factorize the system!");
+    }
+
+    is_factorized_ = true;
+    n_factorizations_++;
+}
+
+void DenseLinearSolver::SetFactorization(const HostView2D factors, const HostIntView1D pivots) {
+    if (factors.extent(0) != factors.extent(1) || factors.extent(0) != pivots.extent(0)) {
+        throw std::invalid_argument(
+            "Provided factors must be a square matrix with as many rows as pivots"
+        );
+    }
+
+    factors_ = HostView2D("factors", factors.extent(0), factors.extent(1));
+    pivots_ = HostIntView1D("pivots", pivots.extent(0));
+    Kokkos::deep_copy(factors_, factors);
+    Kokkos::deep_copy(pivots_, pivots);
+    is_factorized_ = true;
+    is_refined_ = false;
+}
+
+void DenseLinearSolver::Solve(HostView1D solution) {
+    if (!is_factorized_) {
+        throw std::runtime_error("The system must be factorized before it can be solved");
+    }
+
+    if (this->GetSize() != solution.extent(0)) {
+        throw std::invalid_argument(
+            "Provided system and solution must contain the same number of rows"
+        );
+    }
+
+    if (!is_refined_) {
+        this->SolveDouble(solution);
+        return;
+    }
+
+    Kokkos::deep_copy(right_hand_side_, solution);
+    if (this->SolveRefined(solution)) {
+        return;
+    }
+
+    // The refinement stalled, i.e. the system is too ill-conditioned for single precision
+    OTURB_LOG_WARNING(
+        "Mixed precision refinement stalled after " + std::to_string(n_refinement_iterations_) +
+        " iterations, falling back to a double precision factorization\n"
+    );
+    n_fallbacks_++;
+    this->FactorizeDouble(system_);
+    Kokkos::deep_copy(solution, right_hand_side_);
+    this->SolveDouble(solution);
+}
+
+void DenseLinearSolver::SolveDouble(HostView1D solution) const {
+    auto rows = static_cast<int>(factors_.extent(0));
+    int right_hand_sides{1};
+    int leading_dimension_solution{1};
+
+    // Call DGETRS from LAPACK to solve A * x = b with the stored LU factors
+    auto info = LAPACKE_dgetrs(
+        LAPACK_ROW_MAJOR,           // input: matrix layout
+        'N',                        // input: solve with A, i.e. no transpose
+        rows,                       // input: number of linear equations
+        right_hand_sides,           // input: number of rhs
+        factors_.data(),            // input: the factors L and U from the factorization
+        rows,                       // input: leading dimension of system
+        pivots_.data(),             // input: pivot indices
+        solution.data(),            // input/output: Upon entry, the right hand side matrix
+                                    // Upon exit, the solution matrix
+        leading_dimension_solution  // input: leading dimension of solution
+    );
+
+    if (info != 0) {
+        throw std::runtime_error("LAPACKE_dgetrs failed to solve the system!");
+    }
+}
+
+bool DenseLinearSolver::SolveRefined(HostView1D solution) {
+    const auto n = this->GetSize();
+    const auto system = system_;
+    const auto right_hand_side = right_hand_side_;
+    const auto residual = residual_;
+    const auto correction = correction_;
+
+    // Same stopping criterion as LAPACK's dsgesv, i.e. the residual is at the level of the
+    // rounding errors of a backward stable double precision solve
+    const auto tolerance = system_norm_ * std::numeric_limits<double>::epsilon() *
+                           std::sqrt(static_cast<double>(n));
+
+    Kokkos::deep_copy(solution, 0.);
+    Kokkos::deep_copy(residual_, right_hand_side_);
+    auto previous_residual_norm = std::numeric_limits<double>::infinity();
+    for (n_refinement_iterations_ = 0;; ++n_refinement_iterations_) {
+        auto residual_norm = 0.;
+        auto solution_norm = 0.;
+        host_parallel_reduce(
+            "mixed_precision_residual_norm", n,
+            KOKKOS_LAMBDA(const size_t i, double& max_residual) {
+                max_residual = Kokkos::max(max_residual, Kokkos::fabs(residual(i)));
+            },
+            Kokkos::Max<double>(residual_norm)
+        );
+        host_parallel_reduce(
+            "mixed_precision_solution_norm", n,
+            KOKKOS_LAMBDA(const size_t i, double& max_solution) {
+                max_solution = Kokkos::max(max_solution, Kokkos::fabs(solution(i)));
+            },
+            Kokkos::Max<double>(solution_norm)
+        );
+        if (residual_norm <= tolerance * solution_norm) {
+            return true;
+        }
+
+        // Every correction must at least halve the residual, which also catches overflows of
+        // the single precision factors, i.e. NaN residuals
+        if (n_refinement_iterations_ == max_refinement_iterations_ ||
+            !(residual_norm < 0.5 * previous_residual_norm)) {
+            return false;
+        }
+        previous_residual_norm = residual_norm;
+
+        host_parallel_for(
+            "mixed_precision_round_residual", n,
+            KOKKOS_LAMBDA(const size_t i) { correction(i) = static_cast<float>(residual(i)); }
+        );
+
+        auto rows = static_cast<int>(n);
+        int right_hand_sides{1};
+        int leading_dimension_solution{1};
+
+        // Call SGETRS from LAPACK to solve A * d = r with the single precision LU factors
+        auto info = LAPACKE_sgetrs(
+            LAPACK_ROW_MAJOR,           // input: matrix layout
+            'N',                        // input: solve with A, i.e. no transpose
+            rows,                       // input: number of linear equations
+            right_hand_sides,           // input: number of rhs
+            single_factors_.data(),     // input: the factors L and U from the factorization
+            rows,                       // input: leading dimension of system
+            pivots_.data(),             // input: pivot indices
+            correction_.data(),         // input/output: Upon entry, the residual
+                                        // Upon exit, the correction
+            leading_dimension_solution  // input: leading dimension of solution
+        );
+
+        if (info != 0) {
+            throw std::runtime_error("LAPACKE_sgetrs failed to solve the system!");
+        }
+
+        // Apply the correction and update the residual {r} = {b} - [A] {x} in double precision
+        host_parallel_for(
+            "mixed_precision_correct_solution", n,
+            KOKKOS_LAMBDA(const size_t i) { solution(i) += static_cast<double>(correction(i)); }
+        );
+        host_parallel_for(
+            "mixed_precision_residual", n,
+            KOKKOS_LAMBDA(const size_t i) {
+                auto sum = right_hand_side(i);
+                for (size_t j = 0; j < n; ++j) {
+                    sum -= system(i, j) * solution(j);
+                }
+                residual(i) = sum;
+            }
+        );
+    }
+}
+
+BandedLinearSolver::BandedLinearSolver()
+    : sub_diagonals_(0),
+      super_diagonals_(0),
+      band_("band", 0),
+      pivots_("pivots", 0),
+      reordered_solution_("reordered_solution", 0),
+      is_factorized_(false),
+      n_factorizations_(0) {
+}
+
+void BandedLinearSolver::Factorize(const BlockSparseMatrix& system) {
+    const auto rows = system.GetNumberOfRows();
+    this->is_factorized_ = false;
+
+    // Offsets of the blocks in the rows/columns of the reordered system
+    const auto ordering = system.ReverseCuthillMcKeeOrdering();
+    this->block_sizes_ = system.GetBlockSizes();
+    this->block_offsets_ = system.GetBlockOffsets();
+    this->reordered_offsets_.assign(ordering.size(), 0);
+    for (size_t i = 0, offset = 0; i < ordering.size(); ++i) {
+        reordered_offsets_[ordering[i]] = offset;
+        offset += block_sizes_[ordering[i]];
+    }
+
+    // Number of sub- and super-diagonals of the reordered system, treating every stored block
+    // as dense
+    const auto& row_offsets = system.GetRowOffsets();
+    const auto& column_indices = system.GetColumnIndices();
+    this->sub_diagonals_ = 0;
+    this->super_diagonals_ = 0;
+    for (size_t block_row = 0; block_row < ordering.size(); ++block_row) {
+        for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1]; ++index) {
+            const auto block_column = column_indices[index];
+            const auto first_row = reordered_offsets_[block_row];
+            const auto first_column = reordered_offsets_[block_column];
+            const auto last_row = first_row + block_sizes_[block_row] - 1;
+            const auto last_column = first_column + block_sizes_[block_column] - 1;
+            if (last_row > first_column) {
+                sub_diagonals_ = std::max(sub_diagonals_, last_row - first_column);
+            }
+            if (last_column > first_row) {
+                super_diagonals_ = std::max(super_diagonals_, last_column - first_row);
+            }
+        }
+    }
+
+    // Store the reordered system in LAPACK's (column-major) band storage, with kl additional
+    // rows for the fill-in of the partial pivoting, i.e. A(i, j) at ab(kl + ku + i - j, j)
+    const auto leading_dimension = 2 * sub_diagonals_ + super_diagonals_ + 1;
+    if (band_.extent(0) != leading_dimension * rows) {
+        this->band_ = HostView1D("band", leading_dimension * rows);
+    } else {
+        Kokkos::deep_copy(band_, 0.);
+    }
+    if (pivots_.extent(0) != rows) {
+        this->pivots_ = HostIntView1D("pivots", rows);
+        this->reordered_solution_ = HostView1D("reordered_solution", rows);
+    }
+    for (size_t block_row = 0; block_row < ordering.size(); ++block_row) {
+        for (auto index = row_offsets[block_row]; index < row_offsets[block_row + 1]; ++index) {
+            const auto block_column = column_indices[index];
+            const auto block = system.GetBlock(block_row, block_column);
+            for (size_t i = 0; i < block.extent(0); ++i) {
+                for (size_t j = 0; j < block.extent(1); ++j) {
+                    const auto row = reordered_offsets_[block_row] + i;
+                    const auto column = reordered_offsets_[block_column] + j;
+                    band_(sub_diagonals_ + super_diagonals_ + row - column +
+                          column * leading_dimension) = block(i, j);
+                }
+            }
+        }
+    }
+
+    if (rows > 0) {
+        // Call DGBTRF from LAPACK to compute the LU factorization of a real band matrix A,
+        // returns 0 if successful
+        // https://www.netlib.org/lapack/lapacke.html
+        auto info = LAPACKE_dgbtrf(
+            LAPACK_COL_MAJOR,                     // input: matrix layout
+            static_cast<int>(rows),               // input: number of rows
+            static_cast<int>(rows),               // input: number of columns
+            static_cast<int>(sub_diagonals_),     // input: number of sub-diagonals
+            static_cast<int>(super_diagonals_),   // input: number of super-diagonals
+            band_.data(),                         // input/output: Upon entry, the band matrix
+                                                  // Upon exit, the factors L and U
+            static_cast<int>(leading_dimension),  // input: leading dimension of band
+            pivots_.data()                        // output: pivot indices
+        );
+
+        if (info != 0) {
+            throw std::runtime_error("LAPACKE_dgbtrf failed to factorize the system!");
+        }
+    }
+
+    this->is_factorized_ = true;
+    this->n_factorizations_++;
+}
+
+void BandedLinearSolver::Solve(HostView1D solution) {
+    if (!this->is_factorized_) {
+        throw std::runtime_error("The system must be factorized before it can be solved");
+    }
+
+    const auto rows = this->GetSize();
+    if (rows != solution.extent(0)) {
+        throw std::invalid_argument(
+            "Provided system and solution must contain the same number of rows"
+        );
+    }
+    if (rows == 0) {
+        return;
+    }
+
+    for (size_t block = 0; block < block_sizes_.size(); ++block) {
+        for (size_t i = 0; i < block_sizes_[block]; ++i) {
+            reordered_solution_(reordered_offsets_[block] + i) =
+                solution(block_offsets_[block] + i);
+        }
+    }
+
+    // Call DGBTRS from LAPACK to solve the system with the factors of DGBTRF, returns 0 if
+    // successful
+    // https://www.netlib.org/lapack/lapacke.html
+    const auto leading_dimension = 2 * sub_diagonals_ + super_diagonals_ + 1;
+    int right_hand_sides{1};
+    auto info = LAPACKE_dgbtrs(
+        LAPACK_COL_MAJOR,                     // input: matrix layout
+        'N',                                  // input: solve A * x = b, i.e. not transposed
+        static_cast<int>(rows),               // input: number of linear equations
+        static_cast<int>(sub_diagonals_),     // input: number of sub-diagonals
+        static_cast<int>(super_diagonals_),   // input: number of super-diagonals
+        right_hand_sides,                     // input: number of rhs
+        band_.data(),                         // input: the factors L and U
+        static_cast<int>(leading_dimension),  // input: leading dimension of band
+        pivots_.data(),                       // input: pivot indices
+        reordered_solution_.data(),           // input/output: Upon entry, the rhs
+                                              // Upon exit, the solution
+        static_cast<int>(rows)                // input: leading dimension of solution
+    );
+
+    if (info != 0) {
+        throw std::runtime_error("LAPACKE_dgbtrs failed to solve the system!");
+    }
+
+    for (size_t block = 0; block < block_sizes_.size(); ++block) {
+        for (size_t i = 0; i < block_sizes_[block]; ++i) {
+            solution(block_offsets_[block] + i) =
+                reordered_solution_(reordered_offsets_[block] + i);
+        }
+    }
+}
+
+NullSpaceReduction::NullSpaceReduction(size_t n_unknowns, size_t n_constraints)
+    : tangent_("tangent", n_unknowns, n_unknowns),
+      constraint_gradient_("constraint_gradient", n_unknowns, n_constraints),
+      multiplier_gradient_("multiplier_gradient", n_unknowns, n_constraints),
+      constraint_range_("constraint_range", n_unknowns, n_constraints),
+      multiplier_range_("multiplier_range", n_unknowns, n_constraints),
+      constraint_factor_("constraint_factor", n_constraints, n_constraints),
+      multiplier_factor_("multiplier_factor", n_constraints, n_constraints),
+      particular_solution_("particular_solution", n_unknowns),
+      remainder_("remainder", n_unknowns),
+      orthogonal_("orthogonal", n_unknowns, n_unknowns),
+      tau_("tau", n_constraints),
+      constraint_solution_("constraint_solution", n_constraints),
+      unbalanced_("unbalanced", n_unknowns) {
+    if (n_constraints > n_unknowns) {
+        throw std::invalid_argument("The number of constraints must not exceed the unknowns");
+    }
+
+    const auto n_reduced = n_unknowns - n_constraints;
+    constraint_null_space_ = HostView2D("constraint_null_space", n_unknowns, n_reduced);
+    multiplier_null_space_ = HostView2D("multiplier_null_space", n_unknowns, n_reduced);
+    tangent_null_space_ = HostView2D("tangent_null_space", n_unknowns, n_reduced);
+    reduced_matrix_ = HostView2D("reduced_matrix", n_reduced, n_reduced);
+    reduced_right_hand_side_ = HostView1D("reduced_right_hand_side", n_reduced);
+}
+
+void NullSpaceReduction::Factorize(
+    const HostView2D matrix, HostView2D range, HostView2D null_space, HostView2D factor
+) {
+    const auto n = matrix.extent(0);
+    const auto m = matrix.extent(1);
+    if (m == 0) {
+        Kokkos::deep_copy(null_space, 0.);
+        for (size_t i = 0; i < n; ++i) {
+            null_space(i, i) = 1.;
+        }
+        return;
+    }
+
+    // Householder QR factorization of the matrix, expanded to the full orthogonal matrix
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            orthogonal_(i, j) = matrix(i, j);
+        }
+    }
+    const auto rows = static_cast<int>(n);
+    const auto columns = static_cast<int>(m);
+    auto info =
+        LAPACKE_dgeqrf(LAPACK_ROW_MAJOR, rows, columns, orthogonal_.data(), rows, tau_.data());
+    if (info != 0) {
+        throw std::runtime_error("LAPACKE_dgeqrf failed to factorize the constraint gradient!");
+    }
+
+    auto max_diagonal = 0.;
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            factor(i, j) = (j >= i) ? orthogonal_(i, j) : 0.;
+        }
+        max_diagonal = std::max(max_diagonal, std::abs(factor(i, i)));
+    }
+    const auto tolerance =
+        static_cast<double>(n) * std::numeric_limits<double>::epsilon() * max_diagonal;
+    for (size_t i = 0; i < m; ++i) {
+        if (!(std::abs(factor(i, i)) > tolerance)) {
+            throw std::runtime_error("The constraint gradient must be of full rank");
+        }
+    }
+
+    info = LAPACKE_dorgqr(
+        LAPACK_ROW_MAJOR, rows, rows, columns, orthogonal_.data(), rows, tau_.data()
+    );
+    if (info != 0) {
+        throw std::runtime_error("LAPACKE_dorgqr failed to form the orthogonal matrix!");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            range(i, j) = orthogonal_(i, j);
+        }
+        for (size_t j = m; j < n; ++j) {
+            null_space(i, j - m) = orthogonal_(i, j);
+        }
+    }
+}
+
+HostView2D NullSpaceReduction::Reduce(const HostView2D system) {
+    const auto n = this->GetNumberOfUnknowns();
+    const auto m = this->GetNumberOfConstraints();
+    const auto n_reduced = this->GetReducedSize();
+    if (system.extent(0) != n + m || system.extent(1) != n + m) {
+        throw std::invalid_argument(
+            "Provided system must be a square matrix of the unknowns and the constraints"
+        );
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            tangent_(i, j) = system(i, j);
+        }
+        for (size_t k = 0; k < m; ++k) {
+            constraint_gradient_(i, k) = system(n + k, i);
+            multiplier_gradient_(i, k) = system(i, n + k);
+        }
+    }
+    for (size_t k = 0; k < m; ++k) {
+        for (size_t l = 0; l < m; ++l) {
+            if (system(n + k, n + l) != 0.) {
+                throw std::invalid_argument(
+                    "The null space reduction requires a zero block of the constraints"
+                );
+            }
+        }
+    }
+
+    Factorize(
+        constraint_gradient_, constraint_range_, constraint_null_space_, constraint_factor_
+    );
+    Factorize(
+        multiplier_gradient_, multiplier_range_, multiplier_null_space_, multiplier_factor_
+    );
+
+    // [W^T S N], i.e. O(n^2 (n - m)) instead of the O((n + m)^3) of factorizing the system
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n_reduced; ++j) {
+            auto sum = 0.;
+            for (size_t k = 0; k < n; ++k) {
+                sum += tangent_(i, k) * constraint_null_space_(k, j);
+            }
+            tangent_null_space_(i, j) = sum;
+        }
+    }
+    for (size_t i = 0; i < n_reduced; ++i) {
+        for (size_t j = 0; j < n_reduced; ++j) {
+            auto sum = 0.;
+            for (size_t k = 0; k < n; ++k) {
+                sum += multiplier_null_space_(k, i) * tangent_null_space_(k, j);
+            }
+            reduced_matrix_(i, j) = sum;
+        }
+    }
+    return reduced_matrix_;
+}
+
+HostView1D NullSpaceReduction::ReduceRightHandSide(const HostView1D right_hand_side) {
+    const auto n = this->GetNumberOfUnknowns();
+    const auto m = this->GetNumberOfConstraints();
+    if (right_hand_side.extent(0) != n + m) {
+        throw std::invalid_argument(
+            "Provided right-hand side must contain the unknowns and the constraints"
+        );
+    }
+
+    // Increments that satisfy the constraints, i.e. Y R^-T {g} by forward substitution
+    for (size_t i = 0; i < m; ++i) {
+        auto sum = right_hand_side(n + i);
+        for (size_t k = 0; k < i; ++k) {
+            sum -= constraint_factor_(k, i) * constraint_solution_(k);
+        }
+        constraint_solution_(i) = sum / constraint_factor_(i, i);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        auto sum = 0.;
+        for (size_t k = 0; k < m; ++k) {
+            sum += constraint_range_(i, k) * constraint_solution_(k);
+        }
+        particular_solution_(i) = sum;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        auto sum = right_hand_side(i);
+        for (size_t k = 0; k < n; ++k) {
+            sum -= tangent_(i, k) * particular_solution_(k);
+        }
+        remainder_(i) = sum;
+    }
+    for (size_t i = 0; i < this->GetReducedSize(); ++i) {
+        auto sum = 0.;
+        for (size_t k = 0; k < n; ++k) {
+            sum += multiplier_null_space_(k, i) * remainder_(k);
+        }
+        reduced_right_hand_side_(i) = sum;
+    }
+    return reduced_right_hand_side_;
+}
+
+void NullSpaceReduction::Recover(const HostView1D reduced_solution, HostView1D solution) {
+    const auto n = this->GetNumberOfUnknowns();
+    const auto m = this->GetNumberOfConstraints();
+    const auto n_reduced = this->GetReducedSize();
+    if (reduced_solution.extent(0) != n_reduced || solution.extent(0) != n + m) {
+        throw std::invalid_argument("Provided solutions must match the sizes of the reduction");
+    }
+
+    // The multipliers balance what the increments leave of the right-hand side, i.e.
+    // C {dl} = {r} - S {dx} = remainder - S N {z}
+    for (size_t i = 0; i < n; ++i) {
+        auto increment = particular_solution_(i);
+        auto balance = remainder_(i);
+        for (size_t k = 0; k < n_reduced; ++k) {
+            increment += constraint_null_space_(i, k) * reduced_solution(k);
+            balance -= tangent_null_space_(i, k) * reduced_solution(k);
+        }
+        solution(i) = increment;
+        unbalanced_(i) = balance;
+    }
+
+    // T {dl} = Z^T (remainder - S N {z}) by back substitution
+    for (size_t i = m; i-- > 0;) {
+        auto sum = 0.;
+        for (size_t k = 0; k < n; ++k) {
+            sum += multiplier_range_(k, i) * unbalanced_(k);
+        }
+        for (size_t k = i + 1; k < m; ++k) {
+            sum -= multiplier_factor_(i, k) * solution(n + k);
+        }
+        solution(n + i) = sum / multiplier_factor_(i, i);
+    }
+}
+
+BroydenUpdate::BroydenUpdate(size_t size, size_t max_updates)
+    : steps_("steps", max_updates, size),
+      directions_("directions", max_updates, size),
+      previous_residuals_("previous_residuals", size),
+      increments_("increments", size),
+      change_("change", size),
+      n_updates_(0),
+      has_step_(false) {
+}
+
+void BroydenUpdate::Reset() {
+    n_updates_ = 0;
+    has_step_ = false;
+}
+
+void BroydenUpdate::Record(const HostView1D residuals, const HostView1D increments) {
+    if (residuals.extent(0) != this->GetSize() || increments.extent(0) != this->GetSize()) {
+        throw std::invalid_argument("Provided vectors must match the size of the update");
+    }
+    Kokkos::deep_copy(previous_residuals_, residuals);
+    Kokkos::deep_copy(increments_, increments);
+    has_step_ = true;
+}
+
+bool BroydenUpdate::Update(
+    double step_length, const HostView1D residuals, const std::function<void(HostView1D)>& solve
+) {
+    if (!has_step_) {
+        throw std::runtime_error("Broyden update requires a recorded step");
+    }
+    if (residuals.extent(0) != this->GetSize()) {
+        throw std::invalid_argument("Provided residuals must match the size of the update");
+    }
+    if (n_updates_ == this->GetMaximumNumberOfUpdates()) {
+        return false;
+    }
+
+    // H_k {y_k}, i.e. the change of the residual vector solved for with the current inverse
+    const auto n = this->GetSize();
+    for (size_t i = 0; i < n; ++i) {
+        change_(i) = residuals(i) - previous_residuals_(i);
+    }
+    solve(change_);
+    this->Apply(change_);
+
+    // The iteration applies the negated increments, i.e. {s_k} = -step_length {increments}
+    const auto k = n_updates_;
+    auto denominator = 0.;
+    auto step_norm = 0.;
+    auto change_norm = 0.;
+    for (size_t i = 0; i < n; ++i) {
+        steps_(k, i) = -step_length * increments_(i);
+        denominator += steps_(k, i) * change_(i);
+        step_norm += steps_(k, i) * steps_(k, i);
+        change_norm += change_(i) * change_(i);
+    }
+    if (!(std::abs(denominator) >
+          std::numeric_limits<double>::epsilon() * std::sqrt(step_norm * change_norm))) {
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        directions_(k, i) = (steps_(k, i) - change_(i)) / denominator;
+    }
+    n_updates_++;
+    return true;
+}
+
+void BroydenUpdate::Apply(HostView1D solution) const {
+    if (solution.extent(0) != this->GetSize()) {
+        throw std::invalid_argument("Provided solution must match the size of the update");
+    }
+
+    // H_k = (I + a_k-1 s_k-1^T) ... (I + a_0 s_0^T) H_0, i.e. the oldest update first
+    const auto n = this->GetSize();
+    for (size_t k = 0; k < n_updates_; ++k) {
+        auto projection = 0.;
+        for (size_t i = 0; i < n; ++i) {
+            projection += steps_(k, i) * solution(i);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            solution(i) += projection * directions_(k, i);
+        }
+    }
+}
+
+namespace {
+
+/// Returns the dot product of the two provided vectors
+double dot(const HostView1D a, const HostView1D b) {
+    double result = 0.;
+    host_parallel_reduce(
+        "gmres_dot_product", a.extent(0),
+        KOKKOS_LAMBDA(const size_t i, double& partial_sum) { partial_sum += a(i) * b(i); },
+        Kokkos::Sum<double>(result)
+    );
+    return result;
+}
+
+/// Returns the L2 norm of the provided vector
+double norm(const HostView1D vector) {
+    return std::sqrt(dot(vector, vector));
+}
+
+/// Computes {y} = {y} + a * {x}
+void axpy(double a, const HostView1D x, HostView1D y) {
+    host_parallel_for(
+        "gmres_axpy", y.extent(0), KOKKOS_LAMBDA(const size_t i) { y(i) += a * x(i); }
+    );
+}
+
+/// Computes {y} = a * {x}
+void scale(double a, const HostView1D x, HostView1D y) {
+    host_parallel_for(
+        "gmres_scale", y.extent(0), KOKKOS_LAMBDA(const size_t i) { y(i) = a * x(i); }
+    );
+}
+
+}  // namespace
+
+GMRESSolver::GMRESSolver(
+    size_t size, size_t restart, size_t max_iterations, double relative_tolerance
+)
+    : max_iterations_(max_iterations),
+      relative_tolerance_(relative_tolerance),
+      n_iterations_(0),
+      total_n_iterations_(0),
+      relative_residual_norm_(0.),
+      hessenberg_("gmres_hessenberg", restart + 1, restart),
+      cosines_("gmres_cosines", restart),
+      sines_("gmres_sines", restart),
+      residuals_("gmres_residuals", restart + 1),
+      right_hand_side_("gmres_right_hand_side", size),
+      work_("gmres_work", size),
+      preconditioned_("gmres_preconditioned", size) {
+    if (restart == 0) {
+        throw std::invalid_argument("The number of iterations between restarts must be > 0");
+    }
+
+    if (max_iterations == 0) {
+        throw std::invalid_argument("The maximum number of iterations must be > 0");
+    }
+
+    if (relative_tolerance <= 0.) {
+        throw std::invalid_argument("The relative tolerance must be positive");
+    }
+
+    for (size_t i = 0; i <= restart; ++i) {
+        basis_.emplace_back("gmres_basis", size);
+    }
+}
+
+bool GMRESSolver::Solve(
+    const LinearOperator& system, HostView1D solution, const LinearOperator& preconditioner
+) {
+    const auto n = this->GetSize();
+    if (solution.extent(0) != n) {
+        throw std::invalid_argument(
+            "Provided solution must contain as many rows as the solver is sized for"
+        );
+    }
+
+    const auto restart = this->GetRestart();
+
+    // Multiplies the system with the preconditioned vector into the work vector
+    const auto apply_system = [&](const HostView1D vector) {
+        if (preconditioner) {
+            preconditioner(vector, preconditioned_);
+            system(preconditioned_, work_);
+        } else {
+            system(vector, work_);
+        }
+    };
+
+    Kokkos::deep_copy(right_hand_side_, solution);
+    Kokkos::deep_copy(solution, 0.);
+    n_iterations_ = 0;
+    relative_residual_norm_ = 0.;
+
+    const auto right_hand_side_norm = norm(right_hand_side_);
+    if (right_hand_side_norm == 0.) {
+        return true;
+    }
+    const auto tolerance = relative_tolerance_ * right_hand_side_norm;
+
+    // The initial residual is the right-hand side, since the initial guess is zero
+    Kokkos::deep_copy(work_, right_hand_side_);
+    auto residual_norm = right_hand_side_norm;
+    auto is_converged = false;
+    while (!is_converged && n_iterations_ < max_iterations_) {
+        scale(1. / residual_norm, work_, basis_[0]);
+        Kokkos::deep_copy(residuals_, 0.);
+        residuals_(0) = residual_norm;
+
+        // Arnoldi process, with the least squares problem solved by Givens rotations
+        size_t k = 0;
+        while (k < restart && n_iterations_ < max_iterations_) {
+            apply_system(basis_[k]);
+            for (size_t j = 0; j <= k; ++j) {
+                hessenberg_(j, k) = dot(work_, basis_[j]);
+                axpy(-hessenberg_(j, k), basis_[j], work_);
+            }
+            const auto h_next = norm(work_);
+            hessenberg_(k + 1, k) = h_next;
+            if (h_next > 0.) {
+                scale(1. / h_next, work_, basis_[k + 1]);
+            }
+
+            for (size_t j = 0; j < k; ++j) {
+                const auto h_jk = hessenberg_(j, k);
+                hessenberg_(j, k) = cosines_(j) * h_jk + sines_(j) * hessenberg_(j + 1, k);
+                hessenberg_(j + 1, k) = -sines_(j) * h_jk + cosines_(j) * hessenberg_(j + 1, k);
+            }
+            const auto r = std::hypot(hessenberg_(k, k), hessenberg_(k + 1, k));
+            cosines_(k) = hessenberg_(k, k) / r;
+            sines_(k) = hessenberg_(k + 1, k) / r;
+            hessenberg_(k, k) = r;
+            hessenberg_(k + 1, k) = 0.;
+            residuals_(k + 1) = -sines_(k) * residuals_(k);
+            residuals_(k) = cosines_(k) * residuals_(k);
+
+            ++k;
+            ++n_iterations_;
+            residual_norm = std::abs(residuals_(k));
+            if (residual_norm <= tolerance || h_next == 0.) {
+                break;
+            }
+        }
+
+        // Solve the upper triangular least squares system in place and accumulate the update
+        // of the solution in the work vector
+        for (size_t i = k; i-- > 0;) {
+            auto sum = residuals_(i);
+            for (size_t j = i + 1; j < k; ++j) {
+                sum -= hessenberg_(i, j) * residuals_(j);
+            }
+            residuals_(i) = sum / hessenberg_(i, i);
+        }
+        Kokkos::deep_copy(work_, 0.);
+        for (size_t j = 0; j < k; ++j) {
+            axpy(residuals_(j), basis_[j], work_);
+        }
+        if (preconditioner) {
+            preconditioner(work_, preconditioned_);
+            axpy(1., preconditioned_, solution);
+        } else {
+            axpy(1., work_, solution);
+        }
+
+        // Restart from the true residual, which also guards against the drift of the rotated one
+        system(solution, work_);
+        scale(-1., work_, work_);
+        axpy(1., right_hand_side_, work_);
+        residual_norm = norm(work_);
+        is_converged = residual_norm <= tolerance;
+    }
+
+    total_n_iterations_ += n_iterations_;
+    relative_residual_norm_ = residual_norm / right_hand_side_norm;
+    return is_converged;
+}
+
 }  // namespace openturbine::rigid_pendulum
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <vector>
+
+#include "src/rigid_pendulum_poc/block_sparse_matrix.h"
 #include "src/rigid_pendulum_poc/utilities.h"
 
 namespace openturbine::rigid_pendulum {
@@ -13,4 +17,371 @@ namespace openturbine::rigid_pendulum {
 /// @param solution A vector of right-hand side values
 void solve_linear_system(HostView2D, HostView1D);
 
+/// @brief Solve a linear system of equations using LAPACKE's dgesv with caller-provided
+///     storage for the pivot indices, i.e. without allocating
+/// @param system A matrix of coefficients
+/// @param solution A vector of right-hand side values
+/// @param pivots A vector of the same size as solution to store the pivot indices
+void solve_linear_system(HostView2D, HostView1D, HostIntView1D);
+
+/// @brief Solve a block sparse linear system of equations with a BandedLinearSolver
+/// @details The system is not modified and the solution is stored in the provided right-hand
+///     side vector, see BandedLinearSolver for the factorization
+/// @param system A block sparse matrix of coefficients
+/// @param solution A vector of right-hand side values
+void solve_linear_system(const BlockSparseMatrix&, HostView1D);
+
+/// An enum class to indicate the precision of the LU factorization of a dense linear solver
+enum class FactorizationPrecision {
+    kDOUBLE = 0,  //< Factorize with dgetrf and solve with dgetrs
+    kMIXED,       //< Factorize with sgetrf, refine the solution in double precision
+};
+
+/*! @brief A dense linear solver that keeps the LU factorization of the system between solves
+ *  @details Factorize() computes the LU factors and pivots of the system with LAPACKE's dgetrf
+ *      and stores them, so that any number of subsequent Solve() calls only perform the forward
+ *      and back substitutions with dgetrs, i.e. O(n^2) instead of O(n^3) work. This allows the
+ *      iteration matrix to be reused across Newton-Raphson iterations (modified Newton).
+ *
+ *      With mixed precision, the system is factorized in single precision with sgetrf, i.e. at
+ *      about twice the throughput and half the memory traffic, and every solve recovers double
+ *      precision accuracy by iterative refinement: the residual of the solution is computed
+ *      with the double precision system and the correction solved with the single precision
+ *      factors, as in LAPACK's dsgesv. If the refinement stalls, e.g. for ill-conditioned
+ *      systems, the system is factorized in double precision and used until the next
+ *      factorization.
+ */
+class DenseLinearSolver {
+public:
+    DenseLinearSolver(
+        size_t size = 0, FactorizationPrecision precision = FactorizationPrecision::kDOUBLE,
+        size_t max_refinement_iterations = 10
+    );
+
+    /// Returns the number of rows/columns of the system the solver is sized for
+    inline size_t GetSize() const { return factors_.extent(0); }
+
+    /// Returns the precision of the factorization
+    inline FactorizationPrecision GetPrecision() const { return precision_; }
+
+    /// Returns the maximum number of refinement iterations of a mixed precision solve
+    inline size_t GetMaximumNumberOfRefinementIterations() const {
+        return max_refinement_iterations_;
+    }
+
+    /// Returns if the solver holds the factorization of a system
+    inline bool IsFactorized() const { return is_factorized_; }
+
+    /// Returns if the system is solved with single precision factors and refinement, i.e.
+    /// mixed precision that has not fallen back to a double precision factorization
+    inline bool IsRefined() const { return is_refined_; }
+
+    /// Returns the number of factorizations performed thus far
+    inline size_t GetNumberOfFactorizations() const { return n_factorizations_; }
+
+    /// Returns the number of single precision solves of the latest mixed precision solve
+    inline size_t GetNumberOfRefinementIterations() const { return n_refinement_iterations_; }
+
+    /// Returns the number of times the refinement stalled and the solver fell back to a double
+    /// precision factorization thus far
+    inline size_t GetNumberOfFallbacks() const { return n_fallbacks_; }
+
+    /// Discards the stored factorization, so that the next Solve() requires a Factorize()
+    inline void Invalidate() { is_factorized_ = false; }
+
+    /// Computes and stores the LU factorization of the provided system, which is not modified
+    void Factorize(const HostView2D);
+
+    /// Solves the factorized system in place, i.e. the right-hand side is overwritten
+    void Solve(HostView1D);
+
+    /// Returns the LU factors of the latest double precision factorization
+    inline HostView2D GetFactors() const { return factors_; }
+
+    /// Returns the pivot indices of the latest factorization
+    inline HostIntView1D GetPivots() const { return pivots_; }
+
+    /// Restores a factorization from the provided factors and pivots, e.g. from a checkpoint
+    void SetFactorization(const HostView2D factors, const HostIntView1D pivots);
+
+private:
+    FactorizationPrecision precision_;  //< Precision of the factorization
+    size_t max_refinement_iterations_;  //< Maximum number of refinement iterations of a solve
+    HostView2D factors_;                //< LU factors of the latest factorized system
+    HostIntView1D pivots_;              //< Pivot indices of the latest factorization
+    bool is_factorized_;                //< Flag to indicate if the factors are valid
+    bool is_refined_;                   //< Flag to indicate if solves refine single factors
+    size_t n_factorizations_;           //< Number of factorizations performed
+    size_t n_refinement_iterations_;    //< Single precision solves of the latest solve
+    size_t n_fallbacks_;                //< Number of double precision fallbacks
+
+    HostView2D system_;                                        //< Copy of the factorized system
+    double system_norm_;                                       //< Infinity norm of the system
+    Kokkos::View<float**, Kokkos::HostSpace> single_factors_;  //< Single precision LU factors
+    Kokkos::View<float*, Kokkos::HostSpace> correction_;       //< Single precision correction
+    HostView1D right_hand_side_;                               //< Copy of the latest rhs
+    HostView1D residual_;                                      //< Residual of the latest solution
+
+    /// Factorizes the double precision system with dgetrf into the factors
+    void FactorizeDouble(const HostView2D);
+
+    /// Solves with the double precision factors with dgetrs
+    void SolveDouble(HostView1D) const;
+
+    /// Solves with the single precision factors and iterative refinement, returns false if the
+    /// refinement stalled before reaching double precision accuracy
+    bool SolveRefined(HostView1D);
+};
+
+/*! @brief A direct solver of block sparse linear systems that keeps the banded LU factorization
+ *      of the system between solves
+ *  @details Factorize() reorders the blocks with the reverse Cuthill-McKee algorithm to reduce
+ *      the bandwidth of the system, stores the reordered system in LAPACK's band storage, and
+ *      factorizes it with partial pivoting with LAPACKE's dgbtrf. Subsequent Solve() calls only
+ *      permute the right-hand side and perform the substitutions with dgbtrs. For multibody
+ *      systems with a chain-like topology, e.g. discretized blades, the bandwidth does not
+ *      depend on the number of bodies so that both memory and time grow linearly with the
+ *      number of bodies, instead of the O(n^2) memory and O(n^3) time of a dense factorization.
+ */
+class BandedLinearSolver {
+public:
+    BandedLinearSolver();
+
+    /// Returns the number of rows/columns of the latest factorized system
+    inline size_t GetSize() const { return pivots_.extent(0); }
+
+    /// Returns the number of sub-diagonals of the latest reordered system
+    inline size_t GetNumberOfSubDiagonals() const { return sub_diagonals_; }
+
+    /// Returns the number of super-diagonals of the latest reordered system
+    inline size_t GetNumberOfSuperDiagonals() const { return super_diagonals_; }
+
+    /// Returns if the solver holds the factorization of a system
+    inline bool IsFactorized() const { return is_factorized_; }
+
+    /// Returns the number of factorizations performed thus far
+    inline size_t GetNumberOfFactorizations() const { return n_factorizations_; }
+
+    /// Discards the stored factorization, so that the next Solve() requires a Factorize()
+    inline void Invalidate() { is_factorized_ = false; }
+
+    /// Computes and stores the banded LU factorization of the provided system, which is not
+    /// modified
+    void Factorize(const BlockSparseMatrix&);
+
+    /// Solves the factorized system in place, i.e. the right-hand side is overwritten
+    void Solve(HostView1D);
+
+private:
+    std::vector<size_t> block_sizes_;        //< Sizes of the blocks of the factorized system
+    std::vector<size_t> block_offsets_;      //< Offsets of the blocks in the original system
+    std::vector<size_t> reordered_offsets_;  //< Offsets of the blocks in the reordered system
+    size_t sub_diagonals_;                   //< Number of sub-diagonals of the reordered system
+    size_t super_diagonals_;                 //< Number of super-diagonals of the reordered system
+    HostView1D band_;                        //< LU factors in LAPACK's band storage
+    HostIntView1D pivots_;                   //< Pivot indices of the latest factorization
+    HostView1D reordered_solution_;          //< Reordered right-hand side/solution of a solve
+    bool is_factorized_;                     //< Flag to indicate if the factors are valid
+    size_t n_factorizations_;                //< Number of factorizations performed
+};
+
+/*! @brief Reduces the saddle point systems of constrained problems to the null space of their
+ *      constraint gradients, i.e. to a smaller system without the Lagrange multipliers
+ *  @details The iteration matrix of n unknowns and m constraints
+ *
+ *          [ S  C ] {dx}   {r}
+ *          [ B  0 ] {dl} = {g}
+ *
+ *      with the constraint gradient B (m x n) and C = B^T, scaled if preconditioned, is
+ *      indefinite and of size n + m. With the QR factorizations B^T = [Y N] [R 0]^T and
+ *      C = [Z W] [T 0]^T, the increments dx = Y R^-T {g} + N {z} satisfy the constraints for
+ *      any {z}, and multiplying the first block row with W^T eliminates the multipliers, i.e.
+ *
+ *          [W^T S N] {z} = W^T ({r} - S Y R^-T {g})
+ *
+ *      is of size n - m only, and the projection N^T S N of the tangent if C = B^T. The
+ *      multipliers are recovered from T {dl} = Z^T ({r} - S {dx}). The QR factorizations are
+ *      computed with LAPACKE's dgeqrf and dorgqr.
+ */
+class NullSpaceReduction {
+public:
+    NullSpaceReduction(size_t n_unknowns = 0, size_t n_constraints = 0);
+
+    /// Returns the number of unknowns n of the system, i.e. excluding the multipliers
+    inline size_t GetNumberOfUnknowns() const { return tangent_.extent(0); }
+
+    /// Returns the number of constraints m of the system
+    inline size_t GetNumberOfConstraints() const { return constraint_factor_.extent(0); }
+
+    /// Returns the number of rows/columns n - m of the reduced system
+    inline size_t GetReducedSize() const { return reduced_matrix_.extent(0); }
+
+    /// Computes the null space of the constraints of the provided system of n + m rows/columns,
+    /// which is not modified, and returns its reduced matrix
+    HostView2D Reduce(const HostView2D system);
+
+    /// Returns the reduced right-hand side of the provided right-hand side of the latest
+    /// reduced system
+    HostView1D ReduceRightHandSide(const HostView1D right_hand_side);
+
+    /// Recovers the solution of the system, i.e. the increments and the multipliers, from the
+    /// provided solution of the reduced system of the latest reduced right-hand side
+    void Recover(const HostView1D reduced_solution, HostView1D solution);
+
+private:
+    HostView2D tangent_;                  //< Tangent S of the latest reduced system
+    HostView2D constraint_gradient_;      //< Constraint gradient B^T of the latest system
+    HostView2D multiplier_gradient_;      //< Multiplier gradient C of the latest system
+    HostView2D constraint_range_;         //< Orthonormal basis Y of the range of B^T
+    HostView2D constraint_null_space_;    //< Orthonormal basis N of the null space of B
+    HostView2D multiplier_range_;         //< Orthonormal basis Z of the range of C
+    HostView2D multiplier_null_space_;    //< Orthonormal basis W of the left null space of C
+    HostView2D constraint_factor_;        //< Upper triangular factor R of B^T
+    HostView2D multiplier_factor_;        //< Upper triangular factor T of C
+    HostView2D tangent_null_space_;       //< Product S N
+    HostView2D reduced_matrix_;           //< Reduced matrix W^T S N
+    HostView1D reduced_right_hand_side_;  //< Latest reduced right-hand side
+    HostView1D particular_solution_;      //< Increments Y R^-T {g} that satisfy the constraints
+    HostView1D remainder_;                //< Latest {r} - S Y R^-T {g}
+    HostView2D orthogonal_;               //< Workspace of the QR factorizations
+    HostView1D tau_;                      //< Householder scalars of the QR factorizations
+    HostView1D constraint_solution_;      //< Workspace of R^-T {g}
+    HostView1D unbalanced_;               //< Workspace of the remainder - S N {z}
+
+    /// Computes the orthonormal bases of the range and the null space of the provided n x m
+    /// matrix of full column rank, and its upper triangular factor
+    void Factorize(
+        const HostView2D matrix, HostView2D range, HostView2D null_space, HostView2D factor
+    );
+};
+
+/*! @brief Rank-one Broyden updates of the inverse of a factorized iteration matrix, i.e. a
+ *      quasi-Newton iteration without reassembling and refactorizing the iteration matrix
+ *  @details Implements the "good" Broyden update of the inverse H, i.e. the update that
+ *      satisfies the secant condition H_k+1 {y_k} = {s_k} of the latest step {s_k} and the
+ *      change {y_k} of the residual vector:
+ *
+ *          H_k+1 = (I + {a_k} {s_k}^T) H_k,  {a_k} = ({s_k} - H_k {y_k}) / ({s_k}^T H_k {y_k})
+ *
+ *      The inverse is never formed, only the vectors {a_k} and {s_k} are stored, i.e. applying
+ *      H_k to a right-hand side is a solve with the factors of H_0 followed by k dot products
+ *      and vector updates. The steps are those of the Newton-Raphson iteration, which applies
+ *      the negated increments solved for, see Record().
+ */
+class BroydenUpdate {
+public:
+    BroydenUpdate(size_t size = 0, size_t max_updates = 0);
+
+    /// Returns the size of the system
+    inline size_t GetSize() const { return previous_residuals_.extent(0); }
+
+    /// Returns the maximum number of updates stored
+    inline size_t GetMaximumNumberOfUpdates() const { return steps_.extent(0); }
+
+    /// Returns the number of updates since the latest reset, i.e. factorization
+    inline size_t GetNumberOfUpdates() const { return n_updates_; }
+
+    /// Returns if the increments of a step are recorded, i.e. if the next update is possible
+    inline bool HasStep() const { return has_step_; }
+
+    /// Discards the updates and the recorded step, e.g. after a new factorization
+    void Reset();
+
+    /// Records the provided residual vector and the increments solved for with the current
+    /// inverse, whose negation scaled by the step length is the step of the next update
+    void Record(const HostView1D residuals, const HostView1D increments);
+
+    /*! @brief Adds the update of the recorded step, scaled by the provided step length, and the
+     *      change of the provided residual vector since the recorded one
+     *  @param solve Solves with the factors of the initial inverse H_0 in place
+     *  @return false if the update is degenerate or no further update can be stored, i.e. if
+     *      the inverse is not updated
+     */
+    bool Update(
+        double step_length, const HostView1D residuals, const std::function<void(HostView1D)>& solve
+    );
+
+    /// Applies the updates to the provided solution of the initial inverse H_0 in place, i.e.
+    /// turns H_0 {r} into H_k {r}
+    void Apply(HostView1D solution) const;
+
+private:
+    HostView2D steps_;               //< Steps {s_k} of the updates
+    HostView2D directions_;          //< Directions {a_k} of the updates
+    HostView1D previous_residuals_;  //< Residual vector of the recorded step
+    HostView1D increments_;          //< Increments solved for at the recorded step
+    HostView1D change_;              //< Change of the residual vector, i.e. H_k {y_k}
+    size_t n_updates_;               //< Number of updates since the latest reset
+    bool has_step_;                  //< Flag to indicate if a step is recorded
+};
+
+/// A linear operator, i.e. computes the product {y} = [A] {x} of a matrix that does not have to
+/// be formed with the provided vector {x}, into the provided vector {y}
+using LinearOperator = std::function<void(const HostView1D, HostView1D)>;
+
+/*! @brief A restarted GMRES solver for linear systems that are only known through their
+ *      products with vectors, i.e. without forming or factorizing the matrix
+ *  @details Implements GMRES(m) of Saad and Schultz, "GMRES: A generalized minimal residual
+ *      algorithm for solving nonsymmetric linear systems," 1986, SIAM Journal on Scientific and
+ *      Statistical Computing, Vol 7, 856-869, with modified Gram-Schmidt orthogonalization,
+ *      Givens rotations, and optional right preconditioning. The Krylov basis is allocated once
+ *      at construction, i.e. the memory is O(n m) instead of the O(n^2) of a dense factorization.
+ */
+class GMRESSolver {
+public:
+    GMRESSolver(
+        size_t size = 0, size_t restart = 30, size_t max_iterations = 100,
+        double relative_tolerance = 1e-10
+    );
+
+    /// Returns the number of rows/columns of the systems the solver is sized for
+    inline size_t GetSize() const { return right_hand_side_.extent(0); }
+
+    /// Returns the number of iterations between restarts, i.e. the size of the Krylov basis
+    inline size_t GetRestart() const { return hessenberg_.extent(1); }
+
+    /// Returns the maximum number of iterations of a solve
+    inline size_t GetMaximumNumberOfIterations() const { return max_iterations_; }
+
+    /// Returns the tolerance of the residual norm relative to the norm of the right-hand side
+    inline double GetRelativeTolerance() const { return relative_tolerance_; }
+
+    /// Returns the number of iterations of the latest solve
+    inline size_t GetNumberOfIterations() const { return n_iterations_; }
+
+    /// Returns the number of iterations of all solves thus far
+    inline size_t GetTotalNumberOfIterations() const { return total_n_iterations_; }
+
+    /// Returns the residual norm relative to the norm of the right-hand side of the latest solve
+    inline double GetRelativeResidualNorm() const { return relative_residual_norm_; }
+
+    /*! @brief Solves the provided system in place, i.e. the right-hand side is overwritten with
+     *      the solution, starting from a zero initial guess
+     *  @details The optional preconditioner is applied from the right, i.e. GMRES solves
+     *      [A] [M]^-1 {z} = {b} with {x} = [M]^-1 {z}, so that the residual norm is the one of
+     *      the original system
+     *  @return If the relative residual norm reached the tolerance
+     */
+    bool Solve(
+        const LinearOperator& system, HostView1D solution,
+        const LinearOperator& preconditioner = LinearOperator()
+    );
+
+private:
+    size_t max_iterations_;          //< Maximum number of iterations of a solve
+    double relative_tolerance_;      //< Tolerance of the relative residual norm
+    size_t n_iterations_;            //< Number of iterations of the latest solve
+    size_t total_n_iterations_;      //< Number of iterations of all solves
+    double relative_residual_norm_;  //< Relative residual norm of the latest solve
+
+    std::vector<HostView1D> basis_;  //< Orthonormal basis of the Krylov subspace
+    HostView2D hessenberg_;          //< Upper Hessenberg matrix of the Arnoldi process
+    HostView1D cosines_;             //< Cosines of the Givens rotations
+    HostView1D sines_;               //< Sines of the Givens rotations
+    HostView1D residuals_;           //< Rotated residual vector of the least squares problem
+    HostView1D right_hand_side_;     //< Copy of the right-hand side of the latest solve
+    HostView1D work_;                //< Product of the system with the latest basis vector/residual
+    HostView1D preconditioned_;      //< Preconditioned vector the system is multiplied with
+};
+
 }  // namespace openturbine::rigid_pendulum
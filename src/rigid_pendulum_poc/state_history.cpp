@@ -0,0 +1,120 @@
+#include "src/rigid_pendulum_poc/state_history.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace openturbine::rigid_pendulum {
+
+StateHistory::StateHistory(
+    size_t n_gen_coords, size_t n_velocities, size_t capacity, size_t stride,
+    StateHistoryMode mode
+)
+    : n_gen_coords_(n_gen_coords),
+      n_velocities_(n_velocities),
+      stride_(stride),
+      mode_(mode),
+      first_(0),
+      n_samples_(0),
+      samples_(
+          Kokkos::view_alloc(Kokkos::WithoutInitializing, "state_history"), capacity,
+          1 + n_gen_coords + 3 * n_velocities
+      ),
+      steps_(capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("The capacity of the state history must be > 0");
+    }
+
+    if (stride_ == 0) {
+        throw std::invalid_argument("The number of time steps between samples must be > 0");
+    }
+}
+
+size_t StateHistory::RequiredCapacity(size_t n_steps, size_t stride) {
+    if (stride == 0) {
+        throw std::invalid_argument("The number of time steps between samples must be > 0");
+    }
+    return n_steps / stride + 1;
+}
+
+void StateHistory::Observe(const TimeStepRecord& record) {
+    if (record.step % stride_ != 0) {
+        return;
+    }
+
+    const auto& state = record.state;
+    if (state.GetGeneralizedCoordinates().extent(0) != n_gen_coords_ ||
+        state.GetVelocity().extent(0) != n_velocities_ ||
+        state.GetAcceleration().extent(0) != n_velocities_ ||
+        state.GetAlgorithmicAcceleration().extent(0) != n_velocities_) {
+        throw std::invalid_argument("The sizes of the state must match the state history");
+    }
+
+    // Fill the arena first, afterwards overwrite the oldest sample or stop
+    const auto capacity = this->GetCapacity();
+    auto row = (first_ + n_samples_) % capacity;
+    if (n_samples_ < capacity) {
+        n_samples_++;
+    } else if (mode_ == StateHistoryMode::kRING_BUFFER) {
+        row = first_;
+        first_ = (first_ + 1) % capacity;
+    } else {
+        throw std::runtime_error(
+            "The state history is full - increase its capacity or stride, or use the ring buffer "
+            "mode"
+        );
+    }
+
+    steps_[row] = record.step;
+    samples_(row, 0) = record.time;
+    const auto copy = [this, row](const HostView1D values, size_t column) {
+        for (size_t i = 0; i < values.extent(0); ++i) {
+            samples_(row, column + i) = values(i);
+        }
+    };
+    copy(state.GetGeneralizedCoordinates(), this->GetGeneralizedCoordinatesColumn());
+    copy(state.GetVelocity(), this->GetVelocityColumn());
+    copy(state.GetAcceleration(), this->GetAccelerationColumn());
+    copy(state.GetAlgorithmicAcceleration(), this->GetAlgorithmicAccelerationColumn());
+}
+
+size_t StateHistory::GetRow(size_t i) const {
+    if (i >= n_samples_) {
+        throw std::out_of_range("The state history does not hold the requested sample");
+    }
+    return (first_ + i) % this->GetCapacity();
+}
+
+size_t StateHistory::GetStep(size_t i) const {
+    return steps_[this->GetRow(i)];
+}
+
+double StateHistory::GetTime(size_t i) const {
+    return samples_(this->GetRow(i), 0);
+}
+
+State StateHistory::GetState(size_t i) const {
+    const auto row = this->GetRow(i);
+    const auto columns = [this, row](size_t column, size_t size) {
+        return Kokkos::subview(samples_, row, Kokkos::make_pair(column, column + size));
+    };
+    return State(
+        columns(this->GetGeneralizedCoordinatesColumn(), n_gen_coords_),
+        columns(this->GetVelocityColumn(), n_velocities_),
+        columns(this->GetAccelerationColumn(), n_velocities_),
+        columns(this->GetAlgorithmicAccelerationColumn(), n_velocities_)
+    );
+}
+
+HostView2D StateHistory::GetSamples() {
+    // The rows of the arena are contiguous, i.e. rotating its entries by whole rows orders them
+    if (first_ != 0) {
+        const auto n_columns = samples_.extent(1);
+        auto* data = samples_.data();
+        std::rotate(data, data + first_ * n_columns, data + n_samples_ * n_columns);
+        std::rotate(steps_.begin(), steps_.begin() + first_, steps_.begin() + n_samples_);
+        first_ = 0;
+    }
+    return Kokkos::subview(samples_, Kokkos::make_pair(size_t{0}, n_samples_), Kokkos::ALL);
+}
+
+}  // namespace openturbine::rigid_pendulum
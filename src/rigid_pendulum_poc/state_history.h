@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+
+#include "src/rigid_pendulum_poc/state.h"
+#include "src/rigid_pendulum_poc/state_observer.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// Behavior of a StateHistory once it holds as many samples as its capacity
+enum class StateHistoryMode {
+    kFIXED,        //< Keeps the first samples, storing more samples throws
+    kRING_BUFFER,  //< Keeps the latest samples, i.e. overwrites the oldest sample
+};
+
+/*! @brief Stores sampled states of a time integration in one preallocated arena, i.e. instead of
+ *      the views of one State per time step as StateHistoryObserver does
+ *  @details Every sample is one row of a capacity x (1 + n_q + 3 n_v) view, i.e. the time
+ *      followed by the generalized coordinates, the velocities, the accelerations, and the
+ *      algorithmic accelerations - 26 doubles per sample of the heavy top. Only every stride-th
+ *      time step, including the initial state, is sampled. The Lagrange multipliers and
+ *      iteration counts of the time steps are not stored.
+ */
+class StateHistory : public StateObserver {
+public:
+    StateHistory(
+        size_t n_gen_coords, size_t n_velocities, size_t capacity, size_t stride = 1,
+        StateHistoryMode mode = StateHistoryMode::kFIXED
+    );
+
+    /// Returns the capacity required to sample the initial state and the provided number of time
+    /// steps with the provided stride
+    static size_t RequiredCapacity(size_t n_steps, size_t stride = 1);
+
+    void Observe(const TimeStepRecord&) override;
+
+    /// Returns the maximum number of samples
+    inline size_t GetCapacity() const { return steps_.size(); }
+
+    /// Returns the number of time steps between two samples
+    inline size_t GetStride() const { return stride_; }
+
+    /// Returns the behavior once the history is full
+    inline StateHistoryMode GetMode() const { return mode_; }
+
+    /// Returns the number of samples held
+    inline size_t GetNumberOfSamples() const { return n_samples_; }
+
+    /// Returns the first column of the generalized coordinates in the rows of the samples
+    inline size_t GetGeneralizedCoordinatesColumn() const { return 1; }
+
+    /// Returns the first column of the velocities in the rows of the samples
+    inline size_t GetVelocityColumn() const { return 1 + n_gen_coords_; }
+
+    /// Returns the first column of the accelerations in the rows of the samples
+    inline size_t GetAccelerationColumn() const { return 1 + n_gen_coords_ + n_velocities_; }
+
+    /// Returns the first column of the algorithmic accelerations in the rows of the samples
+    inline size_t GetAlgorithmicAccelerationColumn() const {
+        return 1 + n_gen_coords_ + 2 * n_velocities_;
+    }
+
+    /// Returns the time step of the i-th sample, ordered from the oldest to the latest sample
+    size_t GetStep(size_t i) const;
+
+    /// Returns the time of the i-th sample, ordered from the oldest to the latest sample
+    double GetTime(size_t i) const;
+
+    /// Returns a copy of the state of the i-th sample, ordered from the oldest to the latest
+    State GetState(size_t i) const;
+
+    /*! @brief Returns the samples as a number of samples x (1 + n_q + 3 n_v) view of the arena,
+     *      i.e. without copying them, ordered from the oldest to the latest sample
+     *  @details A wrapped ring buffer is rotated in place once to order its samples. The view
+     *      shares the arena, i.e. later samples may overwrite its rows in the ring buffer mode.
+     */
+    HostView2D GetSamples();
+
+private:
+    size_t n_gen_coords_;        //< Number of generalized coordinates per sample
+    size_t n_velocities_;        //< Number of velocities per sample
+    size_t stride_;              //< Number of time steps between two samples
+    StateHistoryMode mode_;      //< Behavior once the history is full
+    size_t first_;               //< Row of the oldest sample
+    size_t n_samples_;           //< Number of samples held
+    HostView2D samples_;         //< Arena of capacity x (1 + n_q + 3 n_v) doubles
+    std::vector<size_t> steps_;  //< Time steps of the rows of the arena
+
+    /// Returns the row of the arena of the i-th sample
+    size_t GetRow(size_t i) const;
+};
+
+}  // namespace openturbine::rigid_pendulum
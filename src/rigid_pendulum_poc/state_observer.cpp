@@ -0,0 +1,77 @@
+#include "src/rigid_pendulum_poc/state_observer.h"
+
+namespace openturbine::rigid_pendulum {
+
+void StateHistoryObserver::Observe(const TimeStepRecord& record) {
+    states_.emplace_back(record.state);
+}
+
+DecimatingObserver::DecimatingObserver(std::shared_ptr<StateObserver> sink, size_t k)
+    : sink_(std::move(sink)), k_(k) {
+    if (sink_ == nullptr) {
+        throw std::invalid_argument("The provided observer must not be null");
+    }
+
+    if (k_ == 0) {
+        throw std::invalid_argument("The number of time steps between forwarded steps must be > 0");
+    }
+}
+
+void DecimatingObserver::Observe(const TimeStepRecord& record) {
+    if (record.step % k_ == 0) {
+        sink_->Observe(record);
+    }
+}
+
+void DecimatingObserver::Finalize() {
+    sink_->Finalize();
+}
+
+RingBufferObserver::RingBufferObserver(size_t capacity) : capacity_(capacity), n_observed_(0) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("The capacity of the ring buffer must be > 0");
+    }
+    records_.reserve(capacity_);
+}
+
+void RingBufferObserver::Observe(const TimeStepRecord& record) {
+    // Fill the buffer first, afterwards overwrite the oldest record
+    if (records_.size() < capacity_) {
+        records_.push_back(record);
+    } else {
+        records_[n_observed_ % capacity_] = record;
+    }
+    n_observed_++;
+}
+
+std::vector<TimeStepRecord> RingBufferObserver::GetRecords() const {
+    if (records_.size() < capacity_) {
+        return records_;
+    }
+
+    auto records = std::vector<TimeStepRecord>{};
+    records.reserve(capacity_);
+    for (size_t i = 0; i < capacity_; ++i) {
+        records.push_back(records_[(n_observed_ + i) % capacity_]);
+    }
+    return records;
+}
+
+CallbackObserver::CallbackObserver(Callback observe, std::function<void()> finalize)
+    : observe_(std::move(observe)), finalize_(std::move(finalize)) {
+    if (!observe_) {
+        throw std::invalid_argument("The provided callback must not be empty");
+    }
+}
+
+void CallbackObserver::Observe(const TimeStepRecord& record) {
+    observe_(record);
+}
+
+void CallbackObserver::Finalize() {
+    if (finalize_) {
+        finalize_();
+    }
+}
+
+}  // namespace openturbine::rigid_pendulum
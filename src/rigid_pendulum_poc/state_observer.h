@@ -0,0 +1,102 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "src/rigid_pendulum_poc/state.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// @brief The results and statistics of a completed time step, as handed to a StateObserver
+struct TimeStepRecord {
+    size_t step;                //< Index of the time step, zero for the initial state
+    double time;                //< Time at the end of the time step
+    State state;                //< State at the end of the time step
+    HostView1D lagrange_mults;  //< Lagrange multipliers at the end of the time step
+    size_t n_iterations;        //< Number of non-linear iterations of the time step
+    bool is_converged;          //< Flag to indicate if the non-linear iterations converged
+};
+
+/*! @brief An abstract class for sinks that receive the states of a time integration while it
+ *      runs, i.e. instead of the time integrator storing the states of all time steps
+ */
+class StateObserver {
+public:
+    virtual ~StateObserver() = default;
+
+    /// Receives the record of a completed time step - called once for the initial state and
+    /// then once per time step, in order
+    virtual void Observe(const TimeStepRecord&) = 0;
+
+    /// Called once after the last time step has been observed, e.g. to flush any buffers
+    virtual void Finalize() {}
+};
+
+/// @brief Stores the states of all time steps, i.e. memory grows with the number of steps - see
+/// StateHistory for sampled states in one preallocated arena
+class StateHistoryObserver : public StateObserver {
+public:
+    void Observe(const TimeStepRecord&) override;
+
+    /// Returns the states of all observed time steps
+    inline const std::vector<State>& GetStates() const { return states_; }
+
+private:
+    std::vector<State> states_;  //< States of all observed time steps
+};
+
+/// @brief Forwards every k-th time step, including the initial state, to another observer
+class DecimatingObserver : public StateObserver {
+public:
+    DecimatingObserver(std::shared_ptr<StateObserver> sink, size_t k);
+
+    void Observe(const TimeStepRecord&) override;
+
+    void Finalize() override;
+
+    /// Returns the number of time steps between two forwarded time steps
+    inline size_t GetDecimation() const { return k_; }
+
+private:
+    std::shared_ptr<StateObserver> sink_;  //< Observer receiving the forwarded time steps
+    size_t k_;                             //< Number of time steps between forwarded steps
+};
+
+/// @brief Keeps the records of the latest N time steps in a ring buffer
+class RingBufferObserver : public StateObserver {
+public:
+    RingBufferObserver(size_t capacity);
+
+    void Observe(const TimeStepRecord&) override;
+
+    /// Returns the maximum number of records kept
+    inline size_t GetCapacity() const { return capacity_; }
+
+    /// Returns the kept records, ordered from the oldest to the latest time step
+    std::vector<TimeStepRecord> GetRecords() const;
+
+private:
+    size_t capacity_;                      //< Maximum number of records kept
+    size_t n_observed_;                    //< Number of records observed thus far
+    std::vector<TimeStepRecord> records_;  //< Ring buffer of the latest records
+};
+
+/// @brief Forwards every time step to the provided callable, e.g. a writer of the results
+class CallbackObserver : public StateObserver {
+public:
+    using Callback = std::function<void(const TimeStepRecord&)>;
+
+    CallbackObserver(Callback observe, std::function<void()> finalize = nullptr);
+
+    void Observe(const TimeStepRecord&) override;
+
+    void Finalize() override;
+
+private:
+    Callback observe_;                //< Called for every time step
+    std::function<void()> finalize_;  //< Called after the last time step, if provided
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -2,18 +2,11 @@
 
 #include "src/rigid_pendulum_poc/linearization_parameters.h"
 #include "src/rigid_pendulum_poc/state.h"
+#include "src/rigid_pendulum_poc/state_observer.h"
 #include "src/rigid_pendulum_poc/utilities.h"
 
 namespace openturbine::rigid_pendulum {
 
-using ResidualVector = std::function<
-    HostView1D(const HostView1D, const HostView1D, const HostView1D, const HostView1D)>;
-
-using IterationMatrix = std::function<HostView2D(
-    const double&, const double&, const HostView1D, const HostView1D, const HostView1D,
-    const double&, const HostView1D
-)>;
-
 // An enum class to indicate the type of time integrator
 enum class TimeIntegratorType {
     kNEWMARK_BETA = 0,   //< Newmark-beta method
@@ -31,6 +24,13 @@ public:
         const State&, size_t, std::shared_ptr<LinearizationParameters> lin_params
     ) = 0;
 
+    /// Performs the time integration and hands the state of every time step to the provided
+    /// observer, only keeping the latest state
+    virtual void Integrate(
+        const State&, size_t, std::shared_ptr<LinearizationParameters> lin_params,
+        StateObserver& observer
+    ) = 0;
+
     /// Returns the type of the time integrator
     virtual TimeIntegratorType GetType() const = 0;
 };
@@ -0,0 +1,88 @@
+#include "src/rigid_pendulum_poc/time_step_controller.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "src/rigid_pendulum_poc/execution_policy.h"
+
+namespace openturbine::rigid_pendulum {
+
+TimeStepController::TimeStepController(AdaptiveTimeStepPolicy policy) : policy_(policy) {
+    if (policy_.absolute_tolerance <= 0. || policy_.relative_tolerance < 0.) {
+        throw std::invalid_argument("The error tolerances must be positive");
+    }
+
+    if (policy_.min_time_step <= 0. ||
+        (policy_.max_time_step > 0. && policy_.max_time_step < policy_.min_time_step)) {
+        throw std::invalid_argument("Invalid range of permitted time steps");
+    }
+
+    if (policy_.safety_factor <= 0. || policy_.safety_factor > 1.) {
+        throw std::invalid_argument("The safety factor must be in (0, 1]");
+    }
+
+    if (policy_.max_growth_factor < 1. || policy_.min_shrink_factor <= 0. ||
+        policy_.min_shrink_factor > 1. || policy_.rejection_factor <= 0. ||
+        policy_.rejection_factor >= 1.) {
+        throw std::invalid_argument("Invalid growth, shrink, or rejection factor");
+    }
+}
+
+double TimeStepController::CalculateErrorNorm(
+    double h, double beta, const State& current, const State& next
+) const {
+    const auto acceleration_current = current.GetAcceleration();
+    const auto acceleration_next = next.GetAcceleration();
+    const auto velocity_next = next.GetVelocity();
+    const auto size = acceleration_next.extent(0);
+    if (acceleration_current.extent(0) != size || velocity_next.extent(0) != size) {
+        throw std::invalid_argument("The provided states must be of the same size");
+    }
+
+    // Zienkiewicz and Xie (1991) estimate of the local error, scaled by the tolerances
+    // relative to the increments of the generalized coordinates, i.e. h * v
+    const auto error_coefficient = h * h * std::abs(beta - 1. / 6.);
+    const auto absolute_tolerance = policy_.absolute_tolerance;
+    const auto relative_tolerance = policy_.relative_tolerance;
+    double sum_of_squares = 0.;
+    host_parallel_reduce(
+        "local_error_norm", size,
+        KOKKOS_LAMBDA(const size_t i, double& partial_sum) {
+            const auto error =
+                error_coefficient * (acceleration_next(i) - acceleration_current(i));
+            const auto scale =
+                absolute_tolerance + relative_tolerance * Kokkos::fabs(h * velocity_next(i));
+            partial_sum += (error / scale) * (error / scale);
+        },
+        Kokkos::Sum<double>(sum_of_squares)
+    );
+    return size > 0 ? std::sqrt(sum_of_squares / static_cast<double>(size)) : 0.;
+}
+
+TimeStepDecision TimeStepController::Evaluate(
+    double h, double error_norm, size_t n_iterations, bool is_converged
+) const {
+    const auto clamp_time_step = [this](double time_step) {
+        time_step = std::max(time_step, policy_.min_time_step);
+        return policy_.max_time_step > 0. ? std::min(time_step, policy_.max_time_step)
+                                          : time_step;
+    };
+
+    // Steps that diverge or converge too slowly are repeated with a smaller time step
+    const auto is_too_slow = policy_.max_iterations > 0 && n_iterations > policy_.max_iterations;
+    if (!is_converged || is_too_slow) {
+        return {false, clamp_time_step(h * policy_.rejection_factor)};
+    }
+
+    // The local error is third order in the time step, i.e. error ~ C h^3
+    auto factor = policy_.max_growth_factor;
+    if (error_norm > 0.) {
+        factor = policy_.safety_factor * std::pow(error_norm, -1. / 3.);
+        factor = std::clamp(factor, policy_.min_shrink_factor, policy_.max_growth_factor);
+    }
+
+    return {error_norm <= 1., clamp_time_step(h * factor)};
+}
+
+}  // namespace openturbine::rigid_pendulum
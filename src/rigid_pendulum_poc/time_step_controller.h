@@ -0,0 +1,58 @@
+#pragma once
+
+#include "src/rigid_pendulum_poc/state.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/// @brief Policy for adapting the time step to the estimated local error of every time step
+struct AdaptiveTimeStepPolicy {
+    bool is_adaptive = false;          //< Flag to indicate if the time step is adapted
+    double absolute_tolerance = 1e-6;  //< Absolute tolerance of the local error
+    double relative_tolerance = 1e-4;  //< Tolerance relative to the increments of the step
+    double min_time_step = 1e-8;       //< Smallest permitted time step
+    double max_time_step = 0.;         //< Largest permitted time step, zero for no limit
+    double safety_factor = 0.9;        //< Factor applied to the optimal time step
+    double max_growth_factor = 2.;     //< Largest increase of the time step after a step
+    double min_shrink_factor = 0.2;    //< Largest decrease of the time step after a step
+    double rejection_factor = 0.5;     //< Decrease of the time step after a failed step
+    size_t max_iterations = 0;         //< Reject steps that need more iterations, zero to
+                                       // only reject steps that do not converge
+};
+
+/// @brief The outcome of a time step, as evaluated by the TimeStepController
+struct TimeStepDecision {
+    bool is_accepted;       //< Flag to indicate if the time step is accepted
+    double next_time_step;  //< Time step for the next (or the repeated) time step
+};
+
+/*! @brief Controls the time step of a time integration based on estimates of the local error
+ *  @details The local error of the generalized coordinates is estimated a posteriori from the
+ *      difference between the accelerations at the start and at the end of the time step as
+ *      in Zienkiewicz and Xie, "A simple error estimator and adaptive time stepping procedure for
+ *      dynamic analysis," 1991, Earthquake Engineering & Structural Dynamics, Vol 20, 871-887,
+ *      i.e. e = h^2 |beta - 1/6| (a_{n+1} - a_n), which is third order in the time step. Time
+ *      steps that do not converge, converge too slowly, or exceed the error tolerance are
+ *      rejected and repeated with a smaller time step, otherwise the next time step is sized
+ *      such that its error is expected to meet the tolerance.
+ */
+class TimeStepController {
+public:
+    TimeStepController(AdaptiveTimeStepPolicy policy = AdaptiveTimeStepPolicy{});
+
+    /// Returns the policy of the controller
+    inline const AdaptiveTimeStepPolicy& GetPolicy() const { return policy_; }
+
+    /// Returns the root-mean-square of the estimated local errors of the time step from the
+    /// current to the next state, scaled by the tolerances, i.e. values <= 1 meet the tolerance
+    double CalculateErrorNorm(double h, double beta, const State& current, const State& next) const;
+
+    /// Accepts or rejects a time step of the provided size and proposes the next time step
+    TimeStepDecision Evaluate(double h, double error_norm, size_t n_iterations, bool is_converged)
+        const;
+
+private:
+    AdaptiveTimeStepPolicy policy_;  //< Policy of the controller
+};
+
+}  // namespace openturbine::rigid_pendulum
@@ -2,6 +2,8 @@
 
 #include <stdexcept>
 
+#include "src/utilities/metrics.h"
+
 namespace openturbine::rigid_pendulum {
 
 TimeStepper::TimeStepper(
@@ -10,14 +12,52 @@ TimeStepper::TimeStepper(
     : initial_time_(initial_time),
       time_step_(time_step),
       n_steps_(n_steps),
+      final_time_(initial_time + static_cast<double>(n_steps) * time_step),
       kMAX_ITERATIONS_(max_iterations) {
     this->current_time_ = initial_time;
     this->n_iterations_ = 0;
     this->total_n_iterations_ = 0;
+    this->total_n_jacobian_updates_ = 0;
+    this->total_n_broyden_updates_ = 0;
 
     if (this->kMAX_ITERATIONS_ < 1) {
         throw std::invalid_argument("Invalid value for max_iterations");
     }
 }
 
+void TimeStepper::RecordStepStatistics(double wall_time, double solve_time, size_t n_iterations) {
+    this->wall_time_.Add(wall_time);
+    this->solve_time_.Add(solve_time);
+    this->iterations_.Add(static_cast<double>(n_iterations));
+
+    // The metrics are looked up once, updating them afterwards is a few relaxed atomics
+    static auto& registry = util::MetricsRegistry::Get();
+    static auto& steps = registry.GetCounter("openturbine_time_steps_total", "Number of time steps");
+    static auto& steps_per_second = registry.GetGauge(
+        "openturbine_steps_per_second", "Time steps per second of the latest time step"
+    );
+    static auto& step_time = registry.GetHistogram(
+        "openturbine_time_step_seconds", {1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1.},
+        "Wall time of the time steps in seconds"
+    );
+    static auto& solve_time_total = registry.GetCounter(
+        "openturbine_linear_solve_seconds_total", "Wall time of the linear solves in seconds"
+    );
+    static auto& iterations = registry.GetHistogram(
+        "openturbine_newton_iterations", {1., 2., 3., 5., 10., 20., 50.},
+        "Newton-Raphson iterations per time step"
+    );
+    steps.Increment();
+    steps_per_second.Set(wall_time > 0. ? 1. / wall_time : 0.);
+    step_time.Observe(wall_time);
+    solve_time_total.Increment(solve_time);
+    iterations.Observe(static_cast<double>(n_iterations));
+}
+
+void TimeStepper::ResetStatistics() {
+    this->wall_time_ = RunningStatistics();
+    this->solve_time_ = RunningStatistics();
+    this->iterations_ = RunningStatistics();
+}
+
 }  // namespace openturbine::rigid_pendulum
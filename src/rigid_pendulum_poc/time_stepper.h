@@ -4,6 +4,48 @@
 
 namespace openturbine::rigid_pendulum {
 
+/// @brief Running count, sum, minimum, maximum, and latest value of a per-step quantity, i.e.
+///     without storing the samples of all time steps - callable on the device, e.g. to
+///     accumulate the invariants of the bodies of an ensemble in its kernels
+class RunningStatistics {
+public:
+    /// Adds the provided sample to the statistics
+    KOKKOS_INLINE_FUNCTION void Add(double value) {
+        min_ = (count_ == 0 || value < min_) ? value : min_;
+        max_ = (count_ == 0 || value > max_) ? value : max_;
+        last_ = value;
+        total_ += value;
+        count_++;
+    }
+
+    /// Returns the number of samples
+    KOKKOS_INLINE_FUNCTION size_t GetCount() const { return count_; }
+
+    /// Returns the sum of all samples
+    KOKKOS_INLINE_FUNCTION double GetTotal() const { return total_; }
+
+    /// Returns the mean of all samples, zero if there are none
+    KOKKOS_INLINE_FUNCTION double GetMean() const {
+        return count_ > 0 ? total_ / static_cast<double>(count_) : 0.;
+    }
+
+    /// Returns the smallest sample, zero if there are none
+    KOKKOS_INLINE_FUNCTION double GetMin() const { return min_; }
+
+    /// Returns the largest sample, zero if there are none
+    KOKKOS_INLINE_FUNCTION double GetMax() const { return max_; }
+
+    /// Returns the latest sample, zero if there are none
+    KOKKOS_INLINE_FUNCTION double GetLast() const { return last_; }
+
+private:
+    size_t count_ = 0;   //< Number of samples
+    double total_ = 0.;  //< Sum of all samples
+    double min_ = 0.;    //< Smallest sample
+    double max_ = 0.;    //< Largest sample
+    double last_ = 0.;   //< Latest sample
+};
+
 /// @brief A class to store and manage the states of a dynamic system
 class TimeStepper {
 public:
@@ -21,9 +63,18 @@ public:
     /// Returns the time step of the analysis
     inline double GetTimeStep() const { return time_step_; }
 
+    /// Sets the time step of the analysis, e.g. when adapting it to the local error
+    inline void SetTimeStep(double time_step) { time_step_ = time_step; }
+
+    /// Returns the final time of the analysis, i.e. after the initial number of time steps
+    inline double GetFinalTime() const { return final_time_; }
+
     /// Advances the current analysis time by one time step
     inline void AdvanceTimeStep() { current_time_ += time_step_; }
 
+    /// Sets the current time of the analysis, e.g. when restarting from a checkpoint
+    inline void SetCurrentTime(double current_time) { current_time_ = current_time; }
+
     /// Returns the number of analysis time steps to perform
     inline size_t GetNumberOfSteps() const { return n_steps_; }
 
@@ -42,19 +93,62 @@ public:
     /// Increments the total number of iterations by the number of iterations performed
     inline void IncrementTotalNumberOfIterations(size_t n) { total_n_iterations_ += n; }
 
+    /// Sets the total number of iterations, e.g. when restarting from a checkpoint
+    inline void SetTotalNumberOfIterations(size_t n) { total_n_iterations_ = n; }
+
+    /// Returns the total number of updates of the iteration matrix performed thus far
+    inline size_t GetTotalNumberOfJacobianUpdates() const { return total_n_jacobian_updates_; }
+
+    /// Increments the total number of updates of the iteration matrix by one
+    inline void IncrementTotalNumberOfJacobianUpdates() { total_n_jacobian_updates_++; }
+
+    /// Returns the total number of quasi-Newton (Broyden) updates of the inverse of the
+    /// iteration matrix performed thus far
+    inline size_t GetTotalNumberOfBroydenUpdates() const { return total_n_broyden_updates_; }
+
+    /// Increments the total number of Broyden updates by one
+    inline void IncrementTotalNumberOfBroydenUpdates() { total_n_broyden_updates_++; }
+
     /// Returns the maximum number of iterations for the non-linear update
     inline size_t GetMaximumNumberOfIterations() const { return kMAX_ITERATIONS_; }
 
+    /// Records the wall time (s), the time spent in the linear solves (s), and the number of
+    /// non-linear iterations of a completed (or rejected) time step
+    void RecordStepStatistics(double wall_time, double solve_time, size_t n_iterations);
+
+    /// Returns the statistics of the wall time (s) of the time steps
+    inline const RunningStatistics& GetWallTimeStatistics() const { return wall_time_; }
+
+    /// Returns the statistics of the time (s) spent factorizing and solving the linear systems
+    inline const RunningStatistics& GetSolveTimeStatistics() const { return solve_time_; }
+
+    /// Returns the statistics of the number of non-linear iterations of the time steps
+    inline const RunningStatistics& GetIterationStatistics() const { return iterations_; }
+
+    /// Returns the average number of non-linear iterations per time step, zero if no time step
+    /// has been recorded
+    inline double GetAverageNumberOfIterations() const { return iterations_.GetMean(); }
+
+    /// Discards the statistics of all time steps recorded thus far
+    void ResetStatistics();
+
 private:
     double initial_time_;        //< Initial time of the analysis
     double time_step_;           //< Time step (delta t) of the analysis
     size_t n_steps_;             //< Number of time steps to perform in the analysis
+    double final_time_;          //< Final time of the analysis
     double current_time_;        //< Current time of the analysis
     size_t n_iterations_;        //< Number of iterations performed in the latest non-linear update
     size_t total_n_iterations_;  //< Total number of non-linear iterations performed to
                                  // complete the analysis
     const size_t kMAX_ITERATIONS_;  //< Maximum number of iterations permitted for each
                                     // non-linear update
+    size_t total_n_jacobian_updates_;  //< Total number of updates of the iteration matrix
+    size_t total_n_broyden_updates_;   //< Total number of Broyden updates of its inverse
+
+    RunningStatistics wall_time_;   //< Wall time of the time steps
+    RunningStatistics solve_time_;  //< Time spent in the linear solves of the time steps
+    RunningStatistics iterations_;  //< Number of non-linear iterations of the time steps
 };
 
 }  // namespace openturbine::rigid_pendulum
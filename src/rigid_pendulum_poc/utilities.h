@@ -6,27 +6,89 @@
 
 namespace openturbine::rigid_pendulum {
 
-using HostView1D = Kokkos::View<double*, Kokkos::HostSpace>;
-using HostView2D = Kokkos::View<double**, Kokkos::HostSpace>;
+/// Kokkos views of doubles/ints in the provided memory space
+template <typename MemorySpace>
+using View1D = Kokkos::View<double*, MemorySpace>;
+template <typename MemorySpace>
+using View2D = Kokkos::View<double**, MemorySpace>;
+template <typename MemorySpace>
+using View3D = Kokkos::View<double***, MemorySpace>;
+template <typename MemorySpace>
+using IntView1D = Kokkos::View<int*, MemorySpace>;
+
+using HostView1D = View1D<Kokkos::HostSpace>;
+using HostView2D = View2D<Kokkos::HostSpace>;
+using HostView3D = View3D<Kokkos::HostSpace>;
+using HostIntView1D = IntView1D<Kokkos::HostSpace>;
+
+/// Memory space of the default execution space, i.e. GPU memory in CUDA/HIP/SYCL builds
+using DeviceMemorySpace = Kokkos::DefaultExecutionSpace::memory_space;
+
+using DeviceView1D = View1D<DeviceMemorySpace>;
+using DeviceView2D = View2D<DeviceMemorySpace>;
+using DeviceIntView1D = IntView1D<DeviceMemorySpace>;
 
 // TODO: Move the following definitions to a constants.h file in a common math directory
 static constexpr double kTOLERANCE = 1e-6;
 static constexpr double kPI = 3.14159265358979323846;
 
 // TODO: Move the following math related functions to a common math directory
+/*!
+ * @brief  Reports an error from host or device code
+ * @details Throws the provided exception type on the host and aborts the kernel on the device,
+ *      where exceptions are not available - meant for the checks of the device-callable types,
+ *      which are off the hot path unless the check fails
+ * @param  message: Description of the error
+ */
+template <typename Exception>
+KOKKOS_INLINE_FUNCTION void report_error([[maybe_unused]] const char* message) {
+    KOKKOS_IF_ON_HOST((throw Exception(message);))
+    KOKKOS_IF_ON_DEVICE((Kokkos::abort(message);))
+}
+
 /*!
  * @brief  Returns a boolean indicating if two provided doubles are close to each other
  * @param  a: First double
  * @param  b: Second double
  * @param  epsilon: Tolerance for closeness
  */
-bool close_to(double a, double b, double epsilon = kTOLERANCE);
+KOKKOS_INLINE_FUNCTION constexpr bool close_to(double a, double b, double epsilon = kTOLERANCE) {
+    const auto delta = (a > b) ? a - b : b - a;
+    a = (a < 0.) ? -a : a;
+    b = (b < 0.) ? -b : b;
+
+    if (a < epsilon) {
+        return b < epsilon;
+    }
+
+    return (delta / a) < epsilon;
+}
 
 /*!
  * @brief  Takes an angle and returns the equivalent angle in the range [-pi, pi]
  * @param  angle: Angle to be wrapped, in radians
  */
-double wrap_angle_to_pi(double angle);
+KOKKOS_INLINE_FUNCTION double wrap_angle_to_pi(double angle) {
+    using Kokkos::fmod;
+    double wrapped_angle = fmod(angle, 2. * kPI);
+
+    // Check if the angle is close to PI or -PI to avoid numerical issues
+    if (close_to(wrapped_angle, kPI)) {
+        return kPI;
+    }
+    if (close_to(wrapped_angle, -kPI)) {
+        return -kPI;
+    }
+
+    if (wrapped_angle > kPI) {
+        wrapped_angle -= 2. * kPI;
+    }
+    if (wrapped_angle < -kPI) {
+        wrapped_angle += 2. * kPI;
+    }
+
+    return wrapped_angle;
+}
 
 /*!
  * @brief  Creates an identity vector (i.e. a vector with all entries equal to 1)
@@ -52,7 +114,8 @@ HostView1D create_vector(const std::vector<double>&);
  */
 HostView2D create_matrix(const std::vector<std::vector<double>>&);
 
-/// Transposes a provided m x n matrix and returns an n x m matrix
+/// Transposes a provided m x n matrix and returns an n x m matrix - see transpose() in
+/// view_expressions.h for the transpose without a copy, e.g. as the operand of a product
 HostView2D transpose_matrix(const HostView2D);
 
 /// Generates and returns the 3 x 3 cross product matrix from a provided 3D vector
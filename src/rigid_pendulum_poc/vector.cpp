@@ -1,8 +0,0 @@
-#include "src/rigid_pendulum_poc/vector.h"
-
-namespace openturbine::rigid_pendulum {
-
-Vector::Vector(double x, double y, double z) : x_(x), y_(y), z_(z) {
-}
-
-}  // namespace openturbine::rigid_pendulum
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <stdexcept>
+#include <type_traits>
+
+#include <Kokkos_Core.hpp>
+
+#include "src/rigid_pendulum_poc/execution_policy.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum {
+
+/*! @brief Lazy expressions over host views of vectors and matrices
+ *  @details Compound expressions such as [M] {v'} + {g} + [B]^T {Lambda} are built from lazy(),
+ *      transpose(), +, - and * without computing anything, and are evaluated entry by entry by
+ *      assign() or evaluate(), i.e. in one parallel_for with no intermediate views. The
+ *      expressions hold their views by value, i.e. shallow copies, and transpose() only swaps
+ *      the indices of its operand.
+ *
+ *      Each entry of a product is a dot product of its operands, which are themselves evaluated
+ *      entry by entry - the operands of nested products, e.g. ([A] [B]) [C], should be
+ *      evaluated explicitly to not evaluate the inner product once per entry of the outer one.
+ *      The view assigned to must not be an operand of a product or a transpose of the
+ *      expression, since its entries are overwritten while the expression is evaluated.
+ */
+
+/// Trait to identify the lazy expression types, i.e. the operands of the expression operators
+template <typename T>
+struct is_view_expression : std::false_type {};
+
+/// A rank 1 or rank 2 view as the leaf of an expression
+template <typename View>
+class ViewExpression {
+public:
+    static constexpr int rank = View::rank;
+    static_assert(rank == 1 || rank == 2, "Only views of vectors and matrices are supported");
+
+    explicit ViewExpression(const View& view) : view_(view) {}
+
+    KOKKOS_INLINE_FUNCTION size_t extent(size_t r) const { return view_.extent(r); }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i) const { return view_(i); }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i, size_t j) const { return view_(i, j); }
+
+private:
+    View view_;
+};
+
+/// The transpose of a matrix expression, i.e. the entries of its operand with swapped indices
+template <typename Expression>
+class TransposeExpression {
+public:
+    static constexpr int rank = 2;
+    static_assert(Expression::rank == 2, "Only matrices can be transposed");
+
+    explicit TransposeExpression(const Expression& expression) : expression_(expression) {}
+
+    KOKKOS_INLINE_FUNCTION size_t extent(size_t r) const { return expression_.extent(1 - r); }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i, size_t j) const {
+        return expression_(j, i);
+    }
+
+private:
+    Expression expression_;
+};
+
+/// The product of an expression with a scalar
+template <typename Expression>
+class ScaledExpression {
+public:
+    static constexpr int rank = Expression::rank;
+
+    ScaledExpression(const Expression& expression, double scalar)
+        : expression_(expression), scalar_(scalar) {}
+
+    KOKKOS_INLINE_FUNCTION size_t extent(size_t r) const { return expression_.extent(r); }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i) const { return scalar_ * expression_(i); }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i, size_t j) const {
+        return scalar_ * expression_(i, j);
+    }
+
+private:
+    Expression expression_;
+    double scalar_;
+};
+
+/// The sum of two expressions of the same size
+template <typename Left, typename Right>
+class SumExpression {
+public:
+    static constexpr int rank = Left::rank;
+    static_assert(Left::rank == Right::rank, "Only expressions of the same rank can be added");
+
+    SumExpression(const Left& left, const Right& right) : left_(left), right_(right) {
+        if (left.extent(0) != right.extent(0) || left.extent(1) != right.extent(1)) {
+            throw std::invalid_argument("The sizes of the added vectors/matrices must be equal");
+        }
+    }
+
+    KOKKOS_INLINE_FUNCTION size_t extent(size_t r) const { return left_.extent(r); }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i) const { return left_(i) + right_(i); }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i, size_t j) const {
+        return left_(i, j) + right_(i, j);
+    }
+
+private:
+    Left left_;
+    Right right_;
+};
+
+/// The product of a matrix expression with a vector or matrix expression
+template <typename Left, typename Right>
+class ProductExpression {
+public:
+    static constexpr int rank = Right::rank;
+    static_assert(Left::rank == 2, "Only matrices can be multiplied with vectors/matrices");
+
+    ProductExpression(const Left& left, const Right& right) : left_(left), right_(right) {
+        if (left.extent(1) != right.extent(0)) {
+            throw std::invalid_argument(
+                rank == 1 ? "The number of columns of the matrix must be equal to the number of "
+                            "rows of the vector"
+                          : "The number of columns of the first matrix must be equal to the "
+                            "number of rows of the second matrix"
+            );
+        }
+    }
+
+    KOKKOS_INLINE_FUNCTION size_t extent(size_t r) const {
+        return r == 0 ? left_.extent(0) : right_.extent(r);
+    }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i) const {
+        double sum = 0.;
+        for (size_t k = 0; k < left_.extent(1); ++k) {
+            sum += left_(i, k) * right_(k);
+        }
+        return sum;
+    }
+
+    KOKKOS_INLINE_FUNCTION double operator()(size_t i, size_t j) const {
+        double sum = 0.;
+        for (size_t k = 0; k < left_.extent(1); ++k) {
+            sum += left_(i, k) * right_(k, j);
+        }
+        return sum;
+    }
+
+private:
+    Left left_;
+    Right right_;
+};
+
+template <typename View>
+struct is_view_expression<ViewExpression<View>> : std::true_type {};
+template <typename Expression>
+struct is_view_expression<TransposeExpression<Expression>> : std::true_type {};
+template <typename Expression>
+struct is_view_expression<ScaledExpression<Expression>> : std::true_type {};
+template <typename Left, typename Right>
+struct is_view_expression<SumExpression<Left, Right>> : std::true_type {};
+template <typename Left, typename Right>
+struct is_view_expression<ProductExpression<Left, Right>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_view_expression_v = is_view_expression<std::decay_t<T>>::value;
+
+/// Returns the provided view as the leaf of an expression, or the provided expression itself
+template <typename T>
+auto lazy(const T& operand) {
+    if constexpr (is_view_expression_v<T>) {
+        return operand;
+    } else {
+        return ViewExpression<T>(operand);
+    }
+}
+
+/// Returns the transpose of the provided matrix view or expression without copying its entries
+template <typename T>
+auto transpose(const T& operand) {
+    return TransposeExpression(lazy(operand));
+}
+
+/// Expression operators, which are only considered if at least one operand is an expression and
+/// the other one an expression or a view
+template <typename T>
+inline constexpr bool is_view_or_expression_v =
+    is_view_expression_v<T> || Kokkos::is_view<std::decay_t<T>>::value;
+
+template <typename Left, typename Right>
+using enable_if_any_view_expression_t = std::enable_if_t<
+    (is_view_expression_v<Left> || is_view_expression_v<Right>) &&
+        is_view_or_expression_v<Left> && is_view_or_expression_v<Right>,
+    int>;
+
+template <typename Left, typename Right, enable_if_any_view_expression_t<Left, Right> = 0>
+auto operator+(const Left& left, const Right& right) {
+    return SumExpression(lazy(left), lazy(right));
+}
+
+template <typename Left, typename Right, enable_if_any_view_expression_t<Left, Right> = 0>
+auto operator-(const Left& left, const Right& right) {
+    return SumExpression(lazy(left), ScaledExpression(lazy(right), -1.));
+}
+
+template <typename Left, typename Right, enable_if_any_view_expression_t<Left, Right> = 0>
+auto operator*(const Left& left, const Right& right) {
+    return ProductExpression(lazy(left), lazy(right));
+}
+
+template <typename Expression, std::enable_if_t<is_view_expression_v<Expression>, int> = 0>
+auto operator*(const Expression& expression, double scalar) {
+    return ScaledExpression(expression, scalar);
+}
+
+template <typename Expression, std::enable_if_t<is_view_expression_v<Expression>, int> = 0>
+auto operator*(double scalar, const Expression& expression) {
+    return ScaledExpression(expression, scalar);
+}
+
+/// Evaluates the provided expression into the provided view of the same size, i.e. in a single
+/// host_parallel_for over its entries
+template <typename View, typename Expression>
+void assign(const View& result, const Expression& expression) {
+    static_assert(View::rank == Expression::rank, "The result must have the rank of the expression");
+    if (result.extent(0) != expression.extent(0) || result.extent(1) != expression.extent(1)) {
+        throw std::invalid_argument("The size of the result must match the expression");
+    }
+
+    if constexpr (Expression::rank == 1) {
+        host_parallel_for(
+            "assign_vector_expression", result.extent(0),
+            [result, expression](size_t i) { result(i) = expression(i); }
+        );
+    } else {
+        host_parallel_for(
+            "assign_matrix_expression", result.extent(0), result.extent(1),
+            [result, expression](size_t i, size_t j) { result(i, j) = expression(i, j); }
+        );
+    }
+}
+
+/// Evaluates the provided expression into a new view, i.e. a HostView1D or a HostView2D
+template <typename Expression, std::enable_if_t<is_view_expression_v<Expression>, int> = 0>
+auto evaluate(const Expression& expression) {
+    if constexpr (Expression::rank == 1) {
+        auto result = HostView1D("result", expression.extent(0));
+        assign(result, expression);
+        return result;
+    } else {
+        auto result = HostView2D("result", expression.extent(0), expression.extent(1));
+        assign(result, expression);
+        return result;
+    }
+}
+
+}  // namespace openturbine::rigid_pendulum
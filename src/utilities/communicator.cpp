@@ -0,0 +1,143 @@
+#include "src/utilities/communicator.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace openturbine::util {
+
+bool is_mpi_enabled() {
+#ifdef OTURB_ENABLE_MPI
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::string create_rank_file_name(const std::string& file_name, size_t rank, size_t n_ranks) {
+    if (n_ranks == 1) {
+        return file_name;
+    }
+
+    // Only an extension of the file itself counts, i.e. not a dot in one of its directories or
+    // the leading dot of a hidden file
+    const auto rank_tag = "." + std::to_string(rank);
+    const auto extension = file_name.find_last_of('.');
+    const auto directory = file_name.find_last_of('/');
+    const auto file_start = directory == std::string::npos ? 0 : directory + 1;
+    if (extension == std::string::npos || extension <= file_start) {
+        return file_name + rank_tag;
+    }
+    return file_name.substr(0, extension) + rank_tag + file_name.substr(extension);
+}
+
+MPIEnvironment::MPIEnvironment([[maybe_unused]] int& argc, [[maybe_unused]] char**& argv)
+    : is_initializer_(false) {
+#ifdef OTURB_ENABLE_MPI
+    int is_initialized = 0;
+    MPI_Initialized(&is_initialized);
+    if (!is_initialized) {
+        if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
+            throw std::runtime_error("Failed to initialize MPI");
+        }
+        is_initializer_ = true;
+    }
+#endif
+}
+
+MPIEnvironment::~MPIEnvironment() {
+#ifdef OTURB_ENABLE_MPI
+    int is_finalized = 0;
+    MPI_Finalized(&is_finalized);
+    if (is_initializer_ && !is_finalized) {
+        MPI_Finalize();
+    }
+#endif
+}
+
+#ifdef OTURB_ENABLE_MPI
+
+Communicator::Communicator(MPI_Comm communicator) : communicator_(communicator) {
+    int is_initialized = 0;
+    MPI_Initialized(&is_initialized);
+    if (!is_initialized) {
+        throw std::runtime_error("MPI must be initialized before its communicators are used");
+    }
+
+    int rank = 0;
+    int size = 1;
+    MPI_Comm_rank(communicator_, &rank);
+    MPI_Comm_size(communicator_, &size);
+    rank_ = static_cast<size_t>(rank);
+    size_ = static_cast<size_t>(size);
+}
+
+Communicator Communicator::World() {
+    return Communicator(MPI_COMM_WORLD);
+}
+
+Communicator Communicator::Self() {
+    return Communicator(MPI_COMM_SELF);
+}
+
+void Communicator::Barrier() const {
+    MPI_Barrier(communicator_);
+}
+
+size_t Communicator::Sum(size_t value) const {
+    auto sum = static_cast<std::uint64_t>(value);
+    MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_UINT64_T, MPI_SUM, communicator_);
+    return static_cast<size_t>(sum);
+}
+
+void Communicator::Reduce(double* values, size_t n_values, Operation operation) const {
+    const auto mpi_operation = operation == Operation::kSum   ? MPI_SUM
+                               : operation == Operation::kMin ? MPI_MIN
+                                                              : MPI_MAX;
+    MPI_Allreduce(
+        MPI_IN_PLACE, values, static_cast<int>(n_values), MPI_DOUBLE, mpi_operation,
+        communicator_
+    );
+}
+
+#else
+
+Communicator::Communicator() : rank_(0), size_(1) {
+}
+
+Communicator Communicator::World() {
+    return Communicator();
+}
+
+Communicator Communicator::Self() {
+    return Communicator();
+}
+
+void Communicator::Barrier() const {
+}
+
+size_t Communicator::Sum(size_t value) const {
+    return value;
+}
+
+// The values of a single process are already reduced
+void Communicator::Reduce(double*, size_t, Operation) const {
+}
+
+#endif
+
+double Communicator::Sum(double value) const {
+    this->Reduce(&value, 1, Operation::kSum);
+    return value;
+}
+
+double Communicator::Min(double value) const {
+    this->Reduce(&value, 1, Operation::kMin);
+    return value;
+}
+
+double Communicator::Max(double value) const {
+    this->Reduce(&value, 1, Operation::kMax);
+    return value;
+}
+
+}  // namespace openturbine::util
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#ifdef OTURB_ENABLE_MPI
+#include <mpi.h>
+#endif
+
+namespace openturbine::util {
+
+/// Returns true if this build distributes work over MPI processes, i.e. OTURB_ENABLE_MPI
+bool is_mpi_enabled();
+
+/// Returns the provided file name with the provided rank inserted before its extension, e.g.
+/// "log.txt" -> "log.3.txt" - unchanged if there is a single rank
+std::string create_rank_file_name(const std::string& file_name, size_t rank, size_t n_ranks);
+
+/*! @brief Initializes MPI for the lifetime of the object, if enabled and not yet initialized
+ *  @details Construct one at the start of main(), before Kokkos::initialize(), so that Kokkos
+ *      can map the ranks of a node to its devices. MPI is finalized by the destructor of the
+ *      environment that initialized it. In serial builds this does nothing.
+ */
+class MPIEnvironment {
+public:
+    MPIEnvironment(int& argc, char**& argv);
+    ~MPIEnvironment();
+
+    MPIEnvironment(const MPIEnvironment&) = delete;
+    MPIEnvironment& operator=(const MPIEnvironment&) = delete;
+
+private:
+    bool is_initializer_;  //< Flag to indicate if this environment initialized MPI
+};
+
+/*! @brief A group of processes and the collective operations over them
+ *  @details Wraps an MPI communicator in builds with OTURB_ENABLE_MPI, and is the single
+ *      process (rank 0 of 1) otherwise, so that the same code runs in both builds. All
+ *      reductions are collective, i.e. must be called by every process of the group in the same
+ *      order, and return the reduced value on every process.
+ */
+class Communicator {
+public:
+    /// Returns the group of all processes, i.e. MPI_COMM_WORLD
+    static Communicator World();
+
+    /// Returns the group of this process only, i.e. MPI_COMM_SELF
+    static Communicator Self();
+
+    /// Returns the rank of this process in the group
+    inline size_t GetRank() const { return rank_; }
+
+    /// Returns the number of processes in the group
+    inline size_t GetSize() const { return size_; }
+
+    /// Returns if this process is the first of the group, e.g. the one writing to the console
+    inline bool IsRoot() const { return rank_ == 0; }
+
+    /// Blocks until all processes of the group have reached the barrier
+    void Barrier() const;
+
+    /// Returns the sum of the provided value over all processes
+    double Sum(double) const;
+
+    /// Returns the sum of the provided value over all processes
+    size_t Sum(size_t) const;
+
+    /// Returns the smallest of the provided values of all processes
+    double Min(double) const;
+
+    /// Returns the largest of the provided values of all processes
+    double Max(double) const;
+
+    /// Returns the element-wise sums of the provided values over all processes, i.e. several
+    /// reductions for the latency of one
+    template <size_t N>
+    std::array<double, N> Sum(const std::array<double, N>& values) const {
+        auto sums = values;
+        this->Reduce(sums.data(), N, Operation::kSum);
+        return sums;
+    }
+
+    /// Returns the element-wise maxima of the provided values over all processes
+    template <size_t N>
+    std::array<double, N> Max(const std::array<double, N>& values) const {
+        auto maxima = values;
+        this->Reduce(maxima.data(), N, Operation::kMax);
+        return maxima;
+    }
+
+    /// Returns the provided file name with the rank of this process, see create_rank_file_name()
+    inline std::string GetRankFileName(const std::string& file_name) const {
+        return create_rank_file_name(file_name, rank_, size_);
+    }
+
+private:
+    enum class Operation {
+        kSum = 0,
+        kMin,
+        kMax,
+    };
+
+#ifdef OTURB_ENABLE_MPI
+    explicit Communicator(MPI_Comm);
+
+    MPI_Comm communicator_;  //< Underlying MPI communicator
+#else
+    Communicator();
+#endif
+    size_t rank_;  //< Rank of this process in the group
+    size_t size_;  //< Number of processes in the group
+
+    /// Reduces the provided values over all processes in place
+    void Reduce(double* values, size_t n_values, Operation) const;
+};
+
+}  // namespace openturbine::util
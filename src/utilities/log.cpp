@@ -1,7 +1,15 @@
 #include "src/utilities/log.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
 #include <ctime>
+#include <mutex>
+#include <thread>
+
+#include "src/utilities/ring_buffer.h"
 
 namespace openturbine::util {
 
@@ -32,58 +40,236 @@ std::string SeverityLevelToString(const SeverityLevel& level) {
     }
 }
 
+/*! @brief Writes the log records on a background thread
+ *  @details Records are pushed into a lock-free ring buffer by any number of threads and
+ *      drained in batches by a single background thread, which keeps the log file open and
+ *      flushes the outputs once per batch. If the ring buffer is full, the pushing thread waits
+ *      for the background thread to make room, i.e. records are never dropped. Once the writer
+ *      stops, records are written synchronously by the pushing thread.
+ */
+class Log::Writer {
+public:
+    Writer(const std::string& file_name, OutputType type)
+        : type_(type),
+          buffer_(kBUFFER_CAPACITY),
+          n_pushed_(0),
+          n_written_(0),
+          is_running_(true),
+          stop_(false) {
+        if (type_ != OutputType::kConsole) {
+            file_.open(file_name, std::ofstream::out | std::ofstream::app);
+        }
+        thread_ = std::thread([this]() { this->Run(); });
+    }
+
+    ~Writer() { this->Stop(); }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    /// Queues the provided record for writing
+    void Push(std::string record) {
+        while (is_running_.load(std::memory_order_acquire)) {
+            if (buffer_.TryPush(record)) {
+                n_pushed_.fetch_add(1, std::memory_order_release);
+                condition_.notify_one();
+
+                // Stop() may have drained the buffer for the last time after the check above,
+                // i.e. the record is written here then - pairs with the fence in Stop()
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!is_running_.load(std::memory_order_relaxed)) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    this->Drain();
+                }
+                return;
+            }
+            condition_.notify_one();
+            std::this_thread::yield();
+        }
+
+        // Once the writer is stopping, e.g. while the program exits, write synchronously after
+        // the records queued before
+        std::lock_guard<std::mutex> lock(mutex_);
+        this->Drain();
+        this->Write(record);
+        this->FlushOutputs();
+    }
+
+    /// Blocks until all records pushed thus far have been written
+    void Flush() {
+        const auto n_pushed = n_pushed_.load(std::memory_order_acquire);
+        while (n_written_.load(std::memory_order_acquire) < n_pushed &&
+               is_running_.load(std::memory_order_acquire)) {
+            condition_.notify_one();
+            std::this_thread::yield();
+        }
+    }
+
+    /// Writes all queued records and stops the background thread
+    void Stop() {
+        if (!thread_.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+
+        // Records pushed from here on are written synchronously, while those that passed the
+        // check in Push() before are drained once more after the thread has finished
+        is_running_.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition_.notify_one();
+        thread_.join();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        this->Drain();
+    }
+
+private:
+    static constexpr size_t kBUFFER_CAPACITY = 4096;
+    static constexpr auto kIDLE_TIMEOUT = std::chrono::milliseconds(10);
+
+    OutputType type_;                    //< Output type of the records
+    std::ofstream file_;                 //< Log file, kept open for the lifetime of the writer
+    RingBuffer<std::string> buffer_;     //< Queued records
+    std::atomic<size_t> n_pushed_;       //< Number of pushed records
+    std::atomic<size_t> n_written_;      //< Number of written records
+    std::atomic<bool> is_running_;       //< Flag to indicate if the thread is writing records
+    std::mutex mutex_;                   //< Protects stop_, the outputs, and the waiting
+    std::condition_variable condition_;  //< Wakes up the thread when records are pushed
+    bool stop_;                          //< Flag to stop the thread once the buffer is drained
+    std::thread thread_;                 //< Background thread writing the records
+
+    /// Writes the provided record to the outputs, without flushing them
+    void Write(const std::string& record) {
+        if (type_ != OutputType::kFile) {
+            std::cout << record;
+        }
+        if (type_ != OutputType::kConsole) {
+            file_ << record;
+        }
+    }
+
+    /// Flushes the outputs
+    void FlushOutputs() {
+        if (type_ != OutputType::kFile) {
+            std::cout.flush();
+        }
+        if (type_ != OutputType::kConsole) {
+            file_.flush();
+        }
+    }
+
+    /// Writes all queued records and flushes the outputs once, returns the number of records
+    /// written - requires holding the mutex, since the outputs are shared with Push()/Stop()
+    size_t Drain() {
+        std::string record;
+        size_t n_records{0};
+        while (buffer_.TryPop(record)) {
+            this->Write(record);
+            n_records++;
+        }
+        if (n_records > 0) {
+            this->FlushOutputs();
+            n_written_.fetch_add(n_records, std::memory_order_release);
+        }
+        return n_records;
+    }
+
+    void Run() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (this->Drain() > 0) {
+                continue;
+            }
+            if (stop_ && buffer_.GetSize() == 0) {
+                return;
+            }
+            condition_.wait_for(lock, kIDLE_TIMEOUT);
+        }
+    }
+};
+
+namespace {
+
+/// Returns the given severity level as a string literal, i.e. without allocating
+const char* severity_level_label(SeverityLevel level) {
+    switch (level) {
+        case SeverityLevel::kDebug:
+            return "DEBUG";
+        case SeverityLevel::kError:
+            return "ERROR";
+        case SeverityLevel::kInfo:
+            return "INFO";
+        case SeverityLevel::kWarning:
+            return "WARNING";
+        default:
+            return "NONE";
+    }
+}
+
+/// Returns the record of the provided message in the following format:
+/// [YYYY-MM-DD HH:MM:SS.ms] [openturbine] [severity] message
+std::string format_record(const std::string& message, SeverityLevel severity) {
+    const auto now = std::chrono::system_clock::now();
+    const auto seconds = std::chrono::system_clock::to_time_t(now);
+    const auto ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+
+    // The date and time only change once a second, so only then are they formatted again
+    thread_local std::time_t cached_seconds = -1;
+    thread_local char time_stamp[32] = {};
+    if (seconds != cached_seconds) {
+        std::tm local_time{};
+        localtime_r(&seconds, &local_time);
+        std::strftime(time_stamp, sizeof(time_stamp), "%Y-%m-%d %H:%M:%S", &local_time);
+        cached_seconds = seconds;
+    }
+
+    char prefix[64];
+    const auto length = std::snprintf(
+        prefix, sizeof(prefix), "[%s.%03d] [openturbine] [%s] ", time_stamp,
+        static_cast<int>(ms.count()), severity_level_label(severity)
+    );
+
+    std::string record;
+    record.reserve(static_cast<size_t>(length) + message.size());
+    record.append(prefix, static_cast<size_t>(length));
+    record.append(message);
+    return record;
+}
+
+}  // namespace
+
 Log::Log(std::string name, SeverityLevel max_severity, OutputType type)
-    : file_name_(name), max_severity_level_(max_severity), output_type_(type) {
+    : file_name_(name),
+      max_severity_level_(max_severity),
+      output_type_(type),
+      writer_(std::make_unique<Writer>(name, type)) {
 }
 
+Log::~Log() = default;
+Log::Log(Log&&) noexcept = default;
+Log& Log::operator=(Log&&) noexcept = default;
+
 Log* Log::Get(std::string name, SeverityLevel max_severity, OutputType type) {
     if (log_instance_ == nullptr) {
         log_instance_ = new Log(name, max_severity, type);
+        // Write out all queued records before the program exits
+        std::atexit([]() { log_instance_->writer_->Stop(); });
     }
     return log_instance_;
 }
 
 void Log::WriteMessage(const std::string& message, SeverityLevel severity) const {
-    if (severity <= this->max_severity_level_) {
-        // print the time stamp in YYYY-MM-DD HH:MM:SS.ms format (where ms is milliseconds)
-        auto now = std::chrono::system_clock::now();
-        auto t = std::chrono::system_clock::to_time_t(now);
-        auto local_t = std::localtime(&t);
-
-        auto year = std::to_string(local_t->tm_year + 1900);
-        auto month = std::to_string(local_t->tm_mon + 1);
-        auto day = std::to_string(local_t->tm_mday);
-        auto hr = std::to_string(local_t->tm_hour);
-        auto min = std::to_string(local_t->tm_min);
-        auto sec = std::to_string(local_t->tm_sec);
-        auto ms =
-            std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-        auto time_stamp = year + std::string("-") + month + std::string("-") + day +
-                          std::string(" ") + hr + std::string(":") + min + std::string(":") + sec +
-                          std::string(".") + std::to_string(ms.count());
-
-        // print the annotated log message in the following format:
-        // [time stamp] [openturbine] [severity] message
-        auto log_message = std::string("[") + time_stamp + std::string("] ") +
-                           std::string("[openturbine] [") + SeverityLevelToString(severity) +
-                           std::string("] ") + message;
-
-        std::ofstream out(this->file_name_, std::ofstream::out | std::ofstream::app);
-        if (this->output_type_ == OutputType::kFile) {
-            out << log_message;
-            out.close();
-            return;
-        }
-
-        if (this->output_type_ == OutputType::kConsole) {
-            std::cout << log_message;
-            return;
-        }
-
-        std::cout << log_message;
-        out << log_message;
-        out.close();
+    if (this->IsEnabled(severity)) {
+        this->writer_->Push(format_record(message, severity));
     }
 }
 
+void Log::Flush() const {
+    this->writer_->Flush();
+}
+
 }  // namespace openturbine::util
@@ -2,8 +2,16 @@
 
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 
+/*! @brief Compile-time maximum severity level of the OTURB_LOG_* macros, i.e. the numeric value
+ *      of a SeverityLevel - messages of a lower severity (higher numeric value) compile to nothing
+ */
+#ifndef OTURB_LOG_LEVEL
+#define OTURB_LOG_LEVEL 4
+#endif
+
 namespace openturbine::util {
 
 /*! @brief Log severity levels - this is a hierarchial list, lower numeric value
@@ -33,16 +41,20 @@ enum class OutputType {
  *  https://en.wikipedia.org/wiki/Singleton_pattern.
  *  This class defines the `Get` method that serves as an alternative to a
  *  c-tor and lets clients access the same instance of this class.
+ *
+ *  Logging is asynchronous: the calling thread only formats the record and pushes it into a
+ *  lock-free ring buffer, which a background thread drains into the (kept open) log file and/or
+ *  the console. Use the OTURB_LOG_* macros to only build the messages when they are logged.
  */
 class Log {
 public:
-    ~Log() = default;
+    ~Log();
     /// Explicitly delete the copy c-tor
     Log(const Log&) = delete;
     /// Also delete the copy assignment c-tor
     Log& operator=(const Log&) = delete;
-    Log(Log&&) = default;
-    Log& operator=(Log&&) = default;
+    Log(Log&&) noexcept;
+    Log& operator=(Log&&) noexcept;
 
     /*!
      *  This is a static method that controls the access to the singleton
@@ -68,19 +80,29 @@ public:
     SeverityLevel GetMaxSeverityLevel() const { return max_severity_level_; }
     OutputType GetOutputType() const { return output_type_; }
 
-    /// @brief Write a logging message using the Log object
+    /// Returns if messages of the provided severity level are logged
+    bool IsEnabled(SeverityLevel severity) const { return severity <= max_severity_level_; }
+
+    /// @brief Write a logging message using the Log object, i.e. queue it for the background
+    ///     thread to write out
     /// @param SeverityLevel: Indicates the severity level of the log message
     void WriteMessage(const std::string&, SeverityLevel) const;
 
+    /// @brief Block until all messages written thus far have been written out
+    void Flush() const;
+
     void Debug(std::string message) const { WriteMessage(message, SeverityLevel::kDebug); }
     void Error(std::string message) const { WriteMessage(message, SeverityLevel::kError); }
     void Info(std::string message) const { WriteMessage(message, SeverityLevel::kInfo); }
     void Warning(std::string message) const { WriteMessage(message, SeverityLevel::kWarning); }
 
 private:
+    class Writer;
+
     std::string file_name_;
     SeverityLevel max_severity_level_;
     OutputType output_type_;
+    std::unique_ptr<Writer> writer_;  //< Ring buffer and background thread writing the records
     static Log* log_instance_;
 
     /// A private c-tor to prevent direct construction of the Log class
@@ -89,3 +111,40 @@ private:
 };
 
 }  // namespace openturbine::util
+
+/// Logs the provided message, which is only evaluated if the severity level is enabled
+#define OTURB_LOG_MESSAGE(severity, message)                              \
+    do {                                                                  \
+        const auto* oturb_log_instance = ::openturbine::util::Log::Get(); \
+        if (oturb_log_instance->IsEnabled(severity)) {                    \
+            oturb_log_instance->WriteMessage(message, severity);          \
+        }                                                                 \
+    } while (false)
+
+#if OTURB_LOG_LEVEL >= 1
+#define OTURB_LOG_ERROR(message) \
+    OTURB_LOG_MESSAGE(::openturbine::util::SeverityLevel::kError, message)
+#else
+#define OTURB_LOG_ERROR(message) static_cast<void>(0)
+#endif
+
+#if OTURB_LOG_LEVEL >= 2
+#define OTURB_LOG_WARNING(message) \
+    OTURB_LOG_MESSAGE(::openturbine::util::SeverityLevel::kWarning, message)
+#else
+#define OTURB_LOG_WARNING(message) static_cast<void>(0)
+#endif
+
+#if OTURB_LOG_LEVEL >= 3
+#define OTURB_LOG_INFO(message) \
+    OTURB_LOG_MESSAGE(::openturbine::util::SeverityLevel::kInfo, message)
+#else
+#define OTURB_LOG_INFO(message) static_cast<void>(0)
+#endif
+
+#if OTURB_LOG_LEVEL >= 4
+#define OTURB_LOG_DEBUG(message) \
+    OTURB_LOG_MESSAGE(::openturbine::util::SeverityLevel::kDebug, message)
+#else
+#define OTURB_LOG_DEBUG(message) static_cast<void>(0)
+#endif
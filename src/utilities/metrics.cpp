@@ -0,0 +1,271 @@
+#include "src/utilities/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <Kokkos_Core.hpp>
+
+namespace openturbine::util {
+
+namespace {
+
+/// Adds the provided amount to an atomic double, i.e. fetch_add() of C++20
+void atomic_add(std::atomic<double>& value, double amount) {
+    auto current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current, current + amount, std::memory_order_relaxed)) {
+    }
+}
+
+/// Returns the provided value in the shortest form that reads back exactly, e.g. "3" or "0.25"
+std::string format_number(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0. ? "+Inf" : "-Inf";
+    }
+    char buffer[32];
+    for (int precision = 6; precision <= 17; ++precision) {
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (std::strtod(buffer, nullptr) == value) {
+            break;
+        }
+    }
+    return buffer;
+}
+
+/// Returns the provided value as a JSON number, or null if it is not finite
+std::string format_json_number(double value) {
+    return std::isfinite(value) ? format_number(value) : "null";
+}
+
+/// Writes the HELP and TYPE lines of a metric in the Prometheus text format
+void write_prometheus_header(
+    std::ostream& output, const std::string& name, const std::string& help, const char* type
+) {
+    if (!help.empty()) {
+        output << "# HELP " << name << " " << help << "\n";
+    }
+    output << "# TYPE " << name << " " << type << "\n";
+}
+
+/// Counters of the Kokkos allocations, see MetricsRegistry::EnableAllocationTracking()
+Counter* allocations_counter = nullptr;
+Counter* allocated_bytes_counter = nullptr;
+
+void count_allocation(
+    const Kokkos::Tools::SpaceHandle, const char*, const void*, const uint64_t size
+) {
+    allocations_counter->Increment();
+    allocated_bytes_counter->Increment(static_cast<double>(size));
+}
+
+}  // namespace
+
+void Counter::Increment(double amount) {
+    atomic_add(value_, amount);
+}
+
+Histogram::Histogram(std::vector<double> upper_bounds, std::string help)
+    : help_(std::move(help)),
+      upper_bounds_(std::move(upper_bounds)),
+      counts_(new std::atomic<uint64_t>[upper_bounds_.size() + 1]),
+      count_(0),
+      sum_(0.) {
+    if (!std::is_sorted(upper_bounds_.begin(), upper_bounds_.end())) {
+        throw std::invalid_argument("The upper bounds of the histogram buckets must be sorted");
+    }
+    for (size_t i = 0; i <= upper_bounds_.size(); ++i) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::Observe(double value) {
+    const auto bucket = static_cast<size_t>(
+        std::lower_bound(upper_bounds_.begin(), upper_bounds_.end(), value) -
+        upper_bounds_.begin()
+    );
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    atomic_add(sum_, value);
+}
+
+std::vector<uint64_t> Histogram::GetBucketCounts() const {
+    auto counts = std::vector<uint64_t>(upper_bounds_.size() + 1);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+MetricsRegistry& MetricsRegistry::Get() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+Counter& MetricsRegistry::GetCounter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& counter = counters_[name];
+    if (counter == nullptr) {
+        counter = std::make_unique<Counter>(help);
+    }
+    return *counter;
+}
+
+Gauge& MetricsRegistry::GetGauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& gauge = gauges_[name];
+    if (gauge == nullptr) {
+        gauge = std::make_unique<Gauge>(help);
+    }
+    return *gauge;
+}
+
+Histogram& MetricsRegistry::GetHistogram(
+    const std::string& name, const std::vector<double>& upper_bounds, const std::string& help
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& histogram = histograms_[name];
+    if (histogram == nullptr) {
+        histogram = std::make_unique<Histogram>(upper_bounds, help);
+    }
+    return *histogram;
+}
+
+std::string MetricsRegistry::ToPrometheusText() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto output = std::ostringstream{};
+    for (const auto& [name, counter] : counters_) {
+        write_prometheus_header(output, name, counter->GetHelp(), "counter");
+        output << name << " " << format_number(counter->GetValue()) << "\n";
+    }
+    for (const auto& [name, gauge] : gauges_) {
+        write_prometheus_header(output, name, gauge->GetHelp(), "gauge");
+        output << name << " " << format_number(gauge->GetValue()) << "\n";
+    }
+    for (const auto& [name, histogram] : histograms_) {
+        write_prometheus_header(output, name, histogram->GetHelp(), "histogram");
+        // The buckets of the Prometheus format are cumulative
+        const auto counts = histogram->GetBucketCounts();
+        const auto& upper_bounds = histogram->GetUpperBounds();
+        uint64_t cumulative_count = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            cumulative_count += counts[i];
+            const auto le = (i < upper_bounds.size()) ? format_number(upper_bounds[i]) : "+Inf";
+            output << name << "_bucket{le=\"" << le << "\"} " << cumulative_count << "\n";
+        }
+        output << name << "_sum " << format_number(histogram->GetSum()) << "\n";
+        output << name << "_count " << cumulative_count << "\n";
+    }
+    return output.str();
+}
+
+std::string MetricsRegistry::ToJson(double time_stamp) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto output = std::ostringstream{};
+    output << "{\"time\":" << format_json_number(time_stamp) << ",\"counters\":{";
+    auto separator = "";
+    for (const auto& [name, counter] : counters_) {
+        output << separator << "\"" << name << "\":" << format_json_number(counter->GetValue());
+        separator = ",";
+    }
+    output << "},\"gauges\":{";
+    separator = "";
+    for (const auto& [name, gauge] : gauges_) {
+        output << separator << "\"" << name << "\":" << format_json_number(gauge->GetValue());
+        separator = ",";
+    }
+    output << "},\"histograms\":{";
+    separator = "";
+    for (const auto& [name, histogram] : histograms_) {
+        output << separator << "\"" << name << "\":{\"count\":" << histogram->GetCount()
+               << ",\"sum\":" << format_json_number(histogram->GetSum()) << ",\"buckets\":[";
+        const auto counts = histogram->GetBucketCounts();
+        const auto& upper_bounds = histogram->GetUpperBounds();
+        for (size_t i = 0; i < counts.size(); ++i) {
+            const auto le =
+                (i < upper_bounds.size()) ? format_json_number(upper_bounds[i]) : "null";
+            output << (i > 0 ? "," : "") << "{\"le\":" << le << ",\"count\":" << counts[i] << "}";
+        }
+        output << "]}";
+        separator = ",";
+    }
+    output << "}}";
+    return output.str();
+}
+
+void MetricsRegistry::EnableAllocationTracking() {
+    allocations_counter =
+        &this->GetCounter("openturbine_kokkos_allocations_total", "Number of Kokkos allocations");
+    allocated_bytes_counter = &this->GetCounter(
+        "openturbine_kokkos_allocated_bytes_total", "Number of bytes allocated by Kokkos"
+    );
+    Kokkos::Tools::Experimental::set_allocate_data_callback(count_allocation);
+}
+
+MetricsExporter::MetricsExporter(
+    const MetricsRegistry& registry, std::string file_name, MetricsFormat format,
+    std::chrono::milliseconds interval
+)
+    : registry_(registry),
+      file_name_(std::move(file_name)),
+      format_(format),
+      interval_(interval),
+      stop_(false),
+      n_exports_(0) {
+    if (interval_.count() <= 0) {
+        throw std::invalid_argument("The interval between metrics exports must be positive");
+    }
+
+    // Start from an empty file, i.e. not append to the records of a previous run
+    if (!std::ofstream(file_name_)) {
+        throw std::runtime_error("Cannot write the metrics to " + file_name_);
+    }
+
+    thread_ = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!condition_.wait_for(lock, interval_, [this]() { return stop_; })) {
+            lock.unlock();
+            this->Export();
+            lock.lock();
+        }
+    });
+}
+
+MetricsExporter::~MetricsExporter() {
+    this->Stop();
+}
+
+void MetricsExporter::Export() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (format_ == MetricsFormat::kJsonLines) {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        const auto time_stamp = std::chrono::duration<double>(now).count();
+        std::ofstream(file_name_, std::ofstream::app) << registry_.ToJson(time_stamp) << "\n";
+    } else {
+        const auto temporary_file = file_name_ + ".tmp";
+        std::ofstream(temporary_file) << registry_.ToPrometheusText();
+        std::rename(temporary_file.c_str(), file_name_.c_str());
+    }
+    n_exports_++;
+}
+
+void MetricsExporter::Stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+    this->Export();
+}
+
+}  // namespace openturbine::util
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace openturbine::util {
+
+/// @brief A monotonically increasing metric, e.g. the number of time steps - updated with one
+///     relaxed atomic operation, i.e. from any thread at near-zero cost
+class Counter {
+public:
+    explicit Counter(std::string help = "") : help_(std::move(help)), value_(0.) {}
+
+    /// Adds the provided non-negative amount to the counter
+    void Increment(double amount = 1.);
+
+    /// Returns the current value of the counter
+    inline double GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+    inline const std::string& GetHelp() const { return help_; }
+
+private:
+    std::string help_;           //< Description of the metric
+    std::atomic<double> value_;  //< Current value
+};
+
+/// @brief A metric that goes up and down, e.g. the time steps per second of the latest step
+class Gauge {
+public:
+    explicit Gauge(std::string help = "") : help_(std::move(help)), value_(0.) {}
+
+    /// Sets the gauge to the provided value
+    inline void Set(double value) { value_.store(value, std::memory_order_relaxed); }
+
+    /// Returns the current value of the gauge
+    inline double GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+    inline const std::string& GetHelp() const { return help_; }
+
+private:
+    std::string help_;           //< Description of the metric
+    std::atomic<double> value_;  //< Current value
+};
+
+/// @brief A distribution of observed values, e.g. the Newton-Raphson iterations per time step,
+///     counted in buckets of the provided (sorted) upper bounds and an implicit +Inf bucket
+class Histogram {
+public:
+    Histogram(std::vector<double> upper_bounds, std::string help = "");
+
+    /// Counts the provided value in the first bucket whose upper bound it does not exceed
+    void Observe(double value);
+
+    /// Returns the upper bounds of the buckets, without the +Inf bucket
+    inline const std::vector<double>& GetUpperBounds() const { return upper_bounds_; }
+
+    /// Returns the number of observed values of every bucket, i.e. not cumulative and with the
+    /// +Inf bucket last
+    std::vector<uint64_t> GetBucketCounts() const;
+
+    /// Returns the number of observed values
+    inline uint64_t GetCount() const { return count_.load(std::memory_order_relaxed); }
+
+    /// Returns the sum of the observed values
+    inline double GetSum() const { return sum_.load(std::memory_order_relaxed); }
+
+    inline const std::string& GetHelp() const { return help_; }
+
+private:
+    std::string help_;                                 //< Description of the metric
+    std::vector<double> upper_bounds_;                 //< Upper bounds of the buckets
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;  //< Counts of the buckets, +Inf last
+    std::atomic<uint64_t> count_;                      //< Number of observed values
+    std::atomic<double> sum_;                          //< Sum of the observed values
+};
+
+/*! @brief The registry of the metrics of a run, e.g. of the time integrators and solvers
+ *  @details A singleton like Log. Metrics are created on their first lookup and live as long as
+ *      the registry, i.e. the references returned by the lookups stay valid and should be kept
+ *      by the hot paths instead of looking the metrics up by name every time. Only creating and
+ *      exporting the metrics takes a lock, updating them is lock-free.
+ */
+class MetricsRegistry {
+public:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /// Returns the registry of the process
+    static MetricsRegistry& Get();
+
+    /// Returns the counter of the provided name, created with the provided help if new
+    Counter& GetCounter(const std::string& name, const std::string& help = "");
+
+    /// Returns the gauge of the provided name, created with the provided help if new
+    Gauge& GetGauge(const std::string& name, const std::string& help = "");
+
+    /// Returns the histogram of the provided name, created with the provided bucket upper
+    /// bounds and help if new
+    Histogram& GetHistogram(
+        const std::string& name, const std::vector<double>& upper_bounds,
+        const std::string& help = ""
+    );
+
+    /// Returns all metrics in the Prometheus text exposition format, e.g. for the textfile
+    /// collector of the node exporter
+    std::string ToPrometheusText() const;
+
+    /// Returns all metrics as one line of JSON, i.e. a record of a JSON lines file, with the
+    /// provided Unix time stamp in seconds
+    std::string ToJson(double time_stamp) const;
+
+    /*! @brief Counts the Kokkos allocations and their bytes, through the allocation callbacks of
+     *      Kokkos Tools
+     *  @details Replaces any other allocation callbacks, e.g. of a tool, and should be called
+     *      after Kokkos is initialized
+     */
+    void EnableAllocationTracking();
+
+private:
+    mutable std::mutex mutex_;                                      //< Protects the maps
+    std::map<std::string, std::unique_ptr<Counter>> counters_;      //< Counters by name
+    std::map<std::string, std::unique_ptr<Gauge>> gauges_;          //< Gauges by name
+    std::map<std::string, std::unique_ptr<Histogram>> histograms_;  //< Histograms by name
+};
+
+/// Formats of the metrics written by a MetricsExporter
+enum class MetricsFormat {
+    kJsonLines = 0,  //< Appends one JSON record per export
+    kPrometheus = 1  //< Replaces the file with the Prometheus text of every export
+};
+
+/*! @brief Writes the metrics of a registry to a file periodically, from a background thread
+ *  @details The Prometheus text is written to a temporary file that then replaces the file, so
+ *      that readers never see a partial export. The metrics are also written once more when the
+ *      exporter stops, i.e. when it is destroyed.
+ */
+class MetricsExporter {
+public:
+    MetricsExporter(
+        const MetricsRegistry& registry, std::string file_name, MetricsFormat format,
+        std::chrono::milliseconds interval = std::chrono::seconds(10)
+    );
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /// Writes the current metrics, i.e. independent of the interval
+    void Export() const;
+
+    /// Returns the number of exports thus far
+    inline size_t GetNumberOfExports() const { return n_exports_.load(); }
+
+    /// Writes the metrics a last time and stops the background thread
+    void Stop();
+
+private:
+    const MetricsRegistry& registry_;        //< Registry of the exported metrics
+    std::string file_name_;                  //< File the metrics are written to
+    MetricsFormat format_;                   //< Format of the file
+    std::chrono::milliseconds interval_;     //< Time between two exports
+    mutable std::mutex mutex_;               //< Serializes the exports and protects stop_
+    std::condition_variable condition_;      //< Wakes up the thread to stop
+    bool stop_;                              //< Flag to stop the thread
+    mutable std::atomic<size_t> n_exports_;  //< Number of exports thus far
+    std::thread thread_;                     //< Background thread exporting the metrics
+};
+
+}  // namespace openturbine::util
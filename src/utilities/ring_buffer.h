@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace openturbine::util {
+
+/*! @brief A bounded, lock-free multi-producer ring buffer
+ *  @details Every slot carries a sequence number that tells producers and consumers whether the
+ *      slot is free to be written or ready to be read, so that TryPush() and TryPop() only need
+ *      a single compare-and-swap on the shared position and never block. The algorithm is
+ *      Dmitry Vyukov's bounded MPMC queue, here used with any number of producers and one
+ *      consumer, e.g. the threads emitting log records and the thread writing them out.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    /// Constructs a ring buffer with the provided capacity, which must be a power of two
+    explicit RingBuffer(size_t capacity = 1024)
+        : capacity_(capacity), slots_(new Slot[capacity]), push_position_(0), pop_position_(0) {
+        if (capacity_ == 0 || (capacity_ & (capacity_ - 1)) != 0) {
+            throw std::invalid_argument("The capacity of the ring buffer must be a power of two");
+        }
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /// Returns the maximum number of values the buffer can hold
+    inline size_t GetCapacity() const { return capacity_; }
+
+    /// Returns the (approximate, if accessed concurrently) number of values in the buffer
+    inline size_t GetSize() const {
+        return push_position_.load(std::memory_order_relaxed) -
+               pop_position_.load(std::memory_order_relaxed);
+    }
+
+    /// Moves the provided value into the buffer, returns false without modifying the value
+    /// if the buffer is full
+    bool TryPush(T& value) {
+        auto position = push_position_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &slots_[position & (capacity_ - 1)];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (push_position_.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed
+                    )) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = push_position_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = std::move(value);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Moves the oldest value of the buffer into the provided value, returns false if the
+    /// buffer is empty
+    bool TryPop(T& value) {
+        auto position = pop_position_.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &slots_[position & (capacity_ - 1)];
+            const auto sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+            if (difference == 0) {
+                if (pop_position_.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed
+                    )) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = pop_position_.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(slot->value);
+        slot->sequence.store(position + capacity_, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;  //< Position of the slot in the push/pop sequence
+        T value;                       //< Stored value
+    };
+
+    const size_t capacity_;              //< Maximum number of values, a power of two
+    std::unique_ptr<Slot[]> slots_;      //< Storage of the values
+    std::atomic<size_t> push_position_;  //< Position of the next push
+    std::atomic<size_t> pop_position_;   //< Position of the next pop
+};
+
+}  // namespace openturbine::util
@@ -0,0 +1,231 @@
+#include <benchmark/benchmark.h>
+
+#include "src/rigid_pendulum_poc/batched_solver.h"
+#include "src/rigid_pendulum_poc/execution_policy.h"
+#include "src/rigid_pendulum_poc/kinematics.h"
+#include "src/rigid_pendulum_poc/quaternion.h"
+#include "src/rigid_pendulum_poc/solver.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+#include "src/rigid_pendulum_poc/vector.h"
+#include "src/rigid_pendulum_poc/view_expressions.h"
+
+namespace openturbine::rigid_pendulum::benchmarks {
+
+/// Returns a diagonally dominant n x n matrix, i.e. one that is well conditioned for the solves
+static HostView2D create_benchmark_matrix(size_t n) {
+    auto matrix = HostView2D("matrix", n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            matrix(i, j) = (i == j) ? static_cast<double>(n) + 1. : 1. / (1. + i + j);
+        }
+    }
+    return matrix;
+}
+
+static void BM_QuaternionMultiply(benchmark::State& state) {
+    const auto q1 = quaternion_from_angle_axis(0.3, Vector(1., 0., 0.));
+    auto q2 = quaternion_from_angle_axis(0.5, Vector(0., 1., 1.).GetUnitVector());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(q2 = q1 * q2);
+    }
+}
+BENCHMARK(BM_QuaternionMultiply);
+
+static void BM_QuaternionFromRotationVector(benchmark::State& state) {
+    const auto rotation_vector = Vector(0.1, 0.2, 0.3);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(quaternion_from_rotation_vector(rotation_vector));
+    }
+}
+BENCHMARK(BM_QuaternionFromRotationVector);
+
+/// Evaluates the quaternion and the tangent operator of a rotation vector separately, i.e. as
+/// two exponential maps
+static void BM_QuaternionAndTangentOperator(benchmark::State& state) {
+    auto psi = Vec<3>{{0.1, 0.2, 0.3}};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(psi);
+        benchmark::DoNotOptimize(quaternion_from_rotation_vector(Vector{psi(0), psi(1), psi(2)}));
+        benchmark::DoNotOptimize(calculate_tangent_operator(psi, create_cross_product_matrix(psi)));
+    }
+}
+BENCHMARK(BM_QuaternionAndTangentOperator);
+
+/// Same as BM_QuaternionAndTangentOperator, but with one fused exponential map
+static void BM_ExponentialMap(benchmark::State& state) {
+    auto psi = Vec<3>{{0.1, 0.2, 0.3}};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(psi);
+        benchmark::DoNotOptimize(ExponentialMap::Calculate(psi));
+    }
+}
+BENCHMARK(BM_ExponentialMap);
+
+static void BM_RotationVectorFromQuaternion(benchmark::State& state) {
+    const auto quaternion = quaternion_from_rotation_vector(Vector(0.1, 0.2, 0.3));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rotation_vector_from_quaternion(quaternion));
+    }
+}
+BENCHMARK(BM_RotationVectorFromQuaternion);
+
+static void BM_MultiplyMatrixWithMatrix(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto a = create_benchmark_matrix(n);
+    const auto b = create_benchmark_matrix(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(multiply_matrix_with_matrix(a, b));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MultiplyMatrixWithMatrix)->Arg(3)->Arg(6)->Arg(9)->Arg(36)->Arg(90)->Complexity();
+
+// Residual of n velocities and n / 2 constraints, i.e. [M] {v'} + {g} + [B]^T {Lambda}, with one
+// view per intermediate result
+static void BM_ResidualWithIntermediateViews(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto mass_matrix = create_benchmark_matrix(n);
+    const auto constraint_gradient = HostView2D("constraint_gradient", n / 2, n);
+    const auto acceleration = create_identity_vector(n);
+    const auto forces = create_identity_vector(n);
+    const auto lagrange_mults = create_identity_vector(n / 2);
+    for (auto _ : state) {
+        auto residual = multiply_matrix_with_vector(mass_matrix, acceleration);
+        const auto reactions =
+            multiply_matrix_with_vector(transpose_matrix(constraint_gradient), lagrange_mults);
+        for (size_t i = 0; i < n; ++i) {
+            residual(i) += forces(i) + reactions(i);
+        }
+        benchmark::DoNotOptimize(residual);
+    }
+}
+BENCHMARK(BM_ResidualWithIntermediateViews)->Arg(12)->Arg(36)->Arg(90);
+
+// Same residual as a single expression, i.e. in one loop without intermediate views
+static void BM_ResidualWithViewExpression(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto mass_matrix = create_benchmark_matrix(n);
+    const auto constraint_gradient = HostView2D("constraint_gradient", n / 2, n);
+    const auto acceleration = create_identity_vector(n);
+    const auto forces = create_identity_vector(n);
+    const auto lagrange_mults = create_identity_vector(n / 2);
+    const auto residual = HostView1D("residual", n);
+    for (auto _ : state) {
+        assign(
+            residual, lazy(mass_matrix) * acceleration + forces +
+                          transpose(constraint_gradient) * lagrange_mults
+        );
+        benchmark::DoNotOptimize(residual.data());
+    }
+}
+BENCHMARK(BM_ResidualWithViewExpression)->Arg(12)->Arg(36)->Arg(90);
+
+/// Scales a vector of the size of the heavy top's system on the provided execution space, i.e.
+/// the launch overhead of a small kernel, e.g. of OpenMP compared to the inline Serial dispatch
+/// of host_parallel_for
+template <typename ExecutionSpace>
+static void BM_SmallKernelDispatch(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto vector = create_identity_vector(n);
+    for (auto _ : state) {
+        Kokkos::parallel_for(
+            "scale_vector", Kokkos::RangePolicy<ExecutionSpace>(0, n),
+            [vector](size_t i) { vector(i) *= 1.0001; }
+        );
+        benchmark::DoNotOptimize(vector.data());
+    }
+}
+BENCHMARK_TEMPLATE(BM_SmallKernelDispatch, Kokkos::DefaultHostExecutionSpace)->Arg(9);
+BENCHMARK_TEMPLATE(BM_SmallKernelDispatch, InlineExecutionSpace)->Arg(9);
+
+static void BM_SolveLinearSystem(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto matrix = create_benchmark_matrix(n);
+    auto system = HostView2D("system", n, n);
+    auto solution = HostView1D("solution", n);
+    auto pivots = HostIntView1D("pivots", n);
+    for (auto _ : state) {
+        // The solve overwrites the system with its factors, i.e. restore it in every iteration -
+        // the O(n^2) copies are timed as well, since pausing the timer costs more at small sizes
+        Kokkos::deep_copy(system, matrix);
+        Kokkos::deep_copy(solution, 1.);
+        solve_linear_system(system, solution, pivots);
+        benchmark::DoNotOptimize(solution.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SolveLinearSystem)->Arg(9)->Arg(36)->Arg(90)->Complexity();
+
+/// Solves 1024 systems of size n one after the other with LAPACKE, i.e. the reference for the
+/// batched solve below
+static void BM_SolveLinearSystemsOneByOne(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const size_t n_systems = 1024;
+    const auto matrix = create_benchmark_matrix(n);
+    auto system = HostView2D("system", n, n);
+    auto solution = HostView1D("solution", n);
+    auto pivots = HostIntView1D("pivots", n);
+    for (auto _ : state) {
+        for (size_t s = 0; s < n_systems; ++s) {
+            Kokkos::deep_copy(system, matrix);
+            Kokkos::deep_copy(solution, 1.);
+            solve_linear_system(system, solution, pivots);
+            benchmark::DoNotOptimize(solution.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n_systems));
+}
+BENCHMARK(BM_SolveLinearSystemsOneByOne)->Arg(6)->Arg(9)->Arg(12);
+
+/// Solves 1024 systems of size n at once with the batched small-system LU
+static void BM_SolveBatchedLinearSystems(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const size_t n_systems = 1024;
+    const auto matrix = create_benchmark_matrix(n);
+    auto matrices = HostView3D("matrices", n_systems, n, n);
+    for (size_t s = 0; s < n_systems; ++s) {
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                matrices(s, i, j) = matrix(i, j);
+            }
+        }
+    }
+    auto systems = HostView3D("systems", n_systems, n, n);
+    auto solutions = HostView2D("solutions", n_systems, n);
+    for (auto _ : state) {
+        Kokkos::deep_copy(systems, matrices);
+        Kokkos::deep_copy(solutions, 1.);
+        solve_batched_linear_systems<Kokkos::DefaultHostExecutionSpace>(systems, solutions);
+        benchmark::DoNotOptimize(solutions.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n_systems));
+}
+BENCHMARK(BM_SolveBatchedLinearSystems)->Arg(6)->Arg(9)->Arg(12)->Arg(15);
+
+/// Factorizes and solves an n x n system with the dense solver in the provided precision
+template <FactorizationPrecision precision>
+static void BM_FactorizeAndSolve(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto matrix = create_benchmark_matrix(n);
+    auto solver = DenseLinearSolver(n, precision);
+    auto solution = HostView1D("solution", n);
+    for (auto _ : state) {
+        solver.Factorize(matrix);
+        Kokkos::deep_copy(solution, 1.);
+        solver.Solve(solution);
+        benchmark::DoNotOptimize(solution.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_FactorizeAndSolve, FactorizationPrecision::kDOUBLE)
+    ->Arg(9)
+    ->Arg(90)
+    ->Arg(900)
+    ->Complexity();
+BENCHMARK_TEMPLATE(BM_FactorizeAndSolve, FactorizationPrecision::kMIXED)
+    ->Arg(9)
+    ->Arg(90)
+    ->Arg(900)
+    ->Complexity();
+
+}  // namespace openturbine::rigid_pendulum::benchmarks
@@ -0,0 +1,130 @@
+/** \file benchmark_main.cpp
+ *  Entry point for the benchmarks
+ *
+ *  The Kokkos backend is the default execution space of the Kokkos build, the number of threads
+ *  is set with the usual Kokkos arguments, e.g.
+ *      openturbine_benchmarks --kokkos-num-threads=8 --benchmark_filter=Integrate
+ *  Both are reported in the context of the benchmark results.
+ *
+ *  The Kokkos allocations of every benchmark are counted with the Kokkos Tools allocation
+ *  callbacks, i.e. reported as allocs_per_iter and max_bytes_used. With
+ *  --performance_baselines=<file> the median times and the allocations are compared against
+ *  stored baselines, which is what the performance tests of ctest do, e.g.
+ *      openturbine_benchmarks --benchmark_filter=Integrate/1000 --benchmark_repetitions=5
+ *          --performance_baselines=performance_baselines.csv --performance_tolerance=0.5
+ *          --performance_results=results.json
+ *  exits with a failure if any benchmark is more than 50% slower or allocates more often than
+ *  its baseline. --update_performance_baselines writes the measurements to the baselines file
+ *  instead, e.g. to record the baselines of a new machine.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include <Kokkos_Core.hpp>
+#include <benchmark/benchmark.h>
+
+#include "src/utilities/log.h"
+#include "tests/benchmarks/performance_check.h"
+
+namespace {
+
+/// Records the number and the peak size of the Kokkos allocations between Start() and Stop()
+class KokkosMemoryManager : public benchmark::MemoryManager {
+public:
+    void Start() override {
+        n_allocations_ = 0;
+        bytes_in_use_ = 0;
+        max_bytes_in_use_ = 0;
+        total_allocated_bytes_ = 0;
+        Kokkos::Tools::Experimental::set_allocate_data_callback(CountAllocation);
+        Kokkos::Tools::Experimental::set_deallocate_data_callback(CountDeallocation);
+    }
+
+    void Stop(Result& result) override {
+        Kokkos::Tools::Experimental::set_allocate_data_callback(nullptr);
+        Kokkos::Tools::Experimental::set_deallocate_data_callback(nullptr);
+        result.num_allocs = n_allocations_;
+        result.max_bytes_used = max_bytes_in_use_;
+        result.total_allocated_bytes = total_allocated_bytes_;
+        result.net_heap_growth = bytes_in_use_;
+    }
+
+    void Stop(Result* result) override { Stop(*result); }
+
+private:
+    static inline int64_t n_allocations_ = 0;
+    static inline int64_t bytes_in_use_ = 0;
+    static inline int64_t max_bytes_in_use_ = 0;
+    static inline int64_t total_allocated_bytes_ = 0;
+
+    static void CountAllocation(
+        const Kokkos::Tools::SpaceHandle, const char*, const void*, const uint64_t size
+    ) {
+        ++n_allocations_;
+        bytes_in_use_ += static_cast<int64_t>(size);
+        total_allocated_bytes_ += static_cast<int64_t>(size);
+        max_bytes_in_use_ = std::max(max_bytes_in_use_, bytes_in_use_);
+    }
+
+    static void CountDeallocation(
+        const Kokkos::Tools::SpaceHandle, const char*, const void*, const uint64_t size
+    ) {
+        bytes_in_use_ -= static_cast<int64_t>(size);
+    }
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Kokkos::initialize(argc, argv);
+
+    // Only log errors, and only to file, so that the time steps are not dominated by logging
+    openturbine::util::Log::Get(
+        "openturbine_benchmarks.log", openturbine::util::SeverityLevel::kError,
+        openturbine::util::OutputType::kFile
+    );
+
+    benchmark::AddCustomContext("kokkos_execution_space", Kokkos::DefaultExecutionSpace::name());
+    benchmark::AddCustomContext(
+        "kokkos_concurrency", std::to_string(Kokkos::DefaultExecutionSpace().concurrency())
+    );
+
+    auto memory_manager = KokkosMemoryManager();
+    benchmark::RegisterMemoryManager(&memory_manager);
+
+    int status = 0;
+    try {
+        const auto options = openturbine::benchmarks::parse_performance_check_arguments(argc, argv);
+        benchmark::Initialize(&argc, argv);
+        if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+            status = 1;
+        } else {
+            auto reporter =
+                openturbine::benchmarks::PerformanceReporter(benchmark::ConsoleReporter::OO_Tabular);
+            benchmark::RunSpecifiedBenchmarks(&reporter);
+            if (options.is_update) {
+                openturbine::benchmarks::write_performance_baselines(
+                    options.baselines_file, reporter.GetMeasurements()
+                );
+                std::cout << "Performance baselines written to " << options.baselines_file << "\n";
+            } else if (!options.baselines_file.empty()) {
+                const auto n_regressions = openturbine::benchmarks::check_performance(
+                    options, reporter.GetMeasurements(), std::cout
+                );
+                status = (n_regressions > 0) ? 1 : 0;
+            }
+        }
+    } catch (const std::exception& exception) {
+        std::cerr << exception.what() << "\n";
+        status = 1;
+    }
+    benchmark::Shutdown();
+    benchmark::RegisterMemoryManager(nullptr);
+
+    Kokkos::finalize();
+    return status;
+}
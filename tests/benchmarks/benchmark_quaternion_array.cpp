@@ -0,0 +1,136 @@
+#include <vector>
+
+#include <Kokkos_Core.hpp>
+#include <benchmark/benchmark.h>
+
+#include "src/rigid_pendulum_poc/quaternion_array.h"
+
+namespace openturbine::rigid_pendulum::benchmarks {
+
+/// Returns n unit quaternions of varying orientations, stored as an array of structs
+static std::vector<Quaternion> create_benchmark_quaternions(size_t n) {
+    auto quaternions = std::vector<Quaternion>(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto s = static_cast<double>(i) / static_cast<double>(n);
+        quaternions[i] = quaternion_from_rotation_vector(Vector(s, 1. - s, 0.5 * s));
+    }
+    return quaternions;
+}
+
+/// Returns the struct-of-arrays counterpart of the provided quaternions on the host
+static QuaternionArray<Kokkos::HostSpace> create_quaternion_array(
+    const std::vector<Quaternion>& quaternions
+) {
+    auto array = QuaternionArray<Kokkos::HostSpace>(quaternions.size());
+    auto components = array.GetComponents();
+    for (size_t i = 0; i < quaternions.size(); ++i) {
+        components(0, i) = quaternions[i].GetScalarComponent();
+        components(1, i) = quaternions[i].GetXComponent();
+        components(2, i) = quaternions[i].GetYComponent();
+        components(3, i) = quaternions[i].GetZComponent();
+    }
+    return array;
+}
+
+/// Sets the quaternions processed per second and the bytes read and written from/to memory
+static void set_quaternion_counters(benchmark::State& state, size_t n, size_t doubles_per_entry) {
+    const auto n_processed = static_cast<int64_t>(n) * state.iterations();
+    state.SetItemsProcessed(n_processed);
+    state.SetBytesProcessed(n_processed * static_cast<int64_t>(doubles_per_entry * sizeof(double)));
+}
+
+/// Composes n pairs of quaternions one at a time, i.e. the array-of-structs baseline
+static void BM_ComposeQuaternionsScalar(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto a = create_benchmark_quaternions(n);
+    const auto b = create_benchmark_quaternions(n);
+    auto result = std::vector<Quaternion>(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            result[i] = a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    set_quaternion_counters(state, n, 12);
+}
+BENCHMARK(BM_ComposeQuaternionsScalar)->Range(1 << 10, 1 << 20);
+
+static void BM_ComposeQuaternions(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto a = create_quaternion_array(create_benchmark_quaternions(n));
+    const auto b = create_quaternion_array(create_benchmark_quaternions(n));
+    auto result = QuaternionArray<Kokkos::HostSpace>(n);
+    for (auto _ : state) {
+        compose_quaternions<Kokkos::DefaultHostExecutionSpace>(a, b, result);
+        Kokkos::fence();
+        benchmark::DoNotOptimize(result.GetComponents().data());
+    }
+    set_quaternion_counters(state, n, 12);
+}
+BENCHMARK(BM_ComposeQuaternions)->Range(1 << 10, 1 << 20);
+
+/// Rotates n vectors one at a time, i.e. the array-of-structs baseline
+static void BM_RotateVectorsScalar(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto quaternions = create_benchmark_quaternions(n);
+    const auto vectors = std::vector<Vector>(n, Vector(1., 2., 3.));
+    auto result = std::vector<Vector>(n);
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            result[i] = rotate_vector(quaternions[i], vectors[i]);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    set_quaternion_counters(state, n, 10);
+}
+BENCHMARK(BM_RotateVectorsScalar)->Range(1 << 10, 1 << 20);
+
+static void BM_RotateVectors(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto quaternions = create_quaternion_array(create_benchmark_quaternions(n));
+    auto vectors = VectorArray<Kokkos::HostSpace>(n);
+    Kokkos::deep_copy(vectors.GetComponents(), 1.);
+    auto result = VectorArray<Kokkos::HostSpace>(n);
+    for (auto _ : state) {
+        rotate_vectors<Kokkos::DefaultHostExecutionSpace>(quaternions, vectors, result);
+        Kokkos::fence();
+        benchmark::DoNotOptimize(result.GetComponents().data());
+    }
+    set_quaternion_counters(state, n, 10);
+}
+BENCHMARK(BM_RotateVectors)->Range(1 << 10, 1 << 20);
+
+static void BM_QuaternionsFromRotationVectors(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    auto rotation_vectors = VectorArray<Kokkos::HostSpace>(n);
+    Kokkos::deep_copy(rotation_vectors.GetComponents(), 0.3);
+    auto result = QuaternionArray<Kokkos::HostSpace>(n);
+    for (auto _ : state) {
+        quaternions_from_rotation_vectors<Kokkos::DefaultHostExecutionSpace>(
+            rotation_vectors, result
+        );
+        Kokkos::fence();
+        benchmark::DoNotOptimize(result.GetComponents().data());
+    }
+    set_quaternion_counters(state, n, 7);
+}
+BENCHMARK(BM_QuaternionsFromRotationVectors)->Range(1 << 10, 1 << 20);
+
+static void BM_ExponentialMaps(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    auto rotation_vectors = VectorArray<Kokkos::HostSpace>(n);
+    Kokkos::deep_copy(rotation_vectors.GetComponents(), 0.3);
+    auto quaternions = QuaternionArray<Kokkos::HostSpace>(n);
+    auto tangent_operators = HostView3D("tangent_operators", 3, 3, n);
+    for (auto _ : state) {
+        exponential_maps<Kokkos::DefaultHostExecutionSpace>(
+            rotation_vectors, quaternions, tangent_operators
+        );
+        Kokkos::fence();
+        benchmark::DoNotOptimize(tangent_operators.data());
+    }
+    set_quaternion_counters(state, n, 16);
+}
+BENCHMARK(BM_ExponentialMaps)->Range(1 << 10, 1 << 20);
+
+}  // namespace openturbine::rigid_pendulum::benchmarks
@@ -0,0 +1,213 @@
+#include <cmath>
+#include <memory>
+
+#include <Kokkos_Core.hpp>
+#include <benchmark/benchmark.h>
+
+#include "src/rigid_pendulum_poc/batched_generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/state_history.h"
+#include "src/rigid_pendulum_poc/state_observer.h"
+
+namespace openturbine::rigid_pendulum::benchmarks {
+
+/// Returns the initial state of the heavy top problem from Brüls and Cardona (2010)
+static State create_heavy_top_initial_state() {
+    auto q0 = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    auto v0 = create_vector({-4.61538, 0., 0., 0., 150., -4.61538});
+    auto a0 =
+        create_vector({0., -21.301732544400004, -30.960830769230938, 661.3461692307692, 0., 0.});
+    auto aa0 = create_vector({0., 0., 0., 0., 0., 0.});
+    return State(q0, v0, a0, aa0);
+}
+
+/// Returns a generalized-alpha time integrator with the parameters of Brüls and Cardona (2010)
+static GeneralizedAlphaTimeIntegrator create_heavy_top_time_integrator(
+    size_t n_steps, LinearSolverPolicy linear_solver_policy = LinearSolverPolicy()
+) {
+    const auto rho_inf = 0.6;
+    const auto alpha_m = (2. * rho_inf - 1.) / (rho_inf + 1.);
+    const auto alpha_f = rho_inf / (rho_inf + 1.);
+    const auto gamma = 0.5 + alpha_f - alpha_m;
+    const auto beta = 0.25 * std::pow(gamma + 0.5, 2);
+    return GeneralizedAlphaTimeIntegrator(
+        alpha_f, alpha_m, beta, gamma, TimeStepper(0., 0.002, n_steps, 10), true,
+        linear_solver_policy
+    );
+}
+
+static void BM_HeavyTopResidualVector(benchmark::State& state) {
+    auto lin_params = HeavyTopLinearizationParameters();
+    const auto initial_state = create_heavy_top_initial_state();
+    const auto lagrange_mults = create_vector({1., 2., 3.});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lin_params.ResidualVector(
+            initial_state.GetGeneralizedCoordinates(), initial_state.GetVelocity(),
+            initial_state.GetAcceleration(), lagrange_mults
+        ));
+    }
+}
+BENCHMARK(BM_HeavyTopResidualVector);
+
+static void BM_HeavyTopIterationMatrix(benchmark::State& state) {
+    auto lin_params = HeavyTopLinearizationParameters();
+    const auto initial_state = create_heavy_top_initial_state();
+    const auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6.});
+    const auto lagrange_mults = create_vector({1., 2., 3.});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lin_params.IterationMatrix(
+            0.002, 1., 1., initial_state.GetGeneralizedCoordinates(), delta_gen_coords,
+            initial_state.GetVelocity(), initial_state.GetAcceleration(), lagrange_mults
+        ));
+    }
+}
+BENCHMARK(BM_HeavyTopIterationMatrix);
+
+static void BM_HeavyTopLinearize(benchmark::State& state) {
+    auto lin_params = HeavyTopLinearizationParameters();
+    const auto initial_state = create_heavy_top_initial_state();
+    const auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6.});
+    const auto lagrange_mults = create_vector({1., 2., 3.});
+    auto residual_vector = HostView1D("residual_vector", HeavyTop::kSystemSize);
+    auto iteration_matrix =
+        HostView2D("iteration_matrix", HeavyTop::kSystemSize, HeavyTop::kSystemSize);
+    for (auto _ : state) {
+        lin_params.Linearize(
+            0.002, 1., 1., initial_state.GetGeneralizedCoordinates(), delta_gen_coords,
+            initial_state.GetVelocity(), initial_state.GetAcceleration(), lagrange_mults,
+            residual_vector, true, iteration_matrix
+        );
+        benchmark::DoNotOptimize(iteration_matrix.data());
+    }
+}
+BENCHMARK(BM_HeavyTopLinearize);
+
+static void BM_AlphaStep(benchmark::State& state) {
+    auto time_integrator = create_heavy_top_time_integrator(1);
+    auto lin_params = std::make_shared<HeavyTopLinearizationParameters>();
+    const auto initial_state = create_heavy_top_initial_state();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(time_integrator.AlphaStep(initial_state, 3, lin_params));
+    }
+}
+BENCHMARK(BM_AlphaStep);
+
+/// Same as BM_AlphaStep, but with the problem dispatched statically, i.e. by its concrete type
+static void BM_AlphaStepStaticDispatch(benchmark::State& state) {
+    auto time_integrator = create_heavy_top_time_integrator(1);
+    auto lin_params = HeavyTopLinearizationParameters();
+    const auto initial_state = create_heavy_top_initial_state();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(time_integrator.AlphaStep(initial_state, 3, lin_params));
+    }
+}
+BENCHMARK(BM_AlphaStepStaticDispatch);
+
+/// Same as BM_AlphaStep, but with matrix-free GMRES solves instead of the LU factorization
+static void BM_AlphaStepNewtonKrylov(benchmark::State& state) {
+    auto policy = LinearSolverPolicy{};
+    policy.type = LinearSolverType::kNEWTON_KRYLOV;
+    auto time_integrator = create_heavy_top_time_integrator(1, policy);
+    auto lin_params = std::make_shared<HeavyTopLinearizationParameters>();
+    const auto initial_state = create_heavy_top_initial_state();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(time_integrator.AlphaStep(initial_state, 3, lin_params));
+    }
+}
+BENCHMARK(BM_AlphaStepNewtonKrylov);
+
+/// Integrates the heavy top for the provided number of time steps, without any stored history
+static void BM_Integrate(benchmark::State& state) {
+    const auto n_steps = static_cast<size_t>(state.range(0));
+    auto lin_params = std::make_shared<HeavyTopLinearizationParameters>();
+    const auto initial_state = create_heavy_top_initial_state();
+    auto observer = CallbackObserver([](const TimeStepRecord&) {});
+    for (auto _ : state) {
+        auto time_integrator = create_heavy_top_time_integrator(n_steps);
+        time_integrator.Integrate(initial_state, 3, lin_params, observer);
+    }
+    state.counters["steps_per_second"] = benchmark::Counter(
+        static_cast<double>(n_steps * state.iterations()), benchmark::Counter::kIsRate
+    );
+}
+BENCHMARK(BM_Integrate)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+/// Same as BM_Integrate, but storing the states of all time steps, i.e. one State per time step
+static void BM_IntegrateWithStateHistoryObserver(benchmark::State& state) {
+    const auto n_steps = static_cast<size_t>(state.range(0));
+    auto lin_params = std::make_shared<HeavyTopLinearizationParameters>();
+    const auto initial_state = create_heavy_top_initial_state();
+    for (auto _ : state) {
+        auto time_integrator = create_heavy_top_time_integrator(n_steps);
+        auto history = StateHistoryObserver();
+        time_integrator.Integrate(initial_state, 3, lin_params, history);
+        benchmark::DoNotOptimize(history.GetStates().data());
+    }
+}
+BENCHMARK(BM_IntegrateWithStateHistoryObserver)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+/// Same as BM_IntegrateWithStateHistoryObserver, but storing the states in the preallocated
+/// arena of a StateHistory
+static void BM_IntegrateWithStateHistory(benchmark::State& state) {
+    const auto n_steps = static_cast<size_t>(state.range(0));
+    auto lin_params = std::make_shared<HeavyTopLinearizationParameters>();
+    const auto initial_state = create_heavy_top_initial_state();
+    for (auto _ : state) {
+        auto time_integrator = create_heavy_top_time_integrator(n_steps);
+        auto history = StateHistory(7, 6, StateHistory::RequiredCapacity(n_steps));
+        time_integrator.Integrate(initial_state, 3, lin_params, history);
+        benchmark::DoNotOptimize(history.GetSamples().data());
+    }
+}
+BENCHMARK(BM_IntegrateWithStateHistory)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+/// Integrates an ensemble of heavy tops on the provided execution space, the number of threads
+/// is set at run time with the Kokkos arguments
+template <typename ExecutionSpace>
+static void BM_BatchedIntegrate(benchmark::State& state) {
+    using TimeIntegrator = BatchedGeneralizedAlphaTimeIntegrator<ExecutionSpace>;
+
+    const auto n_bodies = static_cast<size_t>(state.range(0));
+    const size_t n_steps = 100;
+    auto bodies = typename TimeIntegrator::BodiesView("bodies", n_bodies);
+    Kokkos::deep_copy(bodies, HeavyTop());
+    auto states = typename TimeIntegrator::BatchedStateType(n_bodies);
+    const auto initial_state = create_heavy_top_initial_state();
+
+    const auto reference_integrator = create_heavy_top_time_integrator(n_steps);
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (size_t i = 0; i < n_bodies; ++i) {
+            states.SetState(i, initial_state);
+        }
+        auto time_integrator = TimeIntegrator(
+            reference_integrator.GetAlphaF(), reference_integrator.GetAlphaM(),
+            reference_integrator.GetBeta(), reference_integrator.GetGamma(),
+            reference_integrator.GetTimeStepper(), true
+        );
+        state.ResumeTiming();
+
+        time_integrator.Integrate(states, bodies);
+        Kokkos::fence();
+    }
+    state.counters["steps_per_second"] = benchmark::Counter(
+        static_cast<double>(n_steps * state.iterations()), benchmark::Counter::kIsRate
+    );
+    state.counters["body_steps_per_second"] = benchmark::Counter(
+        static_cast<double>(n_bodies * n_steps * state.iterations()), benchmark::Counter::kIsRate
+    );
+    state.counters["concurrency"] = ExecutionSpace().concurrency();
+}
+BENCHMARK_TEMPLATE(BM_BatchedIntegrate, Kokkos::DefaultHostExecutionSpace)
+    ->RangeMultiplier(8)
+    ->Range(1, 512)
+    ->Unit(benchmark::kMillisecond);
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL)
+BENCHMARK_TEMPLATE(BM_BatchedIntegrate, Kokkos::DefaultExecutionSpace)
+    ->RangeMultiplier(8)
+    ->Range(1, 4096)
+    ->Unit(benchmark::kMillisecond);
+#endif
+
+}  // namespace openturbine::rigid_pendulum::benchmarks
@@ -0,0 +1,199 @@
+#include "tests/benchmarks/performance_check.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace openturbine::benchmarks {
+
+namespace {
+
+/// Returns the value of the provided command line argument if it starts with the option, e.g.
+/// "--option=", or nullptr
+const char* get_option_value(const char* argument, const char* option) {
+    const auto length = std::strlen(option);
+    return (std::strncmp(argument, option, length) == 0) ? argument + length : nullptr;
+}
+
+/// Returns the median of the provided values
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const auto n = values.size();
+    return (n % 2 == 1) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+}
+
+/// Returns the provided string as a JSON string, i.e. quoted with quotes/backslashes escaped
+std::string to_json_string(const std::string& value) {
+    auto json = std::string("\"");
+    for (const auto c : value) {
+        if (c == '"' || c == '\\') {
+            json += '\\';
+        }
+        json += c;
+    }
+    return json + "\"";
+}
+
+}  // namespace
+
+PerformanceCheckOptions parse_performance_check_arguments(int& argc, char** argv) {
+    auto options = PerformanceCheckOptions{};
+    int n_remaining = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (const auto* baselines = get_option_value(argv[i], "--performance_baselines=")) {
+            options.baselines_file = baselines;
+        } else if (const auto* results = get_option_value(argv[i], "--performance_results=")) {
+            options.results_file = results;
+        } else if (const auto* tolerance = get_option_value(argv[i], "--performance_tolerance=")) {
+            options.time_tolerance = std::stod(tolerance);
+            if (options.time_tolerance < 0.) {
+                throw std::invalid_argument("The performance tolerance must not be negative");
+            }
+        } else if (std::strcmp(argv[i], "--update_performance_baselines") == 0) {
+            options.is_update = true;
+        } else {
+            argv[n_remaining++] = argv[i];
+        }
+    }
+    argc = n_remaining;
+    if (options.is_update && options.baselines_file.empty()) {
+        throw std::invalid_argument(
+            "--update_performance_baselines requires --performance_baselines=<file>"
+        );
+    }
+    return options;
+}
+
+void PerformanceReporter::ReportRuns(const std::vector<Run>& runs) {
+    benchmark::ConsoleReporter::ReportRuns(runs);
+    for (const auto& run : runs) {
+        if (run.error_occurred || run.run_type != Run::RT_Iteration) {
+            continue;
+        }
+        const auto name = run.run_name.str();
+        const auto real_time_ns =
+            run.GetAdjustedRealTime() * 1e9 / benchmark::GetTimeUnitMultiplier(run.time_unit);
+        real_times_ns_[name].push_back(real_time_ns);
+        allocs_per_iter_[name] = run.allocs_per_iter;
+    }
+}
+
+PerformanceMeasurements PerformanceReporter::GetMeasurements() const {
+    auto measurements = PerformanceMeasurements{};
+    for (const auto& [name, real_times_ns] : real_times_ns_) {
+        measurements[name] =
+            PerformanceMeasurement{median(real_times_ns), allocs_per_iter_.at(name)};
+    }
+    return measurements;
+}
+
+PerformanceMeasurements read_performance_baselines(const std::string& file) {
+    auto baselines = PerformanceMeasurements{};
+    auto input = std::ifstream(file);
+    auto line = std::string{};
+    while (std::getline(input, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        // The names may contain commas, e.g. of templated benchmarks, but the numbers do not
+        const auto allocs_separator = line.rfind(',');
+        const auto time_separator = (allocs_separator == std::string::npos || allocs_separator == 0)
+                                        ? std::string::npos
+                                        : line.rfind(',', allocs_separator - 1);
+        if (time_separator == std::string::npos) {
+            throw std::invalid_argument("Malformed performance baseline: " + line);
+        }
+        auto values = std::istringstream(line.substr(time_separator + 1));
+        auto baseline = PerformanceMeasurement{};
+        auto separator = ',';
+        if (!(values >> baseline.real_time_ns >> separator >> baseline.allocs_per_iter)) {
+            throw std::invalid_argument("Malformed performance baseline: " + line);
+        }
+        baselines[line.substr(0, time_separator)] = baseline;
+    }
+    return baselines;
+}
+
+void write_performance_baselines(
+    const std::string& file, const PerformanceMeasurements& measurements
+) {
+    auto baselines = read_performance_baselines(file);
+    for (const auto& [name, measurement] : measurements) {
+        baselines[name] = measurement;
+    }
+
+    auto output = std::ofstream(file);
+    if (!output) {
+        throw std::runtime_error("Cannot write the performance baselines to " + file);
+    }
+    output << "# name, median real time per iteration [ns], Kokkos allocations per iteration\n";
+    output << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (const auto& [name, baseline] : baselines) {
+        output << name << "," << baseline.real_time_ns << "," << baseline.allocs_per_iter << "\n";
+    }
+}
+
+size_t check_performance(
+    const PerformanceCheckOptions& options, const PerformanceMeasurements& measurements,
+    std::ostream& output
+) {
+    const auto baselines = read_performance_baselines(options.baselines_file);
+    auto json = std::ostringstream{};
+    json << std::setprecision(std::numeric_limits<double>::max_digits10);
+    json << "{\n  \"time_tolerance\": " << options.time_tolerance << ",\n  \"benchmarks\": [";
+
+    output << "\nPerformance check against " << options.baselines_file << "\n";
+    size_t n_regressions = 0;
+    auto separator = "";
+    for (const auto& [name, measurement] : measurements) {
+        json << separator << "\n    {\"name\": " << to_json_string(name)
+             << ", \"real_time_ns\": " << measurement.real_time_ns
+             << ", \"allocs_per_iter\": " << measurement.allocs_per_iter;
+        separator = ",";
+
+        const auto baseline = baselines.find(name);
+        if (baseline == baselines.end()) {
+            output << "  " << name << ": no baseline\n";
+            json << ", \"status\": \"no_baseline\"}";
+            continue;
+        }
+
+        const auto time_ratio = measurement.real_time_ns / baseline->second.real_time_ns;
+        const auto is_slower = time_ratio > 1. + options.time_tolerance;
+        // Allocation counts are deterministic, i.e. any increase is a regression
+        const auto has_more_allocations =
+            measurement.allocs_per_iter > baseline->second.allocs_per_iter + 1e-9;
+        const auto* status = is_slower              ? "slower"
+                             : has_more_allocations ? "more_allocations"
+                                                    : "pass";
+        n_regressions += (is_slower || has_more_allocations) ? 1 : 0;
+
+        output << "  " << name << ": " << status << " (time " << std::fixed
+               << std::setprecision(2) << time_ratio << "x baseline, "
+               << measurement.allocs_per_iter << " vs " << baseline->second.allocs_per_iter
+               << " allocations per iteration)\n"
+               << std::defaultfloat;
+        json << ", \"baseline_real_time_ns\": " << baseline->second.real_time_ns
+             << ", \"baseline_allocs_per_iter\": " << baseline->second.allocs_per_iter
+             << ", \"time_ratio\": " << time_ratio << ", \"status\": \"" << status << "\"}";
+    }
+    json << "\n  ],\n  \"regressions\": " << n_regressions << "\n}\n";
+    output << n_regressions << " of " << measurements.size() << " benchmarks regressed\n";
+
+    if (!options.results_file.empty()) {
+        auto results = std::ofstream(options.results_file);
+        if (!results) {
+            throw std::runtime_error(
+                "Cannot write the performance results to " + options.results_file
+            );
+        }
+        results << json.str();
+    }
+    return n_regressions;
+}
+
+}  // namespace openturbine::benchmarks
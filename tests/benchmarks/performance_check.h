@@ -0,0 +1,74 @@
+#pragma once
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace openturbine::benchmarks {
+
+/// Measured performance of a benchmark, i.e. its median time over the repetitions and its
+/// number of Kokkos allocations per iteration
+struct PerformanceMeasurement {
+    double real_time_ns = 0.;     //< Median real time per iteration in nanoseconds
+    double allocs_per_iter = 0.;  //< Kokkos allocations per iteration
+};
+
+using PerformanceMeasurements = std::map<std::string, PerformanceMeasurement>;
+
+/// Options of the performance check, set with the --performance_* arguments of the benchmarks
+struct PerformanceCheckOptions {
+    std::string baselines_file;  //< File of the baselines, no check if empty
+    std::string results_file;    //< File of the machine-readable results, none if empty
+    double time_tolerance = 1.;  //< Allowed relative increase of the times over their baselines
+    bool is_update = false;      //< Flag to write the measurements to the baselines file
+};
+
+/*! @brief Reads and removes the performance check arguments from the command line, i.e.
+ *      --performance_baselines=<file>, --performance_results=<file>,
+ *      --performance_tolerance=<relative increase> and --update_performance_baselines, so that
+ *      the remaining arguments can be passed on to Google Benchmark
+ */
+PerformanceCheckOptions parse_performance_check_arguments(int& argc, char** argv);
+
+/// Reports the benchmarks to the console like the default reporter and records their
+/// measurements for the performance check
+class PerformanceReporter : public benchmark::ConsoleReporter {
+public:
+    using benchmark::ConsoleReporter::ConsoleReporter;
+
+    void ReportRuns(const std::vector<Run>& runs) override;
+
+    /// Returns the measurements of all benchmarks reported thus far
+    PerformanceMeasurements GetMeasurements() const;
+
+private:
+    std::map<std::string, std::vector<double>> real_times_ns_;  //< Times of all repetitions
+    std::map<std::string, double> allocs_per_iter_;             //< Allocations per iteration
+};
+
+/// Reads baselines written by write_performance_baselines(), i.e. lines of name, real time in
+/// nanoseconds and allocations per iteration separated by commas - an absent file has none
+PerformanceMeasurements read_performance_baselines(const std::string& file);
+
+/// Writes the provided measurements to the baselines file, keeping the baselines of other
+/// benchmarks already in it
+void write_performance_baselines(
+    const std::string& file, const PerformanceMeasurements& measurements
+);
+
+/*! @brief Compares the measurements with their baselines, prints the comparison, and writes it
+ *      as JSON to the results file of the options, if any
+ *  @details A benchmark regresses if its time exceeds its baseline by more than the tolerance
+ *      or if it allocates more often than its baseline - benchmarks without a baseline are
+ *      reported but never regress
+ *  @return The number of regressed benchmarks
+ */
+size_t check_performance(
+    const PerformanceCheckOptions& options, const PerformanceMeasurements& measurements,
+    std::ostream& output
+);
+
+}  // namespace openturbine::benchmarks
@@ -0,0 +1,388 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/automatic_differentiation.h"
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/multibody_model.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+// Residual of a chain of identical rigid bodies connected by spherical joints, i.e. the residual
+// of MultibodyModel written once on any scalar type
+struct PendulumChainResidual {
+    double mass;
+    Vec<3> principal_moment_of_inertia;
+    Vec<3> gravity;
+    Kokkos::View<SphericalJointElement*, Kokkos::HostSpace> joints;
+
+    template <typename Scalar>
+    void operator()(
+        const ScalarHostView1D<Scalar> gen_coords, const ScalarHostView1D<Scalar> velocity,
+        const ScalarHostView1D<Scalar> acceleration, const ScalarHostView1D<Scalar> lagrange_mults,
+        ScalarHostView1D<Scalar> residual
+    ) const {
+        const auto n_bodies = gen_coords.extent(0) / 7;
+        const auto m = mass;
+        const auto J = principal_moment_of_inertia;
+        const auto g = gravity;
+        const auto chain_joints = joints;
+
+        // Position of the provided end of a joint, and the rotation matrix of its body
+        const auto joint_position = [=](size_t joint, size_t end, Matrix<3, 3, Scalar>& rotation) {
+            const auto body = chain_joints(joint).GetBody(end);
+            const auto s = chain_joints(joint).GetPosition(end);
+            auto position = Vec<3, Scalar>{{Scalar(s(0)), Scalar(s(1)), Scalar(s(2))}};
+            if (body == SphericalJointElement::kGround) {
+                return position;
+            }
+            const auto q0 = gen_coords(7 * body + 3);
+            const auto q1 = gen_coords(7 * body + 4);
+            const auto q2 = gen_coords(7 * body + 5);
+            const auto q3 = gen_coords(7 * body + 6);
+            rotation = Matrix<3, 3, Scalar>{
+                {{q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3, (q1 * q2 - q0 * q3) * 2.,
+                  (q1 * q3 + q0 * q2) * 2.},
+                 {(q1 * q2 + q0 * q3) * 2., q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3,
+                  (q2 * q3 - q0 * q1) * 2.},
+                 {(q1 * q3 - q0 * q2) * 2., (q2 * q3 + q0 * q1) * 2.,
+                  q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3}}};
+            const auto x = Vec<3, Scalar>{
+                {gen_coords(7 * body), gen_coords(7 * body + 1), gen_coords(7 * body + 2)}};
+            return x + rotation * position;
+        };
+
+        // [M] {v'} + {g(q,v,t)} + [B]^T {Lambda}, with the joint loads of every body gathered
+        // from its joints
+        host_parallel_for(
+            "pendulum_chain_bodies", n_bodies,
+            KOKKOS_LAMBDA(const size_t body) {
+                auto omega = Vec<3, Scalar>{};
+                for (size_t i = 0; i < 3; ++i) {
+                    omega(i) = velocity(6 * body + 3 + i);
+                    residual(6 * body + i) = acceleration(6 * body + i) * m + g(i) * m;
+                }
+                const auto J_omega =
+                    Vec<3, Scalar>{{omega(0) * J(0), omega(1) * J(1), omega(2) * J(2)}};
+                const auto gyroscopic = omega.CrossProduct(J_omega);
+                for (size_t i = 0; i < 3; ++i) {
+                    residual(6 * body + 3 + i) =
+                        acceleration(6 * body + 3 + i) * J(i) + gyroscopic(i);
+                }
+                for (size_t joint = 0; joint < chain_joints.extent(0); ++joint) {
+                    for (size_t end = 0; end < 2; ++end) {
+                        if (chain_joints(joint).GetBody(end) != body) {
+                            continue;
+                        }
+                        auto rotation = Matrix<3, 3, Scalar>{};
+                        joint_position(joint, end, rotation);
+                        const auto sign = SphericalJointElement::GetSign(end);
+                        const auto lambda = Vec<3, Scalar>{
+                            {lagrange_mults(3 * joint), lagrange_mults(3 * joint + 1),
+                             lagrange_mults(3 * joint + 2)}};
+                        const auto s = chain_joints(joint).GetPosition(end);
+                        const auto moment =
+                            Vec<3, Scalar>{{Scalar(s(0)), Scalar(s(1)), Scalar(s(2))}}
+                                .CrossProduct(rotation.GetTranspose() * lambda);
+                        for (size_t i = 0; i < 3; ++i) {
+                            residual(6 * body + i) += lambda(i) * sign;
+                            residual(6 * body + 3 + i) += moment(i) * sign;
+                        }
+                    }
+                }
+            }
+        );
+
+        // {Phi} = ({x_a} + [R_a] {s_a}) - ({x_b} + [R_b] {s_b})
+        host_parallel_for(
+            "pendulum_chain_joints", chain_joints.extent(0),
+            KOKKOS_LAMBDA(const size_t joint) {
+                auto rotation = Matrix<3, 3, Scalar>{};
+                const auto constraints =
+                    joint_position(joint, 0, rotation) - joint_position(joint, 1, rotation);
+                for (size_t i = 0; i < 3; ++i) {
+                    residual(6 * n_bodies + 3 * joint + i) = constraints(i);
+                }
+            }
+        );
+    }
+};
+
+// Returns a chain of the provided number of pendulums of length 2 hanging along the y-axis from
+// the origin, with the joints at the ends of the bodies
+std::shared_ptr<MultibodyModel> create_pendulum_chain_model(size_t n_bodies) {
+    auto model = std::make_shared<MultibodyModel>();
+    for (size_t body = 0; body < n_bodies; ++body) {
+        model->AddRigidBody(RigidBodyElement(1., Vec<3>{{0.1, 0.01, 0.1}}));
+        model->AddSphericalJoint(SphericalJointElement(
+            body == 0 ? SphericalJointElement::kGround : body - 1,
+            body == 0 ? Vec<3>{} : Vec<3>{{0., 1., 0.}}, body, Vec<3>{{0., -1., 0.}}
+        ));
+    }
+    return model;
+}
+
+// Returns the residual of the chain of create_pendulum_chain_model()
+PendulumChainResidual create_pendulum_chain_residual(size_t n_bodies) {
+    auto joints = Kokkos::View<SphericalJointElement*, Kokkos::HostSpace>("joints", n_bodies);
+    for (size_t body = 0; body < n_bodies; ++body) {
+        joints(body) = SphericalJointElement(
+            body == 0 ? SphericalJointElement::kGround : body - 1,
+            body == 0 ? Vec<3>{} : Vec<3>{{0., 1., 0.}}, body, Vec<3>{{0., -1., 0.}}
+        );
+    }
+    return PendulumChainResidual{1., Vec<3>{{0.1, 0.01, 0.1}}, Vec<3>{{0., 0., 9.81}}, joints};
+}
+
+// Returns the initial state of the chain, swinging rigidly about the x-axis
+State create_pendulum_chain_initial_state(size_t n_bodies) {
+    auto gen_coords = HostView1D("gen_coords", 7 * n_bodies);
+    auto velocity = HostView1D("velocity", 6 * n_bodies);
+    for (size_t body = 0; body < n_bodies; ++body) {
+        const auto y = 1. + 2. * static_cast<double>(body);
+        gen_coords(7 * body + 1) = y;
+        gen_coords(7 * body + 3) = 1.;
+        velocity(6 * body + 2) = y;
+        velocity(6 * body + 3) = 1.;
+    }
+    return State(
+        gen_coords, velocity, HostView1D("acceleration", 6 * n_bodies),
+        HostView1D("algorithmic_acceleration", 6 * n_bodies)
+    );
+}
+
+// Returns the sparsity pattern of the iteration matrix of the chain
+BlockSparseMatrix create_pendulum_chain_pattern(size_t n_bodies) {
+    const auto state = create_pendulum_chain_initial_state(n_bodies);
+    return create_pendulum_chain_model(n_bodies)->SparseIterationMatrix(
+        0.1, 2., 3., state.GetGeneralizedCoordinates(), state.GetVelocity(), state.GetVelocity(),
+        state.GetAcceleration(), HostView1D("lagrange_mults", 3 * n_bodies)
+    );
+}
+
+TEST(DualTest, ArithmeticAndFunctionsPropagateDerivatives) {
+    const auto x = Dual<2>(2., 0);
+    const auto y = Dual<2>(3., 1);
+
+    // f = x y + sin(x) / y - sqrt(x) + 2 cos(y) - 1 / x
+    const auto f = x * y + sin(x) / y - sqrt(x) + 2. * cos(y) - 1. / x;
+    EXPECT_NEAR(
+        f.GetValue(),
+        6. + std::sin(2.) / 3. - std::sqrt(2.) + 2. * std::cos(3.) - 0.5, 1e-15
+    );
+    EXPECT_NEAR(f.GetDerivative(0), 3. + std::cos(2.) / 3. - 0.5 / std::sqrt(2.) + 0.25, 1e-15);
+    EXPECT_NEAR(f.GetDerivative(1), 2. - std::sin(2.) / 9. - 2. * std::sin(3.), 1e-15);
+
+    EXPECT_TRUE(x < y);
+    EXPECT_FALSE(x >= y);
+    EXPECT_EQ(value_of(-x), -2.);
+    EXPECT_EQ((-x).GetDerivative(0), -1.);
+}
+
+TEST(DualTest, DerivativesOfTheExponentialMapAreFiniteAtZero) {
+    // The derivative of the quaternion of psi = t {1, 2, 3} with respect to t at zero is
+    // {0, 1/2 {1, 2, 3}}, and close to the small angle threshold both branches agree
+    for (const auto t : {0., 0.0377, 0.0378}) {
+        const auto parameter = Dual<1>(t, 0);
+        const auto psi = Vec<3, Dual<1>>{{parameter, parameter * 2., parameter * 3.}};
+        const auto quaternion = calculate_exponential_map_quaternion(psi);
+        const auto expected = quaternion_from_rotation_vector(Vector(t, 2. * t, 3. * t));
+        EXPECT_NEAR(quaternion(0).GetValue(), expected.GetScalarComponent(), 1e-15);
+        EXPECT_NEAR(quaternion(1).GetValue(), expected.GetXComponent(), 1e-15);
+
+        const auto h = 1e-7;
+        const auto perturbed =
+            quaternion_from_rotation_vector(Vector(t + h, 2. * (t + h), 3. * (t + h)));
+        EXPECT_NEAR(
+            quaternion(0).GetDerivative(0),
+            (perturbed.GetScalarComponent() - expected.GetScalarComponent()) / h, 1e-6
+        );
+        EXPECT_NEAR(
+            quaternion(3).GetDerivative(0),
+            (perturbed.GetZComponent() - expected.GetZComponent()) / h, 1e-6
+        );
+    }
+}
+
+TEST(JacobianColoringTest, ColumnsSharingARowHaveDistinctColors) {
+    // A tridiagonal pattern of scalar blocks needs three colors
+    auto nonzero_blocks = std::vector<std::pair<size_t, size_t>>{};
+    for (size_t i = 0; i < 10; ++i) {
+        for (size_t j = (i > 0 ? i - 1 : 0); j < std::min<size_t>(i + 2, 10); ++j) {
+            nonzero_blocks.emplace_back(i, j);
+        }
+    }
+    const auto coloring =
+        JacobianColoring(BlockSparseMatrix(std::vector<size_t>(10, 1), nonzero_blocks));
+    EXPECT_EQ(coloring.GetNumberOfColors(), 3);
+    EXPECT_EQ(coloring.GetNumberOfSweeps(2), 2);
+    EXPECT_EQ(coloring.GetColors(), (std::vector<size_t>{0, 1, 2, 0, 1, 2, 0, 1, 2, 0}));
+
+    // The columns of a block always have distinct colors
+    const auto block_coloring = JacobianColoring(BlockSparseMatrix({2, 3}, {{0, 0}, {1, 1}}));
+    EXPECT_EQ(block_coloring.GetColors(), (std::vector<size_t>{0, 1, 0, 1, 2}));
+}
+
+TEST(JacobianColoringTest, NumberOfColorsOfPendulumChainsIsIndependentOfTheirLength) {
+    const auto n_colors = JacobianColoring(create_pendulum_chain_pattern(4)).GetNumberOfColors();
+    EXPECT_LT(n_colors, 4 * 9);
+    for (const auto n_bodies : {8, 32, 128}) {
+        const auto pattern = create_pendulum_chain_pattern(n_bodies);
+        const auto coloring = JacobianColoring(pattern);
+        EXPECT_EQ(coloring.GetNumberOfColors(), n_colors);
+
+        // No two columns of a block row share a color
+        const auto& colors = coloring.GetColors();
+        const auto& offsets = pattern.GetBlockOffsets();
+        for (size_t block_row = 0; block_row < pattern.GetNumberOfBlockRows(); ++block_row) {
+            auto row_colors = std::vector<size_t>{};
+            for (auto index = pattern.GetRowOffsets()[block_row];
+                 index < pattern.GetRowOffsets()[block_row + 1]; ++index) {
+                const auto block_column = pattern.GetColumnIndices()[index];
+                for (auto j = offsets[block_column]; j < offsets[block_column + 1]; ++j) {
+                    row_colors.push_back(colors[j]);
+                }
+            }
+            std::sort(row_colors.begin(), row_colors.end());
+            EXPECT_EQ(
+                std::adjacent_find(row_colors.begin(), row_colors.end()), row_colors.end()
+            );
+        }
+    }
+}
+
+TEST(JacobianColoringTest, EvaluateJacobianOfTridiagonalFunction) {
+    // f_i = x_{i-1} x_i + sin(x_{i+1})
+    constexpr size_t n = 7;
+    auto nonzero_blocks = std::vector<std::pair<size_t, size_t>>{};
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = (i > 0 ? i - 1 : 0); j < std::min(i + 2, n); ++j) {
+            nonzero_blocks.emplace_back(i, j);
+        }
+    }
+    const auto coloring =
+        JacobianColoring(BlockSparseMatrix(std::vector<size_t>(n, 1), nonzero_blocks));
+    const auto function = [](const ScalarHostView1D<Dual<2>> x, ScalarHostView1D<Dual<2>> f) {
+        for (size_t i = 0; i < n; ++i) {
+            f(i) = (i > 0 ? x(i - 1) : Dual<2>(1.)) * x(i) + (i + 1 < n ? sin(x(i + 1)) : 0.);
+        }
+    };
+    auto x = HostView1D("x", n);
+    for (size_t i = 0; i < n; ++i) {
+        x(i) = 0.5 + static_cast<double>(i);
+    }
+
+    auto jacobian = coloring.CreateJacobian();
+    coloring.Evaluate<2>(function, x, jacobian);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(jacobian(i, i), i > 0 ? x(i - 1) : 1., 1e-15);
+        if (i > 0) {
+            EXPECT_NEAR(jacobian(i, i - 1), x(i), 1e-15);
+        }
+        if (i + 1 < n) {
+            EXPECT_NEAR(jacobian(i, i + 1), std::cos(x(i + 1)), 1e-15);
+        }
+    }
+
+    auto mismatched_jacobian = BlockSparseMatrix(std::vector<size_t>(n, 1), {{0, 0}});
+    EXPECT_THROW(coloring.Evaluate<2>(function, x, mismatched_jacobian), std::invalid_argument);
+}
+
+TEST(AutomaticDifferentiationLinearizationParametersTest, PendulumChainMatchesMultibodyModel) {
+    constexpr size_t n_bodies = 3;
+    auto model = create_pendulum_chain_model(n_bodies);
+    auto linearization_parameters = AutomaticDifferentiationLinearizationParameters(
+        create_pendulum_chain_residual(n_bodies), create_pendulum_chain_pattern(n_bodies)
+    );
+    const auto state = create_pendulum_chain_initial_state(n_bodies);
+    auto gen_coords = HostView1D("gen_coords", 7 * n_bodies);
+    auto delta_gen_coords = HostView1D("delta_gen_coords", 6 * n_bodies);
+    auto acceleration = HostView1D("acceleration", 6 * n_bodies);
+    auto lagrange_mults = HostView1D("lagrange_mults", 3 * n_bodies);
+    for (size_t i = 0; i < 6 * n_bodies; ++i) {
+        delta_gen_coords(i) = 1. + static_cast<double>(i % 5);
+        acceleration(i) = 0.5 * static_cast<double>(i % 3);
+    }
+    for (size_t i = 0; i < 3 * n_bodies; ++i) {
+        lagrange_mults(i) = 1. + static_cast<double>(i);
+    }
+
+    // An iterate with rotated bodies, i.e. updated from the initial state with the increments
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.1, 1));
+    time_integrator.UpdateGeneralizedCoordinates(
+        state.GetGeneralizedCoordinates(), delta_gen_coords, gen_coords
+    );
+
+    const auto residuals = linearization_parameters.ResidualVector(
+        gen_coords, state.GetVelocity(), acceleration, lagrange_mults
+    );
+    const auto expected_residuals =
+        model->ResidualVector(gen_coords, state.GetVelocity(), acceleration, lagrange_mults);
+    const auto iteration_matrix = linearization_parameters.SparseIterationMatrix(
+        0.1, 2., 3., gen_coords, delta_gen_coords, state.GetVelocity(), acceleration,
+        lagrange_mults
+    );
+    const auto expected_iteration_matrix = model->IterationMatrix(
+        0.1, 2., 3., gen_coords, delta_gen_coords, state.GetVelocity(), acceleration,
+        lagrange_mults
+    );
+
+    constexpr auto size = 9 * n_bodies;
+    EXPECT_EQ(
+        iteration_matrix.GetNumberOfNonZeroBlocks(),
+        create_pendulum_chain_pattern(n_bodies).GetNumberOfNonZeroBlocks()
+    );
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(residuals(i), expected_residuals(i), 1e-12);
+        for (size_t j = 0; j < size; ++j) {
+            EXPECT_NEAR(iteration_matrix(i, j), expected_iteration_matrix(i, j), 1e-12);
+        }
+    }
+}
+
+TEST(AutomaticDifferentiationLinearizationParametersTest, IntegratePendulumChain) {
+    constexpr size_t n_bodies = 3;
+    auto integrate = [](std::shared_ptr<LinearizationParameters> linearization_parameters) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.005, 20, 20), true
+        );
+        auto results = time_integrator.Integrate(
+            create_pendulum_chain_initial_state(n_bodies), 3 * n_bodies, linearization_parameters
+        );
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return results.back();
+    };
+
+    const auto state =
+        integrate(std::make_shared<AutomaticDifferentiationLinearizationParameters<
+                      PendulumChainResidual>>(
+            create_pendulum_chain_residual(n_bodies), create_pendulum_chain_pattern(n_bodies)
+        ));
+    const auto expected = integrate(create_pendulum_chain_model(n_bodies));
+
+    for (size_t i = 0; i < 7 * n_bodies; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-10
+        );
+    }
+    for (size_t i = 0; i < 6 * n_bodies; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-8);
+    }
+}
+
+TEST(AutomaticDifferentiationLinearizationParametersTest, ExpectThrowIfSizesDoNotMatchPattern) {
+    auto linearization_parameters = AutomaticDifferentiationLinearizationParameters(
+        create_pendulum_chain_residual(2), create_pendulum_chain_pattern(2)
+    );
+    const auto state = create_pendulum_chain_initial_state(3);
+
+    EXPECT_THROW(
+        linearization_parameters.IterationMatrix(
+            0.1, 2., 3., state.GetGeneralizedCoordinates(), state.GetVelocity(),
+            state.GetVelocity(), state.GetAcceleration(), HostView1D("lagrange_mults", 6)
+        ),
+        std::invalid_argument
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
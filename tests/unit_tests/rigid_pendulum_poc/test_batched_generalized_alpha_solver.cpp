@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/batched_generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+using BatchedTimeIntegrator = BatchedGeneralizedAlphaTimeIntegrator<>;
+
+TEST(BatchedTimeIntegratorTest, UpdateGeneralizedCoordinatesMatchesTimeIntegrator) {
+    auto gen_coords = Vec<7>{{1., 2., 3., 1., 0., 0., 0.}};
+    auto delta_gen_coords = Vec<6>{{0.5, -1., 2., 0.1, 0.2, 0.3}};
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.5));
+
+    auto expected = time_integrator.UpdateGeneralizedCoordinates(
+        to_host_view(gen_coords), to_host_view(delta_gen_coords)
+    );
+    auto gen_coords_next = BatchedTimeIntegrator::UpdateGeneralizedCoordinates(
+        gen_coords, delta_gen_coords, 0.5
+    );
+
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(gen_coords_next(i), expected(i), 1e-15);
+    }
+}
+
+TEST(BatchedTimeIntegratorTest, ExpectThrowIfNumberOfBodiesDoesNotMatchStates) {
+    auto time_integrator = BatchedTimeIntegrator();
+    auto states = BatchedTimeIntegrator::BatchedStateType(3);
+    auto bodies = BatchedTimeIntegrator::BodiesView("bodies", 2);
+
+    EXPECT_THROW(time_integrator.AlphaStep(states, bodies), std::invalid_argument);
+}
+
+TEST(BatchedTimeIntegratorTest, ExpectThrowIfStatesAreNotOfHeavyTopSize) {
+    auto time_integrator = BatchedTimeIntegrator();
+    auto states = BatchedTimeIntegrator::BatchedStateType(2, 4, 3, 0);
+    auto bodies = BatchedTimeIntegrator::BodiesView("bodies", 2);
+
+    EXPECT_THROW(time_integrator.AlphaStep(states, bodies), std::invalid_argument);
+}
+
+TEST(BatchedTimeIntegratorTest, EnsembleOfHeavyTopsMatchesSingleBodySolution) {
+    // Generalized alpha parameters and time stepping of Brüls and Cardona (2010)
+    auto rho_inf = 0.6;
+    auto alpha_m = (2. * rho_inf - 1.) / (rho_inf + 1.);
+    auto alpha_f = rho_inf / (rho_inf + 1.);
+    auto gamma = 0.5 + alpha_f - alpha_m;
+    auto beta = 0.25 * std::pow(gamma + 0.5, 2);
+    auto time_stepper = TimeStepper(0., 0.002, 10, 10);
+
+    // The second body is a heavier top, so its trajectory differs from the others
+    const size_t n_bodies = 4;
+    auto bodies = BatchedTimeIntegrator::BodiesView("bodies", n_bodies);
+    auto bodies_host = Kokkos::create_mirror_view(bodies);
+    auto states = BatchedTimeIntegrator::BatchedStateType(n_bodies);
+    for (size_t i = 0; i < n_bodies; ++i) {
+        bodies_host(i) = HeavyTop();
+        states.SetState(i, create_heavy_top_initial_state());
+    }
+    bodies_host(1) = HeavyTop(30.);
+    Kokkos::deep_copy(bodies, bodies_host);
+
+    auto batched_time_integrator =
+        BatchedTimeIntegrator(alpha_f, alpha_m, beta, gamma, time_stepper, true);
+    batched_time_integrator.Integrate(states, bodies);
+
+    EXPECT_EQ(batched_time_integrator.GetNumberOfConvergedBodies(), n_bodies);
+
+    // Same expected values as the single body heavy top problem (from a pilot fortran code)
+    for (size_t body : {0, 2, 3}) {
+        auto final_state = states.GetState(body);
+        expect_kokkos_view_1D_equal(
+            final_state.GetGeneralizedCoordinates(),
+            {0.091943, 0.995745, -0.006167, 0.070604, 0.045687, 0.996438, -0.006332}
+        );
+        expect_kokkos_view_1D_equal(
+            final_state.GetVelocity(), {4.564702, -0.425498, -0.620310, 1.287734, 150., 4.522188}
+        );
+        expect_kokkos_view_1D_equal(
+            final_state.GetAcceleration(),
+            {-6.272347, -24.111949, -29.783310, -560.293932, 0., 244.069741}
+        );
+        expect_kokkos_view_1D_equal(
+            final_state.GetAlgorithmicAcceleration(),
+            {-4.850215, -21.808817, -30.587676, -616.404070, 0., 241.543883}
+        );
+    }
+
+    // The heavier top matches the single body integrator with the same properties
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(alpha_f, alpha_m, beta, gamma, time_stepper, true);
+    auto results = time_integrator.Integrate(
+        create_heavy_top_initial_state(), 3,
+        std::make_shared<HeavyTopLinearizationParameters>(HeavyTop(30.))
+    );
+    auto expected_state = results.back();
+    auto heavier_state = states.GetState(1);
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            heavier_state.GetGeneralizedCoordinates()(i),
+            expected_state.GetGeneralizedCoordinates()(i), 1e-10
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(heavier_state.GetVelocity()(i), expected_state.GetVelocity()(i), 1e-8);
+        EXPECT_NEAR(heavier_state.GetAcceleration()(i), expected_state.GetAcceleration()(i), 1e-6);
+    }
+}
+
+TEST(BatchedTimeIntegratorTest, ConvergedBodiesAreMaskedOutOfFurtherIterations) {
+    auto time_stepper = TimeStepper(0., 0.002, 1, 10);
+
+    // The first body is at rest in its equilibrium without gravity, i.e. converges immediately,
+    // while the second one needs several Newton-Raphson iterations
+    auto states = BatchedTimeIntegrator::BatchedStateType(2);
+    states.SetState(1, create_heavy_top_initial_state());
+    auto at_rest = State(
+        create_vector({0., 1., 0., 1., 0., 0., 0.}), create_vector({0., 0., 0., 0., 0., 0.}),
+        create_vector({0., 0., 0., 0., 0., 0.}), create_vector({0., 0., 0., 0., 0., 0.})
+    );
+    states.SetState(0, at_rest);
+    auto bodies = BatchedTimeIntegrator::BodiesView("bodies", 2);
+    auto bodies_host = Kokkos::create_mirror_view(bodies);
+    bodies_host(0) = HeavyTop(15., {{0.234375, 0.46875, 0.234375}}, {{0., 1., 0.}}, {});
+    bodies_host(1) = HeavyTop();
+    Kokkos::deep_copy(bodies, bodies_host);
+
+    auto time_integrator = BatchedTimeIntegrator(0.5, 0.5, 0.25, 0.5, time_stepper, true);
+    time_integrator.AlphaStep(states, bodies);
+
+    auto n_iterations = Kokkos::create_mirror_view(time_integrator.GetNumberOfIterations());
+    Kokkos::deep_copy(n_iterations, time_integrator.GetNumberOfIterations());
+    EXPECT_EQ(n_iterations(0), 0);
+    EXPECT_GT(n_iterations(1), 1);
+    EXPECT_EQ(time_integrator.GetTimeStepper().GetNumberOfIterations(), n_iterations(1));
+    EXPECT_EQ(time_integrator.GetNumberOfConvergedBodies(), 2);
+}
+
+TEST(BatchedTimeIntegratorTest, DiagnosticsMatchSingleBodyDiagnostics) {
+    auto policy = DiagnosticsPolicy{};
+    policy.is_enabled = true;
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 10, 10), true);
+    time_integrator.SetDiagnosticsPolicy(policy);
+    auto problem = HeavyTopLinearizationParameters();
+    time_integrator.Integrate(create_heavy_top_initial_state(), 3, problem);
+    const auto expected = time_integrator.GetDiagnostics()(0);
+
+    const size_t n_bodies = 3;
+    auto bodies = BatchedTimeIntegrator::BodiesView("bodies", n_bodies);
+    Kokkos::deep_copy(bodies, HeavyTop());
+    auto states = BatchedTimeIntegrator::BatchedStateType(n_bodies);
+    for (size_t i = 0; i < n_bodies; ++i) {
+        states.SetState(i, create_heavy_top_initial_state());
+    }
+    auto batched_time_integrator =
+        BatchedTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 10, 10), true);
+    batched_time_integrator.SetDiagnosticsPolicy(policy);
+    batched_time_integrator.Integrate(states, bodies);
+
+    auto diagnostics = Kokkos::create_mirror_view(batched_time_integrator.GetDiagnostics());
+    Kokkos::deep_copy(diagnostics, batched_time_integrator.GetDiagnostics());
+    ASSERT_EQ(diagnostics.extent(0), n_bodies);
+    for (size_t body = 0; body < n_bodies; ++body) {
+        const auto& energy = diagnostics(body).total_energy;
+        EXPECT_EQ(energy.GetCount(), 11);
+        EXPECT_NEAR(energy.GetLast(), expected.total_energy.GetLast(), 1e-6);
+        EXPECT_NEAR(energy.GetMin(), expected.total_energy.GetMin(), 1e-6);
+        EXPECT_NEAR(energy.GetMax(), expected.total_energy.GetMax(), 1e-6);
+        EXPECT_NEAR(
+            diagnostics(body).angular_momentum.GetMean(), expected.angular_momentum.GetMean(),
+            1e-6
+        );
+        EXPECT_LT(diagnostics(body).constraint_violation.GetMax(), 1e-10);
+    }
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/batched_solver.h"
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "src/rigid_pendulum_poc/solver.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+// Returns a nonsymmetric system that requires pivoting, i.e. with small diagonal entries
+HostView2D create_pivoting_system(size_t size, size_t seed = 0) {
+    auto system = HostView2D("system", size, size);
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            system(i, j) = (i == j) ? 1e-3 * static_cast<double>(seed + 1)
+                                    : 1. / (1. + static_cast<double>(seed + i + 2 * j));
+        }
+    }
+    return system;
+}
+
+// Returns the solution of the provided system with LAPACKE as the reference
+HostView1D solve_with_lapacke(const HostView2D system, const HostView1D right_hand_side) {
+    auto system_copy = HostView2D("system", system.extent(0), system.extent(1));
+    auto solution = HostView1D("solution", right_hand_side.extent(0));
+    Kokkos::deep_copy(system_copy, system);
+    Kokkos::deep_copy(solution, right_hand_side);
+    solve_linear_system(system_copy, solution);
+    return solution;
+}
+
+HostView1D create_right_hand_side(size_t size) {
+    auto right_hand_side = HostView1D("right_hand_side", size);
+    for (size_t i = 0; i < size; ++i) {
+        right_hand_side(i) = 1. + static_cast<double>(i);
+    }
+    return right_hand_side;
+}
+
+TEST(BatchedSolverTest, SerialLUOfFixedSizeMatrixMatchesLAPACKE) {
+    constexpr size_t kSize = 9;
+    const auto system = create_pivoting_system(kSize);
+    const auto right_hand_side = create_right_hand_side(kSize);
+    const auto expected = solve_with_lapacke(system, right_hand_side);
+
+    auto matrix = Matrix<kSize, kSize>{};
+    auto solution = Vec<kSize>{};
+    for (size_t i = 0; i < kSize; ++i) {
+        solution(i) = right_hand_side(i);
+        for (size_t j = 0; j < kSize; ++j) {
+            matrix(i, j) = system(i, j);
+        }
+    }
+    auto pivots = Vec<kSize, int>{};
+
+    EXPECT_EQ(serial_lu_factorize<kSize>(matrix, pivots), 0);
+    serial_lu_solve<kSize>(matrix, pivots, solution);
+
+    for (size_t i = 0; i < kSize; ++i) {
+        EXPECT_NEAR(solution(i), expected(i), 1e-10 * Kokkos::fabs(expected(i)));
+    }
+}
+
+TEST(BatchedSolverTest, SerialLUOfDynamicSizeViewsPivotsLikeLAPACKE) {
+    const size_t size = 4;
+    auto system = create_pivoting_system(size);
+    auto factors = HostView2D("factors", size, size);
+    auto lapacke_pivots = HostIntView1D("lapacke_pivots", size);
+    Kokkos::deep_copy(factors, system);
+    auto discarded = create_right_hand_side(size);
+    solve_linear_system(factors, discarded, lapacke_pivots);
+
+    auto pivots = HostIntView1D("pivots", size);
+    EXPECT_EQ(serial_lu_factorize<kDynamicSize>(system, pivots), 0);
+
+    for (size_t i = 0; i < size; ++i) {
+        // LAPACK's pivots are one-based
+        EXPECT_EQ(pivots(i), lapacke_pivots(i) - 1);
+        for (size_t j = 0; j < size; ++j) {
+            EXPECT_NEAR(system(i, j), factors(i, j), 1e-12);
+        }
+    }
+}
+
+TEST(BatchedSolverTest, SerialLUReturnsFirstZeroPivotOfSingularSystem) {
+    auto system = Matrix<3, 3>({{1., 2., 3.}, {2., 4., 6.}, {0., 0., 1.}});
+    auto pivots = Vec<3, int>{};
+
+    EXPECT_EQ(serial_lu_factorize<3>(system, pivots), 2);
+}
+
+TEST(BatchedSolverTest, TeamLUInsideTeamKernelMatchesLAPACKE) {
+    using TeamPolicy = Kokkos::TeamPolicy<Kokkos::DefaultHostExecutionSpace>;
+    using ScratchSpace = Kokkos::DefaultHostExecutionSpace::scratch_memory_space;
+    using ScratchView1D = Kokkos::View<double*, ScratchSpace, Kokkos::MemoryUnmanaged>;
+    using ScratchView2D = Kokkos::View<double**, ScratchSpace, Kokkos::MemoryUnmanaged>;
+    using ScratchIntView1D = Kokkos::View<int*, ScratchSpace, Kokkos::MemoryUnmanaged>;
+    constexpr size_t kSize = 9;
+    const size_t n_systems = 3;
+    auto systems = HostView3D("systems", n_systems, kSize, kSize);
+    auto solutions = HostView2D("solutions", n_systems, kSize);
+    for (size_t s = 0; s < n_systems; ++s) {
+        const auto system = create_pivoting_system(kSize, s);
+        for (size_t i = 0; i < kSize; ++i) {
+            solutions(s, i) = 1. + static_cast<double>(i);
+            for (size_t j = 0; j < kSize; ++j) {
+                systems(s, i, j) = system(i, j);
+            }
+        }
+    }
+    auto info = HostIntView1D("info", n_systems);
+
+    const auto scratch_size = ScratchView2D::shmem_size(kSize, kSize) +
+                              ScratchView1D::shmem_size(kSize) +
+                              ScratchIntView1D::shmem_size(kSize);
+    auto policy = TeamPolicy(static_cast<int>(n_systems), Kokkos::AUTO)
+                      .set_scratch_size(0, Kokkos::PerTeam(scratch_size));
+    Kokkos::parallel_for(
+        "team_lu", policy,
+        KOKKOS_LAMBDA(const typename TeamPolicy::member_type& member) {
+            const size_t s = member.league_rank();
+            auto system = ScratchView2D(member.team_scratch(0), kSize, kSize);
+            auto solution = ScratchView1D(member.team_scratch(0), kSize);
+            auto pivots = ScratchIntView1D(member.team_scratch(0), kSize);
+            Kokkos::single(Kokkos::PerTeam(member), [&]() {
+                for (size_t i = 0; i < kSize; ++i) {
+                    solution(i) = solutions(s, i);
+                    for (size_t j = 0; j < kSize; ++j) {
+                        system(i, j) = systems(s, i, j);
+                    }
+                }
+            });
+            member.team_barrier();
+
+            const auto result = team_lu_factorize<kSize>(member, system, pivots);
+            team_lu_solve<kSize>(member, system, pivots, solution);
+            Kokkos::single(Kokkos::PerTeam(member), [&]() {
+                info(s) = result;
+                for (size_t i = 0; i < kSize; ++i) {
+                    solutions(s, i) = solution(i);
+                }
+            });
+        }
+    );
+
+    for (size_t s = 0; s < n_systems; ++s) {
+        const auto expected =
+            solve_with_lapacke(create_pivoting_system(kSize, s), create_right_hand_side(kSize));
+        EXPECT_EQ(info(s), 0);
+        for (size_t i = 0; i < kSize; ++i) {
+            EXPECT_NEAR(solutions(s, i), expected(i), 1e-10 * Kokkos::fabs(expected(i)));
+        }
+    }
+}
+
+TEST(BatchedSolverTest, SolveBatchedSystemsOfSpecializedAndDynamicSizesMatchesLAPACKE) {
+    const size_t n_systems = 5;
+    for (size_t size : {2, 6, 9, 12, 15}) {
+        auto systems = HostView3D("systems", n_systems, size, size);
+        auto solutions = HostView2D("solutions", n_systems, size);
+        for (size_t s = 0; s < n_systems; ++s) {
+            const auto system = create_pivoting_system(size, s);
+            for (size_t i = 0; i < size; ++i) {
+                solutions(s, i) = 1. + static_cast<double>(i);
+                for (size_t j = 0; j < size; ++j) {
+                    systems(s, i, j) = system(i, j);
+                }
+            }
+        }
+
+        solve_batched_linear_systems<Kokkos::DefaultHostExecutionSpace>(systems, solutions);
+
+        for (size_t s = 0; s < n_systems; ++s) {
+            const auto expected =
+                solve_with_lapacke(create_pivoting_system(size, s), create_right_hand_side(size));
+            for (size_t i = 0; i < size; ++i) {
+                EXPECT_NEAR(solutions(s, i), expected(i), 1e-10 * Kokkos::fabs(expected(i)));
+            }
+        }
+    }
+}
+
+TEST(BatchedSolverTest, ExpectThrowIfBatchedSystemsAreSingularOrSizesDoNotMatch) {
+    auto systems = HostView3D("systems", 3, 6, 6);
+    auto solutions = HostView2D("solutions", 3, 6);
+    for (size_t s = 0; s < 3; ++s) {
+        for (size_t i = 0; i < 6; ++i) {
+            // The second system is left singular
+            systems(s, i, i) = (s == 1 && i == 4) ? 0. : 1.;
+        }
+    }
+
+    EXPECT_THROW(
+        solve_batched_linear_systems<Kokkos::DefaultHostExecutionSpace>(systems, solutions),
+        std::runtime_error
+    );
+    EXPECT_THROW(
+        solve_batched_linear_systems<Kokkos::DefaultHostExecutionSpace>(
+            HostView3D("systems", 3, 6, 5), solutions
+        ),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        solve_batched_linear_systems<Kokkos::DefaultHostExecutionSpace>(
+            systems, HostView2D("solutions", 2, 6)
+        ),
+        std::invalid_argument
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
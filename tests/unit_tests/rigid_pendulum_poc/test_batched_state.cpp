@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/batched_state.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(BatchedStateTest, CreateBatchedStateWithStructOfArraysLayout) {
+    auto states = BatchedState<>(5);
+
+    EXPECT_EQ(states.GetNumberOfBodies(), 5);
+    EXPECT_EQ(states.GetGeneralizedCoordinates().extent(0), 7);
+    EXPECT_EQ(states.GetGeneralizedCoordinates().extent(1), 5);
+    EXPECT_EQ(states.GetVelocity().extent(0), 6);
+    EXPECT_EQ(states.GetAcceleration().extent(0), 6);
+    EXPECT_EQ(states.GetAlgorithmicAcceleration().extent(0), 6);
+    EXPECT_EQ(states.GetLagrangeMultipliers().extent(0), 3);
+    EXPECT_EQ(states.GetLagrangeMultipliers().extent(1), 5);
+}
+
+TEST(BatchedStateTest, SetAndGetStateOfOneBody) {
+    auto states = BatchedState<>(3, 4, 3, 0);
+    auto q = create_vector({1., 2., 3., 4.});
+    auto v = create_vector({5., 6., 7.});
+    auto a = create_vector({8., 9., 10.});
+
+    states.SetState(1, State(q, v, a, v));
+
+    auto state = states.GetState(1);
+    expect_kokkos_view_1D_equal(state.GetGeneralizedCoordinates(), {1., 2., 3., 4.});
+    expect_kokkos_view_1D_equal(state.GetVelocity(), {5., 6., 7.});
+    expect_kokkos_view_1D_equal(state.GetAcceleration(), {8., 9., 10.});
+    expect_kokkos_view_1D_equal(state.GetAlgorithmicAcceleration(), {5., 6., 7.});
+
+    // Other bodies are not affected
+    expect_kokkos_view_1D_equal(states.GetState(0).GetGeneralizedCoordinates(), {0., 0., 0., 0.});
+}
+
+TEST(BatchedStateTest, StatesAreStoredAsStructOfArraysOnTheHost) {
+    auto states = BatchedState<Kokkos::HostSpace>(2, 4, 3, 0);
+    auto q = create_vector({1., 2., 3., 4.});
+    auto v = create_vector({5., 6., 7.});
+
+    states.SetState(1, State(q, v, v, v));
+
+    auto gen_coords = states.GetGeneralizedCoordinates();
+    EXPECT_EQ(gen_coords(2, 1), 3.);
+    EXPECT_EQ(&gen_coords(0, 1) + 1, &gen_coords(1, 0));
+}
+
+TEST(BatchedStateTest, ExpectThrowIfStateDoesNotMatchBatch) {
+    auto states = BatchedState<>(2);
+    auto q = create_vector({1., 2., 3., 4.});
+    auto v = create_vector({5., 6., 7.});
+
+    EXPECT_THROW(states.SetState(0, State(q, v, v, v)), std::invalid_argument);
+    EXPECT_THROW(states.SetState(2, State()), std::out_of_range);
+    EXPECT_THROW(states.GetState(2), std::out_of_range);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
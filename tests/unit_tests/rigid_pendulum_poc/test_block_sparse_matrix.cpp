@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/block_sparse_matrix.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(BlockSparseMatrixTest, ConstructZeroMatrixWithProvidedPattern) {
+    auto matrix = BlockSparseMatrix({2, 3, 1}, {{2, 0}, {0, 0}, {1, 1}, {0, 2}, {0, 0}});
+
+    EXPECT_EQ(matrix.GetNumberOfRows(), 6);
+    EXPECT_EQ(matrix.GetNumberOfBlockRows(), 3);
+    EXPECT_EQ(matrix.GetNumberOfNonZeroBlocks(), 4);
+    EXPECT_EQ(matrix.GetNumberOfNonZeros(), 4 + 9 + 2 + 2);
+    EXPECT_EQ(matrix.GetBlockOffsets(), (std::vector<size_t>{0, 2, 5, 6}));
+    EXPECT_EQ(matrix.GetRowOffsets(), (std::vector<size_t>{0, 2, 3, 4}));
+    EXPECT_EQ(matrix.GetColumnIndices(), (std::vector<size_t>{0, 2, 1, 0}));
+
+    EXPECT_TRUE(matrix.HasBlock(0, 2));
+    EXPECT_FALSE(matrix.HasBlock(2, 2));
+    expect_kokkos_view_2D_equal(
+        matrix.ToDense(), std::vector<std::vector<double>>(6, std::vector<double>(6, 0.))
+    );
+}
+
+TEST(BlockSparseMatrixTest, WritesToBlocksModifyTheMatrix) {
+    auto matrix = BlockSparseMatrix({2, 1}, {{0, 0}, {1, 0}});
+
+    auto block = matrix.GetBlock(0, 0);
+    block(0, 1) = 2.;
+    block(1, 0) = 3.;
+    auto coupling_block = matrix.GetBlock(1, 0);
+    EXPECT_EQ(coupling_block.extent(0), 1);
+    EXPECT_EQ(coupling_block.extent(1), 2);
+    coupling_block(0, 1) = 4.;
+
+    EXPECT_EQ(matrix(0, 1), 2.);
+    EXPECT_EQ(matrix(1, 0), 3.);
+    EXPECT_EQ(matrix(2, 1), 4.);
+    EXPECT_EQ(matrix(1, 2), 0.);
+    expect_kokkos_view_2D_equal(matrix.ToDense(), {{0., 2., 0.}, {3., 0., 0.}, {0., 4., 0.}});
+
+    matrix.SetZero();
+    EXPECT_EQ(matrix(0, 1), 0.);
+    EXPECT_EQ(matrix.GetNumberOfNonZeroBlocks(), 2);
+}
+
+TEST(BlockSparseMatrixTest, CreateFromDenseAndMultiplyWithVector) {
+    auto dense = create_matrix({
+        {1., 2., 0., 0.},  // row 1
+        {3., 4., 0., 0.},  // row 2
+        {0., 0., 0., 5.},  // row 3
+        {6., 0., 0., 0.}   // row 4
+    });
+
+    auto matrix = BlockSparseMatrix::FromDense(dense, {2, 1, 1});
+
+    EXPECT_EQ(matrix.GetNumberOfNonZeroBlocks(), 3);
+    EXPECT_TRUE(matrix.HasBlock(0, 0));
+    EXPECT_TRUE(matrix.HasBlock(1, 2));
+    EXPECT_TRUE(matrix.HasBlock(2, 0));
+    expect_kokkos_view_2D_equal(
+        matrix.ToDense(), {{1., 2., 0., 0.}, {3., 4., 0., 0.}, {0., 0., 0., 5.}, {6., 0., 0., 0.}}
+    );
+    expect_kokkos_view_1D_equal(
+        matrix.Multiply(create_vector({1., 2., 3., 4.})), {5., 11., 20., 6.}
+    );
+}
+
+TEST(BlockSparseMatrixTest, ReverseCuthillMcKeeOrderingReducesBandwidthOfChain) {
+    // A chain of blocks 0 - 5 - 1 - 4 - 2 - 3, i.e. with a large bandwidth as numbered
+    const auto chain = std::vector<size_t>{0, 5, 1, 4, 2, 3};
+    auto nonzero_blocks = std::vector<std::pair<size_t, size_t>>{};
+    for (size_t i = 0; i < chain.size(); ++i) {
+        nonzero_blocks.emplace_back(chain[i], chain[i]);
+        if (i + 1 < chain.size()) {
+            nonzero_blocks.emplace_back(chain[i], chain[i + 1]);
+        }
+    }
+    auto matrix = BlockSparseMatrix(std::vector<size_t>(6, 6), nonzero_blocks);
+
+    auto ordering = matrix.ReverseCuthillMcKeeOrdering();
+
+    ASSERT_EQ(ordering.size(), 6);
+    auto position = std::vector<size_t>(6);
+    for (size_t i = 0; i < ordering.size(); ++i) {
+        position[ordering[i]] = i;
+    }
+    for (const auto& [block_row, block_column] : nonzero_blocks) {
+        const auto distance = position[block_row] > position[block_column]
+                                  ? position[block_row] - position[block_column]
+                                  : position[block_column] - position[block_row];
+        EXPECT_LE(distance, 1);
+    }
+}
+
+TEST(BlockSparseMatrixTest, CreateMultibodyBlockSizes) {
+    EXPECT_EQ(create_multibody_block_sizes(6, 3), (std::vector<size_t>{6, 3}));
+    EXPECT_EQ(create_multibody_block_sizes(12, 0), (std::vector<size_t>{6, 6}));
+    EXPECT_EQ(create_multibody_block_sizes(8, 5), (std::vector<size_t>{6, 2, 5}));
+}
+
+TEST(BlockSparseMatrixTest, ExpectThrowIfBlockIsNotPartOfPatternOrOutOfRange) {
+    EXPECT_THROW(BlockSparseMatrix({2, 2}, {{0, 2}}), std::out_of_range);
+
+    auto matrix = BlockSparseMatrix({2, 2}, {{0, 0}});
+
+    EXPECT_THROW(matrix.GetBlock(1, 1), std::invalid_argument);
+    EXPECT_THROW(matrix(4, 0), std::out_of_range);
+    EXPECT_THROW(matrix.Multiply(create_vector({1., 2.})), std::invalid_argument);
+    EXPECT_THROW(
+        BlockSparseMatrix::FromDense(create_identity_matrix(3), {2, 2}), std::invalid_argument
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,203 @@
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/batched_generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/checkpoint.h"
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+void expect_states_identical(const State& state, const State& expected) {
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_EQ(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i)
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(state.GetVelocity()(i), expected.GetVelocity()(i));
+        EXPECT_EQ(state.GetAcceleration()(i), expected.GetAcceleration()(i));
+        EXPECT_EQ(state.GetAlgorithmicAcceleration()(i), expected.GetAlgorithmicAcceleration()(i));
+    }
+}
+
+GeneralizedAlphaTimeIntegrator create_heavy_top_integrator(const TimeStepper& time_stepper) {
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.375, 0.125, 0.390625, 0.75, time_stepper, true);
+    // Reuse the factorization across time steps, i.e. the restart must restore it
+    time_integrator.SetJacobianUpdatePolicy({JacobianUpdateStrategy::kEVERY_K_STEPS, 3});
+    return time_integrator;
+}
+
+TEST(CheckpointTest, WriteAndReadCheckpoint) {
+    const auto file_name = std::string("checkpoint_roundtrip.bin");
+    auto checkpoint = Checkpoint{
+        12,
+        0.024,
+        0.002,
+        3,
+        47,
+        create_heavy_top_initial_state(),
+        create_vector({1., -2., 3.}),
+        2,
+        create_matrix({{1., 2.}, {3., 4.}}),
+        HostIntView1D("pivots", 2)};
+    checkpoint.pivots(0) = 2;
+    checkpoint.pivots(1) = 2;
+
+    write_checkpoint(file_name, checkpoint);
+    auto restored = read_checkpoint(file_name);
+
+    EXPECT_EQ(restored.step, 12);
+    EXPECT_EQ(restored.current_time, 0.024);
+    EXPECT_EQ(restored.time_step, 0.002);
+    EXPECT_EQ(restored.n_iterations, 3);
+    EXPECT_EQ(restored.total_n_iterations, 47);
+    expect_states_identical(restored.state, checkpoint.state);
+    expect_kokkos_view_1D_equal(restored.lagrange_mults, {1., -2., 3.});
+    EXPECT_EQ(restored.n_steps_since_jacobian_update, 2);
+    expect_kokkos_view_2D_equal(restored.factors, {{1., 2.}, {3., 4.}});
+    ASSERT_EQ(restored.pivots.extent(0), 2);
+    EXPECT_EQ(restored.pivots(0), 2);
+    EXPECT_EQ(restored.pivots(1), 2);
+    std::remove(file_name.c_str());
+}
+
+TEST(CheckpointTest, RestartReproducesUninterruptedTimeIntegration) {
+    const auto file_name = std::string("checkpoint_heavy_top.bin");
+    const auto time_stepper = TimeStepper(0., 0.002, 20, 50);
+    auto heavy_top = std::make_shared<HeavyTopLinearizationParameters>();
+
+    auto time_integrator = create_heavy_top_integrator(time_stepper);
+    time_integrator.SetCheckpointPolicy({file_name, 7});
+    auto states = time_integrator.Integrate(create_heavy_top_initial_state(), 3, heavy_top);
+
+    // The latest checkpoint is of step 14, written after the one of step 7 was replaced
+    auto checkpoint = read_checkpoint(file_name);
+    EXPECT_EQ(checkpoint.step, 14);
+    EXPECT_GT(checkpoint.factors.extent(0), 0);
+    expect_states_identical(checkpoint.state, states[14]);
+
+    auto restarted_integrator = create_heavy_top_integrator(time_stepper);
+    auto history = StateHistoryObserver();
+    restarted_integrator.Restart(checkpoint, 3, heavy_top, history);
+
+    ASSERT_EQ(history.GetStates().size(), 6);
+    for (size_t i = 0; i < history.GetStates().size(); ++i) {
+        expect_states_identical(history.GetStates()[i], states[15 + i]);
+    }
+    EXPECT_EQ(
+        restarted_integrator.GetTimeStepper().GetCurrentTime(),
+        time_integrator.GetTimeStepper().GetCurrentTime()
+    );
+    EXPECT_EQ(
+        restarted_integrator.GetTimeStepper().GetTotalNumberOfIterations(),
+        time_integrator.GetTimeStepper().GetTotalNumberOfIterations()
+    );
+    std::remove(file_name.c_str());
+}
+
+TEST(CheckpointTest, RestartAdaptiveTimeIntegrationPastTheNominalNumberOfSteps) {
+    const auto file_name = std::string("checkpoint_adaptive.bin");
+    const auto time_stepper = TimeStepper(0., 0.01, 4, 50);
+    auto heavy_top = std::make_shared<HeavyTopLinearizationParameters>();
+    auto policy = AdaptiveTimeStepPolicy{};
+    policy.is_adaptive = true;
+    policy.absolute_tolerance = 1e-6;
+    policy.relative_tolerance = 1e-4;
+
+    auto time_integrator = create_heavy_top_integrator(time_stepper);
+    time_integrator.SetAdaptiveTimeStepPolicy(policy);
+    time_integrator.SetCheckpointPolicy({file_name, 5});
+    auto states = StateHistoryObserver();
+    time_integrator.Integrate(create_heavy_top_initial_state(), 3, heavy_top, states);
+
+    // The time step shrank, i.e. the checkpoint is of a step beyond the nominal 4 steps
+    auto checkpoint = read_checkpoint(file_name);
+    ASSERT_GT(checkpoint.step, time_stepper.GetNumberOfSteps());
+    ASSERT_GT(states.GetStates().size(), checkpoint.step + 1);
+    expect_states_identical(checkpoint.state, states.GetStates()[checkpoint.step]);
+
+    auto restarted_integrator = create_heavy_top_integrator(time_stepper);
+    restarted_integrator.SetAdaptiveTimeStepPolicy(policy);
+    auto history = StateHistoryObserver();
+    restarted_integrator.Restart(checkpoint, 3, heavy_top, history);
+
+    ASSERT_EQ(history.GetStates().size(), states.GetStates().size() - checkpoint.step - 1);
+    for (size_t i = 0; i < history.GetStates().size(); ++i) {
+        expect_states_identical(
+            history.GetStates()[i], states.GetStates()[checkpoint.step + 1 + i]
+        );
+    }
+    EXPECT_EQ(restarted_integrator.GetTimeStepper().GetCurrentTime(), time_stepper.GetFinalTime());
+
+    // A checkpoint past the final time is not part of the analysis
+    checkpoint.current_time = 2. * time_stepper.GetFinalTime();
+    EXPECT_THROW(
+        restarted_integrator.Restart(checkpoint, 3, heavy_top, history), std::invalid_argument
+    );
+    std::remove(file_name.c_str());
+}
+
+TEST(CheckpointTest, RestartEnsembleFromAsynchronousCheckpoint) {
+    using BatchedTimeIntegrator = BatchedGeneralizedAlphaTimeIntegrator<>;
+    const auto file_name = std::string("checkpoint_ensemble.bin");
+    const auto time_stepper = TimeStepper(0., 0.002, 8, 10);
+
+    const size_t n_bodies = 3;
+    auto bodies = BatchedTimeIntegrator::BodiesView("bodies", n_bodies);
+    auto bodies_host = Kokkos::create_mirror_view(bodies);
+    auto states = BatchedTimeIntegrator::BatchedStateType(n_bodies);
+    for (size_t i = 0; i < n_bodies; ++i) {
+        bodies_host(i) = HeavyTop(15. * static_cast<double>(i + 1));
+        states.SetState(i, create_heavy_top_initial_state());
+    }
+    Kokkos::deep_copy(bodies, bodies_host);
+
+    auto time_integrator = BatchedTimeIntegrator(0.375, 0.125, 0.390625, 0.75, time_stepper, true);
+    time_integrator.SetCheckpointPolicy({file_name, 5});
+    time_integrator.Integrate(states, bodies);
+
+    auto checkpoint = read_batched_checkpoint(file_name);
+    EXPECT_EQ(checkpoint.step, 5);
+    EXPECT_EQ(checkpoint.states.GetNumberOfBodies(), n_bodies);
+
+    auto restarted_states = BatchedTimeIntegrator::BatchedStateType(n_bodies);
+    auto restarted_integrator =
+        BatchedTimeIntegrator(0.375, 0.125, 0.390625, 0.75, time_stepper, true);
+    restarted_integrator.Restart(checkpoint, restarted_states, bodies);
+
+    for (size_t i = 0; i < n_bodies; ++i) {
+        expect_states_identical(restarted_states.GetState(i), states.GetState(i));
+    }
+    EXPECT_EQ(
+        restarted_integrator.GetTimeStepper().GetTotalNumberOfIterations(),
+        time_integrator.GetTimeStepper().GetTotalNumberOfIterations()
+    );
+    std::remove(file_name.c_str());
+}
+
+TEST(CheckpointTest, ExpectThrowIfCheckpointIsInvalid) {
+    auto time_integrator = GeneralizedAlphaTimeIntegrator();
+    EXPECT_THROW(time_integrator.SetCheckpointPolicy({"", 10}), std::invalid_argument);
+    EXPECT_THROW(read_checkpoint("checkpoint_missing.bin"), std::runtime_error);
+
+    const auto file_name = std::string("checkpoint_single.bin");
+    auto checkpoint = time_integrator.CreateCheckpoint(
+        5, create_heavy_top_initial_state(), create_vector({0., 0., 0.})
+    );
+    write_checkpoint(file_name, checkpoint);
+
+    EXPECT_THROW(read_batched_checkpoint(file_name), std::runtime_error);
+    auto history = StateHistoryObserver();
+    EXPECT_THROW(
+        time_integrator.Restart(
+            checkpoint, 3, std::make_shared<HeavyTopLinearizationParameters>(), history
+        ),
+        std::invalid_argument
+    );
+    std::remove(file_name.c_str());
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
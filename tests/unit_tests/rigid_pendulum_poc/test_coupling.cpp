@@ -0,0 +1,162 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "src/rigid_pendulum_poc/coupling.h"
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+// Runs the loop of an external code on the provided channel, i.e. evaluates the loads of every
+// time step from the published kinematics until the channel is closed
+template <typename Evaluate>
+std::thread start_external_code(CouplingChannel& channel, Evaluate evaluate) {
+    return std::thread([&channel, evaluate]() {
+        for (size_t step = 1; channel.WaitForKinematics(channel.GetKinematicsStep(step)); ++step) {
+            const auto kinematics = channel.GetKinematics(channel.GetKinematicsStep(step));
+            evaluate(step, kinematics, channel.GetLoads(step));
+            channel.PublishLoads(step);
+        }
+    });
+}
+
+TEST(CouplingChannelTest, PublishAndWaitForTimeSteps) {
+    auto channel = CouplingChannel(2, 3);
+    channel.SetTimeout(std::chrono::milliseconds(1));
+    EXPECT_EQ(channel.GetNumberOfLoads(), 2);
+    EXPECT_EQ(channel.GetNumberOfKinematics(), 3);
+    EXPECT_EQ(channel.GetPipelineDepth(), 0);
+
+    // The slots of consecutive time steps are distinct, and reused after pipeline depth + 2 steps
+    EXPECT_NE(channel.GetLoads(1).data(), channel.GetLoads(2).data());
+    EXPECT_EQ(channel.GetLoads(1).data(), channel.GetLoads(3).data());
+    EXPECT_EQ(channel.GetKinematics(0).extent(0), 3);
+
+    // The loads of the initial state count as published
+    EXPECT_TRUE(channel.WaitForLoads(0));
+    EXPECT_THROW(channel.WaitForKinematics(0), std::runtime_error);
+    channel.GetKinematics(0)(2) = 4.;
+    channel.PublishKinematics(0);
+    EXPECT_TRUE(channel.WaitForKinematics(0));
+    EXPECT_EQ(channel.GetKinematics(0)(2), 4.);
+
+    EXPECT_THROW(channel.PublishKinematics(2), std::invalid_argument);
+    EXPECT_THROW(channel.PublishLoads(0), std::invalid_argument);
+
+    channel.Close();
+    EXPECT_TRUE(channel.IsClosed());
+    EXPECT_FALSE(channel.WaitForLoads(1));
+    EXPECT_THROW(CouplingChannel(0, 3), std::invalid_argument);
+}
+
+TEST(CouplingChannelTest, KinematicsStepsOfPipelinedLoads) {
+    const auto staggered = CouplingChannel(1, 1, 0);
+    EXPECT_EQ(staggered.GetKinematicsStep(1), 0);
+    EXPECT_EQ(staggered.GetKinematicsStep(5), 4);
+
+    const auto pipelined = CouplingChannel(1, 1, 1);
+    EXPECT_EQ(pipelined.GetKinematicsStep(1), 0);
+    EXPECT_EQ(pipelined.GetKinematicsStep(2), 0);
+    EXPECT_EQ(pipelined.GetKinematicsStep(5), 3);
+}
+
+TEST(CouplingChannelTest, ShareTheChannelThroughSharedMemory) {
+    const auto name = "/openturbine_test_coupling_" + std::to_string(getpid());
+    auto channel = CouplingChannel::Create(name, 6, 20, 1);
+    auto attached = CouplingChannel::Attach(name);
+    EXPECT_EQ(attached.GetNumberOfLoads(), 6);
+    EXPECT_EQ(attached.GetNumberOfKinematics(), 20);
+    EXPECT_EQ(attached.GetPipelineDepth(), 1);
+
+    // The loads written through one mapping are read in place through the other
+    attached.GetLoads(1)(5) = 42.;
+    attached.PublishLoads(1);
+    EXPECT_TRUE(channel.WaitForLoads(1));
+    EXPECT_NE(channel.GetLoads(1).data(), attached.GetLoads(1).data());
+    EXPECT_EQ(channel.GetLoads(1)(5), 42.);
+
+    EXPECT_THROW(CouplingChannel::Attach(name + "_missing"), std::runtime_error);
+}
+
+TEST(LoadCouplingObserverTest, CoupledLoadsMatchRegisteredLoads) {
+    // Loads that cancel the gravity of the heavy top
+    const auto loads = std::vector<double>{0., 0., 15. * 9.81, 0., 0., 0.};
+
+    auto reference_problem = HeavyTopLinearizationParameters();
+    reference_problem.SetExternalLoads(create_vector(loads));
+    auto reference_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 10, 10), true);
+    const auto reference =
+        reference_integrator.Integrate(create_heavy_top_initial_state(), 3, reference_problem);
+
+    auto channel =
+        std::make_shared<CouplingChannel>(6, LoadCouplingObserver::KinematicsSize(7, 6));
+    auto external_code =
+        start_external_code(*channel, [&loads](size_t, HostView1D, HostView1D external_loads) {
+            for (size_t i = 0; i < 6; ++i) {
+                external_loads(i) = loads[i];
+            }
+        });
+
+    auto problem = std::make_shared<HeavyTopLinearizationParameters>();
+    auto coupling = LoadCouplingObserver(channel, problem);
+    auto history = StateHistoryObserver();
+    auto observer = CallbackObserver(
+        [&](const TimeStepRecord& record) {
+            history.Observe(record);
+            coupling.Observe(record);
+        },
+        [&]() { coupling.Finalize(); }
+    );
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 10, 10), true);
+    time_integrator.Integrate(create_heavy_top_initial_state(), 3, *problem, observer);
+    external_code.join();
+
+    ASSERT_EQ(history.GetStates().size(), reference.size());
+    for (size_t i = 0; i < reference.size(); ++i) {
+        for (size_t j = 0; j < 7; ++j) {
+            EXPECT_EQ(
+                history.GetStates()[i].GetGeneralizedCoordinates()(j),
+                reference[i].GetGeneralizedCoordinates()(j)
+            );
+        }
+    }
+}
+
+TEST(LoadCouplingObserverTest, PipelinedLoadsFollowLaggedKinematics) {
+    auto channel =
+        std::make_shared<CouplingChannel>(6, LoadCouplingObserver::KinematicsSize(7, 6), 1);
+    auto kinematics_times = std::vector<double>{};
+    auto external_code = start_external_code(
+        *channel,
+        [&kinematics_times](size_t, HostView1D kinematics, HostView1D loads) {
+            kinematics_times.push_back(kinematics(0));
+            Kokkos::deep_copy(loads, 0.);
+        }
+    );
+
+    auto problem = std::make_shared<HeavyTopLinearizationParameters>();
+    auto observer = LoadCouplingObserver(channel, problem);
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 10, 10), true);
+    time_integrator.Integrate(create_heavy_top_initial_state(), 3, *problem, observer);
+    external_code.join();
+
+    // The loads of the time steps 1 to 11 follow from the kinematics of the steps 0, 0, 1, ... 9,
+    // and those of time step 12 are evaluated ahead if the channel is not closed before
+    EXPECT_TRUE(problem->HasExternalLoads());
+    ASSERT_GE(kinematics_times.size(), 11);
+    EXPECT_LE(kinematics_times.size(), 12);
+    for (size_t step = 1; step <= 11; ++step) {
+        EXPECT_NEAR(
+            kinematics_times[step - 1],
+            0.002 * static_cast<double>(channel->GetKinematicsStep(step)), 1e-12
+        );
+    }
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
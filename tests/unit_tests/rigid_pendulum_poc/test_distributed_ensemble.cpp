@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/distributed_ensemble.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+using DistributedIntegrator = DistributedEnsembleIntegrator<>;
+
+TEST(DistributedEnsembleTest, PartitionCoversEnsembleWithBalancedBlocks) {
+    for (size_t n_bodies : {0, 1, 7, 10, 100}) {
+        for (size_t n_ranks : {1, 3, 4, 16}) {
+            auto next_body = size_t{0};
+            for (size_t rank = 0; rank < n_ranks; ++rank) {
+                const auto partition = partition_ensemble(n_bodies, n_ranks, rank);
+
+                EXPECT_EQ(partition.first_body, next_body);
+                EXPECT_GE(partition.n_bodies, n_bodies / n_ranks);
+                EXPECT_LE(partition.n_bodies, n_bodies / n_ranks + 1);
+                next_body += partition.n_bodies;
+            }
+            EXPECT_EQ(next_body, n_bodies);
+        }
+    }
+}
+
+TEST(DistributedEnsembleTest, ExpectThrowIfRankIsNotOneOfTheRanks) {
+    EXPECT_THROW(partition_ensemble(10, 4, 4), std::invalid_argument);
+    EXPECT_THROW(partition_ensemble(10, 0, 0), std::invalid_argument);
+}
+
+TEST(DistributedEnsembleTest, ReduceStepStatisticsOfSingleProcess) {
+    const auto statistics = reduce_step_statistics(util::Communicator::Self(), 5, 4, 3, 0.25);
+
+    EXPECT_EQ(statistics.n_bodies, 5);
+    EXPECT_EQ(statistics.n_converged_bodies, 4);
+    EXPECT_EQ(statistics.max_iterations, 3);
+    EXPECT_EQ(statistics.min_wall_time, 0.25);
+    EXPECT_EQ(statistics.mean_wall_time, 0.25);
+    EXPECT_EQ(statistics.max_wall_time, 0.25);
+}
+
+TEST(DistributedEnsembleTest, PartitionsMatchBatchedIntegrationOfWholeEnsemble) {
+    const auto time_stepper = TimeStepper(0., 0.002, 5, 10);
+    const size_t n_bodies = 5;
+    auto create_bodies = [](size_t first_body, size_t n) {
+        auto bodies = DistributedIntegrator::BodiesView("bodies", n);
+        auto bodies_host = Kokkos::create_mirror_view(bodies);
+        for (size_t i = 0; i < n; ++i) {
+            bodies_host(i) = HeavyTop(15. + 5. * static_cast<double>(first_body + i));
+        }
+        Kokkos::deep_copy(bodies, bodies_host);
+        return bodies;
+    };
+    auto create_states = [](size_t n) {
+        auto states = DistributedIntegrator::BatchedStateType(n);
+        for (size_t i = 0; i < n; ++i) {
+            states.SetState(i, create_heavy_top_initial_state());
+        }
+        return states;
+    };
+
+    // Every process integrates the whole ensemble as the reference
+    auto expected_states = create_states(n_bodies);
+    auto batched_integrator = DistributedIntegrator::BatchedIntegratorType(
+        0.375, 0.125, 0.390625, 0.75, time_stepper, true
+    );
+    batched_integrator.Integrate(expected_states, create_bodies(0, n_bodies));
+
+    auto integrator = DistributedIntegrator(
+        util::Communicator::World(), n_bodies, 0.375, 0.125, 0.390625, 0.75, time_stepper, true
+    );
+    const auto partition = integrator.GetPartition();
+    auto states = create_states(partition.n_bodies);
+    size_t n_callbacks = 0;
+    integrator.Integrate(
+        states, create_bodies(partition.first_body, partition.n_bodies),
+        [&](size_t step, const DistributedIntegrator::BatchedStateType&) {
+            EXPECT_EQ(step, ++n_callbacks);
+        }
+    );
+
+    EXPECT_EQ(n_callbacks, 5);
+    EXPECT_TRUE(integrator.IsConverged());
+    EXPECT_EQ(integrator.GetLatestStepStatistics().n_bodies, n_bodies);
+    EXPECT_EQ(integrator.GetLatestStepStatistics().n_converged_bodies, n_bodies);
+    EXPECT_LE(
+        integrator.GetLatestStepStatistics().min_wall_time,
+        integrator.GetLatestStepStatistics().max_wall_time
+    );
+    EXPECT_EQ(integrator.GetIterationStatistics().GetCount(), 5);
+    EXPECT_EQ(integrator.GetWallTimeStatistics().GetCount(), 5);
+    for (size_t i = 0; i < partition.n_bodies; ++i) {
+        const auto state = states.GetState(i);
+        const auto expected = expected_states.GetState(partition.first_body + i);
+        for (size_t j = 0; j < 7; ++j) {
+            EXPECT_EQ(
+                state.GetGeneralizedCoordinates()(j), expected.GetGeneralizedCoordinates()(j)
+            );
+        }
+        for (size_t j = 0; j < 6; ++j) {
+            EXPECT_EQ(state.GetVelocity()(j), expected.GetVelocity()(j));
+        }
+    }
+}
+
+TEST(DistributedEnsembleTest, ExpectThrowIfStatesDoNotMatchPartition) {
+    auto integrator = DistributedIntegrator(util::Communicator::Self(), 3);
+    auto states = DistributedIntegrator::BatchedStateType(2);
+    auto bodies = DistributedIntegrator::BodiesView("bodies", 2);
+
+    EXPECT_THROW(integrator.Integrate(states, bodies), std::invalid_argument);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/execution_policy.h"
+#include "src/rigid_pendulum_poc/utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(ExecutionPolicyTest, SmallKernelsRunInline) {
+    EXPECT_TRUE(is_inline_kernel(0));
+    EXPECT_TRUE(is_inline_kernel(13));
+    EXPECT_TRUE(is_inline_kernel(kMaxInlineKernelSize));
+    EXPECT_FALSE(is_inline_kernel(kMaxInlineKernelSize + 1));
+}
+
+TEST(ExecutionPolicyTest, ParallelForVisitsEveryEntry) {
+    for (const size_t size : {size_t{0}, size_t{13}, kMaxInlineKernelSize + 7}) {
+        auto vector = HostView1D("vector", size);
+        host_parallel_for("fill_vector", size, [vector](size_t i) {
+            vector(i) += static_cast<double>(i);
+        });
+        for (size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(vector(i), static_cast<double>(i));
+        }
+    }
+}
+
+TEST(ExecutionPolicyTest, ParallelForVisitsEveryEntryOfAMatrix) {
+    for (const size_t rows : {size_t{3}, kMaxInlineKernelSize}) {
+        auto matrix = HostView2D("matrix", rows, 5);
+        host_parallel_for("fill_matrix", rows, 5, [matrix](size_t i, size_t j) {
+            matrix(i, j) += static_cast<double>(5 * i + j);
+        });
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < 5; ++j) {
+                EXPECT_EQ(matrix(i, j), static_cast<double>(5 * i + j));
+            }
+        }
+    }
+}
+
+TEST(ExecutionPolicyTest, ParallelReduceSumsEveryEntry) {
+    for (const size_t size : {size_t{13}, kMaxInlineKernelSize + 7}) {
+        auto sum = 0.;
+        host_parallel_reduce(
+            "sum_indices", size,
+            [](size_t i, double& partial_sum) { partial_sum += static_cast<double>(i); }, sum
+        );
+        EXPECT_EQ(sum, static_cast<double>(size * (size - 1) / 2));
+    }
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -3,6 +3,8 @@
 #include <gtest/gtest.h>
 
 #include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/multibody_model.h"
 #include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
 
 namespace openturbine::rigid_pendulum::tests {
@@ -105,6 +107,45 @@ TEST(TimeIntegratorTest, GetHistoryOfStatesFromTimeIntegrator) {
     EXPECT_EQ(state_history.size(), 18);
 }
 
+TEST(TimeIntegratorTest, StreamStatesOfTimeIntegrationToObserver) {
+    auto q0 = create_vector({1., 1., 1., 1., 1., 1., 1.});
+    auto v0 = create_vector({2., 2., 2., 2., 2., 2.});
+    auto a0 = create_vector({3., 3., 3., 3., 3., 3.});
+    auto aa0 = create_vector({4., 4., 4., 4., 4., 4.});
+    auto initial_state = State(q0, v0, a0, aa0);
+    auto unity_linearization_parameters = std::make_shared<UnityLinearizationParameters>();
+
+    auto history_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.1, 17));
+    auto state_history =
+        history_integrator.Integrate(initial_state, 0, unity_linearization_parameters);
+
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.1, 17));
+    auto latest_steps = RingBufferObserver(4);
+    time_integrator.Integrate(initial_state, 0, unity_linearization_parameters, latest_steps);
+
+    // The observer receives the initial state and then every time step, in order
+    auto records = latest_steps.GetRecords();
+    ASSERT_EQ(records.size(), 4);
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto step = 14 + i;
+        EXPECT_EQ(records[i].step, step);
+        EXPECT_NEAR(records[i].time, 0.1 * static_cast<double>(step), 1e-12);
+        EXPECT_EQ(records[i].lagrange_mults.extent(0), 0);
+        EXPECT_LE(
+            records[i].n_iterations,
+            time_integrator.GetTimeStepper().GetMaximumNumberOfIterations()
+        );
+        for (size_t j = 0; j < 7; ++j) {
+            EXPECT_EQ(
+                records[i].state.GetGeneralizedCoordinates()(j),
+                state_history[step].GetGeneralizedCoordinates()(j)
+            );
+        }
+    }
+}
+
 TEST(TimeIntegratorTest, TotalNumberOfIterationsInNonLinearSolution) {
     auto time_integrator =
         GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 1., 10));
@@ -135,6 +176,35 @@ TEST(TimeIntegratorTest, TotalNumberOfIterationsInNonLinearSolution) {
     );
 }
 
+TEST(TimeIntegratorTest, TimeStepperKeepsStatisticsOfEveryTimeStep) {
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 1., 10));
+
+    auto q0 = create_vector({1., 1., 1., 1., 1., 1., 1.});
+    auto v0 = create_vector({2., 2., 2., 2., 2., 2.});
+    auto a0 = create_vector({3., 3., 3., 3., 3., 3.});
+    auto aa0 = create_vector({4., 4., 4., 4., 4., 4.});
+    auto initial_state = State(q0, v0, a0, aa0);
+
+    time_integrator.Integrate(initial_state, 0, std::make_shared<UnityLinearizationParameters>());
+
+    const auto& time_stepper = time_integrator.GetTimeStepper();
+    const auto& wall_time = time_stepper.GetWallTimeStatistics();
+    const auto& solve_time = time_stepper.GetSolveTimeStatistics();
+    const auto& iterations = time_stepper.GetIterationStatistics();
+
+    EXPECT_EQ(wall_time.GetCount(), 10);
+    EXPECT_EQ(solve_time.GetCount(), 10);
+    EXPECT_EQ(iterations.GetCount(), 10);
+    EXPECT_EQ(iterations.GetTotal(), time_stepper.GetTotalNumberOfIterations());
+    EXPECT_LE(iterations.GetMax(), time_stepper.GetMaximumNumberOfIterations());
+
+    // The linear solves are part of the time steps
+    EXPECT_GT(wall_time.GetTotal(), 0.);
+    EXPECT_GE(solve_time.GetMin(), 0.);
+    EXPECT_LE(solve_time.GetTotal(), wall_time.GetTotal());
+}
+
 TEST(TimeIntegratorTest, TestUpdateGeneralizedCoordinates) {
     auto time_integrator =
         GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 1.0, 10));
@@ -185,6 +255,20 @@ TEST(TimeIntegratorTest, ExpectNonConvergedSolution) {
     EXPECT_FALSE(converged);
 }
 
+TEST(TimeIntegratorTest, ExpectConvergedSolutionRelativeToInitialResidual) {
+    auto time_integrator = GeneralizedAlphaTimeIntegrator();
+
+    EXPECT_FALSE(time_integrator.CheckConvergence(1e-6, 1.));
+
+    auto policy = NewtonPolicy{};
+    policy.relative_tolerance = 1e-5;
+    time_integrator.SetNewtonPolicy(policy);
+
+    EXPECT_TRUE(time_integrator.CheckConvergence(1e-6, 1.));
+    EXPECT_FALSE(time_integrator.CheckConvergence(1e-4, 1.));
+    EXPECT_TRUE(time_integrator.CheckConvergence(1e-13, 0.));
+}
+
 TEST(GeneralizedAlphaTimeIntegratorTest, ConstructorWithInvalidAlphaF) {
     EXPECT_THROW(GeneralizedAlphaTimeIntegrator(1.1, 0.5, 0.25, 0.5), std::invalid_argument);
 }
@@ -385,4 +469,740 @@ TEST(TimeIntegratorTest, AlphaStepSolutionAfterOneIncWithNonZeroStates) {
     );
 }
 
+/// Unity residual vector and identity iteration matrix returned from preallocated views, i.e.
+/// a problem that does not allocate during the time integration
+class PreallocatedLinearizationParameters : public LinearizationParameters {
+public:
+    PreallocatedLinearizationParameters(size_t size)
+        : residual_("residual", size), iteration_matrix_("iteration_matrix", size, size) {}
+
+    virtual HostView1D ResidualVector(
+        const HostView1D, const HostView1D, const HostView1D, const HostView1D
+    ) override {
+        Kokkos::deep_copy(residual_, 1.);
+        return residual_;
+    }
+
+    virtual HostView2D IterationMatrix(
+        const double&, const double&, const double&, const HostView1D, const HostView1D,
+        const HostView1D, const HostView1D, const HostView1D
+    ) override {
+        Kokkos::deep_copy(iteration_matrix_, 0.);
+        for (size_t i = 0; i < iteration_matrix_.extent(0); ++i) {
+            iteration_matrix_(i, i) = 1.;
+        }
+        return iteration_matrix_;
+    }
+
+private:
+    HostView1D residual_;
+    HostView2D iteration_matrix_;
+};
+
+TEST(TimeIntegratorTest, IntegrateSizesWorkspaceFromInitialStateAndConstraints) {
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 1.0, 2));
+
+    auto q0 = create_vector({1., 1., 1., 1., 1., 1., 1.});
+    auto v0 = create_vector({2., 2., 2., 2., 2., 2.});
+    auto a0 = create_vector({3., 3., 3., 3., 3., 3.});
+    auto aa0 = create_vector({4., 4., 4., 4., 4., 4.});
+    auto initial_state = State(q0, v0, a0, aa0);
+
+    size_t n_lagrange_mults{3};
+    std::shared_ptr<LinearizationParameters> unity_linearization_parameters =
+        std::make_shared<UnityLinearizationParameters>();
+
+    time_integrator.Integrate(initial_state, n_lagrange_mults, unity_linearization_parameters);
+
+    EXPECT_TRUE(time_integrator.GetWorkspace().IsSizedFor(7, 6, 3));
+}
+
+TEST(TimeIntegratorTest, AlphaStepDoesNotModifyProvidedState) {
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 1.0, 1));
+
+    auto q0 = create_vector({1., 1., 1., 1., 1., 1., 1.});
+    auto v0 = create_vector({2., 2., 2., 2., 2., 2.});
+    auto a0 = create_vector({3., 3., 3., 3., 3., 3.});
+    auto aa0 = create_vector({4., 4., 4., 4., 4., 4.});
+    auto state = State(q0, v0, a0, aa0);
+
+    size_t n_lagrange_mults{0};
+    std::shared_ptr<LinearizationParameters> unity_linearization_parameters =
+        std::make_shared<UnityLinearizationParameters>();
+
+    time_integrator.AlphaStep(state, n_lagrange_mults, unity_linearization_parameters);
+
+    expect_kokkos_view_1D_equal(state.GetGeneralizedCoordinates(), {1., 1., 1., 1., 1., 1., 1.});
+    expect_kokkos_view_1D_equal(state.GetVelocity(), {2., 2., 2., 2., 2., 2.});
+    expect_kokkos_view_1D_equal(state.GetAcceleration(), {3., 3., 3., 3., 3., 3.});
+    expect_kokkos_view_1D_equal(state.GetAlgorithmicAcceleration(), {4., 4., 4., 4., 4., 4.});
+}
+
+TEST(TimeIntegratorTest, SteadyStateAlphaStepOnlyAllocatesReturnedResults) {
+    size_t n_lagrange_mults{3};
+    std::shared_ptr<LinearizationParameters> preallocated_linearization_parameters =
+        std::make_shared<PreallocatedLinearizationParameters>(6 + n_lagrange_mults);
+
+    auto q0 = create_vector({0., 0., 0., 1., 0., 0., 0.});
+    auto v0 = create_vector({1., 2., 3., 4., 5., 6.});
+    auto initial_state = State(q0, v0, v0, v0);
+
+    auto count_allocations_per_step = [&](size_t max_iterations) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.1, 1, max_iterations)
+        );
+
+        // The first step sizes the workspace, the second one is a steady-state step
+        auto [state, lagrange_mults] = time_integrator.AlphaStep(
+            initial_state, n_lagrange_mults, preallocated_linearization_parameters
+        );
+
+        AllocationCounter counter;
+        time_integrator.AlphaStep(state, n_lagrange_mults, preallocated_linearization_parameters);
+        return counter.GetNumberOfAllocations();
+    };
+
+    // A steady-state step only allocates the returned State (4 views) and Lagrange multipliers
+    // (1 view), independent of the number of Newton-Raphson iterations it performs
+    EXPECT_EQ(count_allocations_per_step(1), 5);
+    EXPECT_EQ(count_allocations_per_step(10), 5);
+}
+
+TEST(TimeIntegratorTest, ExpectThrowIfJacobianUpdatePolicyIsInvalid) {
+    auto time_integrator = GeneralizedAlphaTimeIntegrator();
+
+    EXPECT_THROW(
+        time_integrator.SetJacobianUpdatePolicy({JacobianUpdateStrategy::kEVERY_K_STEPS, 0}),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        time_integrator.SetJacobianUpdatePolicy({JacobianUpdateStrategy::kON_STALL, 1, 0.}),
+        std::invalid_argument
+    );
+}
+
+TEST(TimeIntegratorTest, ReusedIterationMatrixConvergesToFullNewtonSolution) {
+    // Heavy top problem from Brüls and Cardona (2010)
+    auto omega0 = Vector({0., 150., -4.61538});
+    auto initial_velocity = omega0.CrossProduct(Vector({0., 1., 0.}));
+    auto q0 = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    auto v0 = create_vector(
+        {initial_velocity.GetXComponent(), initial_velocity.GetYComponent(),
+         initial_velocity.GetZComponent(), omega0.GetXComponent(), omega0.GetYComponent(),
+         omega0.GetZComponent()}
+    );
+    auto a0 =
+        create_vector({0., -21.301732544400004, -30.960830769230938, 661.3461692307692, 0., 0.});
+    auto aa0 = create_vector({0., 0., 0., 0., 0., 0.});
+    auto initial_state = State(q0, v0, a0, aa0);
+
+    auto integrate = [&](const JacobianUpdatePolicy& policy) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 10, 50), true
+        );
+        time_integrator.SetJacobianUpdatePolicy(policy);
+        auto results = time_integrator.Integrate(
+            initial_state, 3, std::make_shared<HeavyTopLinearizationParameters>()
+        );
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return std::make_tuple(
+            results.back(), time_integrator.GetLinearSolver().GetNumberOfFactorizations()
+        );
+    };
+
+    auto [full_newton_state, full_newton_factorizations] = integrate({});
+    for (auto policy : {
+             JacobianUpdatePolicy{JacobianUpdateStrategy::kEVERY_K_ITERATIONS, 2},
+             JacobianUpdatePolicy{JacobianUpdateStrategy::kEVERY_K_STEPS, 2},
+             JacobianUpdatePolicy{JacobianUpdateStrategy::kON_STALL, 1, 0.5},
+         }) {
+        auto [state, n_factorizations] = integrate(policy);
+
+        EXPECT_LT(n_factorizations, full_newton_factorizations);
+        for (size_t i = 0; i < 7; ++i) {
+            EXPECT_NEAR(
+                state.GetGeneralizedCoordinates()(i),
+                full_newton_state.GetGeneralizedCoordinates()(i), 1e-10
+            );
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            EXPECT_NEAR(state.GetVelocity()(i), full_newton_state.GetVelocity()(i), 1e-8);
+        }
+    }
+}
+
+TEST(TimeIntegratorTest, BroydenUpdatesConvergeInFewerIterationsThanModifiedNewton) {
+    auto integrate = [](const JacobianUpdatePolicy& policy) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 10, 50), true
+        );
+        time_integrator.SetJacobianUpdatePolicy(policy);
+        auto results = time_integrator.Integrate(
+            create_heavy_top_initial_state(), 3,
+            std::make_shared<HeavyTopLinearizationParameters>()
+        );
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return std::make_tuple(results.back(), time_integrator.GetTimeStepper());
+    };
+
+    auto [full_newton_state, full_newton_stepper] = integrate({});
+    auto [modified_newton_state, modified_newton_stepper] =
+        integrate({JacobianUpdateStrategy::kEVERY_K_STEPS, 1});
+    auto [state, stepper] = integrate({JacobianUpdateStrategy::kBROYDEN, 1, 0.5});
+
+    // The iteration matrix is updated about once per time step, like modified Newton, while the
+    // Broyden updates of its inverse in between save iterations
+    EXPECT_EQ(modified_newton_stepper.GetTotalNumberOfJacobianUpdates(), 10);
+    EXPECT_EQ(modified_newton_stepper.GetTotalNumberOfBroydenUpdates(), 0);
+    EXPECT_LT(
+        stepper.GetTotalNumberOfJacobianUpdates(),
+        full_newton_stepper.GetTotalNumberOfJacobianUpdates()
+    );
+    EXPECT_GT(stepper.GetTotalNumberOfBroydenUpdates(), 0);
+    EXPECT_LT(
+        stepper.GetTotalNumberOfIterations(), modified_newton_stepper.GetTotalNumberOfIterations()
+    );
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), full_newton_state.GetGeneralizedCoordinates()(i),
+            1e-10
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), full_newton_state.GetVelocity()(i), 1e-8);
+    }
+}
+
+TEST(TimeIntegratorTest, AdaptiveTimeStepReachesFinalTimeWithFewerSteps) {
+    auto heavy_top = std::make_shared<HeavyTopLinearizationParameters>();
+
+    // Reference solution with a small, fixed time step
+    auto reference_integrator = GeneralizedAlphaTimeIntegrator(
+        0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.0005, 200, 50), true
+    );
+    auto reference =
+        reference_integrator.Integrate(create_heavy_top_initial_state(), 3, heavy_top).back();
+
+    auto time_integrator = GeneralizedAlphaTimeIntegrator(
+        0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.0005, 200, 50), true
+    );
+    auto policy = AdaptiveTimeStepPolicy{};
+    policy.is_adaptive = true;
+    policy.absolute_tolerance = 1e-5;
+    policy.relative_tolerance = 1e-3;
+    time_integrator.SetAdaptiveTimeStepPolicy(policy);
+    auto times = std::vector<double>{};
+    auto final_state = State();
+    auto observer = CallbackObserver([&times, &final_state](const TimeStepRecord& record) {
+        EXPECT_TRUE(record.is_converged);
+        times.push_back(record.time);
+        final_state = record.state;
+    });
+    time_integrator.Integrate(create_heavy_top_initial_state(), 3, heavy_top, observer);
+
+    // Far fewer steps than with the fixed time step of the reference solution
+    EXPECT_LT(times.size() - 1, 200);
+    EXPECT_EQ(times.back(), time_integrator.GetTimeStepper().GetFinalTime());
+    EXPECT_EQ(time_integrator.GetTimeStepper().GetCurrentTime(), times.back());
+    for (size_t i = 1; i < times.size(); ++i) {
+        EXPECT_GT(times[i], times[i - 1]);
+    }
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            final_state.GetGeneralizedCoordinates()(i), reference.GetGeneralizedCoordinates()(i),
+            1e-3
+        );
+    }
+}
+
+TEST(TimeIntegratorTest, AdaptiveTimeStepRejectsStepsThatDoNotConverge) {
+    // A single Newton-Raphson iteration never converges, so every step is rejected until the
+    // minimum time step is reached
+    auto time_integrator = GeneralizedAlphaTimeIntegrator(
+        0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 10, 1), true
+    );
+    auto policy = AdaptiveTimeStepPolicy{};
+    policy.is_adaptive = true;
+    policy.min_time_step = 0.0005;
+    time_integrator.SetAdaptiveTimeStepPolicy(policy);
+
+    auto history = StateHistoryObserver();
+    EXPECT_THROW(
+        time_integrator.Integrate(
+            create_heavy_top_initial_state(), 3,
+            std::make_shared<HeavyTopLinearizationParameters>(), history
+        ),
+        std::runtime_error
+    );
+    EXPECT_EQ(time_integrator.GetNumberOfRejectedSteps(), 3);
+}
+
+TEST(TimeIntegratorTest, StaticDispatchMatchesVirtualDispatch) {
+    auto integrate = [](auto&& integrate_problem) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 10, 10), true
+        );
+        auto results = integrate_problem(time_integrator);
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return results.back();
+    };
+
+    // The problem is provided by reference to its concrete type or through the base class
+    auto heavy_top = HeavyTopLinearizationParameters();
+    const auto state = integrate([&](GeneralizedAlphaTimeIntegrator& time_integrator) {
+        return time_integrator.Integrate(create_heavy_top_initial_state(), 3, heavy_top);
+    });
+    const auto expected = integrate([](GeneralizedAlphaTimeIntegrator& time_integrator) {
+        return time_integrator.Integrate(
+            create_heavy_top_initial_state(), 3,
+            std::make_shared<HeavyTopLinearizationParameters>()
+        );
+    });
+
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_EQ(state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i));
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(state.GetVelocity()(i), expected.GetVelocity()(i));
+        EXPECT_EQ(state.GetAcceleration()(i), expected.GetAcceleration()(i));
+    }
+}
+
+TEST(TimeIntegratorTest, NewtonKrylovMatchesDirectSolution) {
+    auto integrate = [](const LinearSolverPolicy& policy, auto problem, const State& state,
+                        size_t n_constraints) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 10, 20), true, policy
+        );
+        auto results = time_integrator.Integrate(state, n_constraints, problem);
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return std::make_tuple(results.back(), time_integrator);
+    };
+
+    auto policy = LinearSolverPolicy{};
+    policy.type = LinearSolverType::kNEWTON_KRYLOV;
+
+    // Finite difference Jacobian-vector products of the heavy top, and analytic ones of the
+    // multibody model of the heavy top
+    for (auto problem : std::vector<std::shared_ptr<LinearizationParameters>>{
+             std::make_shared<HeavyTopLinearizationParameters>(), create_heavy_top_model()}) {
+        auto [expected, direct_integrator] =
+            integrate({}, problem, create_heavy_top_initial_state(), 3);
+        auto [state, krylov_integrator] =
+            integrate(policy, problem, create_heavy_top_initial_state(), 3);
+
+        // No iteration matrix is formed or factorized
+        EXPECT_EQ(krylov_integrator.GetLinearSolver().GetNumberOfFactorizations(), 0);
+        EXPECT_EQ(krylov_integrator.GetWorkspace().GetIterationMatrix().size(), 0);
+        EXPECT_GT(krylov_integrator.GetKrylovSolver().GetTotalNumberOfIterations(), 0);
+        EXPECT_GT(direct_integrator.GetLinearSolver().GetNumberOfFactorizations(), 0);
+
+        for (size_t i = 0; i < 7; ++i) {
+            EXPECT_NEAR(
+                state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i),
+                1e-10
+            );
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-7);
+        }
+    }
+}
+
+TEST(TimeIntegratorTest, MixedPrecisionMatchesDoublePrecisionSolution) {
+    auto integrate = [](const LinearSolverPolicy& policy) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 10, 20), true, policy
+        );
+        auto results = time_integrator.Integrate(
+            create_heavy_top_initial_state(), 3,
+            std::make_shared<HeavyTopLinearizationParameters>()
+        );
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return std::make_tuple(results.back(), time_integrator);
+    };
+
+    auto policy = LinearSolverPolicy{};
+    policy.precision = FactorizationPrecision::kMIXED;
+    auto [expected, double_integrator] = integrate({});
+    auto [state, mixed_integrator] = integrate(policy);
+
+    EXPECT_EQ(mixed_integrator.GetLinearSolver().GetPrecision(), FactorizationPrecision::kMIXED);
+    EXPECT_TRUE(mixed_integrator.GetLinearSolver().IsRefined());
+    EXPECT_EQ(mixed_integrator.GetLinearSolver().GetNumberOfFallbacks(), 0);
+    EXPECT_EQ(
+        mixed_integrator.GetTimeStepper().GetTotalNumberOfIterations(),
+        double_integrator.GetTimeStepper().GetTotalNumberOfIterations()
+    );
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-12
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-9);
+    }
+}
+
+TEST(TimeIntegratorTest, NullSpaceReductionMatchesDirectSolution) {
+    auto integrate = [](const LinearSolverPolicy& policy) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 10, 20), true, policy
+        );
+        auto results = time_integrator.Integrate(
+            create_heavy_top_initial_state(), 3,
+            std::make_shared<HeavyTopLinearizationParameters>()
+        );
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return std::make_tuple(results.back(), time_integrator);
+    };
+
+    auto policy = LinearSolverPolicy{};
+    policy.type = LinearSolverType::kNULL_SPACE;
+    auto [expected, direct_integrator] = integrate({});
+    auto [state, reduced_integrator] = integrate(policy);
+
+    // The factorized system holds the 3 unconstrained velocities of the heavy top only
+    EXPECT_EQ(reduced_integrator.GetNullSpaceReduction().GetReducedSize(), 3);
+    EXPECT_EQ(reduced_integrator.GetLinearSolver().GetSize(), 3);
+    EXPECT_EQ(direct_integrator.GetLinearSolver().GetSize(), 9);
+    EXPECT_EQ(
+        reduced_integrator.GetTimeStepper().GetTotalNumberOfIterations(),
+        direct_integrator.GetTimeStepper().GetTotalNumberOfIterations()
+    );
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-12
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-9);
+    }
+}
+
+TEST(TimeIntegratorTest, SparseDirectSolutionOfPendulumChainMatchesDirectSolution) {
+    // A chain of pendulums of length 2 hanging along the y-axis from the origin, spinning about
+    // the y-axis
+    constexpr size_t n_bodies = 8;
+    auto model = std::make_shared<MultibodyModel>();
+    auto gen_coords = HostView1D("gen_coords", 7 * n_bodies);
+    auto velocity = HostView1D("velocity", 6 * n_bodies);
+    for (size_t body = 0; body < n_bodies; ++body) {
+        model->AddRigidBody(RigidBodyElement(1., Vec<3>{{0.1, 0.01, 0.1}}));
+        model->AddSphericalJoint(SphericalJointElement(
+            body == 0 ? SphericalJointElement::kGround : body - 1,
+            body == 0 ? Vec<3>{} : Vec<3>{{0., 1., 0.}}, body, Vec<3>{{0., -1., 0.}}
+        ));
+        const auto y = 1. + 2. * static_cast<double>(body);
+        gen_coords(7 * body + 1) = y;
+        gen_coords(7 * body + 3) = 1.;
+        velocity(6 * body + 2) = y;
+        velocity(6 * body + 3) = 1.;
+    }
+    const auto initial_state = State(
+        gen_coords, velocity, HostView1D("acceleration", 6 * n_bodies),
+        HostView1D("algorithmic_acceleration", 6 * n_bodies)
+    );
+
+    auto integrate = [&](const LinearSolverPolicy& policy) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.005, 10, 20), true, policy
+        );
+        time_integrator.SetJacobianUpdatePolicy({JacobianUpdateStrategy::kEVERY_K_ITERATIONS, 2});
+        auto results = time_integrator.Integrate(initial_state, 3 * n_bodies, model);
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return std::make_tuple(results.back(), time_integrator);
+    };
+
+    auto policy = LinearSolverPolicy{};
+    policy.type = LinearSolverType::kSPARSE_DIRECT;
+    auto [expected, direct_integrator] = integrate({});
+    auto [state, sparse_integrator] = integrate(policy);
+
+    // Only the banded solver holds a factorization, whose factors are reused between updates
+    const auto& banded_solver = sparse_integrator.GetBandedLinearSolver();
+    EXPECT_EQ(sparse_integrator.GetLinearSolver().GetSize(), 0);
+    EXPECT_EQ(banded_solver.GetSize(), 9 * n_bodies);
+    EXPECT_LT(banded_solver.GetNumberOfSubDiagonals(), 9 * n_bodies / 2);
+    EXPECT_EQ(
+        banded_solver.GetNumberOfFactorizations(),
+        sparse_integrator.GetTimeStepper().GetTotalNumberOfJacobianUpdates()
+    );
+    EXPECT_LT(
+        sparse_integrator.GetTimeStepper().GetTotalNumberOfJacobianUpdates(),
+        sparse_integrator.GetTimeStepper().GetTotalNumberOfIterations()
+    );
+    EXPECT_EQ(
+        sparse_integrator.GetTimeStepper().GetTotalNumberOfIterations(),
+        direct_integrator.GetTimeStepper().GetTotalNumberOfIterations()
+    );
+    for (size_t i = 0; i < 7 * n_bodies; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-10
+        );
+    }
+    for (size_t i = 0; i < 6 * n_bodies; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-8);
+    }
+}
+
+TEST(TimeIntegratorTest, ExpectThrowIfLinearSolverPolicyIsInvalid) {
+    auto policy = LinearSolverPolicy{};
+    policy.type = LinearSolverType::kNEWTON_KRYLOV;
+
+    auto invalid_restart = policy;
+    invalid_restart.krylov_restart = 0;
+    auto invalid_tolerance = policy;
+    invalid_tolerance.krylov_tolerance = 0.;
+    auto invalid_perturbation = policy;
+    invalid_perturbation.perturbation = 0.;
+    auto invalid_refinement = LinearSolverPolicy{};
+    invalid_refinement.precision = FactorizationPrecision::kMIXED;
+    invalid_refinement.max_refinement_iterations = 0;
+    auto invalid_sparse_precision = LinearSolverPolicy{};
+    invalid_sparse_precision.type = LinearSolverType::kSPARSE_DIRECT;
+    invalid_sparse_precision.precision = FactorizationPrecision::kMIXED;
+
+    for (const auto& invalid_policy :
+         {invalid_restart, invalid_tolerance, invalid_perturbation, invalid_refinement,
+          invalid_sparse_precision}) {
+        EXPECT_THROW(
+            GeneralizedAlphaTimeIntegrator(
+                0.5, 0.5, 0.25, 0.5, TimeStepper(), false, invalid_policy
+            ),
+            std::invalid_argument
+        );
+    }
+}
+
+// Returns the final state and the total number of iterations of the heavy top problem
+// integrated with the provided Newton policy
+std::tuple<State, size_t> integrate_heavy_top(const NewtonPolicy& policy) {
+    auto time_integrator = GeneralizedAlphaTimeIntegrator(
+        0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 20, 20), true
+    );
+    time_integrator.SetNewtonPolicy(policy);
+    auto results = time_integrator.Integrate(
+        create_heavy_top_initial_state(), 3, std::make_shared<HeavyTopLinearizationParameters>()
+    );
+    EXPECT_TRUE(time_integrator.IsConverged());
+    return std::make_tuple(
+        results.back(), time_integrator.GetTimeStepper().GetTotalNumberOfIterations()
+    );
+}
+
+TEST(TimeIntegratorTest, PredictorOfConstantAccelerationConvergesWithoutIterations) {
+    // A free falling body, i.e. of constant acceleration, which the predictor extrapolates from
+    // the first time step on
+    auto model = MultibodyModel();
+    model.AddRigidBody(RigidBodyElement());
+    const auto initial_state = State(
+        create_vector({0., 0., 0., 1., 0., 0., 0.}), create_vector({1., 0., 0., 0., 0., 0.}),
+        create_vector({0., 0., -9.81, 0., 0., 0.}), create_vector({0., 0., -9.81, 0., 0., 0.})
+    );
+
+    for (size_t order = 1; order <= 3; ++order) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.01, 10, 10), true
+        );
+        auto policy = NewtonPolicy{};
+        policy.predictor_order = order;
+        time_integrator.SetNewtonPolicy(policy);
+        auto results = time_integrator.Integrate(initial_state, 0, model);
+
+        EXPECT_TRUE(time_integrator.IsConverged());
+        EXPECT_EQ(time_integrator.GetTimeStepper().GetIterationStatistics().GetMax(), 1.);
+        EXPECT_EQ(time_integrator.GetTimeStepper().GetTotalNumberOfIterations(), 1);
+        EXPECT_NEAR(results.back().GetGeneralizedCoordinates()(0), 0.1, 1e-12);
+        EXPECT_NEAR(results.back().GetAcceleration()(2), -9.81, 1e-12);
+    }
+}
+
+TEST(TimeIntegratorTest, PredictorConvergesToSolutionWithoutPredictor) {
+    auto [expected, expected_iterations] = integrate_heavy_top({});
+
+    for (size_t order = 1; order <= 3; ++order) {
+        auto policy = NewtonPolicy{};
+        policy.predictor_order = order;
+        auto [state, n_iterations] = integrate_heavy_top(policy);
+
+        EXPECT_LE(n_iterations, expected_iterations);
+        for (size_t i = 0; i < 7; ++i) {
+            EXPECT_NEAR(
+                state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i),
+                1e-10
+            );
+        }
+        for (size_t i = 0; i < 6; ++i) {
+            EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-8);
+        }
+    }
+}
+
+TEST(TimeIntegratorTest, LineSearchConvergesToFullNewtonSolution) {
+    auto [expected, expected_iterations] = integrate_heavy_top({});
+
+    auto policy = NewtonPolicy{};
+    policy.is_line_search = true;
+    auto [state, n_iterations] = integrate_heavy_top(policy);
+
+    // Full Newton increments decrease the residual norm sufficiently near the solution, i.e.
+    // the line search does not backtrack
+    EXPECT_EQ(n_iterations, expected_iterations);
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-10
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-8);
+    }
+}
+
+TEST(TimeIntegratorTest, RelativeToleranceConvergesInFewerIterations) {
+    auto [expected, expected_iterations] = integrate_heavy_top({});
+
+    auto policy = NewtonPolicy{};
+    policy.relative_tolerance = 1e-6;
+    auto [state, n_iterations] = integrate_heavy_top(policy);
+
+    EXPECT_LT(n_iterations, expected_iterations);
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-6
+        );
+    }
+}
+
+TEST(TimeIntegratorTest, DiagnosticsAccumulateInvariantsOfEveryTimeStep) {
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 100, 10), true);
+    auto policy = DiagnosticsPolicy{};
+    policy.is_enabled = true;
+    time_integrator.SetDiagnosticsPolicy(policy);
+    auto problem = HeavyTopLinearizationParameters();
+    const auto results = time_integrator.Integrate(create_heavy_top_initial_state(), 3, problem);
+
+    // One sample of the initial state and of every time step
+    const auto diagnostics = time_integrator.GetDiagnostics();
+    ASSERT_EQ(diagnostics.extent(0), 1);
+    const auto& energy = diagnostics(0).total_energy;
+    EXPECT_EQ(energy.GetCount(), 101);
+    EXPECT_EQ(diagnostics(0).n_renormalizations, 0);
+
+    // The statistics match the invariants of the stored states
+    auto invariants = RigidBodyInvariantsView1D<Kokkos::HostSpace>("invariants", 1);
+    auto min_energy = std::numeric_limits<double>::infinity();
+    auto max_energy = -std::numeric_limits<double>::infinity();
+    auto sum_energy = 0.;
+    for (const auto& state : results) {
+        problem.CalculateInvariants(
+            state.GetGeneralizedCoordinates(), state.GetVelocity(), invariants
+        );
+        min_energy = std::min(min_energy, invariants(0).total_energy);
+        max_energy = std::max(max_energy, invariants(0).total_energy);
+        sum_energy += invariants(0).total_energy;
+    }
+    EXPECT_NEAR(energy.GetLast(), invariants(0).total_energy, 1e-12);
+    EXPECT_NEAR(energy.GetMin(), min_energy, 1e-12);
+    EXPECT_NEAR(energy.GetMax(), max_energy, 1e-12);
+    EXPECT_NEAR(energy.GetMean(), sum_energy / 101., 1e-9);
+
+    // The top satisfies its constraints and the unit norm of its quaternion to round-off
+    EXPECT_LT(diagnostics(0).constraint_violation.GetMax(), 1e-10);
+    EXPECT_LT(diagnostics(0).quaternion_norm_drift.GetMax(), 1e-12);
+}
+
+TEST(TimeIntegratorTest, DiagnosticsShowSecondOrderDriftOfInvariants) {
+    // Returns the spread of the energy and the vertical angular momentum of the heavy top over
+    // 0.2 seconds with the provided time step, relative to their means
+    auto integrate = [](double h) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.5, 0.5, 0.25, 0.5, TimeStepper(0., h, static_cast<size_t>(0.2 / h + 0.5), 10), true
+        );
+        auto policy = DiagnosticsPolicy{};
+        policy.is_enabled = true;
+        time_integrator.SetDiagnosticsPolicy(policy);
+        time_integrator.Integrate(
+            create_heavy_top_initial_state(), 3, std::make_shared<HeavyTopLinearizationParameters>()
+        );
+        const auto diagnostics = time_integrator.GetDiagnostics()(0);
+        return std::make_tuple(
+            (diagnostics.total_energy.GetMax() - diagnostics.total_energy.GetMin()) /
+                diagnostics.total_energy.GetMean(),
+            (diagnostics.angular_momentum.GetMax() - diagnostics.angular_momentum.GetMin()) /
+                std::abs(diagnostics.angular_momentum.GetMean())
+        );
+    };
+
+    // Both invariants are conserved by the continuous problem, i.e. the drift of the undamped
+    // integrator is its second-order error
+    const auto [energy_drift, momentum_drift] = integrate(0.002);
+    const auto [refined_energy_drift, refined_momentum_drift] = integrate(0.001);
+    EXPECT_LT(energy_drift, 1e-2);
+    EXPECT_GT(energy_drift / refined_energy_drift, 3.);
+    EXPECT_GT(momentum_drift / refined_momentum_drift, 3.);
+}
+
+TEST(TimeIntegratorTest, DiagnosticsRenormalizeDriftingQuaternions) {
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 20, 10), true);
+    auto policy = DiagnosticsPolicy{};
+    policy.is_enabled = true;
+    policy.renormalization_threshold = std::numeric_limits<double>::min();
+    time_integrator.SetDiagnosticsPolicy(policy);
+    const auto results = time_integrator.Integrate(
+        create_heavy_top_initial_state(), 3, std::make_shared<HeavyTopLinearizationParameters>()
+    );
+
+    // Every drifting quaternion is renormalized, i.e. the states drift by round-off only
+    const auto diagnostics = time_integrator.GetDiagnostics();
+    EXPECT_LE(diagnostics(0).n_renormalizations, 20);
+    for (const auto& state : results) {
+        auto norm = 0.;
+        for (size_t i = 3; i < 7; ++i) {
+            norm += std::pow(state.GetGeneralizedCoordinates()(i), 2);
+        }
+        EXPECT_NEAR(std::sqrt(norm), 1., 1e-15);
+    }
+
+    policy.renormalization_threshold = 0.;
+    EXPECT_THROW(time_integrator.SetDiagnosticsPolicy(policy), std::invalid_argument);
+}
+
+TEST(TimeIntegratorTest, DiagnosticsOfProblemsWithoutInvariants) {
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.5, 0.5, 0.25, 0.5, TimeStepper(0., 1., 1, 1));
+    auto policy = DiagnosticsPolicy{};
+    policy.is_enabled = true;
+    time_integrator.SetDiagnosticsPolicy(policy);
+    auto problem = UnityLinearizationParameters();
+    EXPECT_FALSE(problem.HasInvariants());
+    time_integrator.Integrate(create_heavy_top_initial_state(), 3, problem);
+
+    const auto diagnostics = time_integrator.GetDiagnostics();
+    EXPECT_EQ(diagnostics(0).quaternion_norm_drift.GetCount(), 2);
+    EXPECT_EQ(diagnostics(0).total_energy.GetMax(), 0.);
+}
+
+TEST(TimeIntegratorTest, ExpectThrowIfNewtonPolicyIsInvalid) {
+    auto invalid_order = NewtonPolicy{};
+    invalid_order.predictor_order = 4;
+    auto invalid_backtracks = NewtonPolicy{};
+    invalid_backtracks.is_line_search = true;
+    invalid_backtracks.max_backtracks = 0;
+    auto invalid_armijo_constant = NewtonPolicy{};
+    invalid_armijo_constant.armijo_constant = 1.;
+    auto invalid_tolerance = NewtonPolicy{};
+    invalid_tolerance.relative_tolerance = -1e-6;
+
+    auto time_integrator = GeneralizedAlphaTimeIntegrator();
+    for (const auto& invalid_policy :
+         {invalid_order, invalid_backtracks, invalid_armijo_constant, invalid_tolerance}) {
+        EXPECT_THROW(time_integrator.SetNewtonPolicy(invalid_policy), std::invalid_argument);
+    }
+}
+
 }  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/generalized_alpha_workspace.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(GeneralizedAlphaWorkspaceTest, CreateDefaultWorkspace) {
+    auto workspace = GeneralizedAlphaWorkspace();
+
+    EXPECT_EQ(workspace.GetNumberOfGeneralizedCoordinates(), 0);
+    EXPECT_EQ(workspace.GetNumberOfVelocities(), 0);
+    EXPECT_EQ(workspace.GetNumberOfConstraints(), 0);
+    EXPECT_EQ(workspace.GetSystemSize(), 0);
+}
+
+TEST(GeneralizedAlphaWorkspaceTest, WorkspaceViewsAreSizedFromProblemDimensions) {
+    auto workspace = GeneralizedAlphaWorkspace(7, 6, 3);
+
+    EXPECT_EQ(workspace.GetSystemSize(), 9);
+    EXPECT_EQ(workspace.GetGeneralizedCoordinatesNext().extent(0), 7);
+    EXPECT_EQ(workspace.GetVelocity().extent(0), 6);
+    EXPECT_EQ(workspace.GetAcceleration().extent(0), 6);
+    EXPECT_EQ(workspace.GetAlgorithmicAccelerationNext().extent(0), 6);
+    EXPECT_EQ(workspace.GetGeneralizedCoordinatesIncrement().extent(0), 6);
+    EXPECT_EQ(workspace.GetLagrangeMultipliersNext().extent(0), 3);
+    EXPECT_EQ(workspace.GetSolutionIncrements().extent(0), 9);
+}
+
+TEST(GeneralizedAlphaWorkspaceTest, IsSizedForProvidedProblemDimensions) {
+    auto workspace = GeneralizedAlphaWorkspace(7, 6, 3);
+
+    EXPECT_TRUE(workspace.IsSizedFor(7, 6, 3));
+    EXPECT_FALSE(workspace.IsSizedFor(7, 6, 0));
+    EXPECT_FALSE(workspace.IsSizedFor(6, 6, 3));
+    EXPECT_FALSE(workspace.IsSizedFor(7, 5, 3));
+}
+
+TEST(GeneralizedAlphaWorkspaceTest, MatrixFreeWorkspaceHoldsPerturbedStatesInsteadOfMatrix) {
+    auto workspace = GeneralizedAlphaWorkspace(7, 6, 3, true);
+
+    EXPECT_TRUE(workspace.IsMatrixFree());
+    EXPECT_TRUE(workspace.IsSizedFor(7, 6, 3, true));
+    EXPECT_FALSE(workspace.IsSizedFor(7, 6, 3));
+    EXPECT_EQ(workspace.GetIterationMatrix().size(), 0);
+    EXPECT_EQ(workspace.GetPerturbedGeneralizedCoordinates().extent(0), 7);
+    EXPECT_EQ(workspace.GetPerturbedGeneralizedCoordinatesIncrement().extent(0), 6);
+    EXPECT_EQ(workspace.GetPerturbedVelocity().extent(0), 6);
+    EXPECT_EQ(workspace.GetPerturbedAcceleration().extent(0), 6);
+    EXPECT_EQ(workspace.GetPerturbedLagrangeMultipliers().extent(0), 3);
+    EXPECT_EQ(workspace.GetPerturbedResiduals().extent(0), 9);
+    EXPECT_EQ(workspace.GetKrylovVector().extent(0), 9);
+
+    // The default workspace does not hold the perturbed states
+    EXPECT_EQ(GeneralizedAlphaWorkspace(7, 6, 3).GetPerturbedResiduals().extent(0), 0);
+}
+
+TEST(GeneralizedAlphaWorkspaceTest, CopiesOfWorkspaceShareTheSameViews) {
+    auto workspace = GeneralizedAlphaWorkspace(7, 6, 3);
+    auto copy = workspace;
+
+    EXPECT_EQ(copy.GetVelocity().data(), workspace.GetVelocity().data());
+    EXPECT_EQ(copy.GetSolutionIncrements().data(), workspace.GetSolutionIncrements().data());
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
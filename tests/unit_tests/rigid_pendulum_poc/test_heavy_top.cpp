@@ -229,6 +229,231 @@ TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, CalculateIterationMatrix)
     );
 }
 
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, FixedSizeIterationMatrixMatchesViews) {
+    constexpr auto heavy_top = HeavyTop{};
+    const auto gen_coords = Vec<7>{{0., 1., 0., 1., 0., 0., 0.}};
+    const auto delta_gen_coords = Vec<6>{{0., 0., 0., 1., 1., 1.}};
+    const auto velocity = Vec<6>{{0., 0., 0., 0.3, 0.1, 0.8}};
+    const auto acceleration = Vec<6>{};
+    const auto lagrange_mults = Vec<3>{{1., 2., 3.}};
+
+    AllocationCounter counter;
+    auto iteration_matrix = heavy_top.IterationMatrix(
+        0.1, 1., 2., gen_coords, delta_gen_coords, velocity, lagrange_mults
+    );
+    auto residual_vector =
+        heavy_top.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults);
+    EXPECT_EQ(counter.GetNumberOfAllocations(), 0);
+
+    HeavyTopLinearizationParameters heavy_top_lin_params{};
+    auto expected_iteration_matrix = heavy_top_lin_params.IterationMatrix(
+        0.1, 1., 2., to_host_view(gen_coords), to_host_view(delta_gen_coords),
+        to_host_view(velocity), to_host_view(acceleration), to_host_view(lagrange_mults)
+    );
+    auto expected_residual_vector = heavy_top_lin_params.ResidualVector(
+        to_host_view(gen_coords), to_host_view(velocity), to_host_view(acceleration),
+        to_host_view(lagrange_mults)
+    );
+
+    for (size_t i = 0; i < HeavyTop::kSystemSize; ++i) {
+        EXPECT_NEAR(residual_vector(i), expected_residual_vector(i), kTOLERANCE);
+        for (size_t j = 0; j < HeavyTop::kSystemSize; ++j) {
+            EXPECT_NEAR(iteration_matrix(i, j), expected_iteration_matrix(i, j), kTOLERANCE);
+        }
+    }
+    EXPECT_NEAR(iteration_matrix(3, 3), -1.807179, 1e-6);
+    EXPECT_NEAR(iteration_matrix(5, 4), 3.227062, 1e-6);
+}
+
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, FusedLinearizationMatchesSeparateEvaluations) {
+    constexpr auto heavy_top = HeavyTop{};
+    const auto gen_coords = Vec<7>{{0., 1., 0., 1., 0., 0., 0.}};
+    const auto delta_gen_coords = Vec<6>{{1., 2., 3., 4., 5., 6.}};
+    const auto velocity = Vec<6>{{0., 0., 0., 0., 150., -4.61538}};
+    const auto acceleration = Vec<6>{{1., 2., 3., 661.3461692307692, 0., 0.}};
+    const auto lagrange_mults = Vec<3>{{1., 2., 3.}};
+
+    auto residual_vector = Vec<HeavyTop::kSystemSize>{};
+    auto iteration_matrix = Matrix<HeavyTop::kSystemSize, HeavyTop::kSystemSize>{};
+    heavy_top.Linearize(
+        0.1, 1., 2., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults,
+        residual_vector, true, iteration_matrix
+    );
+
+    const auto expected_residual_vector =
+        heavy_top.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults);
+    const auto expected_iteration_matrix = heavy_top.IterationMatrix(
+        0.1, 1., 2., gen_coords, delta_gen_coords, velocity, lagrange_mults
+    );
+
+    // The views of the linearization parameters are written in place
+    HeavyTopLinearizationParameters heavy_top_lin_params{};
+    auto residual_view = HostView1D("residual_vector", HeavyTop::kSystemSize);
+    auto iteration_matrix_view =
+        HostView2D("iteration_matrix", HeavyTop::kSystemSize, HeavyTop::kSystemSize);
+    heavy_top_lin_params.Linearize(
+        0.1, 1., 2., to_host_view(gen_coords), to_host_view(delta_gen_coords),
+        to_host_view(velocity), to_host_view(acceleration), to_host_view(lagrange_mults),
+        residual_view, true, iteration_matrix_view
+    );
+    EXPECT_TRUE(heavy_top_lin_params.IsLinearizeFused());
+
+    for (size_t i = 0; i < HeavyTop::kSystemSize; ++i) {
+        EXPECT_NEAR(residual_vector(i), expected_residual_vector(i), kTOLERANCE);
+        EXPECT_NEAR(residual_view(i), expected_residual_vector(i), kTOLERANCE);
+        for (size_t j = 0; j < HeavyTop::kSystemSize; ++j) {
+            EXPECT_NEAR(iteration_matrix(i, j), expected_iteration_matrix(i, j), kTOLERANCE);
+            EXPECT_NEAR(iteration_matrix_view(i, j), expected_iteration_matrix(i, j), kTOLERANCE);
+        }
+    }
+}
+
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, FusedLinearizationSkipsIterationMatrix) {
+    auto gen_coords = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6.});
+    auto velocity = create_vector({0., 0., 0., 0., 150., -4.61538});
+    auto acceleration = create_vector({0., 0., 0., 661.3461692307692, 0., 0.});
+    auto lagrange_mults = create_vector({1., 2., 3.});
+    auto heavy_top_lin_params = HeavyTopLinearizationParameters();
+
+    auto residual_vector = HostView1D("residual_vector", 9);
+    auto iteration_matrix = HostView2D("iteration_matrix", 9, 9);
+    Kokkos::deep_copy(iteration_matrix, 42.);
+    heavy_top_lin_params.Linearize(
+        0.1, 1., 1., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults,
+        residual_vector, false, iteration_matrix
+    );
+
+    auto expected_residual_vector =
+        heavy_top_lin_params.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults);
+    for (size_t i = 0; i < 9; ++i) {
+        EXPECT_EQ(residual_vector(i), expected_residual_vector(i));
+        for (size_t j = 0; j < 9; ++j) {
+            EXPECT_EQ(iteration_matrix(i, j), 42.);
+        }
+    }
+}
+
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, ExternalLoadsAreReadInPlace) {
+    auto gen_coords = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6.});
+    auto velocity = create_vector({0., 0., 0., 0., 150., -4.61538});
+    auto acceleration = create_vector({0., 0., 0., 661.3461692307692, 0., 0.});
+    auto lagrange_mults = create_vector({1., 2., 3.});
+    auto heavy_top_lin_params = HeavyTopLinearizationParameters();
+    auto expected_residual_vector =
+        heavy_top_lin_params.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults);
+
+    auto external_loads = HostView1D("external_loads", 6);
+    heavy_top_lin_params.SetExternalLoads(external_loads);
+    EXPECT_TRUE(heavy_top_lin_params.HasExternalLoads());
+
+    // Loads written after the registration are applied, i.e. the view is not copied
+    auto residual_vector = HostView1D("residual_vector", 9);
+    auto iteration_matrix = HostView2D("iteration_matrix", 9, 9);
+    for (size_t i = 0; i < 6; ++i) {
+        external_loads(i) = static_cast<double>(i + 1);
+    }
+    heavy_top_lin_params.Linearize(
+        0.1, 1., 1., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults,
+        residual_vector, false, iteration_matrix
+    );
+    const auto residual_view =
+        heavy_top_lin_params.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults);
+    for (size_t i = 0; i < 9; ++i) {
+        const auto load = (i < 6) ? external_loads(i) : 0.;
+        EXPECT_NEAR(residual_vector(i), expected_residual_vector(i) - load, kTOLERANCE);
+        EXPECT_NEAR(residual_view(i), expected_residual_vector(i) - load, kTOLERANCE);
+    }
+
+    EXPECT_THROW(
+        heavy_top_lin_params.SetExternalLoads(HostView1D("external_loads", 3)),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        UnityLinearizationParameters().SetExternalLoads(external_loads), std::runtime_error
+    );
+}
+
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, SparseIterationMatrixMatchesDense) {
+    auto gen_coords = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6.});
+    auto velocity = create_vector({0., 0., 0., 0., 150., -4.61538});
+    auto acceleration = create_vector({0., 0., 0., 661.3461692307692, 0., 0.});
+    auto lagrange_mults = create_vector({1., 2., 3.});
+    auto heavy_top_lin_params = HeavyTopLinearizationParameters();
+
+    auto sparse_iteration_matrix = heavy_top_lin_params.SparseIterationMatrix(
+        0.1, 1., 1., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults
+    );
+    auto iteration_matrix = heavy_top_lin_params.IterationMatrix(
+        0.1, 1., 1., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults
+    );
+
+    // One 6 x 6 block for the body and one 3 x 3 block for the constraints, without any
+    // contribution of the constraints to themselves
+    EXPECT_EQ(sparse_iteration_matrix.GetBlockSizes(), (std::vector<size_t>{6, 3}));
+    EXPECT_EQ(sparse_iteration_matrix.GetNumberOfNonZeroBlocks(), 3);
+    EXPECT_FALSE(sparse_iteration_matrix.HasBlock(1, 1));
+    for (size_t i = 0; i < 9; ++i) {
+        for (size_t j = 0; j < 9; ++j) {
+            EXPECT_EQ(sparse_iteration_matrix(i, j), iteration_matrix(i, j));
+        }
+    }
+}
+
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, ExpectThrowIfOrientationIsNotUnitQuaternion) {
+    auto gen_coords = create_vector({0., 1., 0., 2., 0., 0., 0.});
+    auto velocity = create_vector({0., 0., 0., 0., 0., 0.});
+    auto acceleration = create_vector({0., 0., 0., 0., 0., 0.});
+    auto lagrange_mults = create_vector({0., 0., 0.});
+    HeavyTopLinearizationParameters heavy_top_lin_params{};
+
+    EXPECT_THROW(
+        heavy_top_lin_params.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults),
+        std::invalid_argument
+    );
+}
+
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, InvariantsOfInitialState) {
+    const auto state = create_heavy_top_initial_state();
+    auto invariants = RigidBodyInvariantsView1D<Kokkos::HostSpace>("invariants", 1);
+    auto heavy_top_lin_params = HeavyTopLinearizationParameters();
+    EXPECT_TRUE(heavy_top_lin_params.HasInvariants());
+    heavy_top_lin_params.CalculateInvariants(
+        state.GetGeneralizedCoordinates(), state.GetVelocity(), invariants
+    );
+
+    // The center of mass is at the height of the fixed point, i.e. the energy is kinetic only,
+    // and the angular momentum about the vertical is {x} x m {v} + [J] {W} along z
+    const auto v = 4.61538;
+    EXPECT_NEAR(
+        invariants(0).total_energy,
+        0.5 * 15. * v * v + 0.5 * (0.46875 * 150. * 150. + 0.234375 * v * v), 1e-9
+    );
+    EXPECT_NEAR(invariants(0).angular_momentum, -15. * v - 0.234375 * v, 1e-12);
+    EXPECT_EQ(invariants(0).quaternion_norm_drift, 0.);
+    EXPECT_NEAR(invariants(0).constraint_violation, 0., 1e-15);
+
+    auto too_many = RigidBodyInvariantsView1D<Kokkos::HostSpace>("invariants", 2);
+    EXPECT_THROW(
+        heavy_top_lin_params.CalculateInvariants(
+            state.GetGeneralizedCoordinates(), state.GetVelocity(), too_many
+        ),
+        std::invalid_argument
+    );
+}
+
+TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, RenormalizeQuaternion) {
+    auto gen_coords = Vec<7>{{1., 2., 3., 2., 0., 0., 0.}};
+    EXPECT_EQ(calculate_quaternion_norm_drift(gen_coords), 1.);
+
+    renormalize_quaternion(gen_coords);
+    EXPECT_EQ(calculate_quaternion_norm_drift(gen_coords), 0.);
+    EXPECT_EQ(gen_coords(0), 1.);
+    EXPECT_EQ(gen_coords(3), 1.);
+}
+
 TEST(HeavyTopProblemFromBrulsAndCardona2010PaperTest, CalculateTangentOperatorWithPhiAsZero) {
     auto psi = create_vector({0., 0., 0.});
     HeavyTopLinearizationParameters heavy_top_lin_params{};
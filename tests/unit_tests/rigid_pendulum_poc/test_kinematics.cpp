@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/kinematics.h"
+#include "src/rigid_pendulum_poc/multibody_model.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+// Returns the generalized coordinates of two bodies, the second one rotated by 90 degrees about
+// the z-axis
+HostView1D create_two_body_gen_coords() {
+    const auto c = Kokkos::sqrt(0.5);
+    return create_vector({0., 1., 0., 1., 0., 0., 0., 1., 2., 3., c, 0., 0., c});
+}
+
+template <size_t R, size_t C>
+void expect_matrix_equal(const Matrix<R, C>& actual, const Matrix<R, C>& expected) {
+    for (size_t i = 0; i < R; ++i) {
+        for (size_t j = 0; j < C; ++j) {
+            EXPECT_NEAR(actual(i, j), expected(i, j), 1e-15);
+        }
+    }
+}
+
+TEST(KinematicsTest, RigidBodyKinematicsMatchHeavyTop) {
+    const auto c = Kokkos::sqrt(0.5);
+    const auto gen_coords = Vec<7>{{1., 2., 3., c, 0., 0., c}};
+    const auto psi = Vec<3>{{0.1, 0.2, 0.3}};
+
+    const auto kinematics = RigidBodyKinematics::Calculate(gen_coords, psi);
+
+    expect_matrix_equal(kinematics.rotation_matrix, HeavyTop::CalculateRotationMatrix(gen_coords));
+    expect_matrix_equal(kinematics.rotation_increment_matrix, create_cross_product_matrix(psi));
+    expect_matrix_equal(kinematics.tangent_operator, HeavyTop::TangentOperator(psi));
+}
+
+TEST(KinematicsTest, CacheEvaluatesRepeatedIterateOnce) {
+    const auto gen_coords = create_two_body_gen_coords();
+    const auto delta_gen_coords = create_vector({0., 0., 0., 1., 1., 1., 0., 0., 0., 1., 2., 3.});
+    auto cache = KinematicsCache();
+
+    cache.Update(gen_coords);
+    cache.Update(gen_coords, delta_gen_coords, 0.1);
+    const auto kinematics = cache.Update(gen_coords, delta_gen_coords, 0.1);
+
+    EXPECT_EQ(cache.GetNumberOfRotationEvaluations(), 1);
+    EXPECT_EQ(cache.GetNumberOfTangentEvaluations(), 1);
+    ASSERT_EQ(kinematics.extent(0), 2);
+    expect_matrix_equal(
+        kinematics(1).rotation_matrix,
+        Matrix<3, 3>{{{0., -1., 0.}, {1., 0., 0.}, {0., 0., 1.}}}
+    );
+    expect_matrix_equal(
+        kinematics(1).tangent_operator, HeavyTop::TangentOperator(Vec<3>{{0.1, 0.2, 0.3}})
+    );
+}
+
+TEST(KinematicsTest, CacheReevaluatesCoordinatesChangedThroughViews) {
+    const auto gen_coords = create_two_body_gen_coords();
+    const auto delta_gen_coords = create_vector({0., 0., 0., 1., 1., 1., 0., 0., 0., 1., 2., 3.});
+    auto cache = KinematicsCache();
+    cache.Update(gen_coords, delta_gen_coords, 0.1);
+
+    // A new Newton-Raphson iterate, i.e. both the coordinates and their increment change
+    gen_coords(0) = 2.;
+    cache.Update(gen_coords);
+    EXPECT_EQ(cache.GetNumberOfRotationEvaluations(), 2);
+    EXPECT_EQ(cache.GetNumberOfTangentEvaluations(), 1);
+
+    delta_gen_coords(4) = 2.;
+    cache.Update(gen_coords, delta_gen_coords, 0.1);
+    EXPECT_EQ(cache.GetNumberOfRotationEvaluations(), 2);
+    EXPECT_EQ(cache.GetNumberOfTangentEvaluations(), 2);
+
+    cache.Invalidate();
+    cache.Update(gen_coords);
+    EXPECT_EQ(cache.GetNumberOfRotationEvaluations(), 3);
+}
+
+TEST(KinematicsTest, CopiesOfCacheStartOutEmpty) {
+    auto cache = KinematicsCache();
+    cache.Update(create_two_body_gen_coords());
+
+    auto copy = cache;
+    copy.Update(create_two_body_gen_coords());
+
+    EXPECT_EQ(cache.GetNumberOfRotationEvaluations(), 1);
+    EXPECT_EQ(copy.GetNumberOfRotationEvaluations(), 1);
+}
+
+TEST(KinematicsTest, ExpectThrowIfSizesDoNotMatchRigidBodies) {
+    auto cache = KinematicsCache();
+
+    EXPECT_THROW(cache.Update(create_vector({0., 0., 0., 1., 0., 0.})), std::invalid_argument);
+    EXPECT_THROW(
+        cache.Update(create_two_body_gen_coords(), create_vector({0., 0., 0., 0., 0., 0.}), 0.1),
+        std::invalid_argument
+    );
+}
+
+TEST(KinematicsTest, HeavyTopEvaluatesKinematicsOncePerIterate) {
+    const auto gen_coords = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    const auto delta_gen_coords = create_vector({0., 0., 0., 1., 1., 1.});
+    const auto velocity = create_vector({0., 0., 0., 0.3, 0.1, 0.8});
+    const auto acceleration = create_vector({0., 0., 0., 0., 0., 0.});
+    const auto lagrange_mults = create_vector({1., 2., 3.});
+    auto heavy_top_lin_params = HeavyTopLinearizationParameters();
+
+    heavy_top_lin_params.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults);
+    heavy_top_lin_params.IterationMatrix(
+        0.1, 1., 2., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults
+    );
+
+    const auto& cache = heavy_top_lin_params.GetKinematicsCache();
+    EXPECT_EQ(cache.GetNumberOfRotationEvaluations(), 1);
+    EXPECT_EQ(cache.GetNumberOfTangentEvaluations(), 1);
+}
+
+TEST(KinematicsTest, MultibodyModelSharesKinematicsBetweenResidualAndIterationMatrix) {
+    auto model = MultibodyModel();
+    const auto upper = model.AddRigidBody(RigidBodyElement());
+    const auto lower = model.AddRigidBody(RigidBodyElement());
+    model.AddSphericalJoint(SphericalJointElement(
+        SphericalJointElement::kGround, Vec<3>{}, upper, Vec<3>{{0., -1., 0.}}
+    ));
+    model.AddSphericalJoint(
+        SphericalJointElement(upper, Vec<3>{{0., 1., 0.}}, lower, Vec<3>{{0., -1., 0.}})
+    );
+    const auto gen_coords = create_two_body_gen_coords();
+    const auto delta_gen_coords = HostView1D("delta_gen_coords", 12);
+    const auto velocity = HostView1D("velocity", 12);
+    const auto acceleration = HostView1D("acceleration", 12);
+    const auto lagrange_mults = HostView1D("lagrange_mults", 6);
+
+    model.ResidualVector(gen_coords, velocity, acceleration, lagrange_mults);
+    model.IterationMatrix(
+        0.1, 1., 2., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults
+    );
+    model.SparseIterationMatrix(
+        0.1, 1., 2., gen_coords, delta_gen_coords, velocity, acceleration, lagrange_mults
+    );
+
+    EXPECT_EQ(model.GetKinematicsCache().GetNumberOfRotationEvaluations(), 1);
+    EXPECT_EQ(model.GetKinematicsCache().GetNumberOfTangentEvaluations(), 1);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -1,8 +1,10 @@
+#include <cmath>
 #include <limits>
 
 #include <gtest/gtest.h>
 
 #include "src/rigid_pendulum_poc/solver.h"
+#include "src/utilities/metrics.h"
 #include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
 
 namespace openturbine::rigid_pendulum::tests {
@@ -122,4 +124,481 @@ TEST(LinearSolverTest, Check3x3Matrix2x1VectorCompatibility) {
     );
 }
 
+TEST(DenseLinearSolverTest, FactorizeOnceAndSolveForMultipleRightHandSides) {
+    auto system = create_matrix({{4., 3., 0.}, {3., 4., -1.}, {0., -1., 4.}});
+    auto solver = DenseLinearSolver(3);
+
+    solver.Factorize(system);
+
+    // The provided system is not modified by the factorization
+    expect_kokkos_view_2D_equal(system, {{4., 3., 0.}, {3., 4., -1.}, {0., -1., 4.}});
+
+    auto solution_1 = create_vector({24., 30., -24.});
+    solver.Solve(solution_1);
+    expect_kokkos_view_1D_equal(solution_1, {3., 4., -5.});
+
+    auto solution_2 = create_vector({7., 6., 3.});
+    solver.Solve(solution_2);
+    expect_kokkos_view_1D_equal(solution_2, {1., 1., 1.});
+
+    EXPECT_TRUE(solver.IsFactorized());
+    EXPECT_EQ(solver.GetNumberOfFactorizations(), 1);
+}
+
+TEST(DenseLinearSolverTest, FactorizeResizesSolverForLargerSystems) {
+    auto solver = DenseLinearSolver();
+    EXPECT_EQ(solver.GetSize(), 0);
+
+    solver.Factorize(create_diagonal_matrix({2., 4.}));
+    auto solution = create_vector({1., 1.});
+    solver.Solve(solution);
+
+    EXPECT_EQ(solver.GetSize(), 2);
+    expect_kokkos_view_1D_equal(solution, {0.5, 0.25});
+}
+
+TEST(DenseLinearSolverTest, ExpectThrowIfSolvedBeforeFactorized) {
+    auto solver = DenseLinearSolver(2);
+    auto solution = create_vector({1., 1.});
+
+    EXPECT_THROW(solver.Solve(solution), std::runtime_error);
+
+    solver.Factorize(create_diagonal_matrix({1., 1.}));
+    solver.Invalidate();
+    EXPECT_THROW(solver.Solve(solution), std::runtime_error);
+}
+
+TEST(DenseLinearSolverTest, ExpectThrowIfSystemIsSingularOrSizesDoNotMatch) {
+    auto solver = DenseLinearSolver(2);
+
+    EXPECT_THROW(solver.Factorize(create_matrix({{1., 2.}, {2., 4.}})), std::runtime_error);
+    EXPECT_FALSE(solver.IsFactorized());
+    EXPECT_THROW(solver.Factorize(create_matrix({{1., 2., 3.}})), std::invalid_argument);
+
+    solver.Factorize(create_diagonal_matrix({1., 1.}));
+    auto solution = create_vector({1., 1., 1.});
+    EXPECT_THROW(solver.Solve(solution), std::invalid_argument);
+}
+
+// Returns the n x n Hilbert matrix, whose condition number grows exponentially with n
+HostView2D create_hilbert_matrix(size_t n) {
+    auto matrix = HostView2D("hilbert", n, n);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            matrix(i, j) = 1. / static_cast<double>(i + j + 1);
+        }
+    }
+    return matrix;
+}
+
+TEST(DenseLinearSolverTest, MixedPrecisionRefinesSolutionToDoublePrecision) {
+    // Entries that are not representable in single precision, with a condition number ~500
+    const auto system = create_hilbert_matrix(4);
+    auto solver = DenseLinearSolver(4, FactorizationPrecision::kMIXED);
+    auto expected_solver = DenseLinearSolver(4);
+
+    solver.Factorize(system);
+    expected_solver.Factorize(system);
+    auto solution = create_vector({1., -2., 3., -4.});
+    auto expected = create_vector({1., -2., 3., -4.});
+    solver.Solve(solution);
+    expected_solver.Solve(expected);
+
+    EXPECT_TRUE(solver.IsRefined());
+    EXPECT_GT(solver.GetNumberOfRefinementIterations(), 1);
+    EXPECT_EQ(solver.GetNumberOfFallbacks(), 0);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(solution(i), expected(i), 1e-11 * std::abs(expected(i)));
+    }
+}
+
+TEST(DenseLinearSolverTest, MixedPrecisionFallsBackToDoublePrecisionIfRefinementStalls) {
+    // A condition number ~1e13, i.e. beyond single precision
+    const auto system = create_hilbert_matrix(10);
+    auto solver = DenseLinearSolver(10, FactorizationPrecision::kMIXED);
+    auto expected_solver = DenseLinearSolver(10);
+
+    solver.Factorize(system);
+    expected_solver.Factorize(system);
+    auto solution = HostView1D("solution", 10);
+    auto expected = HostView1D("expected", 10);
+    Kokkos::deep_copy(solution, 1.);
+    Kokkos::deep_copy(expected, 1.);
+    solver.Solve(solution);
+    expected_solver.Solve(expected);
+
+    EXPECT_FALSE(solver.IsRefined());
+    EXPECT_EQ(solver.GetNumberOfFallbacks(), 1);
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(solution(i), expected(i));
+    }
+
+    // The double precision factors are used until the next factorization
+    solver.Solve(solution);
+    EXPECT_EQ(solver.GetNumberOfFallbacks(), 1);
+    solver.Factorize(create_hilbert_matrix(3));
+    EXPECT_TRUE(solver.IsRefined());
+}
+
+TEST(DenseLinearSolverTest, ExpectThrowIfMixedPrecisionHasNoRefinementIterations) {
+    EXPECT_THROW(DenseLinearSolver(2, FactorizationPrecision::kMIXED, 0), std::invalid_argument);
+
+    auto solver = DenseLinearSolver(2, FactorizationPrecision::kMIXED);
+    EXPECT_THROW(solver.Factorize(create_matrix({{1., 2.}, {2., 4.}})), std::runtime_error);
+    EXPECT_FALSE(solver.IsFactorized());
+}
+
+// Creates the saddle point system of a chain of bodies, where every joint constrains three
+// degrees of freedom of two neighboring bodies - all bodies are numbered before the joints
+BlockSparseMatrix create_chain_system(size_t n_bodies) {
+    const auto n_joints = n_bodies - 1;
+    auto block_sizes = std::vector<size_t>(n_bodies, 6);
+    block_sizes.insert(block_sizes.end(), n_joints, 3);
+
+    auto nonzero_blocks = std::vector<std::pair<size_t, size_t>>{};
+    for (size_t body = 0; body < n_bodies; ++body) {
+        nonzero_blocks.emplace_back(body, body);
+    }
+    for (size_t joint = 0; joint < n_joints; ++joint) {
+        for (auto body : {joint, joint + 1}) {
+            nonzero_blocks.emplace_back(body, n_bodies + joint);
+            nonzero_blocks.emplace_back(n_bodies + joint, body);
+        }
+    }
+
+    auto system = BlockSparseMatrix(block_sizes, nonzero_blocks);
+    for (size_t body = 0; body < n_bodies; ++body) {
+        auto block = system.GetBlock(body, body);
+        for (size_t i = 0; i < 6; ++i) {
+            for (size_t j = 0; j < 6; ++j) {
+                block(i, j) = (i == j) ? 10. + static_cast<double>(body) : 0.1 * (i + j);
+            }
+        }
+    }
+    for (size_t joint = 0; joint < n_joints; ++joint) {
+        for (auto [body, sign] : {std::make_pair(joint, 1.), std::make_pair(joint + 1, -1.)}) {
+            auto gradient = system.GetBlock(n_bodies + joint, body);
+            auto gradient_transpose = system.GetBlock(body, n_bodies + joint);
+            for (size_t i = 0; i < 3; ++i) {
+                gradient(i, i) = sign;
+                gradient(i, i + 3) = 0.5 * sign * static_cast<double>(joint + 1);
+                for (size_t j = 0; j < 6; ++j) {
+                    gradient_transpose(j, i) = gradient(i, j);
+                }
+            }
+        }
+    }
+    return system;
+}
+
+TEST(BlockSparseLinearSolverTest, SolveBlockDiagonalSystem) {
+    auto system = BlockSparseMatrix({2, 1}, {{0, 0}, {1, 1}});
+    auto block_1 = system.GetBlock(0, 0);
+    block_1(0, 0) = 2.;
+    block_1(1, 1) = 4.;
+    system.GetBlock(1, 1)(0, 0) = 8.;
+    auto solution = create_vector({2., 2., 2.});
+
+    solve_linear_system(system, solution);
+
+    expect_kokkos_view_1D_equal(solution, {1., 0.5, 0.25});
+}
+
+TEST(BlockSparseLinearSolverTest, SolveMultibodyChainMatchesDenseSolve) {
+    auto system = create_chain_system(20);
+    const auto size = system.GetNumberOfRows();
+    auto solution = HostView1D("solution", size);
+    auto expected_solution = HostView1D("expected_solution", size);
+    for (size_t i = 0; i < size; ++i) {
+        solution(i) = std::sin(static_cast<double>(i));
+        expected_solution(i) = solution(i);
+    }
+    auto dense_system = system.ToDense();
+
+    solve_linear_system(system, solution);
+    solve_linear_system(dense_system, expected_solution);
+
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(solution(i), expected_solution(i), 1e-12);
+    }
+
+    // The provided system is not modified by the solve
+    EXPECT_EQ(system(0, 0), 10.);
+    EXPECT_EQ(system(120, 0), 1.);
+}
+
+TEST(BlockSparseLinearSolverTest, SolveHasZeroDiagonalConstraintBlocks) {
+    // Requires pivoting, the constraint rows have zeros on the diagonal
+    auto system = create_chain_system(2);
+    auto solution = create_vector(std::vector<double>(15, 1.));
+    auto expected_solution = create_vector(std::vector<double>(15, 1.));
+
+    solve_linear_system(system, solution);
+    solve_linear_system(system.ToDense(), expected_solution);
+
+    for (size_t i = 0; i < 15; ++i) {
+        EXPECT_NEAR(solution(i), expected_solution(i), 1e-12);
+    }
+}
+
+TEST(BlockSparseLinearSolverTest, BandedSolverReusesFactorizationForMultipleSolves) {
+    auto system = create_chain_system(10);
+    const auto size = system.GetNumberOfRows();
+    auto solver = BandedLinearSolver();
+    EXPECT_FALSE(solver.IsFactorized());
+
+    solver.Factorize(system);
+    EXPECT_TRUE(solver.IsFactorized());
+    EXPECT_EQ(solver.GetSize(), size);
+
+    for (auto scale : {1., -3.}) {
+        auto solution = HostView1D("solution", size);
+        auto expected_solution = HostView1D("expected_solution", size);
+        for (size_t i = 0; i < size; ++i) {
+            solution(i) = scale * std::cos(static_cast<double>(i));
+            expected_solution(i) = solution(i);
+        }
+
+        solver.Solve(solution);
+        solve_linear_system(system.ToDense(), expected_solution);
+
+        for (size_t i = 0; i < size; ++i) {
+            EXPECT_NEAR(solution(i), expected_solution(i), 1e-12);
+        }
+    }
+    EXPECT_EQ(solver.GetNumberOfFactorizations(), 1);
+
+    solver.Invalidate();
+    auto solution = HostView1D("solution", size);
+    EXPECT_THROW(solver.Solve(solution), std::runtime_error);
+}
+
+TEST(BlockSparseLinearSolverTest, ExpectThrowIfSystemIsSingularOrSizesDoNotMatch) {
+    auto singular_system = BlockSparseMatrix({2, 2}, {{0, 0}});
+    auto solution = create_vector({1., 1., 1., 1.});
+
+    EXPECT_THROW(solve_linear_system(singular_system, solution), std::runtime_error);
+
+    auto system = create_chain_system(2);
+    EXPECT_THROW(solve_linear_system(system, solution), std::invalid_argument);
+}
+
+// Returns a nonsymmetric saddle point system of 4 unknowns and 2 constraints, whose multiplier
+// gradient is the transposed constraint gradient scaled by two, as if preconditioned
+HostView2D create_saddle_point_system() {
+    return create_matrix({
+        {4., 1., 0., 2., 2., 0.},    // row 1
+        {-1., 5., 1., 0., 0., 2.},   // row 2
+        {0., 2., 6., 1., 4., -2.},   // row 3
+        {1., 0., -1., 3., -2., 6.},  // row 4
+        {1., 0., 2., -1., 0., 0.},   // row 5
+        {0., 1., -1., 3., 0., 0.}    // row 6
+    });
+}
+
+TEST(NullSpaceReductionTest, SolveReducedSystemMatchesSaddlePointSolve) {
+    auto reduction = NullSpaceReduction(4, 2);
+    EXPECT_EQ(reduction.GetNumberOfUnknowns(), 4);
+    EXPECT_EQ(reduction.GetNumberOfConstraints(), 2);
+    EXPECT_EQ(reduction.GetReducedSize(), 2);
+
+    const auto system = create_saddle_point_system();
+    auto solver = DenseLinearSolver(2);
+    solver.Factorize(reduction.Reduce(system));
+
+    auto solution = create_vector({1., -2., 3., -4., 0.5, 1.5});
+    auto expected = create_vector({1., -2., 3., -4., 0.5, 1.5});
+    solve_linear_system(create_saddle_point_system(), expected);
+
+    auto reduced_solution = reduction.ReduceRightHandSide(solution);
+    solver.Solve(reduced_solution);
+    reduction.Recover(reduced_solution, solution);
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(solution(i), expected(i), 1e-12);
+    }
+}
+
+TEST(NullSpaceReductionTest, IterationsDoNotAllocate) {
+    auto reduction = NullSpaceReduction(4, 2);
+    auto solver = DenseLinearSolver(2);
+    const auto system = create_saddle_point_system();
+    auto solution = create_vector({1., -2., 3., -4., 0.5, 1.5});
+
+    auto& registry = util::MetricsRegistry::Get();
+    registry.EnableAllocationTracking();
+    auto& allocations = registry.GetCounter("openturbine_kokkos_allocations_total");
+    const auto n_allocations = allocations.GetValue();
+
+    // The reduction, solve and recovery of each Newton-Raphson iteration
+    for (size_t iteration = 0; iteration < 3; ++iteration) {
+        solver.Factorize(reduction.Reduce(system));
+        auto reduced_solution = reduction.ReduceRightHandSide(solution);
+        solver.Solve(reduced_solution);
+        reduction.Recover(reduced_solution, solution);
+    }
+    Kokkos::Tools::Experimental::set_allocate_data_callback(nullptr);
+
+    EXPECT_EQ(allocations.GetValue(), n_allocations);
+}
+
+TEST(NullSpaceReductionTest, UnconstrainedSystemIsNotReduced) {
+    auto reduction = NullSpaceReduction(2, 0);
+    const auto reduced = reduction.Reduce(create_matrix({{2., 1.}, {0., 3.}}));
+    expect_kokkos_view_2D_equal(reduced, {{2., 1.}, {0., 3.}});
+
+    auto solution = create_vector({4., 3.});
+    auto reduced_solution = reduction.ReduceRightHandSide(solution);
+    solve_linear_system(create_matrix({{2., 1.}, {0., 3.}}), reduced_solution);
+    reduction.Recover(reduced_solution, solution);
+    expect_kokkos_view_1D_equal(solution, {1.5, 1.});
+}
+
+TEST(NullSpaceReductionTest, ExpectThrowIfSystemIsNotAReducibleSaddlePointSystem) {
+    EXPECT_THROW(NullSpaceReduction(2, 3), std::invalid_argument);
+
+    auto reduction = NullSpaceReduction(4, 2);
+    EXPECT_THROW(reduction.Reduce(create_diagonal_matrix({1., 1., 1.})), std::invalid_argument);
+
+    auto penalized = create_saddle_point_system();
+    penalized(5, 5) = 1.;
+    EXPECT_THROW(reduction.Reduce(penalized), std::invalid_argument);
+
+    // Redundant constraints, i.e. a rank deficient constraint gradient
+    auto redundant = create_saddle_point_system();
+    for (size_t j = 0; j < 4; ++j) {
+        redundant(5, j) = 2. * redundant(4, j);
+    }
+    EXPECT_THROW(reduction.Reduce(redundant), std::runtime_error);
+}
+
+TEST(BroydenUpdateTest, UpdatedInverseSatisfiesTheSecantCondition) {
+    // The initial inverse is the identity, i.e. solving with its factors does nothing
+    const auto solve = [](HostView1D) {};
+    auto update = BroydenUpdate(3, 2);
+    EXPECT_EQ(update.GetSize(), 3);
+    EXPECT_EQ(update.GetMaximumNumberOfUpdates(), 2);
+    EXPECT_FALSE(update.HasStep());
+    EXPECT_THROW(update.Update(1., create_vector({0., 0., 0.}), solve), std::runtime_error);
+
+    // A step of -0.5 times the increments changes the residual vector by {y}
+    update.Record(create_vector({1., 2., 3.}), create_vector({2., 0., -2.}));
+    EXPECT_TRUE(update.Update(0.5, create_vector({3., 1., 3.}), solve));
+    EXPECT_EQ(update.GetNumberOfUpdates(), 1);
+
+    auto change = create_vector({2., -1., 0.});
+    update.Apply(change);
+    expect_kokkos_view_1D_equal(change, {-1., 0., 1.});
+
+    // A zero change of the residual vector is degenerate
+    update.Record(create_vector({3., 1., 3.}), create_vector({1., 1., 1.}));
+    EXPECT_FALSE(update.Update(1., create_vector({3., 1., 3.}), solve));
+    EXPECT_EQ(update.GetNumberOfUpdates(), 1);
+
+    update.Reset();
+    EXPECT_EQ(update.GetNumberOfUpdates(), 0);
+    EXPECT_FALSE(update.HasStep());
+}
+
+// Returns the linear operator of the provided dense matrix
+LinearOperator create_dense_operator(const HostView2D matrix) {
+    return [matrix](const HostView1D vector, HostView1D product) {
+        for (size_t i = 0; i < matrix.extent(0); ++i) {
+            product(i) = 0.;
+            for (size_t j = 0; j < matrix.extent(1); ++j) {
+                product(i) += matrix(i, j) * vector(j);
+            }
+        }
+    };
+}
+
+// Returns a nonsymmetric, diagonally dominant system with badly scaled rows
+HostView2D create_nonsymmetric_system(size_t size) {
+    auto system = HostView2D("system", size, size);
+    for (size_t i = 0; i < size; ++i) {
+        const auto scale = std::pow(10., static_cast<double>(i % 4));
+        for (size_t j = 0; j < size; ++j) {
+            system(i, j) = scale * (i == j ? 4. : 1. / (1. + i + 2. * j));
+        }
+    }
+    return system;
+}
+
+TEST(GMRESSolverTest, SolveNonsymmetricSystemWithRestartsMatchesDenseSolve) {
+    const size_t size = 20;
+    auto system = create_nonsymmetric_system(size);
+    auto solution = create_vector(std::vector<double>(size, 1.));
+    auto expected_solution = create_vector(std::vector<double>(size, 1.));
+    solve_linear_system(create_nonsymmetric_system(size), expected_solution);
+
+    // Fewer iterations between restarts than the size of the system
+    auto solver = GMRESSolver(size, 5, 500, 1e-13);
+    EXPECT_TRUE(solver.Solve(create_dense_operator(system), solution));
+
+    EXPECT_GT(solver.GetNumberOfIterations(), 5);
+    EXPECT_LE(solver.GetRelativeResidualNorm(), 1e-13);
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(solution(i), expected_solution(i), 1e-10);
+    }
+}
+
+TEST(GMRESSolverTest, RightPreconditionerReducesNumberOfIterations) {
+    const size_t size = 20;
+    auto system = create_nonsymmetric_system(size);
+    auto jacobi_preconditioner = [system](const HostView1D vector, HostView1D product) {
+        for (size_t i = 0; i < vector.extent(0); ++i) {
+            product(i) = vector(i) / system(i, i);
+        }
+    };
+
+    auto solve = [&](const LinearOperator& preconditioner) {
+        auto solution = create_vector(std::vector<double>(size, 1.));
+        auto solver = GMRESSolver(size, 30, 100, 1e-12);
+        EXPECT_TRUE(solver.Solve(create_dense_operator(system), solution, preconditioner));
+        return std::make_tuple(solution, solver.GetNumberOfIterations());
+    };
+
+    auto [solution, n_iterations] = solve({});
+    auto [preconditioned_solution, n_preconditioned_iterations] = solve(jacobi_preconditioner);
+
+    EXPECT_LT(n_preconditioned_iterations, n_iterations);
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(preconditioned_solution(i), solution(i), 1e-10);
+    }
+}
+
+TEST(GMRESSolverTest, SolveZeroRightHandSideWithoutIterations) {
+    auto solution = create_vector({0., 0., 0.});
+    auto solver = GMRESSolver(3);
+
+    EXPECT_TRUE(solver.Solve(create_dense_operator(create_diagonal_matrix({1., 2., 3.})), solution));
+
+    EXPECT_EQ(solver.GetNumberOfIterations(), 0);
+    expect_kokkos_view_1D_equal(solution, {0., 0., 0.});
+}
+
+TEST(GMRESSolverTest, ReportIfToleranceIsNotReached) {
+    const size_t size = 20;
+    auto solution = create_vector(std::vector<double>(size, 1.));
+    auto solver = GMRESSolver(size, 2, 2, 1e-12);
+
+    EXPECT_FALSE(solver.Solve(create_dense_operator(create_nonsymmetric_system(size)), solution));
+
+    EXPECT_EQ(solver.GetNumberOfIterations(), 2);
+    EXPECT_EQ(solver.GetTotalNumberOfIterations(), 2);
+    EXPECT_GT(solver.GetRelativeResidualNorm(), 1e-12);
+}
+
+TEST(GMRESSolverTest, ExpectThrowIfParametersAreInvalidOrSizesDoNotMatch) {
+    EXPECT_THROW(GMRESSolver(3, 0), std::invalid_argument);
+    EXPECT_THROW(GMRESSolver(3, 3, 0), std::invalid_argument);
+    EXPECT_THROW(GMRESSolver(3, 3, 3, 0.), std::invalid_argument);
+
+    auto solver = GMRESSolver(3);
+    auto solution = create_vector({1., 1.});
+    EXPECT_THROW(
+        solver.Solve(create_dense_operator(create_diagonal_matrix({1., 2.})), solution),
+        std::invalid_argument
+    );
+}
+
 }  // namespace openturbine::rigid_pendulum::tests
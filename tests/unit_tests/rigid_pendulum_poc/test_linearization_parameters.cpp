@@ -56,4 +56,26 @@ TEST(UnityLinearizationParametersTest, IterationMatrix) {
     );
 }
 
+TEST(UnityLinearizationParametersTest, LinearizeWritesResidualVectorAndIterationMatrix) {
+    auto gen_coords = create_vector({1., 2., 3., 4., 5., 6., 7.});
+    auto v = create_vector({1., 2., 3., 4., 5., 6.});
+    auto lagrange_mults = create_vector({1., 2., 3.});
+    auto residual_vector = HostView1D("residual_vector", 9);
+    auto iteration_matrix = HostView2D("iteration_matrix", 9, 9);
+
+    UnityLinearizationParameters unity_linearization_parameters;
+    EXPECT_FALSE(unity_linearization_parameters.IsLinearizeFused());
+
+    unity_linearization_parameters.Linearize(
+        1., 1., 1., gen_coords, v, v, v, lagrange_mults, residual_vector, true, iteration_matrix
+    );
+
+    for (size_t i = 0; i < 9; ++i) {
+        EXPECT_EQ(residual_vector(i), 1.);
+        for (size_t j = 0; j < 9; ++j) {
+            EXPECT_EQ(iteration_matrix(i, j), i == j ? 1. : 0.);
+        }
+    }
+}
+
 }  // namespace openturbine::rigid_pendulum::tests
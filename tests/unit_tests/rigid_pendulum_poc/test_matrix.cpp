@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/matrix.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(FixedSizeMatrixTest, DefaultConstructedMatrixAndVectorAreNull) {
+    constexpr auto m = Matrix<2, 3>{};
+    constexpr auto v = Vec<4>{};
+
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_EQ(m(i, j), 0.);
+        }
+    }
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(v(i), 0.);
+    }
+}
+
+TEST(FixedSizeMatrixTest, OperationsAreEvaluatedAtCompileTime) {
+    constexpr auto m = Matrix<2, 2>{{{1., 2.}, {3., 4.}}};
+    constexpr auto v = Vec<2>{{1., -1.}};
+
+    static_assert((m * v)(0) == -1.);
+    static_assert((m * v)(1) == -1.);
+    static_assert((m * Matrix<2, 2>::Identity())(1, 0) == 3.);
+    static_assert(m.GetTranspose()(0, 1) == 3.);
+    static_assert(v.DotProduct(v) == 2.);
+}
+
+TEST(FixedSizeMatrixTest, MultiplyMatrixWithMatrix) {
+    auto m1 = Matrix<2, 3>{{{1., 2., 3.}, {4., 5., 6.}}};
+    auto m2 = Matrix<3, 2>{{{1., 2.}, {3., 4.}, {5., 6.}}};
+
+    auto result = m1 * m2;
+
+    expect_kokkos_view_2D_equal(to_host_view(result), {{22., 28.}, {49., 64.}});
+}
+
+TEST(FixedSizeMatrixTest, AddSubtractAndScaleMatrices) {
+    auto m1 = Matrix<2, 2>{{{1., 2.}, {3., 4.}}};
+    auto m2 = Matrix<2, 2>{{{4., 3.}, {2., 1.}}};
+
+    expect_kokkos_view_2D_equal(to_host_view(m1 + m2), {{5., 5.}, {5., 5.}});
+    expect_kokkos_view_2D_equal(to_host_view(m1 - m2), {{-3., -1.}, {1., 3.}});
+    expect_kokkos_view_2D_equal(to_host_view(2. * m1), {{2., 4.}, {6., 8.}});
+    expect_kokkos_view_2D_equal(to_host_view(-m1), {{-1., -2.}, {-3., -4.}});
+}
+
+TEST(FixedSizeMatrixTest, GetAndSetBlocks) {
+    auto m = Matrix<3, 3>{{{1., 2., 3.}, {4., 5., 6.}, {7., 8., 9.}}};
+
+    expect_kokkos_view_2D_equal(to_host_view(m.GetBlock<2, 2>(1, 1)), {{5., 6.}, {8., 9.}});
+
+    m.SetBlock(0, 1, Matrix<2, 2>::Identity());
+    expect_kokkos_view_2D_equal(to_host_view(m), {{1., 1., 0.}, {4., 0., 1.}, {7., 8., 9.}});
+}
+
+TEST(FixedSizeMatrixTest, VectorOperations) {
+    auto v1 = Vec<3>{{1., 2., 3.}};
+    auto v2 = Vec<3>{{4., 5., 6.}};
+
+    expect_kokkos_view_1D_equal(to_host_view(v1 + v2), {5., 7., 9.});
+    expect_kokkos_view_1D_equal(to_host_view(v1 - v2), {-3., -3., -3.});
+    expect_kokkos_view_1D_equal(to_host_view(v1 * 2.), {2., 4., 6.});
+    expect_kokkos_view_1D_equal(to_host_view(v1.CrossProduct(v2)), {-3., 6., -3.});
+    EXPECT_EQ(v1.DotProduct(v2), 32.);
+    EXPECT_NEAR((Vec<2>{{3., 4.}}.Length()), 5., kTOLERANCE);
+}
+
+TEST(FixedSizeMatrixTest, GetAndSetSegments) {
+    auto v = Vec<5>{{1., 2., 3., 4., 5.}};
+
+    expect_kokkos_view_1D_equal(to_host_view(v.GetSegment<3>(2)), {3., 4., 5.});
+
+    v.SetSegment(0, Vec<2>{{-1., -2.}});
+    expect_kokkos_view_1D_equal(to_host_view(v), {-1., -2., 3., 4., 5.});
+}
+
+TEST(FixedSizeMatrixTest, CrossProductMatrixMatchesViewVersion) {
+    auto v = Vec<3>{{1., 2., 3.}};
+
+    expect_kokkos_view_2D_equal(
+        to_host_view(create_cross_product_matrix(v)), {{0., -3., 2.}, {3., 0., -1.}, {-2., 1., 0.}}
+    );
+}
+
+TEST(FixedSizeMatrixTest, ConvertFromAndToHostViews) {
+    auto view = create_vector({1., 2., 3., 4.});
+    auto matrix_view = create_matrix({{1., 2.}, {3., 4.}});
+
+    expect_kokkos_view_1D_equal(to_host_view(to_vec<2>(view, 2)), {3., 4.});
+    expect_kokkos_view_2D_equal(to_host_view(to_matrix<2, 2>(matrix_view)), {{1., 2.}, {3., 4.}});
+}
+
+TEST(FixedSizeMatrixTest, ExpectThrowIfViewDoesNotMatchFixedSize) {
+    auto view = create_vector({1., 2., 3.});
+    auto matrix_view = create_matrix({{1., 2.}, {3., 4.}});
+
+    EXPECT_THROW(to_vec<4>(view), std::invalid_argument);
+    EXPECT_THROW(to_vec<3>(view, 1), std::invalid_argument);
+    EXPECT_THROW((to_matrix<3, 2>(matrix_view)), std::invalid_argument);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
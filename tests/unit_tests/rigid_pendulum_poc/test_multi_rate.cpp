@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/multi_rate.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+// Returns a heavy top group with the provided number of sub-steps per macro time step
+SubsystemGroup create_heavy_top_group(size_t n_substeps) {
+    return SubsystemGroup{
+        std::make_shared<HeavyTopLinearizationParameters>(), create_heavy_top_initial_state(), 3,
+        n_substeps};
+}
+
+GeneralizedAlphaTimeIntegrator create_macro_integrator(double time_step, size_t n_steps) {
+    return GeneralizedAlphaTimeIntegrator(
+        0.5, 0.5, 0.25, 0.5, TimeStepper(0., time_step, n_steps, 10), true
+    );
+}
+
+void expect_states_near(const State& actual, const State& expected) {
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            actual.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-12
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(actual.GetVelocity()(i), expected.GetVelocity()(i), 1e-12);
+    }
+}
+
+TEST(MultiRateIntegratorTest, UncoupledGroupsMatchSingleRateIntegrations) {
+    auto integrator = MultiRateIntegrator(
+        create_macro_integrator(0.004, 10), {create_heavy_top_group(1), create_heavy_top_group(4)}
+    );
+    EXPECT_EQ(integrator.GetNumberOfGroups(), 2);
+    EXPECT_DOUBLE_EQ(integrator.GetTimeStep(0), 0.004);
+    EXPECT_DOUBLE_EQ(integrator.GetTimeStep(1), 0.001);
+
+    const auto results = integrator.Integrate();
+    ASSERT_EQ(results.size(), 2);
+    ASSERT_EQ(results[0].size(), 11);
+    ASSERT_EQ(results[1].size(), 11);
+
+    auto slow_problem = HeavyTopLinearizationParameters();
+    const auto slow = create_macro_integrator(0.004, 10).Integrate(
+        create_heavy_top_initial_state(), 3, slow_problem
+    );
+    auto fast_problem = HeavyTopLinearizationParameters();
+    const auto fast = create_macro_integrator(0.001, 40).Integrate(
+        create_heavy_top_initial_state(), 3, fast_problem
+    );
+    for (size_t step = 0; step <= 10; ++step) {
+        expect_states_near(results[0][step], slow[step]);
+        expect_states_near(results[1][step], fast[4 * step]);
+    }
+}
+
+TEST(MultiRateIntegratorTest, FastGroupsSeeInterpolatedStatesOfSlowGroups) {
+    struct Evaluation {
+        size_t group;
+        double time;
+        std::vector<State> states;
+    };
+    auto evaluations = std::vector<Evaluation>{};
+    const auto coupling = [&evaluations](
+                              size_t group, double time, const std::vector<State>& states,
+                              HostView1D loads
+                          ) {
+        evaluations.push_back({group, time, states});
+        Kokkos::deep_copy(loads, 0.);
+    };
+
+    auto integrator = MultiRateIntegrator(
+        create_macro_integrator(0.004, 3), {create_heavy_top_group(4), create_heavy_top_group(1)},
+        coupling
+    );
+    const auto results = integrator.Integrate();
+
+    // The slow group advances first with the fast group held at the start of the macro step,
+    // then the fast group sees the slow group interpolated to the end of every sub-step
+    ASSERT_EQ(evaluations.size(), 3 * 5);
+    for (size_t step = 0; step < 3; ++step) {
+        const auto& slow = evaluations[5 * step];
+        EXPECT_EQ(slow.group, 1);
+        EXPECT_NEAR(slow.time, 0.004 * static_cast<double>(step + 1), 1e-12);
+        expect_states_near(slow.states[0], results[0][step]);
+
+        for (size_t substep = 1; substep <= 4; ++substep) {
+            const auto& fast = evaluations[5 * step + substep];
+            const auto fraction = 0.25 * static_cast<double>(substep);
+            EXPECT_EQ(fast.group, 0);
+            EXPECT_NEAR(fast.time, 0.004 * (static_cast<double>(step) + fraction), 1e-12);
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(
+                    fast.states[1].GetGeneralizedCoordinates()(i),
+                    (1. - fraction) * results[1][step].GetGeneralizedCoordinates()(i) +
+                        fraction * results[1][step + 1].GetGeneralizedCoordinates()(i),
+                    1e-12
+                );
+            }
+        }
+    }
+}
+
+TEST(MultiRateIntegratorTest, SubCycledGroupsSeeTheirOwnStateOfEverySubStep) {
+    // Loads that damp the velocities of the group itself, i.e. that follow its sub-steps
+    auto interface_states = std::vector<State>{};
+    auto loads_history = std::vector<std::vector<double>>{};
+    const auto coupling = [&](size_t group, double, const std::vector<State>& states,
+                              HostView1D loads) {
+        interface_states.push_back(states[group]);
+        loads_history.emplace_back();
+        for (size_t i = 0; i < loads.extent(0); ++i) {
+            loads(i) = -0.1 * states[group].GetVelocity()(i);
+            loads_history.back().push_back(loads(i));
+        }
+    };
+
+    auto integrator = MultiRateIntegrator(
+        create_macro_integrator(0.004, 2), {create_heavy_top_group(4)}, coupling
+    );
+    const auto results = integrator.Integrate();
+
+    // The first sub-step starts from the state of the macro step, and every later one from the
+    // state of the previous sub-step, i.e. the loads change from one sub-step to the next
+    ASSERT_EQ(loads_history.size(), 2 * 4);
+    for (size_t step = 0; step < 2; ++step) {
+        expect_states_near(interface_states[4 * step], results[0][step]);
+        for (size_t substep = 1; substep < 4; ++substep) {
+            const auto& loads = loads_history[4 * step + substep];
+            const auto& previous_loads = loads_history[4 * step + substep - 1];
+            auto change = 0.;
+            for (size_t i = 0; i < loads.size(); ++i) {
+                change = std::max(change, std::abs(loads[i] - previous_loads[i]));
+            }
+            EXPECT_GT(change, 1e-6);
+        }
+    }
+}
+
+TEST(MultiRateIntegratorTest, ThrowOnInvalidGroups) {
+    const auto macro_integrator = create_macro_integrator(0.004, 3);
+    EXPECT_THROW(MultiRateIntegrator(macro_integrator, {}), std::invalid_argument);
+    EXPECT_THROW(
+        MultiRateIntegrator(macro_integrator, {create_heavy_top_group(0)}), std::invalid_argument
+    );
+
+    // Coupled problems must support external loads
+    const auto coupling = [](size_t, double, const std::vector<State>&, HostView1D) {};
+    auto group = create_heavy_top_group(1);
+    group.problem = std::make_shared<UnityLinearizationParameters>();
+    EXPECT_THROW(MultiRateIntegrator(macro_integrator, {group}, coupling), std::runtime_error);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/multibody_model.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+// Returns a double pendulum, i.e. two bodies of length 2 hanging along the y-axis from the
+// origin, with the joints at the ends of the bodies
+std::shared_ptr<MultibodyModel> create_double_pendulum_model() {
+    auto model = std::make_shared<MultibodyModel>();
+    const auto upper = model->AddRigidBody(RigidBodyElement(1., Vec<3>{{0.1, 0.01, 0.1}}));
+    const auto lower = model->AddRigidBody(RigidBodyElement(2., Vec<3>{{0.2, 0.02, 0.2}}));
+    model->AddSphericalJoint(SphericalJointElement(
+        SphericalJointElement::kGround, Vec<3>{}, upper, Vec<3>{{0., -1., 0.}}
+    ));
+    model->AddSphericalJoint(
+        SphericalJointElement(upper, Vec<3>{{0., 1., 0.}}, lower, Vec<3>{{0., -1., 0.}})
+    );
+    return model;
+}
+
+// Returns the initial state of the double pendulum, swinging about the x-axis
+State create_double_pendulum_initial_state() {
+    return State(
+        create_vector({0., 1., 0., 1., 0., 0., 0., 0., 3., 0., 1., 0., 0., 0.}),
+        create_vector({0., 0., 1., 1., 0., 0., 0., 0., 3., 1., 0., 0.}),
+        create_vector({0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.}),
+        create_vector({0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0., 0.})
+    );
+}
+
+TEST(MultibodyModelTest, CountElementsAndDegreesOfFreedom) {
+    auto model = create_double_pendulum_model();
+
+    EXPECT_EQ(model->GetNumberOfBodies(), 2);
+    EXPECT_EQ(model->GetNumberOfJoints(), 2);
+    EXPECT_EQ(model->GetNumberOfGeneralizedCoordinates(), 14);
+    EXPECT_EQ(model->GetNumberOfVelocities(), 12);
+    EXPECT_EQ(model->GetNumberOfConstraints(), 6);
+}
+
+TEST(MultibodyModelTest, HeavyTopModelMatchesHeavyTopLinearizationParameters) {
+    auto model = create_heavy_top_model();
+    auto heavy_top = HeavyTopLinearizationParameters();
+    const auto state = create_heavy_top_initial_state();
+    const auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6.});
+    const auto lagrange_mults = create_vector({1., 2., 3.});
+
+    const auto residuals = model->ResidualVector(
+        state.GetGeneralizedCoordinates(), state.GetVelocity(), state.GetAcceleration(),
+        lagrange_mults
+    );
+    const auto expected_residuals = heavy_top.ResidualVector(
+        state.GetGeneralizedCoordinates(), state.GetVelocity(), state.GetAcceleration(),
+        lagrange_mults
+    );
+    const auto iteration_matrix = model->IterationMatrix(
+        0.1, 2., 3., state.GetGeneralizedCoordinates(), delta_gen_coords, state.GetVelocity(),
+        state.GetAcceleration(), lagrange_mults
+    );
+    const auto expected_iteration_matrix = heavy_top.IterationMatrix(
+        0.1, 2., 3., state.GetGeneralizedCoordinates(), delta_gen_coords, state.GetVelocity(),
+        state.GetAcceleration(), lagrange_mults
+    );
+
+    for (size_t i = 0; i < HeavyTop::kSystemSize; ++i) {
+        EXPECT_NEAR(residuals(i), expected_residuals(i), 1e-12);
+        for (size_t j = 0; j < HeavyTop::kSystemSize; ++j) {
+            EXPECT_NEAR(iteration_matrix(i, j), expected_iteration_matrix(i, j), 1e-12);
+        }
+    }
+}
+
+TEST(MultibodyModelTest, IntegrateHeavyTopModel) {
+    auto integrate = [](std::shared_ptr<LinearizationParameters> linearization_parameters) {
+        auto time_integrator = GeneralizedAlphaTimeIntegrator(
+            0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.002, 20, 10), true
+        );
+        auto results = time_integrator.Integrate(
+            create_heavy_top_initial_state(), 3, linearization_parameters
+        );
+        EXPECT_TRUE(time_integrator.IsConverged());
+        return results.back();
+    };
+
+    const auto state = integrate(create_heavy_top_model());
+    const auto expected = integrate(std::make_shared<HeavyTopLinearizationParameters>());
+
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            state.GetGeneralizedCoordinates()(i), expected.GetGeneralizedCoordinates()(i), 1e-10
+        );
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), expected.GetVelocity()(i), 1e-8);
+    }
+}
+
+TEST(MultibodyModelTest, IntegrateDoublePendulumKeepsJointsTogether) {
+    auto model = create_double_pendulum_model();
+    auto time_integrator = GeneralizedAlphaTimeIntegrator(
+        0.375, 0.125, 0.390625, 0.75, TimeStepper(0., 0.005, 50, 20), true
+    );
+
+    auto results =
+        time_integrator.Integrate(create_double_pendulum_initial_state(), 6, model);
+    EXPECT_TRUE(time_integrator.IsConverged());
+
+    // Both joints are still in place, i.e. the constraint residuals vanish
+    const auto& state = results.back();
+    const auto residuals = model->ResidualVector(
+        state.GetGeneralizedCoordinates(), state.GetVelocity(), state.GetAcceleration(),
+        HostView1D("lagrange_mults", 6)
+    );
+    for (size_t i = 12; i < 18; ++i) {
+        EXPECT_NEAR(residuals(i), 0., 1e-10);
+    }
+
+    // The lower body moved, i.e. the pendulum swung
+    EXPECT_GT(std::abs(state.GetGeneralizedCoordinates()(9)), 0.1);
+}
+
+TEST(MultibodyModelTest, SparseIterationMatrixMatchesDenseIterationMatrix) {
+    auto model = create_double_pendulum_model();
+    const auto state = create_double_pendulum_initial_state();
+    const auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6., 6., 5., 4., 3., 2., 1.});
+    const auto lagrange_mults = create_vector({1., 2., 3., 4., 5., 6.});
+
+    const auto dense = model->IterationMatrix(
+        0.1, 2., 3., state.GetGeneralizedCoordinates(), delta_gen_coords, state.GetVelocity(),
+        state.GetAcceleration(), lagrange_mults
+    );
+    const auto sparse = model->SparseIterationMatrix(
+        0.1, 2., 3., state.GetGeneralizedCoordinates(), delta_gen_coords, state.GetVelocity(),
+        state.GetAcceleration(), lagrange_mults
+    );
+
+    // Two body blocks, the ground joint couples one body and the other joint both bodies
+    EXPECT_EQ(sparse.GetNumberOfNonZeroBlocks(), 8);
+    EXPECT_FALSE(sparse.HasBlock(0, 1));
+    EXPECT_FALSE(sparse.HasBlock(1, 2));
+    for (size_t i = 0; i < 18; ++i) {
+        for (size_t j = 0; j < 18; ++j) {
+            EXPECT_NEAR(sparse(i, j), dense(i, j), 1e-14);
+        }
+    }
+}
+
+TEST(MultibodyModelTest, JacobianVectorProductMatchesIterationMatrix) {
+    auto model = create_double_pendulum_model();
+    const auto state = create_double_pendulum_initial_state();
+    const auto delta_gen_coords = create_vector({1., 2., 3., 4., 5., 6., 6., 5., 4., 3., 2., 1.});
+    const auto lagrange_mults = create_vector({1., 2., 3., 4., 5., 6.});
+    const auto vector = create_vector(
+        {1., -1., 2., -2., 3., -3., 4., -4., 5., -5., 6., -6., 1., 2., 3., 4., 5., 6.}
+    );
+    auto product = HostView1D("product", 18);
+
+    EXPECT_TRUE(model->HasJacobianVectorProduct());
+    model->JacobianVectorProduct(
+        0.1, 2., 3., state.GetGeneralizedCoordinates(), delta_gen_coords, state.GetVelocity(),
+        state.GetAcceleration(), lagrange_mults, vector, product
+    );
+
+    const auto iteration_matrix = model->IterationMatrix(
+        0.1, 2., 3., state.GetGeneralizedCoordinates(), delta_gen_coords, state.GetVelocity(),
+        state.GetAcceleration(), lagrange_mults
+    );
+    for (size_t i = 0; i < 18; ++i) {
+        auto expected = 0.;
+        for (size_t j = 0; j < 18; ++j) {
+            expected += iteration_matrix(i, j) * vector(j);
+        }
+        EXPECT_NEAR(product(i), expected, 1e-12);
+    }
+}
+
+TEST(MultibodyModelTest, ExpectThrowIfJointBodiesAreInvalid) {
+    auto model = MultibodyModel();
+    model.AddRigidBody(RigidBodyElement());
+
+    EXPECT_THROW(
+        model.AddSphericalJoint(SphericalJointElement(SphericalJointElement::kGround, {}, 1, {})),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        model.AddSphericalJoint(SphericalJointElement(0, {}, 0, {})), std::invalid_argument
+    );
+}
+
+TEST(MultibodyModelTest, ExpectThrowIfSizesDoNotMatchModel) {
+    auto model = create_double_pendulum_model();
+    const auto state = create_heavy_top_initial_state();
+
+    EXPECT_THROW(
+        model->ResidualVector(
+            state.GetGeneralizedCoordinates(), state.GetVelocity(), state.GetAcceleration(),
+            create_vector({1., 2., 3.})
+        ),
+        std::invalid_argument
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/parareal.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+// Returns a numerically damped integrator, i.e. with a spectral radius at infinity of 0.5, of
+// 80 time steps of the heavy top released at rest from the horizontal
+GeneralizedAlphaTimeIntegrator create_damped_integrator() {
+    const auto rho_inf = 0.5;
+    const auto alpha_m = (2. * rho_inf - 1.) / (rho_inf + 1.);
+    const auto alpha_f = rho_inf / (rho_inf + 1.);
+    const auto gamma = 0.5 + alpha_f - alpha_m;
+    const auto beta = 0.25 * (gamma + 0.5) * (gamma + 0.5);
+    return GeneralizedAlphaTimeIntegrator(
+        alpha_f, alpha_m, beta, gamma, TimeStepper(0., 0.01, 80, 10), true
+    );
+}
+
+State create_released_state() {
+    return State(
+        create_vector({0., 1., 0., 1., 0., 0., 0.}), create_vector({0., 0., 0., 0., 0., 0.}),
+        create_vector({0., 0., 0., 0., 0., 0.}), create_vector({0., 0., 0., 0., 0., 0.})
+    );
+}
+
+std::shared_ptr<LinearizationParameters> create_heavy_top() {
+    return std::make_shared<HeavyTopLinearizationParameters>();
+}
+
+// Returns the largest difference of the velocities of the slice states from the sequential
+// states at the slice boundaries
+double max_velocity_error(
+    const PararealResult& result, const std::vector<State>& sequential, size_t steps_per_slice
+) {
+    auto error = 0.;
+    for (size_t slice = 0; slice < result.states.size(); ++slice) {
+        const auto velocity = result.states[slice].GetVelocity();
+        const auto reference = sequential[slice * steps_per_slice].GetVelocity();
+        for (size_t i = 0; i < velocity.extent(0); ++i) {
+            error = std::max(error, std::abs(velocity(i) - reference(i)));
+        }
+    }
+    return error;
+}
+
+TEST(PararealIntegratorTest, ReproduceSequentialIntegrationAfterAllSlicesAreExact) {
+    auto fine_integrator = create_damped_integrator();
+    auto problem = HeavyTopLinearizationParameters();
+    const auto sequential = fine_integrator.Integrate(create_released_state(), 3, problem);
+
+    const auto parareal = PararealIntegrator(fine_integrator, PararealPolicy{8, 2, 10, 0., 4});
+    const auto result = parareal.Integrate(create_released_state(), 3, create_heavy_top);
+
+    EXPECT_EQ(result.n_iterations, 8);
+    EXPECT_TRUE(result.is_converged);
+    ASSERT_EQ(result.states.size(), 9);
+    EXPECT_LT(max_velocity_error(result, sequential, 10), 1e-10);
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(
+            result.states.back().GetGeneralizedCoordinates()(i),
+            sequential.back().GetGeneralizedCoordinates()(i), 1e-10
+        );
+    }
+}
+
+TEST(PararealIntegratorTest, IterationsConvergeToSequentialIntegration) {
+    auto fine_integrator = create_damped_integrator();
+    auto problem = HeavyTopLinearizationParameters();
+    const auto sequential = fine_integrator.Integrate(create_released_state(), 3, problem);
+
+    auto errors = std::vector<double>{};
+    for (size_t n_iterations = 1; n_iterations <= 4; ++n_iterations) {
+        const auto parareal =
+            PararealIntegrator(fine_integrator, PararealPolicy{8, 5, n_iterations, 0., 4});
+        const auto result = parareal.Integrate(create_released_state(), 3, create_heavy_top);
+        EXPECT_EQ(result.n_iterations, n_iterations);
+        EXPECT_FALSE(result.is_converged);
+        errors.push_back(max_velocity_error(result, sequential, 10));
+    }
+    for (size_t i = 1; i < errors.size(); ++i) {
+        EXPECT_LT(errors[i], errors[i - 1]);
+    }
+    EXPECT_LT(errors.back(), 0.1 * errors.front());
+}
+
+TEST(PararealIntegratorTest, StopOnceTheCorrectionsAreBelowTheTolerance) {
+    const auto parareal =
+        PararealIntegrator(create_damped_integrator(), PararealPolicy{8, 5, 8, 1e-3, 4});
+    const auto result = parareal.Integrate(create_released_state(), 3, create_heavy_top);
+
+    EXPECT_TRUE(result.is_converged);
+    EXPECT_LT(result.n_iterations, 8);
+    ASSERT_EQ(result.corrections.size(), result.n_iterations);
+    EXPECT_LT(result.corrections.back(), 1e-3);
+}
+
+TEST(PararealIntegratorTest, ThreadsDoNotChangeTheResult) {
+    const auto serial =
+        PararealIntegrator(create_damped_integrator(), PararealPolicy{8, 5, 3, 0., 1})
+            .Integrate(create_released_state(), 3, create_heavy_top);
+    const auto threaded =
+        PararealIntegrator(create_damped_integrator(), PararealPolicy{8, 5, 3, 0., 8})
+            .Integrate(create_released_state(), 3, create_heavy_top);
+
+    ASSERT_EQ(serial.states.size(), threaded.states.size());
+    for (size_t slice = 0; slice < serial.states.size(); ++slice) {
+        for (size_t i = 0; i < 7; ++i) {
+            EXPECT_EQ(
+                serial.states[slice].GetGeneralizedCoordinates()(i),
+                threaded.states[slice].GetGeneralizedCoordinates()(i)
+            );
+        }
+    }
+}
+
+TEST(PararealIntegratorTest, ThrowOnInvalidPolicy) {
+    EXPECT_THROW(
+        PararealIntegrator(create_damped_integrator(), PararealPolicy{0, 1, 5, 0., 1}),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        PararealIntegrator(create_damped_integrator(), PararealPolicy{8, 0, 5, 0., 1}),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        PararealIntegrator(create_damped_integrator(), PararealPolicy{7, 1, 5, 0., 1}),
+        std::invalid_argument
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
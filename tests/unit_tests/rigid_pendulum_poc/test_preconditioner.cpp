@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/preconditioner.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(DiagonalPreconditionerTest, DefaultPreconditionerIsIdentity) {
+    auto preconditioner = DiagonalPreconditioner(2);
+    auto matrix = create_matrix({{1., 2.}, {3., 4.}});
+    auto rhs = create_vector({5., 6.});
+
+    preconditioner.ApplyToMatrix(matrix);
+    preconditioner.ApplyToRightHandSide(rhs);
+    preconditioner.ApplyToSolution(rhs);
+
+    EXPECT_EQ(preconditioner.GetSize(), 2);
+    expect_kokkos_view_2D_equal(matrix, {{1., 2.}, {3., 4.}});
+    expect_kokkos_view_1D_equal(rhs, {5., 6.});
+}
+
+TEST(DiagonalPreconditionerTest, ScaleRowsAndColumnsOfMatrixInPlace) {
+    auto preconditioner =
+        DiagonalPreconditioner(create_vector({2., 3., 1.}), create_vector({1., 10., 100.}));
+    auto matrix = create_matrix({{1., 1., 1.}, {1., 2., 3.}, {4., 5., 6.}});
+    const auto data = matrix.data();
+
+    preconditioner.ApplyToMatrix(matrix);
+
+    EXPECT_EQ(matrix.data(), data);
+    expect_kokkos_view_2D_equal(matrix, {{2., 20., 200.}, {3., 60., 900.}, {4., 50., 600.}});
+}
+
+TEST(DiagonalPreconditionerTest, ScaleStoredBlocksOfBlockSparseMatrixInPlace) {
+    auto preconditioner =
+        DiagonalPreconditioner(create_vector({2., 3., 1.}), create_vector({1., 10., 100.}));
+    auto matrix = BlockSparseMatrix::FromDense(
+        create_matrix({{1., 1., 0.}, {1., 2., 3.}, {0., 5., 6.}}), {1, 2}
+    );
+
+    preconditioner.ApplyToMatrix(matrix);
+
+    EXPECT_EQ(matrix.GetNumberOfNonZeroBlocks(), 4);
+    expect_kokkos_view_2D_equal(
+        matrix.ToDense(), {{2., 20., 0.}, {3., 60., 900.}, {0., 50., 600.}}
+    );
+}
+
+TEST(DiagonalPreconditionerTest, ScaleRightHandSideAndSolution) {
+    auto preconditioner =
+        DiagonalPreconditioner(create_vector({2., 3., 1.}), create_vector({1., 10., 100.}));
+    auto vector = create_vector({1., 1., 1.});
+
+    preconditioner.ApplyToRightHandSide(vector);
+    expect_kokkos_view_1D_equal(vector, {2., 3., 1.});
+
+    preconditioner.ApplyToSolution(vector);
+    expect_kokkos_view_1D_equal(vector, {2., 30., 100.});
+}
+
+TEST(DiagonalPreconditionerTest, ApplyingPreconditionerDoesNotAllocate) {
+    auto preconditioner = create_bottasso_preconditioner(6, 3, 0.25, 0.1);
+    auto matrix = create_identity_matrix(9);
+    auto vector = create_identity_vector(9);
+
+    AllocationCounter counter;
+    preconditioner.ApplyToMatrix(matrix);
+    preconditioner.ApplyToRightHandSide(vector);
+    preconditioner.ApplyToSolution(vector);
+    EXPECT_EQ(counter.GetNumberOfAllocations(), 0);
+}
+
+TEST(DiagonalPreconditionerTest, CreateBottassoPreconditioner) {
+    const auto beta = 0.25;
+    const auto h = 0.1;
+    auto preconditioner = create_bottasso_preconditioner(2, 1, beta, h);
+
+    expect_kokkos_view_1D_equal(
+        preconditioner.GetLeftScaling(), {beta * h * h, beta * h * h, 1.}, 1e-15
+    );
+    expect_kokkos_view_1D_equal(
+        preconditioner.GetRightScaling(), {1., 1., 1. / (beta * h * h)}, 1e-12
+    );
+}
+
+TEST(DiagonalPreconditionerTest, ExpectThrowIfSizesDoNotMatch) {
+    EXPECT_THROW(
+        DiagonalPreconditioner(create_vector({1., 2.}), create_vector({1.})),
+        std::invalid_argument
+    );
+
+    auto preconditioner = DiagonalPreconditioner(2);
+    auto matrix = create_identity_matrix(3);
+    auto vector = create_vector({1.});
+
+    EXPECT_THROW(preconditioner.ApplyToMatrix(matrix), std::invalid_argument);
+    EXPECT_THROW(preconditioner.ApplyToRightHandSide(vector), std::invalid_argument);
+    EXPECT_THROW(preconditioner.ApplyToSolution(vector), std::invalid_argument);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/quaternion_array.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+using HostQuaternionArray = QuaternionArray<Kokkos::HostSpace>;
+using HostVectorArray = VectorArray<Kokkos::HostSpace>;
+
+// Returns a few rotation vectors, including a null and a very small one
+std::vector<Vector> create_rotation_vectors() {
+    return {
+        Vector(0., 0., 0.),       Vector(1e-6, -2e-6, 3e-7), Vector(0.1, 0.2, 0.3),
+        Vector(-1.2, 0.4, 0.7),   Vector(0., 0., 3.),        Vector(2., -1., 0.5),
+    };
+}
+
+void expect_quaternion_equal(const Quaternion& actual, const Quaternion& expected) {
+    EXPECT_NEAR(actual.GetScalarComponent(), expected.GetScalarComponent(), kTOLERANCE);
+    EXPECT_NEAR(actual.GetXComponent(), expected.GetXComponent(), kTOLERANCE);
+    EXPECT_NEAR(actual.GetYComponent(), expected.GetYComponent(), kTOLERANCE);
+    EXPECT_NEAR(actual.GetZComponent(), expected.GetZComponent(), kTOLERANCE);
+}
+
+void expect_vector_equal(const Vector& actual, const Vector& expected) {
+    EXPECT_NEAR(actual.GetXComponent(), expected.GetXComponent(), kTOLERANCE);
+    EXPECT_NEAR(actual.GetYComponent(), expected.GetYComponent(), kTOLERANCE);
+    EXPECT_NEAR(actual.GetZComponent(), expected.GetZComponent(), kTOLERANCE);
+}
+
+TEST(QuaternionArrayTest, CreateArraysWithStructOfArraysLayout) {
+    auto quaternions = HostQuaternionArray(5);
+    auto vectors = HostVectorArray(5);
+
+    EXPECT_EQ(quaternions.GetSize(), 5);
+    EXPECT_EQ(quaternions.GetComponents().extent(0), 4);
+    EXPECT_EQ(vectors.GetSize(), 5);
+    EXPECT_EQ(vectors.GetComponents().extent(0), 3);
+
+    // A given component of all entries is contiguous in memory
+    auto components = quaternions.GetComponents();
+    EXPECT_EQ(&components(0, 4) + 1, &components(1, 0));
+}
+
+TEST(QuaternionArrayTest, SetAndGetEntries) {
+    auto quaternions = HostQuaternionArray(3);
+    auto vectors = HostVectorArray(3);
+
+    quaternions.SetQuaternion(1, Quaternion(1., 2., 3., 4.));
+    vectors.SetVector(2, Vector(5., 6., 7.));
+
+    EXPECT_EQ(quaternions.GetQuaternion(1).GetComponents(), std::make_tuple(1., 2., 3., 4.));
+    EXPECT_EQ(quaternions.GetComponents()(2, 1), 3.);
+    EXPECT_EQ(quaternions.GetQuaternion(0).GetComponents(), std::make_tuple(0., 0., 0., 0.));
+    EXPECT_EQ(vectors.GetVector(2).GetComponents(), std::make_tuple(5., 6., 7.));
+}
+
+TEST(QuaternionArrayTest, ExpectThrowIfIndexIsOutOfRange) {
+    auto quaternions = HostQuaternionArray(2);
+    auto vectors = HostVectorArray(2);
+
+    EXPECT_THROW(quaternions.SetQuaternion(2, Quaternion()), std::out_of_range);
+    EXPECT_THROW(quaternions.GetQuaternion(2), std::out_of_range);
+    EXPECT_THROW(vectors.SetVector(2, Vector()), std::out_of_range);
+    EXPECT_THROW(vectors.GetVector(2), std::out_of_range);
+}
+
+TEST(QuaternionArrayTest, ComposeQuaternionsMatchesQuaternionProduct) {
+    const auto rotation_vectors = create_rotation_vectors();
+    const auto n = rotation_vectors.size();
+    auto a = HostQuaternionArray(n);
+    auto b = HostQuaternionArray(n);
+    for (size_t i = 0; i < n; ++i) {
+        a.SetQuaternion(i, quaternion_from_rotation_vector(rotation_vectors[i]));
+        b.SetQuaternion(i, quaternion_from_rotation_vector(rotation_vectors[n - 1 - i]));
+    }
+    auto result = HostQuaternionArray(n);
+
+    compose_quaternions<Kokkos::DefaultHostExecutionSpace>(a, b, result);
+
+    for (size_t i = 0; i < n; ++i) {
+        expect_quaternion_equal(result.GetQuaternion(i), a.GetQuaternion(i) * b.GetQuaternion(i));
+    }
+}
+
+TEST(QuaternionArrayTest, RotateVectorsMatchesRotateVector) {
+    const auto rotation_vectors = create_rotation_vectors();
+    const auto n = rotation_vectors.size();
+    auto quaternions = HostQuaternionArray(n);
+    auto vectors = HostVectorArray(n);
+    for (size_t i = 0; i < n; ++i) {
+        quaternions.SetQuaternion(i, quaternion_from_rotation_vector(rotation_vectors[i]));
+        vectors.SetVector(i, Vector(1., -2., 0.5 * i));
+    }
+    auto result = HostVectorArray(n);
+
+    rotate_vectors<Kokkos::DefaultHostExecutionSpace>(quaternions, vectors, result);
+
+    for (size_t i = 0; i < n; ++i) {
+        expect_vector_equal(
+            result.GetVector(i),
+            rotate_vector(quaternions.GetQuaternion(i), vectors.GetVector(i))
+        );
+    }
+}
+
+TEST(QuaternionArrayTest, ExponentialAndLogarithmicMapsMatchScalarVersions) {
+    const auto rotation_vectors = create_rotation_vectors();
+    const auto n = rotation_vectors.size();
+    auto vectors = HostVectorArray(n);
+    for (size_t i = 0; i < n; ++i) {
+        vectors.SetVector(i, rotation_vectors[i]);
+    }
+    auto quaternions = HostQuaternionArray(n);
+    auto result = HostVectorArray(n);
+
+    quaternions_from_rotation_vectors<Kokkos::DefaultHostExecutionSpace>(vectors, quaternions);
+    rotation_vectors_from_quaternions<Kokkos::DefaultHostExecutionSpace>(quaternions, result);
+
+    for (size_t i = 0; i < n; ++i) {
+        expect_quaternion_equal(
+            quaternions.GetQuaternion(i), quaternion_from_rotation_vector(rotation_vectors[i])
+        );
+        // The maps are the inverse of one another, also for small rotations
+        expect_vector_equal(result.GetVector(i), rotation_vectors[i]);
+    }
+}
+
+TEST(QuaternionArrayTest, ExponentialMapsMatchTheirScalarCounterpart) {
+    const auto rotation_vectors = create_rotation_vectors();
+    const auto n = rotation_vectors.size();
+    auto vectors = HostVectorArray(n);
+    for (size_t i = 0; i < n; ++i) {
+        vectors.SetVector(i, rotation_vectors[i]);
+    }
+    auto quaternions = HostQuaternionArray(n);
+    auto tangent_operators = HostView3D("tangent_operators", 3, 3, n);
+
+    exponential_maps<Kokkos::DefaultHostExecutionSpace>(vectors, quaternions, tangent_operators);
+
+    for (size_t i = 0; i < n; ++i) {
+        const auto [x, y, z] = rotation_vectors[i].GetComponents();
+        const auto expected = ExponentialMap::Calculate(Vec<3>{{x, y, z}});
+        expect_quaternion_equal(quaternions.GetQuaternion(i), expected.quaternion);
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t k = 0; k < 3; ++k) {
+                EXPECT_NEAR(tangent_operators(j, k, i), expected.tangent_operator(j, k), 1e-15);
+            }
+        }
+    }
+
+    EXPECT_THROW(
+        exponential_maps<Kokkos::DefaultHostExecutionSpace>(
+            vectors, quaternions, HostView3D("tangent_operators", 3, 3, n - 1)
+        ),
+        std::invalid_argument
+    );
+}
+
+TEST(QuaternionArrayTest, ExpectThrowIfArraySizesDoNotMatch) {
+    auto quaternions = HostQuaternionArray(2);
+    auto other_quaternions = HostQuaternionArray(3);
+    auto vectors = HostVectorArray(3);
+
+    EXPECT_THROW(
+        compose_quaternions<Kokkos::DefaultHostExecutionSpace>(
+            quaternions, other_quaternions, quaternions
+        ),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        rotate_vectors<Kokkos::DefaultHostExecutionSpace>(quaternions, vectors, vectors),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        quaternions_from_rotation_vectors<Kokkos::DefaultHostExecutionSpace>(vectors, quaternions),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        rotation_vectors_from_quaternions<Kokkos::DefaultHostExecutionSpace>(quaternions, vectors),
+        std::invalid_argument
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
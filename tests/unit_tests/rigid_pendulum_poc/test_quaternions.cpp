@@ -1,5 +1,10 @@
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
 #include <gtest/gtest.h>
 
+#include "src/rigid_pendulum_poc/kinematics.h"
 #include "src/rigid_pendulum_poc/quaternion.h"
 #include "src/rigid_pendulum_poc/utilities.h"
 #include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
@@ -20,6 +25,40 @@ TEST(QuaternionTest, ConstructorWithProvidedComponents) {
     ASSERT_EQ(q.GetComponents(), expected);
 }
 
+TEST(QuaternionTest, ConstexprConstructionAndArithmetic) {
+    constexpr auto q = Quaternion(1., 2., 3., 4.) * Quaternion(1., 0., 0., 0.).GetConjugate();
+    static_assert(q.GetScalarComponent() == 1.);
+    static_assert(q.GetZComponent() == 4.);
+    static_assert(std::is_trivially_copyable_v<Quaternion>);
+}
+
+TEST(QuaternionTest, UseQuaternionsInsideOfKernel) {
+    const auto rotation_vector = Vector(0.1, -0.2, 0.3);
+    auto rotated = HostView2D("rotated", 2, 3);
+
+    Kokkos::parallel_for(
+        "rotate_vectors", Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, 2),
+        KOKKOS_LAMBDA(const size_t i) {
+            const auto q = quaternion_from_rotation_vector(rotation_vector * static_cast<double>(i));
+            const auto v = rotate_vector(q, Vector(1., 2., 3.));
+            rotated(i, 0) = v.GetXComponent();
+            rotated(i, 1) = v.GetYComponent();
+            rotated(i, 2) = v.GetZComponent();
+        }
+    );
+
+    const auto q = quaternion_from_rotation_vector(rotation_vector);
+    const auto [x, y, z] = rotate_vector(q, {1., 2., 3.}).GetComponents();
+    expect_kokkos_view_2D_equal(rotated, {{1., 2., 3.}, {x, y, z}});
+}
+
+TEST(QuaternionTest, ConvertMatrixToQuaternion) {
+    constexpr auto identity = Matrix<3, 3>::Identity();
+    const auto q = rotation_matrix_to_quaternion(identity);
+
+    ASSERT_EQ(q.GetComponents(), std::make_tuple(1., 0., 0., 0.));
+}
+
 TEST(QuaternionTest, GetIndividualComponents) {
     Quaternion q(1., 2., 3., 4.);
 
@@ -201,6 +240,46 @@ TEST(QuaternionTest, GetQuaternionFromNullRotationVector) {
     ASSERT_NEAR(q.GetZComponent(), expected.GetZComponent(), 1e-6);
 }
 
+TEST(QuaternionTest, ExponentialMapCoefficientsAreContinuousAtSmallAngles) {
+    // The series below the small angle threshold and the closed forms above it agree - the
+    // closed forms cancel for small angles, i.e. are only accurate to eps / angle^2 there
+    for (const auto angle : {1e-3, 0.05, 0.141, 0.142, 0.3, 2.}) {
+        const auto c = calculate_exponential_map_coefficients(angle * angle);
+        const auto tolerance = std::max(1e-13, 1e-15 / (angle * angle));
+        EXPECT_NEAR(c.cos_half_angle, std::cos(0.5 * angle), 1e-15);
+        EXPECT_NEAR(c.vector_factor, std::sin(0.5 * angle) / angle, 1e-15);
+        EXPECT_NEAR(c.cos_coefficient, (std::cos(angle) - 1.) / (angle * angle), tolerance);
+        EXPECT_NEAR(
+            c.sin_coefficient, (angle - std::sin(angle)) / (angle * angle * angle), tolerance
+        );
+    }
+
+    const auto c = calculate_exponential_map_coefficients(0.);
+    EXPECT_EQ(c.cos_half_angle, 1.);
+    EXPECT_EQ(c.vector_factor, 0.5);
+    EXPECT_EQ(c.cos_coefficient, -0.5);
+    EXPECT_EQ(c.sin_coefficient, 1. / 6.);
+}
+
+TEST(QuaternionTest, ExponentialMapMatchesQuaternionAndTangentOperator) {
+    for (const auto& psi : {Vec<3>{{0., 0., 0.}}, Vec<3>{{1e-5, 2e-5, -3e-5}},
+                            Vec<3>{{0.01, -0.02, 0.05}}, Vec<3>{{1., 2., 3.}}}) {
+        const auto exponential_map = ExponentialMap::Calculate(psi);
+
+        const auto q = quaternion_from_rotation_vector(Vector{psi(0), psi(1), psi(2)});
+        EXPECT_EQ(exponential_map.quaternion.GetComponents(), q.GetComponents());
+        const auto tangent_operator =
+            calculate_tangent_operator(psi, create_cross_product_matrix(psi));
+        for (size_t i = 0; i < 3; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                EXPECT_NEAR(
+                    exponential_map.tangent_operator(i, j), tangent_operator(i + 3, j + 3), 1e-15
+                );
+            }
+        }
+    }
+}
+
 TEST(QuaternionTest, GetRotationVectorFromNullQuaternion) {
     Quaternion q(1., 0., 0., 0.);
     auto v = rotation_vector_from_quaternion(q);
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "src/rigid_pendulum_poc/state_history.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(StateHistoryTest, StoreEverySampleInOneRowOfTheArena) {
+    auto history = StateHistory(1, 1, 4);
+    const auto records = std::vector<TimeStepRecord>{
+        create_time_step_record(0), create_time_step_record(1), create_time_step_record(2)};
+
+    // The arena is preallocated, i.e. storing the samples does not allocate
+    AllocationCounter counter;
+    for (const auto& record : records) {
+        history.Observe(record);
+    }
+    EXPECT_EQ(counter.GetNumberOfAllocations(), 0);
+
+    ASSERT_EQ(history.GetNumberOfSamples(), 3);
+    EXPECT_EQ(history.GetCapacity(), 4);
+    EXPECT_EQ(history.GetStep(2), 2);
+    EXPECT_EQ(history.GetTime(2), 0.2);
+    expect_kokkos_view_1D_equal(history.GetState(2).GetVelocity(), {20.});
+    expect_kokkos_view_1D_equal(history.GetState(2).GetAlgorithmicAcceleration(), {60.});
+    expect_kokkos_view_2D_equal(
+        history.GetSamples(),
+        {{0., 0., 0., 0., 0.}, {0.1, 1., 10., 20., 30.}, {0.2, 2., 20., 40., 60.}}
+    );
+}
+
+TEST(StateHistoryTest, SampleEveryStrideTimeStepsIncludingTheInitialState) {
+    auto history = StateHistory(1, 1, StateHistory::RequiredCapacity(10, 4), 4);
+    for (size_t step = 0; step <= 10; ++step) {
+        history.Observe(create_time_step_record(step));
+    }
+
+    ASSERT_EQ(history.GetNumberOfSamples(), 3);
+    EXPECT_EQ(history.GetCapacity(), 3);
+    EXPECT_EQ(history.GetStep(0), 0);
+    EXPECT_EQ(history.GetStep(1), 4);
+    EXPECT_EQ(history.GetStep(2), 8);
+}
+
+TEST(StateHistoryTest, RingBufferKeepsTheLatestSamplesInOrder) {
+    auto history = StateHistory(1, 1, 3, 1, StateHistoryMode::kRING_BUFFER);
+    for (size_t step = 0; step < 8; ++step) {
+        history.Observe(create_time_step_record(step));
+    }
+
+    ASSERT_EQ(history.GetNumberOfSamples(), 3);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(history.GetStep(i), 5 + i);
+        expect_kokkos_view_1D_equal(
+            history.GetState(i).GetGeneralizedCoordinates(), {static_cast<double>(5 + i)}
+        );
+    }
+
+    // Exporting orders the rows of the arena, which later samples continue from
+    auto samples = history.GetSamples();
+    expect_kokkos_view_2D_equal(
+        samples,
+        {{0.5, 5., 50., 100., 150.}, {0.6, 6., 60., 120., 180.}, {0.7, 7., 70., 140., 210.}}
+    );
+    history.Observe(create_time_step_record(8));
+    EXPECT_EQ(history.GetStep(0), 6);
+    EXPECT_EQ(history.GetStep(2), 8);
+    EXPECT_EQ(history.GetSamples()(2, 1), 8.);
+}
+
+TEST(StateHistoryTest, StoreSampledStatesOfHeavyTopIntegration) {
+    auto heavy_top = HeavyTopLinearizationParameters();
+    auto reference_integrator = GeneralizedAlphaTimeIntegrator(
+        0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 10, 10), true
+    );
+    const auto reference =
+        reference_integrator.Integrate(create_heavy_top_initial_state(), 3, heavy_top);
+
+    auto time_integrator = GeneralizedAlphaTimeIntegrator(
+        0.5, 0.5, 0.25, 0.5, TimeStepper(0., 0.002, 10, 10), true
+    );
+    auto history = StateHistory(7, 6, StateHistory::RequiredCapacity(10, 5), 5);
+    time_integrator.Integrate(create_heavy_top_initial_state(), 3, heavy_top, history);
+
+    ASSERT_EQ(history.GetNumberOfSamples(), 3);
+    const auto samples = history.GetSamples();
+    EXPECT_EQ(samples.extent(1), 26);
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& expected = reference[5 * i];
+        for (size_t j = 0; j < 7; ++j) {
+            EXPECT_EQ(
+                samples(i, history.GetGeneralizedCoordinatesColumn() + j),
+                expected.GetGeneralizedCoordinates()(j)
+            );
+        }
+        for (size_t j = 0; j < 6; ++j) {
+            EXPECT_EQ(
+                samples(i, history.GetAccelerationColumn() + j), expected.GetAcceleration()(j)
+            );
+        }
+    }
+}
+
+TEST(StateHistoryTest, ExpectThrowIfHistoryIsFullOrInvalid) {
+    auto history = StateHistory(1, 1, 2);
+    history.Observe(create_time_step_record(0));
+    history.Observe(create_time_step_record(1));
+
+    EXPECT_THROW(history.Observe(create_time_step_record(2)), std::runtime_error);
+    EXPECT_THROW(history.GetState(2), std::out_of_range);
+    EXPECT_THROW(StateHistory(2, 1, 2).Observe(create_time_step_record(0)), std::invalid_argument);
+    EXPECT_THROW(StateHistory(1, 1, 0), std::invalid_argument);
+    EXPECT_THROW(StateHistory(1, 1, 2, 0), std::invalid_argument);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/state_observer.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(StateHistoryObserverTest, StoreStatesOfAllTimeSteps) {
+    auto observer = StateHistoryObserver();
+    for (size_t step = 0; step < 4; ++step) {
+        observer.Observe(create_time_step_record(step));
+    }
+
+    ASSERT_EQ(observer.GetStates().size(), 4);
+    expect_kokkos_view_1D_equal(observer.GetStates()[2].GetVelocity(), {20.});
+}
+
+TEST(RingBufferObserverTest, KeepOnlyTheLatestRecordsInOrder) {
+    auto observer = RingBufferObserver(3);
+    observer.Observe(create_time_step_record(0));
+    observer.Observe(create_time_step_record(1));
+
+    auto records = observer.GetRecords();
+    ASSERT_EQ(records.size(), 2);
+    EXPECT_EQ(records[0].step, 0);
+    EXPECT_EQ(records[1].step, 1);
+
+    for (size_t step = 2; step < 8; ++step) {
+        observer.Observe(create_time_step_record(step));
+    }
+
+    records = observer.GetRecords();
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(observer.GetCapacity(), 3);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQ(records[i].step, 5 + i);
+        EXPECT_EQ(records[i].time, 0.1 * static_cast<double>(5 + i));
+        expect_kokkos_view_1D_equal(records[i].lagrange_mults, {-static_cast<double>(5 + i)});
+    }
+}
+
+TEST(DecimatingObserverTest, ForwardEveryKthTimeStepAndFinalize) {
+    auto steps = std::vector<size_t>{};
+    auto is_finalized = false;
+    auto sink = std::make_shared<CallbackObserver>(
+        [&steps](const TimeStepRecord& record) { steps.push_back(record.step); },
+        [&is_finalized]() { is_finalized = true; }
+    );
+    auto observer = DecimatingObserver(sink, 3);
+
+    for (size_t step = 0; step < 8; ++step) {
+        observer.Observe(create_time_step_record(step));
+    }
+    observer.Finalize();
+
+    EXPECT_EQ(observer.GetDecimation(), 3);
+    EXPECT_EQ(steps, (std::vector<size_t>{0, 3, 6}));
+    EXPECT_TRUE(is_finalized);
+}
+
+TEST(CallbackObserverTest, FinalizeWithoutCallbackDoesNothing) {
+    size_t n_observed{0};
+    auto observer = CallbackObserver([&n_observed](const TimeStepRecord&) { n_observed++; });
+
+    observer.Observe(create_time_step_record(0));
+    observer.Finalize();
+
+    EXPECT_EQ(n_observed, 1);
+}
+
+TEST(StateObserverTest, ExpectThrowIfObserverParametersAreInvalid) {
+    EXPECT_THROW(RingBufferObserver(0), std::invalid_argument);
+    EXPECT_THROW(DecimatingObserver(nullptr, 1), std::invalid_argument);
+    EXPECT_THROW(
+        DecimatingObserver(std::make_shared<StateHistoryObserver>(), 0), std::invalid_argument
+    );
+    EXPECT_THROW(CallbackObserver(nullptr), std::invalid_argument);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/time_step_controller.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(TimeStepControllerTest, GrowTimeStepIfErrorIsSmall) {
+    auto policy = AdaptiveTimeStepPolicy{};
+    policy.is_adaptive = true;
+    policy.max_time_step = 0.15;
+    auto controller = TimeStepController(policy);
+
+    auto decision = controller.Evaluate(0.1, 0.001, 3, true);
+    EXPECT_TRUE(decision.is_accepted);
+    EXPECT_EQ(decision.next_time_step, 0.15);
+
+    decision = controller.Evaluate(0.01, 0.001, 3, true);
+    EXPECT_TRUE(decision.is_accepted);
+    EXPECT_NEAR(decision.next_time_step, 0.02, 1e-15);
+
+    // The next time step is sized for the error to meet the tolerance, i.e. error ~ h^3
+    decision = controller.Evaluate(0.01, 0.5, 3, true);
+    EXPECT_TRUE(decision.is_accepted);
+    EXPECT_NEAR(decision.next_time_step, 0.01 * 0.9 * std::pow(0.5, -1. / 3.), 1e-15);
+}
+
+TEST(TimeStepControllerTest, RejectAndShrinkTimeStepIfErrorIsLarge) {
+    auto controller = TimeStepController();
+
+    auto decision = controller.Evaluate(0.01, 8., 3, true);
+    EXPECT_FALSE(decision.is_accepted);
+    EXPECT_NEAR(decision.next_time_step, 0.01 * 0.9 * 0.5, 1e-15);
+
+    decision = controller.Evaluate(0.01, 1e6, 3, true);
+    EXPECT_FALSE(decision.is_accepted);
+    EXPECT_NEAR(decision.next_time_step, 0.01 * 0.2, 1e-15);
+}
+
+TEST(TimeStepControllerTest, RejectTimeStepOnDivergenceOrSlowConvergence) {
+    auto policy = AdaptiveTimeStepPolicy{};
+    policy.max_iterations = 5;
+    policy.min_time_step = 0.004;
+    auto controller = TimeStepController(policy);
+
+    auto decision = controller.Evaluate(0.01, 0., 10, false);
+    EXPECT_FALSE(decision.is_accepted);
+    EXPECT_EQ(decision.next_time_step, 0.005);
+
+    decision = controller.Evaluate(0.01, 0., 6, true);
+    EXPECT_FALSE(decision.is_accepted);
+
+    // The time step is never reduced below the minimum time step
+    decision = controller.Evaluate(0.005, 0., 6, true);
+    EXPECT_FALSE(decision.is_accepted);
+    EXPECT_EQ(decision.next_time_step, 0.004);
+}
+
+TEST(TimeStepControllerTest, CalculateScaledErrorNorm) {
+    auto policy = AdaptiveTimeStepPolicy{};
+    policy.absolute_tolerance = 1e-3;
+    policy.relative_tolerance = 0.;
+    auto controller = TimeStepController(policy);
+    auto zeros = create_vector({0., 0.});
+    auto current = State(zeros, zeros, create_vector({1., 2.}), zeros);
+    auto next = State(zeros, zeros, create_vector({3., 2.}), zeros);
+
+    // e = h^2 |beta - 1/6| (a_next - a_current) = 0.01 * 0.25 * {2, 0} = {0.005, 0}
+    auto error_norm = controller.CalculateErrorNorm(0.1, 1. / 6. + 0.25, current, next);
+
+    EXPECT_NEAR(error_norm, std::sqrt((5. * 5.) / 2.), 1e-12);
+}
+
+TEST(TimeStepControllerTest, ExpectThrowIfPolicyIsInvalid) {
+    auto policy = AdaptiveTimeStepPolicy{};
+    policy.absolute_tolerance = 0.;
+    EXPECT_THROW(TimeStepController{policy}, std::invalid_argument);
+
+    policy = AdaptiveTimeStepPolicy{};
+    policy.min_time_step = 0.1;
+    policy.max_time_step = 0.01;
+    EXPECT_THROW(TimeStepController{policy}, std::invalid_argument);
+
+    policy = AdaptiveTimeStepPolicy{};
+    policy.rejection_factor = 1.;
+    EXPECT_THROW(TimeStepController{policy}, std::invalid_argument);
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
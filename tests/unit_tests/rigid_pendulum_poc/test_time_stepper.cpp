@@ -20,6 +20,18 @@ TEST(TimeStepperTest, CreateTimeStepper) {
     EXPECT_EQ(time_stepper.GetCurrentTime(), 1.);
     EXPECT_EQ(time_stepper.GetTimeStep(), 0.01);
     EXPECT_EQ(time_stepper.GetNumberOfSteps(), 10);
+    EXPECT_NEAR(time_stepper.GetFinalTime(), 1.1, 1e-15);
+}
+
+TEST(TimeStepperTest, ChangingTimeStepKeepsFinalTime) {
+    auto time_stepper = TimeStepper(0., 0.5, 4);
+
+    time_stepper.SetTimeStep(0.25);
+    time_stepper.AdvanceTimeStep();
+
+    EXPECT_EQ(time_stepper.GetTimeStep(), 0.25);
+    EXPECT_EQ(time_stepper.GetCurrentTime(), 0.25);
+    EXPECT_EQ(time_stepper.GetFinalTime(), 2.);
 }
 
 TEST(TimeStepperTest, ConstructorWithInvalidNumberOfSteps) {
@@ -72,10 +84,61 @@ TEST(TimeStepperTest, IncrementTotalNumberOfIterations) {
     EXPECT_EQ(time_stepper.GetTotalNumberOfIterations(), 10);
 }
 
+TEST(TimeStepperTest, IncrementTotalNumbersOfJacobianAndBroydenUpdates) {
+    auto time_stepper = TimeStepper();
+
+    EXPECT_EQ(time_stepper.GetTotalNumberOfJacobianUpdates(), 0);
+    EXPECT_EQ(time_stepper.GetTotalNumberOfBroydenUpdates(), 0);
+
+    time_stepper.IncrementTotalNumberOfJacobianUpdates();
+    time_stepper.IncrementTotalNumberOfBroydenUpdates();
+    time_stepper.IncrementTotalNumberOfBroydenUpdates();
+    EXPECT_EQ(time_stepper.GetTotalNumberOfJacobianUpdates(), 1);
+    EXPECT_EQ(time_stepper.GetTotalNumberOfBroydenUpdates(), 2);
+}
+
 TEST(TimeStepperTest, GetMaximumNumberOfIterations) {
     auto time_stepper = TimeStepper();
 
     EXPECT_EQ(time_stepper.GetMaximumNumberOfIterations(), 10);
 }
 
+TEST(TimeStepperTest, RunningStatisticsOfSamples) {
+    auto statistics = RunningStatistics();
+
+    EXPECT_EQ(statistics.GetCount(), 0);
+    EXPECT_EQ(statistics.GetMean(), 0.);
+
+    statistics.Add(2.);
+    statistics.Add(-1.);
+    statistics.Add(5.);
+
+    EXPECT_EQ(statistics.GetCount(), 3);
+    EXPECT_EQ(statistics.GetTotal(), 6.);
+    EXPECT_EQ(statistics.GetMean(), 2.);
+    EXPECT_EQ(statistics.GetMin(), -1.);
+    EXPECT_EQ(statistics.GetMax(), 5.);
+}
+
+TEST(TimeStepperTest, RecordAndResetStepStatistics) {
+    auto time_stepper = TimeStepper();
+
+    time_stepper.RecordStepStatistics(0.5, 0.25, 3);
+    time_stepper.RecordStepStatistics(1.5, 0.75, 5);
+
+    EXPECT_EQ(time_stepper.GetWallTimeStatistics().GetCount(), 2);
+    EXPECT_EQ(time_stepper.GetWallTimeStatistics().GetMean(), 1.);
+    EXPECT_EQ(time_stepper.GetSolveTimeStatistics().GetTotal(), 1.);
+    EXPECT_EQ(time_stepper.GetIterationStatistics().GetMin(), 3.);
+    EXPECT_EQ(time_stepper.GetIterationStatistics().GetMax(), 5.);
+    EXPECT_EQ(time_stepper.GetAverageNumberOfIterations(), 4.);
+
+    time_stepper.ResetStatistics();
+
+    EXPECT_EQ(time_stepper.GetWallTimeStatistics().GetCount(), 0);
+    EXPECT_EQ(time_stepper.GetSolveTimeStatistics().GetCount(), 0);
+    EXPECT_EQ(time_stepper.GetIterationStatistics().GetCount(), 0);
+    EXPECT_EQ(time_stepper.GetAverageNumberOfIterations(), 0.);
+}
+
 }  // namespace openturbine::rigid_pendulum::tests
@@ -53,4 +53,64 @@ Vector multiply_rotation_matrix_with_vector(const RotationMatrix& R, const Vecto
     };
 };
 
+State create_heavy_top_initial_state() {
+    auto omega0 = Vector({0., 150., -4.61538});
+    auto initial_velocity = omega0.CrossProduct(Vector({0., 1., 0.}));
+
+    auto q0 = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    auto v0 = create_vector({
+        initial_velocity.GetXComponent(),  // component 1
+        initial_velocity.GetYComponent(),  // component 2
+        initial_velocity.GetZComponent(),  // component 3
+        omega0.GetXComponent(),            // component 4
+        omega0.GetYComponent(),            // component 5
+        omega0.GetZComponent()             // component 6
+    });
+    auto a0 =
+        create_vector({0., -21.301732544400004, -30.960830769230938, 661.3461692307692, 0., 0.});
+    auto aa0 = create_vector({0., 0., 0., 0., 0., 0.});
+
+    return State(q0, v0, a0, aa0);
+}
+
+std::shared_ptr<MultibodyModel> create_heavy_top_model() {
+    auto model = std::make_shared<MultibodyModel>();
+    const auto body = model->AddRigidBody(RigidBodyElement());
+    model->AddSphericalJoint(
+        SphericalJointElement(SphericalJointElement::kGround, Vec<3>{}, body, Vec<3>{{0., -1., 0.}})
+    );
+    return model;
+}
+
+TimeStepRecord create_time_step_record(size_t step) {
+    const auto value = static_cast<double>(step);
+    return {
+        step,
+        0.1 * value,
+        State(
+            create_vector({value}), create_vector({10. * value}), create_vector({20. * value}),
+            create_vector({30. * value})
+        ),
+        create_vector({-value}),
+        step % 4,
+        step != 3};
+}
+
+size_t AllocationCounter::n_allocations_ = 0;
+
+AllocationCounter::AllocationCounter() {
+    n_allocations_ = 0;
+    Kokkos::Tools::Experimental::set_allocate_data_callback(CountAllocation);
+}
+
+AllocationCounter::~AllocationCounter() {
+    Kokkos::Tools::Experimental::set_allocate_data_callback(nullptr);
+}
+
+void AllocationCounter::CountAllocation(
+    const Kokkos::Tools::SpaceHandle, const char*, const void*, const uint64_t
+) {
+    n_allocations_++;
+}
+
 }  // namespace openturbine::rigid_pendulum::tests
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <memory>
+
+#include "src/rigid_pendulum_poc/multibody_model.h"
 #include "src/rigid_pendulum_poc/quaternion.h"
+#include "src/rigid_pendulum_poc/state.h"
+#include "src/rigid_pendulum_poc/state_observer.h"
 #include "src/rigid_pendulum_poc/utilities.h"
 
 namespace openturbine::rigid_pendulum::tests {
@@ -20,4 +25,39 @@ void expect_kokkos_view_2D_equal(
 // Multiply a 3x3 rotation matrix with a provided 3x1 vector and return the result
 Vector multiply_rotation_matrix_with_vector(const RotationMatrix&, const Vector&);
 
+// Returns the initial state of the heavy top problem from Brüls and Cardona (2010)
+State create_heavy_top_initial_state();
+
+// Returns the heavy top as a multibody model, i.e. one body and one joint to the ground at the
+// origin, which is at -{X} from the center of mass
+std::shared_ptr<MultibodyModel> create_heavy_top_model();
+
+// Returns the record of a state with one generalized coordinate, one velocity, and one Lagrange
+// multiplier, whose values are derived from the step, e.g. for testing observers
+TimeStepRecord create_time_step_record(size_t step);
+
+// Counts the Kokkos allocations made while an instance is alive, using the Kokkos Tools
+// allocation callback - only one instance should be alive at any given time
+class AllocationCounter {
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    // Returns the number of allocations since construction or the latest reset
+    size_t GetNumberOfAllocations() const { return n_allocations_; }
+
+    // Resets the number of allocations to zero
+    void Reset() { n_allocations_ = 0; }
+
+private:
+    static size_t n_allocations_;
+
+    static void CountAllocation(
+        const Kokkos::Tools::SpaceHandle, const char*, const void*, const uint64_t
+    );
+};
+
 }  // namespace openturbine::rigid_pendulum::tests
@@ -1,3 +1,5 @@
+#include <type_traits>
+
 #include <gtest/gtest.h>
 
 #include "src/rigid_pendulum_poc/vector.h"
@@ -18,6 +20,29 @@ TEST(VectorTest, ConstructorWithProvidedComponents) {
     ASSERT_EQ(v.GetComponents(), expected);
 }
 
+TEST(VectorTest, ConstexprConstructionAndArithmetic) {
+    constexpr auto v = Vector(1., 2., 3.) + Vector(4., 5., 6.) * 2.;
+    static_assert(v.GetXComponent() == 9.);
+    static_assert(v.GetYComponent() == 12.);
+    static_assert(v.GetZComponent() == 15.);
+    static_assert(Vector(1., 0., 0.).CrossProduct(Vector(0., 1., 0.)).GetZComponent() == 1.);
+    static_assert(std::is_trivially_copyable_v<Vector>);
+}
+
+TEST(VectorTest, UseVectorsInsideOfKernel) {
+    const auto v = Vector(1., 2., 3.);
+    auto lengths = HostView1D("lengths", 4);
+
+    Kokkos::parallel_for(
+        "vector_lengths", Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, 4),
+        KOKKOS_LAMBDA(const size_t i) { lengths(i) = (v * static_cast<double>(i)).Length(); }
+    );
+
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_NEAR(lengths(i), static_cast<double>(i) * std::sqrt(14.), kTOLERANCE);
+    }
+}
+
 TEST(VectorTest, GetIndividualComponents) {
     Vector v(1., 2., 3.);
 
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "src/rigid_pendulum_poc/view_expressions.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace openturbine::rigid_pendulum::tests {
+
+TEST(ViewExpressionsTest, TransposeSharesEntriesOfMatrix) {
+    auto matrix = create_matrix({{1., 2., 3.}, {4., 5., 6.}});
+
+    const auto transposed = transpose(matrix);
+    matrix(0, 2) = 7.;
+
+    EXPECT_EQ(transposed.extent(0), 3);
+    EXPECT_EQ(transposed.extent(1), 2);
+    EXPECT_EQ(transposed(2, 0), 7.);
+    EXPECT_EQ(transposed(1, 1), 5.);
+}
+
+TEST(ViewExpressionsTest, EvaluateResidualOfHeavyTopInOneExpression) {
+    // {residual} = [M] {v'} + {g} + [B]^T {Lambda}
+    const auto mass_matrix = create_matrix({{2., 0.}, {0., 3.}});
+    const auto acceleration = create_vector({1., 2.});
+    const auto forces = create_vector({0.5, -0.5});
+    const auto constraint_gradient = create_matrix({{1., 2.}, {3., 4.}, {5., 6.}});
+    const auto lagrange_mults = create_vector({1., 0., -1.});
+
+    auto residual = evaluate(
+        lazy(mass_matrix) * acceleration + forces + transpose(constraint_gradient) * lagrange_mults
+    );
+
+    expect_kokkos_view_1D_equal(residual, {2. + 0.5 + 1. - 5., 6. - 0.5 + 2. - 6.});
+}
+
+TEST(ViewExpressionsTest, EvaluateScaledSumsAndDifferencesOfMatrices) {
+    const auto a = create_matrix({{1., 2.}, {3., 4.}});
+    const auto b = create_matrix({{0., 1.}, {1., 0.}});
+
+    auto result = evaluate(2. * lazy(a) - lazy(b) * 0.5 + transpose(a) * b);
+
+    expect_kokkos_view_2D_equal(result, {{2. + 3., 4. - 0.5 + 1.}, {6. - 0.5 + 4., 8. + 2.}});
+}
+
+TEST(ViewExpressionsTest, AssignExpressionIntoExistingView) {
+    const auto matrix = create_matrix({{1., 2.}, {3., 4.}});
+    const auto vector = create_vector({1., -1.});
+    auto result = create_vector({10., 20.});
+
+    assign(result, transpose(matrix) * vector + vector);
+
+    expect_kokkos_view_1D_equal(result, {1. - 3. + 1., 2. - 4. - 1.});
+}
+
+TEST(ViewExpressionsTest, ExpectThrowIfSizesDoNotMatch) {
+    const auto matrix = create_matrix({{1., 2., 3.}, {4., 5., 6.}});
+    const auto vector = create_vector({1., 2.});
+
+    EXPECT_THROW(lazy(matrix) * vector, std::invalid_argument);
+    EXPECT_THROW(lazy(matrix) + transpose(matrix), std::invalid_argument);
+    EXPECT_THROW(
+        assign(HostView1D("result", 2), transpose(matrix) * create_vector({1., 2.})),
+        std::invalid_argument
+    );
+}
+
+}  // namespace openturbine::rigid_pendulum::tests
@@ -0,0 +1,63 @@
+#include <array>
+
+#include "gtest/gtest.h"
+
+#include "src/utilities/communicator.h"
+
+namespace oturb_tests {
+
+using namespace openturbine::util;
+
+TEST(CommunicatorTest, WorldHoldsThisProcess) {
+    const auto world = Communicator::World();
+
+    EXPECT_GE(world.GetSize(), 1);
+    EXPECT_LT(world.GetRank(), world.GetSize());
+    EXPECT_EQ(world.IsRoot(), world.GetRank() == 0);
+    if (!is_mpi_enabled()) {
+        EXPECT_EQ(world.GetSize(), 1);
+    }
+}
+
+TEST(CommunicatorTest, SelfIsSingleProcess) {
+    const auto self = Communicator::Self();
+
+    EXPECT_EQ(self.GetRank(), 0);
+    EXPECT_EQ(self.GetSize(), 1);
+    EXPECT_TRUE(self.IsRoot());
+    EXPECT_EQ(self.Sum(2.5), 2.5);
+    EXPECT_EQ(self.Sum(size_t{3}), 3);
+    EXPECT_EQ(self.Min(-1.), -1.);
+    EXPECT_EQ(self.Max(4.), 4.);
+    EXPECT_EQ(self.GetRankFileName("log.txt"), "log.txt");
+}
+
+TEST(CommunicatorTest, ReduceOverAllProcesses) {
+    const auto world = Communicator::World();
+    const auto rank = static_cast<double>(world.GetRank());
+    const auto size = static_cast<double>(world.GetSize());
+
+    EXPECT_EQ(world.Sum(1.), size);
+    EXPECT_EQ(world.Sum(world.GetRank()), world.GetSize() * (world.GetSize() - 1) / 2);
+    EXPECT_EQ(world.Min(rank), 0.);
+    EXPECT_EQ(world.Max(rank), size - 1.);
+    EXPECT_EQ(
+        world.Sum(std::array<double, 2>{1., rank}),
+        (std::array<double, 2>{size, size * (size - 1.) / 2.})
+    );
+    EXPECT_EQ(
+        world.Max(std::array<double, 2>{rank, -rank}), (std::array<double, 2>{size - 1., 0.})
+    );
+    world.Barrier();
+}
+
+TEST(CommunicatorTest, CreateRankFileNames) {
+    EXPECT_EQ(create_rank_file_name("log.txt", 0, 1), "log.txt");
+    EXPECT_EQ(create_rank_file_name("log.txt", 3, 4), "log.3.txt");
+    EXPECT_EQ(create_rank_file_name("output/history.oth", 12, 100), "output/history.12.oth");
+    EXPECT_EQ(create_rank_file_name("history", 1, 2), "history.1");
+    EXPECT_EQ(create_rank_file_name("run.1/history", 1, 2), "run.1/history.1");
+    EXPECT_EQ(create_rank_file_name("output/.history", 1, 2), "output/.history.1");
+}
+
+}  // namespace oturb_tests
@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "src/io/ensemble_history_writer.H"
+
+namespace oturb_tests {
+
+using namespace openturbine::io;
+using namespace openturbine::rigid_pendulum;
+
+TEST(EnsembleHistoryWriterTest, WriteStatesOfAllBodiesBodyAfterBody) {
+    const auto communicator = openturbine::util::Communicator::World();
+    const auto file_name = communicator.GetRankFileName("ensemble_history.bin");
+    auto states = BatchedState<Kokkos::HostSpace>(2);
+    const auto set_states = [&states](size_t step) {
+        for (size_t body = 0; body < 2; ++body) {
+            const auto value = static_cast<double>(10 * step + body);
+            for (size_t i = 0; i < 7; ++i) {
+                states.GetGeneralizedCoordinates()(i, body) = value + 0.01 * i;
+            }
+            for (size_t i = 0; i < 6; ++i) {
+                states.GetVelocity()(i, body) = -value - 0.01 * i;
+                states.GetAcceleration()(i, body) = 2. * value;
+                states.GetAlgorithmicAcceleration()(i, body) = 3. * value;
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                states.GetLagrangeMultipliers()(i, body) = 4. * value + i;
+            }
+        }
+    };
+    {
+        auto writer = EnsembleHistoryWriter(
+            "ensemble_history.bin", communicator, TimeStepper(0., 0.5, 3, 8)
+        );
+        EXPECT_EQ(writer.GetFileName(), file_name);
+        for (size_t step = 1; step <= 3; ++step) {
+            set_states(step);
+            writer.Write(step, 0.5 * step, states, step + 1, step != 2);
+        }
+        writer.Finalize();
+        EXPECT_EQ(writer.GetNumberOfRecords(), 3);
+    }
+
+    auto history = read_time_history(file_name);
+
+    EXPECT_EQ(history.metadata.n_steps, 3);
+    EXPECT_EQ(history.metadata.n_coordinates, 14);
+    EXPECT_EQ(history.metadata.n_velocities, 12);
+    EXPECT_EQ(history.metadata.n_lagrange_mults, 6);
+    ASSERT_EQ(history.records.size(), 3);
+    for (size_t step = 1; step <= 3; ++step) {
+        const auto& record = history.records[step - 1];
+        EXPECT_EQ(record.step, step);
+        EXPECT_EQ(record.time, 0.5 * step);
+        EXPECT_EQ(record.n_iterations, step + 1);
+        EXPECT_EQ(record.is_converged, step != 2);
+        for (size_t body = 0; body < 2; ++body) {
+            const auto value = static_cast<double>(10 * step + body);
+            for (size_t i = 0; i < 7; ++i) {
+                EXPECT_EQ(record.state.GetGeneralizedCoordinates()(7 * body + i), value + 0.01 * i);
+            }
+            for (size_t i = 0; i < 6; ++i) {
+                EXPECT_EQ(record.state.GetVelocity()(6 * body + i), -value - 0.01 * i);
+                EXPECT_EQ(record.state.GetAcceleration()(6 * body + i), 2. * value);
+                EXPECT_EQ(record.state.GetAlgorithmicAcceleration()(6 * body + i), 3. * value);
+            }
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_EQ(record.lagrange_mults(3 * body + i), 4. * value + i);
+            }
+        }
+    }
+    std::remove(file_name.c_str());
+}
+
+}  // namespace oturb_tests
@@ -1,5 +1,11 @@
+#include <fstream>
+#include <sstream>
+
 #include "gtest/gtest.h"
 
+// Compile out the Info and Debug logging macros of this file to test their elimination
+#undef OTURB_LOG_LEVEL
+#define OTURB_LOG_LEVEL 2
 #include "src/utilities/log.h"
 
 namespace oturb_tests {
@@ -101,4 +107,45 @@ TEST(LogTest, GetInstance) {
     EXPECT_EQ(second_log_instance, log_instance);
 }
 
+TEST(LogTest, IsEnabledForSeverityLevelsUpToTheMaximum) {
+    Log* log_instance = Log::Get();
+    EXPECT_TRUE(log_instance->IsEnabled(SeverityLevel::kError));
+    EXPECT_TRUE(log_instance->IsEnabled(SeverityLevel::kDebug));
+}
+
+TEST(LogTest, FlushWritesQueuedMessagesToLogFile) {
+    Log* log_instance = Log::Get();
+    log_instance->Warning("first message from FlushWritesQueuedMessagesToLogFile\n");
+    log_instance->Error("second message from FlushWritesQueuedMessagesToLogFile\n");
+    log_instance->Flush();
+
+    std::ifstream file(log_instance->GetOutputFileName());
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const auto log = contents.str();
+
+    const auto first = log.find("[WARNING] first message from FlushWritesQueuedMessagesToLogFile");
+    const auto second = log.find("[ERROR] second message from FlushWritesQueuedMessagesToLogFile");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(second, std::string::npos);
+    EXPECT_LT(first, second);
+}
+
+std::string create_message(int& n_evaluations) {
+    n_evaluations++;
+    return "message from LogMacrosOnlyEvaluateMessagesOfEnabledLevels\n";
+}
+
+TEST(LogTest, LogMacrosOnlyEvaluateMessagesOfEnabledLevels) {
+    int n_evaluations = 0;
+
+    // Info and Debug are compiled out in this file, Warning is enabled at run time
+    OTURB_LOG_DEBUG(create_message(n_evaluations));
+    OTURB_LOG_INFO(create_message(n_evaluations));
+    EXPECT_EQ(n_evaluations, 0);
+
+    OTURB_LOG_WARNING(create_message(n_evaluations));
+    EXPECT_EQ(n_evaluations, 1);
+}
+
 }  // namespace oturb_tests
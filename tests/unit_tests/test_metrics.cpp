@@ -0,0 +1,193 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <Kokkos_Core.hpp>
+
+#include "gtest/gtest.h"
+#include "src/rigid_pendulum_poc/time_stepper.h"
+#include "src/utilities/metrics.h"
+
+namespace oturb_tests {
+
+using namespace openturbine::util;
+
+std::string read_metrics_file(const std::string& file_name) {
+    auto input = std::ifstream(file_name);
+    auto contents = std::stringstream{};
+    contents << input.rdbuf();
+    return contents.str();
+}
+
+TEST(MetricsTest, CounterAndGauge) {
+    auto counter = Counter("Number of things");
+    counter.Increment();
+    counter.Increment(2.5);
+    EXPECT_EQ(counter.GetValue(), 3.5);
+    EXPECT_EQ(counter.GetHelp(), "Number of things");
+
+    auto gauge = Gauge();
+    gauge.Set(4.);
+    gauge.Set(-1.);
+    EXPECT_EQ(gauge.GetValue(), -1.);
+}
+
+TEST(MetricsTest, HistogramCountsValuesInTheFirstBucketNotExceeded) {
+    auto histogram = Histogram({1., 2., 5.});
+    for (const auto value : {0.5, 1., 1.5, 3., 7., 9.}) {
+        histogram.Observe(value);
+    }
+
+    EXPECT_EQ(histogram.GetBucketCounts(), (std::vector<uint64_t>{2, 1, 1, 2}));
+    EXPECT_EQ(histogram.GetCount(), 6);
+    EXPECT_EQ(histogram.GetSum(), 22.);
+    EXPECT_THROW(Histogram({2., 1.}), std::invalid_argument);
+}
+
+TEST(MetricsTest, RegistryReturnsTheSameMetricForTheSameName) {
+    auto registry = MetricsRegistry();
+    auto& counter = registry.GetCounter("steps_total");
+    counter.Increment();
+    EXPECT_EQ(&registry.GetCounter("steps_total"), &counter);
+    EXPECT_EQ(registry.GetCounter("steps_total").GetValue(), 1.);
+    EXPECT_NE(&registry.GetCounter("other_total"), &counter);
+}
+
+TEST(MetricsTest, PrometheusTextFormat) {
+    auto registry = MetricsRegistry();
+    registry.GetCounter("steps_total", "Number of steps").Increment(3.);
+    registry.GetGauge("steps_per_second").Set(0.25);
+    auto& histogram = registry.GetHistogram("iterations", {1., 2.});
+    histogram.Observe(1.);
+    histogram.Observe(4.);
+
+    EXPECT_EQ(
+        registry.ToPrometheusText(),
+        "# HELP steps_total Number of steps\n"
+        "# TYPE steps_total counter\n"
+        "steps_total 3\n"
+        "# TYPE steps_per_second gauge\n"
+        "steps_per_second 0.25\n"
+        "# TYPE iterations histogram\n"
+        "iterations_bucket{le=\"1\"} 1\n"
+        "iterations_bucket{le=\"2\"} 1\n"
+        "iterations_bucket{le=\"+Inf\"} 2\n"
+        "iterations_sum 5\n"
+        "iterations_count 2\n"
+    );
+}
+
+TEST(MetricsTest, JsonFormat) {
+    auto registry = MetricsRegistry();
+    registry.GetCounter("steps_total").Increment(3.);
+    registry.GetGauge("residual").Set(0.1);
+    registry.GetHistogram("iterations", {2.}).Observe(1.);
+
+    EXPECT_EQ(
+        registry.ToJson(12.5),
+        "{\"time\":12.5,\"counters\":{\"steps_total\":3},\"gauges\":{\"residual\":0.1},"
+        "\"histograms\":{\"iterations\":{\"count\":1,\"sum\":1,\"buckets\":[{\"le\":2,\"count\":1},"
+        "{\"le\":null,\"count\":0}]}}}"
+    );
+}
+
+TEST(MetricsTest, ExporterWritesJsonLinesAndReplacesPrometheusText) {
+    auto registry = MetricsRegistry();
+    auto& counter = registry.GetCounter("steps_total");
+
+    {
+        auto exporter = MetricsExporter(
+            registry, "test_metrics.jsonl", MetricsFormat::kJsonLines, std::chrono::hours(1)
+        );
+        counter.Increment();
+        exporter.Export();
+        counter.Increment();
+        // Destroying the exporter writes the final metrics
+    }
+    auto records = std::istringstream(read_metrics_file("test_metrics.jsonl"));
+    auto line = std::string{};
+    auto n_records = 0;
+    while (std::getline(records, line)) {
+        EXPECT_NE(line.find("\"steps_total\":" + std::to_string(++n_records)), std::string::npos);
+    }
+    EXPECT_EQ(n_records, 2);
+
+    auto exporter = MetricsExporter(
+        registry, "test_metrics.prom", MetricsFormat::kPrometheus, std::chrono::hours(1)
+    );
+    exporter.Export();
+    exporter.Stop();
+    EXPECT_EQ(exporter.GetNumberOfExports(), 2);
+    EXPECT_EQ(read_metrics_file("test_metrics.prom"), registry.ToPrometheusText());
+
+    std::remove("test_metrics.jsonl");
+    std::remove("test_metrics.prom");
+}
+
+TEST(MetricsTest, ExporterExportsPeriodically) {
+    auto registry = MetricsRegistry();
+    auto exporter = MetricsExporter(
+        registry, "test_metrics_periodic.jsonl", MetricsFormat::kJsonLines,
+        std::chrono::milliseconds(1)
+    );
+    while (exporter.GetNumberOfExports() < 3) {
+        std::this_thread::yield();
+    }
+    exporter.Stop();
+    EXPECT_GE(exporter.GetNumberOfExports(), 4);
+
+    std::remove("test_metrics_periodic.jsonl");
+}
+
+TEST(MetricsTest, ExpectThrowIfExporterIsInvalid) {
+    auto registry = MetricsRegistry();
+    EXPECT_THROW(
+        MetricsExporter(
+            registry, "test_metrics.jsonl", MetricsFormat::kJsonLines, std::chrono::milliseconds(0)
+        ),
+        std::invalid_argument
+    );
+    EXPECT_THROW(
+        MetricsExporter(registry, "no_such_directory/metrics.jsonl", MetricsFormat::kJsonLines),
+        std::runtime_error
+    );
+}
+
+TEST(MetricsTest, TimeStepperUpdatesTheRegistry) {
+    auto& registry = MetricsRegistry::Get();
+    const auto steps = registry.GetCounter("openturbine_time_steps_total").GetValue();
+    const auto solve_time = registry.GetCounter("openturbine_linear_solve_seconds_total").GetValue();
+
+    auto time_stepper = openturbine::rigid_pendulum::TimeStepper();
+    time_stepper.RecordStepStatistics(0.5, 0.25, 3);
+
+    EXPECT_EQ(registry.GetCounter("openturbine_time_steps_total").GetValue(), steps + 1.);
+    EXPECT_EQ(
+        registry.GetCounter("openturbine_linear_solve_seconds_total").GetValue(), solve_time + 0.25
+    );
+    EXPECT_EQ(registry.GetGauge("openturbine_steps_per_second").GetValue(), 2.);
+    EXPECT_GE(registry.GetHistogram("openturbine_newton_iterations", {}).GetCount(), 1);
+}
+
+TEST(MetricsTest, CountKokkosAllocations) {
+    auto& registry = MetricsRegistry::Get();
+    registry.EnableAllocationTracking();
+    const auto n_allocations =
+        registry.GetCounter("openturbine_kokkos_allocations_total").GetValue();
+    const auto n_bytes = registry.GetCounter("openturbine_kokkos_allocated_bytes_total").GetValue();
+
+    auto view = Kokkos::View<double*, Kokkos::HostSpace>("metrics_test", 16);
+    Kokkos::Tools::Experimental::set_allocate_data_callback(nullptr);
+
+    EXPECT_EQ(
+        registry.GetCounter("openturbine_kokkos_allocations_total").GetValue(), n_allocations + 1.
+    );
+    EXPECT_GE(
+        registry.GetCounter("openturbine_kokkos_allocated_bytes_total").GetValue(),
+        n_bytes + 16. * sizeof(double)
+    );
+}
+
+}  // namespace oturb_tests
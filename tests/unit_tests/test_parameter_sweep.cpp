@@ -0,0 +1,150 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "src/io/parameter_sweep.H"
+
+namespace oturb_tests {
+
+using namespace openturbine::io;
+using namespace openturbine::rigid_pendulum;
+
+SweepInput parse(const std::string& text) {
+    auto stream = std::istringstream(text);
+    return parse_sweep_input(stream);
+}
+
+TEST(ParameterSweepTest, ParseBaseCaseAndGrid) {
+    const auto input = parse(
+        "# heavy top sweep\n"
+        "mass = 10.\n"
+        "n_steps = 20   # short cases\n"
+        "\n"
+        "alpha_f = 0.3, 0.4\n"
+        "  time_step =0.001,0.002 , 0.004\n"
+    );
+
+    EXPECT_EQ(input.base.mass, 10.);
+    EXPECT_EQ(input.base.n_steps, 20);
+    EXPECT_EQ(input.base.alpha_m, SweepCase().alpha_m);
+    ASSERT_EQ(input.grid.size(), 2);
+    EXPECT_EQ(input.grid[0].parameter, "alpha_f");
+    EXPECT_EQ(input.grid[0].values, std::vector<double>({0.3, 0.4}));
+    EXPECT_EQ(input.grid[1].parameter, "time_step");
+    EXPECT_EQ(input.grid[1].values, std::vector<double>({0.001, 0.002, 0.004}));
+}
+
+TEST(ParameterSweepTest, CreateCartesianProductOfGrid) {
+    const auto cases = create_sweep_cases(parse("mass = 10, 20\nalpha_f = 0.3, 0.35, 0.4\n"));
+
+    ASSERT_EQ(cases.size(), 6);
+    EXPECT_EQ(cases[0].mass, 10.);
+    EXPECT_EQ(cases[0].alpha_f, 0.3);
+    EXPECT_EQ(cases[2].mass, 10.);
+    EXPECT_EQ(cases[2].alpha_f, 0.4);
+    EXPECT_EQ(cases[3].mass, 20.);
+    EXPECT_EQ(cases[3].alpha_f, 0.3);
+    EXPECT_EQ(cases[5].mass, 20.);
+    EXPECT_EQ(cases[5].alpha_f, 0.4);
+    EXPECT_EQ(create_sweep_cases(parse("mass = 10\n")).size(), 1);
+}
+
+TEST(ParameterSweepTest, GetAndSetParametersByName) {
+    auto sweep_case = SweepCase();
+    for (const auto& name : get_sweep_parameter_names()) {
+        set_sweep_parameter(sweep_case, name, 3.);
+        EXPECT_EQ(get_sweep_parameter(sweep_case, name), 3.);
+    }
+    EXPECT_EQ(sweep_case.max_iterations, 3);
+}
+
+TEST(ParameterSweepTest, InitialStateOfDefaultCaseMatchesHeavyTopProblem) {
+    const auto state = create_sweep_initial_state(SweepCase());
+
+    // Position and velocities of the Brüls and Cardona (2010) heavy top, with the accelerations
+    // consistent with its constraint and equations of motion
+    const auto expected_gen_coords = std::vector<double>{0., 1., 0., 1., 0., 0., 0.};
+    const auto expected_velocity = std::vector<double>{4.61538, 0., 0., 0., 150., -4.61538};
+    const auto expected_acceleration = std::vector<double>{
+        0., -21.301732544400004, -30.960830769230938, 661.3461692307692, 0., 0.};
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_NEAR(state.GetGeneralizedCoordinates()(i), expected_gen_coords[i], 1e-12);
+    }
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_NEAR(state.GetVelocity()(i), expected_velocity[i], 1e-12);
+        EXPECT_NEAR(state.GetAcceleration()(i), expected_acceleration[i], 1e-9);
+    }
+}
+
+TEST(ParameterSweepTest, RunSweepMatchesSerialRuns) {
+    const auto cases = create_sweep_cases(
+        parse("n_steps = 5\nmass = 10, 15\ninertia_y = 0.4, 0.5\ntime_step = 0.001, 0.002\n")
+    );
+
+    const auto summaries = run_sweep(cases, 3);
+
+    ASSERT_EQ(summaries.size(), cases.size());
+    for (size_t i = 0; i < cases.size(); ++i) {
+        const auto expected = run_sweep_case(i, cases[i]);
+        EXPECT_EQ(summaries[i].index, i);
+        EXPECT_EQ(summaries[i].parameters.mass, cases[i].mass);
+        EXPECT_TRUE(summaries[i].is_converged);
+        EXPECT_TRUE(summaries[i].error.empty());
+        EXPECT_EQ(summaries[i].n_steps, 5);
+        EXPECT_NEAR(summaries[i].final_time, 5. * cases[i].time_step, 1e-12);
+        EXPECT_EQ(summaries[i].total_iterations, expected.total_iterations);
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_EQ(summaries[i].final_position[j], expected.final_position[j]);
+            EXPECT_EQ(summaries[i].final_velocity[j], expected.final_velocity[j]);
+        }
+    }
+}
+
+TEST(ParameterSweepTest, RecordErrorsOfFailedCases) {
+    auto sweep_case = SweepCase();
+    sweep_case.alpha_f = 2.;
+
+    const auto summary = run_sweep_case(7, sweep_case);
+
+    EXPECT_EQ(summary.index, 7);
+    EXPECT_FALSE(summary.is_converged);
+    EXPECT_EQ(summary.error, "Invalid value for alpha_f");
+}
+
+TEST(ParameterSweepTest, WriteOneSummaryLinePerCase) {
+    auto cases = create_sweep_cases(parse("n_steps = 2\nmass = 10, 15\n"));
+    cases[1].beta = -1.;
+    auto summaries = run_sweep(cases, 2);
+    const auto file_name = std::string("test_parameter_sweep.csv");
+
+    write_sweep_summary(file_name, summaries);
+
+    auto file = std::ifstream(file_name);
+    auto lines = std::vector<std::string>{};
+    for (auto line = std::string{}; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_EQ(lines[0].rfind("case,mass,", 0), 0);
+    EXPECT_EQ(lines[1].rfind("0,10,", 0), 0);
+    EXPECT_EQ(lines[1].substr(lines[1].size() - 3), ",\"\"");
+    EXPECT_EQ(lines[2].rfind("1,15,", 0), 0);
+    EXPECT_EQ(lines[2].substr(lines[2].size() - 25), ",\"Invalid value for beta\"");
+    std::remove(file_name.c_str());
+}
+
+TEST(ParameterSweepTest, ExpectThrowIfInputIsInvalid) {
+    EXPECT_THROW(parse("mass 10\n"), std::runtime_error);
+    EXPECT_THROW(parse("mass = \n"), std::runtime_error);
+    EXPECT_THROW(parse("mass = ten\n"), std::runtime_error);
+    EXPECT_THROW(parse("mass = 10, 20 kg\n"), std::runtime_error);
+    EXPECT_THROW(parse("mass = 10\nmass = 20, 30\n"), std::runtime_error);
+    EXPECT_THROW(parse("length = 10\n"), std::invalid_argument);
+    EXPECT_THROW(parse("n_steps = 2.5\n"), std::invalid_argument);
+    EXPECT_THROW(read_sweep_input("does_not_exist.sweep"), std::runtime_error);
+}
+
+}  // namespace oturb_tests
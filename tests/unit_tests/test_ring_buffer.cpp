@@ -0,0 +1,92 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/utilities/ring_buffer.h"
+
+namespace oturb_tests {
+
+using namespace openturbine::util;
+
+TEST(RingBufferTest, PopValuesInOrderOfPush) {
+    RingBuffer<std::string> buffer(4);
+    for (auto value : {"a", "b", "c"}) {
+        auto record = std::string(value);
+        EXPECT_TRUE(buffer.TryPush(record));
+    }
+    EXPECT_EQ(buffer.GetSize(), 3);
+
+    std::string value;
+    for (auto expected : {"a", "b", "c"}) {
+        EXPECT_TRUE(buffer.TryPop(value));
+        EXPECT_EQ(value, expected);
+    }
+    EXPECT_FALSE(buffer.TryPop(value));
+    EXPECT_EQ(buffer.GetSize(), 0);
+}
+
+TEST(RingBufferTest, PushFailsWithoutModifyingValueIfFull) {
+    RingBuffer<int> buffer(2);
+    int value = 1;
+    EXPECT_TRUE(buffer.TryPush(value));
+    EXPECT_TRUE(buffer.TryPush(value));
+
+    value = 3;
+    EXPECT_FALSE(buffer.TryPush(value));
+    EXPECT_EQ(value, 3);
+
+    // Popping makes room for the next push, i.e. the buffer wraps around
+    EXPECT_TRUE(buffer.TryPop(value));
+    value = 3;
+    EXPECT_TRUE(buffer.TryPush(value));
+    EXPECT_TRUE(buffer.TryPop(value));
+    EXPECT_TRUE(buffer.TryPop(value));
+    EXPECT_EQ(value, 3);
+}
+
+TEST(RingBufferTest, ConcurrentProducersWithSingleConsumer) {
+    constexpr int kPRODUCERS = 4;
+    constexpr int kVALUES_PER_PRODUCER = 10000;
+    RingBuffer<int> buffer(64);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < kPRODUCERS; ++producer) {
+        producers.emplace_back([&buffer, producer]() {
+            for (int i = 0; i < kVALUES_PER_PRODUCER; ++i) {
+                int value = producer * kVALUES_PER_PRODUCER + i;
+                while (!buffer.TryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Every value is popped exactly once, and the values of every producer in order
+    std::vector<int> last_value(kPRODUCERS, -1);
+    long long sum = 0;
+    for (int n_popped = 0; n_popped < kPRODUCERS * kVALUES_PER_PRODUCER;) {
+        int value;
+        if (buffer.TryPop(value)) {
+            const auto producer = value / kVALUES_PER_PRODUCER;
+            EXPECT_GT(value, last_value[producer]);
+            last_value[producer] = value;
+            sum += value;
+            n_popped++;
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    const long long n_values = kPRODUCERS * kVALUES_PER_PRODUCER;
+    EXPECT_EQ(sum, n_values * (n_values - 1) / 2);
+}
+
+TEST(RingBufferTest, ExpectThrowIfCapacityIsNotPowerOfTwo) {
+    EXPECT_THROW(RingBuffer<int>(0), std::invalid_argument);
+    EXPECT_THROW(RingBuffer<int>(3), std::invalid_argument);
+}
+
+}  // namespace oturb_tests
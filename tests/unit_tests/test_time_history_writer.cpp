@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "src/io/time_history_writer.H"
+#include "src/rigid_pendulum_poc/generalized_alpha_time_integrator.h"
+#include "src/rigid_pendulum_poc/heavy_top.h"
+#include "tests/unit_tests/rigid_pendulum_poc/test_utilities.h"
+
+namespace oturb_tests {
+
+using namespace openturbine::io;
+using namespace openturbine::rigid_pendulum;
+using openturbine::rigid_pendulum::tests::create_time_step_record;
+
+void expect_records_equal(const TimeStepRecord& actual, const TimeStepRecord& expected) {
+    EXPECT_EQ(actual.step, expected.step);
+    EXPECT_EQ(actual.time, expected.time);
+    EXPECT_EQ(actual.n_iterations, expected.n_iterations);
+    EXPECT_EQ(actual.is_converged, expected.is_converged);
+
+    const auto expect_views_equal = [](HostView1D view, HostView1D expected_view) {
+        ASSERT_EQ(view.extent(0), expected_view.extent(0));
+        for (size_t i = 0; i < view.extent(0); ++i) {
+            EXPECT_EQ(view(i), expected_view(i));
+        }
+    };
+    expect_views_equal(
+        actual.state.GetGeneralizedCoordinates(), expected.state.GetGeneralizedCoordinates()
+    );
+    expect_views_equal(actual.state.GetVelocity(), expected.state.GetVelocity());
+    expect_views_equal(actual.state.GetAcceleration(), expected.state.GetAcceleration());
+    expect_views_equal(
+        actual.state.GetAlgorithmicAcceleration(), expected.state.GetAlgorithmicAcceleration()
+    );
+    expect_views_equal(actual.lagrange_mults, expected.lagrange_mults);
+}
+
+TEST(TimeHistoryWriterTest, WriteAndReadRecordsInChunks) {
+    const auto file_name = std::string("time_history_chunks.bin");
+    {
+        auto writer = TimeHistoryWriter(file_name, TimeStepper(1., 0.25, 6, 12), 4);
+        for (size_t step = 0; step < 7; ++step) {
+            writer.Observe(create_time_step_record(step));
+        }
+        writer.Finalize();
+        EXPECT_EQ(writer.GetNumberOfRecords(), 7);
+    }
+
+    auto history = read_time_history(file_name);
+
+    EXPECT_EQ(history.metadata.initial_time, 1.);
+    EXPECT_EQ(history.metadata.time_step, 0.25);
+    EXPECT_EQ(history.metadata.n_steps, 6);
+    EXPECT_EQ(history.metadata.max_iterations, 12);
+    EXPECT_EQ(history.metadata.n_coordinates, 1);
+    EXPECT_EQ(history.metadata.n_velocities, 1);
+    EXPECT_EQ(history.metadata.n_lagrange_mults, 1);
+    EXPECT_EQ(history.metadata.chunk_size, 4);
+    EXPECT_EQ(history.metadata.compression, Compression::kNone);
+    ASSERT_EQ(history.records.size(), 7);
+    for (size_t step = 0; step < 7; ++step) {
+        expect_records_equal(history.records[step], create_time_step_record(step));
+    }
+    std::remove(file_name.c_str());
+}
+
+TEST(TimeHistoryWriterTest, WriteHeaderOfEmptyTimeHistory) {
+    const auto file_name = std::string("time_history_empty.bin");
+    { auto writer = TimeHistoryWriter(file_name, TimeStepper(0., 0.1, 10)); }
+
+    auto history = read_time_history(file_name);
+
+    EXPECT_EQ(history.metadata.n_steps, 10);
+    EXPECT_EQ(history.metadata.n_coordinates, 0);
+    EXPECT_TRUE(history.records.empty());
+    std::remove(file_name.c_str());
+}
+
+TEST(TimeHistoryWriterTest, StreamTimeIntegrationOfHeavyTop) {
+    const auto file_name = std::string("time_history_heavy_top.bin");
+    const auto time_stepper = TimeStepper(0., 0.002, 25, 50);
+    const auto compression = is_compression_available(Compression::kZlib) ? Compression::kZlib
+                                                                          : Compression::kNone;
+    // Heavy top problem from Brüls and Cardona (2010)
+    auto q0 = create_vector({0., 1., 0., 1., 0., 0., 0.});
+    auto v0 = create_vector({4.61538, 0., 0., 0., 150., -4.61538});
+    auto v_dot0 =
+        create_vector({0., -21.301732544400004, -30.960830769230938, 661.3461692307692, 0., 0.});
+    auto initial_state = State(q0, v0, v_dot0, create_vector({0., 0., 0., 0., 0., 0.}));
+    auto heavy_top = std::make_shared<HeavyTopLinearizationParameters>();
+
+    auto history_integrator =
+        GeneralizedAlphaTimeIntegrator(0.375, 0.125, 0.390625, 0.75, time_stepper, true);
+    auto states = history_integrator.Integrate(initial_state, 3, heavy_top);
+
+    auto time_integrator =
+        GeneralizedAlphaTimeIntegrator(0.375, 0.125, 0.390625, 0.75, time_stepper, true);
+    auto writer = TimeHistoryWriter(file_name, time_stepper, 8, compression);
+    time_integrator.Integrate(initial_state, 3, heavy_top, writer);
+
+    auto history = read_time_history(file_name);
+
+    EXPECT_EQ(history.metadata.compression, compression);
+    EXPECT_EQ(history.metadata.time_step, 0.002);
+    EXPECT_EQ(history.metadata.n_lagrange_mults, 3);
+    ASSERT_EQ(history.records.size(), states.size());
+    for (size_t step = 0; step < states.size(); ++step) {
+        EXPECT_EQ(history.records[step].step, step);
+        EXPECT_TRUE(history.records[step].is_converged);
+        for (size_t i = 0; i < 7; ++i) {
+            EXPECT_EQ(
+                history.records[step].state.GetGeneralizedCoordinates()(i),
+                states[step].GetGeneralizedCoordinates()(i)
+            );
+        }
+    }
+    std::remove(file_name.c_str());
+}
+
+TEST(TimeHistoryWriterTest, ExpectThrowIfRecordsAreInconsistentOrFileIsInvalid) {
+    const auto file_name = std::string("time_history_invalid.bin");
+    auto writer = TimeHistoryWriter(file_name, TimeStepper(0., 0.1, 10));
+    writer.Observe(create_time_step_record(0));
+    auto record = create_time_step_record(1);
+    record.lagrange_mults = create_vector({1., 2.});
+
+    EXPECT_THROW(writer.Observe(record), std::invalid_argument);
+    EXPECT_THROW(TimeHistoryWriter(file_name, TimeStepper(), 0), std::invalid_argument);
+    EXPECT_THROW(read_time_history("time_history_missing.bin"), std::runtime_error);
+
+    writer.Finalize();
+    EXPECT_THROW(writer.Observe(create_time_step_record(1)), std::runtime_error);
+    std::remove(file_name.c_str());
+}
+
+}  // namespace oturb_tests
@@ -7,11 +7,14 @@
 #include "gtest/gtest.h"
 
 #include "OpenTurbineTestEnv.H"
+#include "src/utilities/communicator.h"
 
 //! Global instance of the environment (for access in tests)
 openturbine_tests::OTurbTestEnv* utest_env{nullptr};
 
 int main(int argc, char** argv) {
+    // The tests run on every rank if launched with MPI, i.e. collectives are tested as well
+    auto mpi_environment = openturbine::util::MPIEnvironment(argc, argv);
     ::testing::InitGoogleTest(&argc, argv);
 
     utest_env = new openturbine_tests::OTurbTestEnv(argc, argv);